@@ -0,0 +1,62 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "benchmark/benchmark.h"
+
+#if !DEVICE_USTICKER
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+using benchmark::v1::Benchmark;
+using benchmark::v1::statistics_t;
+
+CircularBuffer<uint8_t, 32> buffer;
+
+void circularbuffer_push_pop()
+{
+    uint8_t value = 0xA5;
+    buffer.push(value);
+    buffer.pop(value);
+}
+
+/** Benchmark a CircularBuffer push/pop round trip */
+void bench_circularbuffer_push_pop(void)
+{
+    statistics_t stats = Benchmark::measure("circularbuffer_push_pop", circularbuffer_push_pop);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    Benchmark::init();
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark CircularBuffer push/pop", bench_circularbuffer_push_pop),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
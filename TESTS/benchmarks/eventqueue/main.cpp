@@ -0,0 +1,81 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_events.h"
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "benchmark/benchmark.h"
+
+#if !DEVICE_USTICKER
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+using benchmark::v1::Benchmark;
+using benchmark::v1::statistics_t;
+
+#define BENCH_EQUEUE_SIZE (4*EVENTS_EVENT_SIZE)
+
+EventQueue queue(BENCH_EQUEUE_SIZE);
+
+void no_op()
+{
+}
+
+void eventqueue_dispatch()
+{
+    queue.dispatch(0);
+}
+
+void eventqueue_post_dispatch()
+{
+    queue.call(no_op);
+    queue.dispatch(0);
+}
+
+/** Benchmark a post/dispatch round trip */
+void bench_eventqueue_post_dispatch(void)
+{
+    statistics_t stats = Benchmark::measure("eventqueue_post_dispatch", eventqueue_post_dispatch);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+/** Benchmark dispatching an empty queue */
+void bench_eventqueue_dispatch_empty(void)
+{
+    statistics_t stats = Benchmark::measure("eventqueue_dispatch_empty", eventqueue_dispatch);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    Benchmark::init();
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark EventQueue post/dispatch", bench_eventqueue_post_dispatch),
+    Case("Benchmark EventQueue empty dispatch", bench_eventqueue_dispatch_empty),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
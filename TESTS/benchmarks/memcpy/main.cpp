@@ -0,0 +1,74 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "benchmark/benchmark.h"
+
+#if !DEVICE_USTICKER
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+using benchmark::v1::Benchmark;
+using benchmark::v1::statistics_t;
+
+uint8_t src_buffer[1024];
+uint8_t dst_buffer[1024];
+
+void memcpy_64()
+{
+    memcpy(dst_buffer, src_buffer, 64);
+}
+
+void memcpy_1024()
+{
+    memcpy(dst_buffer, src_buffer, 1024);
+}
+
+/** Benchmark a 64 byte aligned memcpy */
+void bench_memcpy_64(void)
+{
+    statistics_t stats = Benchmark::measure("memcpy_64", memcpy_64);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+/** Benchmark a 1024 byte aligned memcpy */
+void bench_memcpy_1024(void)
+{
+    statistics_t stats = Benchmark::measure("memcpy_1024", memcpy_1024);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    Benchmark::init();
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark memcpy 64 bytes", bench_memcpy_64),
+    Case("Benchmark memcpy 1024 bytes", bench_memcpy_1024),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,80 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+#include "benchmark/benchmark.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !DEVICE_USTICKER
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+using benchmark::v1::Benchmark;
+using benchmark::v1::statistics_t;
+
+Mutex mutex;
+
+void mutex_lock_unlock()
+{
+    mutex.lock();
+    mutex.unlock();
+}
+
+void mutex_trylock_unlock()
+{
+    mutex.trylock();
+    mutex.unlock();
+}
+
+/** Benchmark an uncontended Mutex lock/unlock pair */
+void bench_mutex_lock_unlock(void)
+{
+    statistics_t stats = Benchmark::measure("mutex_lock_unlock", mutex_lock_unlock);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+/** Benchmark an uncontended Mutex trylock/unlock pair */
+void bench_mutex_trylock_unlock(void)
+{
+    statistics_t stats = Benchmark::measure("mutex_trylock_unlock", mutex_trylock_unlock);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    Benchmark::init();
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark Mutex lock/unlock", bench_mutex_lock_unlock),
+    Case("Benchmark Mutex trylock/unlock", bench_mutex_trylock_unlock),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
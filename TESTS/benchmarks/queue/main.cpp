@@ -0,0 +1,67 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+#include "benchmark/benchmark.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !DEVICE_USTICKER
+  #error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+using benchmark::v1::Benchmark;
+using benchmark::v1::statistics_t;
+
+Queue<uint32_t, 4> queue;
+uint32_t message;
+
+void queue_put_get()
+{
+    queue.put(&message);
+    queue.get(0);
+}
+
+/** Benchmark a Queue put/get round trip */
+void bench_queue_put_get(void)
+{
+    statistics_t stats = Benchmark::measure("queue_put_get", queue_put_get);
+    TEST_ASSERT_TRUE(stats.min <= stats.max);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    Benchmark::init();
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark Queue put/get", bench_queue_put_get),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_TESTS_H
+#define BENCH_TESTS_H
+
+NetworkInterface* get_interface();
+void fill_tx_buffer_ascii(char *buff, size_t len);
+void bench_connect_to_echo_srv(TCPSocket& sock);
+void bench_connect_to_discard_srv(TCPSocket& sock);
+void bench_connect_to_chargen_srv(TCPSocket& sock);
+
+/*
+ * Send one measurement over the greentea console as a "network_benchmark"
+ * key-value pair in the form "name;amount;unit;elapsed_ms;per_sec", so
+ * numbers are comparable between targets and builds.
+ */
+void bench_report(const char *name, const char *unit, uint64_t amount, uint32_t elapsed_ms);
+
+namespace bench_global
+{
+static const int BUFF_SIZE = 1220;
+
+static const uint32_t TCP_BULK_TARGET_BYTES = 100 * 1024;
+static const int UDP_PKT_SIZE = 64;
+static const int UDP_PKT_COUNT = 500;
+static const int CONNECT_CLOSE_COUNT = 20;
+
+extern char rx_buffer[BUFF_SIZE];
+extern char tx_buffer[BUFF_SIZE];
+}
+
+/*
+ * Test cases
+ */
+void TCPSOCKET_BENCH_TX();
+void TCPSOCKET_BENCH_RX();
+void TCPSOCKET_BENCH_CONNECT_CLOSE();
+void UDPSOCKET_BENCH_PACKET_RATE();
+void DNS_BENCH_LATENCY();
+
+#endif //BENCH_TESTS_H
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "bench_tests.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#ifndef MBED_CONF_APP_DNS_TEST_HOSTS
+#define MBED_CONF_APP_DNS_TEST_HOSTS {"google.com", "youtube.com", "facebook.com", "wikipedia.org", "yahoo.com", "instagram.com"}
+#endif
+
+static const char *dns_bench_hosts[] = MBED_CONF_APP_DNS_TEST_HOSTS;
+
+void DNS_BENCH_LATENCY()
+{
+    const int host_count = sizeof(dns_bench_hosts) / sizeof(dns_bench_hosts[0]);
+    int resolved = 0;
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < host_count; i++) {
+        SocketAddress addr;
+        if (get_interface()->gethostbyname(dns_bench_hosts[i], &addr) == NSAPI_ERROR_OK) {
+            resolved++;
+        }
+    }
+    timer.stop();
+
+    bench_report("dns_lookup", "lookups", resolved, timer.read_ms());
+    TEST_ASSERT(resolved > 0);
+}
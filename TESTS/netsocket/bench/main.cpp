@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_CONF_APP_CONNECT_STATEMENT
+#error [NOT_SUPPORTED] No network configuration found for this target.
+#endif
+
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "utest/utest_stack_trace.h"
+#include "bench_tests.h"
+
+using namespace utest::v1;
+
+namespace
+{
+    NetworkInterface* net;
+}
+
+char bench_global::rx_buffer[BUFF_SIZE];
+char bench_global::tx_buffer[BUFF_SIZE];
+
+NetworkInterface* get_interface()
+{
+    return net;
+}
+
+static void _ifup() {
+    net = MBED_CONF_APP_OBJECT_CONSTRUCTION;
+    nsapi_error_t err = MBED_CONF_APP_CONNECT_STATEMENT;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    printf("MBED: Benchmark client IP address is '%s'\n", net->get_ip_address());
+}
+
+static void _ifdown() {
+    net->disconnect();
+    printf("MBED: ifdown\n");
+}
+
+static void _connect_to_port(TCPSocket& sock, uint16_t port) {
+    SocketAddress tcp_addr;
+
+    get_interface()->gethostbyname(MBED_CONF_APP_ECHO_SERVER_ADDR, &tcp_addr);
+    tcp_addr.set_port(port);
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(get_interface()));
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.connect(tcp_addr));
+}
+
+void bench_connect_to_echo_srv(TCPSocket& sock) {
+    _connect_to_port(sock, MBED_CONF_APP_ECHO_SERVER_PORT);
+}
+
+void bench_connect_to_discard_srv(TCPSocket& sock) {
+    _connect_to_port(sock, 9);
+}
+
+void bench_connect_to_chargen_srv(TCPSocket& sock) {
+    _connect_to_port(sock, 19);
+}
+
+void fill_tx_buffer_ascii(char *buff, size_t len)
+{
+    for (size_t i = 0; i<len; ++i) {
+        buff[i] = (rand() % 43) + '0';
+    }
+}
+
+void bench_report(const char *name, const char *unit, uint64_t amount, uint32_t elapsed_ms)
+{
+    uint64_t per_sec = elapsed_ms ? (amount * 1000) / elapsed_ms : 0;
+    char value[96];
+
+    snprintf(value, sizeof(value), "%s;%llu;%s;%lu;%llu",
+             name,
+             (unsigned long long)amount,
+             unit,
+             (unsigned long)elapsed_ms,
+             (unsigned long long)per_sec);
+    greentea_send_kv("network_benchmark", value);
+    printf("MBED: %s: %llu %s in %lu ms (%llu %s/s)\n",
+           name,
+           (unsigned long long)amount,
+           unit,
+           (unsigned long)elapsed_ms,
+           (unsigned long long)per_sec,
+           unit);
+}
+
+// Test setup
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(480, "default_auto");
+    _ifup();
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+void greentea_teardown(const size_t passed, const size_t failed, const failure_t failure)
+{
+    _ifdown();
+    return greentea_test_teardown_handler(passed, failed, failure);
+}
+
+Case cases[] = {
+    Case("TCPSOCKET_BENCH_TX", TCPSOCKET_BENCH_TX),
+    Case("TCPSOCKET_BENCH_RX", TCPSOCKET_BENCH_RX),
+    Case("TCPSOCKET_BENCH_CONNECT_CLOSE", TCPSOCKET_BENCH_CONNECT_CLOSE),
+    Case("UDPSOCKET_BENCH_PACKET_RATE", UDPSOCKET_BENCH_PACKET_RATE),
+    Case("DNS_BENCH_LATENCY", DNS_BENCH_LATENCY),
+};
+
+Specification specification(greentea_setup, cases, greentea_teardown);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "bench_tests.h"
+#include "TCPSocket.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+void TCPSOCKET_BENCH_CONNECT_CLOSE()
+{
+    SocketAddress tcp_addr;
+    get_interface()->gethostbyname(MBED_CONF_APP_ECHO_SERVER_ADDR, &tcp_addr);
+    tcp_addr.set_port(MBED_CONF_APP_ECHO_SERVER_PORT);
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < bench_global::CONNECT_CLOSE_COUNT; i++) {
+        TCPSocket sock;
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(get_interface()));
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.connect(tcp_addr));
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+    }
+    timer.stop();
+
+    bench_report("tcp_connect_close", "connections",
+                 bench_global::CONNECT_CLOSE_COUNT, timer.read_ms());
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "bench_tests.h"
+#include "TCPSocket.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+void TCPSOCKET_BENCH_RX()
+{
+    TCPSocket sock;
+    bench_connect_to_chargen_srv(sock);
+    sock.set_timeout(10000);
+
+    uint32_t total = 0;
+    Timer timer;
+    timer.start();
+    while (total < bench_global::TCP_BULK_TARGET_BYTES) {
+        int ret = sock.recv(bench_global::rx_buffer, bench_global::BUFF_SIZE);
+        if (ret <= 0) {
+            TEST_FAIL_MESSAGE("recv failed");
+            break;
+        }
+        total += ret;
+    }
+    timer.stop();
+
+    bench_report("tcp_rx_bulk", "bytes", total, timer.read_ms());
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
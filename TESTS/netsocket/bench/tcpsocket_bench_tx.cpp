@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "bench_tests.h"
+#include "TCPSocket.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+void TCPSOCKET_BENCH_TX()
+{
+    TCPSocket sock;
+    bench_connect_to_discard_srv(sock);
+    fill_tx_buffer_ascii(bench_global::tx_buffer, bench_global::BUFF_SIZE);
+
+    uint32_t total = 0;
+    Timer timer;
+    timer.start();
+    while (total < bench_global::TCP_BULK_TARGET_BYTES) {
+        int ret = sock.send(bench_global::tx_buffer, bench_global::BUFF_SIZE);
+        if (ret <= 0) {
+            TEST_FAIL_MESSAGE("send failed");
+            break;
+        }
+        total += ret;
+    }
+    timer.stop();
+
+    bench_report("tcp_tx_bulk", "bytes", total, timer.read_ms());
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include MBED_CONF_APP_HEADER_FILE
+#include "bench_tests.h"
+#include "UDPSocket.h"
+#include "unity/unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+void UDPSOCKET_BENCH_PACKET_RATE()
+{
+    UDPSocket sock;
+    SocketAddress udp_addr;
+    get_interface()->gethostbyname(MBED_CONF_APP_ECHO_SERVER_ADDR, &udp_addr);
+    udp_addr.set_port(MBED_CONF_APP_ECHO_SERVER_PORT);
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(get_interface()));
+    fill_tx_buffer_ascii(bench_global::tx_buffer, bench_global::UDP_PKT_SIZE);
+
+    int sent = 0;
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < bench_global::UDP_PKT_COUNT; i++) {
+        int ret = sock.sendto(udp_addr, bench_global::tx_buffer, bench_global::UDP_PKT_SIZE);
+        if (ret == bench_global::UDP_PKT_SIZE) {
+            sent++;
+        }
+    }
+    bench_report("udp_tx_packet_rate", "packets", sent, timer.read_ms());
+    TEST_ASSERT(sent > 0);
+
+    // Count the echoes that make it back - losses are expected and
+    // interesting, the send loop does not wait for the server
+    sock.set_timeout(500);
+    int received = 0;
+    while (sock.recvfrom(NULL, bench_global::rx_buffer, bench_global::BUFF_SIZE) > 0) {
+        received++;
+    }
+    timer.stop();
+    bench_report("udp_echo_packet_rate", "packets", received, timer.read_ms());
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
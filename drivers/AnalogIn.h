@@ -23,6 +23,12 @@
 #include "hal/analogin_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "platform/SingleOwnerChecker.h"
+
+#if DEVICE_ANALOGIN_BURST
+#include "platform/CThunk.h"
+#include "platform/FunctionPointer.h"
+#endif
 
 namespace mbed {
 /** \addtogroup drivers */
@@ -57,7 +63,12 @@ public:
      *
      * @param pin AnalogIn pin to connect to
      */
-    AnalogIn(PinName pin) {
+    AnalogIn(PinName pin) :
+#if DEVICE_ANALOGIN_BURST
+        _irq(this),
+#endif
+        _thread_safe(true)
+    {
         lock();
         analogin_init(&_adc, pin);
         unlock();
@@ -86,6 +97,45 @@ public:
         return ret;
     }
 
+#if DEVICE_ANALOGIN_BURST || defined(DOXYGEN_ONLY)
+
+    /** Start a burst capture of count samples into the given buffer
+     *
+     * The conversions are paced by the hardware (via DMA where the target
+     * supports it) at the requested sample rate, so streaming acquisition
+     * costs one completion callback instead of one locked read per sample.
+     * The buffer must stay valid until the callback has been invoked.
+     *
+     * @param buffer         Buffer the normalised 16-bit samples are stored to
+     * @param count          Number of samples to capture
+     * @param callback       Completion callback, invoked from interrupt context
+     * @param sample_rate_hz Requested sample rate in Hz, 0 for the maximum
+     *                       rate the ADC supports
+     * @return Zero if the capture has started, or -1 if the ADC is busy
+     */
+    int capture(uint16_t *buffer, size_t count, const event_callback_t &callback, uint32_t sample_rate_hz = 0) {
+        lock();
+        if (analogin_active(&_adc)) {
+            unlock();
+            return -1;
+        }
+        _callback = callback;
+        _irq.callback(&AnalogIn::irq_handler_asynch);
+        analogin_capture_asynch(&_adc, buffer, count, sample_rate_hz, _irq.entry(), DMA_USAGE_ALWAYS);
+        unlock();
+        return 0;
+    }
+
+    /** Abort the on-going burst capture
+     */
+    void abort_capture() {
+        lock();
+        analogin_abort_capture_asynch(&_adc);
+        unlock();
+    }
+
+#endif
+
     /** An operator shorthand for read()
      *
      * The float() operator can be used as a shorthand for read() to simplify common code sequences
@@ -104,6 +154,26 @@ public:
         return read();
     }
 
+    /** Declare whether this object is only ever used by a single thread
+     *
+     *  A single-owner AnalogIn object skips the ADC mutex in lock() and
+     *  unlock(), removing the dominant fixed cost of a read. In exchange
+     *  the caller guarantees that no other thread touches any AnalogIn
+     *  object while this one is in the single-owner state - the mutex is
+     *  shared by every AnalogIn instance. In debug builds the owning
+     *  thread is recorded on the first read and a read from any other
+     *  thread triggers an assert.
+     *
+     *  @param single_owner true to elide locking, false to restore the
+     *                      default thread safe behaviour
+     */
+    void set_single_owner(bool single_owner = true) {
+        _mutex->lock();
+        _thread_safe = !single_owner;
+        _owner_check.reset();
+        _mutex->unlock();
+    }
+
     virtual ~AnalogIn() {
         // Do nothing
     }
@@ -111,15 +181,37 @@ public:
 protected:
 
     virtual void lock() {
+        if (!_thread_safe) {
+            _owner_check.check();
+            return;
+        }
         _mutex->lock();
     }
 
     virtual void unlock() {
+        if (!_thread_safe) {
+            return;
+        }
         _mutex->unlock();
     }
 
+#if DEVICE_ANALOGIN_BURST
+    /** Capture IRQ handler, fires the user callback on completion
+     */
+    void irq_handler_asynch(void) {
+        if (analogin_irq_handler_asynch(&_adc) && _callback) {
+            _callback.call(0);
+        }
+    }
+
+    CThunk<AnalogIn> _irq;
+    event_callback_t _callback;
+#endif
+
     analogin_t _adc;
     static SingletonPtr<PlatformMutex> _mutex;
+    bool _thread_safe;
+    SingleOwnerChecker _owner_check;
 };
 
 } // namespace mbed
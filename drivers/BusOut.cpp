@@ -23,10 +23,16 @@ BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinNa
 
     // No lock needed in the constructor
     _nc_mask = 0;
+    _nr_connected = 0;
+    _cached_value = 0;
+    _cache_valid = false;
     for (int i=0; i<16; i++) {
         _pin[i] = (pins[i] != NC) ? new DigitalOut(pins[i]) : 0;
         if (pins[i] != NC) {
             _nc_mask |= (1 << i);
+            _cpin[_nr_connected] = _pin[i];
+            _cbit[_nr_connected] = i;
+            _nr_connected++;
         }
     }
 }
@@ -34,10 +40,16 @@ BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinNa
 BusOut::BusOut(PinName pins[16]) {
     // No lock needed in the constructor
     _nc_mask = 0;
+    _nr_connected = 0;
+    _cached_value = 0;
+    _cache_valid = false;
     for (int i=0; i<16; i++) {
         _pin[i] = (pins[i] != NC) ? new DigitalOut(pins[i]) : 0;
         if (pins[i] != NC) {
             _nc_mask |= (1 << i);
+            _cpin[_nr_connected] = _pin[i];
+            _cbit[_nr_connected] = i;
+            _nr_connected++;
         }
     }
 }
@@ -53,11 +65,21 @@ BusOut::~BusOut() {
 
 void BusOut::write(int value) {
     lock();
-    for (int i=0; i<16; i++) {
-        if (_pin[i] != 0) {
-            _pin[i]->write((value >> i) & 1);
+    if (_cache_valid) {
+        // Only touch the pins whose bit actually changed
+        int changed = (value ^ _cached_value) & _nc_mask;
+        for (int i=0; i<_nr_connected; i++) {
+            if ((changed >> _cbit[i]) & 1) {
+                _cpin[i]->write((value >> _cbit[i]) & 1);
+            }
+        }
+    } else {
+        for (int i=0; i<_nr_connected; i++) {
+            _cpin[i]->write((value >> _cbit[i]) & 1);
         }
+        _cache_valid = true;
     }
+    _cached_value = value;
     unlock();
 }
 
@@ -89,6 +111,9 @@ DigitalOut& BusOut::operator[] (int index) {
     // No lock needed since _pin is not modified outside the constructor
     MBED_ASSERT(index >= 0 && index <= 16);
     MBED_ASSERT(_pin[index]);
+    // The pin can be driven behind our back through the reference, so the
+    // next write() must not trust its cached value
+    _cache_valid = false;
     return *_pin[index];
 }
 
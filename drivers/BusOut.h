@@ -113,6 +113,15 @@ protected:
     virtual void unlock();
     DigitalOut* _pin[16];
 
+    /* Compacted view of the connected pins so write() does not probe the
+     * 16 possible slots, plus the last written value so only pins whose
+     * bit actually changed are touched. */
+    DigitalOut* _cpin[16];
+    uint8_t _cbit[16];
+    int _nr_connected;
+    int _cached_value;
+    bool _cache_valid;
+
     /* Mask of bus's NC pins
      * If bit[n] is set to 1 - pin is connected
      * if bit[n] is cleared - pin is not connected (NC)
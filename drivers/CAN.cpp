@@ -22,24 +22,40 @@
 
 namespace mbed {
 
-CAN::CAN(PinName rd, PinName td) : _can(), _irq() {
+CAN::CAN(PinName rd, PinName td) : _can(), _irq(),
+        _seg_rx_total(0), _seg_rx_received(0), _seg_rx_seq(0), _seg_rx_active(false) {
     // No lock needed in constructor
 
     for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
         _irq[i] = NULL;
     }
 
+#if MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE
+    for (int i = 0; i < MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS; i++) {
+        _subscriptions[i].used = false;
+        _subscriptions[i].drops = 0;
+    }
+#endif
+
     can_init(&_can, rd, td);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq() {
+CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq(),
+        _seg_rx_total(0), _seg_rx_received(0), _seg_rx_seq(0), _seg_rx_active(false) {
     // No lock needed in constructor
 
     for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
         _irq[i] = NULL;
     }
 
+#if MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE
+    for (int i = 0; i < MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS; i++) {
+        _subscriptions[i].used = false;
+        _subscriptions[i].drops = 0;
+    }
+#endif
+
     can_init_freq(&_can, rd, td, hz);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
@@ -76,6 +92,178 @@ int CAN::read(CANMessage &msg, int handle) {
     return ret;
 }
 
+#if DEVICE_CAN_FD
+
+int CAN::frequency(int hz, int data_hz) {
+    lock();
+    int ret = can_fd_frequency(&_can, hz, data_hz);
+    unlock();
+    return ret;
+}
+
+int CAN::write(const CANFDMessage &msg) {
+    lock();
+    int ret = can_fd_write(&_can, &msg, 0);
+    unlock();
+    return ret;
+}
+
+int CAN::read(CANFDMessage &msg, int handle) {
+    lock();
+    int ret = can_fd_read(&_can, &msg, handle);
+    unlock();
+    return ret;
+}
+
+#endif
+
+/* Segment framing. The first frame of a message opens with the marker
+ * byte followed by the 16-bit payload length, consecutive frames with a
+ * wrapping sequence number that never reaches the marker value; the rest
+ * of each frame is payload. On FD hardware segments are 64-byte frames
+ * sent with bitrate switching, elsewhere classic 8-byte frames. */
+#if DEVICE_CAN_FD
+#define CAN_SEG_FRAME_SIZE  64
+#else
+#define CAN_SEG_FRAME_SIZE  8
+#endif
+#define CAN_SEG_FIRST_MARKER    0xFF
+#define CAN_SEG_SEQ_MASK        0x7F
+// Retries per segment before a bus that stops draining fails the write
+#define CAN_SEG_WRITE_RETRIES   0x100000
+
+int CAN::seg_write_frame(unsigned int id, const unsigned char *data, unsigned char len, CANFormat format) {
+    for (uint32_t retry = 0; retry < CAN_SEG_WRITE_RETRIES; retry++) {
+#if DEVICE_CAN_FD
+        CANFDMessage msg((int)id, (const char *)data, len, true, format);
+        if (can_fd_write(&_can, &msg, 0)) {
+            return 1;
+        }
+#else
+        CANMessage msg((int)id, (const char *)data, len, CANData, format);
+        if (can_write(&_can, msg, 0)) {
+            return 1;
+        }
+#endif
+    }
+    return 0;
+}
+
+int CAN::seg_read_frame(unsigned int &id, unsigned char *data, unsigned char &len) {
+#if DEVICE_CAN_FD
+    CANFDMessage msg;
+    if (!can_fd_read(&_can, &msg, 0)) {
+        return 0;
+    }
+#else
+    CANMessage msg;
+    if (!can_read(&_can, &msg, 0)) {
+        return 0;
+    }
+#endif
+    id = msg.id;
+    len = msg.len;
+    memcpy(data, msg.data, msg.len);
+    return 1;
+}
+
+int CAN::write_segmented(unsigned int id, const unsigned char *data, unsigned int length, CANFormat format) {
+    if (length > 0xFFFF) {
+        return 0;
+    }
+    lock();
+    unsigned char frame[CAN_SEG_FRAME_SIZE];
+
+    // First frame: marker, announced length, then as much payload as fits
+    frame[0] = CAN_SEG_FIRST_MARKER;
+    frame[1] = (unsigned char)(length >> 8);
+    frame[2] = (unsigned char)length;
+    unsigned int chunk = length;
+    if (chunk > CAN_SEG_FRAME_SIZE - 3) {
+        chunk = CAN_SEG_FRAME_SIZE - 3;
+    }
+    memcpy(&frame[3], data, chunk);
+    if (!seg_write_frame(id, frame, (unsigned char)(3 + chunk), format)) {
+        unlock();
+        return 0;
+    }
+
+    // Consecutive frames, each headed by its sequence number
+    unsigned int sent = chunk;
+    unsigned char seq = 0;
+    while (sent < length) {
+        frame[0] = seq;
+        seq = (seq + 1) & CAN_SEG_SEQ_MASK;
+        chunk = length - sent;
+        if (chunk > CAN_SEG_FRAME_SIZE - 1) {
+            chunk = CAN_SEG_FRAME_SIZE - 1;
+        }
+        memcpy(&frame[1], &data[sent], chunk);
+        if (!seg_write_frame(id, frame, (unsigned char)(1 + chunk), format)) {
+            unlock();
+            return 0;
+        }
+        sent += chunk;
+    }
+    unlock();
+    return 1;
+}
+
+int CAN::read_segmented(unsigned int id, unsigned char *buffer, unsigned int size) {
+    lock();
+    unsigned int rx_id;
+    unsigned char frame[CAN_SEG_FRAME_SIZE];
+    unsigned char len;
+
+    while (seg_read_frame(rx_id, frame, len)) {
+        if ((rx_id != id) || (len == 0)) {
+            // Not segmented traffic - the engine owns this id only
+            continue;
+        }
+        if (frame[0] == CAN_SEG_FIRST_MARKER) {
+            // First frame restarts reassembly, dropping any partial message
+            if (len < 3) {
+                continue;
+            }
+            _seg_rx_total = ((unsigned int)frame[1] << 8) | frame[2];
+            if (_seg_rx_total > size) {
+                _seg_rx_active = false;
+                unlock();
+                return -1;
+            }
+            unsigned int chunk = len - 3;
+            if (chunk > _seg_rx_total) {
+                chunk = _seg_rx_total;
+            }
+            memcpy(buffer, &frame[3], chunk);
+            _seg_rx_received = chunk;
+            _seg_rx_seq = 0;
+            _seg_rx_active = true;
+        } else if (_seg_rx_active) {
+            if (frame[0] != _seg_rx_seq) {
+                // Lost a segment - drop the message, wait for a first frame
+                _seg_rx_active = false;
+                continue;
+            }
+            _seg_rx_seq = (_seg_rx_seq + 1) & CAN_SEG_SEQ_MASK;
+            unsigned int chunk = len - 1;
+            if (chunk > _seg_rx_total - _seg_rx_received) {
+                // Padding from DLC rounding on the final segment
+                chunk = _seg_rx_total - _seg_rx_received;
+            }
+            memcpy(&buffer[_seg_rx_received], &frame[1], chunk);
+            _seg_rx_received += chunk;
+        }
+        if (_seg_rx_active && (_seg_rx_received >= _seg_rx_total)) {
+            _seg_rx_active = false;
+            unlock();
+            return _seg_rx_total;
+        }
+    }
+    unlock();
+    return 0;
+}
+
 void CAN::reset() {
     lock();
     can_reset(&_can);
@@ -109,6 +297,90 @@ int CAN::mode(Mode mode) {
     return ret;
 }
 
+#if MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE
+
+int CAN::subscribe(unsigned int id, unsigned int mask, CANFormat format, Callback<void()> notify) {
+    lock();
+    int sub = -1;
+    for (int i = 0; i < MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS; i++) {
+        if (!_subscriptions[i].used) {
+            sub = i;
+            break;
+        }
+    }
+    if (sub < 0) {
+        unlock();
+        return -1;
+    }
+
+    // Bind a hardware acceptance filter for this rule where the target
+    // supports it; software demultiplexing below works either way, the
+    // filter just keeps unsubscribed traffic off the CPU.
+    can_filter(&_can, id, mask, format, 0);
+
+    _subscriptions[sub].id = id;
+    _subscriptions[sub].mask = mask;
+    _subscriptions[sub].format = format;
+    _subscriptions[sub].notify = notify;
+    _subscriptions[sub].drops = 0;
+    _subscriptions[sub].queue.reset();
+    _subscriptions[sub].used = true;
+
+    attach(callback(this, &CAN::rx_queue_irq), RxIrq);
+    unlock();
+    return sub;
+}
+
+void CAN::rx_queue_irq() {
+    CANMessage msg;
+
+    /* Drain the peripheral and route each frame to the first matching
+     * subscription; subscriptions are matched in creation order, so the
+     * earliest one acts as the highest priority rule. */
+    while (can_read(&_can, &msg, 0)) {
+        for (int i = 0; i < MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS; i++) {
+            rx_subscription &s = _subscriptions[i];
+            if (!s.used) {
+                continue;
+            }
+            if ((s.format != CANAny) && (s.format != msg.format)) {
+                continue;
+            }
+            if ((msg.id & s.mask) != (s.id & s.mask)) {
+                continue;
+            }
+            if (s.queue.full()) {
+                s.drops++;
+            } else {
+                s.queue.push(msg);
+                if (s.notify) {
+                    s.notify();
+                }
+            }
+            break;
+        }
+    }
+}
+
+int CAN::read_subscription(int sub, CANMessage &msg) {
+    if ((sub < 0) || (sub >= MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS) ||
+            !_subscriptions[sub].used) {
+        return 0;
+    }
+    // The queue is interrupt safe, no bus lock needed on the hot path
+    return _subscriptions[sub].queue.pop(msg) ? 1 : 0;
+}
+
+unsigned int CAN::subscription_drops(int sub) {
+    if ((sub < 0) || (sub >= MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS) ||
+            !_subscriptions[sub].used) {
+        return 0;
+    }
+    return _subscriptions[sub].drops;
+}
+
+#endif
+
 int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle) {
     lock();
     int ret = can_filter(&_can, id, mask, format, handle);
@@ -25,6 +25,14 @@
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 
+#if MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE
+#include "platform/CircularBuffer.h"
+
+#ifndef MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS
+#define MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS 4
+#endif
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -76,6 +84,65 @@ public:
     }
 };
 
+/** CANFDMessage class
+ *
+ * A CAN FD frame with up to 64 data bytes. The data length is rounded up
+ * to the next valid FD DLC size (0-8, 12, 16, 20, 24, 32, 48 or 64) and
+ * zero padded, matching what the hardware puts on the wire.
+ *
+ * @note Synchronization level: Thread safe
+ * @ingroup drivers
+ */
+class CANFDMessage : public CAN_FD_Message {
+
+public:
+    /** Creates empty CAN FD message.
+     */
+    CANFDMessage() : CAN_FD_Message() {
+        len    = 0;
+        brs    = 1;
+        format = CANStandard;
+        id     = 0;
+        memset(data, 0, 64);
+    }
+
+    /** Creates CAN FD message with specific content.
+     *
+     *  @param _id      Message ID
+     *  @param _data    Message Data
+     *  @param _len     Message Data length, rounded up to a valid FD DLC size
+     *  @param _brs     Switch to the data-phase bitrate for the data field
+     *  @param _format  Data Format: Use enum CANFormat for valid parameter values
+     */
+    CANFDMessage(int _id, const char *_data, unsigned char _len = 64, bool _brs = true, CANFormat _format = CANStandard) {
+      len    = dlc_round(_len);
+      brs    = _brs ? 1 : 0;
+      format = _format;
+      id     = _id;
+      memset(data, 0, 64);
+      memcpy(data, _data, (_len > 64) ? 64 : _len);
+    }
+
+    /** Round a byte count up to the next valid CAN FD data length
+     *
+     *  @param length byte count (0-64)
+     *
+     *  @returns the smallest valid FD data length holding length bytes
+     */
+    static unsigned char dlc_round(unsigned char length) {
+        static const unsigned char sizes[] = {12, 16, 20, 24, 32, 48, 64};
+        if (length <= 8) {
+            return length;
+        }
+        for (size_t i = 0; i < sizeof sizes; i++) {
+            if (length <= sizes[i]) {
+                return sizes[i];
+            }
+        }
+        return 64;
+    }
+};
+
 /** A can bus client, used for communicating with can devices
  * @ingroup drivers
  */
@@ -163,6 +230,89 @@ public:
      */
     int read(CANMessage &msg, int handle = 0);
 
+#if DEVICE_CAN_FD || defined(DOXYGEN_ONLY)
+
+    /** Set the nominal and data-phase frequencies of a CAN FD interface
+     *
+     *  @param hz the arbitration-phase frequency in hertz
+     *  @param data_hz the data-phase frequency in hertz, used by frames
+     *                 sent with the bitrate switch flag
+     *
+     *  @returns
+     *    1 if successful,
+     *    0 otherwise
+     */
+    int frequency(int hz, int data_hz);
+
+    /** Write a CANFDMessage to the bus.
+     *
+     *  @param msg The CANFDMessage to write.
+     *
+     *  @returns
+     *    0 if write failed,
+     *    1 if write was successful
+     */
+    int write(const CANFDMessage &msg);
+
+    /** Read a CANFDMessage from the bus.
+     *
+     *  @param msg A CANFDMessage to read to.
+     *  @param handle message filter handle (0 for any message)
+     *
+     *  @returns
+     *    0 if no message arrived,
+     *    1 if message arrived
+     */
+    int read(CANFDMessage &msg, int handle = 0);
+
+#endif
+
+    /** Write a payload larger than one frame as a segmented message
+     *
+     *  The payload is split into a first frame announcing the total
+     *  length followed by sequence-numbered consecutive frames, all sent
+     *  under the given id - 64-byte frames with bitrate switching on FD
+     *  hardware, classic 8-byte frames otherwise. read_segmented() on
+     *  the receiving node reassembles them transparently. The id must be
+     *  dedicated to segmented traffic.
+     *
+     *  Blocks until every segment has been accepted by a transmit
+     *  mailbox; a bus that stops draining fails the call instead of
+     *  hanging it. A failed or interrupted message is discarded by the
+     *  receiver when the next first frame arrives.
+     *
+     *  @param id the message id used for every segment
+     *  @param data payload to send
+     *  @param length payload length in bytes (up to 65535)
+     *  @param format format of the segments (Default CANStandard)
+     *
+     *  @returns
+     *    0 if a segment could not be sent,
+     *    1 if the whole payload was sent
+     */
+    int write_segmented(unsigned int id, const unsigned char *data, unsigned int length, CANFormat format = CANStandard);
+
+    /** Reassemble a segmented message sent with write_segmented()
+     *
+     *  Drains received frames into the caller's buffer and returns the
+     *  payload length once the final segment has arrived. Non-blocking -
+     *  call repeatedly (polled or per RxIrq) with the same buffer while
+     *  a message is in flight. A lost segment discards the partial
+     *  message and reassembly restarts at the next first frame. Frames
+     *  under other ids are discarded, so the instance's acceptance
+     *  filter should only pass the segmented id.
+     *
+     *  @param id the message id carrying the segments
+     *  @param buffer buffer the payload is assembled into
+     *  @param size buffer size in bytes
+     *
+     *  @returns
+     *    assembled payload length once complete,
+     *    0 while the message is incomplete,
+     *    -1 if the announced payload does not fit in size bytes
+     */
+    int read_segmented(unsigned int id, unsigned char *buffer, unsigned int size);
+
     /** Reset CAN interface.
      *
      * To use after error overflow.
@@ -207,6 +357,52 @@ public:
      */
     int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
 
+#if MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE || defined(DOXYGEN_ONLY)
+
+    /** Subscribe to received frames matching an id/mask pair
+     *
+     *  Binds a hardware acceptance filter to a dedicated receive queue.
+     *  Frames are demultiplexed into the queues from the receive interrupt,
+     *  earliest subscription matched first, so high-priority traffic is
+     *  never queued behind frames belonging to another subscription and
+     *  the application no longer demultiplexes in software.
+     *
+     *  Subscribing takes over the receive interrupt; CAN::read() should
+     *  not be mixed with subscriptions on the same instance.
+     *
+     *  @param id the id to subscribe to
+     *  @param mask the mask applied to the id
+     *  @param format format to filter on (Default CANAny)
+     *  @param notify optional callback invoked from interrupt context when
+     *                a frame has been queued to this subscription
+     *
+     *  @returns
+     *    negative value if no subscription slot or hardware filter was
+     *    available, subscription handle otherwise
+     */
+    int subscribe(unsigned int id, unsigned int mask, CANFormat format = CANAny, Callback<void()> notify = NULL);
+
+    /** Read the oldest queued frame of a subscription
+     *
+     *  @param sub subscription handle returned by subscribe()
+     *  @param msg A CANMessage to read to
+     *
+     *  @returns
+     *    0 if no message was queued,
+     *    1 if a message was read from the queue
+     */
+    int read_subscription(int sub, CANMessage &msg);
+
+    /** Number of frames dropped because a subscription queue was full
+     *
+     *  @param sub subscription handle returned by subscribe()
+     *
+     *  @returns number of dropped frames, or 0 for an invalid handle
+     */
+    unsigned int subscription_drops(int sub);
+
+#endif
+
     /**  Detects read errors - Used to detect read overflow errors.
      *
      *  @returns number of read errors
@@ -286,9 +482,45 @@ public:
 protected:
     virtual void lock();
     virtual void unlock();
+    /** Sends one segment, retrying while the transmit mailboxes are full */
+    int seg_write_frame(unsigned int id, const unsigned char *data, unsigned char len, CANFormat format);
+
+    /** Pulls one received frame for the reassembly engine
+     *
+     *  @param id the received message id
+     *  @param data buffer for the frame payload, one frame large
+     *  @param len the received payload length
+     *
+     *  @returns 0 if no frame was available, 1 otherwise
+     */
+    int seg_read_frame(unsigned int &id, unsigned char *data, unsigned char &len);
+
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
+
+    unsigned int        _seg_rx_total;      /**< Announced payload length of the message in flight. */
+    unsigned int        _seg_rx_received;   /**< Bytes reassembled so far. */
+    unsigned char       _seg_rx_seq;        /**< Next expected consecutive frame number. */
+    bool                _seg_rx_active;     /**< A first frame has been seen and reassembly is running. */
+
+#if MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE
+    /** Per-subscription state: matching rule plus a dedicated receive ring */
+    struct rx_subscription {
+        unsigned int id;
+        unsigned int mask;
+        CANFormat format;
+        Callback<void()> notify;
+        unsigned int drops;
+        bool used;
+        CircularBuffer<CANMessage, MBED_CONF_DRIVERS_CAN_RX_QUEUE_SIZE> queue;
+    };
+
+    /** Drains the peripheral and routes frames to subscription queues */
+    void rx_queue_irq();
+
+    rx_subscription _subscriptions[MBED_CONF_DRIVERS_CAN_RX_SUBSCRIPTIONS];
+#endif
 };
 
 } // namespace mbed
@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/DeferredTicker.h"
+
+#include "events/equeue/equeue.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+
+DeferredTicker::DeferredTicker(events::EventQueue *queue) :
+    Ticker(), _queue(queue), _slot(NULL), _post_id(0), _overruns(0)
+{
+    replenish();
+}
+
+DeferredTicker::DeferredTicker(events::EventQueue *queue, const ticker_data_t *data) :
+    Ticker(data), _queue(queue), _slot(NULL), _post_id(0), _overruns(0)
+{
+    replenish();
+}
+
+DeferredTicker::~DeferredTicker()
+{
+    detach();
+
+    core_util_critical_section_enter();
+    void *slot = _slot;
+    int id = _post_id;
+    _slot = NULL;
+    _post_id = 0;
+    core_util_critical_section_exit();
+
+    if (slot) {
+        equeue_dealloc(&_queue->_equeue, slot);
+    }
+    if (id) {
+        equeue_cancel(&_queue->_equeue, id);
+    }
+}
+
+void DeferredTicker::replenish()
+{
+    void *slot = equeue_alloc(&_queue->_equeue, sizeof(DeferredTicker *));
+    if (slot) {
+        *static_cast<DeferredTicker **>(slot) = this;
+    }
+
+    core_util_critical_section_enter();
+    _post_id = 0;
+    _slot = slot;
+    core_util_critical_section_exit();
+}
+
+void DeferredTicker::handler()
+{
+    insert_absolute(event.timestamp + _delay);
+
+    if (!_slot) {
+        // Previous dispatch still queued (or the queue was out of memory
+        // when it tried to replenish) - drop this tick. Try to replenish
+        // here so a transient overload doesn't stall the ticker for good;
+        // equeue_alloc is irq safe, this is just not the steady-state path.
+        _overruns++;
+        if (!_post_id) {
+            void *slot = equeue_alloc(&_queue->_equeue, sizeof(DeferredTicker *));
+            if (slot) {
+                *static_cast<DeferredTicker **>(slot) = this;
+                _slot = slot;
+            }
+        }
+        return;
+    }
+
+    void *slot = _slot;
+    _slot = NULL;
+    _post_id = equeue_post(&_queue->_equeue, &DeferredTicker::dispatch, slot);
+}
+
+void DeferredTicker::dispatch(void *data)
+{
+    DeferredTicker *self = *static_cast<DeferredTicker **>(data);
+
+    // Arm the slot for the next period before running user code, so a
+    // tick during a long callback queues the next dispatch instead of
+    // being dropped
+    self->replenish();
+
+    core_util_critical_section_enter();
+    Callback<void()> function = self->_function;
+    core_util_critical_section_exit();
+
+    if (function) {
+        function();
+    }
+}
+
+} // namespace mbed
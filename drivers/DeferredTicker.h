@@ -0,0 +1,93 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DEFERREDTICKER_H
+#define MBED_DEFERREDTICKER_H
+
+#include "drivers/Ticker.h"
+#include "events/EventQueue.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A Ticker that runs its callback on an EventQueue instead of in the ISR
+ *
+ *  The attached function gets periodic task semantics: the ticker ISR only
+ *  posts a preallocated event slot onto the designated queue - no user
+ *  code and no allocation runs in interrupt context - and the queue's
+ *  dispatch context does the work. The slot for the next period is
+ *  replenished in dispatch context, so the steady-state ISR cost is one
+ *  event post.
+ *
+ *  If a tick fires while the previous dispatch is still queued, that tick
+ *  is dropped and counted; see overruns(). The callback then runs once
+ *  for the backlog rather than piling up.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * @note The queue must outlive the ticker, and the ticker must not be
+ * destroyed while a dispatch of its callback is executing - destroy it
+ * from the queue's dispatch context or with the queue stopped.
+ *
+ * @ingroup drivers
+ */
+class DeferredTicker : public Ticker, private NonCopyable<DeferredTicker> {
+
+public:
+    /** Create a ticker dispatching on the given queue
+     *
+     *  @param queue the EventQueue the callback is posted to
+     */
+    DeferredTicker(events::EventQueue *queue);
+
+    /** Create a ticker dispatching on the given queue, using a custom
+     *  ticker source
+     *
+     *  @param queue the EventQueue the callback is posted to
+     *  @param data  the ticker data to drive the timing from
+     */
+    DeferredTicker(events::EventQueue *queue, const ticker_data_t *data);
+
+    virtual ~DeferredTicker();
+
+    /** Number of ticks dropped because the previous dispatch was still
+     *  pending or the queue was out of memory
+     *
+     *  @return dropped tick count since construction
+     */
+    uint32_t overruns() const
+    {
+        return _overruns;
+    }
+
+protected:
+    virtual void handler();
+
+    /** Dispatch trampoline run by the event queue */
+    static void dispatch(void *data);
+
+    /** Allocate the event slot for the next post, in dispatch context */
+    void replenish();
+
+    events::EventQueue *_queue;     /**< Queue the callback is posted to. */
+    void *_slot;                    /**< Preallocated event slot, NULL while posted. */
+    int _post_id;                   /**< Id of the outstanding post, 0 if none. */
+    uint32_t _overruns;             /**< Ticks dropped, see overruns(). */
+};
+
+} // namespace mbed
+
+#endif
@@ -19,9 +19,17 @@
 
 #include "hal/ethernet_api.h"
 
+#if MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE
+#include "hal/us_ticker_api.h"
+#endif
+
 namespace mbed {
 
-Ethernet::Ethernet() {
+Ethernet::Ethernet()
+#if MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE
+    : _pace_period_us(0), _pace_burst(1), _pace_tokens(1), _pace_last_us(0)
+#endif
+{
     ethernet_init();
 }
 
@@ -53,6 +61,76 @@ int Ethernet::link() {
     return ethernet_link();
 }
 
+#if MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE
+
+void Ethernet::set_pacing(unsigned int frames_per_sec, unsigned int burst) {
+    _pace_period_us = frames_per_sec ? (1000000 / frames_per_sec) : 0;
+    _pace_burst = burst ? burst : 1;
+    // Start with a full bucket so the first frames are not delayed
+    _pace_tokens = _pace_burst;
+    _pace_last_us = ticker_read_us(get_us_ticker_data());
+}
+
+int Ethernet::write_frame(const char *data, int size) {
+    if (_tx_queue.full()) {
+        return 0;
+    }
+    tx_descriptor desc;
+    desc.data = data;
+    desc.length = size;
+    _tx_queue.push(desc);
+    return 1;
+}
+
+int Ethernet::send_queued() {
+    if (_pace_period_us) {
+        // Refill the bucket with the tokens earned since the last pump,
+        // advancing the refill time by whole tokens so fractions carry over
+        us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+        us_timestamp_t earned = (now - _pace_last_us) / _pace_period_us;
+        if (earned >= _pace_burst - _pace_tokens) {
+            _pace_tokens = _pace_burst;
+            _pace_last_us = now;
+        } else {
+            _pace_tokens += (unsigned int)earned;
+            _pace_last_us += earned * _pace_period_us;
+        }
+    }
+
+    int sent = 0;
+    tx_descriptor desc;
+    while (_tx_queue.peek(desc)) {
+        if (_pace_period_us && (_pace_tokens == 0)) {
+            break;
+        }
+        if (ethernet_write(desc.data, desc.length) == desc.length) {
+            if (ethernet_send() != 0) {
+                sent++;
+            }
+            // A failed send loses the staged packet, exactly as it does
+            // on the plain write()/send() path
+            if (_pace_period_us) {
+                _pace_tokens--;
+            }
+        }
+        // Sent, lost or unstageable - either way the driver is finished
+        // with the buffer, hand it back to the caller
+        _tx_queue.pop(desc);
+        _tx_done.push(desc.data);
+    }
+    return sent;
+}
+
+const char *Ethernet::reclaim() {
+    const char *data;
+    if (_tx_done.pop(data)) {
+        return data;
+    }
+    return NULL;
+}
+
+#endif
+
 void Ethernet::set_link(Mode mode) {
     int speed = -1;
     int duplex = 0;
@@ -21,6 +21,11 @@
 
 #if defined (DEVICE_ETHERNET) || defined(DOXYGEN_ONLY)
 
+#if MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE
+#include "platform/CircularBuffer.h"
+#include "hal/ticker_api.h"
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -167,6 +172,76 @@ public:
      *  @param mode the speed and duplex mode to set the link to:
      */
     void set_link(Mode mode);
+
+#if MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE || defined(DOXYGEN_ONLY)
+
+    /** Configure software pacing of queued frame transmission
+     *
+     *  Pacing spreads the frames queued with write_frame() over time with
+     *  a token bucket: tokens accrue at frames_per_sec and send_queued()
+     *  only transmits while a token is available, so a streaming sender
+     *  puts frames on the wire at a steady rate instead of in bursts.
+     *
+     *  @param frames_per_sec sustained transmission rate, 0 to disable
+     *                        pacing (queued frames are sent immediately)
+     *  @param burst          maximum number of frames sent back to back
+     *                        after an idle period (default 1)
+     */
+    void set_pacing(unsigned int frames_per_sec, unsigned int burst = 1);
+
+    /** Queue a frame for transmission without copying it
+     *
+     *  The buffer is lent to the driver, not copied: it must stay valid
+     *  and unchanged until it comes back through reclaim(). Frames are
+     *  transmitted by send_queued() in queueing order, subject to the
+     *  pacing budget.
+     *
+     *  @param data the frame, starting at the destination address
+     *  @param size the frame size in bytes
+     *
+     *  @returns
+     *    0 if the queue was full,
+     *    1 if the frame was queued
+     */
+    int write_frame(const char *data, int size);
+
+    /** Transmit queued frames allowed by the pacing budget
+     *
+     *  Non-blocking; transmits queued frames until the tokens or the
+     *  queue run out and lists the buffers it finished with for
+     *  reclaim(). A frame the hardware rejects is lost, matching the
+     *  plain write()/send() contract, and its buffer is handed back all
+     *  the same. Call this from the main loop or a ticker at least as
+     *  often as a pacing token is earned to sustain the configured rate.
+     *
+     *  @returns the number of frames put on the wire
+     */
+    int send_queued();
+
+    /** Take back a buffer lent with write_frame()
+     *
+     *  @returns
+     *    a buffer the driver has finished transmitting and no longer
+     *    holds, or NULL if none is waiting
+     */
+    const char *reclaim();
+
+private:
+
+    /** A frame lent to the transmit queue */
+    struct tx_descriptor {
+        const char *data;
+        int length;
+    };
+
+    CircularBuffer<tx_descriptor, MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE> _tx_queue;
+    CircularBuffer<const char *, MBED_CONF_DRIVERS_ETHERNET_TX_QUEUE_SIZE> _tx_done;
+
+    unsigned int  _pace_period_us;  /**< Microseconds per earned token, 0 when pacing is off. */
+    unsigned int  _pace_burst;      /**< Token bucket capacity. */
+    unsigned int  _pace_tokens;     /**< Tokens available right now. */
+    us_timestamp_t _pace_last_us;   /**< Time the bucket was last refilled. */
+#endif
 };
 
 } // namespace mbed
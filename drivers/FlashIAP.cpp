@@ -42,7 +42,9 @@ static inline bool is_aligned(uint32_t number, uint32_t alignment)
     }
 }
 
-FlashIAP::FlashIAP()
+FlashIAP::FlashIAP() :
+    _async_buf(NULL), _async_addr(0), _async_addr2(0), _async_size(0),
+    _compare_buf(NULL)
 {
 
 }
@@ -74,6 +76,8 @@ int FlashIAP::deinit()
         ret = -1;
     }
     delete[] _page_buf;
+    delete[] _compare_buf;
+    _compare_buf = NULL;
     _mutex->unlock();
     return ret;
 }
@@ -183,6 +187,270 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
     return ret;
 }
 
+int FlashIAP::erase_start(uint32_t addr, uint32_t size)
+{
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t flash_end_addr = flash_start_addr + flash_size;
+    uint32_t erase_end_addr = addr + size;
+
+    if (erase_end_addr > flash_end_addr) {
+        return -1;
+    } else if (erase_end_addr < flash_end_addr) {
+        uint32_t following_sector_size = flash_get_sector_size(&_flash, erase_end_addr);
+        if (!is_aligned(erase_end_addr, following_sector_size)) {
+            return -1;
+        }
+    }
+    if (!is_aligned_to_sector(addr, size)) {
+        return -1;
+    }
+
+    _mutex->lock();
+    delete[] _compare_buf;
+    _compare_buf = NULL;
+    _async_buf = NULL;
+    _async_addr = addr;
+    _async_size = size;
+    _mutex->unlock();
+    return 0;
+}
+
+int FlashIAP::erase_step()
+{
+    int32_t ret = 0;
+    _mutex->lock();
+    if (_async_size) {
+        if (flash_erase_sector(&_flash, _async_addr)) {
+            _async_size = 0;
+            ret = -1;
+        } else {
+            uint32_t current_sector_size = flash_get_sector_size(&_flash, _async_addr);
+            _async_size -= current_sector_size;
+            _async_addr += current_sector_size;
+            ret = _async_size;
+        }
+    }
+    uint32_t remaining = _async_size;
+    _mutex->unlock();
+    if (ret >= 0 && _progress_cb) {
+        _progress_cb(remaining);
+    }
+    return ret;
+}
+
+int FlashIAP::program_start(const void *buffer, uint32_t addr, uint32_t size)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+
+    // The stepped variant takes no staging copy, so both the address and
+    // the source buffer alignment have to fit the flash HAL directly
+    if (!is_aligned(addr, page_size) || !is_aligned(size, page_size) ||
+        (!buffer) || (((size_t) buffer % sizeof(uint32_t)) != 0) ||
+        ((addr + size) > (flash_start_addr + flash_size))) {
+        return -1;
+    }
+
+    _mutex->lock();
+    delete[] _compare_buf;
+    _compare_buf = NULL;
+    _async_buf = (const uint8_t *) buffer;
+    _async_addr = addr;
+    _async_size = size;
+    _mutex->unlock();
+    return 0;
+}
+
+int FlashIAP::program_step()
+{
+    uint32_t page_size = get_page_size();
+    int32_t ret = 0;
+    _mutex->lock();
+    if (_async_size) {
+        if (flash_program_page(&_flash, _async_addr, _async_buf, page_size)) {
+            _async_size = 0;
+            ret = -1;
+        } else {
+            _async_size -= page_size;
+            _async_addr += page_size;
+            _async_buf += page_size;
+            ret = _async_size;
+        }
+    }
+    uint32_t remaining = _async_size;
+    _mutex->unlock();
+    if (ret >= 0 && _progress_cb) {
+        _progress_cb(remaining);
+    }
+    return ret;
+}
+
+int FlashIAP::verify(const void *buffer, uint32_t addr, uint32_t size)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    const uint8_t *buf = (const uint8_t *) buffer;
+
+    if ((!buffer) || ((addr + size) > (flash_start_addr + flash_size))) {
+        return -1;
+    }
+
+    int ret = 0;
+    _mutex->lock();
+    while (size) {
+        uint32_t chunk = std::min(size, page_size);
+        if (flash_read(&_flash, addr, _page_buf, chunk)) {
+            ret = -1;
+            break;
+        }
+        if (memcmp(_page_buf, buf, chunk)) {
+            ret = 1;
+            break;
+        }
+        size -= chunk;
+        addr += chunk;
+        buf += chunk;
+    }
+    _mutex->unlock();
+    return ret;
+}
+
+int FlashIAP::compare(uint32_t addr1, uint32_t addr2, uint32_t size)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t flash_end_addr = flash_start_addr + flash_size;
+
+    if (((addr1 + size) > flash_end_addr) || ((addr2 + size) > flash_end_addr)) {
+        return -1;
+    }
+
+    uint8_t *second_buf = new uint8_t[page_size];
+    int ret = 0;
+    _mutex->lock();
+    while (size) {
+        uint32_t chunk = std::min(size, page_size);
+        if (flash_read(&_flash, addr1, _page_buf, chunk) ||
+            flash_read(&_flash, addr2, second_buf, chunk)) {
+            ret = -1;
+            break;
+        }
+        if (memcmp(_page_buf, second_buf, chunk)) {
+            ret = 1;
+            break;
+        }
+        size -= chunk;
+        addr1 += chunk;
+        addr2 += chunk;
+    }
+    _mutex->unlock();
+    delete[] second_buf;
+    return ret;
+}
+
+int FlashIAP::verify_start(const void *buffer, uint32_t addr, uint32_t size)
+{
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+
+    if ((!buffer) || ((addr + size) > (flash_start_addr + flash_size))) {
+        return -1;
+    }
+
+    // The stepped compares use their own buffer rather than _page_buf, so
+    // program() calls interleaved between steps cannot clobber the data
+    // a comparison is working on
+    uint32_t page_size = get_page_size();
+    _mutex->lock();
+    delete[] _compare_buf;
+    _compare_buf = new uint8_t[page_size];
+    _async_buf = (const uint8_t *) buffer;
+    _async_addr = addr;
+    _async_addr2 = 0;
+    _async_size = size;
+    _mutex->unlock();
+    return 0;
+}
+
+int FlashIAP::compare_start(uint32_t addr1, uint32_t addr2, uint32_t size)
+{
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t flash_end_addr = flash_start_addr + flash_size;
+
+    if (((addr1 + size) > flash_end_addr) || ((addr2 + size) > flash_end_addr)) {
+        return -1;
+    }
+
+    uint32_t page_size = get_page_size();
+    _mutex->lock();
+    delete[] _compare_buf;
+    _compare_buf = new uint8_t[2 * page_size];
+    _async_buf = NULL;
+    _async_addr = addr1;
+    _async_addr2 = addr2;
+    _async_size = size;
+    _mutex->unlock();
+    return 0;
+}
+
+int FlashIAP::compare_step()
+{
+    uint32_t page_size = get_page_size();
+    int32_t ret = 0;
+    _mutex->lock();
+    if (_async_size) {
+        uint32_t chunk = std::min(_async_size, page_size);
+        const uint8_t *ref = _async_buf;
+        if (flash_read(&_flash, _async_addr, _compare_buf, chunk)) {
+            ret = -1;
+        } else if (!ref) {
+            if (flash_read(&_flash, _async_addr2, _compare_buf + page_size, chunk)) {
+                ret = -1;
+            } else {
+                ref = _compare_buf + page_size;
+            }
+        }
+        if (ret == 0) {
+            if (memcmp(_compare_buf, ref, chunk)) {
+                ret = -2;
+            } else {
+                _async_size -= chunk;
+                _async_addr += chunk;
+                _async_addr2 += chunk;
+                if (_async_buf) {
+                    _async_buf += chunk;
+                }
+                ret = _async_size;
+            }
+        }
+        if (ret < 0) {
+            _async_size = 0;
+        }
+        if (_async_size == 0) {
+            delete[] _compare_buf;
+            _compare_buf = NULL;
+        }
+    }
+    uint32_t remaining = _async_size;
+    _mutex->unlock();
+    if (ret >= 0 && _progress_cb) {
+        _progress_cb(remaining);
+    }
+    return ret;
+}
+
+void FlashIAP::attach_progress(Callback<void(uint32_t)> progress)
+{
+    _mutex->lock();
+    _progress_cb = progress;
+    _mutex->unlock();
+}
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
@@ -28,6 +28,7 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -88,6 +89,124 @@ public:
      */
     int erase(uint32_t addr, uint32_t size);
 
+    /** Begin an interruptible erase
+     *
+     *  Validates the range and records it; no flash operation is performed
+     *  yet. The erase is then advanced one sector at a time with
+     *  erase_step(), with the mutex released between steps so other
+     *  threads (and other FlashIAP users) are stalled for at most one
+     *  sector erase instead of the whole range.
+     *
+     *  @param addr Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size Size to erase in bytes, must be a multiple of the sector size
+     *  @return     0 on success, negative error code on failure
+     */
+    int erase_start(uint32_t addr, uint32_t size);
+
+    /** Erase one sector of the range set up with erase_start()
+     *
+     *  Call repeatedly - typically from a low priority thread or an event
+     *  queue - until it returns 0. The progress callback, if attached, is
+     *  invoked after each step with the number of bytes still to erase.
+     *
+     *  @return     Positive number of bytes still to be erased, 0 when the
+     *              erase has completed, negative error code on failure
+     */
+    int erase_step();
+
+    /** Begin an interruptible program
+     *
+     *  The counterpart of erase_start() for programming: the data is then
+     *  written one program page per program_step() call. The buffer must
+     *  stay valid until the operation has completed.
+     *
+     *  @param buffer Buffer of data to be written, must be uint32_t aligned
+     *  @param addr   Address of a page to begin writing to, must be a multiple of the program page size
+     *  @param size   Size to write in bytes, must be a multiple of the program page size
+     *  @return       0 on success, negative error code on failure
+     */
+    int program_start(const void *buffer, uint32_t addr, uint32_t size);
+
+    /** Program one page of the data set up with program_start()
+     *
+     *  @return     Positive number of bytes still to be programmed, 0 when
+     *              the program has completed, negative error code on failure
+     */
+    int program_step();
+
+    /** Verify flash contents against a buffer
+     *
+     *  Compares the flash range against the buffer without copying the
+     *  whole range out first, one program page at a time.
+     *
+     *  @param buffer Buffer holding the expected contents
+     *  @param addr   Flash address to begin comparing from
+     *  @param size   Size to compare in bytes
+     *  @return       0 when the contents match, 1 when they differ,
+     *                negative error code on failure
+     */
+    int verify(const void *buffer, uint32_t addr, uint32_t size);
+
+    /** Compare two flash ranges
+     *
+     *  @param addr1  Flash address of the first range
+     *  @param addr2  Flash address of the second range
+     *  @param size   Size to compare in bytes
+     *  @return       0 when the ranges match, 1 when they differ,
+     *                negative error code on failure
+     */
+    int compare(uint32_t addr1, uint32_t addr2, uint32_t size);
+
+    /** Begin an interruptible verify against a buffer
+     *
+     *  The counterpart of verify() in the style of erase_start(): the
+     *  range is validated and recorded and the comparison is then advanced
+     *  one program page per compare_step() call, so long compares (delta
+     *  update block matching, image checks) can interleave with other
+     *  work instead of holding the flash for the whole range. The buffer
+     *  must stay valid until the operation has completed.
+     *
+     *  @param buffer Buffer holding the expected contents
+     *  @param addr   Flash address to begin comparing from
+     *  @param size   Size to compare in bytes
+     *  @return       0 on success, negative error code on failure
+     */
+    int verify_start(const void *buffer, uint32_t addr, uint32_t size);
+
+    /** Begin an interruptible flash-to-flash range compare
+     *
+     *  Like verify_start(), with both sides of the comparison read from
+     *  flash - the shape a delta update needs to decide whether an old
+     *  block can be reused as-is.
+     *
+     *  @param addr1  Flash address of the first range
+     *  @param addr2  Flash address of the second range
+     *  @param size   Size to compare in bytes
+     *  @return       0 on success, negative error code on failure
+     */
+    int compare_start(uint32_t addr1, uint32_t addr2, uint32_t size);
+
+    /** Compare one page of the range set up with verify_start() or compare_start()
+     *
+     *  A difference completes the operation early, so a mismatching block
+     *  costs at most one page of reading.
+     *
+     *  @return     Positive number of bytes still to be compared, 0 when
+     *              the whole range has compared equal, -1 on a flash read
+     *              failure, -2 when a difference has been found
+     */
+    int compare_step();
+
+    /** Attach a progress callback for the stepped erase/program operations
+     *
+     *  The callback is invoked after every erase_step() and program_step()
+     *  with the number of bytes remaining, 0 on completion. It runs in the
+     *  context of the caller of the step function.
+     *
+     *  @param progress Progress callback, or an empty callback to detach
+     */
+    void attach_progress(Callback<void(uint32_t)> progress);
+
     /** Get the sector size at the defined address
      *
      *  Sector size might differ at address ranges. 
@@ -130,6 +249,14 @@ private:
     flash_t _flash;
     uint8_t *_page_buf;
     static SingletonPtr<PlatformMutex> _mutex;
+
+    /* State of the stepped erase/program/compare operations */
+    const uint8_t *_async_buf;
+    uint32_t _async_addr;
+    uint32_t _async_addr2;
+    uint32_t _async_size;
+    uint8_t *_compare_buf;
+    Callback<void(uint32_t)> _progress_cb;
 };
 
 } /* namespace mbed */
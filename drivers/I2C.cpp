@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "drivers/I2C.h"
+#include "hal/us_ticker_api.h"
 
 #if DEVICE_I2C
 
@@ -29,8 +30,12 @@ SingletonPtr<PlatformMutex> I2C::_mutex;
 I2C::I2C(PinName sda, PinName scl) :
 #if DEVICE_I2C_ASYNCH
     _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false),
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+    _batch_event(0), _batch_active(false),
 #endif
-    _i2c(), _hz(100000)
+#endif
+    _i2c(), _hz(100000), _claim_count(0), _claim_budget_armed(false), _claim_deadline(0),
+    _thread_safe(true)
 {
     // No lock needed in the constructor
 
@@ -62,11 +67,41 @@ void I2C::aquire() {
     unlock();
 }
 
+void I2C::claim(uint32_t budget_ms) {
+    lock();
+    aquire();
+    if (_claim_count++ == 0) {
+        _claim_budget_armed = (budget_ms != 0);
+        if (_claim_budget_armed) {
+            _claim_deadline = ticker_read_us(get_us_ticker_data()) + (us_timestamp_t)budget_ms * 1000;
+        }
+    }
+}
+
+void I2C::release() {
+    if ((_claim_count > 0) && (--_claim_count == 0)) {
+        _claim_budget_armed = false;
+    }
+    unlock();
+}
+
+bool I2C::claim_expired() {
+    // The claim fields only change under the bus mutex, which the
+    // caller of a claimed sequence already holds
+    return _claim_budget_armed && (ticker_read_us(get_us_ticker_data()) >= _claim_deadline);
+}
+
 // write - Master Transmitter Mode
 int I2C::write(int address, const char* data, int length, bool repeated) {
     lock();
     aquire();
 
+    if (claim_expired()) {
+        // The claim's budget has run out - fail before touching the bus
+        unlock();
+        return -1;
+    }
+
     int stop = (repeated) ? 0 : 1;
     int written = i2c_write(&_i2c, address, data, length, stop);
 
@@ -86,6 +121,12 @@ int I2C::read(int address, char* data, int length, bool repeated) {
     lock();
     aquire();
 
+    if (claim_expired()) {
+        // The claim's budget has run out - fail before touching the bus
+        unlock();
+        return -1;
+    }
+
     int stop = (repeated) ? 0 : 1;
     int read = i2c_read(&_i2c, address, data, length, stop);
 
@@ -118,10 +159,24 @@ void I2C::stop(void) {
 }
 
 void I2C::lock() {
+    if (!_thread_safe) {
+        _owner_check.check();
+        return;
+    }
     _mutex->lock();
 }
 
 void I2C::unlock() {
+    if (!_thread_safe) {
+        return;
+    }
+    _mutex->unlock();
+}
+
+void I2C::set_single_owner(bool single_owner) {
+    _mutex->lock();
+    _thread_safe = !single_owner;
+    _owner_check.reset();
     _mutex->unlock();
 }
 
@@ -145,6 +200,67 @@ int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_bu
     return 0;
 }
 
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+
+int I2C::transfer_batch(const message_t *messages, int count, const event_callback_t& callback, int event)
+{
+    if (count <= 0 || (uint32_t)count > MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE) {
+        return -1;
+    }
+    lock();
+    if (i2c_active(&_i2c) || _batch_active) {
+        unlock();
+        return -1; // transaction ongoing
+    }
+    lock_deep_sleep();
+    aquire();
+
+    for (int i = 0; i < count; i++) {
+        _batch_queue.push(messages[i]);
+    }
+    _batch_callback = callback;
+    _batch_event = event;
+    _batch_active = true;
+    _irq.callback(&I2C::irq_handler_batch);
+    start_batch_message();
+    unlock();
+    return 0;
+}
+
+void I2C::start_batch_message(void)
+{
+    message_t msg;
+    _batch_queue.pop(msg);
+    // Keep the bus with a repeated start between messages, stop only after
+    // the last one. The HAL is asked for all events; the user's mask is
+    // applied once, when the batch completes.
+    int stop = _batch_queue.empty() ? 1 : 0;
+    i2c_transfer_asynch(&_i2c, (void *)msg.tx_buffer, msg.tx_length,
+                        (void *)msg.rx_buffer, msg.rx_length,
+                        msg.address, stop, _irq.entry(), I2C_EVENT_ALL, _usage);
+}
+
+void I2C::irq_handler_batch(void)
+{
+    int event = i2c_irq_handler_asynch(&_i2c);
+    if (!event) {
+        return;
+    }
+    if ((event & I2C_EVENT_TRANSFER_COMPLETE) && !_batch_queue.empty()) {
+        start_batch_message();
+        return;
+    }
+    // Batch done, or aborted by the first error
+    _batch_queue.reset();
+    _batch_active = false;
+    unlock_deep_sleep();
+    if (_batch_callback && (event & _batch_event)) {
+        _batch_callback.call(event & _batch_event);
+    }
+}
+
+#endif
+
 void I2C::abort_transfer(void)
 {
     lock();
@@ -21,14 +21,20 @@
 #if defined (DEVICE_I2C) || defined(DOXYGEN_ONLY)
 
 #include "hal/i2c_api.h"
+#include "hal/ticker_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/SingleOwnerChecker.h"
 
 #if DEVICE_I2C_ASYNCH
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
 #include "platform/FunctionPointer.h"
+#include "platform/Transaction.h"
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+#include "platform/CircularBuffer.h"
+#endif
 #endif
 
 namespace mbed {
@@ -151,6 +157,84 @@ public:
      */
     virtual void unlock(void);
 
+    /** Declare whether this object is only ever used by a single thread
+     *
+     *  A single-owner I2C object skips the I2C mutex in lock() and
+     *  unlock(), removing the dominant fixed cost of short transactions.
+     *  In exchange the caller guarantees that no other thread touches any
+     *  I2C object while this one is in the single-owner state - the mutex
+     *  is shared by every I2C instance. In debug builds the owning thread
+     *  is recorded on the first transaction and a transaction from any
+     *  other thread triggers an assert.
+     *
+     *  @param single_owner true to elide locking, false to restore the
+     *                      default thread safe behaviour
+     */
+    void set_single_owner(bool single_owner = true);
+
+    /** Claim exclusive access to the bus across several operations
+     *
+     *  Holds the bus mutex and bus ownership until the matching
+     *  release(), so a read-modify-write of a register pair cannot be
+     *  interleaved by another thread and does not pay a mutex
+     *  acquisition per call. Claims nest; the budget of the outermost
+     *  claim applies.
+     *
+     *  A non-zero budget arms a deadline for the whole claim. Once it
+     *  has passed, further read and write transactions inside the claim
+     *  fail immediately instead of starting. A single transfer can still
+     *  overrun the deadline - a slave stretching the clock can extend
+     *  any one transfer indefinitely - but the budget stops the rest of
+     *  the sequence from compounding the delay.
+     *
+     *  @param budget_ms time budget for the whole claim in milliseconds,
+     *                   0 for no budget
+     */
+    void claim(uint32_t budget_ms = 0);
+
+    /** Release a claim taken with claim()
+     */
+    void release(void);
+
+    /** Check the time budget of the current claim
+     *
+     *  @return true if the bus is claimed with a budget that has expired
+     */
+    bool claim_expired(void);
+
+    /** Scoped bus claim - claims the bus in the constructor and releases
+     *  it in the destructor, see claim()
+     *
+     * Example:
+     * @code
+     * I2C::ScopedClaim claim(i2c, 10);
+     * i2c.read(addr, reg, 2);
+     * reg[0] |= 0x01;
+     * i2c.write(addr, reg, 2);
+     * @endcode
+     */
+    class ScopedClaim : private NonCopyable<ScopedClaim> {
+    public:
+        /** Claim the bus for the lifetime of this object
+         *
+         *  @param i2c       the bus to claim
+         *  @param budget_ms time budget for the whole claim in
+         *                   milliseconds, 0 for no budget
+         */
+        ScopedClaim(I2C &i2c, uint32_t budget_ms = 0) : _i2c(i2c)
+        {
+            _i2c.claim(budget_ms);
+        }
+
+        ~ScopedClaim()
+        {
+            _i2c.release();
+        }
+
+    private:
+        I2C &_i2c;
+    };
+
     virtual ~I2C() {
         // Do nothing
     }
@@ -177,6 +261,42 @@ public:
      */
     void abort_transfer();
 
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE || defined(DOXYGEN_ONLY)
+
+    /** A single message of a batched transfer, see transfer_batch()
+     *
+     *  A message is a write, a read, or a write followed by a read
+     *  (register access), addressed to one slave on the bus.
+     */
+    typedef struct {
+        int address;           /**< 8/10 bit I2C slave address */
+        const char *tx_buffer; /**< TX buffer with data to be transfered, may be NULL */
+        int tx_length;         /**< Length of the TX buffer in bytes */
+        char *rx_buffer;       /**< RX buffer which is used for received data, may be NULL */
+        int rx_length;         /**< Length of the RX buffer in bytes */
+    } message_t;
+
+    /** Start a non-blocking batch of I2C messages.
+     *
+     * The messages are executed back-to-back from interrupt context with a
+     * repeated start between them and a single stop after the last one, so
+     * a batch costs one bus acquisition and one completion callback instead
+     * of one per message. The callback is invoked once, after the last
+     * message has completed or on the first error.
+     *
+     * This function locks the deep sleep until the batch has completed
+     *
+     * @param messages  Array of messages, executed in order
+     * @param count     Number of messages in the array
+     * @param callback  The event callback function, called once per batch
+     * @param event     The logical OR of events to report
+     * @return Zero if the batch has started, or -1 if the I2C peripheral is
+     *         busy or the batch does not fit the transaction queue
+     */
+    int transfer_batch(const message_t *messages, int count, const event_callback_t& callback, int event = I2C_EVENT_TRANSFER_COMPLETE);
+
+#endif
+
   protected:
     /** Lock deep sleep only if it is not yet locked */
     void lock_deep_sleep();
@@ -189,6 +309,22 @@ public:
     CThunk<I2C> _irq;
     DMAUsage _usage;
     bool _deep_sleep_locked;
+
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+    /** Batch IRQ handler, chains the next queued message from ISR context */
+    void irq_handler_batch(void);
+
+    /** Start the next message of the on-going batch
+     *
+     *  Must be called from a critical section or ISR context
+     */
+    void start_batch_message(void);
+
+    CircularBuffer<message_t, MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE> _batch_queue;
+    event_callback_t _batch_callback;
+    int _batch_event;
+    volatile bool _batch_active;
+#endif
 #endif
 
 protected:
@@ -198,6 +334,11 @@ protected:
     static I2C  *_owner;
     int         _hz;
     static SingletonPtr<PlatformMutex> _mutex;
+    unsigned    _claim_count;
+    bool        _claim_budget_armed;
+    us_timestamp_t _claim_deadline;
+    bool        _thread_safe;
+    SingleOwnerChecker _owner_check;
 };
 
 } // namespace mbed
@@ -0,0 +1,153 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/ImageVerifier.h"
+
+#if DEVICE_FLASH
+
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+
+/* Flash is read through a stack buffer this large while streaming into
+ * the CRC; small enough for any dispatch thread's stack */
+#define VERIFY_READ_SIZE 256
+
+ImageVerifier::ImageVerifier(events::EventQueue *queue) :
+    _queue(queue), _crc(), _address(0), _remaining(0), _expected(0),
+    _chunk_size(0), _running_crc(0), _done(NULL), _status(VERIFY_IDLE),
+    _flash_opened(false)
+{
+}
+
+ImageVerifier::~ImageVerifier()
+{
+    if (_flash_opened) {
+        _flash.deinit();
+    }
+}
+
+bool ImageVerifier::flash_open()
+{
+    if (!_flash_opened) {
+        if (_flash.init() != 0) {
+            return false;
+        }
+        _flash_opened = true;
+    }
+    return true;
+}
+
+bool ImageVerifier::verify(uint32_t address, uint32_t size, uint32_t expected_crc)
+{
+    uint8_t buffer[VERIFY_READ_SIZE];
+    uint32_t crc;
+
+    if (!flash_open()) {
+        return false;
+    }
+    if (_crc.compute_partial_start(&crc) != 0) {
+        return false;
+    }
+    while (size) {
+        uint32_t count = (size < sizeof buffer) ? size : sizeof buffer;
+        if (_flash.read(buffer, address, count) != 0) {
+            return false;
+        }
+        if (_crc.compute_partial(buffer, count, &crc) != 0) {
+            return false;
+        }
+        address += count;
+        size -= count;
+    }
+    if (_crc.compute_partial_stop(&crc) != 0) {
+        return false;
+    }
+    return crc == expected_crc;
+}
+
+bool ImageVerifier::start(uint32_t address, uint32_t size, uint32_t expected_crc,
+                          Callback<void(bool)> done, uint32_t chunk_size)
+{
+    core_util_critical_section_enter();
+    if (_status == VERIFY_RUNNING) {
+        core_util_critical_section_exit();
+        return false;
+    }
+    _status = VERIFY_RUNNING;
+    core_util_critical_section_exit();
+
+    if (!flash_open() || chunk_size == 0 ||
+            _crc.compute_partial_start(&_running_crc) != 0) {
+        _status = VERIFY_ERROR;
+        return false;
+    }
+
+    _address = address;
+    _remaining = size;
+    _expected = expected_crc;
+    _chunk_size = chunk_size;
+    _done = done;
+
+    if (!_queue->call(callback(this, &ImageVerifier::step))) {
+        _status = VERIFY_ERROR;
+        return false;
+    }
+    return true;
+}
+
+void ImageVerifier::step()
+{
+    uint8_t buffer[VERIFY_READ_SIZE];
+    uint32_t chunk = (_remaining < _chunk_size) ? _remaining : _chunk_size;
+
+    while (chunk) {
+        uint32_t count = (chunk < sizeof buffer) ? chunk : sizeof buffer;
+        if (_flash.read(buffer, _address, count) != 0 ||
+                _crc.compute_partial(buffer, count, &_running_crc) != 0) {
+            _status = VERIFY_ERROR;
+            if (_done) {
+                _done(false);
+            }
+            return;
+        }
+        _address += count;
+        _remaining -= count;
+        chunk -= count;
+    }
+
+    if (_remaining == 0) {
+        finish();
+    } else if (!_queue->call(callback(this, &ImageVerifier::step))) {
+        _status = VERIFY_ERROR;
+        if (_done) {
+            _done(false);
+        }
+    }
+}
+
+void ImageVerifier::finish()
+{
+    bool passed = (_crc.compute_partial_stop(&_running_crc) == 0) &&
+                  (_running_crc == _expected);
+    _status = passed ? VERIFY_PASSED : VERIFY_FAILED;
+    if (_done) {
+        _done(passed);
+    }
+}
+
+} // namespace mbed
+
+#endif // DEVICE_FLASH
@@ -0,0 +1,141 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_IMAGEVERIFIER_H
+#define MBED_IMAGEVERIFIER_H
+
+#include "drivers/FlashIAP.h"
+#include "drivers/MbedCRC.h"
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+#if defined(DEVICE_FLASH) || defined(DOXYGEN_ONLY)
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Incremental CRC verification of a flash image
+ *
+ *  Checks a region of internal flash against an expected CRC-32 without
+ *  monopolizing the CPU: verify() does a synchronous check sized for the
+ *  boot fast path (vector table and entry pages only), while start()
+ *  streams the full image through the CRC one chunk per event on an
+ *  EventQueue, so boot continues, the watchdog gets kicked and other
+ *  events keep dispatching while the bulk of the image is verified in
+ *  the background.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * ImageVerifier verifier(mbed_event_queue());
+ *
+ * // Boot fast path - vector table and entry pages, synchronous
+ * if (!verifier.verify(APP_START, BOOT_PAGES_SIZE, BOOT_PAGES_CRC)) {
+ *     panic();
+ * }
+ *
+ * // Full image in the background
+ * verifier.start(APP_START, APP_SIZE, APP_CRC, on_verified);
+ * @endcode
+ * @ingroup drivers
+ */
+class ImageVerifier : private NonCopyable<ImageVerifier> {
+public:
+
+    /** Verification state, see status() */
+    enum Status {
+        VERIFY_IDLE = 0,    /**< No verification started yet */
+        VERIFY_RUNNING,     /**< Background verification in progress */
+        VERIFY_PASSED,      /**< CRC matched the expected value */
+        VERIFY_FAILED,      /**< CRC did not match */
+        VERIFY_ERROR        /**< Flash access or queue error */
+    };
+
+    /** Create a verifier dispatching its background work on a queue
+     *
+     *  @param queue the EventQueue chunks are scheduled on; must outlive
+     *               the verifier
+     */
+    ImageVerifier(events::EventQueue *queue);
+
+    ~ImageVerifier();
+
+    /** Verify a flash region synchronously
+     *
+     *  Intended for the boot fast path: keep the region to the vector
+     *  table and entry pages so the check stays in the microsecond
+     *  range, and leave the full image to start().
+     *
+     *  @param address      start of the region in flash
+     *  @param size         region size in bytes
+     *  @param expected_crc expected CRC-32 (ANSI polynomial) of the region
+     *  @return true if the region's CRC matches
+     */
+    bool verify(uint32_t address, uint32_t size, uint32_t expected_crc);
+
+    /** Start verifying a flash region in the background
+     *
+     *  Streams the region through the CRC chunk by chunk, one chunk per
+     *  dispatched event. Fails if a verification is already running.
+     *
+     *  @param address      start of the region in flash
+     *  @param size         region size in bytes
+     *  @param expected_crc expected CRC-32 (ANSI polynomial) of the region
+     *  @param done         callback invoked from the queue's dispatch
+     *                      context with the verification result; may be
+     *                      empty, in which case poll status()
+     *  @param chunk_size   bytes checked per event; bounds the time one
+     *                      event occupies the queue
+     *  @return true if the verification was scheduled
+     */
+    bool start(uint32_t address, uint32_t size, uint32_t expected_crc,
+               Callback<void(bool)> done = NULL, uint32_t chunk_size = 4096);
+
+    /** Current verification state
+     *
+     *  @return see Status
+     */
+    Status status() const
+    {
+        return _status;
+    }
+
+private:
+    /** Verify one chunk and reschedule, run on the queue */
+    void step();
+    /** Finish the stream, compare and report */
+    void finish();
+    bool flash_open();
+
+    events::EventQueue *_queue;
+    FlashIAP _flash;
+    MbedCRC<POLY_32BIT_ANSI, 32> _crc;
+    uint32_t _address;
+    uint32_t _remaining;
+    uint32_t _expected;
+    uint32_t _chunk_size;
+    uint32_t _running_crc;
+    Callback<void(bool)> _done;
+    volatile Status _status;
+    bool _flash_opened;
+};
+
+} // namespace mbed
+
+#endif // defined(DEVICE_FLASH) || defined(DOXYGEN_ONLY)
+
+#endif
@@ -96,7 +96,7 @@ template <uint32_t polynomial=POLY_32BIT_ANSI, uint8_t width=32>
 class MbedCRC
 {
 public:
-    enum CrcMode { HARDWARE = 0, TABLE, BITWISE };
+    enum CrcMode { HARDWARE = 0, TABLE, SLICE_BY_8, BITWISE };
 
 public:
     typedef uint64_t crc_data_size_t;
@@ -180,6 +180,13 @@ public:
                 return 0;
             case TABLE:
                 return table_compute_partial(buffer, size, crc);
+#if MBED_CONF_DRIVERS_CRC_SLICE_BY_8
+            case SLICE_BY_8:
+                return slice_compute_partial(buffer, size, crc);
+#else
+            case SLICE_BY_8:
+                return -1;
+#endif
             case BITWISE:
                 return bitwise_compute_partial(buffer, size, crc);
         }
@@ -215,7 +222,12 @@ public:
         }
 #endif // DEVICE_CRC
 
-        *crc = _initial_value;
+        if (_mode == SLICE_BY_8) {
+            // The slice engine works entirely in the reflected domain
+            *crc = reflect_remainder(_initial_value);
+        } else {
+            *crc = _initial_value;
+        }
         return 0;
     }
 
@@ -240,6 +252,12 @@ public:
 #endif
         }
 
+        if (_mode == SLICE_BY_8) {
+            // Remainder is already reflected, only the final xor is left
+            *crc = (*crc ^ _final_xor) & get_crc_mask();
+            return 0;
+        }
+
         uint32_t p_crc = *crc;
         if ((width < 8) && (NULL == _crc_table)) {
             p_crc = (uint32_t)(p_crc << (8 - width));
@@ -392,6 +410,47 @@ private:
         return 0;
     }
 
+#if MBED_CONF_DRIVERS_CRC_SLICE_BY_8
+    /** Slice-by-8 CRC computation, folds 8 data bytes per table step
+     *
+     *  Only selected for the reflected 32-bit ANSI configuration. The
+     *  running CRC stays in the reflected domain between calls, so the
+     *  partial start/stop handling differs from the generic engines.
+     *
+     * @param  buffer  data buffer
+     * @param  size  size of the data
+     * @param  crc  CRC value is filled in, but the value is not the final
+     * @return  0  on success or a negative error code on failure
+     */
+    int32_t slice_compute_partial(const void *buffer, crc_data_size_t size, uint32_t *crc) const
+    {
+        MBED_ASSERT(crc != NULL);
+        MBED_ASSERT(buffer != NULL);
+
+        const uint8_t *data = static_cast<const uint8_t *>(buffer);
+        uint32_t p_crc = *crc;
+        crc_data_size_t byte = 0;
+
+        for (; byte + 8 <= size; byte += 8) {
+            p_crc ^= (uint32_t)data[byte] | ((uint32_t)data[byte + 1] << 8) |
+                     ((uint32_t)data[byte + 2] << 16) | ((uint32_t)data[byte + 3] << 24);
+            p_crc = Table_CRC_32bit_ANSI_Slice8[7][p_crc & 0xFF] ^
+                    Table_CRC_32bit_ANSI_Slice8[6][(p_crc >> 8) & 0xFF] ^
+                    Table_CRC_32bit_ANSI_Slice8[5][(p_crc >> 16) & 0xFF] ^
+                    Table_CRC_32bit_ANSI_Slice8[4][(p_crc >> 24) & 0xFF] ^
+                    Table_CRC_32bit_ANSI_Slice8[3][data[byte + 4]] ^
+                    Table_CRC_32bit_ANSI_Slice8[2][data[byte + 5]] ^
+                    Table_CRC_32bit_ANSI_Slice8[1][data[byte + 6]] ^
+                    Table_CRC_32bit_ANSI_Slice8[0][data[byte + 7]];
+        }
+        for (; byte < size; byte++) {
+            p_crc = (p_crc >> 8) ^ Table_CRC_32bit_ANSI_Slice8[0][(p_crc ^ data[byte]) & 0xFF];
+        }
+        *crc = p_crc;
+        return 0;
+    }
+#endif // MBED_CONF_DRIVERS_CRC_SLICE_BY_8
+
      /** CRC computation using ROM tables
      *
      * @param  buffer  data buffer
@@ -440,6 +499,13 @@ private:
 
         _mode = (_crc_table != NULL) ? TABLE : BITWISE;
 
+#if MBED_CONF_DRIVERS_CRC_SLICE_BY_8
+        if ((POLY_32BIT_ANSI == polynomial) && (32 == width) &&
+                _reflect_data && _reflect_remainder) {
+            _mode = SLICE_BY_8;
+        }
+#endif
+
 #ifdef DEVICE_CRC
         crc_mbed_config_t config;
         config.polynomial  = polynomial;
@@ -201,6 +201,9 @@ protected:
         }
     }
 
+    // Commits staged duty-cycles for several channels in one HAL call
+    friend class PwmOutGroup;
+
     pwmout_t _pwm;
     bool _deep_sleep_locked;
 };
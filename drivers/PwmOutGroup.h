@@ -0,0 +1,137 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PWMOUTGROUP_H
+#define MBED_PWMOUTGROUP_H
+
+#include "platform/platform.h"
+
+#if defined (DEVICE_PWMOUT) || defined(DOXYGEN_ONLY)
+
+#include "drivers/PwmOut.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Synchronized duty-cycle updates across several PwmOut channels
+ *
+ *  Duty-cycles are staged per channel and applied together with a single
+ *  commit(), which hands all staged values to the HAL in one call.
+ *  Targets whose timer banks support buffered compare loads latch every
+ *  channel on the same update event; elsewhere the channels are written
+ *  back to back with interrupts masked, which still removes the
+ *  per-channel call and deep-sleep-lock overhead that staggers plain
+ *  write() loops.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * PwmOut u(PIN_U), v(PIN_V), w(PIN_W);
+ * PwmOut *phases[] = { &u, &v, &w };
+ * PwmOutGroup bridge(phases, 3);
+ *
+ * void control_loop_step(float du, float dv, float dw) {
+ *     bridge.stage(0, du);
+ *     bridge.stage(1, dv);
+ *     bridge.stage(2, dw);
+ *     bridge.commit();
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class PwmOutGroup : private NonCopyable<PwmOutGroup> {
+
+public:
+    /** Largest number of channels one group can hold */
+    static const size_t MAX_CHANNELS = 16;
+
+    /** Create a group over existing PwmOut channels
+     *
+     *  @param channels Array of channel pointers, must outlive the group
+     *  @param count    Number of channels, at most MAX_CHANNELS
+     */
+    PwmOutGroup(PwmOut **channels, size_t count) :
+        _channels(channels), _count(count)
+    {
+        MBED_ASSERT(count <= MAX_CHANNELS);
+        for (size_t i = 0; i < _count; i++) {
+            _dirty[i] = false;
+        }
+    }
+
+    /** Stage a duty-cycle for one channel
+     *
+     *  Nothing reaches the hardware until commit().
+     *
+     *  @param channel Index into the channel array
+     *  @param value   Duty-cycle in range 0.0f to 1.0f
+     */
+    void stage(size_t channel, float value)
+    {
+        MBED_ASSERT(channel < _count);
+        core_util_critical_section_enter();
+        _staged[channel] = value;
+        _dirty[channel] = true;
+        core_util_critical_section_exit();
+    }
+
+    /** Apply all staged duty-cycles in one synchronized update
+     *
+     *  Channels without a staged value since the last commit keep their
+     *  current duty-cycle.
+     */
+    void commit()
+    {
+        pwmout_t *objs[MAX_CHANNELS];
+        float values[MAX_CHANNELS];
+        size_t n = 0;
+
+        core_util_critical_section_enter();
+        for (size_t i = 0; i < _count; i++) {
+            if (_dirty[i]) {
+                _channels[i]->lock_deep_sleep();
+                objs[n] = &_channels[i]->_pwm;
+                values[n] = _staged[i];
+                _dirty[i] = false;
+                n++;
+            }
+        }
+        if (n) {
+            pwmout_group_write(objs, values, n);
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** Number of channels in the group */
+    size_t size() const
+    {
+        return _count;
+    }
+
+private:
+    PwmOut **_channels;
+    size_t _count;
+    float _staged[MAX_CHANNELS];
+    bool _dirty[MAX_CHANNELS];
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
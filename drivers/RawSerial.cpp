@@ -15,8 +15,10 @@
  */
 #include "drivers/RawSerial.h"
 #include "platform/mbed_wait_api.h"
+#include "platform/mbed_critical.h"
 #include <stdio.h>
 #include <cstdarg>
+#include <string.h>
 
 
 #if DEVICE_SERIAL
@@ -25,7 +27,9 @@
 
 namespace mbed {
 
-RawSerial::RawSerial(PinName tx, PinName rx, int baud) : SerialBase(tx, rx, baud) {
+RawSerial::RawSerial(PinName tx, PinName rx, int baud) : SerialBase(tx, rx, baud),
+        _tx_buf(NULL), _tx_buf_size(0), _tx_head(0), _tx_tail(0),
+        _tx_dropped(0), _drop_oldest(true), _tx_irq_enabled(false) {
     // No lock needed in the constructor
 }
 
@@ -37,6 +41,11 @@ int RawSerial::getc() {
 }
 
 int RawSerial::putc(int c) {
+    if (_tx_buf) {
+        char data = (char)c;
+        tx_ring_write(&data, 1);
+        return c;
+    }
     lock();
     int ret = _base_putc(c);
     unlock();
@@ -44,6 +53,10 @@ int RawSerial::putc(int c) {
 }
 
 int RawSerial::puts(const char *str) {
+    if (_tx_buf) {
+        tx_ring_write(str, strlen(str));
+        return 0;
+    }
     lock();
     while (*str)
         putc(*str ++);
@@ -51,6 +64,92 @@ int RawSerial::puts(const char *str) {
     return 0;
 }
 
+void RawSerial::set_tx_buffer(char *buffer, size_t size, bool drop_oldest) {
+    flush();
+    core_util_critical_section_enter();
+    if (_tx_irq_enabled) {
+        SerialBase::attach(NULL, TxIrq);
+        _tx_irq_enabled = false;
+    }
+    if (buffer != NULL && size >= 2) {
+        _tx_buf = buffer;
+        _tx_buf_size = size;
+    } else {
+        _tx_buf = NULL;
+        _tx_buf_size = 0;
+    }
+    _tx_head = 0;
+    _tx_tail = 0;
+    _tx_dropped = 0;
+    _drop_oldest = drop_oldest;
+    core_util_critical_section_exit();
+}
+
+void RawSerial::flush() {
+    if (_tx_buf == NULL) {
+        return;
+    }
+    // Drain directly rather than waiting on the TX interrupt, so the
+    // buffered bytes still go out when interrupts are disabled
+    while (true) {
+        core_util_critical_section_enter();
+        if (_tx_tail == _tx_head) {
+            core_util_critical_section_exit();
+            break;
+        }
+        if (SerialBase::writeable()) {
+            _base_putc(_tx_buf[_tx_tail]);
+            _tx_tail = (_tx_tail + 1 == _tx_buf_size) ? 0 : _tx_tail + 1;
+        }
+        core_util_critical_section_exit();
+    }
+}
+
+uint32_t RawSerial::tx_dropped() const {
+    return _tx_dropped;
+}
+
+size_t RawSerial::tx_ring_write(const char *data, size_t length) {
+    size_t written = 0;
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < length; i++) {
+        size_t next = (_tx_head + 1 == _tx_buf_size) ? 0 : _tx_head + 1;
+        if (next == _tx_tail) {
+            if (_drop_oldest) {
+                _tx_tail = (_tx_tail + 1 == _tx_buf_size) ? 0 : _tx_tail + 1;
+                _tx_dropped++;
+            } else {
+                _tx_dropped += length - i;
+                break;
+            }
+        }
+        _tx_buf[_tx_head] = data[i];
+        _tx_head = next;
+        written++;
+    }
+    if (!_tx_irq_enabled && (_tx_head != _tx_tail)) {
+        tx_ring_irq();               // only write to hardware in one place
+        if (_tx_head != _tx_tail) {
+            SerialBase::attach(callback(this, &RawSerial::tx_ring_irq), TxIrq);
+            _tx_irq_enabled = true;
+        }
+    }
+    core_util_critical_section_exit();
+    return written;
+}
+
+void RawSerial::tx_ring_irq(void) {
+    // Feed the peripheral while it can take data and the ring has some
+    while (SerialBase::writeable() && (_tx_tail != _tx_head)) {
+        _base_putc(_tx_buf[_tx_tail]);
+        _tx_tail = (_tx_tail + 1 == _tx_buf_size) ? 0 : _tx_tail + 1;
+    }
+    if (_tx_irq_enabled && (_tx_tail == _tx_head)) {
+        SerialBase::attach(NULL, TxIrq);
+        _tx_irq_enabled = false;
+    }
+}
+
 // Experimental support for printf in RawSerial. No Stream inheritance
 // means we can't call printf() directly, so we use sprintf() instead.
 // We only call malloc() for the sprintf() buffer if the buffer
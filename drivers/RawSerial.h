@@ -88,6 +88,38 @@ public:
 
     int printf(const char *format, ...);
 
+    /** Route transmission through a caller-provided ring drained from interrupt
+     *
+     *  While a buffer is set, putc/puts/printf copy their bytes into the
+     *  ring and return immediately; the TX interrupt feeds the bytes to
+     *  the peripheral in the background. Emitting a diagnostic line then
+     *  costs a memcpy instead of stalling the caller at baud-rate speed.
+     *  When the ring is full, either the oldest buffered bytes are
+     *  overwritten or the new bytes are discarded, depending on the
+     *  policy; tx_dropped() counts bytes lost either way.
+     *
+     *  Passing NULL reverts to the blocking path after synchronously
+     *  draining any buffered bytes, which is the mode crash dumps need.
+     *
+     *  @param buffer      Ring storage, must outlive the buffered mode, or
+     *                     NULL to revert to blocking transmission
+     *  @param size        Size of buffer in bytes
+     *  @param drop_oldest true to overwrite the oldest buffered bytes on
+     *                     overflow, false to discard the new bytes
+     */
+    void set_tx_buffer(char *buffer, size_t size, bool drop_oldest = true);
+
+    /** Synchronously drain any bytes buffered for transmission
+     *
+     *  Spins until the ring is empty, writing directly to the peripheral,
+     *  so it makes progress even with interrupts disabled. No-op in
+     *  blocking mode.
+     */
+    void flush();
+
+    /** Number of bytes lost to TX ring overflow since the buffer was set */
+    uint32_t tx_dropped() const;
+
 protected:
 
     /* Acquire exclusive access to this serial port
@@ -97,6 +129,18 @@ protected:
     /* Release exclusive access to this serial port
      */
     virtual void unlock(void);
+
+private:
+    void tx_ring_irq(void);
+    size_t tx_ring_write(const char *data, size_t length);
+
+    char *_tx_buf;
+    size_t _tx_buf_size;
+    volatile size_t _tx_head;
+    volatile size_t _tx_tail;
+    volatile uint32_t _tx_dropped;
+    bool _drop_oldest;
+    bool _tx_irq_enabled;
 };
 
 } // namespace mbed
@@ -38,7 +38,8 @@ SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
         _bits(8),
         _mode(0),
         _hz(1000000),
-        _write_fill(SPI_FILL_CHAR) {
+        _write_fill(SPI_FILL_CHAR),
+        _thread_safe(true) {
     // No lock needed in the constructor
 
     spi_init(&_spi, mosi, miso, sclk, ssel);
@@ -114,10 +115,24 @@ int SPI::write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_len
 }
 
 void SPI::lock() {
+    if (!_thread_safe) {
+        _owner_check.check();
+        return;
+    }
     _mutex->lock();
 }
 
 void SPI::unlock() {
+    if (!_thread_safe) {
+        return;
+    }
+    _mutex->unlock();
+}
+
+void SPI::set_single_owner(bool single_owner) {
+    _mutex->lock();
+    _thread_safe = !single_owner;
+    _owner_check.reset();
     _mutex->unlock();
 }
 
@@ -138,6 +153,36 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_segments(const transfer_segment_t *segments, int count, unsigned char bit_width, const event_callback_t& callback, int event)
+{
+#if TRANSACTION_QUEUE_SIZE_SPI
+    if (count <= 0) {
+        return -1;
+    }
+    core_util_critical_section_enter();
+    // All segments must fit on the queue so the chain cannot be torn apart
+    // by a competing producer. One slot is executed immediately if the
+    // peripheral is idle, so only the remainder needs to be buffered.
+    uint32_t needed = spi_active(&_spi) ? count : count - 1;
+    if (needed > TRANSACTION_QUEUE_SIZE_SPI - _transaction_buffer.size()) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        // Intermediate segments only surface errors; the completion event
+        // is reported once, from the last segment of the chain.
+        int segment_event = (i == count - 1) ? event : (event & SPI_EVENT_ERROR);
+        transfer(segments[i].tx_buffer, segments[i].tx_length,
+                 segments[i].rx_buffer, segments[i].rx_length,
+                 bit_width, callback, segment_event);
+    }
+    core_util_critical_section_exit();
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 void SPI::abort_transfer()
 {
     spi_abort_asynch(&_spi);
@@ -24,6 +24,7 @@
 #include "hal/spi_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
+#include "platform/SingleOwnerChecker.h"
 
 #if DEVICE_SPI_ASYNCH
 #include "platform/CThunk.h"
@@ -143,6 +144,21 @@ public:
      */
     virtual void unlock(void);
 
+    /** Declare whether this object is only ever used by a single thread
+     *
+     *  A single-owner SPI object skips the SPI mutex in lock() and
+     *  unlock(), removing the dominant fixed cost of short transactions.
+     *  In exchange the caller guarantees that no other thread touches any
+     *  SPI object while this one is in the single-owner state - the mutex
+     *  is shared by every SPI instance. In debug builds the owning thread
+     *  is recorded on the first transaction and a transaction from any
+     *  other thread triggers an assert.
+     *
+     *  @param single_owner true to elide locking, false to restore the
+     *                      default thread safe behaviour
+     */
+    void set_single_owner(bool single_owner = true);
+
     /** Set default write data
       * SPI requires the master to send some data during a read operation.
       * Different devices may require different default byte values.
@@ -154,6 +170,18 @@ public:
 
 #if DEVICE_SPI_ASYNCH
 
+    /** A single segment of a scatter-gather transfer, see transfer_segments()
+     *
+     *  Either buffer may be NULL: a NULL tx_buffer sends the default write
+     *  value, a NULL rx_buffer discards received data.
+     */
+    typedef struct {
+        const void *tx_buffer; /**< TX buffer for this segment, may be NULL */
+        int tx_length;         /**< Length of the TX buffer in bytes */
+        void *rx_buffer;       /**< RX buffer for this segment, may be NULL */
+        int rx_length;         /**< Length of the RX buffer in bytes */
+    } transfer_segment_t;
+
     /** Start non-blocking SPI transfer using 8bit buffers.
      *
      * This function locks the deep sleep until any event has occurred
@@ -177,6 +205,27 @@ public:
         return 0;
     }
 
+    /** Start a non-blocking scatter-gather transfer over a list of segments.
+     *
+     * The segments are chained on the transaction queue and executed
+     * back-to-back, so a multi-buffer update costs a single completion
+     * callback instead of one per buffer. The callback is invoked once,
+     * after the last segment has completed (or on the first error event).
+     *
+     * This function locks the deep sleep until any event has occurred
+     *
+     * @param segments  Array of transfer segments, executed in order
+     * @param count     Number of segments in the array
+     * @param callback  The event callback function, called after the last segment
+     * @param event     The logical OR of events to modify. Look at spi hal header file for SPI events.
+     * @return Zero if all segments were started or queued, or -1 if the
+     *         transaction queue cannot hold the whole list
+     */
+    template<typename Type>
+    int transfer_segments(const transfer_segment_t *segments, int count, const event_callback_t& callback, int event = SPI_EVENT_COMPLETE) {
+        return transfer_segments(segments, count, sizeof(Type)*8, callback, event);
+    }
+
     /** Abort the on-going SPI transfer, and continue with transfer's in the queue if any.
      */
     void abort_transfer();
@@ -217,6 +266,18 @@ protected:
     */
     int transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t& callback, int event);
 
+    /** Common scatter-gather transfer method
+     *
+     * @param segments  Array of transfer segments, executed in order
+     * @param count     Number of segments in the array
+     * @param bit_width The buffers element width
+     * @param callback  The event callback function, called after the last segment
+     * @param event     The logical OR of events to modify
+     * @return Zero if all segments were started or queued, or -1 if the
+     *         transaction queue cannot hold the whole list
+    */
+    int transfer_segments(const transfer_segment_t *segments, int count, unsigned char bit_width, const event_callback_t& callback, int event);
+
     /**
      *
      * @param tx_buffer The TX buffer with data to be transfered. If NULL is passed,
@@ -292,6 +353,8 @@ protected:
     int _mode;
     int _hz;
     char _write_fill;
+    bool _thread_safe;
+    SingleOwnerChecker _owner_check;
 
 private:
     /* Private acquire function without locking/unlocking
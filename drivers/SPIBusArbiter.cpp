@@ -0,0 +1,196 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/SPIBusArbiter.h"
+#include "platform/mbed_critical.h"
+
+#if defined(DEVICE_SPI) && defined(DEVICE_SPI_ASYNCH) && MBED_CONF_DRIVERS_SPI_ARBITER_QUEUE_SIZE
+
+namespace mbed {
+
+SPIBusArbiter::SPIBusArbiter(PinName mosi, PinName miso, PinName sclk) :
+    _mosi(mosi), _miso(miso), _sclk(sclk),
+    _done(callback(this, &SPIBusArbiter::transfer_done)),
+    _free(NULL), _pending(NULL), _active(NULL), _chain_device(NULL)
+{
+    for (int i = 0; i < MBED_CONF_DRIVERS_SPI_ARBITER_QUEUE_SIZE; i++) {
+        _slots[i].next = _free;
+        _free = &_slots[i];
+    }
+}
+
+int SPIBusArbiter::enqueue(SPIBusDevice *device, const SPI::transfer_segment_t *segments,
+                           int count, const event_callback_t &callback, int event)
+{
+    if (count <= 0) {
+        return -1;
+    }
+    core_util_critical_section_enter();
+    // All segments must fit at once so a chain cannot be torn apart by a
+    // competing producer
+    int free_count = 0;
+    for (pending_t *p = _free; p != NULL; p = p->next) {
+        free_count++;
+    }
+    if (free_count < count) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        pending_t *job = _free;
+        _free = _free->next;
+
+        job->device = device;
+        job->priority = device->_priority;
+        job->chain = (i != count - 1);
+        job->data.tx_buffer = const_cast<void *>(segments[i].tx_buffer);
+        job->data.tx_length = segments[i].tx_length;
+        job->data.rx_buffer = segments[i].rx_buffer;
+        job->data.rx_length = segments[i].rx_length;
+        job->data.width = 8;
+        job->data.callback = callback;
+        // Intermediate segments of a chain only surface errors; the
+        // completion event is reported once, from the last segment.
+        job->data.event = job->chain ? (event & SPI_EVENT_ERROR) : event;
+
+        // Insert after every entry of equal or higher priority, so equal
+        // priorities stay FIFO and the segments of a chain stay in order
+        pending_t **prev = &_pending;
+        while (*prev != NULL && (*prev)->priority >= job->priority) {
+            prev = &(*prev)->next;
+        }
+        job->next = *prev;
+        *prev = job;
+    }
+    dispatch();
+    core_util_critical_section_exit();
+    return 0;
+}
+
+void SPIBusArbiter::dispatch()
+{
+    if (_active != NULL || _pending == NULL) {
+        return;
+    }
+    pending_t **prev = &_pending;
+    if (_chain_device != NULL) {
+        // A chain holds the chip select - the next transfer must be the
+        // continuation of that chain, regardless of priority. The chain
+        // was queued atomically, so the continuation is always present.
+        while (*prev != NULL && (*prev)->device != _chain_device) {
+            prev = &(*prev)->next;
+        }
+    }
+    pending_t *job = *prev;
+    if (job == NULL) {
+        return;
+    }
+    *prev = job->next;
+    _active = job;
+    job->device->start_on_bus(&job->data);
+}
+
+void SPIBusArbiter::transfer_done(int event)
+{
+    core_util_critical_section_enter();
+    pending_t *job = _active;
+    _active = NULL;
+
+    bool hold_cs = job->chain && !(event & SPI_EVENT_ERROR);
+    if (job->chain && (event & SPI_EVENT_ERROR)) {
+        // A segment of a chain failed: drop the queued remainder of the
+        // chain (the device's earliest pending entries, up to and
+        // including the first non-chained one). The error itself has
+        // already been reported from the failing segment.
+        bool more = true;
+        while (more) {
+            pending_t **prev = &_pending;
+            while (*prev != NULL && (*prev)->device != job->device) {
+                prev = &(*prev)->next;
+            }
+            pending_t *drop = *prev;
+            if (drop == NULL) {
+                break;
+            }
+            *prev = drop->next;
+            more = drop->chain;
+            drop->next = _free;
+            _free = drop;
+        }
+    }
+    if (hold_cs) {
+        _chain_device = job->device;
+    } else {
+        job->device->_cs = 1;
+        _chain_device = NULL;
+    }
+
+    event_callback_t user_callback = job->data.callback;
+    int user_event = job->data.event;
+    job->next = _free;
+    _free = job;
+
+    dispatch();
+    core_util_critical_section_exit();
+
+    if (user_callback && (event & user_event)) {
+        user_callback.call(event & user_event);
+    }
+}
+
+SPIBusDevice::SPIBusDevice(SPIBusArbiter &bus, PinName cs, int priority) :
+    SPI(bus._mosi, bus._miso, bus._sclk),
+    _bus(bus), _cs(cs, 1), _priority(priority)
+{
+}
+
+int SPIBusDevice::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length,
+                           const event_callback_t &callback, int event)
+{
+    transfer_segment_t segment;
+    segment.tx_buffer = tx_buffer;
+    segment.tx_length = tx_length;
+    segment.rx_buffer = rx_buffer;
+    segment.rx_length = rx_length;
+    return _bus.enqueue(this, &segment, 1, callback, event);
+}
+
+int SPIBusDevice::transfer_segments(const transfer_segment_t *segments, int count,
+                                    const event_callback_t &callback, int event)
+{
+    return _bus.enqueue(this, segments, count, callback, event);
+}
+
+void SPIBusDevice::set_priority(int priority)
+{
+    core_util_critical_section_enter();
+    _priority = priority;
+    core_util_critical_section_exit();
+}
+
+void SPIBusDevice::start_on_bus(const transaction_t *data)
+{
+    _cs = 0;
+    // The arbiter runs the transfer with its own callback and the full
+    // event mask, and forwards the user's events from transfer_done().
+    // The per-device format and frequency are applied by the owner switch
+    // inside start_transfer(), which takes no lock and is ISR safe.
+    SPI::transfer(data->tx_buffer, data->tx_length, data->rx_buffer, data->rx_length,
+                  data->width, _bus._done, SPI_EVENT_ALL);
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,197 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SPI_BUS_ARBITER_H
+#define MBED_SPI_BUS_ARBITER_H
+
+#include "platform/platform.h"
+
+#if (defined(DEVICE_SPI) && defined(DEVICE_SPI_ASYNCH) && MBED_CONF_DRIVERS_SPI_ARBITER_QUEUE_SIZE) || defined(DOXYGEN_ONLY)
+
+#include "drivers/SPI.h"
+#include "drivers/DigitalOut.h"
+#include "platform/NonCopyable.h"
+#include "platform/Transaction.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+class SPIBusDevice;
+
+/** An arbiter for one physical SPI bus shared by several devices.
+ *
+ * Plain SPI objects sharing a bus serialize through the SPI mutex in
+ * strict FIFO order and leave chip select to the caller. The arbiter
+ * instead keeps a priority-ordered queue of transfers for the bus: each
+ * SPIBusDevice binds a chip select pin and a scheduling priority, and
+ * submits non-blocking transfers which the arbiter starts in priority
+ * order, asserting the device's chip select for exactly the duration of
+ * its granted transfer. A bulk, low priority transfer therefore delays a
+ * small, high priority one by at most the transfer already on the wire.
+ *
+ * The queue depth is set with drivers.spi-arbiter-queue-size; the default
+ * of 0 compiles the arbiter out.
+ *
+ * Example:
+ * @code
+ * SPIBusArbiter bus(p5, p6, p7);
+ * SPIBusDevice display(bus, p8, 0);  // bulk, low priority
+ * SPIBusDevice encoder(bus, p9, 1);  // tiny, deadline bound
+ *
+ * display.transfer(frame, sizeof(frame), NULL, 0, frame_done);
+ * encoder.transfer(NULL, 0, sample, sizeof(sample), sample_done);
+ * @endcode
+ *
+ * @note Synchronization level: Interrupt safe
+ * @ingroup drivers
+ */
+class SPIBusArbiter : private NonCopyable<SPIBusArbiter> {
+public:
+    /** Create an arbiter for the physical bus on the given pins
+     *
+     *  @param mosi SPI Master Out, Slave In pin
+     *  @param miso SPI Master In, Slave Out pin
+     *  @param sclk SPI Clock pin
+     */
+    SPIBusArbiter(PinName mosi, PinName miso, PinName sclk);
+
+private:
+    friend class SPIBusDevice;
+
+    /* One queued transfer. The callback and event stored in the
+     * transaction are the user's; the arbiter runs the transfer with its
+     * own completion callback and forwards matching events afterwards. */
+    struct pending_t {
+        SPIBusDevice *device;
+        transaction_t data;
+        int priority;
+        bool chain;    // chip select stays asserted into the next queued
+                       // segment of the same device
+        pending_t *next;
+    };
+
+    /* Queue one transfer, or a chain of segments over which the device's
+     * chip select is held asserted. Either the whole chain is queued or
+     * nothing is. Returns 0 on success, -1 if the queue cannot hold it. */
+    int enqueue(SPIBusDevice *device, const SPI::transfer_segment_t *segments,
+                int count, const event_callback_t &callback, int event);
+
+    /* Start the best pending transfer if the bus is idle. Interrupts
+     * must be disabled by the caller. */
+    void dispatch();
+
+    /* Completion callback for the transfer on the wire: releases or
+     * holds the chip select, starts the next transfer, forwards the
+     * user's events. Runs in interrupt context. */
+    void transfer_done(int event);
+
+    PinName _mosi;
+    PinName _miso;
+    PinName _sclk;
+    event_callback_t _done;
+    pending_t _slots[MBED_CONF_DRIVERS_SPI_ARBITER_QUEUE_SIZE];
+    pending_t *_free;
+    pending_t *_pending;       // sorted by descending priority, FIFO within one
+    pending_t *_active;        // the transfer on the wire, NULL if idle
+    SPIBusDevice *_chain_device; // device whose chain holds the chip select
+};
+
+/** An SPI device on an arbitrated bus.
+ *
+ * Inherits SPI, so format(), frequency() and set_default_write_value()
+ * configure this device individually - the arbiter applies them through
+ * the usual peripheral owner switch when it grants the bus. The chip
+ * select pin is bound at construction (active low) and driven by the
+ * arbiter, not the caller.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @ingroup drivers
+ */
+class SPIBusDevice : public SPI {
+public:
+    /** Create a device on an arbitrated bus
+     *
+     *  @param bus      The arbiter of the physical bus the device sits on
+     *  @param cs       Chip select pin of the device, active low
+     *  @param priority Scheduling priority, higher values are granted the
+     *                  bus first; equal priorities run in submission order
+     */
+    SPIBusDevice(SPIBusArbiter &bus, PinName cs, int priority = 0);
+
+    /** Queue a non-blocking transfer of 8-bit buffers on the arbitrated bus
+     *
+     *  The arbiter asserts the chip select, runs the transfer when the
+     *  device's turn comes and releases the chip select on completion.
+     *  The callback is invoked from interrupt context.
+     *
+     *  @param tx_buffer The TX buffer with data to be transfered. If NULL
+     *                   is passed, the default SPI value is sent
+     *  @param tx_length The length of TX buffer in bytes
+     *  @param rx_buffer The RX buffer which is used for received data. If
+     *                   NULL is passed, received data are ignored
+     *  @param rx_length The length of RX buffer in bytes
+     *  @param callback  The event callback function
+     *  @param event     The logical OR of events to report
+     *  @return Zero if the transfer was queued, or -1 if the queue is full
+     */
+    int transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length,
+                 const event_callback_t &callback = event_callback_t(),
+                 int event = SPI_EVENT_COMPLETE);
+
+    /** Queue a chain of segments run back-to-back under one chip select
+     *
+     *  The whole chain is queued atomically and the chip select stays
+     *  asserted from the first segment to the last, with no other device
+     *  scheduled in between. Intermediate segments only report errors;
+     *  the completion event comes from the last segment. If a segment
+     *  fails, the rest of the chain is dropped and the chip select
+     *  released.
+     *
+     *  @param segments Array of transfer segments
+     *  @param count    Number of segments in the array
+     *  @param callback The event callback function
+     *  @param event    The logical OR of events to report
+     *  @return Zero if the chain was queued, or -1 if it does not fit
+     */
+    int transfer_segments(const transfer_segment_t *segments, int count,
+                          const event_callback_t &callback = event_callback_t(),
+                          int event = SPI_EVENT_COMPLETE);
+
+    /** Change the scheduling priority of this device
+     *
+     *  Applies to transfers submitted afterwards; already queued
+     *  transfers keep the priority they were submitted with.
+     *
+     *  @param priority Scheduling priority, higher values run first
+     */
+    void set_priority(int priority);
+
+private:
+    friend class SPIBusArbiter;
+
+    /* Assert the chip select and start a granted transfer on the wire.
+     * Called by the arbiter, in interrupt context after the first grant. */
+    void start_on_bus(const transaction_t *data);
+
+    SPIBusArbiter &_bus;
+    DigitalOut _cs;
+    int _priority;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
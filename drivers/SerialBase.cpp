@@ -28,7 +28,9 @@ SerialBase::SerialBase(PinName tx, PinName rx, int baud) :
                                                  _rx_usage(DMA_USAGE_NEVER), _tx_callback(NULL),
                                                  _rx_callback(NULL),
 #endif
-                                                _serial(), _baud(baud) {
+                                                _serial(), _baud(baud),
+                                                _md_enabled(false), _md_selected(false),
+                                                _md_address(0), _md_mark(0), _md_pending(-1) {
     // No lock needed in the constructor
 
     for (size_t i = 0; i < sizeof _irq / sizeof _irq[0]; i++) {
@@ -55,7 +57,7 @@ void SerialBase::format(int bits, Parity parity, int stop_bits) {
 
 int SerialBase::readable() {
     lock();
-    int ret = serial_readable(&_serial);
+    int ret = (_md_enabled && (_md_pending >= 0)) || serial_readable(&_serial);
     unlock();
     return ret;
 }
@@ -93,13 +95,50 @@ void SerialBase::attach(Callback<void()> func, IrqType type) {
 
 void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type) {
     SerialBase *handler = (SerialBase*)id;
+#if !DEVICE_SERIAL_9BIT_MULTIDROP
+    // With hardware address matching foreign frames never interrupt;
+    // without it they are dropped here before anything is woken up
+    if (((IrqType)irq_type == RxIrq) && handler->_md_enabled && !handler->_multidrop_accept()) {
+        return;
+    }
+#endif
     if (handler->_irq[irq_type]) {
         handler->_irq[irq_type]();
     }
 }
 
+// Runs in the RX interrupt. Consumes frames until one for this node is
+// found, which is parked for getc() - the user handler reads it through
+// the normal path without knowing the filter took it off the wire first.
+bool SerialBase::_multidrop_accept() {
+    while (serial_readable(&_serial)) {
+        int c = serial_getc(&_serial);
+        if ((c & _md_mark) == _md_mark) {
+            // Address frame - selects one node, mutes the rest
+            _md_selected = ((uint8_t)c == _md_address);
+            continue;
+        }
+        if (!_md_selected) {
+            // Another node's data
+            continue;
+        }
+        _md_pending = c;
+        return true;
+    }
+    return false;
+}
+
 int SerialBase::_base_getc() {
     // Mutex is already held
+    if (_md_enabled) {
+        core_util_critical_section_enter();
+        int pending = _md_pending;
+        _md_pending = -1;
+        core_util_critical_section_exit();
+        if (pending >= 0) {
+            return pending;
+        }
+    }
     return serial_getc(&_serial);
 }
 
@@ -125,6 +164,34 @@ void SerialBase::send_break() {
   unlock();
 }
 
+void SerialBase::set_multidrop_filter(uint8_t address, uint8_t address_mark) {
+    lock();
+    core_util_critical_section_enter();
+    _md_address = address;
+    _md_mark = address_mark;
+    _md_selected = false;
+    _md_pending = -1;
+    _md_enabled = true;
+#if DEVICE_SERIAL_9BIT_MULTIDROP
+    serial_address_match(&_serial, address, 1);
+#endif
+    core_util_critical_section_exit();
+    unlock();
+}
+
+void SerialBase::clear_multidrop_filter() {
+    lock();
+    core_util_critical_section_enter();
+    _md_enabled = false;
+    _md_selected = false;
+    _md_pending = -1;
+#if DEVICE_SERIAL_9BIT_MULTIDROP
+    serial_address_match(&_serial, _md_address, 0);
+#endif
+    core_util_critical_section_exit();
+    unlock();
+}
+
 void SerialBase::lock() {
     // Stub
 }
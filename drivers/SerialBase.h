@@ -139,6 +139,36 @@ public:
      */
     void send_break();
 
+    /** Enable multidrop address filtering on the receive path
+     *
+     *  On a shared bus (RS-485 sensor chain) every node sees every frame;
+     *  the filter makes sure only traffic addressed to this node reaches
+     *  the attached RX handler. On targets with hardware address matching
+     *  (DEVICE_SERIAL_9BIT_MULTIDROP) the UART is muted in hardware and
+     *  foreign frames do not generate interrupts at all. Elsewhere the
+     *  frames are consumed and discarded inside the RX interrupt, so the
+     *  interrupt still fires per frame but the handler - and anything it
+     *  wakes - only runs for this node's data.
+     *
+     *  In the software fallback a frame whose bits under address_mark are
+     *  all set is treated as an address frame: the frame selects the node
+     *  whose address it carries and mutes everyone else. The default mark
+     *  of 0x80 maps the 9th-bit address-mark convention onto the high
+     *  data bit, leaving 7-bit payloads. Address frames are consumed by
+     *  the filter and not delivered.
+     *
+     *  @param address      the address of this node
+     *  @param address_mark bit mask identifying address frames in the
+     *                      software fallback (default 0x80)
+     */
+    void set_multidrop_filter(uint8_t address, uint8_t address_mark = 0x80);
+
+    /** Disable multidrop address filtering
+     *
+     *  Every received frame is delivered again.
+     */
+    void clear_multidrop_filter();
+
 protected:
 
     /** Acquire exclusive access to this serial port
@@ -246,6 +276,13 @@ protected:
     int _base_getc();
     int _base_putc(int c);
 
+    /** Consume bus traffic in the RX interrupt until a frame for this
+     *  node is found, see set_multidrop_filter()
+     *
+     *  @return true if a frame for this node was parked for getc()
+     */
+    bool _multidrop_accept();
+
 #if DEVICE_SERIAL_ASYNCH
     CThunk<SerialBase> _thunk_irq;
     DMAUsage _tx_usage;
@@ -258,6 +295,12 @@ protected:
     Callback<void()> _irq[IrqCnt];
     int              _baud;
 
+    bool             _md_enabled;   /**< Multidrop filter armed, see set_multidrop_filter(). */
+    bool             _md_selected;  /**< The last address frame was ours. */
+    uint8_t          _md_address;   /**< This node's address. */
+    uint8_t          _md_mark;      /**< Bit mask identifying address frames. */
+    int              _md_pending;   /**< Accepted frame parked for getc(), -1 if none. */
+
 };
 
 } // namespace mbed
@@ -30,6 +30,9 @@ extern const uint8_t Table_CRC_8bit_CCITT[MBED_CRC_TABLE_SIZE];
 extern const uint16_t Table_CRC_16bit_CCITT[MBED_CRC_TABLE_SIZE];
 extern const uint16_t Table_CRC_16bit_IBM[MBED_CRC_TABLE_SIZE];
 extern const uint32_t Table_CRC_32bit_ANSI[MBED_CRC_TABLE_SIZE];
+#if MBED_CONF_DRIVERS_CRC_SLICE_BY_8
+extern const uint32_t Table_CRC_32bit_ANSI_Slice8[8][MBED_CRC_TABLE_SIZE];
+#endif
 
 /** @}*/
 } // namespace mbed
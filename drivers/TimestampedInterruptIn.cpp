@@ -0,0 +1,109 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/TimestampedInterruptIn.h"
+
+#if defined(DEVICE_INTERRUPTIN) && defined(DEVICE_USTICKER)
+
+namespace mbed {
+
+TimestampedInterruptIn::TimestampedInterruptIn(PinName pin, edge_t *buffer, size_t buffer_size) :
+    InterruptIn(pin), _buffer(buffer), _buffer_size(buffer_size),
+    _head(0), _tail(0), _batch(1), _batched(0), _notify(NULL), _overflows(0)
+{
+}
+
+TimestampedInterruptIn::TimestampedInterruptIn(PinName pin, PinMode mode, edge_t *buffer, size_t buffer_size) :
+    InterruptIn(pin, mode), _buffer(buffer), _buffer_size(buffer_size),
+    _head(0), _tail(0), _batch(1), _batched(0), _notify(NULL), _overflows(0)
+{
+}
+
+void TimestampedInterruptIn::capture_start(size_t batch, Callback<void()> notify)
+{
+    core_util_critical_section_enter();
+    _batch = batch ? batch : 1;
+    _batched = 0;
+    _notify = notify;
+    rise(callback(this, &TimestampedInterruptIn::edge_rise));
+    fall(callback(this, &TimestampedInterruptIn::edge_fall));
+    core_util_critical_section_exit();
+}
+
+void TimestampedInterruptIn::capture_stop()
+{
+    core_util_critical_section_enter();
+    rise(NULL);
+    fall(NULL);
+    _notify = NULL;
+    core_util_critical_section_exit();
+}
+
+void TimestampedInterruptIn::edge_rise()
+{
+    record(1);
+}
+
+void TimestampedInterruptIn::edge_fall()
+{
+    record(0);
+}
+
+void TimestampedInterruptIn::record(uint8_t rising)
+{
+    // Stamp first so the time reflects the edge, not the queue handling
+    us_tick_t now = us_ticker_timestamp();
+
+    size_t head = _head;
+    size_t next = (head + 1 == _buffer_size) ? 0 : head + 1;
+    if (next == _tail) {
+        _overflows++;
+    } else {
+        _buffer[head].timestamp = now;
+        _buffer[head].rising = rising;
+        _head = next;
+    }
+
+    if (++_batched >= _batch) {
+        _batched = 0;
+        if (_notify) {
+            _notify();
+        }
+    }
+}
+
+size_t TimestampedInterruptIn::read_edges(edge_t *edges, size_t count)
+{
+    size_t read = 0;
+    size_t tail = _tail;
+
+    while (read < count && tail != _head) {
+        edges[read++] = _buffer[tail];
+        tail = (tail + 1 == _buffer_size) ? 0 : tail + 1;
+    }
+    _tail = tail;
+    return read;
+}
+
+size_t TimestampedInterruptIn::pending() const
+{
+    size_t head = _head;
+    size_t tail = _tail;
+    return (head >= tail) ? head - tail : _buffer_size - tail + head;
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,152 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TIMESTAMPEDINTERRUPTIN_H
+#define MBED_TIMESTAMPEDINTERRUPTIN_H
+
+#include "drivers/InterruptIn.h"
+
+#if (defined(DEVICE_INTERRUPTIN) && defined(DEVICE_USTICKER)) || defined(DOXYGEN_ONLY)
+
+#include "hal/us_ticker_api.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** An InterruptIn that timestamps edges and batches notifications
+ *
+ *  Each edge is stamped in the gpio_irq handler with the microsecond
+ *  ticker's fast timestamp path and pushed into a caller-provided ring,
+ *  so the timestamp reflects the interrupt itself rather than whenever
+ *  a thread got scheduled. The attached callback fires once per batch
+ *  of edges instead of once per edge - a 5 kHz pulse train read in
+ *  batches of 32 costs one wakeup per 6.4 ms with every pulse still
+ *  stamped to the microsecond.
+ *
+ *  The ring is single-producer single-consumer: the ISR pushes, one
+ *  reader context pops with read_edges(). Edges arriving while the ring
+ *  is full are dropped and counted.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * static TimestampedInterruptIn::edge_t edges[64];
+ * TimestampedInterruptIn flow(p16, edges, 64);
+ *
+ * void on_batch()   // interrupt context - just signal the reader
+ * {
+ *     reader_sem.release();
+ * }
+ *
+ * int main() {
+ *     flow.capture_start(32, on_batch);
+ *     while (1) {
+ *         reader_sem.wait();
+ *         TimestampedInterruptIn::edge_t batch[32];
+ *         size_t n = flow.read_edges(batch, 32);
+ *         // pulse rate from batch[i].timestamp deltas
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class TimestampedInterruptIn : public InterruptIn {
+
+public:
+    /** One captured edge */
+    struct edge_t {
+        us_tick_t timestamp;    /**< Raw ticks, see us_ticker_ticks_to_us(). */
+        uint8_t rising;         /**< 1 for a rising edge, 0 for falling. */
+    };
+
+    /** Create a timestamping InterruptIn on the specified pin
+     *
+     *  @param pin         InterruptIn pin to connect to
+     *  @param buffer      Edge ring storage, must outlive the object
+     *  @param buffer_size Number of entries in buffer
+     */
+    TimestampedInterruptIn(PinName pin, edge_t *buffer, size_t buffer_size);
+
+    /** Create a timestamping InterruptIn with the pin in the specified mode
+     *
+     *  @param pin         InterruptIn pin to connect to
+     *  @param mode        The mode to set the pin to (PullUp/PullDown/etc.)
+     *  @param buffer      Edge ring storage, must outlive the object
+     *  @param buffer_size Number of entries in buffer
+     */
+    TimestampedInterruptIn(PinName pin, PinMode mode, edge_t *buffer, size_t buffer_size);
+
+    /** Start capturing both edges into the ring
+     *
+     *  Takes over the pin's rise and fall callbacks. The notify callback
+     *  runs in interrupt context each time batch more edges have been
+     *  captured - keep it to signaling the reader.
+     *
+     *  @param batch  Edges per notification, at least 1
+     *  @param notify Callback run in the ISR once per batch; may be
+     *                empty to just accumulate and poll with pending()
+     */
+    void capture_start(size_t batch, Callback<void()> notify);
+
+    /** Stop capturing and detach the edge handlers */
+    void capture_stop();
+
+    /** Pop captured edges, oldest first
+     *
+     *  Must be called from a single reader context.
+     *
+     *  @param edges Array the edges are copied to
+     *  @param count Capacity of the array
+     *  @return Number of edges copied
+     */
+    size_t read_edges(edge_t *edges, size_t count);
+
+    /** Number of edges waiting in the ring */
+    size_t pending() const;
+
+    /** Edges dropped because the ring was full
+     *
+     *  @return Dropped edge count since construction
+     */
+    uint32_t overflows() const
+    {
+        return _overflows;
+    }
+
+private:
+    void edge_rise();
+    void edge_fall();
+    void record(uint8_t rising);
+
+    edge_t *_buffer;
+    size_t _buffer_size;
+    // SPSC ring positions: the ISR only writes _head, the reader only
+    // writes _tail, so neither side needs to mask interrupts (same
+    // reasoning as SPSCCircularBuffer); one entry is left unused to
+    // tell full from empty
+    volatile size_t _head;
+    volatile size_t _tail;
+    size_t _batch;
+    size_t _batched;
+    Callback<void()> _notify;
+    volatile uint32_t _overflows;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -34,6 +34,11 @@ UARTSerial::UARTSerial(PinName tx, PinName rx, int baud) :
         _tx_irq_enabled(false),
         _rx_irq_enabled(true),
         _dcd_irq(NULL)
+#if DEVICE_SERIAL_ASYNCH
+        , _rx_frame_char(SERIAL_RESERVED_CHAR_MATCH),
+        _rx_dma_enabled(false),
+        _rx_dma_active(false)
+#endif
 {
     /* Attatch IRQ routines to the serial device. */
     SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
@@ -209,6 +214,15 @@ ssize_t UARTSerial::read(void* buffer, size_t length)
     }
 
     core_util_critical_section_enter();
+#if DEVICE_SERIAL_ASYNCH
+    if (_rx_dma_enabled) {
+        /* Space was just freed up - restart reception if it had stalled
+         * on a full buffer. */
+        if (!_rx_dma_active) {
+            start_rx_dma();
+        }
+    } else
+#endif
     if (!_rx_irq_enabled) {
         UARTSerial::rx_irq();               // only read from hardware in one place
         if (!_rxbuf.full()) {
@@ -223,6 +237,131 @@ ssize_t UARTSerial::read(void* buffer, size_t length)
     return data_read;
 }
 
+ssize_t UARTSerial::read_claim(const char **buffer)
+{
+    api_lock();
+
+    while (_rxbuf.empty()) {
+        if (!_blocking) {
+            api_unlock();
+            return -EAGAIN;
+        }
+        api_unlock();
+        wait_ms(1);  // XXX todo - proper wait, WFE for non-rtos ?
+        api_lock();
+    }
+
+    size_t claimed = _rxbuf.peek_block(buffer);
+
+    api_unlock();
+
+    return claimed;
+}
+
+ssize_t UARTSerial::read_release(size_t amount)
+{
+    api_lock();
+
+    size_t released = _rxbuf.drop(amount);
+
+    core_util_critical_section_enter();
+#if DEVICE_SERIAL_ASYNCH
+    if (_rx_dma_enabled) {
+        if (!_rx_dma_active) {
+            start_rx_dma();
+        }
+    } else
+#endif
+    if (!_rx_irq_enabled) {
+        UARTSerial::rx_irq();               // only read from hardware in one place
+        if (!_rxbuf.full()) {
+            SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
+            _rx_irq_enabled = true;
+        }
+    }
+    core_util_critical_section_exit();
+
+    api_unlock();
+
+    return released;
+}
+
+#if DEVICE_SERIAL_ASYNCH
+
+void UARTSerial::set_rx_dma(bool enable, unsigned char frame_char)
+{
+    api_lock();
+    core_util_critical_section_enter();
+    if (enable && !_rx_dma_enabled) {
+        /* Take over from the byte-interrupt path */
+        if (_rx_irq_enabled) {
+            SerialBase::attach(NULL, RxIrq);
+            _rx_irq_enabled = false;
+        }
+        _rx_frame_char = frame_char;
+        _rx_dma_enabled = true;
+        start_rx_dma();
+    } else if (!enable && _rx_dma_enabled) {
+        if (_rx_dma_active) {
+            SerialBase::abort_read();
+            _rx_dma_active = false;
+        }
+        _rx_dma_enabled = false;
+        if (!_rxbuf.full()) {
+            SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
+            _rx_irq_enabled = true;
+        }
+    } else if (enable) {
+        _rx_frame_char = frame_char;
+    }
+    core_util_critical_section_exit();
+    api_unlock();
+}
+
+void UARTSerial::start_rx_dma(void)
+{
+    size_t space = MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE - _rxbuf.size();
+    if (space == 0) {
+        /* Stalled - read() restarts us once it has drained some data */
+        return;
+    }
+    size_t chunk = sizeof(_rx_dma_staging);
+    if (chunk > space) {
+        chunk = space;
+    }
+    _rx_dma_active = true;
+    SerialBase::read(_rx_dma_staging, chunk,
+                     callback(this, &UARTSerial::rx_dma_irq),
+                     SERIAL_EVENT_RX_COMPLETE | SERIAL_EVENT_RX_CHARACTER_MATCH,
+                     _rx_frame_char);
+}
+
+void UARTSerial::rx_dma_irq(int event)
+{
+    (void)event;
+    _rx_dma_active = false;
+
+    /* A character match terminates the transfer short; the HAL leaves the
+     * number of bytes actually received in the RX buffer position. */
+    size_t received = _serial.rx_buff.pos;
+    bool was_empty = _rxbuf.empty();
+
+    for (size_t i = 0; i < received && !_rxbuf.full(); i++) {
+        _rxbuf.push(_rx_dma_staging[i]);
+    }
+
+    if (_rx_dma_enabled) {
+        start_rx_dma();
+    }
+
+    /* Report the File handler that data is ready to be read from the buffer. */
+    if (was_empty && !_rxbuf.empty()) {
+        wake();
+    }
+}
+
+#endif
+
 bool UARTSerial::hup() const
 {
     return _dcd_irq && _dcd_irq->read() != 0;
@@ -37,6 +37,10 @@
 #define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
 #endif
 
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_CHUNK_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_CHUNK_SIZE  32
+#endif
+
 namespace mbed {
 
 /** \addtogroup drivers */
@@ -97,6 +101,38 @@ public:
      */
     virtual ssize_t read(void* buffer, size_t length);
 
+    /** Claim zero-copy read access to buffered receive data
+     *
+     *  Hands out a pointer to the longest contiguous run of data inside
+     *  the internal receive buffer, so a protocol parser can work on it
+     *  in place instead of copying it out through read(). The claimed
+     *  region stays valid until it is consumed with read_release().
+     *
+     *  Follows the same blocking semantics as read(): if no data is
+     *  available and non-blocking is set, returns -EAGAIN; if blocking,
+     *  waits until data is available.
+     *
+     *  The buffered data may wrap around the internal buffer, so less
+     *  than the total buffered amount can be claimed in one call; claim
+     *  again after releasing to reach the rest.
+     *
+     *  @param buffer   Updated to point at the first buffered byte
+     *  @return         The number of contiguous bytes available at *buffer,
+     *                  negative error on failure
+     */
+    virtual ssize_t read_claim(const char **buffer);
+
+    /** Consume data previously claimed with read_claim()
+     *
+     *  Frees up to amount bytes from the front of the receive buffer and
+     *  restarts reception if it had stalled on a full buffer. Releasing
+     *  less than was claimed is allowed; the remainder stays buffered.
+     *
+     *  @param amount   Number of bytes the parser has consumed
+     *  @return         The number of bytes released
+     */
+    virtual ssize_t read_release(size_t amount);
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -186,6 +222,26 @@ public:
      */
     void set_baud(int baud);
 
+#if DEVICE_SERIAL_ASYNCH || defined(DOXYGEN_ONLY)
+    /** Enable or disable DMA-fed reception
+     *
+     *  In DMA mode the receive side is fed by chunked asynchronous
+     *  transfers into the internal buffer instead of one interrupt per
+     *  byte, so sustained high-baud traffic costs one interrupt per chunk.
+     *  The FileHandle read() API is unchanged.
+     *
+     *  An optional frame character (for example '\n' for AT traffic)
+     *  terminates a chunk early via the HAL character match, bounding the
+     *  latency until buffered data becomes visible to read().
+     *
+     *  @param enable      true to feed the receive buffer by DMA, false for
+     *                     the byte-interrupt path
+     *  @param frame_char  Character that completes a chunk early, in range
+     *                     0-254, or SERIAL_RESERVED_CHAR_MATCH for none
+     */
+    void set_rx_dma(bool enable, unsigned char frame_char = SERIAL_RESERVED_CHAR_MATCH);
+#endif
+
     // Expose private SerialBase::Parity as UARTSerial::Parity
     using SerialBase::Parity;
     // In C++11, we wouldn't need to also have using directives for each value
@@ -253,6 +309,27 @@ private:
     bool _rx_irq_enabled;
     InterruptIn *_dcd_irq;
 
+#if DEVICE_SERIAL_ASYNCH
+    /** Staging area one DMA chunk is received into before it is pushed
+     *  to the circular buffer from the completion interrupt.
+     */
+    uint8_t _rx_dma_staging[MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_CHUNK_SIZE];
+    unsigned char _rx_frame_char;
+    bool _rx_dma_enabled;
+    bool _rx_dma_active;
+
+    /** Start the next chunked asynchronous receive, sized to the free
+     *  space in the circular buffer. Does nothing if the buffer is full;
+     *  read() restarts reception once space is available.
+     */
+    void start_rx_dma(void);
+
+    /** Completion handler for a DMA chunk, pushes received data to the
+     *  circular buffer and re-arms reception.
+     */
+    void rx_dma_irq(int event);
+#endif
+
     /** Device Hanged up
      *  Determines if the device hanged up on us.
      *
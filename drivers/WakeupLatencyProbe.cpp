@@ -0,0 +1,206 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/WakeupLatencyProbe.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "cmsis.h"
+#include <string.h>
+
+#if !defined(__CORTEX_M) || (__CORTEX_M < 3)
+#include "hal/us_ticker_api.h"
+#endif
+
+static mbed_stats_wakeup_latency_t wakeup_stats[MBED_WAKEUP_PATH_COUNT];
+
+void mbed_stats_wakeup_latency_get(mbed_wakeup_path_t path, mbed_stats_wakeup_latency_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_wakeup_latency_t));
+
+    if (path < MBED_WAKEUP_PATH_COUNT) {
+        core_util_critical_section_enter();
+        *stats = wakeup_stats[path];
+        core_util_critical_section_exit();
+    }
+}
+
+void mbed_stats_wakeup_latency_reset(void)
+{
+    core_util_critical_section_enter();
+    memset(wakeup_stats, 0, sizeof(wakeup_stats));
+    core_util_critical_section_exit();
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
+namespace mbed {
+
+#define PROBE_FLAG              0x1UL
+#define PROBE_THREAD_STACK_SIZE 1024
+
+static inline uint32_t probe_timestamp()
+{
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+    return DWT->CYCCNT;
+#else
+    return us_ticker_read();
+#endif
+}
+
+static inline uint32_t probe_ticks_to_us(uint32_t ticks)
+{
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+    return ticks / (SystemCoreClock / 1000000);
+#else
+    return ticks;
+#endif
+}
+
+WakeupLatencyProbe::WakeupLatencyProbe(us_timestamp_t period_us, osPriority priority) :
+    _queue(2 * EVENTS_EVENT_SIZE),
+    _semaphore(0),
+    _thread(priority, PROBE_THREAD_STACK_SIZE, NULL, "wakeup_probe"),
+    _period_us(period_us),
+    _t0(0),
+    _path(MBED_WAKEUP_PATH_SEMAPHORE),
+    _pending(false),
+    _running(false),
+    _started(false)
+{
+}
+
+WakeupLatencyProbe::~WakeupLatencyProbe()
+{
+    _ticker.detach();
+    if (_started) {
+        _running = false;
+        // Release whichever primitive the probe thread is blocked on so
+        // it can observe _running and exit
+        _semaphore.release();
+        _flags.set(PROBE_FLAG);
+        _queue.break_dispatch();
+        _thread.join();
+    }
+}
+
+void WakeupLatencyProbe::start()
+{
+    if (!_started) {
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+        _running = true;
+        _started = true;
+        _thread.start(callback(this, &WakeupLatencyProbe::probe_loop));
+    }
+    _ticker.attach_us(callback(this, &WakeupLatencyProbe::tick), _period_us);
+}
+
+void WakeupLatencyProbe::stop()
+{
+    _ticker.detach();
+}
+
+void WakeupLatencyProbe::tick()
+{
+    if (_pending) {
+        // The previous sample has not been consumed yet - releasing the
+        // same primitive twice would credit the next round with a stale
+        // timestamp, so skip this period
+        return;
+    }
+    _pending = true;
+
+    switch (_path) {
+        case MBED_WAKEUP_PATH_SEMAPHORE:
+            _t0 = probe_timestamp();
+            _semaphore.release();
+            break;
+        case MBED_WAKEUP_PATH_EVENT_FLAGS:
+            _t0 = probe_timestamp();
+            _flags.set(PROBE_FLAG);
+            break;
+        default:
+            // The post itself is part of what a woken thread pays for on
+            // this path, so the timestamp is taken before it
+            _t0 = probe_timestamp();
+            if (!_queue.call(callback(this, &WakeupLatencyProbe::queue_sample))) {
+                _pending = false;
+            }
+            break;
+    }
+}
+
+void WakeupLatencyProbe::probe_loop()
+{
+    while (_running) {
+        switch (_path) {
+            case MBED_WAKEUP_PATH_SEMAPHORE:
+                _semaphore.wait();
+                break;
+            case MBED_WAKEUP_PATH_EVENT_FLAGS:
+                _flags.wait_any(PROBE_FLAG);
+                break;
+            default:
+                // Broken out of by queue_sample() or the destructor
+                _queue.dispatch_forever();
+                continue;
+        }
+        if (!_running) {
+            break;
+        }
+        record();
+    }
+}
+
+void WakeupLatencyProbe::queue_sample()
+{
+    if (_running) {
+        record();
+    }
+    _queue.break_dispatch();
+}
+
+void WakeupLatencyProbe::record()
+{
+    uint32_t latency_us = probe_ticks_to_us(probe_timestamp() - _t0);
+    mbed_stats_wakeup_latency_t *stats = &wakeup_stats[_path];
+
+    uint32_t bucket = 0;
+    while ((latency_us >> (bucket + 1)) && (bucket < MBED_STATS_WAKEUP_LATENCY_BUCKET_COUNT - 1)) {
+        bucket++;
+    }
+
+    core_util_critical_section_enter();
+    stats->samples++;
+    if ((stats->samples == 1) || (latency_us < stats->min_us)) {
+        stats->min_us = latency_us;
+    }
+    if (latency_us > stats->max_us) {
+        stats->max_us = latency_us;
+    }
+    stats->total_us += latency_us;
+    stats->bucket[bucket]++;
+    core_util_critical_section_exit();
+
+    _path = (_path + 1) % MBED_WAKEUP_PATH_COUNT;
+    _pending = false;
+}
+
+} // namespace mbed
+
+#endif
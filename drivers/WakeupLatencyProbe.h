@@ -0,0 +1,108 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_WAKEUPLATENCYPROBE_H
+#define MBED_WAKEUPLATENCYPROBE_H
+
+#include "platform/mbed_stats.h"
+
+#if defined(MBED_CONF_RTOS_PRESENT) || defined(DOXYGEN_ONLY)
+
+#include "drivers/Ticker.h"
+#include "events/EventQueue.h"
+#include "rtos/Thread.h"
+#include "rtos/Semaphore.h"
+#include "rtos/EventFlags.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A self-measuring interrupt-to-thread wakeup latency probe
+ *
+ *  A periodic Ticker interrupt timestamps itself and releases one wakeup
+ *  primitive in round-robin order - a Semaphore release, an EventFlags
+ *  set or an EventQueue call - and a high-priority probe thread blocked
+ *  on that primitive takes the interrupt-to-thread delta from the DWT
+ *  cycle counter (the microsecond ticker on cores without one). Samples
+ *  are accumulated into one histogram per path, readable at any time
+ *  through mbed_stats_wakeup_latency_get().
+ *
+ *  At the default one sample per second the probe costs one interrupt
+ *  and one thread wakeup per period, cheap enough to leave running in
+ *  production and watch scheduling latency drift on live devices.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * @note Keep the probe thread priority above the threads under
+ * observation, so the measured delta is scheduler dispatch latency and
+ * not the runtime of whatever preempts the probe.
+ *
+ * @ingroup drivers
+ */
+class WakeupLatencyProbe : private NonCopyable<WakeupLatencyProbe> {
+
+public:
+    /** Create a wakeup latency probe
+     *
+     *  @param period_us sampling period in microseconds, one wakeup path
+     *                   is exercised per period
+     *  @param priority  priority of the probe thread
+     */
+    WakeupLatencyProbe(us_timestamp_t period_us = 1000000, osPriority priority = osPriorityRealtime);
+
+    ~WakeupLatencyProbe();
+
+    /** Start sampling */
+    void start();
+
+    /** Stop sampling
+     *
+     *  The collected histograms are kept and sampling can be restarted
+     *  with start().
+     */
+    void stop();
+
+private:
+    /** Ticker handler - timestamps and releases the current path's primitive */
+    void tick();
+
+    /** Probe thread body - blocks on the current path's primitive */
+    void probe_loop();
+
+    /** EventQueue path handler, run on the probe thread by dispatch */
+    void queue_sample();
+
+    /** Record one latency sample and advance to the next path */
+    void record();
+
+    Ticker _ticker;
+    events::EventQueue _queue;          /**< Queue for the EventQueue path. */
+    rtos::Semaphore _semaphore;
+    rtos::EventFlags _flags;
+    rtos::Thread _thread;
+    us_timestamp_t _period_us;
+    volatile uint32_t _t0;              /**< Timestamp taken in the ticker ISR. */
+    volatile uint8_t _path;             /**< Path the probe thread is blocked on. */
+    volatile bool _pending;             /**< A sample is in flight, skip overlapping ticks. */
+    volatile bool _running;             /**< Cleared to shut the probe thread down. */
+    bool _started;                      /**< The probe thread has been spawned. */
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
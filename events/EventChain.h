@@ -0,0 +1,185 @@
+/* events
+ * Copyright (c) 2016 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_CHAIN_H
+#define EVENT_CHAIN_H
+
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_assert.h"
+#include <string.h>
+
+namespace events {
+/** \addtogroup events */
+
+/** EventChain
+ *
+ *  Sequence of continuations executed by an EventQueue
+ *  @ingroup events
+ *
+ *  A chain holds a fixed number of continuation slots that are filled with
+ *  then(). Once posted, each stage runs as its own event and reposts the
+ *  next stage with no delay, so the whole chain executes back-to-back
+ *  within a single dispatch wakeup while events from other users of the
+ *  queue still interleave fairly between the stages.
+ *
+ *  The continuation slots and the event storage live inside the chain
+ *  itself, so posting never touches the heap or the queue's memory pool
+ *  and cannot fail for lack of memory.
+ */
+template <int N>
+class EventChain : private mbed::NonCopyable<EventChain<N> > {
+public:
+    /** Create an event chain
+     *
+     *  @param queue    Event queue that executes the chain's stages
+     */
+    EventChain(EventQueue *queue)
+        : _queue(queue), _count(0), _index(0), _posted(false)
+    {
+        memset(&_event, 0, sizeof(_event));
+        _event.chain = this;
+    }
+
+    /** Destroy an event chain
+     *
+     *  A posted chain is cancelled before the storage is released.
+     */
+    ~EventChain()
+    {
+        cancel();
+    }
+
+    /** Append a continuation to the chain
+     *
+     *  Stages run in the order they were appended. A stage beyond the
+     *  chain's capacity is dropped. Appending to a chain that has been
+     *  posted and has not yet completed is not allowed.
+     *
+     *  @param cb       Callback to run as the next stage
+     *  @return         Reference to this chain for then() chaining
+     */
+    EventChain &then(mbed::Callback<void()> cb)
+    {
+        MBED_ASSERT(!_posted);
+        MBED_ASSERT(_count < N);
+        if (!_posted && _count < N) {
+            _stages[_count++] = cb;
+        }
+        return *this;
+    }
+
+    /** Remove all continuations from an idle chain
+     */
+    void clear()
+    {
+        MBED_ASSERT(!_posted);
+        if (!_posted) {
+            for (int i = 0; i < _count; i++) {
+                _stages[i] = mbed::Callback<void()>();
+            }
+            _count = 0;
+            _index = 0;
+        }
+    }
+
+    /** Post the chain onto the event queue
+     *
+     *  The first stage runs at the next dispatch and the remaining stages
+     *  follow within the same dispatch pass. Once the last stage has run
+     *  the chain is idle again and may be reposted, including from its own
+     *  final stage. Posting an empty or already posted chain does nothing.
+     */
+    void post()
+    {
+        if (_posted || _count == 0) {
+            return;
+        }
+        _posted = true;
+        _index = 0;
+        post_stage();
+    }
+
+    /** Cancel a posted chain
+     *
+     *  Stages that have not yet run are dropped and the chain becomes
+     *  idle. The same in-flight caveats as EventQueue::cancel apply to a
+     *  stage that has already begun executing.
+     */
+    void cancel()
+    {
+        if (_posted) {
+            _queue->cancel_user_allocated(&_event.chain);
+            _posted = false;
+            _index = 0;
+        }
+    }
+
+private:
+    struct chain_event {
+        struct equeue_event e;
+        EventChain *chain;
+    };
+
+    void post_stage()
+    {
+        // one-shot, user-allocated storage must set its period explicitly
+        equeue_event_delay(&_event.chain, 0);
+        equeue_event_period(&_event.chain, -1);
+        _queue->post_user_allocated(&EventChain::thunk, &_event.chain);
+    }
+
+    static void thunk(void *data)
+    {
+        (*static_cast<EventChain **>(data))->run_stage();
+    }
+
+    void run_stage()
+    {
+        mbed::Callback<void()> cb = _stages[_index++];
+        if (_index >= _count) {
+            // chain complete before the stage runs, so the final stage
+            // may post the chain again
+            _posted = false;
+            _index = 0;
+            if (cb) {
+                cb();
+            }
+        } else {
+            if (cb) {
+                cb();
+            }
+            // reposting with no delay makes the next stage already due, so
+            // it runs in this dispatch pass without another wakeup
+            if (_posted) {
+                post_stage();
+            }
+        }
+    }
+
+    EventQueue *_queue;
+    mbed::Callback<void()> _stages[N];
+    int _count;
+    int _index;
+    bool _posted;
+    chain_event _event;
+};
+
+}
+
+#endif
+
+/** @}*/
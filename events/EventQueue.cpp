@@ -51,6 +51,22 @@ int EventQueue::time_left(int id) {
     return equeue_timeleft(&_equeue, id);
 }
 
+void EventQueue::post_user_allocated(void (*cb)(void *), void *event) {
+    equeue_post_user_allocated(&_equeue, cb, event);
+}
+
+void EventQueue::cancel_user_allocated(void *event) {
+    equeue_cancel_user_allocated(&_equeue, event);
+}
+
+int EventQueue::time_left_user_allocated(void *event) {
+    return equeue_timeleft_user_allocated(&_equeue, event);
+}
+
+void EventQueue::forward_user_allocated(void (*cb)(void *), void *event, int lane) {
+    equeue_forward(&_equeue, cb, event, lane);
+}
+
 void EventQueue::background(Callback<void(int)> update) {
     _update = update;
 
@@ -23,6 +23,10 @@
 #include <cstddef>
 #include <new>
 
+namespace mbed {
+class DeferredTicker;
+}
+
 namespace events {
 /** \addtogroup events */
 
@@ -145,6 +149,65 @@ public:
      */
     int time_left(int id);
 
+    /** Post an event with user-allocated storage onto the event queue
+     *
+     *  The storage is owned by the caller and laid out as a struct
+     *  equeue_event header immediately followed by the callback's data;
+     *  event must point at the data region. Posting links the storage
+     *  into the queue intrusively, so it never touches the queue's
+     *  allocator and cannot fail for lack of memory - see
+     *  equeue_post_user_allocated for the storage contract.
+     *
+     *  The post_user_allocated function is irq safe.
+     *
+     *  @param cb       Function called in the dispatch context with event
+     *                  as its argument
+     *  @param event    Pointer to the data region of the storage
+     */
+    void post_user_allocated(void (*cb)(void *), void *event);
+
+    /** Cancel an in-flight user-allocated event
+     *
+     *  Attempts to cancel an event posted with post_user_allocated,
+     *  identified by its storage rather than by id. Must only be called
+     *  on storage that has been posted; the same in-flight caveats as
+     *  cancel apply.
+     *
+     *  The cancel_user_allocated function is irq safe.
+     *
+     *  @param event    Pointer to the data region of the storage
+     */
+    void cancel_user_allocated(void *event);
+
+    /** Query how much time is left for a delayed user-allocated event
+     *
+     *  This function is irq safe.
+     *
+     *  @param event    Pointer to the data region of the storage
+     *
+     *  @return         Remaining time in milliseconds, or a negative
+     *                  value if the event is not delayed
+     */
+    int time_left_user_allocated(void *event);
+
+    /** Forward a user-allocated event onto this queue
+     *
+     *  Hands the event's storage over from another queue, typically from
+     *  within the event's own callback. The storage is reposted onto this
+     *  queue with the given callback and no delay, waking this queue's
+     *  dispatcher once. The event's priority lane is inherited as a floor -
+     *  see equeue_forward for the details.
+     *
+     *  The forward_user_allocated function is irq safe.
+     *
+     *  @param cb       Function called in this queue's dispatch context
+     *                  with event as its argument
+     *  @param event    Pointer to the data region of the storage
+     *  @param lane     Minimum priority lane for the forwarded event
+     *                  (default to 0)
+     */
+    void forward_user_allocated(void (*cb)(void *), void *event, int lane = 0);
+
     /** Background an event queue onto a single-shot timer-interrupt
      *
      *  When updated, the event queue will call the provided update function
@@ -476,6 +539,38 @@ public:
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
+    /** Calls an event on the queue after a specified delay, in a given
+     *  priority lane
+     *
+     *  Identical to call_in, except the posted event is assigned to the
+     *  given dispatch lane. When several due events compete for the
+     *  dispatch loop, events in higher lanes run first; events posted
+     *  with call or call_in use lane 0.
+     *
+     *  The call_in_lane function is irq safe and can act as a mechanism
+     *  for moving events out of irq contexts.
+     *
+     *  @param ms       Time to delay in milliseconds
+     *  @param lane     Priority lane, 0 to EQUEUE_LANES-1
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_in_lane(int ms, int lane, F f) {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_lane(e, lane);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
     /** Calls an event on the queue after a specified delay
      *  @see                        EventQueue::call_in
      *  @param ms                   Time to delay in milliseconds
@@ -2306,6 +2401,9 @@ public:
 protected:
     template <typename F>
     friend class Event;
+    // Posts preallocated event slots straight onto the underlying equeue
+    // from the ticker ISR
+    friend class mbed::DeferredTicker;
     struct equeue _equeue;
     mbed::Callback<void(int)> _update;
 
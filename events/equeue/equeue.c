@@ -43,6 +43,27 @@ static inline void equeue_incid(equeue_t *q, struct equeue_event *e) {
 }
 
 
+#if EQUEUE_STATIC_SLOTS > 32
+#error "EQUEUE_STATIC_SLOTS must fit in a 32-bit free-slot bitmap"
+#endif
+
+#if EQUEUE_STATIC_SLOTS > 0
+// size in bytes of a slot in the given size class
+static inline size_t equeue_slot_size(int c) {
+    return EQUEUE_EVENT_SIZE << c;
+}
+
+// total size of the slot region carved out of the queue buffer
+static inline size_t equeue_slots_size(void) {
+    size_t total = 0;
+    for (int c = 0; c < EQUEUE_SLOT_CLASSES; c++) {
+        total += EQUEUE_STATIC_SLOTS * equeue_slot_size(c);
+    }
+    return total;
+}
+#endif
+
+
 // equeue lifetime management
 int equeue_create(equeue_t *q, size_t size) {
     // dynamically allocate the specified buffer
@@ -70,6 +91,37 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
     q->slab.size = size;
     q->slab.data = buffer;
 
+#if EQUEUE_STATIC_SLOTS > 0
+    // carve the static slots out of the front of the buffer, leaving
+    // whatever remains for the chunk allocator
+    if (q->slab.size >= equeue_slots_size() + EQUEUE_EVENT_SIZE) {
+        q->slots.data = q->slab.data;
+        q->slab.data += equeue_slots_size();
+        q->slab.size -= equeue_slots_size();
+
+        unsigned char *p = q->slots.data;
+        for (int c = 0; c < EQUEUE_SLOT_CLASSES; c++) {
+            for (int i = 0; i < EQUEUE_STATIC_SLOTS; i++) {
+                struct equeue_event *e = (struct equeue_event *)p;
+                e->size = equeue_slot_size(c);
+                e->id = 1;
+                p += equeue_slot_size(c);
+            }
+
+            q->slots.map[c] = (EQUEUE_STATIC_SLOTS < 32)
+                    ? (1u << EQUEUE_STATIC_SLOTS) - 1
+                    : (unsigned)-1;
+        }
+    } else {
+        // buffer too small for the configured slots, chunk allocator only
+        q->slots.data = 0;
+    }
+#endif
+
+#if EQUEUE_MPSC_INTAKE
+    q->intake = 0;
+#endif
+
     q->queue = 0;
     q->tick = equeue_tick();
     q->generation = 0;
@@ -109,6 +161,15 @@ void equeue_destroy(equeue_t *q) {
         }
     }
 
+#if EQUEUE_MPSC_INTAKE
+    // events still on the intake stack never reached the queue
+    for (struct equeue_event *e = q->intake; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+#endif
+
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -122,12 +183,74 @@ void equeue_destroy(equeue_t *q) {
 }
 
 
+// equeue static slot allocation functions
+#if EQUEUE_STATIC_SLOTS > 0
+static struct equeue_event *equeue_slot_alloc(equeue_t *q, size_t size) {
+    // try each class that fits, claiming a free slot with a single
+    // compare-and-swap on the class's free bitmap
+    unsigned char *base = q->slots.data;
+    for (int c = 0; c < EQUEUE_SLOT_CLASSES; c++) {
+        if (size <= equeue_slot_size(c)) {
+            unsigned map = q->slots.map[c];
+            while (map) {
+                unsigned bit = map & -map;
+                if (equeue_atomic_cas_uint(&q->slots.map[c],
+                        &map, map & ~bit)) {
+                    int i = 0;
+                    for (unsigned b = bit >> 1; b; b >>= 1) {
+                        i += 1;
+                    }
+
+                    return (struct equeue_event *)
+                            (base + i*equeue_slot_size(c));
+                }
+            }
+        }
+
+        base += EQUEUE_STATIC_SLOTS * equeue_slot_size(c);
+    }
+
+    return 0;
+}
+
+static void equeue_slot_dealloc(equeue_t *q, struct equeue_event *e) {
+    // locate the slot's class and bit from its offset in the slot region
+    unsigned char *base = q->slots.data;
+    for (int c = 0; c < EQUEUE_SLOT_CLASSES; c++) {
+        size_t region = EQUEUE_STATIC_SLOTS * equeue_slot_size(c);
+        if ((unsigned char *)e < base + region) {
+            unsigned bit = 1u << (((unsigned char *)e - base)
+                    / equeue_slot_size(c));
+
+            unsigned map = q->slots.map[c];
+            while (!equeue_atomic_cas_uint(&q->slots.map[c],
+                    &map, map | bit)) {
+            }
+            return;
+        }
+
+        base += region;
+    }
+}
+#endif
+
+
 // equeue chunk allocation functions
 static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
     // add event overhead
     size += sizeof(struct equeue_event);
     size = (size + sizeof(void*)-1) & ~(sizeof(void*)-1);
 
+#if EQUEUE_STATIC_SLOTS > 0
+    // constant-time lock-free fast path
+    if (q->slots.data) {
+        struct equeue_event *e = equeue_slot_alloc(q, size);
+        if (e) {
+            return e;
+        }
+    }
+#endif
+
     equeue_mutex_lock(&q->memlock);
 
     // check if a good chunk is available
@@ -163,6 +286,15 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
 }
 
 static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e) {
+#if EQUEUE_STATIC_SLOTS > 0
+    // slots go back to their class's free bitmap, never the chunk list
+    if (q->slots.data && (unsigned char *)e >= q->slots.data
+            && (unsigned char *)e < q->slots.data + equeue_slots_size()) {
+        equeue_slot_dealloc(q, e);
+        return;
+    }
+#endif
+
     equeue_mutex_lock(&q->memlock);
 
     // stick chunk into list of chunks
@@ -192,6 +324,7 @@ void *equeue_alloc(equeue_t *q, size_t size) {
     e->target = 0;
     e->period = -1;
     e->dtor = 0;
+    e->lane = 0;
 
     return e + 1;
 }
@@ -255,6 +388,24 @@ static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick) {
     return id;
 }
 
+// remove a queued event from the sorted structure, queuelock held
+static void equeue_unlink(struct equeue_event *e) {
+    if (e->sibling) {
+        e->sibling->next = e->next;
+        if (e->sibling->next) {
+            e->sibling->next->ref = &e->sibling->next;
+        }
+
+        *e->ref = e->sibling;
+        e->sibling->ref = e->ref;
+    } else {
+        *e->ref = e->next;
+        if (e->next) {
+            e->next->ref = e->ref;
+        }
+    }
+}
+
 static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
     // decode event from unique id and check that the local id matches
     struct equeue_event *e = (struct equeue_event *)
@@ -266,6 +417,18 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
         return 0;
     }
 
+#if EQUEUE_MPSC_INTAKE
+    // still on the intake stack (or mid-merge), the dispatching context
+    // owns it; clearing the callback turns it into a no-op that the
+    // dispatch loop deallocates after the merge
+    if (!e->ref) {
+        e->cb = 0;
+        e->period = -1;
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+#endif
+
     // clear the event and check if already in-flight
     e->cb = 0;
     e->period = -1;
@@ -277,20 +440,7 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
     }
 
     // disentangle from queue
-    if (e->sibling) {
-        e->sibling->next = e->next;
-        if (e->sibling->next) {
-            e->sibling->next->ref = &e->sibling->next;
-        }
-
-        *e->ref = e->sibling;
-        e->sibling->ref = e->ref;
-    } else {
-        *e->ref = e->next;
-        if (e->next) {
-            e->next->ref = e->ref;
-        }
-    }
+    equeue_unlink(e);
 
     equeue_incid(q, e);
     equeue_mutex_unlock(&q->queuelock);
@@ -298,7 +448,39 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
     return e;
 }
 
+#if EQUEUE_MPSC_INTAKE
+// grab everything posted since the last pass and fold it into the sorted
+// queue, restoring original post order; taking the whole stack with a
+// single compare-and-swap makes this safe from any context
+static void equeue_merge_intake(equeue_t *q) {
+    struct equeue_event *head = q->intake;
+    while (head && !equeue_atomic_cas_ptr(
+            (void **)&q->intake, (void **)&head, 0)) {
+    }
+
+    // the intake stack is last-in first-out, reverse to post order
+    struct equeue_event *es = 0;
+    while (head) {
+        struct equeue_event *next = head->next;
+        head->next = es;
+        es = head;
+        head = next;
+    }
+
+    unsigned tick = equeue_tick();
+    while (es) {
+        struct equeue_event *e = es;
+        es = es->next;
+        equeue_enqueue(q, e, tick);
+    }
+}
+#endif
+
 static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target) {
+#if EQUEUE_MPSC_INTAKE
+    equeue_merge_intake(q);
+#endif
+
     equeue_mutex_lock(&q->queuelock);
 
     // find all expired events and mark a new generation
@@ -322,23 +504,34 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target) {
 
     equeue_mutex_unlock(&q->queuelock);
 
-    // reverse and flatten each slot to match insertion order
+    // reverse and flatten each slot, draining higher priority lanes first
+    // and matching insertion order within a lane
     struct equeue_event **tail = &head;
     struct equeue_event *ess = head;
     while (ess) {
         struct equeue_event *es = ess;
         ess = es->next;
 
-        struct equeue_event *prev = 0;
+        // siblings are newest first, prepending them to their lane
+        // restores insertion order per lane
+        struct equeue_event *lanes[EQUEUE_LANES] = {0};
         for (struct equeue_event *e = es; e; e = e->sibling) {
-            e->next = prev;
-            prev = e;
+            e->next = lanes[e->lane];
+            lanes[e->lane] = e;
         }
 
-        *tail = prev;
-        tail = &es->next;
+        for (int l = EQUEUE_LANES-1; l >= 0; l--) {
+            if (lanes[l]) {
+                *tail = lanes[l];
+                while (*tail) {
+                    tail = &(*tail)->next;
+                }
+            }
+        }
     }
 
+    *tail = 0;
+
     return head;
 }
 
@@ -348,7 +541,32 @@ int equeue_post(equeue_t *q, void (*cb)(void*), void *p) {
     e->cb = cb;
     e->target = tick + e->target;
 
+#if EQUEUE_MPSC_INTAKE
+    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
+
+    // a null ref marks the event as not yet merged for equeue_cancel
+    e->ref = 0;
+
+    // lock-free push onto the intake stack, merged by the dispatch loop
+    struct equeue_event *head = q->intake;
+    do {
+        e->next = head;
+    } while (!equeue_atomic_cas_ptr((void **)&q->intake, (void **)&head, e));
+
+    // a backgrounded queue learns of new events from the enqueue path,
+    // so poke its timer directly
+    if (q->background.update) {
+        equeue_mutex_lock(&q->queuelock);
+        if (q->background.update && q->background.active) {
+            q->background.update(q->background.timer,
+                    equeue_clampdiff(e->target, tick));
+        }
+        equeue_mutex_unlock(&q->queuelock);
+    }
+#else
     int id = equeue_enqueue(q, e, tick);
+#endif
+
     equeue_sema_signal(&q->eventsema);
     return id;
 }
@@ -364,6 +582,115 @@ void equeue_cancel(equeue_t *q, int id) {
     }
 }
 
+void equeue_post_user_allocated(equeue_t *q, void (*cb)(void*), void *p) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    unsigned tick = equeue_tick();
+
+    // a zero local id marks the event as user-allocated, keeping its
+    // storage out of the allocator's hands after dispatch
+    e->id = 0;
+    e->cb = cb;
+    e->target = tick + e->target;
+
+#if EQUEUE_MPSC_INTAKE
+    // a null ref marks the event as not yet merged for cancellation
+    e->ref = 0;
+
+    // lock-free push onto the intake stack, merged by the dispatch loop
+    struct equeue_event *head = q->intake;
+    do {
+        e->next = head;
+    } while (!equeue_atomic_cas_ptr((void **)&q->intake, (void **)&head, e));
+
+    // a backgrounded queue learns of new events from the enqueue path,
+    // so poke its timer directly
+    if (q->background.update) {
+        equeue_mutex_lock(&q->queuelock);
+        if (q->background.update && q->background.active) {
+            q->background.update(q->background.timer,
+                    equeue_clampdiff(e->target, tick));
+        }
+        equeue_mutex_unlock(&q->queuelock);
+    }
+#else
+    equeue_enqueue(q, e, tick);
+#endif
+
+    equeue_sema_signal(&q->eventsema);
+}
+
+void equeue_forward(equeue_t *target, void (*cb)(void*), void *p, int lane) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+
+    // inherit the event's lane as a floor so a high-priority event does
+    // not lose its place when it crosses queues
+    if (lane < e->lane) {
+        lane = e->lane;
+    }
+    if (lane > EQUEUE_LANES-1) {
+        lane = EQUEUE_LANES-1;
+    }
+    e->lane = lane;
+
+    // due immediately on the target, one-shot
+    e->target = 0;
+    e->period = -1;
+
+    equeue_post_user_allocated(target, cb, p);
+}
+
+void equeue_cancel_user_allocated(equeue_t *q, void *p) {
+    if (!p) {
+        return;
+    }
+
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+
+    equeue_mutex_lock(&q->queuelock);
+#if EQUEUE_MPSC_INTAKE
+    // still on the intake stack (or mid-merge), the dispatching context
+    // owns it; clearing the callback turns it into a no-op that falls
+    // back to its owner after the merge
+    if (!e->ref) {
+        e->cb = 0;
+        e->period = -1;
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+#endif
+
+    // clear the event and check if already in-flight
+    e->cb = 0;
+    e->period = -1;
+
+    int diff = equeue_tickdiff(e->target, q->tick);
+    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+
+    // disentangle from queue, the storage stays with its owner
+    equeue_unlink(e);
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+int equeue_timeleft_user_allocated(equeue_t *q, void *p) {
+    int ret = -1;
+
+    if (!p) {
+        return -1;
+    }
+
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+
+    equeue_mutex_lock(&q->queuelock);
+    if (e->cb) {
+        ret = equeue_clampdiff(e->target, equeue_tick());
+    }
+    equeue_mutex_unlock(&q->queuelock);
+    return ret;
+}
+
 int equeue_timeleft(equeue_t *q, int id) {
     int ret = -1;
 
@@ -414,6 +741,8 @@ void equeue_dispatch(equeue_t *q, int ms) {
             if (e->period >= 0) {
                 e->target += e->period;
                 equeue_enqueue(q, e, equeue_tick());
+            } else if (e->id == 0) {
+                // user-allocated storage goes back to its owner untouched
             } else {
                 equeue_incid(q, e);
                 equeue_dealloc(q, e+1);
@@ -452,8 +781,10 @@ void equeue_dispatch(equeue_t *q, int ms) {
         }
         equeue_mutex_unlock(&q->queuelock);
 
-        // wait for events
-        equeue_sema_wait(&q->eventsema, deadline);
+        // wait for events, the semaphore sleeps in milliseconds so with a
+        // sub-millisecond tick the remainder is spent polling the tick
+        equeue_sema_wait(&q->eventsema,
+                deadline < 0 ? deadline : deadline / EQUEUE_TICKS_PER_MSEC);
 
         // check if we were notified to break out of dispatch
         if (q->break_requested) {
@@ -488,6 +819,16 @@ void equeue_event_dtor(void *p, void (*dtor)(void *)) {
     e->dtor = dtor;
 }
 
+void equeue_event_lane(void *p, int lane) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    if (lane < 0) {
+        lane = 0;
+    } else if (lane > EQUEUE_LANES-1) {
+        lane = EQUEUE_LANES-1;
+    }
+    e->lane = lane;
+}
+
 
 // simple callbacks
 struct ecallback {
@@ -540,6 +881,11 @@ int equeue_call_every(equeue_t *q, int ms, void (*cb)(void*), void *data) {
 // backgrounding
 void equeue_background(equeue_t *q,
         void (*update)(void *timer, int ms), void *timer) {
+#if EQUEUE_MPSC_INTAKE
+    // fold in pending posts so the timer sees the earliest deadline
+    equeue_merge_intake(q);
+#endif
+
     equeue_mutex_lock(&q->queuelock);
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -36,11 +36,58 @@ extern "C" {
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// Number of fixed-size event slots reserved per size class for lock-free
+// constant-time allocation
+//
+// When non-zero, equeue_create carves EQUEUE_STATIC_SLOTS slots of each
+// size class out of the front of the queue buffer. Allocations that fit a
+// slot claim one with a single atomic compare-and-swap instead of walking
+// the chunk list under the memory lock, making equeue_alloc deterministic
+// from interrupt contexts. Allocations that miss (all slots taken or too
+// large) fall back to the chunk allocator.
+//
+// Must be at most the number of bits in an unsigned as each class tracks
+// its free slots in a single bitmap word.
+#ifndef EQUEUE_STATIC_SLOTS
+#ifdef MBED_CONF_EVENTS_STATIC_ALLOC_SLOTS
+#define EQUEUE_STATIC_SLOTS MBED_CONF_EVENTS_STATIC_ALLOC_SLOTS
+#else
+#define EQUEUE_STATIC_SLOTS 0
+#endif
+#endif
+
+// Number of slot size classes, sized EQUEUE_EVENT_SIZE << class
+#define EQUEUE_SLOT_CLASSES 3
+
+// Lock-free multi-producer intake for equeue_post
+//
+// When enabled, equeue_post pushes events onto a lock-free intake stack
+// with a single atomic compare-and-swap instead of performing the sorted
+// insertion under the queue lock. The dispatch loop merges the intake
+// into the sorted queue before each pass. This lets several interrupt
+// handlers and threads post to a shared queue without serializing on the
+// queue lock.
+#ifndef EQUEUE_MPSC_INTAKE
+#ifdef MBED_CONF_EVENTS_MPSC_INTAKE
+#define EQUEUE_MPSC_INTAKE MBED_CONF_EVENTS_MPSC_INTAKE
+#else
+#define EQUEUE_MPSC_INTAKE 0
+#endif
+#endif
+
+// Number of priority lanes for events sharing a timestamp
+//
+// At each timestamp, dispatch drains events in higher lanes before events
+// in lower lanes. Events in the same lane keep their post order. All
+// events default to lane 0, see equeue_event_lane.
+#define EQUEUE_LANES 4
+
 // Internal event structure
 struct equeue_event {
     unsigned size;
     uint8_t id;
     uint8_t generation;
+    uint8_t lane;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
@@ -71,6 +118,17 @@ typedef struct equeue {
         unsigned char *data;
     } slab;
 
+#if EQUEUE_STATIC_SLOTS > 0
+    struct equeue_slots {
+        unsigned char *data;
+        unsigned map[EQUEUE_SLOT_CLASSES];
+    } slots;
+#endif
+
+#if EQUEUE_MPSC_INTAKE
+    struct equeue_event *intake;
+#endif
+
     struct equeue_background {
         bool active;
         void (*update)(void *timer, int ms);
@@ -101,6 +159,11 @@ void equeue_destroy(equeue_t *queue);
 // negative, equeue_dispatch will dispatch events indefinitely or until
 // equeue_break is called on this queue.
 //
+// Note that all equeue time parameters are expressed in platform ticks,
+// which are milliseconds by default but become microseconds when a
+// microsecond tick source is selected in equeue_platform.h
+// (see EQUEUE_TICK_US).
+//
 // When called with a finite timeout, the equeue_dispatch function is
 // guaranteed to terminate. When called with a timeout of 0, the
 // equeue_dispatch does not wait and is irq safe.
@@ -156,9 +219,12 @@ void equeue_dealloc(equeue_t *queue, void *event);
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_lane   - Priority lane, 0 (default) to EQUEUE_LANES-1, higher
+//                       lanes dispatch first among events due at the same time
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_lane(void *event, int lane);
 
 // Post an event onto the event queue
 //
@@ -174,6 +240,63 @@ void equeue_event_dtor(void *event, void (*dtor)(void *));
 // be passed to equeue_cancel.
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post an event with user-allocated storage onto the event queue
+//
+// The equeue_post_user_allocated function takes a callback and a pointer to
+// storage owned by the caller, laid out as a struct equeue_event header
+// immediately followed by the callback's data. The storage is linked into
+// the queue intrusively: posting and cancelling never touch the queue's
+// allocator, so a post cannot fail for lack of memory and stays
+// deterministic no matter how contended the queue's memory pool is.
+//
+// The header must be zeroed before first use and the event configured with
+// the equeue_event functions, passing a pointer to the data region. Note
+// that a zeroed period reposts the event immediately, so one-shot events
+// must set a period of -1. Once the callback has run, or the event has been
+// cancelled, the storage belongs to the caller again and may be reposted.
+//
+// The equeue_post_user_allocated function is irq safe.
+void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *), void *event);
+
+// Forward an event to another queue
+//
+// The equeue_forward function hands an event's user-allocated storage over
+// to another queue, typically from within the event's own callback with the
+// data pointer the callback received. The storage is reposted onto the
+// target queue with the given callback and no delay, waking the target's
+// dispatcher once. Any previously configured delay and period are not
+// carried over; the forwarded event is due immediately and one-shot.
+//
+// The event's priority lane is inherited as a floor: on the target queue
+// the event keeps the higher of its current lane and the lane argument, so
+// a high-priority event does not lose its place when it crosses queues.
+// Pass a lane of 0 for plain inheritance.
+//
+// Only user-allocated storage may be forwarded, as a queue-allocated
+// event's storage must return to its owning queue's allocator.
+//
+// The equeue_forward function is irq safe.
+void equeue_forward(equeue_t *target, void (*cb)(void *), void *event, int lane);
+
+// Cancel an in-flight user-allocated event
+//
+// Attempts to cancel an event posted with equeue_post_user_allocated,
+// identified by its storage rather than by id. Must only be called on
+// storage that has been posted. The same in-flight caveats as
+// equeue_cancel apply.
+//
+// The equeue_cancel_user_allocated function is irq safe.
+void equeue_cancel_user_allocated(equeue_t *queue, void *event);
+
+// Query how much time is left for a delayed user-allocated event
+//
+// If the event is delayed, this function can be used to query how much time
+// is left until the event is due to be dispatched.
+//
+// This function is irq safe.
+//
+int equeue_timeleft_user_allocated(equeue_t *queue, void *event);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -23,15 +23,6 @@
 #include <stdbool.h>
 #include "mbed.h"
 
-// Ticker operations
-#if MBED_CONF_RTOS_PRESENT
-
-unsigned equeue_tick() {
-    return osKernelGetTickCount();
-}
-
-#else
-
 #if MBED_CONF_EVENTS_USE_LOWPOWER_TIMER_TICKER
 #define ALIAS_TIMER      LowPowerTimer
 #define ALIAS_TICKER     LowPowerTicker
@@ -42,6 +33,27 @@ unsigned equeue_tick() {
 #define ALIAS_TIMEOUT    Timeout
 #endif
 
+// Ticker operations
+#if defined(EQUEUE_TICK_US)
+
+#include "hal/us_ticker_api.h"
+
+unsigned equeue_tick() {
+    return (unsigned)equeue_tick_us();
+}
+
+uint64_t equeue_tick_us() {
+    return ticker_read_us(get_us_ticker_data());
+}
+
+#elif MBED_CONF_RTOS_PRESENT
+
+unsigned equeue_tick() {
+    return osKernelGetTickCount();
+}
+
+#else
+
 static bool equeue_tick_inited = false;
 static volatile unsigned equeue_minutes = 0;
 static unsigned equeue_timer[
@@ -173,4 +185,17 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms) {
 
 #endif
 
+
+// Atomic operations
+bool equeue_atomic_cas_uint(unsigned *p, unsigned *expected, unsigned desired) {
+    return core_util_atomic_cas_u32(
+            reinterpret_cast<uint32_t*>(p),
+            reinterpret_cast<uint32_t*>(expected),
+            desired);
+}
+
+bool equeue_atomic_cas_ptr(void **p, void **expected, void *desired) {
+    return core_util_atomic_cas_ptr(p, expected, desired);
+}
+
 #endif
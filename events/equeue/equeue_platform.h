@@ -55,16 +55,40 @@ extern "C" {
 #endif
 
 
-// Platform millisecond counter
+// Platform tick resolution
 //
-// Return a tick that represents the number of milliseconds that have passed
-// since an arbitrary point in time. The granularity does not need to be at
-// the millisecond level, however the accuracy of the equeue library is
-// limited by the accuracy of this tick.
+// By default a tick is a millisecond. Uncomment to select a microsecond
+// tick instead: the platform then provides a 64-bit microsecond counter
+// through equeue_tick_us, equeue_tick returns the low 32 bits of it, and
+// every delay passed to the equeue library is interpreted in microseconds
+// instead of milliseconds. This allows sub-millisecond periodic events at
+// the cost of limiting a single delay to 2^31-1 microseconds.
+//#define EQUEUE_TICK_US
+
+#if defined(EQUEUE_TICK_US)
+#include <stdint.h>
+#define EQUEUE_TICKS_PER_MSEC 1000
+#else
+#define EQUEUE_TICKS_PER_MSEC 1
+#endif
+
+// Platform tick counter
+//
+// Return a tick that represents the number of milliseconds (or microseconds
+// when EQUEUE_TICK_US is selected) that have passed since an arbitrary point
+// in time. The granularity does not need to be at the tick level, however
+// the accuracy of the equeue library is limited by the accuracy of this tick.
 //
 // Must intentionally overflow to 0 after 2^32-1
 unsigned equeue_tick(void);
 
+#if defined(EQUEUE_TICK_US)
+// Platform microsecond counter backing the tick when EQUEUE_TICK_US is
+// selected. Unlike equeue_tick, the full 64-bit count is returned so that
+// callers timestamping against the queue do not have to handle overflow.
+uint64_t equeue_tick_us(void);
+#endif
+
 
 // Platform mutex type
 //
@@ -143,6 +167,23 @@ void equeue_sema_signal(equeue_sema_t *sema);
 bool equeue_sema_wait(equeue_sema_t *sema, int ms);
 
 
+// Platform atomic operations
+//
+// The equeue_atomic_cas_uint performs an atomic compare-and-swap on an
+// unsigned integer. If *p equals *expected, *p is set to desired and true
+// is returned. Otherwise *expected is updated with the current value of
+// *p and false is returned.
+//
+// Must be safe against both threads and interrupt contexts. Only required
+// when the static slot allocator is enabled (see EQUEUE_STATIC_SLOTS).
+bool equeue_atomic_cas_uint(unsigned *p, unsigned *expected, unsigned desired);
+
+// The equeue_atomic_cas_ptr performs the same atomic compare-and-swap
+// operation on a pointer. Only required when the lock-free intake is
+// enabled (see EQUEUE_MPSC_INTAKE).
+bool equeue_atomic_cas_ptr(void **p, void **expected, void *desired);
+
+
 #ifdef __cplusplus
 }
 #endif
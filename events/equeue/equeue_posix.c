@@ -25,12 +25,28 @@
 
 
 // Tick operations
+#if defined(EQUEUE_TICK_US)
+
+uint64_t equeue_tick_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return (uint64_t)tv.tv_sec*1000000 + tv.tv_usec;
+}
+
+unsigned equeue_tick(void) {
+    return (unsigned)equeue_tick_us();
+}
+
+#else
+
 unsigned equeue_tick(void) {
     struct timeval tv;
     gettimeofday(&tv, 0);
     return (unsigned)(tv.tv_sec*1000 + tv.tv_usec/1000);
 }
 
+#endif
+
 
 // Mutex operations
 int equeue_mutex_create(equeue_mutex_t *m) {
@@ -103,4 +119,28 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms) {
     return signal;
 }
 
+
+// Atomic operations
+bool equeue_atomic_cas_uint(unsigned *p, unsigned *expected, unsigned desired) {
+    unsigned old = *expected;
+    unsigned current = __sync_val_compare_and_swap(p, old, desired);
+    if (current == old) {
+        return true;
+    }
+
+    *expected = current;
+    return false;
+}
+
+bool equeue_atomic_cas_ptr(void **p, void **expected, void *desired) {
+    void *old = *expected;
+    void *current = __sync_val_compare_and_swap(p, old, desired);
+    if (current == old) {
+        return true;
+    }
+
+    *expected = current;
+    return false;
+}
+
 #endif
@@ -21,6 +21,7 @@
 #include <setjmp.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 
 
@@ -197,6 +198,39 @@ void simple_post_test(void) {
 }
 
 // Misc tests
+void user_allocated_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // exhaust the queue's pool, user-allocated storage must still post
+    while (equeue_alloc(&q, 64)) {
+    }
+
+    int touched = 0;
+    struct {
+        struct equeue_event e;
+        struct indirect data;
+    } ue;
+    memset(&ue, 0, sizeof ue);
+    void *data = &ue.e + 1;
+    equeue_event_period(data, -1);
+    ue.data.touched = &touched;
+
+    equeue_post_user_allocated(&q, indirect_func, data);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 1);
+
+    // the storage is the caller's again, repost and cancel it
+    equeue_event_delay(data, 10);
+    equeue_post_user_allocated(&q, indirect_func, data);
+    equeue_cancel_user_allocated(&q, data);
+    equeue_dispatch(&q, 15);
+    test_assert(touched == 1);
+
+    equeue_destroy(&q);
+}
+
 void destructor_test(void) {
     equeue_t q;
     int err = equeue_create(&q, 2048);
@@ -483,6 +517,42 @@ void sloth_test(void) {
     equeue_destroy(&q);
 }
 
+struct ordering {
+    int *touched;
+    int order;
+};
+
+void ordering_func(void *p) {
+    struct ordering *o = (struct ordering *)p;
+    *o->touched = (*o->touched << 4) | o->order;
+}
+
+void lane_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    for (int i = 0; i < 4; i++) {
+        struct ordering *o = equeue_alloc(&q, sizeof(struct ordering));
+        test_assert(o);
+
+        o->touched = &touched;
+        o->order = i+1;
+        equeue_event_delay(o, 10);
+        equeue_event_lane(o, i % 2);
+
+        int id = equeue_post(&q, ordering_func, o);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 15);
+    // lane 1 events (2nd and 4th posted) dispatch before lane 0 events
+    test_assert(touched == 0x2413);
+
+    equeue_destroy(&q);
+}
+
 void *multithread_thread(void *p) {
     equeue_t *q = (equeue_t *)p;
     equeue_dispatch(q, -1);
@@ -615,6 +685,65 @@ void unchain_test(void) {
     equeue_destroy(&q2);
 }
 
+struct forward {
+    equeue_t *target;
+    int *touched;
+};
+
+void forward_done_func(void *p) {
+    struct forward *f = (struct forward *)p;
+    (*f->touched)++;
+}
+
+void forward_func(void *p) {
+    struct forward *f = (struct forward *)p;
+    (*f->touched)++;
+    equeue_forward(f->target, forward_done_func, p, 1);
+}
+
+void forward_test(void) {
+    equeue_t q1;
+    int err = equeue_create(&q1, 2048);
+    test_assert(!err);
+
+    equeue_t q2;
+    err = equeue_create(&q2, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    struct {
+        struct equeue_event e;
+        struct forward data;
+    } ue;
+    memset(&ue, 0, sizeof ue);
+    void *data = &ue.e + 1;
+    equeue_event_period(data, -1);
+    ue.data.target = &q2;
+    ue.data.touched = &touched;
+
+    equeue_post_user_allocated(&q1, forward_func, data);
+    equeue_dispatch(&q1, 0);
+    test_assert(touched == 1);
+
+    // the event moved to the second queue, due immediately with the floor lane
+    equeue_dispatch(&q2, 0);
+    test_assert(touched == 2);
+    test_assert(ue.e.lane == 1);
+
+    // a higher event lane wins over the floor
+    equeue_event_delay(data, 0);
+    equeue_event_period(data, -1);
+    equeue_event_lane(data, 2);
+    equeue_post_user_allocated(&q1, forward_func, data);
+    equeue_dispatch(&q1, 0);
+    equeue_dispatch(&q2, 0);
+    test_assert(touched == 4);
+    test_assert(ue.e.lane == 2);
+
+    equeue_destroy(&q1);
+    equeue_destroy(&q2);
+}
+
 // Barrage tests
 void simple_barrage_test(int N) {
     equeue_t q;
@@ -752,6 +881,7 @@ int main() {
     test_run(simple_call_in_test);
     test_run(simple_call_every_test);
     test_run(simple_post_test);
+    test_run(user_allocated_test);
     test_run(destructor_test);
     test_run(allocation_failure_test);
     test_run(cancel_test, 20);
@@ -763,9 +893,11 @@ int main() {
     test_run(period_test);
     test_run(nested_test);
     test_run(sloth_test);
+    test_run(lane_test);
     test_run(background_test);
     test_run(chain_test);
     test_run(unchain_test);
+    test_run(forward_test);
     test_run(multithread_test);
     test_run(simple_barrage_test, 20);
     test_run(fragmenting_barrage_test, 20);
@@ -27,6 +27,7 @@
 
 #include "events/EventQueue.h"
 #include "events/Event.h"
+#include "events/EventChain.h"
 
 #include "events/mbed_shared_queues.h"
 
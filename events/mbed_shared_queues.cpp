@@ -17,31 +17,50 @@
 #include "events/mbed_shared_queues.h"
 #include "mbed.h"
 
+#include <new>
+
 using namespace events;
 
 namespace mbed {
 
 #ifdef MBED_CONF_RTOS_PRESENT
-/* Create an event queue, and start the thread that dispatches it. Static
+/* Create an event queue, and start the threads that dispatch it. Static
  * variables mean this happens once the first time each template instantiation
  * is called. This is currently instantiated no more than twice.
+ *
+ * With NumThreads greater than one, the threads form a small dispatcher
+ * pool over the single shared queue: each thread claims whatever batch of
+ * expired events the others have not taken, so a slow handler stalls only
+ * its own thread while the rest keep draining the queue. Events may then
+ * execute concurrently, so ordering between separate events is no longer
+ * guaranteed.
  */
 template
-<osPriority Priority, size_t QueueSize, size_t StackSize>
+<osPriority Priority, size_t QueueSize, size_t StackSize, size_t NumThreads>
 EventQueue *do_shared_event_queue_with_thread()
 {
+    MBED_STATIC_ASSERT(NumThreads >= 1, "A dispatching queue needs at least one thread");
+
     static uint64_t queue_buffer[QueueSize / sizeof(uint64_t)];
     static EventQueue queue(sizeof queue_buffer, (unsigned char *) queue_buffer);
 
-    static uint64_t stack[StackSize / sizeof(uint64_t)];
-    static Thread thread(Priority, StackSize, (unsigned char *) stack);
+    static uint64_t stack[NumThreads][StackSize / sizeof(uint64_t)];
+    static uint64_t thread_mem[NumThreads][
+            (sizeof(Thread) + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+    static Thread *threads[NumThreads];
+
+    for (size_t i = 0; i < NumThreads; i++) {
+        if (!threads[i]) {
+            threads[i] = new (thread_mem[i]) Thread(Priority, StackSize, (unsigned char *) stack[i]);
+        }
 
-    Thread::State state = thread.get_state();
-    if (state == Thread::Inactive || state == Thread::Deleted) {
-        osStatus status = thread.start(callback(&queue, &EventQueue::dispatch_forever));
-        MBED_ASSERT(status == osOK);
-        if (status != osOK) {
-            return NULL;
+        Thread::State state = threads[i]->get_state();
+        if (state == Thread::Inactive || state == Thread::Deleted) {
+            osStatus status = threads[i]->start(callback(&queue, &EventQueue::dispatch_forever));
+            MBED_ASSERT(status == osOK);
+            if (status != osOK) {
+                return NULL;
+            }
         }
     }
 
@@ -58,15 +77,44 @@ EventQueue *mbed_event_queue()
 
     return &queue;
 #else
-    return do_shared_event_queue_with_thread<osPriorityNormal, MBED_CONF_EVENTS_SHARED_EVENTSIZE, MBED_CONF_EVENTS_SHARED_STACKSIZE>();
+    return do_shared_event_queue_with_thread<osPriorityNormal, MBED_CONF_EVENTS_SHARED_EVENTSIZE, MBED_CONF_EVENTS_SHARED_STACKSIZE, MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS>();
 #endif
 }
 
 #ifdef MBED_CONF_RTOS_PRESENT
 EventQueue *mbed_highprio_event_queue()
 {
-    return do_shared_event_queue_with_thread<osPriorityHigh, MBED_CONF_EVENTS_SHARED_HIGHPRIO_EVENTSIZE, MBED_CONF_EVENTS_SHARED_HIGHPRIO_STACKSIZE>();
+    /* always a single thread - the high-priority queue is for short
+     * deferrals from interrupt, where ordering matters more than
+     * parallelism */
+    return do_shared_event_queue_with_thread<osPriorityHigh, MBED_CONF_EVENTS_SHARED_HIGHPRIO_EVENTSIZE, MBED_CONF_EVENTS_SHARED_HIGHPRIO_STACKSIZE, 1>();
+}
+#endif
+
+#if defined(MBED_INIT_REGISTRY_ENABLED)
+#include "platform/mbed_init_registry.h"
+/* Register the shared queues as deferrable units, so staging builds can
+ * pull queue and dispatch thread construction forward to a quiet moment
+ * instead of paying it inside the first deferred call */
+static void init_shared_queue()
+{
+    mbed_event_queue();
+}
+#ifdef MBED_CONF_RTOS_PRESENT
+static void init_highprio_queue()
+{
+    mbed_highprio_event_queue();
 }
 #endif
+static struct SharedQueueInitRegistrar {
+    SharedQueueInitRegistrar()
+    {
+        mbed_init_registry_defer("shared-queue", init_shared_queue);
+#ifdef MBED_CONF_RTOS_PRESENT
+        mbed_init_registry_defer("highprio-queue", init_highprio_queue);
+#endif
+    }
+} shared_queue_init_registrar;
+#endif
 
 }
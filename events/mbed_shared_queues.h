@@ -38,6 +38,12 @@ namespace mbed {
  * such, users can expect that event latency will typically be 10ms or less,
  * but could occasionally be significantly higher if many events are queued.
  *
+ * Setting the configuration option `events.shared-dispatch-threads` above 1
+ * creates a pool of dispatch threads draining the same queue, so one slow
+ * handler no longer stalls the events behind it. Events may then execute
+ * concurrently - do not rely on ordering between separate events when the
+ * pool is enabled.
+ *
  * If an RTOS is not present or the configuration option
  * `events.shared-dispatch-from-application` is set to true, then this
  * does not create a dedicated dispatch thread - instead the application is
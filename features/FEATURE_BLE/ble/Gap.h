@@ -976,6 +976,87 @@ public:
         ResolutionStrategy resolution_strategy;
     };
 
+    /**
+     * Filter applied by the stack to advertising reports before they are
+     * delivered to the application.
+     *
+     * All enabled criteria must match for a report to be delivered; a
+     * criterion left at its zero value is not applied.
+     */
+    struct ScanFilter_t {
+        /**
+         * Maximum number of entries in the peer address allowlist.
+         */
+        static const uint8_t MAX_FILTER_ADDRESSES = 8;
+
+        /**
+         * Peer addresses whose reports are delivered; only the address bytes
+         * are compared. NULL or a zero count accepts reports from any peer.
+         */
+        const BLEProtocol::Address_t *addresses;
+
+        /**
+         * Number of entries in @p addresses.
+         */
+        uint8_t address_count;
+
+        /**
+         * AD type the advertising payload must contain; 0 accepts any
+         * payload.
+         */
+        uint8_t required_ad_type;
+
+        /**
+         * 16-bit service UUID which must appear in a complete or incomplete
+         * list of 16-bit service UUIDs in the payload; 0 accepts any payload.
+         */
+        uint16_t required_service_uuid;
+
+        /**
+         * Minimum RSSI change, in dB, for a report repeating a peer's
+         * previous payload to be delivered again; 0 delivers every report.
+         */
+        uint8_t rssi_delta;
+    };
+
+    /**
+     * Policy driving automatic negotiation of connection parameters from the
+     * traffic profile of a connection.
+     *
+     * The stack counts the GATT operations reported on each connection over
+     * an evaluation period. A busy connection is moved to @p fastParams, and
+     * once it stays quiet for @p idlePeriods consecutive periods, it is moved
+     * to @p slowParams.
+     */
+    struct ConnectionParamsPolicy_t {
+        /**
+         * Parameters requested while the connection carries bulk traffic.
+         */
+        ConnectionParams_t fastParams;
+
+        /**
+         * Parameters requested once the connection has gone idle.
+         */
+        ConnectionParams_t slowParams;
+
+        /**
+         * Number of GATT operations within one evaluation period at which
+         * the connection is considered busy.
+         */
+        uint16_t busyThreshold;
+
+        /**
+         * Consecutive evaluation periods without traffic before the
+         * connection is considered idle.
+         */
+        uint16_t idlePeriods;
+
+        /**
+         * Length of the evaluation period in milliseconds.
+         */
+        uint16_t evaluationPeriod;
+    };
+
     /**
      * Number of microseconds in 1.25 milliseconds.
      */
@@ -2385,6 +2466,59 @@ public:
         return BLE_ERROR_NOT_IMPLEMENTED;
     }
 
+    /**
+     * Set the filter applied to advertising reports during scanning.
+     *
+     * Reports rejected by the filter are dropped inside the stack, before
+     * the event processing and application callback chain run.
+     *
+     * @param[in] filter The filter to apply; NULL removes any installed
+     * filter and delivers every report again.
+     *
+     * @return BLE_ERROR_NONE in case of success or an appropriate error code.
+     */
+    virtual ble_error_t setScanFilter(const ScanFilter_t *filter) {
+        (void)filter;
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Set the policy used to negotiate connection parameters automatically.
+     *
+     * Once a policy is installed, the stack requests @p fastParams for
+     * connections that carry bulk GATT traffic and falls back to
+     * @p slowParams when they go idle, removing the need for the application
+     * to juggle intervals by hand.
+     *
+     * @note The policy applies to connections established after it is set.
+     *
+     * @param[in] policy The policy to apply; NULL removes any installed
+     * policy and leaves the parameters of existing connections unchanged.
+     *
+     * @return BLE_ERROR_NONE in case of success or an appropriate error code.
+     */
+    virtual ble_error_t setConnectionParamsPolicy(
+        const ConnectionParamsPolicy_t *policy
+    ) {
+        (void)policy;
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Report one GATT operation on a connection to the connection parameter
+     * policy engine.
+     *
+     * The GATT client reports its own operations; stacks or applications
+     * driving server-initiated traffic may call this function to make that
+     * traffic visible to the policy.
+     *
+     * @param[in] connectionHandle Handle of the connection carrying the
+     * operation.
+     */
+    virtual void reportConnectionTraffic(Handle_t connectionHandle) {
+        (void)connectionHandle;
+    }
+
 private:
     /**
      * Set the advertising data and scan response in the vendor subsytem.
@@ -540,6 +540,27 @@ public:
         _appearance(GENERIC_TAG) {
     }
 
+    /**
+     * Construct a GapAdvertising instance from a formatted payload.
+     *
+     * The payload bytes are copied as is; no check of the formatting is
+     * performed. This constructor is meant for payloads assembled externally,
+     * such as the frames produced by ble::StaticAdvertisingData.
+     *
+     * @param[in] payload Pointer to the formatted advertising payload.
+     * @param[in] payloadLen Length of the payload in bytes; clipped to
+     * GAP_ADVERTISING_DATA_MAX_PAYLOAD.
+     */
+    GapAdvertisingData(const uint8_t *payload, uint8_t payloadLen) :
+        _payload(),
+        _payloadLen(payloadLen),
+        _appearance(GENERIC_TAG) {
+        if (_payloadLen > GAP_ADVERTISING_DATA_MAX_PAYLOAD) {
+            _payloadLen = GAP_ADVERTISING_DATA_MAX_PAYLOAD;
+        }
+        memcpy(_payload, payload, _payloadLen);
+    }
+
     /**
      * Adds a new field into the payload.
      *
@@ -19,6 +19,8 @@
 
 #include "UUID.h"
 #include "BLETypes.h"
+#include "ArrayView.h"
+#include "FunctionPointerWithContext.h"
 
 /**
  * @addtogroup ble
@@ -71,6 +73,16 @@ public:
      */
     static const Handle_t INVALID_HANDLE = 0x0000;
 
+    /**
+     * Callback invoked when the stack updates a borrowed attribute value in
+     * place.
+     *
+     * The updated attribute is passed to the callback; its current length
+     * reflects the length of the value written by the peer.
+     */
+    typedef FunctionPointerWithContext<const GattAttribute *>
+        ValueUpdateCallback_t;
+
 public:
 
     typedef ble::att_security_requirement_t Security_t;
@@ -124,7 +136,9 @@ public:
         _read_allowed(true),
         _read_security(Security_t::NONE),
         _write_allowed(true),
-        _write_security(Security_t::NONE) {
+        _write_security(Security_t::NONE),
+        _value_borrowed(false),
+        _value_update_cb() {
     }
 
 public:
@@ -219,6 +233,87 @@ public:
         return _hasVariableLen;
     }
 
+    /**
+     * Lend an application-owned buffer to the stack as the attribute value.
+     *
+     * The stack serves reads directly from the buffer and commits writes from
+     * the client into it in place, instead of copying the value in and out of
+     * stack-owned storage. The buffer must remain valid for the lifetime of
+     * the attribute, and the application must not modify it while a GATT
+     * procedure is in progress.
+     *
+     * Use onValueUpdated() to be notified after the stack has written the
+     * value in place.
+     *
+     * @param[in] value Buffer holding the attribute value; its size sets the
+     * maximum length of the value.
+     * @param[in] len Length in bytes of the current value.
+     * @param[in] hasVariableLen Flag that indicates whether the value length
+     * can change throughout time.
+     */
+    void lendValue(
+        const ble::ArrayView<uint8_t> &value,
+        uint16_t len,
+        bool hasVariableLen = true
+    ) {
+        _valuePtr = value.data();
+        _lenMax = value.size();
+        _len = len;
+        _hasVariableLen = hasVariableLen;
+        _value_borrowed = true;
+    }
+
+    /**
+     * Indicate whether the attribute value lives in an application-owned
+     * buffer registered with lendValue().
+     *
+     * Ports use this function to bypass their value storage and operate on
+     * the application buffer directly.
+     *
+     * @return true if the value is borrowed from the application.
+     */
+    bool isValueBorrowed(void) const
+    {
+        return _value_borrowed;
+    }
+
+    /**
+     * Get a view of the buffer backing the attribute value.
+     *
+     * The view covers the whole buffer; getLength() returns the length of
+     * the current value within it.
+     *
+     * @return A view of the attribute value buffer.
+     */
+    ble::ArrayView<uint8_t> getValueView(void)
+    {
+        return ble::ArrayView<uint8_t>(_valuePtr, _lenMax);
+    }
+
+    /**
+     * Register a callback invoked after the stack has updated a borrowed
+     * value in place.
+     *
+     * @param[in] callback Callback invoked with the updated attribute.
+     */
+    void onValueUpdated(const ValueUpdateCallback_t &callback)
+    {
+        _value_update_cb = callback;
+    }
+
+    /**
+     * Notify the application that the value has been updated in place.
+     *
+     * @attention Ports call this function after committing a client write to
+     * a borrowed value. Application code must not use it.
+     */
+    void notifyValueUpdated(void)
+    {
+        if (_value_update_cb) {
+            _value_update_cb.call(this);
+        }
+    }
+
     /**
      * Allow or disallow read operation from a client.
      * @param allow_read Read is allowed if true.
@@ -342,6 +437,16 @@ private:
      */
     uint8_t _write_security: Security_t::size;
 
+    /**
+     * Whether the value lives in an application buffer lent to the stack.
+     */
+    uint8_t _value_borrowed:1;
+
+    /**
+     * Callback invoked when a borrowed value is updated in place.
+     */
+    ValueUpdateCallback_t _value_update_cb;
+
 private:
     /* Disallow copy and assignment. */
     GattAttribute(const GattAttribute &);
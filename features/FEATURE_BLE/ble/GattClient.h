@@ -143,6 +143,94 @@ public:
     typedef CallChainOfFunctionPointersWithContext<const GattWriteCallbackParams*>
         WriteCallbackChain_t;
 
+    /**
+     * Type of an attribute operation executed as part of a batch.
+     *
+     * @see executeBatch().
+     */
+    enum BatchOpType_t {
+        /**
+         * Read of the attribute value; the value read is forwarded to the
+         * handlers registered by onDataRead().
+         */
+        BATCH_OP_READ = 0x00,
+
+        /**
+         * Acknowledged write of the attribute value; the status of the
+         * operation is forwarded to the handlers registered by
+         * onDataWritten().
+         */
+        BATCH_OP_WRITE = 0x01,
+
+        /**
+         * Unacknowledged write of the attribute value.
+         *
+         * The peer does not respond to write commands; consecutive write
+         * commands of a batch are issued back to back without waiting for a
+         * round trip, which lets the stack pack several of them into the
+         * same connection event.
+         */
+        BATCH_OP_WRITE_CMD = 0x02
+    };
+
+    /**
+     * One attribute operation of a batch.
+     *
+     * @see executeBatch().
+     */
+    struct BatchOp_t {
+        /**
+         * Type of the operation.
+         */
+        BatchOpType_t type;
+
+        /**
+         * Handle of the attribute the operation applies to.
+         */
+        GattAttribute::Handle_t attributeHandle;
+
+        /**
+         * Data to write; NULL for read operations.
+         */
+        const uint8_t *value;
+
+        /**
+         * Length in bytes of the data to write; 0 for read operations.
+         */
+        uint16_t length;
+    };
+
+    /**
+     * Batch completion event.
+     *
+     * @see executeBatch().
+     */
+    struct GattBatchCallbackParams {
+        /**
+         * Handle of the connection the batch was executed on.
+         */
+        Gap::Handle_t connHandle;
+
+        /**
+         * Number of operations of the batch that completed.
+         */
+        uint8_t opsCompleted;
+
+        /**
+         * BLE_ERROR_NONE if all the operations of the batch completed;
+         * otherwise, the error that ended the batch.
+         */
+        ble_error_t status;
+    };
+
+    /**
+     * Batch completion event handler.
+     *
+     * @see executeBatch().
+     */
+    typedef FunctionPointerWithContext<const GattBatchCallbackParams*>
+        BatchCallback_t;
+
     /**
      * Handle value notification/indication event handler.
      *
@@ -467,6 +555,77 @@ public:
         return BLE_ERROR_NOT_IMPLEMENTED;
     }
 
+    /*
+     * APIs with nonvirtual implementations.
+     */
+public:
+    /**
+     * Execute a sequence of attribute operations as a pipelined batch.
+     *
+     * Issuing attribute operations one at a time from application code costs
+     * a full connection interval per operation: the response arrives in one
+     * connection event, and the next request waits for the application before
+     * leaving in a later one. This function chains the operations inside the
+     * stack instead - each response immediately triggers the next request,
+     * and consecutive write commands are issued back to back without waiting
+     * for any round trip - so a batch of operations completes in a few
+     * connection events instead of one interval per operation.
+     *
+     * The value of each read and the status of each acknowledged write are
+     * forwarded to the handlers registered by onDataRead() and
+     * onDataWritten() as usual; @p callback is invoked once, when the whole
+     * batch has completed or an operation has failed.
+     *
+     * @param[in] connHandle Handle of the connection used to execute the
+     * batch.
+     * @param[in] ops Array of the operations to execute, in order. The array
+     * and the data buffers it points to must remain valid until @p callback
+     * is invoked.
+     * @param[in] numOps Number of operations present in @p ops.
+     * @param[in] callback Event handler invoked upon completion or failure of
+     * the batch.
+     *
+     * @return BLE_ERROR_NONE if the batch execution has been launched
+     * successfully.
+     * @return BLE_ERROR_INVALID_STATE if a batch is already being executed.
+     * @return BLE_ERROR_INVALID_PARAM if @p ops is NULL or @p numOps is 0.
+     */
+    ble_error_t executeBatch(
+        Gap::Handle_t connHandle,
+        const BatchOp_t *ops,
+        uint8_t numOps,
+        const BatchCallback_t &callback
+    ) {
+        if (batchOps != NULL) {
+            return BLE_ERROR_INVALID_STATE;
+        }
+        if ((ops == NULL) || (numOps == 0)) {
+            return BLE_ERROR_INVALID_PARAM;
+        }
+
+        batchOps = ops;
+        batchNumOps = numOps;
+        batchIndex = 0;
+        batchConnHandle = connHandle;
+        batchCallback = callback;
+
+        ble_error_t err = issueBatchOps();
+        if (err != BLE_ERROR_NONE) {
+            batchOps = NULL;
+        }
+        return err;
+    }
+
+    /**
+     * Query the status of the batch execution procedure.
+     *
+     * @return true if a batch is being executed and false otherwise.
+     */
+    bool isBatchActive(void) const
+    {
+        return (batchOps != NULL);
+    }
+
     /* Event callback handlers. */
 public:
 
@@ -738,11 +897,20 @@ public:
         onDataWriteCallbackChain.clear();
         onHVXCallbackChain.clear();
 
+        /* Discard any batch being executed. */
+        batchOps = NULL;
+        batchCallback = BatchCallback_t();
+
         return BLE_ERROR_NONE;
     }
 
 protected:
-    GattClient()
+    GattClient() :
+        batchOps(NULL),
+        batchNumOps(0),
+        batchIndex(0),
+        batchConnHandle(0),
+        batchCallback()
     {
         /* Empty */
     }
@@ -760,6 +928,7 @@ public:
     void processReadResponse(const GattReadCallbackParams *params)
     {
         onDataReadCallbackChain(params);
+        advanceBatch(params->connHandle, params->handle, params->status);
     }
 
     /**
@@ -774,6 +943,7 @@ public:
     void processWriteResponse(const GattWriteCallbackParams *params)
     {
         onDataWriteCallbackChain(params);
+        advanceBatch(params->connHandle, params->handle, params->status);
     }
 
     /**
@@ -818,6 +988,142 @@ protected:
      */
     GattClientShutdownCallbackChain_t shutdownCallChain;
 
+private:
+    /**
+     * Issue the operations of the batch being executed, starting at
+     * batchIndex.
+     *
+     * Write commands are issued back to back; the function stops at the
+     * first operation awaiting a response, which is then advanced past by
+     * advanceBatch() when the response arrives.
+     *
+     * @return BLE_ERROR_NONE if the operations were successfully issued.
+     */
+    ble_error_t issueBatchOps(void)
+    {
+        while (batchIndex < batchNumOps) {
+            const BatchOp_t &op = batchOps[batchIndex];
+            ble_error_t err;
+
+            switch (op.type) {
+                case BATCH_OP_READ:
+                    err = read(batchConnHandle, op.attributeHandle, 0);
+                    break;
+                case BATCH_OP_WRITE:
+                    err = write(
+                        GATT_OP_WRITE_REQ,
+                        batchConnHandle,
+                        op.attributeHandle,
+                        op.length,
+                        op.value
+                    );
+                    break;
+                case BATCH_OP_WRITE_CMD:
+                default:
+                    err = write(
+                        GATT_OP_WRITE_CMD,
+                        batchConnHandle,
+                        op.attributeHandle,
+                        op.length,
+                        op.value
+                    );
+                    break;
+            }
+
+            if (err != BLE_ERROR_NONE) {
+                return err;
+            }
+
+            if (op.type != BATCH_OP_WRITE_CMD) {
+                /* Response pending; advanceBatch() resumes the batch. */
+                return BLE_ERROR_NONE;
+            }
+
+            ++batchIndex;
+        }
+
+        finishBatch(BLE_ERROR_NONE);
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Resume the batch being executed when the response of its pending
+     * operation arrives.
+     *
+     * @param[in] connHandle Handle of the connection that triggered the
+     * event.
+     * @param[in] attributeHandle Handle of the attribute the event applies
+     * to.
+     * @param[in] status Status of the operation.
+     */
+    void advanceBatch(
+        Gap::Handle_t connHandle,
+        GattAttribute::Handle_t attributeHandle,
+        ble_error_t status
+    ) {
+        if ((batchOps == NULL) ||
+            (connHandle != batchConnHandle) ||
+            (batchIndex >= batchNumOps) ||
+            (attributeHandle != batchOps[batchIndex].attributeHandle) ||
+            (batchOps[batchIndex].type == BATCH_OP_WRITE_CMD)) {
+            return;
+        }
+
+        if (status != BLE_ERROR_NONE) {
+            finishBatch(status);
+            return;
+        }
+
+        ++batchIndex;
+        ble_error_t err = issueBatchOps();
+        if (err != BLE_ERROR_NONE) {
+            finishBatch(err);
+        }
+    }
+
+    /**
+     * End the batch being executed and invoke its completion handler.
+     *
+     * @param[in] status Status reported to the completion handler.
+     */
+    void finishBatch(ble_error_t status)
+    {
+        GattBatchCallbackParams params;
+        params.connHandle = batchConnHandle;
+        params.opsCompleted = batchIndex;
+        params.status = status;
+
+        batchOps = NULL;
+        batchCallback.call(&params);
+    }
+
+private:
+    /**
+     * Operations of the batch being executed or NULL if no batch is being
+     * executed.
+     */
+    const BatchOp_t *batchOps;
+
+    /**
+     * Number of operations present in batchOps.
+     */
+    uint8_t batchNumOps;
+
+    /**
+     * Index of the operation of the batch being executed.
+     */
+    uint8_t batchIndex;
+
+    /**
+     * Handle of the connection the batch is executed on.
+     */
+    Gap::Handle_t batchConnHandle;
+
+    /**
+     * The completion handler of the batch being executed.
+     */
+    BatchCallback_t batchCallback;
+
 private:
     /* Disallow copy and assignment. */
     GattClient(const GattClient &);
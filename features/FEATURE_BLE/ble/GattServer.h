@@ -17,6 +17,8 @@
 #ifndef MBED_GATT_SERVER_H__
 #define MBED_GATT_SERVER_H__
 
+#include <string.h>
+
 #include "Gap.h"
 #include "GattService.h"
 #include "GattAttribute.h"
@@ -24,6 +26,22 @@
 #include "GattCallbackParamTypes.h"
 #include "CallChainOfFunctionPointersWithContext.h"
 
+/**
+ * Number of characteristic value updates that writeQueued() can hold pending
+ * before the queue is flushed automatically.
+ */
+#ifndef BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH
+#define BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH 8
+#endif
+
+/**
+ * Largest characteristic value (in bytes) that writeQueued() can hold pending;
+ * larger values are written through immediately.
+ */
+#ifndef BLE_GATT_SERVER_UPDATE_QUEUE_DATA_SIZE
+#define BLE_GATT_SERVER_UPDATE_QUEUE_DATA_SIZE 20
+#endif
+
 /**
  * @addtogroup ble
  * @{
@@ -166,6 +184,8 @@ protected:
     GattServer() :
         serviceCount(0),
         characteristicCount(0),
+        updateQueueCount(0),
+        updateQueueThreshold(BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH),
         dataSentCallChain(),
         dataWrittenCallChain(),
         dataReadCallChain(),
@@ -425,6 +445,154 @@ public:
      * APIs with nonvirtual implementations.
      */
 public:
+    /**
+     * Queue an update of an attribute value instead of sending it immediately.
+     *
+     * Each call to write() that generates a notification wakes the radio for
+     * a dedicated connection event. When an application updates a
+     * characteristic at a high rate, queuing the updates and emitting them
+     * back to back lets the link layer pack several notifications into the
+     * same connection event, which reduces the radio time spent per
+     * notification.
+     *
+     * Queued updates are written - in the order they were queued - when the
+     * number of pending updates reaches the threshold set by
+     * setUpdateQueueThreshold(), when the queue is full, when the underlying
+     * stack signals the start of a connection event or when the application
+     * calls flushUpdates().
+     *
+     * @param[in] connectionHandle Connection handle.
+     * @param[in] attributeHandle Handle for the value attribute of the
+     * characteristic.
+     * @param[in] value A pointer to a buffer holding the new value; the value
+     * is copied into the queue, the buffer may be reused upon return.
+     * @param[in] size Size of the new value (in bytes). Values larger than
+     * BLE_GATT_SERVER_UPDATE_QUEUE_DATA_SIZE bytes are not queued; they are
+     * written through immediately.
+     *
+     * @return BLE_ERROR_NONE if the update has been queued or successfully
+     * written.
+     */
+    ble_error_t writeQueued(
+        Gap::Handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const uint8_t *value,
+        uint16_t size
+    ) {
+        if (size > BLE_GATT_SERVER_UPDATE_QUEUE_DATA_SIZE) {
+            return write(connectionHandle, attributeHandle, value, size);
+        }
+
+        if (updateQueueCount == BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH) {
+            ble_error_t err = flushUpdates();
+            if (err != BLE_ERROR_NONE) {
+                return err;
+            }
+        }
+
+        QueuedUpdate_t &update = updateQueue[updateQueueCount];
+        update.connectionHandle = connectionHandle;
+        update.attributeHandle = attributeHandle;
+        update.size = size;
+        memcpy(update.value, value, size);
+        ++updateQueueCount;
+
+        if (updateQueueCount >= updateQueueThreshold) {
+            return flushUpdates();
+        }
+
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Write all the updates queued by writeQueued().
+     *
+     * @return BLE_ERROR_NONE if all pending updates have been written; the
+     * first error reported by write() otherwise. The queue is emptied in
+     * either case.
+     */
+    ble_error_t flushUpdates()
+    {
+        ble_error_t err = BLE_ERROR_NONE;
+
+        for (uint8_t i = 0; i < updateQueueCount; ++i) {
+            const QueuedUpdate_t &update = updateQueue[i];
+            ble_error_t write_err = write(
+                update.connectionHandle,
+                update.attributeHandle,
+                update.value,
+                update.size
+            );
+            if (write_err != BLE_ERROR_NONE && err == BLE_ERROR_NONE) {
+                err = write_err;
+            }
+        }
+
+        updateQueueCount = 0;
+        return err;
+    }
+
+    /**
+     * Write the updates queued by writeQueued() for a given connection.
+     *
+     * Updates queued for other connections remain pending.
+     *
+     * @param[in] connectionHandle Connection to flush the pending updates of.
+     *
+     * @return BLE_ERROR_NONE if all pending updates of the connection have
+     * been written; the first error reported by write() otherwise.
+     */
+    ble_error_t flushUpdates(Gap::Handle_t connectionHandle)
+    {
+        ble_error_t err = BLE_ERROR_NONE;
+        uint8_t kept = 0;
+
+        for (uint8_t i = 0; i < updateQueueCount; ++i) {
+            const QueuedUpdate_t &update = updateQueue[i];
+            if (update.connectionHandle != connectionHandle) {
+                if (kept != i) {
+                    updateQueue[kept] = update;
+                }
+                ++kept;
+                continue;
+            }
+
+            ble_error_t write_err = write(
+                update.connectionHandle,
+                update.attributeHandle,
+                update.value,
+                update.size
+            );
+            if (write_err != BLE_ERROR_NONE && err == BLE_ERROR_NONE) {
+                err = write_err;
+            }
+        }
+
+        updateQueueCount = kept;
+        return err;
+    }
+
+    /**
+     * Set the number of pending updates at which writeQueued() flushes the
+     * queue automatically.
+     *
+     * A lower threshold reduces the latency added by queuing at the cost of
+     * less packing; on stacks that invoke handleConnectionEventStart(), the
+     * added latency is in any case bounded by the connection interval.
+     *
+     * @param[in] count The new threshold; clipped to the queue length. A
+     * threshold of 1 makes writeQueued() behave as write().
+     */
+    void setUpdateQueueThreshold(uint8_t count)
+    {
+        if (count == 0) {
+            count = 1;
+        } else if (count > BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH) {
+            count = BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH;
+        }
+        updateQueueThreshold = count;
+    }
+
     /**
      * Add an event handler that monitors emission of characteristic value
      * updates.
@@ -745,6 +913,23 @@ protected:
         dataSentCallChain.call(count);
     }
 
+    /**
+     * Helper function that writes the updates queued for a connection by
+     * writeQueued().
+     *
+     * @attention Vendor implementation should invoke this function when the
+     * link layer prepares a connection event for the connection; the queued
+     * notifications are then emitted back to back and packed into that
+     * connection event.
+     *
+     * @param[in] connectionHandle Handle of the connection the event belongs
+     * to.
+     */
+    void handleConnectionEventStart(Gap::Handle_t connectionHandle)
+    {
+        flushUpdates(connectionHandle);
+    }
+
 public:
     /**
      * Shut down the GattServer instance.
@@ -766,6 +951,7 @@ public:
 
         serviceCount = 0;
         characteristicCount = 0;
+        updateQueueCount = 0;
 
         dataSentCallChain.clear();
         dataWrittenCallChain.clear();
@@ -788,6 +974,32 @@ protected:
      */
     uint8_t characteristicCount;
 
+private:
+    /**
+     * A characteristic value update queued by writeQueued().
+     */
+    struct QueuedUpdate_t {
+        Gap::Handle_t connectionHandle;
+        GattAttribute::Handle_t attributeHandle;
+        uint16_t size;
+        uint8_t value[BLE_GATT_SERVER_UPDATE_QUEUE_DATA_SIZE];
+    };
+
+    /**
+     * Updates queued by writeQueued() and not yet written.
+     */
+    QueuedUpdate_t updateQueue[BLE_GATT_SERVER_UPDATE_QUEUE_LENGTH];
+
+    /**
+     * The number of updates pending in updateQueue.
+     */
+    uint8_t updateQueueCount;
+
+    /**
+     * The number of pending updates at which writeQueued() flushes the queue.
+     */
+    uint8_t updateQueueThreshold;
+
 private:
     /**
      * Callchain containing all registered callback handlers for data sent
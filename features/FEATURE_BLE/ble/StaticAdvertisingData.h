@@ -0,0 +1,283 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLE_STATIC_ADVERTISING_DATA_H_
+#define BLE_STATIC_ADVERTISING_DATA_H_
+
+#include <string.h>
+#include <stddef.h>
+
+#include "platform/mbed_assert.h"
+#include "ArrayView.h"
+#include "GapAdvertisingData.h"
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gap
+ * @{
+ */
+
+namespace ble {
+
+/**
+ * Description of one field slot of a StaticAdvertisingData frame.
+ *
+ * A field slot is an AD structure whose type and payload size are fixed at
+ * compile time. Slots are chained into a frame layout by the @p NextField
+ * parameter; the last slot of the layout leaves it to its default.
+ *
+ * @tparam AdType The AD type of the field (see GapAdvertisingData::DataType_t).
+ * @tparam PayloadSize Size in bytes of the field value.
+ * @tparam NextField The next field of the frame layout or void for the last
+ * field.
+ */
+template<uint8_t AdType, uint8_t PayloadSize, typename NextField = void>
+struct AdvertisingField {
+    /**
+     * The AD type of the field.
+     */
+    static const uint8_t ad_type = AdType;
+
+    /**
+     * Size in bytes of the field value.
+     */
+    static const uint8_t payload_size = PayloadSize;
+
+    /**
+     * Size in bytes of the whole AD structure: the length and type bytes
+     * followed by the value.
+     */
+    static const uint8_t record_size = PayloadSize + 2;
+
+    /**
+     * The next field of the frame layout.
+     */
+    typedef NextField next;
+};
+
+/**
+ * Compute the size in bytes of the frame described by a field layout.
+ *
+ * @tparam Layout Chain of AdvertisingField describing the frame.
+ */
+template<typename Layout>
+struct AdvertisingFrameSize {
+    static const uint8_t value =
+        Layout::record_size + AdvertisingFrameSize<typename Layout::next>::value;
+};
+
+template<>
+struct AdvertisingFrameSize<void> {
+    static const uint8_t value = 0;
+};
+
+/**
+ * Resolve the field at a given index of a field layout and its byte offset
+ * within the frame.
+ *
+ * @tparam Layout Chain of AdvertisingField describing the frame.
+ * @tparam Index Zero based index of the field within the layout.
+ */
+template<typename Layout, size_t Index>
+struct AdvertisingFieldAt {
+    typedef AdvertisingFieldAt<typename Layout::next, Index - 1> next_field;
+    typedef typename next_field::type type;
+    static const uint8_t offset = Layout::record_size + next_field::offset;
+};
+
+template<typename Layout>
+struct AdvertisingFieldAt<Layout, 0> {
+    typedef Layout type;
+    static const uint8_t offset = 0;
+};
+
+/**
+ * Write the length and type bytes of every field of a layout into a frame
+ * buffer.
+ *
+ * @tparam Layout Chain of AdvertisingField describing the frame.
+ */
+template<typename Layout>
+struct AdvertisingFrameInitializer {
+    static void write_headers(uint8_t *frame)
+    {
+        frame[0] = Layout::payload_size + 1;
+        frame[1] = Layout::ad_type;
+        AdvertisingFrameInitializer<typename Layout::next>::write_headers(
+            frame + Layout::record_size
+        );
+    }
+};
+
+template<>
+struct AdvertisingFrameInitializer<void> {
+    static void write_headers(uint8_t *) { }
+};
+
+/**
+ * Advertising payload builder with a structure fixed at compile time.
+ *
+ * While GapAdvertisingData locates and resizes fields at runtime - which
+ * involves scanning the payload and shuffling its content - this class
+ * describes the advertising frame as a compile-time list of field slots of
+ * fixed size. The length and type bytes of every slot are written once at
+ * construction, the byte offset of every slot is resolved by the compiler,
+ * and updating a field value is a plain in-place store.
+ *
+ * This makes it well suited to beacons that rewrite a telemetry field of
+ * their payload many times per second.
+ *
+ * @code
+ * typedef ble::AdvertisingField<
+ *     GapAdvertisingData::FLAGS, 1,
+ *     ble::AdvertisingField<
+ *         GapAdvertisingData::MANUFACTURER_SPECIFIC_DATA, 6
+ *     >
+ * > BeaconFrame_t;
+ *
+ * ble::StaticAdvertisingData<BeaconFrame_t> frame;
+ *
+ * uint8_t flags = GapAdvertisingData::LE_GENERAL_DISCOVERABLE |
+ *                 GapAdvertisingData::BREDR_NOT_SUPPORTED;
+ * frame.set<0>(&flags);
+ *
+ * // refresh the telemetry field; no scan, no reformatting
+ * ble::ArrayView<uint8_t, 6> telemetry = frame.field<1>();
+ * memcpy(telemetry.data() + 2, &measurement, sizeof(measurement));
+ *
+ * gap.setAdvertisingPayload(frame.gapAdvertisingData());
+ * @endcode
+ *
+ * @tparam Layout Chain of AdvertisingField describing the frame.
+ */
+template<typename Layout>
+class StaticAdvertisingData {
+public:
+    /**
+     * Size in bytes of the advertising frame.
+     */
+    static const uint8_t payload_size = AdvertisingFrameSize<Layout>::value;
+
+    MBED_STATIC_ASSERT(
+        payload_size <= GAP_ADVERTISING_DATA_MAX_PAYLOAD,
+        "Advertising frame larger than the maximum advertising payload"
+    );
+
+    /**
+     * Construct the frame; field headers are written and field values are
+     * zero initialized.
+     */
+    StaticAdvertisingData()
+    {
+        memset(_payload, 0, payload_size);
+        AdvertisingFrameInitializer<Layout>::write_headers(_payload);
+    }
+
+    /**
+     * Get a mutable view to the value of a field.
+     *
+     * @tparam Index Zero based index of the field within the frame layout.
+     *
+     * @return An ArrayView of the bytes holding the field value.
+     */
+    template<size_t Index>
+    ArrayView<uint8_t, AdvertisingFieldAt<Layout, Index>::type::payload_size> field()
+    {
+        typedef AdvertisingFieldAt<Layout, Index> field_t;
+        return ArrayView<uint8_t, field_t::type::payload_size>(
+            _payload + field_t::offset + 2,
+            field_t::type::payload_size
+        );
+    }
+
+    /**
+     * Get an immutable view to the value of a field.
+     *
+     * @tparam Index Zero based index of the field within the frame layout.
+     *
+     * @return An ArrayView of the bytes holding the field value.
+     */
+    template<size_t Index>
+    ArrayView<const uint8_t, AdvertisingFieldAt<Layout, Index>::type::payload_size> field() const
+    {
+        typedef AdvertisingFieldAt<Layout, Index> field_t;
+        return ArrayView<const uint8_t, field_t::type::payload_size>(
+            _payload + field_t::offset + 2,
+            field_t::type::payload_size
+        );
+    }
+
+    /**
+     * Replace the value of a field.
+     *
+     * @tparam Index Zero based index of the field within the frame layout.
+     *
+     * @param[in] value Pointer to the new value of the field; the field
+     * payload size is copied from it.
+     */
+    template<size_t Index>
+    void set(const uint8_t *value)
+    {
+        typedef AdvertisingFieldAt<Layout, Index> field_t;
+        memcpy(_payload + field_t::offset + 2, value, field_t::type::payload_size);
+    }
+
+    /**
+     * Get the pointer to the advertising frame bytes.
+     *
+     * @return A pointer to the frame.
+     */
+    const uint8_t *data() const
+    {
+        return _payload;
+    }
+
+    /**
+     * Get the frame length.
+     *
+     * @return The frame length in bytes.
+     */
+    uint8_t size() const
+    {
+        return payload_size;
+    }
+
+    /**
+     * Produce the GapAdvertisingData accepted by Gap::setAdvertisingPayload.
+     *
+     * @return A GapAdvertisingData holding a copy of the frame.
+     */
+    GapAdvertisingData gapAdvertisingData() const
+    {
+        return GapAdvertisingData(_payload, payload_size);
+    }
+
+private:
+    /**
+     * The advertising frame.
+     */
+    uint8_t _payload[payload_size];
+};
+
+} // namespace ble
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* BLE_STATIC_ADVERTISING_DATA_H_ */
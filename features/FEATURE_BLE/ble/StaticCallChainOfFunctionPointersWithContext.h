@@ -0,0 +1,288 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_STATIC_CALLCHAIN_OF_FUNCTION_POINTERS_WITH_CONTEXT_H
+#define MBED_STATIC_CALLCHAIN_OF_FUNCTION_POINTERS_WITH_CONTEXT_H
+
+#include <stddef.h>
+#include "FunctionPointerWithContext.h"
+#include "SafeBool.h"
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup common
+ * @{
+ */
+
+/**
+ * Function like object hosting a fixed-capacity array of
+ * FunctionPointerWithContext.
+ *
+ * This class offers the same service as
+ * CallChainOfFunctionPointersWithContext but trades the unbounded, heap
+ * allocated linked list for an inline array whose capacity is fixed at
+ * compile time: attaching a callback does not allocate, and invoking the
+ * chain iterates contiguous storage instead of chasing pointers. It is
+ * intended for event chains that are called at a high rate with a small,
+ * known number of observers.
+ *
+ * Callbacks are called in the order they were added.
+ *
+ * Example:
+ * @code
+ *
+ * StaticCallChainOfFunctionPointersWithContext<void *, 2> chain;
+ *
+ * void first(void *context) {
+ *     printf("'first' function.\n");
+ * }
+ *
+ * void second(void *context) {
+ *     printf("'second' function.\n");
+ * }
+ *
+ * int main() {
+ *     chain.add(first);
+ *     chain.add(second);
+ *
+ *     // will print:
+ *     // 'first' function.
+ *     // 'second' function.
+ *     chain.call();
+ * }
+ * @endcode
+ *
+ * @tparam ContextType Type of the parameter accepted by the callbacks hosted
+ * in the object.
+ * @tparam Capacity Maximum number of callbacks the object can host.
+ */
+template <typename ContextType, size_t Capacity>
+class StaticCallChainOfFunctionPointersWithContext :
+    public SafeBool<StaticCallChainOfFunctionPointersWithContext<ContextType, Capacity> > {
+public:
+    /**
+     * Alias of the FunctionPointerWithContext type this object can store.
+     */
+    typedef FunctionPointerWithContext<ContextType> *pFunctionPointerWithContext_t;
+
+public:
+    /**
+     * Create an empty callchain.
+     */
+    StaticCallChainOfFunctionPointersWithContext() :
+        count(0),
+        currentCalled(invalid_index) { }
+
+    /**
+     * Add a function pointer at the end of the chain.
+     *
+     * @param[in] function A pointer to a void function.
+     *
+     * @return The FunctionPointerWithContext object stored for @p function or
+     * NULL if the chain is full.
+     */
+    pFunctionPointerWithContext_t add(void (*function)(ContextType context))
+    {
+        return common_add(FunctionPointerWithContext<ContextType>(function));
+    }
+
+    /**
+     * Add a member function bound to its instance at the end of the chain.
+     *
+     * @param[in] tptr Pointer to the object to call the member function on.
+     * @param[in] mptr Pointer to the member function to be called.
+     *
+     * @return The FunctionPointerWithContext object stored for @p tptr and
+     * @p mptr or NULL if the chain is full.
+     */
+    template<typename T>
+    pFunctionPointerWithContext_t add(T *tptr, void (T::*mptr)(ContextType context))
+    {
+        return common_add(FunctionPointerWithContext<ContextType>(tptr, mptr));
+    }
+
+    /**
+     * Add a FunctionPointerWithContext at the end of the chain.
+     *
+     * @param[in] func The FunctionPointerWithContext to add.
+     *
+     * @return The function object stored for @p func or NULL if the chain is
+     * full.
+     */
+    pFunctionPointerWithContext_t add(const FunctionPointerWithContext<ContextType> &func)
+    {
+        return common_add(func);
+    }
+
+    /**
+     * Detach a function pointer from a callchain.
+     *
+     * @param[in] toDetach FunctionPointerWithContext instance to detach from
+     * this callchain.
+     *
+     * @return true if a function pointer has been detached and false otherwise.
+     *
+     * @note It is safe to remove a function pointer while
+     * call(ContextType) is traversing the chain.
+     *
+     * @attention Detaching a callback moves the callbacks stored after it;
+     * pointers previously returned by add() must not be retained across a
+     * call to detach().
+     */
+    bool detach(const FunctionPointerWithContext<ContextType> &toDetach)
+    {
+        for (size_t idx = 0; idx < count; ++idx) {
+            if (functions[idx] == toDetach) {
+                for (size_t i = idx; (i + 1) < count; ++i) {
+                    functions[i] = functions[i + 1];
+                }
+                --count;
+                if ((currentCalled != invalid_index) && (idx <= currentCalled)) {
+                    --currentCalled;
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Remove all functions registered in the chain.
+     */
+    void clear(void)
+    {
+        count = 0;
+        currentCalled = invalid_index;
+    }
+
+    /**
+     * Check whether the callchain contains any callbacks.
+     *
+     * @return true if the callchain is not empty and false otherwise.
+     */
+    bool hasCallbacksAttached(void) const
+    {
+        return (count != 0);
+    }
+
+    /**
+     * Call sequentially each member of the chain.
+     *
+     * @param[in] context Parameter to pass to the functions called.
+     */
+    void call(ContextType context)
+    {
+        ((const StaticCallChainOfFunctionPointersWithContext*) this)->call(context);
+    }
+
+    /**
+     * Call sequentially each member of the chain.
+     *
+     * @param[in] context Parameter to pass to the functions called.
+     */
+    void call(ContextType context) const
+    {
+        for (currentCalled = 0; currentCalled < count; ++currentCalled) {
+            functions[currentCalled].call(context);
+        }
+        currentCalled = invalid_index;
+    }
+
+    /**
+     * Call sequentially each member of the chain.
+     *
+     * @param[in] context Parameter to pass to the functions called.
+     */
+    void operator()(ContextType context) const
+    {
+        call(context);
+    }
+
+    /**
+     * Test if the callchain is empty or not.
+     *
+     * @return true if the callchain is not empty and false otherwise.
+     *
+     * @note used by SafeBool to offer a safe boolean conversion.
+     */
+    bool toBool() const
+    {
+        return count != 0;
+    }
+
+private:
+    /**
+     * Index value signaling that no call is in progress.
+     */
+    static const size_t invalid_index = (size_t) - 1;
+
+    /**
+     * Store a callback in the first free slot of the array.
+     *
+     * @return A pointer to the stored callback or NULL if the chain is full.
+     */
+    pFunctionPointerWithContext_t common_add(const FunctionPointerWithContext<ContextType> &func)
+    {
+        if (count == Capacity) {
+            return NULL;
+        }
+
+        functions[count] = func;
+        return &functions[count++];
+    }
+
+private:
+    /**
+     * The callbacks attached to the chain, stored contiguously in attach
+     * order.
+     */
+    FunctionPointerWithContext<ContextType> functions[Capacity];
+
+    /**
+     * The number of callbacks attached.
+     */
+    size_t count;
+
+    /**
+     * Index of the callback being called or invalid_index if no call is in
+     * progress.
+     *
+     * It is used to maintain the data structure integrity if a function is
+     * removed during the call() operation.
+     *
+     * @note It has to be mutable to accomodate the const version of call(). The
+     * iterator doesn't leak outside the object; therefore, it remains seen as
+     * const from an external standpoint.
+     */
+    mutable size_t currentCalled;
+
+    /* Disallow copy constructor and assignment operators. */
+private:
+    StaticCallChainOfFunctionPointersWithContext(
+        const StaticCallChainOfFunctionPointersWithContext&
+    );
+    StaticCallChainOfFunctionPointersWithContext &operator=(
+        const StaticCallChainOfFunctionPointersWithContext&
+    );
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif
@@ -32,6 +32,19 @@
  * @{
  */
 
+/**
+ * Number of distinct 128-bit UUIDs the interning registry can hold.
+ *
+ * Every 128-bit UUID constructed is looked up in the registry and assigned
+ * the handle of its entry, making subsequent equality tests between
+ * registered UUIDs a single integer comparison. UUIDs constructed once the
+ * registry is full fall back to byte comparison. Set to 0 to disable
+ * interning and reclaim the registry storage.
+ */
+#ifndef BLE_UUID_INTERN_REGISTRY_SIZE
+#define BLE_UUID_INTERN_REGISTRY_SIZE 8
+#endif
+
 /**
  * Convert a character containing an hexadecimal digit into an unsigned integer.
  *
@@ -147,7 +160,8 @@ public:
     UUID(const char* stringUUID) :
         type(UUID_TYPE_LONG),
         baseUUID(),
-        shortUUID(0)
+        shortUUID(0),
+        internHandle(0)
     {
         bool nibble = false;
         uint8_t byte = 0;
@@ -195,7 +209,7 @@ public:
      * @param[in] longUUID The 128-bit (16-byte) of the UUID value.
      * @param[in] order Bytes order of @p longUUID.
      */
-    UUID(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0) {
+    UUID(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0), internHandle(0) {
         setupLong(longUUID, order);
     }
 
@@ -218,7 +232,8 @@ public:
     UUID(ShortUUIDBytes_t _shortUUID) :
         type(UUID_TYPE_SHORT),
         baseUUID(),
-        shortUUID(_shortUUID) {
+        shortUUID(_shortUUID),
+        internHandle(0) {
     }
 
     /**
@@ -228,8 +243,9 @@ public:
      */
     UUID(const UUID &source)
     {
-        type      = source.type;
-        shortUUID = source.shortUUID;
+        type         = source.type;
+        shortUUID    = source.shortUUID;
+        internHandle = source.internHandle;
         memcpy(baseUUID, source.baseUUID, LENGTH_OF_LONG_UUID);
     }
 
@@ -243,7 +259,8 @@ public:
      */
     UUID(void) :
         type(UUID_TYPE_SHORT),
-        shortUUID(BLE_UUID_UNKNOWN) {
+        shortUUID(BLE_UUID_UNKNOWN),
+        internHandle(0) {
     }
 
     /**
@@ -265,6 +282,7 @@ public:
             std::copy(longUUID, longUUID + LENGTH_OF_LONG_UUID, baseUUID);
         }
         shortUUID = (uint16_t)((baseUUID[13] << 8) | (baseUUID[12]));
+        internHandle = internLong(baseUUID);
     }
 
 public:
@@ -333,9 +351,12 @@ public:
             return true;
         }
 
-        if ((this->type == UUID_TYPE_LONG) && (other.type == UUID_TYPE_LONG) &&
-            (memcmp(this->baseUUID, other.baseUUID, LENGTH_OF_LONG_UUID) == 0)) {
-            return true;
+        if ((this->type == UUID_TYPE_LONG) && (other.type == UUID_TYPE_LONG)) {
+            /* UUIDs interned in the registry compare by handle */
+            if (this->internHandle && other.internHandle) {
+                return this->internHandle == other.internHandle;
+            }
+            return memcmp(this->baseUUID, other.baseUUID, LENGTH_OF_LONG_UUID) == 0;
         }
 
         return false;
@@ -353,6 +374,20 @@ public:
         return !(*this == other);
     }
 
+private:
+    /**
+     * Register a 128-bit UUID in the interning registry.
+     *
+     * If the value is already present, the handle of its entry is returned;
+     * otherwise, the value is added to the registry if space remains.
+     *
+     * @param[in] longUUID The 128-bit UUID value in little endian order.
+     *
+     * @return The nonzero handle of the registry entry holding the value or
+     * 0 if the registry is full (or interning is disabled).
+     */
+    static uint16_t internLong(const uint8_t *longUUID);
+
 private:
     /**
      * Representation type of the UUID.
@@ -368,6 +403,26 @@ private:
      * Container of UUID value if the UUID type is equal to UUID_TYPE_SHORT.
      */
     ShortUUIDBytes_t shortUUID;
+
+    /**
+     * Handle of the interning registry entry holding the UUID value or 0 if
+     * the UUID is not interned.
+     *
+     * Only meaningful if the UUID type is equal to UUID_TYPE_LONG.
+     */
+    uint16_t internHandle;
+
+#if BLE_UUID_INTERN_REGISTRY_SIZE > 0
+    /**
+     * Storage of the interned 128-bit UUID values.
+     */
+    static LongUUIDBytes_t internRegistry[BLE_UUID_INTERN_REGISTRY_SIZE];
+
+    /**
+     * Number of entries of the interning registry in use.
+     */
+    static uint16_t internRegistryCount;
+#endif
 };
 
 /**
@@ -281,6 +281,23 @@ public:
         CentralPrivacyConfiguration_t *configuration
     );
 
+    /**
+     * @see Gap::setScanFilter
+     */
+    virtual ble_error_t setScanFilter(const ScanFilter_t *filter);
+
+    /**
+     * @see Gap::setConnectionParamsPolicy
+     */
+    virtual ble_error_t setConnectionParamsPolicy(
+        const ConnectionParamsPolicy_t *policy
+    );
+
+    /**
+     * @see Gap::reportConnectionTraffic
+     */
+    virtual void reportConnectionTraffic(Handle_t connectionHandle);
+
     /**
      * @see Gap::setAdvertisingData
      */
@@ -340,6 +357,24 @@ private:
 
     void on_advertising_report(const pal::GapAdvertisingReportEvent &e);
 
+    bool scan_filter_accept(
+        const uint8_t *address,
+        int8_t rssi,
+        const uint8_t *data,
+        size_t size
+    );
+
+    bool scan_filter_dedup_accept(
+        const uint8_t *address,
+        int8_t rssi,
+        const uint8_t *data,
+        size_t size
+    );
+
+    void on_connection_params_policy_tick();
+
+    void process_connection_params_policy();
+
     void on_connection_complete(const pal::GapConnectionCompleteEvent &e);
 
     void on_disconnection_complete(const pal::GapDisconnectionCompleteEvent &e);
@@ -385,6 +420,46 @@ private:
     bool _privacy_enabled;
     PeripheralPrivacyConfiguration_t _peripheral_privacy_configuration;
     CentralPrivacyConfiguration_t _central_privacy_configuration;
+
+    /**
+     * Number of peers tracked by the scan report deduplicator; the oldest
+     * entry is recycled when a new peer is seen with the table full.
+     */
+    static const uint8_t SCAN_FILTER_DEDUP_SIZE = 8;
+
+    struct ScanDedupEntry_t {
+        bool in_use;
+        BLEProtocol::AddressBytes_t address;
+        int8_t rssi;
+        uint8_t data_length;
+        uint8_t data_checksum;
+    };
+
+    bool _scan_filter_enabled;
+    ScanFilter_t _scan_filter;
+    BLEProtocol::Address_t _scan_filter_addresses[ScanFilter_t::MAX_FILTER_ADDRESSES];
+    ScanDedupEntry_t _scan_dedup[SCAN_FILTER_DEDUP_SIZE];
+    uint8_t _scan_dedup_next;
+
+    /**
+     * Number of connections tracked by the connection parameter policy
+     * engine.
+     */
+    static const uint8_t CONNECTION_POLICY_CONNECTIONS = 4;
+
+    struct ConnectionPolicyState_t {
+        bool in_use;
+        bool fast_active;
+        Handle_t handle;
+        uint16_t traffic_count;
+        uint16_t quiet_periods;
+    };
+
+    bool _connection_params_policy_enabled;
+    ConnectionParamsPolicy_t _connection_params_policy;
+    ConnectionPolicyState_t _connection_policy_states[CONNECTION_POLICY_CONNECTIONS];
+    mbed::Ticker _connection_params_policy_ticker;
+
     ble::address_t _random_static_identity_address;
     bool _random_address_rotating;
     
@@ -121,6 +121,17 @@ public:
      */
     virtual void set_signing_event_handler(pal::SigningEventMonitor::EventHandler *signing_event_handler);
 
+    /**
+     * Register a handler notified of every read or write initiated on a
+     * connection.
+     *
+     * Ports wire this to Gap::reportConnectionTraffic so the connection
+     * parameter policy engine sees the client's traffic.
+     */
+    void set_traffic_event_handler(
+        const FunctionPointerWithContext<Gap::Handle_t> &handler
+    );
+
 private:
     struct ProcedureControlBlock;
     struct DiscoveryControlBlock;
@@ -144,6 +155,7 @@ private:
     pal::GattClient* const _pal_client;
     ServiceDiscovery::TerminationCallback_t _termination_callback;
     pal::SigningEventMonitor::EventHandler* _signing_event_handler;
+    FunctionPointerWithContext<Gap::Handle_t> _traffic_event_handler;
     mutable ProcedureControlBlock* control_blocks;
     bool _is_reseting;
 };
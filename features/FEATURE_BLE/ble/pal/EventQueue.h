@@ -60,6 +60,27 @@ struct EventQueue {
      * BLEInstanceBase::process
      */
     virtual bool post(const mbed::Callback<void()>& event) = 0;
+
+    /**
+     * Post a long-running event into the background lane of the queue.
+     *
+     * Background events run only when no regular event is pending, and a
+     * single background event is processed per processing pass. Splitting a
+     * long computation - such as the ECDH exchange of a pairing procedure -
+     * into restartable slices posted on this lane keeps it from stalling
+     * the traffic of other users of the queue.
+     *
+     * @param event The event to store in the background lane.
+     *
+     * @return true in case of success and false otherwise
+     *
+     * @note The default implementation forwards to post(); implementations
+     * with a real background lane shall override it.
+     */
+    virtual bool post_background(const mbed::Callback<void()>& event)
+    {
+        return post(event);
+    }
 };
 
 } // namespace pal
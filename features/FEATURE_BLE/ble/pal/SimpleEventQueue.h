@@ -41,7 +41,8 @@ struct SimpleEventQueue : EventQueue {
      * event queue.
      */
     SimpleEventQueue() :
-        _ble_base(NULL), _ble_instance_id(0), _events(NULL) { }
+        _ble_base(NULL), _ble_instance_id(0), _events(NULL),
+        _background_events(NULL) { }
 
     /**
      * Initialize the event queue with a BLEInstanceBase and a ble id.
@@ -95,6 +96,36 @@ struct SimpleEventQueue : EventQueue {
         return true;
     }
 
+    /**
+     * @see ble::pal::EventQueue::post_background
+     */
+    virtual bool post_background(const mbed::Callback<void()>& event)
+    {
+        if (_ble_base == NULL) {
+            return false;
+        }
+
+        EventNode* next = new (std::nothrow) EventNode(event);
+        if (next == NULL) {
+            return false;
+        }
+
+        if (_background_events == NULL) {
+            _background_events = next;
+        } else {
+            EventNode* previous = _background_events;
+            while (previous->next) {
+                previous = previous->next;
+            }
+
+            previous->next = next;
+        }
+
+        signal_event();
+
+        return true;
+    }
+
     /**
      * Clear the event queue from all its events.
      */
@@ -105,6 +136,12 @@ struct SimpleEventQueue : EventQueue {
             delete _events;
             _events = next;
         }
+
+        while (_background_events) {
+            EventNode* next = _background_events->next;
+            delete _background_events;
+            _background_events = next;
+        }
     }
 
     /**
@@ -118,6 +155,19 @@ struct SimpleEventQueue : EventQueue {
             delete _events;
             _events = next;
         }
+
+        // Run a single background slice per pass; remaining slices are
+        // processed on later passes, after any event they may have produced
+        if (_background_events) {
+            EventNode* next = _background_events->next;
+            _background_events->event();
+            delete _background_events;
+            _background_events = next;
+
+            if (_events || _background_events) {
+                signal_event();
+            }
+        }
     }
 
 private:
@@ -135,6 +185,7 @@ private:
     BLEInstanceBase* _ble_base;
     BLE::InstanceID_t _ble_instance_id;
     EventNode* _events;
+    EventNode* _background_events;
 };
 
 } // namespace pal
@@ -0,0 +1,48 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ble/UUID.h"
+
+#if BLE_UUID_INTERN_REGISTRY_SIZE > 0
+
+UUID::LongUUIDBytes_t UUID::internRegistry[BLE_UUID_INTERN_REGISTRY_SIZE];
+uint16_t UUID::internRegistryCount = 0;
+
+uint16_t UUID::internLong(const uint8_t *longUUID)
+{
+    for (uint16_t i = 0; i < internRegistryCount; i++) {
+        if (memcmp(internRegistry[i], longUUID, LENGTH_OF_LONG_UUID) == 0) {
+            return i + 1;
+        }
+    }
+
+    if (internRegistryCount < BLE_UUID_INTERN_REGISTRY_SIZE) {
+        memcpy(internRegistry[internRegistryCount], longUUID, LENGTH_OF_LONG_UUID);
+        return ++internRegistryCount;
+    }
+
+    return 0;
+}
+
+#else
+
+uint16_t UUID::internLong(const uint8_t *longUUID)
+{
+    (void)longUUID;
+    return 0;
+}
+
+#endif
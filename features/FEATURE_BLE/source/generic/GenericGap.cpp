@@ -393,6 +393,60 @@ static bool is_advertising_params_valid(const GapAdvertisingParams& params)
     return true;
 }
 
+/*
+ * Return true if the advertising payload contains an AD structure of the
+ * given type.
+ */
+static bool advertising_data_contains_type(
+    const uint8_t *data, size_t size, uint8_t ad_type
+) {
+    size_t i = 0;
+    while (i < size) {
+        uint8_t field_length = data[i];
+        if (field_length == 0 || (i + 1 + field_length) > size) {
+            break;
+        }
+
+        if (data[i + 1] == ad_type) {
+            return true;
+        }
+
+        i += 1 + field_length;
+    }
+
+    return false;
+}
+
+/*
+ * Return true if the advertising payload lists the given 16-bit service UUID
+ * in a complete or incomplete list of 16-bit service UUIDs.
+ */
+static bool advertising_data_contains_uuid(
+    const uint8_t *data, size_t size, uint16_t uuid
+) {
+    size_t i = 0;
+    while (i < size) {
+        uint8_t field_length = data[i];
+        if (field_length == 0 || (i + 1 + field_length) > size) {
+            break;
+        }
+
+        uint8_t ad_type = data[i + 1];
+        if (ad_type == GapAdvertisingData::INCOMPLETE_LIST_16BIT_SERVICE_IDS ||
+            ad_type == GapAdvertisingData::COMPLETE_LIST_16BIT_SERVICE_IDS) {
+            for (size_t j = i + 2; (j + 1) < (i + 1 + field_length); j += 2) {
+                if ((data[j] | (data[j + 1] << 8)) == uuid) {
+                    return true;
+                }
+            }
+        }
+
+        i += 1 + field_length;
+    }
+
+    return false;
+}
+
 } // end of anonymous namespace
 
 GenericGap::GenericGap(
@@ -412,6 +466,11 @@ GenericGap::GenericGap(
     _privacy_enabled(false),
     _peripheral_privacy_configuration(default_peripheral_privacy_configuration),
     _central_privacy_configuration(default_central_privacy_configuration),
+    _scan_filter_enabled(false),
+    _scan_filter(),
+    _scan_dedup_next(0),
+    _connection_params_policy_enabled(false),
+    _connection_params_policy(),
     _random_address_rotating(false),
     _advertising_timeout(),
     _scan_timeout(),
@@ -966,6 +1025,135 @@ ble_error_t GenericGap::getCentralPrivacyConfiguration(
     return BLE_ERROR_NONE;
 }
 
+ble_error_t GenericGap::setScanFilter(const ScanFilter_t *filter)
+{
+    if (filter == NULL) {
+        _scan_filter_enabled = false;
+        return BLE_ERROR_NONE;
+    }
+
+    if (filter->address_count > ScanFilter_t::MAX_FILTER_ADDRESSES ||
+        (filter->address_count && (filter->addresses == NULL))) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    _scan_filter = *filter;
+    for (uint8_t i = 0; i < filter->address_count; ++i) {
+        _scan_filter_addresses[i] = filter->addresses[i];
+    }
+    _scan_filter.addresses = _scan_filter_addresses;
+
+    for (uint8_t i = 0; i < SCAN_FILTER_DEDUP_SIZE; ++i) {
+        _scan_dedup[i].in_use = false;
+    }
+    _scan_dedup_next = 0;
+
+    _scan_filter_enabled = true;
+
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t GenericGap::setConnectionParamsPolicy(
+    const ConnectionParamsPolicy_t *policy
+)
+{
+    if (policy == NULL) {
+        _connection_params_policy_ticker.detach();
+        _connection_params_policy_enabled = false;
+        return BLE_ERROR_NONE;
+    }
+
+    if (is_connection_params_valid(&policy->fastParams) == false ||
+        is_connection_params_valid(&policy->slowParams) == false ||
+        policy->busyThreshold == 0 ||
+        policy->idlePeriods == 0 ||
+        policy->evaluationPeriod == 0
+    ) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    _connection_params_policy = *policy;
+
+    if (!_connection_params_policy_enabled) {
+        for (uint8_t i = 0; i < CONNECTION_POLICY_CONNECTIONS; ++i) {
+            _connection_policy_states[i].in_use = false;
+        }
+        _connection_params_policy_enabled = true;
+    }
+
+    _connection_params_policy_ticker.attach_us(
+        mbed::callback(this, &GenericGap::on_connection_params_policy_tick),
+        policy->evaluationPeriod * 1000UL
+    );
+
+    return BLE_ERROR_NONE;
+}
+
+void GenericGap::reportConnectionTraffic(Handle_t connectionHandle)
+{
+    if (!_connection_params_policy_enabled) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < CONNECTION_POLICY_CONNECTIONS; ++i) {
+        if (_connection_policy_states[i].in_use &&
+            _connection_policy_states[i].handle == connectionHandle) {
+            ++_connection_policy_states[i].traffic_count;
+            break;
+        }
+    }
+}
+
+void GenericGap::on_connection_params_policy_tick()
+{
+    _event_queue.post(
+        mbed::callback(this, &GenericGap::process_connection_params_policy)
+    );
+}
+
+void GenericGap::process_connection_params_policy()
+{
+    if (!_connection_params_policy_enabled) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < CONNECTION_POLICY_CONNECTIONS; ++i) {
+        ConnectionPolicyState_t &state = _connection_policy_states[i];
+        if (!state.in_use) {
+            continue;
+        }
+
+        if (state.traffic_count >= _connection_params_policy.busyThreshold) {
+            state.quiet_periods = 0;
+            if (!state.fast_active &&
+                updateConnectionParams(
+                    state.handle, &_connection_params_policy.fastParams
+                ) == BLE_ERROR_NONE
+            ) {
+                state.fast_active = true;
+            }
+        } else if (state.traffic_count == 0) {
+            if (state.quiet_periods < _connection_params_policy.idlePeriods) {
+                ++state.quiet_periods;
+            }
+
+            if (state.fast_active &&
+                state.quiet_periods >= _connection_params_policy.idlePeriods &&
+                updateConnectionParams(
+                    state.handle, &_connection_params_policy.slowParams
+                ) == BLE_ERROR_NONE
+            ) {
+                state.fast_active = false;
+            }
+        } else {
+            // Background traffic; neither busy nor idle
+            state.quiet_periods = 0;
+        }
+
+        state.traffic_count = 0;
+    }
+}
+
 ble_error_t GenericGap::setAdvertisingData(const GapAdvertisingData &advData, const GapAdvertisingData &scanResponse)
 {
     ble_error_t err = _pal_gap.set_advertising_data(
@@ -1075,6 +1263,19 @@ void GenericGap::processConnectionEvent(
         );
     }
 
+    if (_connection_params_policy_enabled) {
+        for (uint8_t i = 0; i < CONNECTION_POLICY_CONNECTIONS; ++i) {
+            if (!_connection_policy_states[i].in_use) {
+                _connection_policy_states[i].in_use = true;
+                _connection_policy_states[i].fast_active = false;
+                _connection_policy_states[i].handle = handle;
+                _connection_policy_states[i].traffic_count = 0;
+                _connection_policy_states[i].quiet_periods = 0;
+                break;
+            }
+        }
+    }
+
     ::Gap::processConnectionEvent(
         handle,
         role,
@@ -1099,6 +1300,14 @@ void GenericGap::processDisconnectionEvent(
         );
     }
 
+    for (uint8_t i = 0; i < CONNECTION_POLICY_CONNECTIONS; ++i) {
+        if (_connection_policy_states[i].in_use &&
+            _connection_policy_states[i].handle == handle) {
+            _connection_policy_states[i].in_use = false;
+            break;
+        }
+    }
+
     ::Gap::processDisconnectionEvent(
         handle,
         reason
@@ -1184,6 +1393,18 @@ void GenericGap::on_advertising_report(const pal::GapAdvertisingReportEvent& e)
             continue;
         }
 
+        if (_scan_filter_enabled &&
+            !scan_filter_accept(
+                advertising.address.data(),
+                advertising.rssi,
+                advertising.data.data(),
+                advertising.data.size()
+            )
+        ) {
+            // Filter it out
+            continue;
+        }
+
         // note 1-to-1 conversion between connection_peer_address_type_t and
         // peer_address_type_t
         peer_address_type_t peer_address_type =
@@ -1201,6 +1422,90 @@ void GenericGap::on_advertising_report(const pal::GapAdvertisingReportEvent& e)
     }
 }
 
+bool GenericGap::scan_filter_accept(
+    const uint8_t *address,
+    int8_t rssi,
+    const uint8_t *data,
+    size_t size
+)
+{
+    if (_scan_filter.address_count) {
+        uint8_t i = 0;
+        while (i < _scan_filter.address_count &&
+               memcmp(_scan_filter.addresses[i].address, address, BLEProtocol::ADDR_LEN) != 0) {
+            ++i;
+        }
+
+        if (i == _scan_filter.address_count) {
+            return false;
+        }
+    }
+
+    if (_scan_filter.required_ad_type &&
+        !advertising_data_contains_type(data, size, _scan_filter.required_ad_type)) {
+        return false;
+    }
+
+    if (_scan_filter.required_service_uuid &&
+        !advertising_data_contains_uuid(data, size, _scan_filter.required_service_uuid)) {
+        return false;
+    }
+
+    if (_scan_filter.rssi_delta &&
+        !scan_filter_dedup_accept(address, rssi, data, size)) {
+        return false;
+    }
+
+    return true;
+}
+
+bool GenericGap::scan_filter_dedup_accept(
+    const uint8_t *address,
+    int8_t rssi,
+    const uint8_t *data,
+    size_t size
+)
+{
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        checksum += data[i];
+    }
+
+    ScanDedupEntry_t *entry = NULL;
+    for (uint8_t i = 0; i < SCAN_FILTER_DEDUP_SIZE; ++i) {
+        if (_scan_dedup[i].in_use &&
+            memcmp(_scan_dedup[i].address, address, BLEProtocol::ADDR_LEN) == 0) {
+            entry = &_scan_dedup[i];
+            break;
+        }
+    }
+
+    if (entry) {
+        int rssi_delta = rssi - entry->rssi;
+        if (rssi_delta < 0) {
+            rssi_delta = -rssi_delta;
+        }
+
+        if (entry->data_length == size &&
+            entry->data_checksum == checksum &&
+            rssi_delta < _scan_filter.rssi_delta) {
+            return false;
+        }
+    } else {
+        // New peer; recycle the next slot
+        entry = &_scan_dedup[_scan_dedup_next];
+        _scan_dedup_next = (_scan_dedup_next + 1) % SCAN_FILTER_DEDUP_SIZE;
+        entry->in_use = true;
+        memcpy(entry->address, address, BLEProtocol::ADDR_LEN);
+    }
+
+    entry->rssi = rssi;
+    entry->data_length = size;
+    entry->data_checksum = checksum;
+
+    return true;
+}
+
 void GenericGap::on_connection_complete(const pal::GapConnectionCompleteEvent& e)
 {
     if (e.status != pal::hci_error_code_t::SUCCESS) {
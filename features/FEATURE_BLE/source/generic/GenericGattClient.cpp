@@ -938,6 +938,7 @@ GenericGattClient::GenericGattClient(pal::GattClient* pal_client) :
 	_pal_client(pal_client),
 	_termination_callback(),
 	_signing_event_handler(NULL),
+	_traffic_event_handler(),
 	 control_blocks(NULL),
 	_is_reseting(false) {
 	_pal_client->when_server_message_received(
@@ -1039,6 +1040,10 @@ ble_error_t GenericGattClient::read(
 		return BLE_ERROR_INVALID_STATE;
 	}
 
+	if (_traffic_event_handler) {
+		_traffic_event_handler.call(connection_handle);
+	}
+
 	ReadControlBlock* read_pcb = new(std::nothrow) ReadControlBlock(
 		connection_handle,
 		attribute_handle,
@@ -1083,6 +1088,10 @@ ble_error_t GenericGattClient::write(
 		return BLE_ERROR_INVALID_STATE;
 	}
 
+	if (_traffic_event_handler) {
+		_traffic_event_handler.call(connection_handle);
+	}
+
     uint16_t mtu = get_mtu(connection_handle);
 
     /* if link is encrypted signed writes should be normal writes */
@@ -1273,6 +1282,12 @@ ble_error_t GenericGattClient::reset(void) {
 	return BLE_ERROR_NONE;
 }
 
+void GenericGattClient::set_traffic_event_handler(
+	const FunctionPointerWithContext<Gap::Handle_t> &handler
+) {
+	_traffic_event_handler = handler;
+}
+
 void GenericGattClient::set_signing_event_handler(
     EventHandler *signing_event_handler
 ) {
@@ -100,6 +100,16 @@ void Test_AT_CellularDevice::test_AT_CellularDevice_open_sim()
     CHECK(dev.open_sim(&fh1));
 }
 
+void Test_AT_CellularDevice::test_AT_CellularDevice_open_multiplexer()
+{
+    EventQueue que;
+    AT_CellularDevice dev(que);
+    FileHandle_stub fh1;
+
+    CHECK(!dev.open_multiplexer(NULL));
+    CHECK(dev.open_multiplexer(&fh1));
+}
+
 void Test_AT_CellularDevice::test_AT_CellularDevice_open_information()
 {
     EventQueue que;
@@ -168,6 +178,20 @@ void Test_AT_CellularDevice::test_AT_CellularDevice_close_sim()
     CHECK(ATHandler_stub::ref_count == 0);
 }
 
+void Test_AT_CellularDevice::test_AT_CellularDevice_close_multiplexer()
+{
+    EventQueue que;
+    AT_CellularDevice dev(que);
+    FileHandle_stub fh1;
+    ATHandler_stub::ref_count = 0;
+
+    CHECK(dev.open_multiplexer(&fh1));
+    CHECK(ATHandler_stub::ref_count == 1);
+
+    dev.close_multiplexer();
+    CHECK(ATHandler_stub::ref_count == 0);
+}
+
 void Test_AT_CellularDevice::test_AT_CellularDevice_close_information()
 {
     EventQueue que;
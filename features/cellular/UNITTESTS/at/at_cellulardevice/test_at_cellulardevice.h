@@ -36,6 +36,8 @@ public:
 
     void test_AT_CellularDevice_open_sim();
 
+    void test_AT_CellularDevice_open_multiplexer();
+
     void test_AT_CellularDevice_open_information();
 
     void test_AT_CellularDevice_close_network();
@@ -46,6 +48,8 @@ public:
 
     void test_AT_CellularDevice_close_sim();
 
+    void test_AT_CellularDevice_close_multiplexer();
+
     void test_AT_CellularDevice_close_information();
 
     void test_AT_CellularDevice_set_timeout();
@@ -61,6 +61,11 @@ TEST(AT_CellularNetwork, test_AT_CellularNetwork_activate_context)
     unit->test_AT_CellularNetwork_activate_context();
 }
 
+TEST(AT_CellularNetwork, test_AT_CellularNetwork_prepare_context)
+{
+    unit->test_AT_CellularNetwork_prepare_context();
+}
+
 TEST(AT_CellularNetwork, test_AT_CellularNetwork_connect)
 {
     unit->test_AT_CellularNetwork_connect();
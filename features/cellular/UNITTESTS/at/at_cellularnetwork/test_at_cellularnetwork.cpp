@@ -316,6 +316,33 @@ void Test_AT_CellularNetwork::test_AT_CellularNetwork_activate_context()
 
 }
 
+void Test_AT_CellularNetwork::test_AT_CellularNetwork_prepare_context()
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    ATHandler at(&fh1, que, 0, ",");
+
+    AT_CellularNetwork cn(at);
+    my_AT_CN my_cn(at);
+
+    // get_context return true and new context created, do_user_authentication called with success.
+    // Prepared context is consumed by the following activation.
+    ATHandler_stub::resp_info_true_counter = 0;
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_OK;
+    ATHandler_stub::bool_value = false;
+    ATHandler_stub::resp_stop_success_count = kResp_stop_count_default;
+    CHECK(NSAPI_ERROR_OK == my_cn.set_credentials("apn", CellularNetwork::CHAP, "user", "passwd"));
+    CHECK(NSAPI_ERROR_OK == my_cn.prepare_context());
+    CHECK(NSAPI_ERROR_OK == my_cn.activate_context());
+
+    // get_context return true and new context created, do_user_authentication called with failure.
+    ATHandler_stub::resp_stop_success_count = 2;
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_OK;
+    ATHandler_stub::bool_value = false;
+    CHECK(NSAPI_ERROR_OK == cn.set_credentials("apn", CellularNetwork::CHAP, "user", "passwd"));
+    CHECK(NSAPI_ERROR_AUTH_FAILURE == cn.prepare_context());
+}
+
 void Test_AT_CellularNetwork::test_AT_CellularNetwork_connect()
 {
     EventQueue que;
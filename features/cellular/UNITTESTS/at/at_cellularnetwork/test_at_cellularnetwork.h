@@ -32,6 +32,8 @@ public:
 
     void test_AT_CellularNetwork_activate_context();
 
+    void test_AT_CellularNetwork_prepare_context();
+
     void test_AT_CellularNetwork_connect();
 
     void test_AT_CellularNetwork_disconnect();
@@ -192,6 +192,16 @@ TEST(ATHandler, test_ATHandler_resp_stop)
     unit->test_ATHandler_resp_stop();
 }
 
+TEST(ATHandler, test_ATHandler_pipeline)
+{
+    unit->test_ATHandler_pipeline();
+}
+
+TEST(ATHandler, test_ATHandler_data_mode)
+{
+    unit->test_ATHandler_data_mode();
+}
+
 TEST(ATHandler, test_ATHandler_info_resp)
 {
     unit->test_ATHandler_info_resp();
@@ -696,6 +696,84 @@ void Test_ATHandler::test_ATHandler_resp_stop()
     at.resp_stop();
 }
 
+void Test_ATHandler::test_ATHandler_pipeline()
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+
+    at.pipeline_start();
+    CHECK(NSAPI_ERROR_OK == at.pipeline_barrier());
+
+    fh1.size_value = 8;
+    at.cmd_start("AT+CFUN=1");
+    at.cmd_stop();
+    at.cmd_start("AT+CMEE=1");
+    at.cmd_stop();
+
+    char table[] = "OK\r\nOK\r\n\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+
+    at.pipeline_stop();
+
+    at.flush();
+    at.clear_error();
+    at.pipeline_start();
+    fh1.size_value = -1;
+    at.cmd_start("AT");
+    at.cmd_stop();
+    CHECK(NSAPI_ERROR_DEVICE_ERROR == at.pipeline_stop());
+    filehandle_stub_table = NULL;
+}
+
+void Test_ATHandler::test_ATHandler_data_mode()
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+
+    at.data_mode_start();
+
+    mbed_poll_stub::revents_value = POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    fh1.size_value = 8;
+    CHECK(4 == at.data_write("data", 4));
+
+    char head[] = "head";
+    char body[] = "body";
+    nsapi_iovec_t iov[2];
+    iov[0].iov_base = head;
+    iov[0].iov_len = 4;
+    iov[1].iov_base = body;
+    iov[1].iov_len = 4;
+    CHECK(8 == at.data_writev(iov, 2));
+
+    mbed_poll_stub::revents_value = POLLIN;
+    char table[] = "data\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    char buf[8];
+    CHECK(4 == at.data_read(buf, 8));
+
+    char table2[] = "OK\r\n\0";
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLOUT | POLLIN;
+    at.data_mode_stop();
+
+    filehandle_stub_table = NULL;
+    at.clear_error();
+    at.data_mode_start();
+    fh1.size_value = -1;
+    mbed_poll_stub::revents_value = POLLOUT;
+    CHECK(-1 == at.data_write("data", 4));
+    CHECK(NSAPI_ERROR_DEVICE_ERROR == at.get_last_error());
+    mbed_poll_stub::int_value = 0;
+}
+
 void Test_ATHandler::test_ATHandler_info_resp()
 {
     EventQueue que;
@@ -86,6 +86,10 @@ public:
 
     void test_ATHandler_resp_stop();
 
+    void test_ATHandler_pipeline();
+
+    void test_ATHandler_data_mode();
+
     void test_ATHandler_info_resp();
 
     void test_ATHandler_info_elem();
@@ -66,6 +66,11 @@ nsapi_error_t AT_CellularNetwork::activate_context()
     return NSAPI_ERROR_OK;
 }
 
+nsapi_error_t AT_CellularNetwork::prepare_context()
+{
+    return NSAPI_ERROR_OK;
+}
+
 nsapi_error_t AT_CellularNetwork::open_data_channel()
 {
     return NSAPI_ERROR_OK;
@@ -18,3 +18,4 @@
 #include <sys/types.h>
 #define EAGAIN 11
 #define ENOTTY 25
+#define ENOSYS 38
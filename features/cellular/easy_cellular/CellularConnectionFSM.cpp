@@ -43,7 +43,8 @@ namespace mbed
 CellularConnectionFSM::CellularConnectionFSM() :
         _serial(0), _state(STATE_INIT), _next_state(_state), _status_callback(0), _event_status_cb(0), _network(0), _power(0), _sim(0),
         _queue(8 * EVENTS_EVENT_SIZE), _queue_thread(0), _cellularDevice(0), _retry_count(0), _event_timeout(-1),
-        _at_queue(8 * EVENTS_EVENT_SIZE), _event_id(0), _plmn(0), _command_success(false), _plmn_network_found(false)
+        _at_queue(8 * EVENTS_EVENT_SIZE), _event_id(0), _plmn(0), _command_success(false), _plmn_network_found(false),
+        _context_prepared(false)
 {
     memset(_sim_pin, 0, sizeof(_sim_pin));
 #if MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY == 0
@@ -126,6 +127,7 @@ nsapi_error_t CellularConnectionFSM::init()
     _retry_count = 0;
     _state = STATE_INIT;
     _next_state = STATE_INIT;
+    _context_prepared = false;
 
     return _network->init();
 }
@@ -446,6 +448,16 @@ void CellularConnectionFSM::state_sim_pin()
     }
 }
 
+void CellularConnectionFSM::prepare_context_while_waiting()
+{
+    // the wait for registration leaves the modem link idle, use it to get
+    // the PDP context defined and authenticated in advance so that only the
+    // activation itself is left after attach
+    if (!_context_prepared) {
+        _context_prepared = (_network->prepare_context() == NSAPI_ERROR_OK);
+    }
+}
+
 void CellularConnectionFSM::state_registering()
 {
     _cellularDevice->set_timeout(TIMEOUT_NETWORK);
@@ -457,6 +469,7 @@ void CellularConnectionFSM::state_registering()
         if (!_command_success) {
             _command_success = (_network->set_registration() == NSAPI_ERROR_OK);
         }
+        prepare_context_while_waiting();
         retry_state_or_fail();
     }
 }
@@ -474,6 +487,7 @@ void CellularConnectionFSM::state_manual_registering_network()
             if (!_command_success) {
                 _command_success = (_network->set_registration(_plmn) == NSAPI_ERROR_OK);
             }
+            prepare_context_while_waiting();
             retry_state_or_fail();
         }
     }
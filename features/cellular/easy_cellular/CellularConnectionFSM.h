@@ -164,6 +164,8 @@ private:
     bool is_registered();
     void device_ready();
 
+    void prepare_context_while_waiting();
+
     // state functions to keep state machine simple
     void state_init();
     void state_power_on();
@@ -216,6 +218,7 @@ private:
     const char *_plmn;
     bool _command_success;
     bool _plmn_network_found;
+    bool _context_prepared;
 };
 
 } // namespace
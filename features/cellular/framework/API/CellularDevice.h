@@ -24,6 +24,7 @@
 #include "CellularNetwork.h"
 #include "CellularSMS.h"
 #include "CellularPower.h"
+#include "CellularMultiplexer.h"
 #include "CellularInformation.h"
 #include "NetworkStack.h"
 
@@ -72,6 +73,13 @@ public:
      */
     virtual CellularSIM *open_sim(FileHandle *fh) = 0;
 
+    /** Create new CellularMultiplexer interface.
+     *
+     *  @param fh    file handle used in communication to modem. Can be for example UART handle.
+     *  @return      New instance of interface CellularMultiplexer.
+     */
+    virtual CellularMultiplexer *open_multiplexer(FileHandle *fh) = 0;
+
     /** Create new CellularInformation interface.
      *
      *  @param fh    file handle used in communication to modem. Can be for example UART handle.
@@ -95,6 +103,10 @@ public:
      */
     virtual void close_sim() = 0;
 
+    /** Closes the opened CellularMultiplexer by deleting the CellularMultiplexer instance.
+     */
+    virtual void close_multiplexer() = 0;
+
     /** Closes the opened CellularInformation by deleting the CellularInformation instance.
      */
     virtual void close_information() = 0;
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_MULTIPLEXER_H_
+#define CELLULAR_MULTIPLEXER_H_
+
+#include "nsapi_types.h"
+
+namespace mbed {
+
+/**
+ *  Class CellularMultiplexer
+ *
+ *  An abstract interface for switching the modem to 3GPP TS 27.010 multiplexed mode.
+ */
+class CellularMultiplexer
+{
+public:
+    virtual ~CellularMultiplexer() {}
+
+public:
+    /** Starts multiplexed mode on the modem.
+     *
+     *  After a successful start the modem expects 27.010 frames on the serial channel,
+     *  so the file handle must be given to CellularMux and used only through its channels.
+     *
+     *  @return zero on success
+     */
+    virtual nsapi_error_t multiplexer_mode_start() = 0;
+};
+
+} // namespace mbed
+
+#endif // CELLULAR_MULTIPLEXER_H_
@@ -385,6 +385,15 @@ public:
      */
     virtual nsapi_error_t activate_context() = 0;
 
+    /** Finds or creates the correct PDP context and authenticates the user but does not activate the context.
+     *  Calling this is optional; activate_context() prepares the context itself when needed. It can be called
+     *  while waiting for network registration so that a later activate_context() only needs to request
+     *  the activation, shortening the connect sequence.
+     *
+     *  @return zero on success
+     */
+    virtual nsapi_error_t prepare_context() = 0;
+
     /**
      * Set the pdn type to be used
      *
@@ -48,6 +48,10 @@ const char *ERROR_ = "ERROR\r\n";
 const uint8_t ERROR_LENGTH = 7;
 const uint8_t MAX_RESP_LENGTH = CMS_ERROR_LENGTH;
 const char DEFAULT_DELIMITER = ',';
+const char *ESCAPE_SEQUENCE = "+++";
+const uint8_t ESCAPE_SEQUENCE_LENGTH = 3;
+// required silence on the line before and after the escape sequence (TIA-602)
+#define ESCAPE_SEQUENCE_GUARD_TIME 1000
 
 static const uint8_t map_3gpp_errors[][2] =  {
     { 103, 3 },  { 106, 6 },  { 107, 7 },  { 108, 8 },  { 111, 11 }, { 112, 12 }, { 113, 13 }, { 114, 14 },
@@ -81,6 +85,10 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, int timeout, const char
     _max_resp_length(MAX_RESP_LENGTH),
     _debug_on(MBED_CONF_CELLULAR_DEBUG_AT),
     _cmd_start(false),
+    _pipelining(false),
+    _pipeline_pending(0),
+    _data_mode(false),
+    _last_data_write(0),
     _start_time(0)
 {
     clear_error();
@@ -536,6 +544,99 @@ int32_t ATHandler::read_int()
     return std::strtol(buff, &first_no_digit, 10);
 }
 
+ATHandler::Fields::Fields() : _count(0)
+{
+}
+
+size_t ATHandler::Fields::count() const
+{
+    return _count;
+}
+
+const char *ATHandler::Fields::str(size_t index) const
+{
+    if (index >= _count) {
+        return NULL;
+    }
+
+    return _field[index];
+}
+
+int32_t ATHandler::Fields::int32(size_t index) const
+{
+    if (index >= _count) {
+        return -1;
+    }
+
+    char *first_no_digit;
+    return std::strtol(_field[index], &first_no_digit, 10);
+}
+
+ssize_t ATHandler::Fields::length(size_t index) const
+{
+    if (index >= _count) {
+        return -1;
+    }
+
+    return strlen(_field[index]);
+}
+
+ssize_t ATHandler::read_fields(Fields &fields, char *buf, size_t size)
+{
+    fields._count = 0;
+
+    if (_last_err || !_stop_tag || _stop_tag->found || size == 0) {
+        return -1;
+    }
+
+    size_t match_pos = 0;
+    size_t buf_idx = 0;
+    size_t field_start = 0;
+
+    while (buf_idx < size - 1) {
+        int c = get_char();
+        if (c == -1) {
+            buf[buf_idx] = '\0';
+            set_error(NSAPI_ERROR_DEVICE_ERROR);
+            return -1;
+        }
+        if (c == _delimiter) {
+            buf[buf_idx++] = '\0';
+            if (fields._count < Fields::MAX_FIELDS) {
+                fields._field[fields._count++] = buf + field_start;
+            }
+            field_start = buf_idx;
+            match_pos = 0;
+            continue;
+        } else if (c == '\"') {
+            match_pos = 0;
+            continue;
+        } else if (_stop_tag->len && c == _stop_tag->tag[match_pos]) {
+            match_pos++;
+            if (match_pos == _stop_tag->len) {
+                _stop_tag->found = true;
+                // remove tag from string if it was matched
+                buf_idx -= (_stop_tag->len - 1);
+                break;
+            }
+        } else if (match_pos) {
+            match_pos = 0;
+        }
+
+        buf[buf_idx++] = c;
+    }
+
+    buf[buf_idx] = '\0';
+
+    // record the last field; an empty response yields no fields at all
+    if ((buf_idx > field_start || fields._count) &&
+        fields._count < Fields::MAX_FIELDS) {
+        fields._field[fields._count++] = buf + field_start;
+    }
+
+    return fields._count;
+}
+
 void ATHandler::set_delimiter(char delimiter)
 {
     _delimiter = delimiter;
@@ -1031,6 +1132,165 @@ void ATHandler::cmd_stop()
     }
     // Finish with CR
     (void)write(_output_delimiter, strlen(_output_delimiter));
+
+    if (_pipelining) {
+        _pipeline_pending++;
+    }
+}
+
+void ATHandler::pipeline_start()
+{
+    _pipelining = true;
+    _pipeline_pending = 0;
+}
+
+nsapi_error_t ATHandler::pipeline_barrier()
+{
+    if (_last_err != NSAPI_ERROR_OK) {
+        // Writing a command failed so part of the commands were never sent.
+        // There are no responses to correlate anymore, the application needs to recover and retry.
+        _pipeline_pending = 0;
+        return _last_err;
+    }
+
+    nsapi_error_t first_err = NSAPI_ERROR_OK;
+    device_err_t first_at_err;
+    int first_3gpp_error = 0;
+    first_at_err.errType = DeviceErrorTypeNoError;
+    first_at_err.errCode = 0;
+
+    while (_pipeline_pending > 0) {
+        resp_start();
+        resp_stop();
+        _pipeline_pending--;
+
+        if (_last_err != NSAPI_ERROR_OK) {
+            if (first_err == NSAPI_ERROR_OK) {
+                first_err = _last_err;
+                first_at_err = _last_at_err;
+                first_3gpp_error = _last_3gpp_error;
+            }
+            // Consume the remaining responses anyway to keep the command
+            // and response streams in sync
+            clear_error();
+        }
+    }
+
+    if (first_err != NSAPI_ERROR_OK) {
+        _last_err = first_err;
+        _last_at_err = first_at_err;
+        _last_3gpp_error = first_3gpp_error;
+    }
+
+    return _last_err;
+}
+
+nsapi_error_t ATHandler::pipeline_stop()
+{
+    nsapi_error_t err = pipeline_barrier();
+    _pipelining = false;
+    return err;
+}
+
+void ATHandler::data_mode_start()
+{
+    _data_mode = true;
+    _last_data_write = rtos::Kernel::get_ms_count();
+}
+
+ssize_t ATHandler::data_write(const void *data, size_t len)
+{
+    if (_last_err != NSAPI_ERROR_OK) {
+        return -1;
+    }
+
+    _start_time = rtos::Kernel::get_ms_count();
+    size_t write_len = write(data, len);
+    _last_data_write = rtos::Kernel::get_ms_count();
+    if (_last_err != NSAPI_ERROR_OK) {
+        return -1;
+    }
+
+    return write_len;
+}
+
+ssize_t ATHandler::data_writev(const nsapi_iovec_t *iov, int iov_len)
+{
+    if (_last_err != NSAPI_ERROR_OK) {
+        return -1;
+    }
+
+    size_t write_len = 0;
+    for (int i = 0; i < iov_len; i++) {
+        if (iov[i].iov_len == 0) {
+            continue;
+        }
+        _start_time = rtos::Kernel::get_ms_count();
+        write_len += write(iov[i].iov_base, iov[i].iov_len);
+        if (_last_err != NSAPI_ERROR_OK) {
+            _last_data_write = rtos::Kernel::get_ms_count();
+            return -1;
+        }
+    }
+    _last_data_write = rtos::Kernel::get_ms_count();
+
+    return write_len;
+}
+
+ssize_t ATHandler::data_read(void *buf, size_t len)
+{
+    if (_last_err != NSAPI_ERROR_OK) {
+        return -1;
+    }
+
+    // Return first what the parser had already buffered when data mode was entered
+    if (_recv_pos < _recv_len) {
+        size_t copy_len = _recv_len - _recv_pos;
+        if (copy_len > len) {
+            copy_len = len;
+        }
+        memcpy(buf, _recv_buff + _recv_pos, copy_len);
+        _recv_pos += copy_len;
+        return copy_len;
+    }
+
+    pollfh fhs;
+    fhs.fh = _fileHandle;
+    fhs.events = POLLIN;
+    _start_time = rtos::Kernel::get_ms_count();
+    int count = poll(&fhs, 1, poll_timeout());
+    if (count > 0 && (fhs.revents & POLLIN)) {
+        ssize_t ret = _fileHandle->read(buf, len);
+        if (ret >= 0) {
+            return ret;
+        }
+    }
+
+    set_error(NSAPI_ERROR_DEVICE_ERROR);
+    return -1;
+}
+
+nsapi_error_t ATHandler::data_mode_stop()
+{
+    if (!_data_mode) {
+        return _last_err;
+    }
+
+    // The modem recognizes the escape sequence only when it is surrounded by silence on
+    // the line, so that payload happening to contain "+++" does not end the data mode.
+    rtos::Thread::wait_until(_last_data_write + ESCAPE_SEQUENCE_GUARD_TIME);
+
+    clear_error();
+    _start_time = rtos::Kernel::get_ms_count();
+    (void)write(ESCAPE_SEQUENCE, ESCAPE_SEQUENCE_LENGTH);
+
+    // The guard time after the sequence is spent waiting for the final result code:
+    // nothing is written until the modem is back in command mode.
+    resp_start();
+    resp_stop();
+
+    _data_mode = false;
+    return _last_err;
 }
 
 size_t ATHandler::write_bytes(const uint8_t *data, size_t len)
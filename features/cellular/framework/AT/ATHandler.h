@@ -248,6 +248,33 @@ public:
      */
     void cmd_stop();
 
+    /** Enters the pipelined command mode.
+     *
+     *  In pipelined mode, commands written with cmd_start()...cmd_stop() are sent back to back without
+     *  reading the response in between. The modem answers the commands in the order they were sent, and
+     *  pipeline_barrier() consumes the responses in that order. Only independent commands whose response
+     *  is a bare final result code (OK or error) may be pipelined; a command that depends on the outcome
+     *  of an earlier one, or whose information response must be parsed, must be preceded by a barrier.
+     */
+    void pipeline_start();
+
+    /** Consumes, in arrival order, the final result code of every command pipelined since the last barrier.
+     *
+     *  All pending responses are consumed even if one of them is an error, so that the command and
+     *  response streams stay in sync; the first error found is kept as the last error. If writing a
+     *  pipelined command failed, the pending responses are discarded instead and the application should
+     *  recover as with any device error.
+     *
+     *  @return NSAPI_ERROR_OK if every pipelined command succeeded, or the first error found
+     */
+    nsapi_error_t pipeline_barrier();
+
+    /** Leaves the pipelined command mode, consuming any outstanding responses as pipeline_barrier() does.
+     *
+     *  @return error as in pipeline_barrier()
+     */
+    nsapi_error_t pipeline_stop();
+
     /** Write bytes without any subparameter delimiters, such as comma.
      *  In case of failure when writing, the last error is set to NSAPI_ERROR_DEVICE_ERROR.
      *
@@ -258,6 +285,52 @@ public:
      */
     size_t write_bytes(const uint8_t *data, size_t len);
 
+    /** Enters transparent data mode.
+     *
+     *  Call after the modem has been switched to transparent passthrough (for example with ATO or a
+     *  vendor direct link command) and its CONNECT response has been consumed. In data mode the AT
+     *  parser is bypassed and the channel carries raw payload: only data_write(), data_writev() and
+     *  data_read() may be used until data_mode_stop() has returned. URCs are not processed in data mode.
+     */
+    void data_mode_start();
+
+    /** Writes raw payload to the modem, bypassing the AT parser.
+     *  In case of failure when writing, the last error is set to NSAPI_ERROR_DEVICE_ERROR.
+     *
+     *  @param data bytes to be written to modem
+     *  @param len  length of data
+     *  @return number of bytes written or -1 in case of error
+     */
+    ssize_t data_write(const void *data, size_t len);
+
+    /** Writes a scatter-gather list of raw payload buffers back to back, bypassing the AT parser.
+     *  The buffers leave as one continuous stream without being staged into a contiguous buffer.
+     *  In case of failure when writing, the last error is set to NSAPI_ERROR_DEVICE_ERROR.
+     *
+     *  @param iov     scatter-gather list of buffers to write
+     *  @param iov_len number of buffers in iov
+     *  @return total number of bytes written or -1 in case of error
+     */
+    ssize_t data_writev(const nsapi_iovec_t *iov, int iov_len);
+
+    /** Reads raw payload from the modem, bypassing the AT parser.
+     *  Bytes that were already in the parser's receiving buffer when data mode was entered are
+     *  returned first.
+     *
+     *  @param buf output buffer for the read
+     *  @param len maximum number of bytes to read
+     *  @return number of bytes read or -1 in case of error or timeout
+     */
+    ssize_t data_read(void *buf, size_t len);
+
+    /** Leaves data mode by sending the escape sequence "+++" surrounded by the required guard
+     *  times of line silence, then consumes the final result code the modem sends once it is
+     *  back in command mode.
+     *
+     *  @return NSAPI_ERROR_OK on success or the last error
+     */
+    nsapi_error_t data_mode_stop();
+
     /** Sets the stop tag for the current scope (response/information response/element)
      *  Parameter's reading routines will stop the reading when such tag is found and will set the found flag.
      *  Consume routines will read everything until such tag is found.
@@ -325,6 +398,66 @@ public:
      */
     int32_t read_int();
 
+    /** Tokenized view of one information response.
+     *
+     *  Filled by read_fields(), which splits the response into fields in a
+     *  single pass. The field spans point into the buffer given to
+     *  read_fields() and stay valid as long as the buffer does.
+     */
+    class Fields {
+    public:
+        Fields();
+
+        /** Number of fields in the response */
+        size_t count() const;
+
+        /** Field as a null terminated string
+         *
+         *  @param index index of the field in the response
+         *  @return the field or NULL if index is out of range
+         */
+        const char *str(size_t index) const;
+
+        /** Field converted to integer. Supports only positive integers.
+         *
+         *  @param index index of the field in the response
+         *  @return the positive integer or -1 in case of error
+         */
+        int32_t int32(size_t index) const;
+
+        /** Length of a field in chars
+         *
+         *  @param index index of the field in the response
+         *  @return length of the field or -1 if index is out of range
+         */
+        ssize_t length(size_t index) const;
+
+    private:
+        friend class ATHandler;
+
+        /** Maximum number of fields recorded from one information response */
+        static const size_t MAX_FIELDS = 16;
+
+        const char *_field[MAX_FIELDS];
+        size_t _count;
+    };
+
+    /** Consumes the current information response in a single pass and splits
+     *  it into fields on the delimiter. Skips the quotation marks. Stops on
+     *  the stop tag or when the buffer is full. Fields beyond
+     *  Fields::MAX_FIELDS are consumed but not recorded.
+     *
+     *  Parsing responses such as +CEREG or +CSQ through the returned fields
+     *  costs one scan of the receive buffer instead of one scan per
+     *  read_string/read_int call.
+     *
+     *  @param fields filled with the field spans of the response
+     *  @param buf buffer the field contents are stored into
+     *  @param size size of buf
+     *  @return number of fields recorded or -1 in case of error
+     */
+    ssize_t read_fields(Fields &fields, char *buf, size_t size);
+
     /**  This looks for necessary matches: prefix, OK, ERROR, URCs and sets the correct scope.
      *
      *  @param prefix string to be matched from receiving buffer. If not NULL and match succeeds, then scope
@@ -431,6 +564,14 @@ private:
     char _info_resp_prefix[BUFF_SIZE];
     bool _debug_on;
     bool _cmd_start;
+    // true when commands are sent back to back and their responses consumed at a barrier
+    bool _pipelining;
+    // number of pipelined commands whose final result code has not been consumed yet
+    uint16_t _pipeline_pending;
+    // true when the channel is in transparent data mode and the AT parser is bypassed
+    bool _data_mode;
+    // time of the last data mode write, used to time the escape sequence guard
+    uint64_t _last_data_write;
 
     // time when a command or an URC processing was started
     uint64_t _start_time;
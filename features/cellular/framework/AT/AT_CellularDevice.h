@@ -24,6 +24,7 @@
 #include "AT_CellularSIM.h"
 #include "AT_CellularSMS.h"
 #include "AT_CellularPower.h"
+#include "AT_CellularMultiplexer.h"
 #include "AT_CellularInformation.h"
 
 #include "ATHandler.h"
@@ -63,6 +64,8 @@ public: // CellularDevice
 
     virtual CellularSIM *open_sim(FileHandle *fh);
 
+    virtual CellularMultiplexer *open_multiplexer(FileHandle *fh);
+
     virtual CellularInformation *open_information(FileHandle *fh);
 
     virtual void close_network();
@@ -73,6 +76,8 @@ public: // CellularDevice
 
     virtual void close_sim();
 
+    virtual void close_multiplexer();
+
     virtual void close_information();
 
     virtual void set_timeout(int timeout);
@@ -88,6 +93,7 @@ protected:
     AT_CellularSMS *_sms;
     AT_CellularSIM *_sim;
     AT_CellularPower* _power;
+    AT_CellularMultiplexer* _multiplexer;
     AT_CellularInformation* _information;
 
 protected:
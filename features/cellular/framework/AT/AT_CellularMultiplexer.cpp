@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2018, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AT_CellularMultiplexer.h"
+#include "CellularMux.h"
+
+using namespace mbed;
+
+AT_CellularMultiplexer::AT_CellularMultiplexer(ATHandler &at) : AT_CellularBase(at)
+{
+}
+
+AT_CellularMultiplexer::~AT_CellularMultiplexer()
+{
+}
+
+nsapi_error_t AT_CellularMultiplexer::multiplexer_mode_start()
+{
+    _at.lock();
+
+    _at.cmd_start("AT+CMUX=");
+    _at.write_int(0); // basic option
+    _at.write_int(0); // UIH frames
+    _at.write_int(5); // port speed 115200
+    _at.write_int(MBED_CONF_CELLULAR_MUX_FRAME_SIZE); // maximum frame size N1
+    _at.cmd_stop();
+    _at.resp_start();
+    _at.resp_stop();
+
+    return _at.unlock_return_error();
+}
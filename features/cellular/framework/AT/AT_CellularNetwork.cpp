@@ -42,7 +42,7 @@ AT_CellularNetwork::AT_CellularNetwork(ATHandler &atHandler) : AT_CellularBase(a
     _stack(NULL), _apn(NULL), _uname(NULL), _pwd(NULL), _ip_stack_type_requested(DEFAULT_STACK),
     _ip_stack_type(DEFAULT_STACK), _cid(-1), _connection_status_cb(NULL), _op_act(RAT_UNKNOWN),
     _authentication_type(CHAP), _cell_id(-1), _connect_status(NSAPI_STATUS_DISCONNECTED), _new_context_set(false),
-    _is_context_active(false), _reg_status(NotRegistered), _current_act(RAT_UNKNOWN)
+    _is_context_active(false), _is_context_prepared(false), _reg_status(NotRegistered), _current_act(RAT_UNKNOWN)
 {
 }
 
@@ -199,6 +199,9 @@ nsapi_error_t AT_CellularNetwork::set_credentials(const char *apn,
 {
     free_credentials();
 
+    // a context prepared with the old credentials is no longer valid
+    _is_context_prepared = false;
+
     size_t len;
     if (apn && (len = strlen(apn)) > 0) {
         _apn = (char *)malloc(len * sizeof(char) + 1);
@@ -267,12 +270,13 @@ nsapi_error_t AT_CellularNetwork::delete_current_context()
     if (_at.get_last_error() == NSAPI_ERROR_OK) {
         _cid = -1;
         _new_context_set = false;
+        _is_context_prepared = false;
     }
 
     return _at.get_last_error();
 }
 
-nsapi_error_t AT_CellularNetwork::activate_context()
+nsapi_error_t AT_CellularNetwork::prepare_context()
 {
     _at.lock();
 
@@ -286,6 +290,38 @@ nsapi_error_t AT_CellularNetwork::activate_context()
         err = NSAPI_ERROR_NO_CONNECTION;
     }
 
+    _at.unlock();
+
+    if (err != NSAPI_ERROR_OK) {
+        tr_error("Failed to prepare network context! (%d)", err);
+    } else {
+        _is_context_prepared = true;
+    }
+
+    return err;
+}
+
+nsapi_error_t AT_CellularNetwork::activate_context()
+{
+    _at.lock();
+
+    nsapi_error_t err = NSAPI_ERROR_OK;
+
+    // skip context selection and authentication if they were already done
+    // with prepare_context() while waiting for registration
+    bool prepared = _is_context_prepared;
+    _is_context_prepared = false;
+
+    if (!prepared) {
+        // try to find or create context with suitable stack
+        if (get_context()) {
+            // try to authenticate user before activating or modifying context
+            err = do_user_authentication();
+        } else {
+            err = NSAPI_ERROR_NO_CONNECTION;
+        }
+    }
+
     if (err != NSAPI_ERROR_OK) {
         _at.unlock();
         tr_error("Failed to activate network context! (%d)", err);
@@ -64,6 +64,8 @@ public: // CellularNetwork
 
     virtual nsapi_error_t activate_context();
 
+    virtual nsapi_error_t prepare_context();
+
     virtual nsapi_error_t set_registration(const char *plmn = 0);
 
     virtual nsapi_error_t get_network_registering_mode(NWRegisteringMode& mode);
@@ -184,6 +186,7 @@ protected:
     nsapi_connection_status_t _connect_status;
     bool _new_context_set;
     bool _is_context_active;
+    bool _is_context_prepared;
     RegistrationStatus _reg_status;
     RadioAccessTechnology _current_act;
     mbed::Callback<void()> _urc_funcs[C_MAX];
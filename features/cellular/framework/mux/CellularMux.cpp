@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2018, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include "CellularMux.h"
+#include "mbed_poll.h"
+#include "Kernel.h"
+
+using namespace mbed;
+using namespace events;
+
+#include "CellularLog.h"
+
+// basic option framing of TS 27.010, chapter 5.2
+const uint8_t MUX_FLAG = 0xF9;
+const uint8_t MUX_EA = 0x01;
+const uint8_t MUX_CR = 0x02;
+const uint8_t MUX_PF = 0x10;
+const uint8_t MUX_CONTROL_SABM = 0x2F;
+const uint8_t MUX_CONTROL_UA = 0x63;
+const uint8_t MUX_CONTROL_DM = 0x0F;
+const uint8_t MUX_CONTROL_DISC = 0x43;
+const uint8_t MUX_CONTROL_UIH = 0xEF;
+
+// acknowledgement timer T1 in milliseconds
+#define MUX_T1_TIMEOUT 300
+// maximum number of retransmissions N2
+#define MUX_RETRY_COUNT 3
+// timeout for writing one frame to the serial channel in milliseconds
+#define MUX_WRITE_TIMEOUT 1000
+
+CellularMux::CellularMux(FileHandle *fh, EventQueue &queue) :
+    _fh(fh),
+    _queue(queue),
+    _connected(false),
+    _response_dlci(0),
+    _response_control(0),
+    _response_received(false),
+    _frame_state(FrameSearchFlag),
+    _frame_header_len(0),
+    _frame_dlci(0),
+    _frame_control(0),
+    _frame_length(0),
+    _frame_pos(0)
+{
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT; i++) {
+        _channels[i]._mux = this;
+        _channels[i]._dlci = i + 1;
+    }
+}
+
+CellularMux::~CellularMux()
+{
+    disconnect();
+}
+
+nsapi_error_t CellularMux::connect()
+{
+    if (_connected) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _fh->set_blocking(false);
+    _fh->sigio(mbed::Callback<void()>(this, &CellularMux::event));
+
+    nsapi_error_t err = control_transaction(0, MUX_CONTROL_SABM);
+    if (err == NSAPI_ERROR_OK) {
+        _connected = true;
+    }
+    return err;
+}
+
+nsapi_error_t CellularMux::disconnect()
+{
+    if (!_connected) {
+        return NSAPI_ERROR_OK;
+    }
+
+    for (int i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT; i++) {
+        if (_channels[i]._open) {
+            _channels[i].close();
+        }
+    }
+
+    (void)control_transaction(0, MUX_CONTROL_DISC);
+    _connected = false;
+    return NSAPI_ERROR_OK;
+}
+
+FileHandle *CellularMux::open_channel(uint8_t dlci)
+{
+    if (!_connected || dlci < 1 || dlci > MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT) {
+        return NULL;
+    }
+
+    MuxDataService &channel = _channels[dlci - 1];
+    if (channel._open) {
+        return &channel;
+    }
+
+    if (control_transaction(dlci, MUX_CONTROL_SABM) != NSAPI_ERROR_OK) {
+        return NULL;
+    }
+
+    channel._rx_buffer.reset();
+    channel._open = true;
+    return &channel;
+}
+
+void CellularMux::event()
+{
+    _queue.call(this, &CellularMux::process_rx);
+}
+
+void CellularMux::process_rx()
+{
+    _mutex.lock();
+    uint8_t buf[32];
+    ssize_t len;
+    while ((len = _fh->read(buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < len; i++) {
+            deframe_byte(buf[i]);
+        }
+    }
+    _mutex.unlock();
+}
+
+void CellularMux::deframe_byte(uint8_t byte)
+{
+    switch (_frame_state) {
+        case FrameSearchFlag:
+            if (byte == MUX_FLAG) {
+                _frame_state = FrameAddress;
+            }
+            break;
+        case FrameAddress:
+            if (byte == MUX_FLAG) {
+                // closing flag of a previous frame or an idle flag, stay in this state
+                break;
+            }
+            _frame_header[0] = byte;
+            _frame_header_len = 1;
+            _frame_dlci = byte >> 2;
+            _frame_state = FrameControl;
+            break;
+        case FrameControl:
+            _frame_header[_frame_header_len++] = byte;
+            _frame_control = byte;
+            _frame_state = FrameLength;
+            break;
+        case FrameLength:
+            _frame_header[_frame_header_len++] = byte;
+            if (_frame_header_len == 3) {
+                _frame_length = byte >> 1;
+                if (!(byte & MUX_EA)) {
+                    break; // second length byte follows
+                }
+            } else {
+                _frame_length |= (size_t)byte << 7;
+            }
+            if (_frame_length > sizeof(_frame_payload)) {
+                tr_error("mux frame too long (%d)", _frame_length);
+                _frame_state = FrameSearchFlag;
+                break;
+            }
+            _frame_pos = 0;
+            _frame_state = _frame_length ? FramePayload : FrameFcs;
+            break;
+        case FramePayload:
+            _frame_payload[_frame_pos++] = byte;
+            if (_frame_pos == _frame_length) {
+                _frame_state = FrameFcs;
+            }
+            break;
+        case FrameFcs:
+            if (byte == fcs(_frame_header, _frame_header_len)) {
+                frame_received();
+            } else {
+                tr_error("mux FCS error on dlci %d", _frame_dlci);
+            }
+            // the closing flag is consumed by the search state
+            _frame_state = FrameSearchFlag;
+            break;
+    }
+}
+
+void CellularMux::frame_received()
+{
+    const uint8_t control = _frame_control & ~MUX_PF;
+
+    if (control == MUX_CONTROL_UA || control == MUX_CONTROL_DM) {
+        _response_dlci = _frame_dlci;
+        _response_control = control;
+        _response_received = true;
+        return;
+    }
+
+    if (control == MUX_CONTROL_UIH) {
+        if (_frame_dlci >= 1 && _frame_dlci <= MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT) {
+            MuxDataService &channel = _channels[_frame_dlci - 1];
+            if (channel._open) {
+                for (size_t i = 0; i < _frame_length; i++) {
+                    if (channel._rx_buffer.full()) {
+                        tr_error("mux rx overflow on dlci %d", _frame_dlci);
+                        break;
+                    }
+                    channel._rx_buffer.push(_frame_payload[i]);
+                }
+                if (channel._sigio_cb) {
+                    channel._sigio_cb();
+                }
+            }
+        }
+        return;
+    }
+
+    if (control == MUX_CONTROL_SABM || control == MUX_CONTROL_DISC) {
+        // channel establishment initiated by the modem is not supported
+        (void)write_frame(_frame_dlci, MUX_CONTROL_DM | MUX_PF, NULL, 0);
+    }
+}
+
+nsapi_error_t CellularMux::control_transaction(uint8_t dlci, uint8_t control)
+{
+    for (int i = 0; i < MUX_RETRY_COUNT; i++) {
+        _mutex.lock();
+        _response_received = false;
+        bool ok = write_frame(dlci, control | MUX_PF, NULL, 0);
+        _mutex.unlock();
+        if (!ok) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+
+        uint8_t response;
+        if (wait_response(dlci, response, MUX_T1_TIMEOUT)) {
+            return (response == MUX_CONTROL_UA) ? NSAPI_ERROR_OK : NSAPI_ERROR_NO_CONNECTION;
+        }
+    }
+
+    return NSAPI_ERROR_TIMEOUT;
+}
+
+bool CellularMux::wait_response(uint8_t dlci, uint8_t &control, uint32_t timeout)
+{
+    const uint64_t start_time = rtos::Kernel::get_ms_count();
+
+    while (rtos::Kernel::get_ms_count() - start_time < timeout) {
+        _mutex.lock();
+        if (_response_received && _response_dlci == dlci) {
+            control = _response_control;
+            _response_received = false;
+            _mutex.unlock();
+            return true;
+        }
+        _mutex.unlock();
+
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+        if (poll(&fhs, 1, 10) > 0 && (fhs.revents & POLLIN)) {
+            process_rx();
+        }
+    }
+
+    return false;
+}
+
+bool CellularMux::write_frame(uint8_t dlci, uint8_t control, const uint8_t *payload, size_t len)
+{
+    uint8_t header[5];
+    size_t header_len;
+
+    header[0] = MUX_FLAG;
+    // as the initiator our command frames carry the C/R bit set
+    header[1] = MUX_EA | MUX_CR | (dlci << 2);
+    header[2] = control;
+    if (len > 0x7F) {
+        header[3] = (len & 0x7F) << 1;
+        header[4] = len >> 7;
+        header_len = 5;
+    } else {
+        header[3] = MUX_EA | (len << 1);
+        header_len = 4;
+    }
+
+    uint8_t trailer[2];
+    trailer[0] = fcs(&header[1], header_len - 1);
+    trailer[1] = MUX_FLAG;
+
+    if (!write_all(header, header_len)) {
+        return false;
+    }
+    if (len && !write_all(payload, len)) {
+        return false;
+    }
+    return write_all(trailer, 2);
+}
+
+bool CellularMux::write_all(const uint8_t *data, size_t len)
+{
+    pollfh fhs;
+    fhs.fh = _fh;
+    fhs.events = POLLOUT;
+
+    const uint64_t start_time = rtos::Kernel::get_ms_count();
+    size_t write_len = 0;
+    while (write_len < len) {
+        uint64_t elapsed = rtos::Kernel::get_ms_count() - start_time;
+        if (elapsed >= MUX_WRITE_TIMEOUT) {
+            return false;
+        }
+        int count = poll(&fhs, 1, MUX_WRITE_TIMEOUT - elapsed);
+        if (count <= 0 || !(fhs.revents & POLLOUT)) {
+            return false;
+        }
+        ssize_t ret = _fh->write(data + write_len, len - write_len);
+        if (ret < 0) {
+            return false;
+        }
+        write_len += (size_t)ret;
+    }
+
+    return true;
+}
+
+ssize_t CellularMux::channel_write(uint8_t dlci, const void *buffer, size_t size)
+{
+    const uint8_t *buf = static_cast<const uint8_t *>(buffer);
+    size_t written = 0;
+
+    while (written < size) {
+        size_t frame_len = size - written;
+        if (frame_len > MBED_CONF_CELLULAR_MUX_FRAME_SIZE) {
+            frame_len = MBED_CONF_CELLULAR_MUX_FRAME_SIZE;
+        }
+        // one frame at a time under the lock so that frames of the other channels can interleave
+        _mutex.lock();
+        bool ok = write_frame(dlci, MUX_CONTROL_UIH, buf + written, frame_len);
+        _mutex.unlock();
+        if (!ok) {
+            return written ? (ssize_t)written : -EIO;
+        }
+        written += frame_len;
+    }
+
+    return written;
+}
+
+int CellularMux::close_channel(uint8_t dlci)
+{
+    (void)control_transaction(dlci, MUX_CONTROL_DISC);
+    return 0;
+}
+
+uint8_t CellularMux::fcs(const uint8_t *data, size_t len)
+{
+    // reflected 8-bit CRC of TS 27.010, annex B
+    uint8_t fcs = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        fcs ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            if (fcs & 0x01) {
+                fcs = (fcs >> 1) ^ 0xE0;
+            } else {
+                fcs = fcs >> 1;
+            }
+        }
+    }
+    return 0xFF - fcs;
+}
+
+CellularMux::MuxDataService::MuxDataService() :
+    _mux(NULL),
+    _dlci(0),
+    _open(false)
+{
+}
+
+ssize_t CellularMux::MuxDataService::read(void *buffer, size_t size)
+{
+    if (!_open) {
+        return -EIO;
+    }
+
+    uint8_t *buf = static_cast<uint8_t *>(buffer);
+    size_t read_len = 0;
+    uint8_t c;
+    while (read_len < size && _rx_buffer.pop(c)) {
+        buf[read_len++] = c;
+    }
+
+    if (read_len == 0) {
+        return -EAGAIN;
+    }
+    return read_len;
+}
+
+ssize_t CellularMux::MuxDataService::write(const void *buffer, size_t size)
+{
+    if (!_open) {
+        return -EIO;
+    }
+    return _mux->channel_write(_dlci, buffer, size);
+}
+
+off_t CellularMux::MuxDataService::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int CellularMux::MuxDataService::close()
+{
+    if (!_open) {
+        return 0;
+    }
+    _open = false;
+    return _mux->close_channel(_dlci);
+}
+
+short CellularMux::MuxDataService::poll(short events) const
+{
+    short revents = 0;
+    if ((events & POLLIN) && !_rx_buffer.empty()) {
+        revents |= POLLIN;
+    }
+    if (events & POLLOUT) {
+        revents |= POLLOUT;
+    }
+    return revents;
+}
+
+void CellularMux::MuxDataService::sigio(Callback<void()> func)
+{
+    _sigio_cb = func;
+    if (_sigio_cb && !_rx_buffer.empty()) {
+        _sigio_cb();
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2018, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_MUX_H_
+#define CELLULAR_MUX_H_
+
+#include "platform/mbed_retarget.h"
+
+#include "FileHandle.h"
+#include "EventQueue.h"
+#include "PlatformMutex.h"
+#include "CircularBuffer.h"
+#include "Callback.h"
+#include "nsapi_types.h"
+
+namespace mbed {
+
+/** Number of user channels (DLCI 1..N) available on the multiplexer. */
+#ifndef MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT
+#define MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT 3
+#endif
+
+/** Maximum information field size (N1) of a multiplexer frame. Must match the frame size
+ *  given to the modem in AT+CMUX. */
+#ifndef MBED_CONF_CELLULAR_MUX_FRAME_SIZE
+#define MBED_CONF_CELLULAR_MUX_FRAME_SIZE 64
+#endif
+
+/** Receive buffer size per multiplexer channel. */
+#ifndef MBED_CONF_CELLULAR_MUX_RX_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_MUX_RX_BUFFER_SIZE 256
+#endif
+
+/** Class CellularMux
+ *
+ *  3GPP TS 27.010 basic option multiplexer. Runs virtual channels over a single serial
+ *  file handle (for example UARTSerial) so that AT control, socket data and for example
+ *  GNSS NMEA output can interleave on one modem UART. Data written to a channel is framed
+ *  one frame at a time, so a long transfer on one channel delays the others by at most
+ *  one frame.
+ *
+ *  The modem must be switched to multiplexed mode first with CellularMultiplexer::multiplexer_mode_start().
+ *  After that the original file handle must only be used through this class.
+ */
+class CellularMux {
+
+public:
+    /** Constructor
+     *
+     *  @param fh    file handle of the serial channel to the modem, for example UARTSerial
+     *  @param queue event queue used to transfer sigio events to this thread
+     */
+    CellularMux(FileHandle *fh, events::EventQueue &queue);
+    ~CellularMux();
+
+    /** Establishes the multiplexer control channel (DLCI 0).
+     *
+     *  The modem must already be in multiplexed mode when this is called.
+     *
+     *  @return NSAPI_ERROR_OK on success
+     *          NSAPI_ERROR_NO_CONNECTION if the modem rejected the channel
+     *          NSAPI_ERROR_TIMEOUT if the modem did not answer
+     *          NSAPI_ERROR_DEVICE_ERROR on failure when writing
+     */
+    nsapi_error_t connect();
+
+    /** Closes the open user channels and the control channel.
+     *
+     *  @return NSAPI_ERROR_OK on success
+     */
+    nsapi_error_t disconnect();
+
+    /** Opens a user channel.
+     *
+     *  @param dlci channel number, 1..MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT
+     *  @return file handle of the virtual channel, or NULL on failure. The returned
+     *          file handle is owned by this class and is closed with FileHandle::close().
+     */
+    FileHandle *open_channel(uint8_t dlci);
+
+private:
+
+    /** One virtual channel of the multiplexer. Used through the FileHandle interface only. */
+    class MuxDataService : public FileHandle {
+    public:
+        MuxDataService();
+
+        virtual ssize_t read(void *buffer, size_t size);
+        virtual ssize_t write(const void *buffer, size_t size);
+        virtual off_t seek(off_t offset, int whence = SEEK_SET);
+        virtual int close();
+        virtual short poll(short events) const;
+        virtual void sigio(Callback<void()> func);
+
+    private:
+        friend class CellularMux;
+
+        CellularMux *_mux;
+        uint8_t _dlci;
+        bool _open;
+        CircularBuffer<uint8_t, MBED_CONF_CELLULAR_MUX_RX_BUFFER_SIZE, uint16_t> _rx_buffer;
+        Callback<void()> _sigio_cb;
+    };
+
+    // states of the receiving frame decoder
+    enum FrameState {
+        FrameSearchFlag,
+        FrameAddress,
+        FrameControl,
+        FrameLength,
+        FramePayload,
+        FrameFcs
+    };
+
+    // sigio from the file handle, posts process_rx to the event queue
+    void event();
+    // reads from the file handle and feeds the frame decoder
+    void process_rx();
+    // runs the frame decoder for one received byte
+    void deframe_byte(uint8_t byte);
+    // dispatches a complete frame with a valid checksum
+    void frame_received();
+    // sends a command frame and waits for the modem to answer with UA or DM, retrying on timeout
+    nsapi_error_t control_transaction(uint8_t dlci, uint8_t control);
+    // reads frames until a response for the given channel arrives or the timeout expires
+    bool wait_response(uint8_t dlci, uint8_t &control, uint32_t timeout);
+    // frames and writes one frame, true on success
+    bool write_frame(uint8_t dlci, uint8_t control, const uint8_t *payload, size_t len);
+    // writes until all is written or the write timeout expires, true on success
+    bool write_all(const uint8_t *data, size_t len);
+    // writes channel data as a sequence of frames, called from MuxDataService
+    ssize_t channel_write(uint8_t dlci, const void *buffer, size_t size);
+    // sends DISC on a channel, called from MuxDataService
+    int close_channel(uint8_t dlci);
+    // frame check sequence of TS 27.010
+    static uint8_t fcs(const uint8_t *data, size_t len);
+
+    FileHandle *_fh;
+    events::EventQueue &_queue;
+    // serializes writing of frames and running of the frame decoder
+    PlatformMutex _mutex;
+
+    MuxDataService _channels[MBED_CONF_CELLULAR_MUX_CHANNEL_COUNT];
+    bool _connected;
+
+    // last received UA/DM response, consumed by wait_response
+    uint8_t _response_dlci;
+    uint8_t _response_control;
+    bool _response_received;
+
+    // receiving frame decoder state
+    FrameState _frame_state;
+    uint8_t _frame_header[4];
+    size_t _frame_header_len;
+    uint8_t _frame_dlci;
+    uint8_t _frame_control;
+    size_t _frame_length;
+    size_t _frame_pos;
+    uint8_t _frame_payload[MBED_CONF_CELLULAR_MUX_FRAME_SIZE];
+};
+
+} // namespace mbed
+
+#endif // CELLULAR_MUX_H_
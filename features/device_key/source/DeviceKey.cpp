@@ -21,6 +21,7 @@
 #include "trng_api.h"
 #include "mbed_wait_api.h"
 #include "stdlib.h"
+#include "string.h"
 
 #if !defined(MBEDTLS_CMAC_C)
 #error [NOT_SUPPORTED] MBEDTLS_CMAC_C needs to be enabled for this driver
@@ -48,11 +49,21 @@ namespace mbed {
 
 DeviceKey::DeviceKey()
 {
+    memset(_derived_key_cache, 0, sizeof(_derived_key_cache));
+    _cache_next = 0;
+    _rot_size = 0;
+    _rot_cached = false;
+    _cmac_ctx_ready = false;
     return;
 }
 
 DeviceKey::~DeviceKey()
 {
+    if (_cmac_ctx_ready) {
+        mbedtls_cipher_free(&_cmac_ctx);
+    }
+    memset(_derived_key_cache, 0, sizeof(_derived_key_cache));
+    memset(_rot_key, 0, sizeof(_rot_key));
     return;
 }
 
@@ -66,30 +77,59 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
         return DEVICEKEY_INVALID_KEY_TYPE;
     }
 
-    //First try to read the key from NVStore
-    int ret = read_key_from_nvstore(key_buff, actual_size);
-    if (DEVICEKEY_SUCCESS != ret && DEVICEKEY_NOT_FOUND != ret) {
-        return ret;
-    }
+    _mutex.lock();
 
-    if (DEVICE_KEY_16BYTE != actual_size && DEVICE_KEY_32BYTE != actual_size) {
-        return DEVICEKEY_READ_FAILED;
+    //Steady state: the same salt was derived before and the key is still cached
+    if (derived_key_cache_get(salt, isalt_size, output, ikey_type)) {
+        _mutex.unlock();
+        return DEVICEKEY_SUCCESS;
     }
 
-    //If the key was not found in NVStore we will create it by using TRNG and then save it to NVStore
-    if (DEVICEKEY_NOT_FOUND == ret) {
-        ret = generate_key_by_trng(key_buff, actual_size);
-        if (DEVICEKEY_SUCCESS != ret) {
+    int ret = DEVICEKEY_SUCCESS;
+    if (_rot_cached) {
+        memcpy(key_buff, _rot_key, _rot_size);
+        actual_size = _rot_size;
+    } else {
+        //First try to read the key from NVStore
+        ret = read_key_from_nvstore(key_buff, actual_size);
+        if (DEVICEKEY_SUCCESS != ret && DEVICEKEY_NOT_FOUND != ret) {
+            _mutex.unlock();
             return ret;
         }
 
-        ret = device_inject_root_of_trust(key_buff, actual_size);
-        if (DEVICEKEY_SUCCESS != ret) {
-            return ret;
+        if (DEVICE_KEY_16BYTE != actual_size && DEVICE_KEY_32BYTE != actual_size) {
+            _mutex.unlock();
+            return DEVICEKEY_READ_FAILED;
         }
+
+        //If the key was not found in NVStore we will create it by using TRNG and then save it to NVStore
+        if (DEVICEKEY_NOT_FOUND == ret) {
+            ret = generate_key_by_trng(key_buff, actual_size);
+            if (DEVICEKEY_SUCCESS != ret) {
+                _mutex.unlock();
+                return ret;
+            }
+
+            ret = device_inject_root_of_trust(key_buff, actual_size);
+            if (DEVICEKEY_SUCCESS != ret) {
+                _mutex.unlock();
+                return ret;
+            }
+        }
+
+        //The root of trust can not change once injected, so keep it in RAM
+        //and spare every later derivation the NVStore lookup
+        memcpy(_rot_key, key_buff, actual_size);
+        _rot_size = actual_size;
+        _rot_cached = true;
     }
 
     ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+    if (DEVICEKEY_SUCCESS == ret) {
+        derived_key_cache_put(salt, isalt_size, output, ikey_type);
+    }
+
+    _mutex.unlock();
     return ret;
 }
 
@@ -159,77 +199,123 @@ int DeviceKey::get_derived_key(uint32_t *ikey_buff, size_t ikey_size, const unsi
 {
     //KDF in counter mode implementation as described in Section 5.1
     //of NIST SP 800-108, Recommendation for Key Derivation Using Pseudorandom Functions
-    int ret;
+    int ret = DEVICEKEY_SUCCESS;
     size_t counter = 0;
     char separator = 0x00;
-    mbedtls_cipher_context_t ctx;
     unsigned char output_len_enc[ 4 ] = {0};
     unsigned char counter_enc[ 1 ] = {0};
 
     DEVKEY_WRITE_UINT32_LE(output_len_enc, ikey_type);
 
-    mbedtls_cipher_type_t mbedtls_cipher_type = MBEDTLS_CIPHER_AES_128_ECB;
-    if (DEVICE_KEY_32BYTE == ikey_size) {
-        mbedtls_cipher_type = MBEDTLS_CIPHER_AES_256_ECB;
-    }
+    //Setting the key up runs the AES key schedule, which dominates a single
+    //derivation. The root of trust never changes at runtime, so the CMAC
+    //context is kept keyed across calls and only reset between derivations.
+    if (!_cmac_ctx_ready) {
+        mbedtls_cipher_type_t mbedtls_cipher_type = MBEDTLS_CIPHER_AES_128_ECB;
+        if (DEVICE_KEY_32BYTE == ikey_size) {
+            mbedtls_cipher_type = MBEDTLS_CIPHER_AES_256_ECB;
+        }
 
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(mbedtls_cipher_type);
+        const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(mbedtls_cipher_type);
 
-    do {
+        mbedtls_cipher_init(&_cmac_ctx);
+        ret = mbedtls_cipher_setup(&_cmac_ctx, cipher_info);
+        if (ret != 0) {
+            goto finish;
+        }
 
-    	mbedtls_cipher_init(&ctx);
-    	ret = mbedtls_cipher_setup(&ctx, cipher_info);
-    	if (ret != 0) {
-    	    goto finish;
-    	}
+        ret = mbedtls_cipher_cmac_starts(&_cmac_ctx, (unsigned char *)ikey_buff, ikey_size * 8);
+        if (ret != 0) {
+            goto finish;
+        }
+
+        _cmac_ctx_ready = true;
+    }
+
+    do {
 
-        ret = mbedtls_cipher_cmac_starts(&ctx, (unsigned char *)ikey_buff, ikey_size * 8);
+        ret = mbedtls_cipher_cmac_reset(&_cmac_ctx);
         if (ret != 0) {
             goto finish;
         }
 
         DEVKEY_WRITE_UINT8_LE(counter_enc, (counter+1));
 
-        ret = mbedtls_cipher_cmac_update(&ctx, (unsigned char *)counter_enc, sizeof(counter_enc));
+        ret = mbedtls_cipher_cmac_update(&_cmac_ctx, (unsigned char *)counter_enc, sizeof(counter_enc));
         if (ret != 0) {
             goto finish;
         }
 
-        ret = mbedtls_cipher_cmac_update(&ctx, isalt, isalt_size);
+        ret = mbedtls_cipher_cmac_update(&_cmac_ctx, isalt, isalt_size);
         if (ret != 0) {
             goto finish;
         }
 
-        ret = mbedtls_cipher_cmac_update(&ctx, (unsigned char *)&separator, sizeof(char));
+        ret = mbedtls_cipher_cmac_update(&_cmac_ctx, (unsigned char *)&separator, sizeof(char));
         if (ret != 0) {
             goto finish;
         }
 
-        ret = mbedtls_cipher_cmac_update(&ctx, (unsigned char *)&output_len_enc, sizeof(output_len_enc));
+        ret = mbedtls_cipher_cmac_update(&_cmac_ctx, (unsigned char *)&output_len_enc, sizeof(output_len_enc));
         if (ret != 0) {
             goto finish;
         }
 
-        ret = mbedtls_cipher_cmac_finish(&ctx, output + (DEVICE_KEY_16BYTE * (counter)));
+        ret = mbedtls_cipher_cmac_finish(&_cmac_ctx, output + (DEVICE_KEY_16BYTE * (counter)));
         if (ret != 0) {
             goto finish;
         }
 
-        mbedtls_cipher_free( &ctx );
-
         counter++;
 
     } while (DEVICE_KEY_16BYTE * counter < ikey_type);
 
 finish:
     if (DEVICEKEY_SUCCESS != ret) {
-    	mbedtls_cipher_free( &ctx );
+    	mbedtls_cipher_free( &_cmac_ctx );
+        _cmac_ctx_ready = false;
         return DEVICEKEY_ERR_CMAC_GENERIC_FAILURE;
     }
 
     return DEVICEKEY_SUCCESS;
 }
 
+bool DeviceKey::derived_key_cache_get(const unsigned char *isalt, size_t isalt_size,
+                                      unsigned char *output, uint16_t ikey_type)
+{
+    if (isalt_size > DEVICE_KEY_CACHE_MAX_SALT_SIZE) {
+        return false;
+    }
+
+    for (int i = 0; i < DEVICE_KEY_CACHE_ENTRIES; i++) {
+        derived_key_cache_entry_t *entry = &_derived_key_cache[i];
+        if (entry->valid && entry->key_type == ikey_type && entry->salt_size == isalt_size
+                && 0 == memcmp(entry->salt, isalt, isalt_size)) {
+            memcpy(output, entry->key, ikey_type);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DeviceKey::derived_key_cache_put(const unsigned char *isalt, size_t isalt_size,
+                                      const unsigned char *output, uint16_t ikey_type)
+{
+    if (isalt_size > DEVICE_KEY_CACHE_MAX_SALT_SIZE) {
+        return;
+    }
+
+    derived_key_cache_entry_t *entry = &_derived_key_cache[_cache_next];
+    _cache_next = (_cache_next + 1) % DEVICE_KEY_CACHE_ENTRIES;
+
+    memcpy(entry->salt, isalt, isalt_size);
+    entry->salt_size = isalt_size;
+    entry->key_type = ikey_type;
+    memcpy(entry->key, output, ikey_type);
+    entry->valid = true;
+}
+
 int DeviceKey::generate_key_by_trng(uint32_t *output, size_t size)
 {
 #if defined(DEVICE_TRNG)
@@ -19,6 +19,8 @@
 #include "stddef.h"
 #include "stdint.h"
 #include "platform/NonCopyable.h"
+#include "PlatformMutex.h"
+#include "mbedtls/cmac.h"
 
 #if (NVSTORE_ENABLED) || defined(DOXYGEN_ONLY)
 
@@ -28,6 +30,12 @@ namespace mbed {
 #define DEVICE_KEY_16BYTE 16
 #define DEVICE_KEY_32BYTE 32
 
+/** Number of derived keys kept in the RAM cache */
+#define DEVICE_KEY_CACHE_ENTRIES 4
+
+/** Longest salt eligible for the derived key cache, in bytes */
+#define DEVICE_KEY_CACHE_MAX_SALT_SIZE 32
+
 enum DeviceKeyStatus {
     DEVICEKEY_SUCCESS                     =  0,
     DEVICEKEY_INVALID_KEY_SIZE            = -1,
@@ -91,6 +99,23 @@ public:
     int device_inject_root_of_trust(uint32_t *value, size_t isize);
 
 private:
+    typedef struct {
+        unsigned char salt[DEVICE_KEY_CACHE_MAX_SALT_SIZE];
+        size_t salt_size;
+        uint16_t key_type;
+        bool valid;
+        unsigned char key[DEVICE_KEY_32BYTE];
+    } derived_key_cache_entry_t;
+
+    PlatformMutex _mutex;
+    derived_key_cache_entry_t _derived_key_cache[DEVICE_KEY_CACHE_ENTRIES];
+    uint32_t _cache_next;
+    uint32_t _rot_key[DEVICE_KEY_32BYTE / sizeof(uint32_t)];
+    size_t _rot_size;
+    bool _rot_cached;
+    mbedtls_cipher_context_t _cmac_ctx;
+    bool _cmac_ctx_ready;
+
     // Private constructor, as class is a singleton
     DeviceKey();
 
@@ -133,6 +158,26 @@ private:
      */
     int generate_key_by_trng(uint32_t *output, size_t size);
 
+    /** Look a previously derived key up in the RAM cache
+     * @param isalt input buffer used to create the key
+     * @param isalt_size size of the data in the salt buffer
+     * @param output buffer to receive the cached key on a hit
+     * @param ikey_type the requested key size. Must be 16 bytes or 32 bytes.
+     * @return true on a cache hit, false otherwise
+     */
+    bool derived_key_cache_get(const unsigned char *isalt, size_t isalt_size,
+                               unsigned char *output, uint16_t ikey_type);
+
+    /** Remember a freshly derived key, evicting the oldest entry when full.
+     *  Salts longer than DEVICE_KEY_CACHE_MAX_SALT_SIZE are not cached.
+     * @param isalt input buffer used to create the key
+     * @param isalt_size size of the data in the salt buffer
+     * @param output buffer holding the derived key
+     * @param ikey_type the size of the derived key. Must be 16 bytes or 32 bytes.
+     */
+    void derived_key_cache_put(const unsigned char *isalt, size_t isalt_size,
+                               const unsigned char *output, uint16_t ikey_type);
+
 };
 /** @}*/
 
@@ -69,6 +69,13 @@ ssize_t Dir::read(struct dirent *ent)
     return _fs->dir_read(_dir, ent);
 }
 
+ssize_t Dir::read(struct dirent *ents, size_t count)
+{
+    MBED_ASSERT(_fs);
+    memset(ents, 0, count * sizeof(struct dirent));
+    return _fs->dir_read(_dir, ents, count);
+}
+
 void Dir::seek(off_t offset)
 {
     MBED_ASSERT(_fs);
@@ -69,6 +69,18 @@ public:
      */
     virtual ssize_t read(struct dirent *ent);
 
+    /** Read up to count directory entries in one call
+     *
+     *  The entries are fetched in a single batch, taking the filesystem
+     *  lock once instead of once per entry.
+     *
+     *  @param ents     Array of directory entries to fill out
+     *  @param count    Number of entries the array has room for
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t read(struct dirent *ents, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param offset   Offset of the location to seek to,
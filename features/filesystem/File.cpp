@@ -110,3 +110,39 @@ off_t File::size()
     return _fs->file_size(_file);
 }
 
+ssize_t File::pread(void *buffer, size_t size, off_t offset)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_pread(_file, buffer, size, offset);
+}
+
+ssize_t File::write_direct(const void *buffer, size_t size)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_write_direct(_file, buffer, size);
+}
+
+ssize_t File::pwrite(const void *buffer, size_t size, off_t offset)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_pwrite(_file, buffer, size, offset);
+}
+
+int File::preallocate(off_t size)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_preallocate(_file, size);
+}
+
+int File::contiguous(bool *contiguous)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_contiguous(_file, contiguous);
+}
+
+int File::get_mapping(const void **addr)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_get_mapping(_file, addr);
+}
+
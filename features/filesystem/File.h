@@ -126,6 +126,81 @@ public:
      */
     virtual off_t size();
 
+    /** Read from the file at a given offset, without moving the file position
+     *
+     *  Performed atomically under the filesystem lock where the filesystem
+     *  supports it, so concurrent readers can share one file without
+     *  racing on the file position.
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The offset in the file to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t pread(void *buffer, size_t size, off_t offset);
+
+    /** Write to the file at a given offset, without moving the file position
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The offset in the file to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t pwrite(const void *buffer, size_t size, off_t offset);
+
+    /** Write whole sectors to a file without intermediate buffering
+     *
+     *  The data goes from the caller's buffer straight to the block
+     *  device, bypassing the filesystem's sector cache. Both the current
+     *  file position and the size must be multiples of the filesystem's
+     *  sector size - anything else would silently fall back to the
+     *  buffered path, so it is rejected with -EINVAL instead.
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write, a multiple of the
+     *                  sector size
+     *  @return         The number of bytes written, negative error on failure,
+     *                  -ENOSYS if the filesystem has no direct path
+     */
+    virtual ssize_t write_direct(const void *buffer, size_t size);
+
+    /** Preallocate storage for the file
+     *
+     *  Reserves storage up front so subsequent appends do not need to
+     *  allocate, and allocates it as one contiguous run on filesystems
+     *  that can. The file size becomes at least the preallocated size;
+     *  the contents of the extended region are undefined until written.
+     *
+     *  @param size     Size to preallocate in bytes
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the filesystem cannot preallocate
+     */
+    virtual int preallocate(off_t size);
+
+    /** Check whether the file occupies one contiguous run of storage
+     *
+     *  @param contiguous Set to true if the file is stored contiguously
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the filesystem cannot tell
+     */
+    virtual int contiguous(bool *contiguous);
+
+    /** Get a pointer for reading the file's contents in place
+     *
+     *  Only possible when the file is stored as one contiguous run on
+     *  storage that is directly addressable, such as internal flash,
+     *  letting read-only assets be accessed without copying them through
+     *  the block layer. The mapping is read-only and remains valid while
+     *  the file is open and the filesystem mounted; writing to the
+     *  filesystem may move or rewrite the storage underneath it.
+     *
+     *  @param addr     Destination for the pointer to the file's contents
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the storage is not directly addressable,
+     *                  -EINVAL if the file is not stored contiguously
+     */
+    virtual int get_mapping(const void **addr);
+
 private:
     FileSystem *_fs;
     fs_file_t _file;
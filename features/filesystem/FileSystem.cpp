@@ -84,6 +84,56 @@ off_t FileSystem::file_size(fs_file_t file)
     return size;
 }
 
+ssize_t FileSystem::file_pread(fs_file_t file, void *buffer, size_t size, off_t offset)
+{
+    off_t off = file_tell(file);
+    if (off < 0) {
+        return off;
+    }
+    off_t err = file_seek(file, offset, SEEK_SET);
+    if (err < 0) {
+        return err;
+    }
+    ssize_t res = file_read(file, buffer, size);
+    file_seek(file, off, SEEK_SET);
+    return res;
+}
+
+ssize_t FileSystem::file_pwrite(fs_file_t file, const void *buffer, size_t size, off_t offset)
+{
+    off_t off = file_tell(file);
+    if (off < 0) {
+        return off;
+    }
+    off_t err = file_seek(file, offset, SEEK_SET);
+    if (err < 0) {
+        return err;
+    }
+    ssize_t res = file_write(file, buffer, size);
+    file_seek(file, off, SEEK_SET);
+    return res;
+}
+
+ssize_t FileSystem::file_write_direct(fs_file_t file, const void *buffer, size_t size)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_preallocate(fs_file_t file, off_t size)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_contiguous(fs_file_t file, bool *contiguous)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_get_mapping(fs_file_t file, const void **addr)
+{
+    return -ENOSYS;
+}
+
 int FileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
     return -ENOSYS;
@@ -99,6 +149,21 @@ ssize_t FileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::dir_read(fs_dir_t dir, struct dirent *ents, size_t count)
+{
+    size_t n = 0;
+    while (n < count) {
+        ssize_t res = dir_read(dir, &ents[n]);
+        if (res < 0) {
+            return res;
+        } else if (res == 0) {
+            break;
+        }
+        n++;
+    }
+    return n;
+}
+
 void FileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
 }
@@ -204,6 +204,92 @@ protected:
      */
     virtual off_t file_size(fs_file_t file);
 
+    /** Read from a file at a given offset, without moving the file position
+     *
+     *  The default implementation emulates the positioned read with
+     *  file_seek, so it is not atomic against concurrent users of the same
+     *  file; filesystems override it to read at the given offset under
+     *  their own lock, letting concurrent readers share one handle without
+     *  racing on the file position.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The offset in the file to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_pread(fs_file_t file, void *buffer, size_t size, off_t offset);
+
+    /** Write to a file at a given offset, without moving the file position
+     *
+     *  The default implementation emulates the positioned write with
+     *  file_seek, with the same caveats as the default file_pread.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The offset in the file to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_pwrite(fs_file_t file, const void *buffer, size_t size, off_t offset);
+
+    /** Write whole sectors to a file without intermediate buffering
+     *
+     *  Writes from the caller's buffer straight to the block device,
+     *  bypassing the filesystem's sector cache. Implementations must
+     *  reject requests that cannot take the direct path rather than
+     *  silently falling back to the buffered one.
+     *
+     *  @param file     File handle, positioned on a sector boundary
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write, a multiple of the
+     *                  sector size
+     *  @return         The number of bytes written, negative error on failure,
+     *                  -EINVAL if position or size are misaligned,
+     *                  -ENOSYS if the filesystem has no direct path
+     */
+    virtual ssize_t file_write_direct(fs_file_t file, const void *buffer, size_t size);
+
+    /** Preallocate storage for a file
+     *
+     *  Reserves storage up front so subsequent appends do not need to
+     *  allocate, and allocates it as one contiguous run on filesystems
+     *  that can, letting sustained writes run at media speed without
+     *  fragmenting. The file size becomes at least the preallocated size;
+     *  the contents of the extended region are undefined until written.
+     *
+     *  @param file     File handle, must be open for writing
+     *  @param size     Size to preallocate in bytes
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the filesystem cannot preallocate
+     */
+    virtual int file_preallocate(fs_file_t file, off_t size);
+
+    /** Check whether a file occupies one contiguous run of storage
+     *
+     *  @param file     File handle
+     *  @param contiguous Set to true if the file is stored contiguously
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the filesystem cannot tell
+     */
+    virtual int file_contiguous(fs_file_t file, bool *contiguous);
+
+    /** Get a pointer for reading the file's contents in place
+     *
+     *  Only possible when the file is stored as one contiguous run on
+     *  storage that is directly addressable, such as internal flash. The
+     *  mapping is read-only and remains valid while the file is open and
+     *  the filesystem mounted; writing to the filesystem may move or
+     *  rewrite the storage underneath it.
+     *
+     *  @param file     File handle
+     *  @param addr     Destination for the pointer to the file's contents
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the storage is not directly addressable,
+     *                  -EINVAL if the file is not stored contiguously
+     */
+    virtual int file_get_mapping(fs_file_t file, const void **addr);
+
     /** Open a directory on the filesystem
      *
      *  @param dir      Destination for the handle to the directory
@@ -227,6 +313,20 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read up to count directory entries in one call
+     *
+     *  The default implementation loops over the single-entry dir_read().
+     *  Filesystems should override this to fetch the whole batch under one
+     *  lock acquisition, reading ahead across directory blocks.
+     *
+     *  @param dir      Dir handle
+     *  @param ents     Array of directory entries to fill out
+     *  @param count    Number of entries the array has room for
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ents, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle
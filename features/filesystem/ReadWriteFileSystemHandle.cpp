@@ -0,0 +1,322 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReadWriteFileSystemHandle.h"
+#include "mbed.h"
+
+
+namespace mbed {
+
+// File handle that takes its owner's reader or writer lock around each
+// operation, and manages its own memory on close
+class ReadWriteFileHandle : public FileHandle {
+public:
+    ReadWriteFileHandle(ReadWriteFileSystemHandle *owner, FileHandle *file, bool writable)
+        : _owner(owner), _file(file), _writable(writable)
+    {
+    }
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        _owner->read_lock();
+        ssize_t res = _file->read(buffer, size);
+        _owner->read_unlock();
+        return res;
+    }
+
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        _owner->write_lock();
+        ssize_t res = _file->write(buffer, size);
+        _owner->write_unlock();
+        return res;
+    }
+
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        _owner->read_lock();
+        off_t res = _file->seek(offset, whence);
+        _owner->read_unlock();
+        return res;
+    }
+
+    virtual int close()
+    {
+        int err;
+        if (_writable) {
+            // closing may flush deferred writes
+            _owner->write_lock();
+            err = _file->close();
+            _owner->write_unlock();
+        } else {
+            _owner->read_lock();
+            err = _file->close();
+            _owner->read_unlock();
+        }
+        delete this;
+        return err;
+    }
+
+    virtual int sync()
+    {
+        _owner->write_lock();
+        int err = _file->sync();
+        _owner->write_unlock();
+        return err;
+    }
+
+    virtual int isatty()
+    {
+        return _file->isatty();
+    }
+
+    virtual off_t tell()
+    {
+        _owner->read_lock();
+        off_t res = _file->tell();
+        _owner->read_unlock();
+        return res;
+    }
+
+    virtual void rewind()
+    {
+        _owner->read_lock();
+        _file->rewind();
+        _owner->read_unlock();
+    }
+
+    virtual off_t size()
+    {
+        _owner->read_lock();
+        off_t res = _file->size();
+        _owner->read_unlock();
+        return res;
+    }
+
+    virtual int set_blocking(bool blocking)
+    {
+        return _file->set_blocking(blocking);
+    }
+
+    virtual bool is_blocking() const
+    {
+        return _file->is_blocking();
+    }
+
+    virtual short poll(short events) const
+    {
+        return _file->poll(events);
+    }
+
+    virtual void sigio(Callback<void()> func)
+    {
+        _file->sigio(func);
+    }
+
+private:
+    ReadWriteFileSystemHandle *_owner;
+    FileHandle *_file;
+    bool _writable;
+};
+
+// Directory handle that takes its owner's reader lock around each
+// operation, and manages its own memory on close
+class ReadWriteDirHandle : public DirHandle {
+public:
+    ReadWriteDirHandle(ReadWriteFileSystemHandle *owner, DirHandle *dir)
+        : _owner(owner), _dir(dir)
+    {
+    }
+
+    virtual ssize_t read(struct dirent *ent)
+    {
+        _owner->read_lock();
+        ssize_t res = _dir->read(ent);
+        _owner->read_unlock();
+        return res;
+    }
+
+    virtual int close()
+    {
+        _owner->read_lock();
+        int err = _dir->close();
+        _owner->read_unlock();
+        delete this;
+        return err;
+    }
+
+    virtual void seek(off_t offset)
+    {
+        _owner->read_lock();
+        _dir->seek(offset);
+        _owner->read_unlock();
+    }
+
+    virtual off_t tell()
+    {
+        _owner->read_lock();
+        off_t res = _dir->tell();
+        _owner->read_unlock();
+        return res;
+    }
+
+    virtual void rewind()
+    {
+        _owner->read_lock();
+        _dir->rewind();
+        _owner->read_unlock();
+    }
+
+    virtual size_t size()
+    {
+        _owner->read_lock();
+        size_t res = _dir->size();
+        _owner->read_unlock();
+        return res;
+    }
+
+private:
+    ReadWriteFileSystemHandle *_owner;
+    DirHandle *_dir;
+};
+
+
+ReadWriteFileSystemHandle::ReadWriteFileSystemHandle(FileSystemHandle *fs)
+    : _fs(fs), _cond(_mutex), _readers(0), _waiting_writers(0), _writer(false)
+{
+}
+
+void ReadWriteFileSystemHandle::read_lock()
+{
+    _mutex.lock();
+    // queue behind waiting writers so a stream of readers cannot starve
+    // a mutation
+    while (_writer || _waiting_writers) {
+        _cond.wait();
+    }
+    _readers++;
+    _mutex.unlock();
+}
+
+void ReadWriteFileSystemHandle::read_unlock()
+{
+    _mutex.lock();
+    if (--_readers == 0) {
+        _cond.notify_all();
+    }
+    _mutex.unlock();
+}
+
+void ReadWriteFileSystemHandle::write_lock()
+{
+    _mutex.lock();
+    _waiting_writers++;
+    while (_writer || _readers) {
+        _cond.wait();
+    }
+    _waiting_writers--;
+    _writer = true;
+    _mutex.unlock();
+}
+
+void ReadWriteFileSystemHandle::write_unlock()
+{
+    _mutex.lock();
+    _writer = false;
+    _cond.notify_all();
+    _mutex.unlock();
+}
+
+int ReadWriteFileSystemHandle::open(FileHandle **file, const char *path, int flags)
+{
+    bool writable = ((flags & 3) != O_RDONLY) ||
+            (flags & (O_CREAT | O_TRUNC | O_APPEND));
+
+    FileHandle *fh;
+    int err;
+    if (writable) {
+        // the open itself may create or truncate the file
+        write_lock();
+        err = _fs->open(&fh, path, flags);
+        write_unlock();
+    } else {
+        read_lock();
+        err = _fs->open(&fh, path, flags);
+        read_unlock();
+    }
+    if (err) {
+        return err;
+    }
+
+    *file = new ReadWriteFileHandle(this, fh, writable);
+    return 0;
+}
+
+int ReadWriteFileSystemHandle::open(DirHandle **dir, const char *path)
+{
+    DirHandle *dh;
+    read_lock();
+    int err = _fs->open(&dh, path);
+    read_unlock();
+    if (err) {
+        return err;
+    }
+
+    *dir = new ReadWriteDirHandle(this, dh);
+    return 0;
+}
+
+int ReadWriteFileSystemHandle::remove(const char *path)
+{
+    write_lock();
+    int err = _fs->remove(path);
+    write_unlock();
+    return err;
+}
+
+int ReadWriteFileSystemHandle::rename(const char *path, const char *newpath)
+{
+    write_lock();
+    int err = _fs->rename(path, newpath);
+    write_unlock();
+    return err;
+}
+
+int ReadWriteFileSystemHandle::stat(const char *path, struct stat *st)
+{
+    read_lock();
+    int err = _fs->stat(path, st);
+    read_unlock();
+    return err;
+}
+
+int ReadWriteFileSystemHandle::mkdir(const char *path, mode_t mode)
+{
+    write_lock();
+    int err = _fs->mkdir(path, mode);
+    write_unlock();
+    return err;
+}
+
+int ReadWriteFileSystemHandle::statvfs(const char *path, struct statvfs *buf)
+{
+    read_lock();
+    int err = _fs->statvfs(path, buf);
+    read_unlock();
+    return err;
+}
+
+} // namespace mbed
@@ -0,0 +1,131 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_READ_WRITE_FILE_SYSTEM_HANDLE_H
+#define MBED_READ_WRITE_FILE_SYSTEM_HANDLE_H
+
+#include "platform/FileSystemHandle.h"
+#include "rtos/Mutex.h"
+#include "rtos/ConditionVariable.h"
+
+namespace mbed {
+
+/** A FileSystemHandle decorator with reader/writer operation queueing
+ *
+ *  Wraps another filesystem so operations that only read (file reads and
+ *  seeks, directory listing, stat) run concurrently, while operations that
+ *  modify the filesystem (writes, syncs, removes, renames, creating opens)
+ *  run exclusively, queued behind the active readers. This keeps a
+ *  long-running mutation such as a log rotation from holding up short
+ *  reads on filesystems whose cores permit concurrent access; a
+ *  filesystem that serializes internally, such as FATFileSystem within
+ *  one mount, still does so underneath this layer.
+ *
+ *  Writers are given preference - once a writer is waiting, new readers
+ *  queue behind it - so mutations cannot be starved by a steady stream of
+ *  reads.
+ *
+ *  File and directory handles returned by open() are owned by this layer
+ *  and freed by close().
+ */
+class ReadWriteFileSystemHandle : public FileSystemHandle {
+public:
+    /** Lifetime of the decorator
+     *
+     *  @param fs       Filesystem to wrap, must stay valid while any
+     *                  handle opened through this layer is open
+     */
+    ReadWriteFileSystemHandle(FileSystemHandle *fs);
+
+    /** Open a file on the underlying filesystem
+     *
+     *  Opens that may create, truncate or write the file are queued as
+     *  writers; read-only opens run as readers.
+     *
+     *  @param file     Destination for the handle to a newly created file
+     *  @param path     The name of the file to open
+     *  @param flags    The flags to open the file in, one of O_RDONLY, O_WRONLY, O_RDWR,
+     *                  bitwise or'd with one of O_CREAT, O_TRUNC, O_APPEND
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int open(FileHandle **file, const char *path, int flags);
+
+    /** Open a directory on the underlying filesystem
+     *
+     *  @param dir      Destination for the handle to the directory
+     *  @param path     Name of the directory to open
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int open(DirHandle **dir, const char *path);
+
+    /** Remove a file from the filesystem.
+     *
+     *  @param path     The name of the file to remove.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int remove(const char *path);
+
+    /** Rename a file in the filesystem.
+     *
+     *  @param path     The name of the file to rename.
+     *  @param newpath  The name to rename it to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int rename(const char *path, const char *newpath);
+
+    /** Store information about the file in a stat structure
+     *
+     *  @param path     The name of the file to find information about
+     *  @param st       The stat buffer to write to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int stat(const char *path, struct stat *st);
+
+    /** Create a directory in the filesystem.
+     *
+     *  @param path     The name of the directory to create.
+     *  @param mode     The permissions with which to create the directory
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int mkdir(const char *path, mode_t mode);
+
+    /** Store information about the mounted filesystem in a statvfs structure
+     *
+     *  @param path     The name of the file to find information about
+     *  @param buf      The stat buffer to write to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int statvfs(const char *path, struct statvfs *buf);
+
+private:
+    friend class ReadWriteFileHandle;
+    friend class ReadWriteDirHandle;
+
+    void read_lock();
+    void read_unlock();
+    void write_lock();
+    void write_unlock();
+
+    FileSystemHandle *_fs;
+    rtos::Mutex _mutex;
+    rtos::ConditionVariable _cond;
+    uint32_t _readers;
+    uint32_t _waiting_writers;
+    bool _writer;
+};
+
+} // namespace mbed
+
+#endif
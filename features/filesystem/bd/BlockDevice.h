@@ -18,6 +18,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include "Callback.h"
 
 
 /** Enum of standard error codes
@@ -37,6 +38,15 @@ typedef uint64_t bd_addr_t;
  */
 typedef uint64_t bd_size_t;
 
+/** Type of the completion callback of asynchronous operations
+ *
+ *  Invoked with 0 on success or a negative error code on failure. May be
+ *  invoked before the asynchronous call returns if the device completes
+ *  synchronously, and may be invoked from interrupt context by DMA-driven
+ *  devices, so it must not block.
+ */
+typedef mbed::Callback<void(int)> bd_complete_cb_t;
+
 
 /** A hardware device capable of writing and reading blocks
  */
@@ -122,6 +132,91 @@ public:
         return 0;
     }
 
+    /** Read blocks from a block device without blocking the caller
+     *
+     *  The default implementation reads synchronously and invokes the
+     *  callback before returning, so every block device supports this API.
+     *  Devices that can drive the transfer by DMA override it to return
+     *  immediately and invoke the callback once the transfer finishes.
+     *  At most one asynchronous operation may be outstanding per device;
+     *  the buffer must stay valid until the callback is invoked.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function called with the result of the read
+     *  @return         0 if the read was started, negative error code on failure
+     *                  to start, in which case the callback is not invoked
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback)
+    {
+        int err = read(buffer, addr, size);
+        if (callback) {
+            callback(err);
+        }
+        return 0;
+    }
+
+    /** Program blocks to a block device without blocking the caller
+     *
+     *  The blocks must have been erased prior to being programmed. See
+     *  read_async for the completion and buffer lifetime contract.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function called with the result of the program
+     *  @return         0 if the program was started, negative error code on failure
+     *                  to start, in which case the callback is not invoked
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback)
+    {
+        int err = program(buffer, addr, size);
+        if (callback) {
+            callback(err);
+        }
+        return 0;
+    }
+
+    /** Erase blocks on a block device without blocking the caller
+     *
+     *  See read_async for the completion contract.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function called with the result of the erase
+     *  @return         0 if the erase was started, negative error code on failure
+     *                  to start, in which case the callback is not invoked
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback)
+    {
+        int err = erase(addr, size);
+        if (callback) {
+            callback(err);
+        }
+        return 0;
+    }
+
+    /** Get a pointer for reading the underlying storage in place
+     *
+     *  On storage that is memory mapped, such as internal flash, returns a
+     *  pointer through which the range [addr, addr + size) can be read
+     *  directly, without copying through read(). The pointer remains valid
+     *  until the range is programmed or erased, or the device is
+     *  deinitialized. The default returns NULL, which devices that are not
+     *  directly addressable, and adapters that buffer writes so the device
+     *  contents may be stale, should keep.
+     *
+     *  @param addr     Address of block to begin mapping
+     *  @param size     Size to map in bytes
+     *  @return         Pointer to the storage, NULL if the range is not
+     *                  directly addressable
+     */
+    virtual const void *get_mapped_read_address(bd_addr_t addr, bd_size_t size) const
+    {
+        return NULL;
+    }
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
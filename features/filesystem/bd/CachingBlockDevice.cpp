@@ -0,0 +1,372 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CachingBlockDevice.h"
+#include "mbed_assert.h"
+#include <string.h>
+
+static inline bd_size_t align_down(bd_size_t val, bd_size_t size)
+{
+    return val / size * size;
+}
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+CachingBlockDevice::CachingBlockDevice(BlockDevice *bd, uint32_t segment_count,
+                                       bd_size_t segment_size, uint32_t max_dirty)
+    : _bd(bd), _seg_count(segment_count), _seg_size(segment_size),
+      _max_dirty(max_dirty), _bd_program_size(0), _segments(0),
+      _lru_counter(0), _last_read_end(0)
+{
+    MBED_ASSERT(_seg_count);
+}
+
+CachingBlockDevice::~CachingBlockDevice()
+{
+    deinit();
+}
+
+int CachingBlockDevice::init()
+{
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    _bd_program_size = _bd->get_program_size();
+
+    if (!_seg_size) {
+        _seg_size = 512;
+    }
+    _seg_size = align_up(_seg_size, _bd_program_size);
+
+    if (!_segments) {
+        _segments = new Segment[_seg_count];
+        for (uint32_t i = 0; i < _seg_count; i++) {
+            _segments[i].valid = false;
+            _segments[i].dirty = false;
+            _segments[i].data = new uint8_t[_seg_size];
+        }
+    }
+
+    _lru_counter = 0;
+    _last_read_end = _bd->size();
+
+    return 0;
+}
+
+int CachingBlockDevice::deinit()
+{
+    int ret = flush_all();
+    if (_segments) {
+        for (uint32_t i = 0; i < _seg_count; i++) {
+            delete[] _segments[i].data;
+        }
+        delete[] _segments;
+        _segments = 0;
+    }
+    int err = _bd->deinit();
+    return ret ? ret : err;
+}
+
+bd_size_t CachingBlockDevice::segment_length(bd_addr_t seg_addr) const
+{
+    bd_size_t len = _seg_size;
+    bd_size_t dev_size = _bd->size();
+    if (seg_addr + len > dev_size) {
+        len = dev_size - seg_addr;
+    }
+    return len;
+}
+
+CachingBlockDevice::Segment *CachingBlockDevice::find_segment(bd_addr_t seg_addr)
+{
+    for (uint32_t i = 0; i < _seg_count; i++) {
+        if (_segments[i].valid && _segments[i].addr == seg_addr) {
+            return &_segments[i];
+        }
+    }
+    return 0;
+}
+
+CachingBlockDevice::Segment *CachingBlockDevice::fetch_segment(bd_addr_t seg_addr, bool load, int &err)
+{
+    err = 0;
+    Segment *seg = find_segment(seg_addr);
+    if (seg) {
+        seg->lru = ++_lru_counter;
+        return seg;
+    }
+
+    // Evict the least recently used segment, preferring empty slots
+    seg = &_segments[0];
+    for (uint32_t i = 0; i < _seg_count; i++) {
+        if (!_segments[i].valid) {
+            seg = &_segments[i];
+            break;
+        }
+        if (_segments[i].lru < seg->lru) {
+            seg = &_segments[i];
+        }
+    }
+
+    if (seg->valid && seg->dirty) {
+        err = flush_segment(seg);
+        if (err) {
+            return 0;
+        }
+    }
+    seg->valid = false;
+
+    if (load) {
+        err = _bd->read(seg->data, seg_addr, segment_length(seg_addr));
+        if (err) {
+            return 0;
+        }
+    }
+
+    seg->addr = seg_addr;
+    seg->valid = true;
+    seg->dirty = false;
+    seg->lru = ++_lru_counter;
+    return seg;
+}
+
+int CachingBlockDevice::flush_segment(Segment *seg)
+{
+    if (!seg->dirty) {
+        return 0;
+    }
+
+    // Only write the dirty span back, widened to program unit boundaries
+    bd_size_t start = align_down(seg->dirty_start, _bd_program_size);
+    bd_size_t end = align_up(seg->dirty_end, _bd_program_size);
+    bd_size_t len = segment_length(seg->addr);
+    if (end > len) {
+        end = len;
+    }
+
+    int ret = _bd->program(seg->data + start, seg->addr + start, end - start);
+    if (ret) {
+        return ret;
+    }
+
+    seg->dirty = false;
+    return 0;
+}
+
+int CachingBlockDevice::flush_all()
+{
+    if (!_segments) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < _seg_count; i++) {
+        if (_segments[i].valid) {
+            int ret = flush_segment(&_segments[i]);
+            if (ret) {
+                return ret;
+            }
+        }
+    }
+    return 0;
+}
+
+uint32_t CachingBlockDevice::dirty_count() const
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < _seg_count; i++) {
+        if (_segments[i].valid && _segments[i].dirty) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int CachingBlockDevice::sync()
+{
+    MBED_ASSERT(_segments);
+    int ret = flush_all();
+    if (ret) {
+        return ret;
+    }
+    return _bd->sync();
+}
+
+int CachingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_segments);
+    bool sequential = (addr == _last_read_end);
+    uint8_t *buf = static_cast<uint8_t *>(b);
+    int err;
+
+    while (size) {
+        bd_addr_t seg_addr = align_down(addr, _seg_size);
+        bd_size_t offset = addr - seg_addr;
+        bd_size_t chunk = _seg_size - offset;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        Segment *seg = fetch_segment(seg_addr, true, err);
+        if (!seg) {
+            return err;
+        }
+
+        memcpy(buf, seg->data + offset, chunk);
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    // A sequential stream is likely to keep going - pull the following
+    // segment in now so the next read is served from memory
+    if (sequential && addr > 0) {
+        bd_addr_t next = align_down(addr - 1, _seg_size) + _seg_size;
+        if (next < _bd->size()) {
+            fetch_segment(next, true, err);
+        }
+    }
+    _last_read_end = addr;
+
+    return 0;
+}
+
+int CachingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_segments);
+    const uint8_t *buf = static_cast<const uint8_t *>(b);
+    int err;
+
+    while (size) {
+        bd_addr_t seg_addr = align_down(addr, _seg_size);
+        bd_size_t offset = addr - seg_addr;
+        bd_size_t chunk = _seg_size - offset;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        // No need to read the underlying data if the whole segment is
+        // about to be overwritten
+        bool whole = (offset == 0) && (chunk == segment_length(seg_addr));
+        Segment *seg = fetch_segment(seg_addr, !whole, err);
+        if (!seg) {
+            return err;
+        }
+
+        memcpy(seg->data + offset, buf, chunk);
+        if (!seg->dirty) {
+            seg->dirty = true;
+            seg->dirty_start = offset;
+            seg->dirty_end = offset + chunk;
+        } else {
+            if (offset < seg->dirty_start) {
+                seg->dirty_start = offset;
+            }
+            if (offset + chunk > seg->dirty_end) {
+                seg->dirty_end = offset + chunk;
+            }
+        }
+
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    if (_max_dirty && dirty_count() > _max_dirty) {
+        return flush_all();
+    }
+
+    return 0;
+}
+
+int CachingBlockDevice::invalidate_range(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _seg_count; i++) {
+        Segment *seg = &_segments[i];
+        if (!seg->valid) {
+            continue;
+        }
+        bd_size_t seg_end = seg->addr + segment_length(seg->addr);
+        if (seg->addr >= addr + size || seg_end <= addr) {
+            continue;
+        }
+        if (seg->dirty && (seg->addr < addr || seg_end > addr + size)) {
+            int ret = flush_segment(seg);
+            if (ret) {
+                return ret;
+            }
+        }
+        seg->valid = false;
+        seg->dirty = false;
+    }
+    return 0;
+}
+
+int CachingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_segments);
+    MBED_ASSERT(is_valid_erase(addr, size));
+    // Cached data in the erased range is dropped, not flushed - the
+    // contents of an erased block are undefined anyway
+    int ret = invalidate_range(addr, size);
+    if (ret) {
+        return ret;
+    }
+    return _bd->erase(addr, size);
+}
+
+int CachingBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_segments);
+    int ret = invalidate_range(addr, size);
+    if (ret) {
+        return ret;
+    }
+    return _bd->trim(addr, size);
+}
+
+bd_size_t CachingBlockDevice::get_read_size() const
+{
+    return 1;
+}
+
+bd_size_t CachingBlockDevice::get_program_size() const
+{
+    return 1;
+}
+
+bd_size_t CachingBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t CachingBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int CachingBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t CachingBlockDevice::size() const
+{
+    return _bd->size();
+}
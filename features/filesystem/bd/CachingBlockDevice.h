@@ -0,0 +1,229 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CACHING_BLOCK_DEVICE_H
+#define MBED_CACHING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+
+/** Block device caching multiple segments of the underlying device on the heap
+ *
+ *  Where BufferedBlockDevice holds exactly one program unit, this adapter
+ *  keeps a configurable number of larger segments, so sequential access is
+ *  served with one bus transaction per segment instead of one per block.
+ *  Sequential reads additionally pull the following segment in ahead of
+ *  time, and programs are held back in the cache and written out on
+ *  eviction, on sync(), or once more than a configurable number of
+ *  segments are dirty. Like the other adapters in this directory it can be
+ *  stacked on any BlockDevice, and it offers byte-granular read and
+ *  program sizes.
+ *
+ *  Deferred data is lost if the device is powered down before sync().
+ */
+class CachingBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the caching block device
+     *
+     *  @param bd            Block device to back the CachingBlockDevice
+     *  @param segment_count Number of cache segments
+     *  @param segment_size  Size of one segment in bytes, rounded up to a
+     *                       multiple of the underlying program size; 0 for
+     *                       a default of 512 bytes or one program unit,
+     *                       whichever is larger
+     *  @param max_dirty     Write all deferred data back once more than
+     *                       this many segments are dirty; 0 to defer until
+     *                       eviction or sync()
+     */
+    CachingBlockDevice(BlockDevice *bd, uint32_t segment_count = 8,
+                       bd_size_t segment_size = 0, uint32_t max_dirty = 0);
+
+    /** Lifetime of a block device
+     */
+    virtual ~CachingBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  Writes deferred data back before deinitializing the underlying
+     *  device.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  Cached data overlapping the erased region is dropped, as the state
+     *  of an erased block is undefined until it has been programmed.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Mark blocks as no longer in use
+     *
+     *  This function provides a hint to the underlying block device that a region of blocks
+     *  is no longer in use and may be erased without side effects. Erase must still be called
+     *  before programming, but trimming allows flash-translation-layers to schedule erases when
+     *  the device is not busy.
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     *  @note Must be a multiple of the read size
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  If get_erase_value returns a non-negative byte value, the underlying
+     *  storage is set to that value when erased, and storage containing
+     *  that value can be programmed without another erase.
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+protected:
+    struct Segment {
+        bd_addr_t addr;
+        bd_size_t dirty_start;
+        bd_size_t dirty_end;
+        uint32_t lru;
+        bool valid;
+        bool dirty;
+        uint8_t *data;
+    };
+
+    BlockDevice *_bd;
+    uint32_t _seg_count;
+    bd_size_t _seg_size;
+    uint32_t _max_dirty;
+    bd_size_t _bd_program_size;
+    Segment *_segments;
+    uint32_t _lru_counter;
+    bd_addr_t _last_read_end;
+
+    /** Length of the segment holding addr, clamped at the device end */
+    bd_size_t segment_length(bd_addr_t seg_addr) const;
+
+    /** Find the resident segment holding seg_addr, or NULL */
+    Segment *find_segment(bd_addr_t seg_addr);
+
+    /** Make the segment holding seg_addr resident, evicting as needed
+     *
+     *  @param seg_addr Segment-aligned address
+     *  @param load     Whether to fill the segment from the underlying
+     *                  device; pass false when the caller overwrites it all
+     *  @param err      Written with 0 or a negative error code
+     *  @return         The segment, or NULL on failure
+     */
+    Segment *fetch_segment(bd_addr_t seg_addr, bool load, int &err);
+
+    /** Write one segment's deferred data back
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    int flush_segment(Segment *seg);
+
+    /** Write all deferred data back
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    int flush_all();
+
+    /** Drop cached segments overlapping a range
+     *
+     *  Segments only partially inside the range are flushed first so
+     *  deferred data outside the range is not lost with them.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    int invalidate_range(bd_addr_t addr, bd_size_t size);
+
+    /** Number of dirty segments */
+    uint32_t dirty_count() const;
+};
+
+
+#endif
@@ -147,3 +147,8 @@ int FlashSimBlockDevice::get_erase_value() const
 {
     return _erase_value;
 }
+
+const void *FlashSimBlockDevice::get_mapped_read_address(bd_addr_t addr, bd_size_t size) const
+{
+    return _bd->get_mapped_read_address(addr, size);
+}
@@ -93,6 +93,24 @@ bd_size_t HeapBlockDevice::size() const
     return _count * _erase_size;
 }
 
+const void *HeapBlockDevice::get_mapped_read_address(bd_addr_t addr, bd_size_t size) const
+{
+    MBED_ASSERT(_blocks != NULL);
+    if (size == 0 || addr + size > _count * _erase_size) {
+        return NULL;
+    }
+
+    bd_addr_t hi = addr / _erase_size;
+    bd_addr_t lo = addr % _erase_size;
+    // Blocks are allocated individually, so the range must sit inside one
+    // block, and an unprogrammed block has no storage to point into
+    if (lo + size > _erase_size || !_blocks[hi]) {
+        return NULL;
+    }
+
+    return &_blocks[hi][lo];
+}
+
 int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
     MBED_ASSERT(_blocks != NULL);
@@ -138,6 +138,19 @@ public:
      */
     virtual bd_size_t get_erase_size(bd_addr_t addr) const;
 
+    /** Get a pointer for reading the underlying storage in place
+     *
+     *  Heap storage is directly addressable, but is allocated one erase
+     *  block at a time, so only ranges within a single erase block that
+     *  has been programmed can be mapped
+     *
+     *  @param addr     Address of block to begin mapping
+     *  @param size     Size to map in bytes
+     *  @return         Pointer to the storage, NULL if the range is not
+     *                  directly addressable
+     */
+    virtual const void *get_mapped_read_address(bd_addr_t addr, bd_size_t size) const;
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
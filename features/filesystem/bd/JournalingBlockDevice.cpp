@@ -0,0 +1,348 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JournalingBlockDevice.h"
+#include "mbed_assert.h"
+#include <string.h>
+
+// Log layout - a sequence of write-intent records appended to the reserved
+// region. Each record is a program-aligned header followed by the payload,
+// with a CRC over both. The scan at init() stops at the first record whose
+// magic, sequence number or CRC does not hold, which is where a power cut
+// tore the log.
+static const uint32_t jbd_magic = 0x6a626431; // 'jbd1'
+static const uint32_t default_journal_blocks = 2;
+static const uint32_t initial_crc = 0xFFFFFFFF;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t crc;
+} jbd_record_t;
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+static uint32_t crc32(uint32_t init_crc, uint32_t data_size, const uint8_t *data_buf)
+{
+    uint32_t i, j;
+    uint32_t crc, mask;
+
+    crc = init_crc;
+    for (i = 0; i < data_size; i++) {
+        crc = crc ^ (uint32_t) (data_buf[i]);
+        for (j = 0; j < 8; j++) {
+            mask = -(crc & 1);
+            crc = (crc >> 1) ^ (0xEDB88320 & mask);
+        }
+    }
+    return crc;
+}
+
+JournalingBlockDevice::JournalingBlockDevice(BlockDevice *bd, bd_size_t journal_size)
+    : _bd(bd), _journal_size(journal_size), _journal_base(0),
+      _prog_size(0), _erase_size(0), _rec_size(0), _journal_offset(0),
+      _seq(0), _replayed(0), _rec_buf(0), _is_initialized(false)
+{
+}
+
+JournalingBlockDevice::~JournalingBlockDevice()
+{
+    if (_is_initialized) {
+        deinit();
+    }
+}
+
+int JournalingBlockDevice::init()
+{
+    if (_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    _prog_size = _bd->get_program_size();
+    _erase_size = _bd->get_erase_size();
+    _rec_size = align_up(sizeof(jbd_record_t), _prog_size);
+
+    if (!_journal_size) {
+        _journal_size = default_journal_blocks * _erase_size;
+    }
+    _journal_size = align_up(_journal_size, _erase_size);
+
+    // The log must hold at least one record with one program block of payload
+    MBED_ASSERT(_journal_size >= _rec_size + _prog_size);
+    MBED_ASSERT(_bd->size() > _journal_size);
+
+    _journal_base = _bd->size() - _journal_size;
+    _rec_buf = new uint8_t[(_rec_size > _prog_size) ? _rec_size : _prog_size];
+    _journal_offset = 0;
+    _seq = 0;
+    _replayed = 0;
+    _is_initialized = true;
+
+    // Repair whatever a power cut left behind, then start with a clean log
+    err = journal_replay();
+    if (!err) {
+        err = _bd->sync();
+    }
+    if (!err) {
+        err = journal_reset();
+    }
+
+    if (err) {
+        delete[] _rec_buf;
+        _rec_buf = 0;
+        _is_initialized = false;
+        _bd->deinit();
+    }
+    return err;
+}
+
+int JournalingBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    int err = journal_flush();
+
+    delete[] _rec_buf;
+    _rec_buf = 0;
+    _is_initialized = false;
+
+    int bd_err = _bd->deinit();
+    return err ? err : bd_err;
+}
+
+int JournalingBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return journal_flush();
+}
+
+int JournalingBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    return _bd->read(buffer, addr, size);
+}
+
+int JournalingBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (_rec_size + size > _journal_size) {
+        // Too large to protect - make everything before it durable, then
+        // write through. Bulk data streams take this path and run at media
+        // speed; the small metadata writes FAT consistency depends on fit
+        // in the log.
+        int err = journal_flush();
+        if (err) {
+            return err;
+        }
+        return _bd->program(buffer, addr, size);
+    }
+
+    if (_journal_offset + _rec_size + size > _journal_size) {
+        // Log full - everything in it is about to be durable anyway
+        int err = journal_flush();
+        if (err) {
+            return err;
+        }
+    }
+
+    int err = journal_append(buffer, addr, size);
+    if (err) {
+        return err;
+    }
+
+    return _bd->program(buffer, addr, size);
+}
+
+int JournalingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    return _bd->erase(addr, size);
+}
+
+bd_size_t JournalingBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t JournalingBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t JournalingBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+int JournalingBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t JournalingBlockDevice::size() const
+{
+    return _bd->size() - _journal_size;
+}
+
+uint32_t JournalingBlockDevice::get_replay_count() const
+{
+    return _replayed;
+}
+
+int JournalingBlockDevice::journal_append(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    jbd_record_t rec;
+    rec.magic = jbd_magic;
+    rec.seq = _seq;
+    rec.addr = addr;
+    rec.size = size;
+    rec.crc = 0;
+    rec.crc = crc32(crc32(initial_crc, sizeof(rec), (const uint8_t *)&rec),
+            size, (const uint8_t *)buffer);
+
+    memset(_rec_buf, 0, _rec_size);
+    memcpy(_rec_buf, &rec, sizeof(rec));
+
+    int err = _bd->program(_rec_buf, _journal_base + _journal_offset, _rec_size);
+    if (err) {
+        return err;
+    }
+
+    err = _bd->program(buffer, _journal_base + _journal_offset + _rec_size, size);
+    if (err) {
+        return err;
+    }
+
+    _journal_offset += _rec_size + size;
+    _seq++;
+    return BD_ERROR_OK;
+}
+
+int JournalingBlockDevice::journal_replay()
+{
+    bd_size_t buf_size = (_rec_size > _prog_size) ? _rec_size : _prog_size;
+    bd_addr_t offset = 0;
+    bool have_seq = false;
+    uint32_t expected_seq = 0;
+
+    while (offset + _rec_size + _prog_size <= _journal_size) {
+        int err = _bd->read(_rec_buf, _journal_base + offset, _rec_size);
+        if (err) {
+            return err;
+        }
+
+        jbd_record_t rec;
+        memcpy(&rec, _rec_buf, sizeof(rec));
+        if (rec.magic != jbd_magic) {
+            break;
+        }
+        if (have_seq && rec.seq != expected_seq) {
+            break;
+        }
+        if (!rec.size || rec.size % _prog_size
+                || rec.addr % _prog_size
+                || rec.addr + rec.size > _journal_base
+                || offset + _rec_size + rec.size > _journal_size) {
+            break;
+        }
+
+        // First pass - checksum the header and payload. A record torn by
+        // the power cut fails here and ends the log.
+        uint32_t stored_crc = rec.crc;
+        rec.crc = 0;
+        uint32_t crc = crc32(initial_crc, sizeof(rec), (const uint8_t *)&rec);
+        for (bd_size_t pos = 0; pos < rec.size; pos += buf_size) {
+            bd_size_t chunk = (rec.size - pos < buf_size) ? (rec.size - pos) : buf_size;
+            err = _bd->read(_rec_buf, _journal_base + offset + _rec_size + pos, chunk);
+            if (err) {
+                return err;
+            }
+            crc = crc32(crc, chunk, _rec_buf);
+        }
+        if (crc != stored_crc) {
+            break;
+        }
+
+        // Second pass - program the payload back to its home address. The
+        // home blocks may hold the very torn write we are repairing, so
+        // erase them again first where the range allows it.
+        if (!(rec.addr % _erase_size) && !(rec.size % _erase_size)) {
+            err = _bd->erase(rec.addr, rec.size);
+            if (err) {
+                return err;
+            }
+        }
+        for (bd_size_t pos = 0; pos < rec.size; pos += buf_size) {
+            bd_size_t chunk = (rec.size - pos < buf_size) ? (rec.size - pos) : buf_size;
+            err = _bd->read(_rec_buf, _journal_base + offset + _rec_size + pos, chunk);
+            if (err) {
+                return err;
+            }
+            err = _bd->program(_rec_buf, rec.addr + pos, chunk);
+            if (err) {
+                return err;
+            }
+        }
+
+        _replayed++;
+        expected_seq = rec.seq + 1;
+        have_seq = true;
+        offset += _rec_size + rec.size;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int JournalingBlockDevice::journal_reset()
+{
+    int err = _bd->erase(_journal_base, _journal_size);
+    if (err) {
+        return err;
+    }
+
+    _journal_offset = 0;
+    return BD_ERROR_OK;
+}
+
+int JournalingBlockDevice::journal_flush()
+{
+    int err = _bd->sync();
+    if (err) {
+        return err;
+    }
+
+    if (_journal_offset == 0) {
+        return BD_ERROR_OK;
+    }
+
+    return journal_reset();
+}
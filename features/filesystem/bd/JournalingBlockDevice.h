@@ -0,0 +1,193 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_JOURNALING_BLOCK_DEVICE_H
+#define MBED_JOURNALING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+
+/** Block device adapter which logs write intents for fast power-fail recovery
+ *
+ *  Filesystems without their own journal, such as FAT, can be left with
+ *  torn metadata by a power cut in the middle of a multi-sector write, and
+ *  detecting that requires a full consistency scan at boot. This adapter
+ *  reserves a small log region at the end of the underlying device and
+ *  appends every programmed range to it - header, payload and checksum -
+ *  before programming the home location. On the next init() any intents
+ *  still in the log are replayed to their home addresses, so a torn write
+ *  is repaired by re-programming it from the log. Recovery cost is bounded
+ *  by the log size, not the volume size.
+ *
+ *  sync() flushes the underlying device and then resets the log, as does
+ *  running out of log space, so the log only ever holds writes that are
+ *  not yet known to be durable. Every program is written twice (once to
+ *  the log, once home); writes too large for the log are flushed and
+ *  written through unprotected, which keeps bulk data streams at media
+ *  speed while the small metadata writes that FAT consistency depends on
+ *  stay journaled.
+ *
+ *  Reads and erases pass straight through. For replay to work on storage
+ *  that needs an erase before program, programmed ranges should line up
+ *  with erase boundaries, which is how FATFileSystem drives its block
+ *  device.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "JournalingBlockDevice.h"
+ *  #include "SDBlockDevice.h"
+ *
+ *  SDBlockDevice sd(PTE3, PTE1, PTE2, PTE4);
+ *  JournalingBlockDevice bd(&sd);
+ *  FATFileSystem fat("fat", &bd);
+ *  @endcode
+ */
+class JournalingBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the journaling block device
+     *
+     *  @param bd           Block device to journal writes to
+     *  @param journal_size
+     *      Size of the log region reserved at the end of the device in
+     *      bytes, rounded up to a multiple of the erase size. A larger
+     *      region absorbs more writes between resets at the cost of
+     *      capacity and worst-case replay time. Defaults to two erase
+     *      blocks.
+     */
+    JournalingBlockDevice(BlockDevice *bd, bd_size_t journal_size = 0);
+    virtual ~JournalingBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  Replays any write intents left in the log by a power cut to their
+     *  home addresses, then resets the log
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  Flushes the underlying device and resets the log - everything
+     *  written so far is durable, so nothing is left to replay
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The write is appended to the log before the home location is
+     *  programmed. The blocks must have been erased prior to being
+     *  programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the logical device in bytes, which is smaller
+     *                  than the underlying device by the log region
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the number of write intents replayed by the last init()
+     *
+     *  Nonzero after a recovery from power loss
+     *
+     *  @return         Number of replayed writes
+     */
+    uint32_t get_replay_count() const;
+
+protected:
+    // Append one write intent - header and payload - to the log
+    int journal_append(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    // Re-program every valid intent in the log to its home address
+    int journal_replay();
+
+    // Erase the log region and start appending from the top
+    int journal_reset();
+
+    // Flush the underlying device, then reset the log
+    int journal_flush();
+
+    BlockDevice *_bd;
+    bd_size_t _journal_size;
+    bd_addr_t _journal_base;
+    bd_size_t _prog_size;
+    bd_size_t _erase_size;
+    bd_size_t _rec_size;
+    bd_addr_t _journal_offset;
+    uint32_t _seq;
+    uint32_t _replayed;
+    uint8_t *_rec_buf;
+    bool _is_initialized;
+};
+
+
+#endif
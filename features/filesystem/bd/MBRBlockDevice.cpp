@@ -302,6 +302,14 @@ int MBRBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *MBRBlockDevice::get_mapped_read_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (addr + size > this->size()) {
+        return NULL;
+    }
+    return _bd->get_mapped_read_address(addr + _offset, size);
+}
+
 bd_size_t MBRBlockDevice::size() const
 {
     return _size;
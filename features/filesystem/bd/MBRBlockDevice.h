@@ -220,6 +220,19 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer for reading the underlying storage in place
+     *
+     *  Forwarded to the underlying block device with the partition's
+     *  offset applied, which returns NULL unless it is directly
+     *  addressable
+     *
+     *  @param addr     Address of block to begin mapping
+     *  @param size     Size to map in bytes
+     *  @return         Pointer to the storage, NULL if the range is not
+     *                  directly addressable
+     */
+    virtual const void *get_mapped_read_address(bd_addr_t addr, bd_size_t size) const;
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
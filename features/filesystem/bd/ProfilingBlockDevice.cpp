@@ -15,6 +15,8 @@
  */
 
 #include "ProfilingBlockDevice.h"
+#include "mbed_critical.h"
+#include <string.h>
 
 
 ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
@@ -22,7 +24,50 @@ ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
     , _read_count(0)
     , _program_count(0)
     , _erase_count(0)
+    , _slow_op_count(0)
+    , _inflight(0)
+    , _max_inflight(0)
 {
+    memset(_latency_histogram, 0, sizeof(_latency_histogram));
+    memset(_max_latency, 0, sizeof(_max_latency));
+    memset(_slow_ops, 0, sizeof(_slow_ops));
+    _timer.start();
+}
+
+void ProfilingBlockDevice::record_op(bd_profile_op op, uint32_t latency_us, bd_addr_t addr, bd_size_t size)
+{
+    int bucket = 0;
+    while (bucket < BD_PROFILE_LATENCY_BUCKETS - 1 && (latency_us >> (bucket + 1))) {
+        bucket++;
+    }
+    _latency_histogram[op][bucket]++;
+
+    if (latency_us > _max_latency[op]) {
+        _max_latency[op] = latency_us;
+    }
+
+    // Keep the slowest operations seen, replacing the fastest logged entry
+    // once the log is full
+    if (_slow_op_count < BD_PROFILE_SLOW_OPS) {
+        bd_profile_slow_op *entry = &_slow_ops[_slow_op_count++];
+        entry->op = op;
+        entry->latency_us = latency_us;
+        entry->addr = addr;
+        entry->size = size;
+    } else {
+        bd_profile_slow_op *fastest = &_slow_ops[0];
+        for (uint32_t i = 1; i < BD_PROFILE_SLOW_OPS; i++) {
+            if (_slow_ops[i].latency_us < fastest->latency_us) {
+                fastest = &_slow_ops[i];
+            }
+        }
+        if (latency_us > fastest->latency_us) {
+            fastest->op = op;
+            fastest->latency_us = latency_us;
+            fastest->addr = addr;
+            fastest->size = size;
+        }
+    }
 }
 
 int ProfilingBlockDevice::init()
@@ -42,7 +87,14 @@ int ProfilingBlockDevice::sync()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t depth = core_util_atomic_incr_u32(&_inflight, 1);
+    if (depth > _max_inflight) {
+        _max_inflight = depth;
+    }
+    us_timestamp_t start = _timer.read_high_resolution_us();
     int err = _bd->read(b, addr, size);
+    record_op(BD_PROFILE_READ, (uint32_t)(_timer.read_high_resolution_us() - start), addr, size);
+    core_util_atomic_decr_u32(&_inflight, 1);
     if (!err) {
         _read_count += size;
     }
@@ -51,7 +103,14 @@ int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t depth = core_util_atomic_incr_u32(&_inflight, 1);
+    if (depth > _max_inflight) {
+        _max_inflight = depth;
+    }
+    us_timestamp_t start = _timer.read_high_resolution_us();
     int err = _bd->program(b, addr, size);
+    record_op(BD_PROFILE_PROGRAM, (uint32_t)(_timer.read_high_resolution_us() - start), addr, size);
+    core_util_atomic_decr_u32(&_inflight, 1);
     if (!err) {
         _program_count += size;
     }
@@ -60,7 +119,14 @@ int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    uint32_t depth = core_util_atomic_incr_u32(&_inflight, 1);
+    if (depth > _max_inflight) {
+        _max_inflight = depth;
+    }
+    us_timestamp_t start = _timer.read_high_resolution_us();
     int err = _bd->erase(addr, size);
+    record_op(BD_PROFILE_ERASE, (uint32_t)(_timer.read_high_resolution_us() - start), addr, size);
+    core_util_atomic_decr_u32(&_inflight, 1);
     if (!err) {
         _erase_count += size;
     }
@@ -102,6 +168,11 @@ void ProfilingBlockDevice::reset()
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(_latency_histogram, 0, sizeof(_latency_histogram));
+    memset(_max_latency, 0, sizeof(_max_latency));
+    memset(_slow_ops, 0, sizeof(_slow_ops));
+    _slow_op_count = 0;
+    _max_inflight = 0;
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -118,3 +189,42 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
 {
     return _erase_count;
 }
+
+const uint32_t *ProfilingBlockDevice::get_latency_histogram(bd_profile_op op) const
+{
+    MBED_ASSERT(op < BD_PROFILE_OP_COUNT);
+    return _latency_histogram[op];
+}
+
+uint32_t ProfilingBlockDevice::get_max_latency(bd_profile_op op) const
+{
+    MBED_ASSERT(op < BD_PROFILE_OP_COUNT);
+    return _max_latency[op];
+}
+
+uint32_t ProfilingBlockDevice::get_slow_ops(bd_profile_slow_op *ops, uint32_t count) const
+{
+    // The log is small, so sort a copy slowest first by insertion
+    bd_profile_slow_op sorted[BD_PROFILE_SLOW_OPS];
+    for (uint32_t i = 0; i < _slow_op_count; i++) {
+        sorted[i] = _slow_ops[i];
+        for (uint32_t j = i; j > 0 && sorted[j].latency_us > sorted[j - 1].latency_us; j--) {
+            bd_profile_slow_op tmp = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = tmp;
+        }
+    }
+
+    if (count > _slow_op_count) {
+        count = _slow_op_count;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        ops[i] = sorted[i];
+    }
+    return count;
+}
+
+uint32_t ProfilingBlockDevice::get_max_inflight() const
+{
+    return _max_inflight;
+}
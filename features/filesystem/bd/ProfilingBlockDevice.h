@@ -42,11 +42,40 @@
  *  printf("read count: %lld\n", profiler.get_read_count());
  *  printf("program count: %lld\n", profiler.get_program_count());
  *  printf("erase count: %lld\n", profiler.get_erase_count());
+ *  printf("max erase latency: %lu us\n", profiler.get_max_latency(ProfilingBlockDevice::BD_PROFILE_ERASE));
  *  @endcode
  */
 class ProfilingBlockDevice : public BlockDevice
 {
 public:
+    /** Operation types tracked by the profiler
+     */
+    enum bd_profile_op {
+        BD_PROFILE_READ = 0,
+        BD_PROFILE_PROGRAM,
+        BD_PROFILE_ERASE,
+        BD_PROFILE_OP_COUNT
+    };
+
+    /** Number of log-scale latency buckets, bucket i counts operations that
+     *  took [2^i, 2^(i+1)) microseconds and the last bucket also counts
+     *  everything slower, giving a range up to about half a second
+     */
+    static const int BD_PROFILE_LATENCY_BUCKETS = 20;
+
+    /** Number of entries kept in the slowest-operation log
+     */
+    static const int BD_PROFILE_SLOW_OPS = 8;
+
+    /** One entry of the slowest-operation log
+     */
+    struct bd_profile_slow_op {
+        bd_profile_op op;       /*!< operation type */
+        uint32_t latency_us;    /*!< how long the operation took */
+        bd_addr_t addr;         /*!< address the operation targeted */
+        bd_size_t size;         /*!< size of the operation in bytes */
+    };
+
     /** Lifetime of the memory block device
      *
      *  @param bd       Block device to back the ProfilingBlockDevice
@@ -175,11 +204,56 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get the latency histogram of an operation type
+     *
+     *  Latencies are recorded for failed operations too, since a stalled
+     *  operation costs the caller the same time whether or not it succeeds.
+     *
+     *  @param op   Operation type to query
+     *  @return     Array of BD_PROFILE_LATENCY_BUCKETS bucket counts, where
+     *              bucket i counts operations that took [2^i, 2^(i+1))
+     *              microseconds and the last bucket everything slower
+     */
+    const uint32_t *get_latency_histogram(bd_profile_op op) const;
+
+    /** Get the longest time a single operation of a type has taken
+     *
+     *  @param op   Operation type to query
+     *  @return     Maximum latency in microseconds, 0 if none recorded
+     */
+    uint32_t get_max_latency(bd_profile_op op) const;
+
+    /** Get the slowest operations seen since the last reset
+     *
+     *  @param ops      Buffer to copy log entries into, slowest first
+     *  @param count    Maximum number of entries to copy
+     *  @return         Number of entries copied
+     */
+    uint32_t get_slow_ops(bd_profile_slow_op *ops, uint32_t count) const;
+
+    /** Get the most operations that have been in flight at once
+     *
+     *  Counts callers inside read/program/erase simultaneously, showing how
+     *  much the device is contended when shared between threads.
+     *
+     *  @return     Maximum number of concurrent operations seen
+     */
+    uint32_t get_max_inflight() const;
+
 private:
     BlockDevice *_bd;
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    mbed::Timer _timer;
+    uint32_t _latency_histogram[BD_PROFILE_OP_COUNT][BD_PROFILE_LATENCY_BUCKETS];
+    uint32_t _max_latency[BD_PROFILE_OP_COUNT];
+    bd_profile_slow_op _slow_ops[BD_PROFILE_SLOW_OPS];
+    uint32_t _slow_op_count;
+    uint32_t _inflight;
+    uint32_t _max_inflight;
+
+    void record_op(bd_profile_op op, uint32_t latency_us, bd_addr_t addr, bd_size_t size);
 };
 
 
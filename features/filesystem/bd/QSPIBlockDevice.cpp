@@ -0,0 +1,367 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QSPIBlockDevice.h"
+
+#if DEVICE_QSPI
+
+#include "mbed_assert.h"
+#include <string.h>
+
+// JEDEC NOR flash command set
+#define QSPI_CMD_RDID       0x9F // Read JEDEC ID
+#define QSPI_CMD_WREN       0x06 // Write enable
+#define QSPI_CMD_RDSR1      0x05 // Read status register 1
+#define QSPI_CMD_RDSR2      0x35 // Read status register 2
+#define QSPI_CMD_WRSR       0x01 // Write status registers 1 and 2
+#define QSPI_CMD_PP         0x02 // Page program
+#define QSPI_CMD_SE         0x20 // 4KB sector erase
+#define QSPI_CMD_READ_FAST  0x0B // Fast read, single data phase
+#define QSPI_CMD_READ_QOUT  0x6B // Fast read, quad data phase
+#define QSPI_CMD_EN4B       0xB7 // Enter 4-byte address mode
+
+#define QSPI_SR1_WIP        0x01 // Write in progress
+#define QSPI_SR2_QE         0x02 // Quad enable
+
+static const bd_size_t QSPI_PAGE_SIZE = 256;
+static const bd_size_t QSPI_SECTOR_SIZE = 4096;
+static const bd_size_t QSPI_4B_THRESHOLD = 16 * 1024 * 1024;
+
+// Fill a command with a bare single-width instruction; callers enable the
+// phases they need on top
+static void cmd_build(qspi_command_t *command, uint8_t instruction)
+{
+    memset(command, 0, sizeof(*command));
+    command->instruction.bus_width = QSPI_CFG_BUS_SINGLE;
+    command->instruction.value = instruction;
+    command->instruction.disabled = false;
+    command->address.disabled = true;
+    command->data.bus_width = QSPI_CFG_BUS_SINGLE;
+}
+
+QSPIBlockDevice::QSPIBlockDevice(PinName io0, PinName io1, PinName io2, PinName io3,
+                                 PinName sclk, PinName ssel, int freq, bool quad) :
+    _qspi(), _io0(io0), _io1(io1), _io2(io2), _io3(io3), _sclk(sclk), _ssel(ssel),
+    _freq(freq), _quad(quad && (io2 != NC) && (io3 != NC)),
+    _size(0), _mmap_base(NULL), _is_initialized(false)
+{
+}
+
+QSPIBlockDevice::~QSPIBlockDevice()
+{
+    deinit();
+}
+
+void QSPIBlockDevice::_build_read_command(qspi_command_t *command, uint32_t addr) const
+{
+    cmd_build(command, _quad ? QSPI_CMD_READ_QOUT : QSPI_CMD_READ_FAST);
+    command->address.bus_width = QSPI_CFG_BUS_SINGLE;
+    command->address.size = (_size > QSPI_4B_THRESHOLD) ?
+                            QSPI_CFG_ADDR_SIZE_32 : QSPI_CFG_ADDR_SIZE_24;
+    command->address.value = addr;
+    command->address.disabled = false;
+    command->dummy_count = 8;
+    command->data.bus_width = _quad ? QSPI_CFG_BUS_QUAD : QSPI_CFG_BUS_SINGLE;
+}
+
+int QSPIBlockDevice::_command(uint8_t instruction)
+{
+    qspi_command_t command;
+    cmd_build(&command, instruction);
+    size_t length = 0;
+    if (qspi_write(&_qspi, &command, NULL, &length) != QSPI_STATUS_OK) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return BD_ERROR_OK;
+}
+
+int QSPIBlockDevice::_wait_ready()
+{
+    qspi_command_t command;
+    cmd_build(&command, QSPI_CMD_RDSR1);
+    uint8_t status = QSPI_SR1_WIP;
+    do {
+        size_t length = 1;
+        if (qspi_read(&_qspi, &command, &status, &length) != QSPI_STATUS_OK) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+    } while (status & QSPI_SR1_WIP);
+    return BD_ERROR_OK;
+}
+
+int QSPIBlockDevice::_mmap_suspend()
+{
+    if (_mmap_base && qspi_mmap_disable(&_qspi) != QSPI_STATUS_OK) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return BD_ERROR_OK;
+}
+
+int QSPIBlockDevice::_mmap_resume()
+{
+    if (!_mmap_base) {
+        return BD_ERROR_OK;
+    }
+    qspi_command_t command;
+    _build_read_command(&command, 0);
+    if (qspi_mmap_enable(&_qspi, &command, &_mmap_base) != QSPI_STATUS_OK) {
+        // Stay usable in command mode rather than failing outright
+        _mmap_base = NULL;
+    }
+    return BD_ERROR_OK;
+}
+
+int QSPIBlockDevice::init()
+{
+    _mutex.lock();
+    if (_is_initialized) {
+        _mutex.unlock();
+        return BD_ERROR_OK;
+    }
+
+    if (qspi_init(&_qspi, _io0, _io1, _io2, _io3, _sclk, _ssel, _freq, 0) != QSPI_STATUS_OK) {
+        _mutex.unlock();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    // Probe the part over JEDEC ID; the third byte encodes the density
+    qspi_command_t command;
+    cmd_build(&command, QSPI_CMD_RDID);
+    uint8_t id[3] = {0};
+    size_t length = sizeof(id);
+    if (qspi_read(&_qspi, &command, id, &length) != QSPI_STATUS_OK ||
+            id[0] == 0x00 || id[0] == 0xFF) {
+        qspi_free(&_qspi);
+        _mutex.unlock();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    _size = (bd_size_t)1 << id[2];
+
+    int err = BD_ERROR_OK;
+    if (_size > QSPI_4B_THRESHOLD) {
+        err = _command(QSPI_CMD_EN4B);
+    }
+
+    if (err == BD_ERROR_OK && _quad) {
+        // Set the quad-enable bit if the part does not have it latched yet
+        uint8_t sr[2];
+        cmd_build(&command, QSPI_CMD_RDSR1);
+        length = 1;
+        err = (qspi_read(&_qspi, &command, &sr[0], &length) == QSPI_STATUS_OK) ?
+              BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+        if (err == BD_ERROR_OK) {
+            cmd_build(&command, QSPI_CMD_RDSR2);
+            length = 1;
+            err = (qspi_read(&_qspi, &command, &sr[1], &length) == QSPI_STATUS_OK) ?
+                  BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+        }
+        if (err == BD_ERROR_OK && !(sr[1] & QSPI_SR2_QE)) {
+            sr[1] |= QSPI_SR2_QE;
+            err = _command(QSPI_CMD_WREN);
+            if (err == BD_ERROR_OK) {
+                cmd_build(&command, QSPI_CMD_WRSR);
+                length = sizeof(sr);
+                err = (qspi_write(&_qspi, &command, sr, &length) == QSPI_STATUS_OK) ?
+                      BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+            }
+            if (err == BD_ERROR_OK) {
+                err = _wait_ready();
+            }
+        }
+    }
+
+    if (err != BD_ERROR_OK) {
+        qspi_free(&_qspi);
+        _mutex.unlock();
+        return err;
+    }
+
+    // Enter the memory-mapped window where the target provides one; on
+    // failure reads simply stay in command mode
+    _build_read_command(&command, 0);
+    if (qspi_mmap_enable(&_qspi, &command, &_mmap_base) != QSPI_STATUS_OK) {
+        _mmap_base = NULL;
+    }
+
+    _is_initialized = true;
+    _mutex.unlock();
+    return BD_ERROR_OK;
+}
+
+int QSPIBlockDevice::deinit()
+{
+    _mutex.lock();
+    if (!_is_initialized) {
+        _mutex.unlock();
+        return BD_ERROR_OK;
+    }
+    if (_mmap_base) {
+        qspi_mmap_disable(&_qspi);
+        _mmap_base = NULL;
+    }
+    qspi_free(&_qspi);
+    _is_initialized = false;
+    _mutex.unlock();
+    return BD_ERROR_OK;
+}
+
+int QSPIBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    _mutex.lock();
+    if (!_is_initialized) {
+        _mutex.unlock();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    int err = BD_ERROR_OK;
+    if (_mmap_base) {
+        // XIP fast path - a plain memory copy instead of a command-mode
+        // transfer per read
+        memcpy(buffer, (const uint8_t *)_mmap_base + addr, size);
+    } else {
+        qspi_command_t command;
+        _build_read_command(&command, (uint32_t)addr);
+        size_t length = (size_t)size;
+        if (qspi_read(&_qspi, &command, buffer, &length) != QSPI_STATUS_OK) {
+            err = BD_ERROR_DEVICE_ERROR;
+        }
+    }
+    _mutex.unlock();
+    return err;
+}
+
+int QSPIBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    _mutex.lock();
+    if (!_is_initialized) {
+        _mutex.unlock();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    int err = _mmap_suspend();
+    const uint8_t *data = (const uint8_t *)buffer;
+    while (err == BD_ERROR_OK && size > 0) {
+        bd_size_t chunk = QSPI_PAGE_SIZE - (addr % QSPI_PAGE_SIZE);
+        if (chunk > size) {
+            chunk = size;
+        }
+        err = _command(QSPI_CMD_WREN);
+        if (err == BD_ERROR_OK) {
+            qspi_command_t command;
+            cmd_build(&command, QSPI_CMD_PP);
+            command.address.bus_width = QSPI_CFG_BUS_SINGLE;
+            command.address.size = (_size > QSPI_4B_THRESHOLD) ?
+                                   QSPI_CFG_ADDR_SIZE_32 : QSPI_CFG_ADDR_SIZE_24;
+            command.address.value = (uint32_t)addr;
+            command.address.disabled = false;
+            size_t length = (size_t)chunk;
+            if (qspi_write(&_qspi, &command, data, &length) != QSPI_STATUS_OK) {
+                err = BD_ERROR_DEVICE_ERROR;
+            }
+        }
+        if (err == BD_ERROR_OK) {
+            err = _wait_ready();
+        }
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+
+    int resume_err = _mmap_resume();
+    if (err == BD_ERROR_OK) {
+        err = resume_err;
+    }
+    _mutex.unlock();
+    return err;
+}
+
+int QSPIBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+    _mutex.lock();
+    if (!_is_initialized) {
+        _mutex.unlock();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    int err = _mmap_suspend();
+    while (err == BD_ERROR_OK && size > 0) {
+        err = _command(QSPI_CMD_WREN);
+        if (err == BD_ERROR_OK) {
+            qspi_command_t command;
+            cmd_build(&command, QSPI_CMD_SE);
+            command.address.bus_width = QSPI_CFG_BUS_SINGLE;
+            command.address.size = (_size > QSPI_4B_THRESHOLD) ?
+                                   QSPI_CFG_ADDR_SIZE_32 : QSPI_CFG_ADDR_SIZE_24;
+            command.address.value = (uint32_t)addr;
+            command.address.disabled = false;
+            size_t length = 0;
+            if (qspi_write(&_qspi, &command, NULL, &length) != QSPI_STATUS_OK) {
+                err = BD_ERROR_DEVICE_ERROR;
+            }
+        }
+        if (err == BD_ERROR_OK) {
+            err = _wait_ready();
+        }
+        addr += QSPI_SECTOR_SIZE;
+        size -= QSPI_SECTOR_SIZE;
+    }
+
+    int resume_err = _mmap_resume();
+    if (err == BD_ERROR_OK) {
+        err = resume_err;
+    }
+    _mutex.unlock();
+    return err;
+}
+
+const void *QSPIBlockDevice::get_mapped_read_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!is_valid_read(addr, size)) {
+        return NULL;
+    }
+    _mutex.lock();
+    const void *base = _mmap_base;
+    _mutex.unlock();
+    if (!base) {
+        return NULL;
+    }
+    return (const uint8_t *)base + addr;
+}
+
+bd_size_t QSPIBlockDevice::get_read_size() const
+{
+    return 1;
+}
+
+bd_size_t QSPIBlockDevice::get_program_size() const
+{
+    return QSPI_PAGE_SIZE;
+}
+
+bd_size_t QSPIBlockDevice::get_erase_size() const
+{
+    return QSPI_SECTOR_SIZE;
+}
+
+bd_size_t QSPIBlockDevice::size() const
+{
+    return _size;
+}
+
+#endif
@@ -0,0 +1,184 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_QSPI_BLOCK_DEVICE_H
+#define MBED_QSPI_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "platform/platform.h"
+
+#if DEVICE_QSPI
+
+#include "hal/qspi_api.h"
+#include "platform/PlatformMutex.h"
+
+/** Block device for NOR flash on a quad-SPI controller
+ *
+ * Reads are served from the controller's memory-mapped (XIP) window when
+ * the target provides one, so a read costs a memory fetch instead of a
+ * command-mode transfer, and get_mapped_read_address() exposes the window
+ * for in-place use of file contents. Programs and erases drop to command
+ * mode for their duration and restore the mapping afterwards. On targets
+ * without a mapped window, everything runs in command mode.
+ *
+ * The driver expects a JEDEC-compliant NOR flash with 4KB sector erase and
+ * 256 byte page program, and a quad-enable bit in bit 1 of status
+ * register 2 (the common Winbond/GigaDevice layout); parts with a
+ * different layout can be used in single-width mode by passing quad=false.
+ *
+ * @code
+ * #include "mbed.h"
+ * #include "QSPIBlockDevice.h"
+ *
+ * QSPIBlockDevice bd(QSPI_IO0, QSPI_IO1, QSPI_IO2, QSPI_IO3,
+ *                    QSPI_SCLK, QSPI_SSEL);
+ *
+ * int main() {
+ *     bd.init();
+ *     printf("size: %llu\n", bd.size());
+ *     bd.deinit();
+ * }
+ * @endcode
+ */
+class QSPIBlockDevice : public BlockDevice {
+public:
+    /** Create a QSPIBlockDevice on the given pins
+     *
+     *  @param io0  Data pin 0
+     *  @param io1  Data pin 1
+     *  @param io2  Data pin 2, NC to force single-width operation
+     *  @param io3  Data pin 3, NC to force single-width operation
+     *  @param sclk Clock pin
+     *  @param ssel Chip select pin
+     *  @param freq Bus frequency in hertz
+     *  @param quad true to read with a quad-width data phase
+     */
+    QSPIBlockDevice(PinName io0, PinName io1, PinName io2, PinName io3,
+                    PinName sclk, PinName ssel,
+                    int freq = 40000000, bool quad = true);
+
+    virtual ~QSPIBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  Probes the flash over JEDEC ID, enables quad mode if requested and
+     *  enters the memory-mapped read window when the target provides one
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize the block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Read blocks from the block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to the block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Get a pointer for reading the flash in place
+     *
+     *  Returns a pointer into the memory-mapped window when the controller
+     *  provides one and no program or erase is in progress, NULL otherwise
+     *
+     *  @param addr     Address of block to begin mapping
+     *  @param size     Size to map in bytes
+     *  @return         Pointer to the storage, NULL if the range is not
+     *                  directly addressable
+     */
+    virtual const void *get_mapped_read_address(bd_addr_t addr, bd_size_t size) const;
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+private:
+    // Send a bare instruction with no address or data phase
+    int _command(uint8_t instruction);
+    // Poll the write-in-progress bit until the flash goes idle
+    int _wait_ready();
+    // Leave/re-enter the memory-mapped window around a write sequence
+    int _mmap_suspend();
+    int _mmap_resume();
+    // Build the configured read command for command mode and XIP
+    void _build_read_command(qspi_command_t *command, uint32_t addr) const;
+
+    qspi_t _qspi;
+    PinName _io0, _io1, _io2, _io3, _sclk, _ssel;
+    int _freq;
+    bool _quad;
+    bd_size_t _size;
+    const void *_mmap_base;
+    bool _is_initialized;
+    mutable PlatformMutex _mutex;
+};
+
+#endif
+
+#endif
@@ -87,6 +87,24 @@ int SlicingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return _bd->erase(addr + _start, size);
 }
 
+int SlicingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    return _bd->read_async(b, addr + _start, size, callback);
+}
+
+int SlicingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    return _bd->program_async(b, addr + _start, size, callback);
+}
+
+int SlicingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+    return _bd->erase_async(addr + _start, size, callback);
+}
+
 bd_size_t SlicingBlockDevice::get_read_size() const
 {
     return _bd->get_read_size();
@@ -112,6 +130,14 @@ int SlicingBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *SlicingBlockDevice::get_mapped_read_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (addr + size > this->size()) {
+        return NULL;
+    }
+    return _bd->get_mapped_read_address(addr + _start, size);
+}
+
 bd_size_t SlicingBlockDevice::size() const
 {
     return _stop - _start;
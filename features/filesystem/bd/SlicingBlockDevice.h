@@ -114,6 +114,43 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Read blocks from a block device without blocking the caller
+     *
+     *  Forwarded to the underlying block device so its asynchronous
+     *  support, if any, is preserved through the slice
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function called with the result of the read
+     *  @return         0 if the read was started, negative error code on failure
+     *                  to start, in which case the callback is not invoked
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback);
+
+    /** Program blocks to a block device without blocking the caller
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function called with the result of the program
+     *  @return         0 if the program was started, negative error code on failure
+     *                  to start, in which case the callback is not invoked
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback);
+
+    /** Erase blocks on a block device without blocking the caller
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function called with the result of the erase
+     *  @return         0 if the erase was started, negative error code on failure
+     *                  to start, in which case the callback is not invoked
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_complete_cb_t callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -153,6 +190,18 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer for reading the underlying storage in place
+     *
+     *  Forwarded to the underlying block device with the slice's offset
+     *  applied, which returns NULL unless it is directly addressable
+     *
+     *  @param addr     Address of block to begin mapping
+     *  @param size     Size to map in bytes
+     *  @return         Pointer to the storage, NULL if the range is not
+     *                  directly addressable
+     */
+    virtual const void *get_mapped_read_address(bd_addr_t addr, bd_size_t size) const;
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
@@ -0,0 +1,602 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WearLevelingBlockDevice.h"
+#include "mbed_assert.h"
+#include <string.h>
+
+// Journal layout - two reserved erase blocks, each starting with a table
+// blob (the full map and erase-count state at the last compaction) followed
+// by fixed-size update records appended as blocks are remapped. The blob
+// with the newer version wins at init; a torn blob fails its CRC and the
+// other block stays authoritative.
+static const uint32_t wl_magic = 0x776c6264; // 'wlbd'
+static const uint32_t journal_blocks = 2;
+static const uint32_t min_journal_slack = 8;
+static const uint8_t blank_flash_val = 0xFF;
+static const uint32_t initial_crc = 0xFFFFFFFF;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t log_count;
+    uint32_t phys_count;
+    uint32_t crc;
+} wl_table_header_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t logical;
+    uint32_t physical;
+    uint32_t erase_count;
+    uint32_t crc;
+} wl_record_t;
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+static uint32_t crc32(uint32_t init_crc, uint32_t data_size, const uint8_t *data_buf)
+{
+    uint32_t i, j;
+    uint32_t crc, mask;
+
+    crc = init_crc;
+    for (i = 0; i < data_size; i++) {
+        crc = crc ^ (uint32_t) (data_buf[i]);
+        for (j = 0; j < 8; j++) {
+            mask = -(crc & 1);
+            crc = (crc >> 1) ^ (0xEDB88320 & mask);
+        }
+    }
+    return crc;
+}
+
+WearLevelingBlockDevice::WearLevelingBlockDevice(BlockDevice *bd, uint32_t spare_count, uint32_t migration_threshold)
+    : _bd(bd), _spare_count(spare_count), _migration_threshold(migration_threshold),
+      _erase_size(0), _prog_size(0), _rec_size(0), _phys_count(0), _log_count(0),
+      _log_to_phys(0), _erase_counts(0), _pool(0), _copy_buf(0), _table_buf(0),
+      _table_size(0), _journal_area(0), _journal_offset(0), _journal_version(0),
+      _migrations(0), _is_initialized(false)
+{
+    MBED_ASSERT(_spare_count);
+}
+
+WearLevelingBlockDevice::~WearLevelingBlockDevice()
+{
+    if (_is_initialized) {
+        deinit();
+    }
+}
+
+int WearLevelingBlockDevice::init()
+{
+    if (_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    _erase_size = _bd->get_erase_size();
+    _prog_size = _bd->get_program_size();
+    _phys_count = _bd->size() / _erase_size;
+    _rec_size = align_up(sizeof(wl_record_t), _prog_size);
+
+    MBED_ASSERT(_phys_count > journal_blocks + _spare_count);
+    MBED_ASSERT(_phys_count < 0xFFFF);
+
+    _log_count = _phys_count - journal_blocks - _spare_count;
+
+    // Table blob - header, then the map (padded to keep the counts aligned),
+    // then the erase counts of every physical block
+    _table_size = align_up(sizeof(wl_table_header_t)
+            + align_up(2 * _log_count, 4) + 4 * _phys_count, _prog_size);
+
+    // The journal must fit the table blob plus room for update records
+    MBED_ASSERT(_table_size + min_journal_slack * _rec_size <= _erase_size);
+
+    _log_to_phys = new uint32_t[_log_count];
+    _erase_counts = new uint32_t[_phys_count];
+    _pool = new uint32_t[_spare_count];
+    _copy_buf = new uint8_t[(_rec_size > _prog_size) ? _rec_size : _prog_size];
+    _table_buf = new uint8_t[_table_size];
+
+    // Identity mapping by default - this also lets a device written without
+    // the adapter (shifted by the journal blocks) keep working
+    for (uint32_t i = 0; i < _log_count; i++) {
+        _log_to_phys[i] = journal_blocks + i;
+    }
+    for (uint32_t i = 0; i < _spare_count; i++) {
+        _pool[i] = journal_blocks + _log_count + i;
+    }
+    memset(_erase_counts, 0, _phys_count * sizeof(uint32_t));
+    _migrations = 0;
+
+    // Find the active journal block - the valid table with the newer version
+    bool valid[journal_blocks];
+    uint32_t versions[journal_blocks];
+    int8_t active = -1;
+    for (uint8_t area = 0; area < journal_blocks; area++) {
+        err = journal_read_table(area, valid[area], versions[area]);
+        if (err) {
+            goto fail;
+        }
+    }
+
+    if (valid[0] && valid[1]) {
+        active = ((versions[0] > versions[1]) || (!versions[0])) ? 0 : 1;
+    } else if (valid[0]) {
+        active = 0;
+    } else if (valid[1]) {
+        active = 1;
+    }
+
+    if (active < 0) {
+        // Fresh device - write an identity table to journal block 0
+        _journal_area = 1;
+        _journal_version = 0;
+        err = journal_compact();
+        if (err) {
+            goto fail;
+        }
+    } else {
+        _journal_area = active;
+        _journal_version = versions[active];
+        err = journal_read_table(_journal_area, valid[0], versions[0]);
+        if (err) {
+            goto fail;
+        }
+        journal_apply_table();
+        err = journal_replay_records(_journal_area, _journal_offset);
+        if (err) {
+            goto fail;
+        }
+
+        // Rebuild the spare pool - every physical block that is neither a
+        // journal block nor mapped belongs to it
+        uint32_t found = 0;
+        for (uint32_t phys = journal_blocks; phys < _phys_count; phys++) {
+            bool mapped = false;
+            for (uint32_t i = 0; i < _log_count; i++) {
+                if (_log_to_phys[i] == phys) {
+                    mapped = true;
+                    break;
+                }
+            }
+            if (!mapped) {
+                if (found == _spare_count) {
+                    err = BD_ERROR_DEVICE_ERROR;
+                    goto fail;
+                }
+                _pool[found++] = phys;
+            }
+        }
+        if (found != _spare_count) {
+            err = BD_ERROR_DEVICE_ERROR;
+            goto fail;
+        }
+    }
+
+    _is_initialized = true;
+    return BD_ERROR_OK;
+
+fail:
+    delete[] _log_to_phys;
+    delete[] _erase_counts;
+    delete[] _pool;
+    delete[] _copy_buf;
+    delete[] _table_buf;
+    _log_to_phys = 0;
+    _erase_counts = 0;
+    _pool = 0;
+    _copy_buf = 0;
+    _table_buf = 0;
+    return err;
+}
+
+int WearLevelingBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    delete[] _log_to_phys;
+    delete[] _erase_counts;
+    delete[] _pool;
+    delete[] _copy_buf;
+    delete[] _table_buf;
+    _log_to_phys = 0;
+    _erase_counts = 0;
+    _pool = 0;
+    _copy_buf = 0;
+    _table_buf = 0;
+    _is_initialized = false;
+
+    return _bd->deinit();
+}
+
+int WearLevelingBlockDevice::sync()
+{
+    return _bd->sync();
+}
+
+bd_addr_t WearLevelingBlockDevice::phys_addr(uint32_t block) const
+{
+    return (bd_addr_t)_log_to_phys[block] * _erase_size;
+}
+
+int WearLevelingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_is_initialized);
+    MBED_ASSERT(is_valid_read(addr, size));
+    uint8_t *buffer = static_cast<uint8_t *>(b);
+
+    while (size > 0) {
+        uint32_t block = addr / _erase_size;
+        bd_size_t off = addr % _erase_size;
+        bd_size_t chunk = _erase_size - off;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        int err = _bd->read(buffer, phys_addr(block) + off, chunk);
+        if (err) {
+            return err;
+        }
+
+        buffer += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_is_initialized);
+    MBED_ASSERT(is_valid_program(addr, size));
+    const uint8_t *buffer = static_cast<const uint8_t *>(b);
+
+    while (size > 0) {
+        uint32_t block = addr / _erase_size;
+        bd_size_t off = addr % _erase_size;
+        bd_size_t chunk = _erase_size - off;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        int err = _bd->program(buffer, phys_addr(block) + off, chunk);
+        if (err) {
+            return err;
+        }
+
+        buffer += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(_is_initialized);
+    MBED_ASSERT(is_valid_erase(addr, size));
+
+    while (size > 0) {
+        int err = remap_and_erase(addr / _erase_size);
+        if (err) {
+            return err;
+        }
+
+        addr += _erase_size;
+        size -= _erase_size;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::remap_and_erase(uint32_t block)
+{
+    int err;
+
+    // Pick the least worn spare as the new home of the logical block
+    uint32_t slot = 0;
+    for (uint32_t i = 1; i < _spare_count; i++) {
+        if (_erase_counts[_pool[i]] < _erase_counts[_pool[slot]]) {
+            slot = i;
+        }
+    }
+    uint32_t fresh = _pool[slot];
+
+    // Hot/cold rotation - if even the best spare has seen far more erases
+    // than the coldest mapped block, move that block's (static) data into
+    // the spare and give the hot logical block the cold physical block, so
+    // rarely written data absorbs the worn blocks
+    uint32_t coldest = 0;
+    for (uint32_t i = 1; i < _log_count; i++) {
+        if (_erase_counts[_log_to_phys[i]] < _erase_counts[_log_to_phys[coldest]]) {
+            coldest = i;
+        }
+    }
+    if ((coldest != block) &&
+            (_erase_counts[fresh] > _erase_counts[_log_to_phys[coldest]] + _migration_threshold)) {
+        err = _bd->erase((bd_addr_t)fresh * _erase_size, _erase_size);
+        if (err) {
+            return err;
+        }
+        _erase_counts[fresh]++;
+
+        uint32_t cold_phys = _log_to_phys[coldest];
+        err = copy_block(cold_phys, fresh);
+        if (err) {
+            return err;
+        }
+        _log_to_phys[coldest] = fresh;
+        err = journal_append(coldest, fresh, _erase_counts[fresh]);
+        if (err) {
+            return err;
+        }
+
+        fresh = cold_phys;
+        _migrations++;
+    }
+
+    err = _bd->erase((bd_addr_t)fresh * _erase_size, _erase_size);
+    if (err) {
+        return err;
+    }
+    _erase_counts[fresh]++;
+
+    _pool[slot] = _log_to_phys[block];
+    _log_to_phys[block] = fresh;
+    return journal_append(block, fresh, _erase_counts[fresh]);
+}
+
+int WearLevelingBlockDevice::copy_block(uint32_t from_phys, uint32_t to_phys)
+{
+    bd_addr_t from = (bd_addr_t)from_phys * _erase_size;
+    bd_addr_t to = (bd_addr_t)to_phys * _erase_size;
+
+    for (bd_size_t off = 0; off < _erase_size; off += _prog_size) {
+        int err = _bd->read(_copy_buf, from + off, _prog_size);
+        if (err) {
+            return err;
+        }
+        err = _bd->program(_copy_buf, to + off, _prog_size);
+        if (err) {
+            return err;
+        }
+    }
+
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::journal_write(uint8_t area, uint32_t offset,
+        uint32_t logical, uint32_t physical, uint32_t erase_count)
+{
+    wl_record_t rec;
+    rec.magic = wl_magic;
+    rec.logical = logical;
+    rec.physical = physical;
+    rec.erase_count = erase_count;
+    rec.crc = crc32(initial_crc, sizeof(rec) - sizeof(rec.crc), (const uint8_t *) &rec);
+
+    memset(_copy_buf, blank_flash_val, _rec_size);
+    memcpy(_copy_buf, &rec, sizeof(rec));
+    return _bd->program(_copy_buf, (bd_addr_t)area * _erase_size + offset, _rec_size);
+}
+
+int WearLevelingBlockDevice::journal_append(uint32_t logical, uint32_t physical, uint32_t erase_count)
+{
+    if (_journal_offset + _rec_size > _erase_size) {
+        // Journal is full - the compaction persists the whole state,
+        // including this update, so no record is needed
+        return journal_compact();
+    }
+
+    int err = journal_write(_journal_area, _journal_offset, logical, physical, erase_count);
+    if (err) {
+        return err;
+    }
+
+    _journal_offset += _rec_size;
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::journal_compact()
+{
+    uint8_t other = 1 - _journal_area;
+
+    int err = _bd->erase((bd_addr_t)other * _erase_size, _erase_size);
+    if (err) {
+        return err;
+    }
+    _erase_counts[other]++;
+
+    // Serialize the whole state into the table blob. A crash while
+    // programming leaves the blob's CRC invalid, so the old journal block
+    // stays authoritative.
+    memset(_table_buf, blank_flash_val, _table_size);
+    wl_table_header_t *header = (wl_table_header_t *) _table_buf;
+    uint8_t *map = _table_buf + sizeof(wl_table_header_t);
+    uint8_t *counts = map + align_up(2 * _log_count, 4);
+
+    header->magic = wl_magic;
+    header->version = _journal_version + 1;
+    header->log_count = _log_count;
+    header->phys_count = _phys_count;
+    for (uint32_t i = 0; i < _log_count; i++) {
+        uint16_t phys = _log_to_phys[i];
+        memcpy(map + 2 * i, &phys, sizeof(phys));
+    }
+    memcpy(counts, _erase_counts, 4 * _phys_count);
+
+    uint32_t crc = crc32(initial_crc, sizeof(*header) - sizeof(header->crc), _table_buf);
+    crc = crc32(crc, align_up(2 * _log_count, 4) + 4 * _phys_count, map);
+    header->crc = crc;
+
+    err = _bd->program(_table_buf, (bd_addr_t)other * _erase_size, _table_size);
+    if (err) {
+        return err;
+    }
+
+    _journal_version++;
+    _journal_area = other;
+    _journal_offset = align_up(_table_size, _rec_size);
+    return BD_ERROR_OK;
+}
+
+int WearLevelingBlockDevice::journal_read_table(uint8_t area, bool &valid, uint32_t &version)
+{
+    valid = false;
+    version = 0;
+
+    int err = _bd->read(_table_buf, (bd_addr_t)area * _erase_size, _table_size);
+    if (err) {
+        return err;
+    }
+
+    wl_table_header_t *header = (wl_table_header_t *) _table_buf;
+    if ((header->magic != wl_magic) ||
+            (header->log_count != _log_count) || (header->phys_count != _phys_count)) {
+        return BD_ERROR_OK;
+    }
+
+    uint8_t *map = _table_buf + sizeof(wl_table_header_t);
+    uint32_t crc = crc32(initial_crc, sizeof(*header) - sizeof(header->crc), _table_buf);
+    crc = crc32(crc, align_up(2 * _log_count, 4) + 4 * _phys_count, map);
+    if (header->crc != crc) {
+        return BD_ERROR_OK;
+    }
+
+    valid = true;
+    version = header->version;
+    return BD_ERROR_OK;
+}
+
+void WearLevelingBlockDevice::journal_apply_table()
+{
+    uint8_t *map = _table_buf + sizeof(wl_table_header_t);
+    uint8_t *counts = map + align_up(2 * _log_count, 4);
+
+    for (uint32_t i = 0; i < _log_count; i++) {
+        uint16_t phys;
+        memcpy(&phys, map + 2 * i, sizeof(phys));
+        _log_to_phys[i] = phys;
+    }
+    memcpy(_erase_counts, counts, 4 * _phys_count);
+}
+
+int WearLevelingBlockDevice::journal_replay_records(uint8_t area, uint32_t &next_offset)
+{
+    uint32_t offset = align_up(_table_size, _rec_size);
+
+    while (offset + _rec_size <= _erase_size) {
+        wl_record_t rec;
+        int err = _bd->read(_copy_buf, (bd_addr_t)area * _erase_size + offset, _rec_size);
+        if (err) {
+            return err;
+        }
+        memcpy(&rec, _copy_buf, sizeof(rec));
+
+        bool blank = true;
+        for (uint32_t i = 0; i < sizeof(rec); i++) {
+            if (_copy_buf[i] != blank_flash_val) {
+                blank = false;
+                break;
+            }
+        }
+        if (blank) {
+            // First free slot - appends continue here
+            break;
+        }
+
+        uint32_t crc = crc32(initial_crc, sizeof(rec) - sizeof(rec.crc), (const uint8_t *) &rec);
+        if ((rec.magic != wl_magic) || (rec.crc != crc)) {
+            // Torn append - skip the slot so we never program it twice
+            offset += _rec_size;
+            break;
+        }
+
+        if ((rec.logical < _log_count) && (rec.physical < _phys_count)) {
+            _log_to_phys[rec.logical] = rec.physical;
+            _erase_counts[rec.physical] = rec.erase_count;
+        }
+        offset += _rec_size;
+    }
+
+    next_offset = offset;
+    return BD_ERROR_OK;
+}
+
+bd_size_t WearLevelingBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t WearLevelingBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t WearLevelingBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+int WearLevelingBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t WearLevelingBlockDevice::size() const
+{
+    return (bd_size_t)_log_count * _erase_size;
+}
+
+void WearLevelingBlockDevice::get_wear_stats(bd_wear_stats *stats) const
+{
+    MBED_ASSERT(_is_initialized);
+
+    stats->min_erase_count = _erase_counts[0];
+    stats->max_erase_count = _erase_counts[0];
+    stats->total_erase_count = 0;
+    stats->block_count = _phys_count;
+    stats->migration_count = _migrations;
+
+    for (uint32_t i = 0; i < _phys_count; i++) {
+        if (_erase_counts[i] < stats->min_erase_count) {
+            stats->min_erase_count = _erase_counts[i];
+        }
+        if (_erase_counts[i] > stats->max_erase_count) {
+            stats->max_erase_count = _erase_counts[i];
+        }
+        stats->total_erase_count += _erase_counts[i];
+    }
+}
+
+uint32_t WearLevelingBlockDevice::get_erase_count(bd_addr_t addr) const
+{
+    MBED_ASSERT(_is_initialized);
+    MBED_ASSERT(addr < size());
+    return _erase_counts[_log_to_phys[addr / _erase_size]];
+}
@@ -0,0 +1,225 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_WEAR_LEVELING_BLOCK_DEVICE_H
+#define MBED_WEAR_LEVELING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+
+/** Block device adapter which levels erase wear across the underlying device
+ *
+ *  Filesystems such as FAT erase a few blocks (the allocation tables) far
+ *  more often than the rest, which exhausts those blocks on raw NOR flash
+ *  long before the others. This adapter presents a slightly smaller logical
+ *  device and remaps each logical erase block to a physical one: every erase
+ *  moves the logical block to the least worn block of a spare pool, and
+ *  rarely erased (cold) blocks are rotated into worn blocks once the wear
+ *  gap crosses a threshold, so static data absorbs traffic from hot blocks.
+ *
+ *  The logical to physical map and the per block erase counts are persisted
+ *  in a journal kept in two reserved erase blocks, so the mapping survives
+ *  reboot. The underlying device must have a uniform erase size.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "WearLevelingBlockDevice.h"
+ *  #include "SPIFBlockDevice.h"
+ *
+ *  SPIFBlockDevice spif(PTE2, PTE4, PTE1, PTE5);
+ *  WearLevelingBlockDevice bd(&spif);
+ *  @endcode
+ */
+class WearLevelingBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the wear-leveling block device
+     *
+     *  @param bd         Block device to level wear across
+     *  @param spare_count
+     *      Number of physical erase blocks kept in the spare pool that
+     *      erased logical blocks rotate through. A larger pool spreads
+     *      wear faster at the cost of capacity.
+     *  @param migration_threshold
+     *      Difference in erase counts between the candidate spare block
+     *      and the coldest mapped block above which the cold block's data
+     *      is migrated into the spare, rotating static data into worn
+     *      blocks. A smaller threshold levels static data more evenly at
+     *      the cost of extra block copies.
+     */
+    WearLevelingBlockDevice(BlockDevice *bd, uint32_t spare_count = 2, uint32_t migration_threshold = 16);
+    virtual ~WearLevelingBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  Rebuilds the logical to physical map from the journal, or formats
+     *  a fresh journal with an identity mapping if none is found
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  Each erased logical block is remapped to the least worn block of
+     *  the spare pool, and its previous physical block joins the pool
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the logical device in bytes, which is smaller
+     *                  than the underlying device by the journal and spare blocks
+     */
+    virtual bd_size_t size() const;
+
+    /** Wear statistics over the physical erase blocks
+     */
+    struct bd_wear_stats {
+        uint32_t min_erase_count;   /*!< erase count of the least worn block */
+        uint32_t max_erase_count;   /*!< erase count of the most worn block */
+        uint64_t total_erase_count; /*!< sum of all erase counts */
+        uint32_t block_count;       /*!< number of physical erase blocks */
+        uint32_t migration_count;   /*!< cold block migrations since init */
+    };
+
+    /** Get wear statistics for health monitoring
+     *
+     *  @param stats    Destination for the wear statistics
+     */
+    void get_wear_stats(bd_wear_stats *stats) const;
+
+    /** Get the erase count of the physical block backing a logical address
+     *
+     *  @param addr     Logical address within the erase block
+     *  @return         Number of erases the backing physical block has seen
+     */
+    uint32_t get_erase_count(bd_addr_t addr) const;
+
+protected:
+    // Translate a logical block index to the base address of its physical block
+    bd_addr_t phys_addr(uint32_t block) const;
+
+    // Remap a logical block to a freshly erased block from the spare pool,
+    // rotating cold data into worn blocks when the wear gap demands it
+    int remap_and_erase(uint32_t block);
+
+    // Copy the contents of one physical block into another (erased) one
+    int copy_block(uint32_t from_phys, uint32_t to_phys);
+
+    // Persist one map update, compacting the journal into the other
+    // reserved block when the active one is full
+    int journal_append(uint32_t logical, uint32_t physical, uint32_t erase_count);
+
+    // Rewrite the whole map and erase-count table into the other journal
+    // block with a bumped version, and switch to it
+    int journal_compact();
+
+    // Write one update record at the given offset of a journal block
+    int journal_write(uint8_t area, uint32_t offset, uint32_t logical, uint32_t physical, uint32_t erase_count);
+
+    // Read a journal block's table into _table_buf and validate it
+    int journal_read_table(uint8_t area, bool &valid, uint32_t &version);
+
+    // Apply the table in _table_buf to the RAM tables
+    void journal_apply_table();
+
+    // Replay the update records following the table of the given area,
+    // returning the offset of the first free record slot
+    int journal_replay_records(uint8_t area, uint32_t &next_offset);
+
+    BlockDevice *_bd;
+    uint32_t _spare_count;
+    uint32_t _migration_threshold;
+    bd_size_t _erase_size;
+    bd_size_t _prog_size;
+    uint32_t _rec_size;
+    uint32_t _phys_count;
+    uint32_t _log_count;
+    uint32_t *_log_to_phys;
+    uint32_t *_erase_counts;
+    uint32_t *_pool;
+    uint8_t *_copy_buf;
+    uint8_t *_table_buf;
+    uint32_t _table_size;
+    uint8_t _journal_area;
+    uint32_t _journal_offset;
+    uint32_t _journal_version;
+    uint32_t _migrations;
+    bool _is_initialized;
+};
+
+
+#endif
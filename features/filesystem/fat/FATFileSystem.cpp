@@ -28,6 +28,7 @@
 #include <errno.h>
 
 #include "FATFileSystem.h"
+#include "events/EventQueue.h"
 
 
 ////// Error handling /////
@@ -141,6 +142,11 @@ static Deferred<const char*> fat_path_prefix(int id, const char *path)
 
 // Global access to block device from FAT driver
 static BlockDevice *_ffs[FF_VOLUMES] = {0};
+
+// Protects the volume table above and FatFs's volume registration during
+// mount and unmount. Ordinary operations only take the per-mount lock, so
+// filesystems on different block devices no longer serialize each other;
+// FatFs is re-entrant for accesses to different volumes.
 static SingletonPtr<PlatformMutex> _ffs_mutex;
 
 
@@ -304,6 +310,7 @@ int FATFileSystem::mount(BlockDevice *bd, bool mount)
         return -EINVAL;
     }
 
+    _ffs_mutex->lock();
     for (int i = 0; i < FF_VOLUMES; i++) {
         if (!_ffs[i]) {
             _id = i;
@@ -313,15 +320,46 @@ int FATFileSystem::mount(BlockDevice *bd, bool mount)
             _fsid[2] = '\0';
             debug_if(FFS_DBG, "Mounting [%s] on ffs drive [%s]\n", getName(), _fsid);
             FRESULT res = f_mount(&_fs, _fsid, mount);
+            _ffs_mutex->unlock();
             unlock();
             return fat_error_remap(res);
         }
     }
 
+    _ffs_mutex->unlock();
     unlock();
     return -ENOMEM;
 }
 
+int FATFileSystem::mount(BlockDevice *bd, events::EventQueue *queue)
+{
+    int err = mount(bd, true);
+    if (err) {
+        return err;
+    }
+
+    // Mounting above only read and validated the boot and FSInfo sectors.
+    // Counting the free clusters still means walking the FAT tables, so warm
+    // that up in the background instead of charging it to the first caller
+    // that asks for the count. If the queue is full nothing is lost, the
+    // first statvfs() simply performs the scan itself.
+    queue->call(this, &FATFileSystem::scan_free_clusters);
+    return 0;
+}
+
+void FATFileSystem::scan_free_clusters()
+{
+    FATFS *fs;
+    DWORD fre_clust;
+
+    lock();
+    if (_id != -1) {
+        // Fills fs->free_clst, so later f_getfree() calls return immediately
+        f_getfree(_fsid, &fre_clust, &fs);
+    }
+    unlock();
+}
+
 int FATFileSystem::unmount()
 {
     lock();
@@ -330,9 +368,11 @@ int FATFileSystem::unmount()
         return -EINVAL;
     }
 
+    _ffs_mutex->lock();
     FRESULT res = f_mount(NULL, _fsid, 0);
     _ffs[_id] = NULL;
     _id = -1;
+    _ffs_mutex->unlock();
     unlock();
     return fat_error_remap(res);
 }
@@ -559,12 +599,12 @@ int FATFileSystem::statvfs(const char *path, struct statvfs *buf)
 
 void FATFileSystem::lock()
 {
-    _ffs_mutex->lock();
+    _mutex.lock();
 }
 
 void FATFileSystem::unlock()
 {
-    _ffs_mutex->unlock();
+    _mutex.unlock();
 }
 
 
@@ -660,6 +700,34 @@ ssize_t FATFileSystem::file_write(fs_file_t file, const void *buffer, size_t len
     }
 }
 
+ssize_t FATFileSystem::file_write_direct(fs_file_t file, const void *buffer, size_t len)
+{
+    FIL *fh = static_cast<FIL*>(file);
+
+    lock();
+    UINT ssize = fh->obj.fs->ssize;
+    if ((fh->fptr % ssize) || (len % ssize)) {
+        // A misaligned transfer would silently stage through the sector
+        // window, which is exactly what the caller asked to avoid
+        unlock();
+        return -EINVAL;
+    }
+
+    // On sector boundaries f_write() hands maximum runs of contiguous
+    // sectors straight from the caller's buffer to disk_write(); the
+    // window buffer is only used for the FAT updates themselves
+    UINT n;
+    FRESULT res = f_write(fh, buffer, len, &n);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_write() failed: %d", res);
+        return fat_error_remap(res);
+    } else {
+        return n;
+    }
+}
+
 int FATFileSystem::file_sync(fs_file_t file)
 {
     FIL *fh = static_cast<FIL*>(file);
@@ -719,6 +787,161 @@ off_t FATFileSystem::file_size(fs_file_t file)
     return res;
 }
 
+ssize_t FATFileSystem::file_pread(fs_file_t file, void *buffer, size_t len, off_t offset)
+{
+    FIL *fh = static_cast<FIL*>(file);
+
+    lock();
+    FSIZE_t fptr = f_tell(fh);
+    FRESULT res = f_lseek(fh, offset);
+    if (res != FR_OK) {
+        unlock();
+        debug_if(FFS_DBG, "lseek failed: %d\n", res);
+        return fat_error_remap(res);
+    }
+
+    UINT n;
+    res = f_read(fh, buffer, len, &n);
+    FRESULT rres = f_lseek(fh, fptr);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_read() failed: %d\n", res);
+        return fat_error_remap(res);
+    } else if (rres != FR_OK) {
+        debug_if(FFS_DBG, "lseek failed: %d\n", rres);
+        return fat_error_remap(rres);
+    } else {
+        return n;
+    }
+}
+
+ssize_t FATFileSystem::file_pwrite(fs_file_t file, const void *buffer, size_t len, off_t offset)
+{
+    FIL *fh = static_cast<FIL*>(file);
+
+    lock();
+    FSIZE_t fptr = f_tell(fh);
+    FRESULT res = f_lseek(fh, offset);
+    if (res != FR_OK) {
+        unlock();
+        debug_if(FFS_DBG, "lseek failed: %d\n", res);
+        return fat_error_remap(res);
+    }
+
+    UINT n;
+    res = f_write(fh, buffer, len, &n);
+    FRESULT rres = f_lseek(fh, fptr);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_write() failed: %d\n", res);
+        return fat_error_remap(res);
+    } else if (rres != FR_OK) {
+        debug_if(FFS_DBG, "lseek failed: %d\n", rres);
+        return fat_error_remap(rres);
+    } else {
+        return n;
+    }
+}
+
+int FATFileSystem::file_preallocate(fs_file_t file, off_t size)
+{
+    FIL *fh = static_cast<FIL*>(file);
+
+    lock();
+    FRESULT res = f_expand(fh, size, 1);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+    }
+    return fat_error_remap(res);
+}
+
+int FATFileSystem::file_contiguous(fs_file_t file, bool *contiguous)
+{
+    FIL *fh = static_cast<FIL*>(file);
+
+    *contiguous = false;
+
+    lock();
+    FSIZE_t fptr = f_tell(fh);
+    FSIZE_t fsize = f_size(fh);
+
+    /* Based on ChaN's application note on checking file contiguity - seek
+     * through the file a cluster at a time and check that each cluster
+     * immediately follows the previous one */
+    FRESULT res = f_rewind(fh);
+    if (res == FR_OK && fsize > 0) {
+#if FF_MAX_SS == FF_MIN_SS
+        DWORD clsize = (DWORD)fh->obj.fs->csize * FF_MAX_SS;
+#else
+        DWORD clsize = (DWORD)fh->obj.fs->csize * fh->obj.fs->ssize;
+#endif
+        /* A cluster leading the first cluster for the first test */
+        DWORD clust = fh->obj.sclust - 1;
+        FSIZE_t left = fsize;
+        while (left) {
+            DWORD step = (left >= clsize) ? clsize : (DWORD)left;
+            res = f_lseek(fh, f_tell(fh) + step);
+            if (res != FR_OK) {
+                break;
+            }
+            if (clust + 1 != fh->clust) {
+                break;
+            }
+            clust = fh->clust;
+            left -= step;
+        }
+        if (res == FR_OK && left == 0) {
+            *contiguous = true;
+        }
+    }
+
+    if (res == FR_OK) {
+        res = f_lseek(fh, fptr);
+    }
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "file_contiguous failed: %d\n", res);
+    }
+    return fat_error_remap(res);
+}
+
+int FATFileSystem::file_get_mapping(fs_file_t file, const void **addr)
+{
+    FIL *fh = static_cast<FIL*>(file);
+
+    bool contiguous = false;
+    int err = file_contiguous(file, &contiguous);
+    if (err) {
+        return err;
+    } else if (!contiguous) {
+        return -EINVAL;
+    }
+
+    lock();
+#if FF_MAX_SS == FF_MIN_SS
+    DWORD ssize = FF_MAX_SS;
+#else
+    DWORD ssize = fh->obj.fs->ssize;
+#endif
+    DWORD sect = fh->obj.fs->database
+            + (DWORD)fh->obj.fs->csize * (fh->obj.sclust - 2);
+    const void *mapping = _ffs[_id]->get_mapped_read_address(
+            (bd_addr_t)sect * ssize, f_size(fh));
+    unlock();
+
+    if (!mapping) {
+        return -ENOSYS;
+    }
+
+    *addr = mapping;
+    return 0;
+}
+
 
 ////// Dir operations //////
 int FATFileSystem::dir_open(fs_dir_t *dir, const char *path)
@@ -781,6 +1004,44 @@ ssize_t FATFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return 1;
 }
 
+ssize_t FATFileSystem::dir_read(fs_dir_t dir, struct dirent *ents, size_t count)
+{
+    FATFS_DIR *dh = static_cast<FATFS_DIR*>(dir);
+    FILINFO finfo;
+    size_t n = 0;
+
+    // One lock acquisition for the whole batch. f_readdir() reads ahead
+    // through its sector window, so consecutive entries in the same
+    // directory block cost no extra media access.
+    lock();
+    while (n < count) {
+        FRESULT res = f_readdir(dh, &finfo);
+        if (res != FR_OK) {
+            unlock();
+            return fat_error_remap(res);
+        } else if (finfo.fname[0] == 0) {
+            break;
+        }
+
+        struct dirent *ent = &ents[n];
+        ent->d_type = (finfo.fattrib & AM_DIR) ? DT_DIR : DT_REG;
+
+#if FF_USE_LFN
+        if (ent->d_name[0] == 0) {
+            // No long filename so use short filename.
+            strncpy(ent->d_name, finfo.fname, FF_LFN_BUF);
+        }
+#else
+        strncpy(ent->d_name, finfo.fname, FF_SFN_BUF);
+#endif
+
+        n++;
+    }
+    unlock();
+
+    return n;
+}
+
 void FATFileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
     FATFS_DIR *dh = static_cast<FATFS_DIR*>(dir);
@@ -29,6 +29,10 @@
 #include <stdint.h>
 #include "PlatformMutex.h"
 
+namespace events {
+class EventQueue;
+}
+
 using namespace mbed;
 
 /**
@@ -69,6 +73,25 @@ public:
      */
     virtual int mount(BlockDevice *bd);
 
+    /** Mounts a filesystem to a block device, deferring the FAT table scan
+     *
+     *  Only the boot sector and the FSInfo sector are read and validated
+     *  before this call returns. Counting the free clusters - which walks
+     *  the FAT tables and dominates the mount cost on large cards whose
+     *  FSInfo sector is stale - is posted to the given event queue and runs
+     *  in the background. File operations proceed immediately; statvfs()
+     *  blocks until the scan has finished, or performs the scan itself if
+     *  the background job has not run yet.
+     *
+     *  The filesystem must stay mounted until the posted scan has been
+     *  dispatched or the queue has been torn down.
+     *
+     *  @param bd       BlockDevice to mount to
+     *  @param queue    EventQueue the deferred scan is posted to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int mount(BlockDevice *bd, events::EventQueue *queue);
+
     /** Unmounts a filesystem from the underlying block device
      *
      *  @return         0 on success, negative error code on failure
@@ -216,6 +239,85 @@ protected:
      */
     virtual off_t file_size(fs_file_t file);
 
+    /** Read from a file at a given offset, without moving the file position
+     *
+     *  The seek, read and position restore happen atomically under the
+     *  mount lock, so concurrent readers can share one file handle.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param len      The number of bytes to read
+     *  @param offset   The offset in the file to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_pread(fs_file_t file, void *buffer, size_t len, off_t offset);
+
+    /** Write to a file at a given offset, without moving the file position
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to write from
+     *  @param len      The number of bytes to write
+     *  @param offset   The offset in the file to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_pwrite(fs_file_t file, const void *buffer, size_t len, off_t offset);
+
+    /** Write whole sectors to a file without intermediate buffering
+     *
+     *  With the file position and length on sector boundaries, FatFs hands
+     *  every sector straight from the caller's buffer to the block device;
+     *  the shared window buffer is only touched for the FAT updates
+     *  themselves. Misaligned requests are rejected rather than silently
+     *  staged through the window.
+     *
+     *  @param file     File handle, positioned on a sector boundary
+     *  @param buffer   The buffer to write from
+     *  @param len      The number of bytes to write, a multiple of the
+     *                  sector size
+     *  @return         The number of bytes written, negative error on failure,
+     *                  -EINVAL if position or length are misaligned
+     */
+    virtual ssize_t file_write_direct(fs_file_t file, const void *buffer, size_t len);
+
+    /** Preallocate storage for a file
+     *
+     *  Maps to f_expand, which reserves one contiguous run of clusters so
+     *  subsequent appends up to the preallocated size never touch the FAT
+     *  and never fragment. The file size becomes the preallocated size;
+     *  the contents of the extended region are undefined until written.
+     *
+     *  @param file     File handle, must be open for writing
+     *  @param size     Size to preallocate in bytes, must be larger than zero
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_preallocate(fs_file_t file, off_t size);
+
+    /** Check whether a file occupies one contiguous run of clusters
+     *
+     *  Walks the file's cluster chain, so the cost is proportional to the
+     *  file size. The file position is preserved.
+     *
+     *  @param file     File handle
+     *  @param contiguous Set to true if the file is stored contiguously
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_contiguous(fs_file_t file, bool *contiguous);
+
+    /** Get a pointer for reading the file's contents in place
+     *
+     *  Checks that the file occupies one contiguous run of clusters and
+     *  asks the underlying block device for a direct pointer to them,
+     *  which is only available on directly addressable storage such as
+     *  internal flash. The file position is preserved.
+     *
+     *  @param file     File handle
+     *  @param addr     Destination for the pointer to the file's contents
+     *  @return         0 on success, negative error code on failure,
+     *                  -ENOSYS if the storage is not directly addressable,
+     *                  -EINVAL if the file is empty or not stored contiguously
+     */
+    virtual int file_get_mapping(fs_file_t file, const void **addr);
+
     /** Open a directory on the filesystem
      *
      *  @param dir      Destination for the handle to the directory
@@ -239,6 +341,19 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read up to count directory entries in one call
+     *
+     *  The whole batch is read under a single lock acquisition, letting
+     *  FatFs reuse its sector window across consecutive entries.
+     *
+     *  @param dir      Dir handle
+     *  @param ents     Array of directory entries to fill out
+     *  @param count    Number of entries the array has room for
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ents, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle
@@ -264,6 +379,9 @@ private:
     FATFS _fs; // Work area (file system object) for logical drive
     char _fsid[sizeof("0:")];
     int _id;
+    PlatformMutex _mutex; // Serializes operations on this mount only
+
+    void scan_free_clusters();
 
 protected:
     virtual void lock();
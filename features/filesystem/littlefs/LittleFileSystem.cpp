@@ -81,6 +81,13 @@ static int lfs_totype(int type)
     }
 }
 
+// A file handle remembers whether it can modify the filesystem, so closing
+// a read-only file does not need to invalidate the entry cache
+struct mbed_lfs_file {
+    lfs_file_t file; // must be first, handles are also cast to lfs_file_t
+    bool writable;
+};
+
 
 ////// Block device operations //////
 static int lfs_bd_read(const struct lfs_config *c, lfs_block_t block,
@@ -119,6 +126,10 @@ LittleFileSystem::LittleFileSystem(const char *name, BlockDevice *bd,
         , _prog_size(prog_size)
         , _block_size(block_size)
         , _lookahead(lookahead) {
+#if MBED_LFS_ENTRY_CACHE
+    entry_cache_drop();
+    _entry_lru = 0;
+#endif
     if (bd) {
         mount(bd);
     }
@@ -129,6 +140,52 @@ LittleFileSystem::~LittleFileSystem() {
     unmount();
 }
 
+#if MBED_LFS_ENTRY_CACHE
+void LittleFileSystem::entry_cache_drop()
+{
+    for (int i = 0; i < MBED_LFS_ENTRY_CACHE; i++) {
+        _entry_cache[i].type = -1;
+    }
+}
+
+LittleFileSystem::lfs_entry_cache *LittleFileSystem::entry_cache_find(const char *path)
+{
+    for (int i = 0; i < MBED_LFS_ENTRY_CACHE; i++) {
+        if (_entry_cache[i].type >= 0 && strcmp(_entry_cache[i].path, path) == 0) {
+            _entry_cache[i].lru = ++_entry_lru;
+            return &_entry_cache[i];
+        }
+    }
+    return NULL;
+}
+
+void LittleFileSystem::entry_cache_insert(const char *path, int8_t type, lfs_size_t size)
+{
+    if (strlen(path) >= sizeof(_entry_cache[0].path)) {
+        return;
+    }
+
+    lfs_entry_cache *entry = entry_cache_find(path);
+    if (!entry) {
+        // evict the least recently used entry, preferring free slots
+        entry = &_entry_cache[0];
+        for (int i = 0; i < MBED_LFS_ENTRY_CACHE; i++) {
+            if (_entry_cache[i].type < 0) {
+                entry = &_entry_cache[i];
+                break;
+            }
+            if (_entry_cache[i].lru < entry->lru) {
+                entry = &_entry_cache[i];
+            }
+        }
+        strcpy(entry->path, path);
+    }
+    entry->type = type;
+    entry->size = size;
+    entry->lru = ++_entry_lru;
+}
+#endif
+
 int LittleFileSystem::mount(BlockDevice *bd)
 {
     _mutex.lock();
@@ -192,7 +249,11 @@ int LittleFileSystem::unmount()
 
         _bd = NULL;
     }
-    
+
+#if MBED_LFS_ENTRY_CACHE
+    entry_cache_drop();
+#endif
+
     LFS_INFO("unmount -> %d", 0);
     _mutex.unlock();
     return 0;
@@ -301,6 +362,11 @@ int LittleFileSystem::remove(const char *filename)
     LFS_INFO("remove(\"%s\")", filename);
     int err = lfs_remove(&_lfs, filename);
     LFS_INFO("remove -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    // renaming or removing a directory also changes descendant paths,
+    // so drop the whole cache
+    entry_cache_drop();
+#endif
     _mutex.unlock();
     return lfs_toerror(err);
 }
@@ -311,6 +377,9 @@ int LittleFileSystem::rename(const char *oldname, const char *newname)
     LFS_INFO("rename(\"%s\", \"%s\")", oldname, newname);
     int err = lfs_rename(&_lfs, oldname, newname);
     LFS_INFO("rename -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    entry_cache_drop();
+#endif
     _mutex.unlock();
     return lfs_toerror(err);
 }
@@ -321,6 +390,9 @@ int LittleFileSystem::mkdir(const char *name, mode_t mode)
     LFS_INFO("mkdir(\"%s\", 0x%lx)", name, mode);
     int err = lfs_mkdir(&_lfs, name);
     LFS_INFO("mkdir -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    entry_cache_drop();
+#endif
     _mutex.unlock();
     return lfs_toerror(err);
 }
@@ -330,8 +402,26 @@ int LittleFileSystem::stat(const char *name, struct stat *st)
     struct lfs_info info;
     _mutex.lock();
     LFS_INFO("stat(\"%s\", %p)", name, st);
+#if MBED_LFS_ENTRY_CACHE
+    lfs_entry_cache *entry = entry_cache_find(name);
+    if (entry) {
+        int err = entry->type ? LFS_ERR_OK : LFS_ERR_NOENT;
+        LFS_INFO("stat -> %d (cached)", lfs_toerror(err));
+        st->st_size = entry->size;
+        st->st_mode = lfs_tomode(entry->type);
+        _mutex.unlock();
+        return lfs_toerror(err);
+    }
+#endif
     int err = lfs_stat(&_lfs, name, &info);
     LFS_INFO("stat -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    if (!err) {
+        entry_cache_insert(name, info.type, info.size);
+    } else if (err == LFS_ERR_NOENT) {
+        entry_cache_insert(name, 0, 0);
+    }
+#endif
     _mutex.unlock();
     st->st_size = info.size;
     st->st_mode = lfs_tomode(info.type);
@@ -370,11 +460,38 @@ int LittleFileSystem::statvfs(const char *name, struct statvfs *st)
 ////// File operations //////
 int LittleFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 {
-    lfs_file_t *f = new lfs_file_t;
+    mbed_lfs_file *f = new mbed_lfs_file;
+    f->writable = ((flags & 3) != O_RDONLY) ||
+            (flags & (O_CREAT | O_TRUNC | O_APPEND));
     _mutex.lock();
     LFS_INFO("file_open(%p, \"%s\", 0x%x)", *file, path, flags);
-    int err = lfs_file_open(&_lfs, f, path, lfs_fromflags(flags));
+#if MBED_LFS_ENTRY_CACHE
+    if (!f->writable) {
+        lfs_entry_cache *entry = entry_cache_find(path);
+        if (entry && !entry->type) {
+            // the path is known not to exist
+            LFS_INFO("file_open -> %d (cached)", lfs_toerror(LFS_ERR_NOENT));
+            _mutex.unlock();
+            delete f;
+            return lfs_toerror(LFS_ERR_NOENT);
+        }
+    } else {
+        // the open may create or truncate the entry
+        lfs_entry_cache *entry = entry_cache_find(path);
+        if (entry) {
+            entry->type = -1;
+        }
+    }
+#endif
+    int err = lfs_file_open(&_lfs, &f->file, path, lfs_fromflags(flags));
     LFS_INFO("file_open -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    if (!err && !f->writable) {
+        entry_cache_insert(path, LFS_TYPE_REG, lfs_file_size(&_lfs, &f->file));
+    } else if (err == LFS_ERR_NOENT && !(flags & O_CREAT)) {
+        entry_cache_insert(path, 0, 0);
+    }
+#endif
     _mutex.unlock();
     if (!err) {
         *file = f;
@@ -386,11 +503,17 @@ int LittleFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 
 int LittleFileSystem::file_close(fs_file_t file)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    mbed_lfs_file *f = (mbed_lfs_file *)file;
     _mutex.lock();
     LFS_INFO("file_close(%p)", file);
-    int err = lfs_file_close(&_lfs, f);
+    int err = lfs_file_close(&_lfs, &f->file);
     LFS_INFO("file_close -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    if (f->writable) {
+        // closing commits the file, cached sizes may be stale
+        entry_cache_drop();
+    }
+#endif
     _mutex.unlock();
     delete f;
     return lfs_toerror(err);
@@ -418,13 +541,57 @@ ssize_t LittleFileSystem::file_write(fs_file_t file, const void *buffer, size_t
     return lfs_toerror(res);
 }
 
-int LittleFileSystem::file_sync(fs_file_t file)
+ssize_t LittleFileSystem::file_pread(fs_file_t file, void *buffer, size_t len, off_t offset)
 {
     lfs_file_t *f = (lfs_file_t *)file;
     _mutex.lock();
+    LFS_INFO("file_pread(%p, %p, %d, %ld)", file, buffer, len, offset);
+    lfs_soff_t fptr = lfs_file_tell(&_lfs, f);
+    lfs_ssize_t res = lfs_file_seek(&_lfs, f, offset, LFS_SEEK_SET);
+    if (res >= 0) {
+        res = lfs_file_read(&_lfs, f, buffer, len);
+        lfs_soff_t err = lfs_file_seek(&_lfs, f, fptr, LFS_SEEK_SET);
+        if (res >= 0 && err < 0) {
+            res = err;
+        }
+    }
+    LFS_INFO("file_pread -> %d", lfs_toerror(res));
+    _mutex.unlock();
+    return lfs_toerror(res);
+}
+
+ssize_t LittleFileSystem::file_pwrite(fs_file_t file, const void *buffer, size_t len, off_t offset)
+{
+    lfs_file_t *f = (lfs_file_t *)file;
+    _mutex.lock();
+    LFS_INFO("file_pwrite(%p, %p, %d, %ld)", file, buffer, len, offset);
+    lfs_soff_t fptr = lfs_file_tell(&_lfs, f);
+    lfs_ssize_t res = lfs_file_seek(&_lfs, f, offset, LFS_SEEK_SET);
+    if (res >= 0) {
+        res = lfs_file_write(&_lfs, f, buffer, len);
+        lfs_soff_t err = lfs_file_seek(&_lfs, f, fptr, LFS_SEEK_SET);
+        if (res >= 0 && err < 0) {
+            res = err;
+        }
+    }
+    LFS_INFO("file_pwrite -> %d", lfs_toerror(res));
+    _mutex.unlock();
+    return lfs_toerror(res);
+}
+
+int LittleFileSystem::file_sync(fs_file_t file)
+{
+    mbed_lfs_file *f = (mbed_lfs_file *)file;
+    _mutex.lock();
     LFS_INFO("file_sync(%p)", file);
-    int err = lfs_file_sync(&_lfs, f);
+    int err = lfs_file_sync(&_lfs, &f->file);
     LFS_INFO("file_sync -> %d", lfs_toerror(err));
+#if MBED_LFS_ENTRY_CACHE
+    if (f->writable) {
+        // syncing commits the file, cached sizes may be stale
+        entry_cache_drop();
+    }
+#endif
     _mutex.unlock();
     return lfs_toerror(err);
 }
@@ -508,6 +675,34 @@ ssize_t LittleFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::dir_read(fs_dir_t dir, struct dirent *ents, size_t count)
+{
+    lfs_dir_t *d = (lfs_dir_t *)dir;
+    struct lfs_info info;
+    size_t n = 0;
+
+    _mutex.lock();
+    LFS_INFO("dir_read(%p, %p, %d)", dir, ents, (int)count);
+    while (n < count) {
+        int res = lfs_dir_read(&_lfs, d, &info);
+        if (res < 0) {
+            LFS_INFO("dir_read -> %d", lfs_toerror(res));
+            _mutex.unlock();
+            return lfs_toerror(res);
+        } else if (res == 0) {
+            break;
+        }
+
+        ents[n].d_type = lfs_totype(info.type);
+        strcpy(ents[n].d_name, info.name);
+        n++;
+    }
+    LFS_INFO("dir_read -> %d", (int)n);
+    _mutex.unlock();
+
+    return n;
+}
+
 void LittleFileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
     lfs_dir_t *d = (lfs_dir_t *)dir;
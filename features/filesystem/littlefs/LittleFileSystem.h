@@ -187,6 +187,29 @@ protected:
      */
     virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
 
+    /** Read from a file at a given offset, without moving the file position
+     *
+     *  The seek, read and position restore happen atomically under the
+     *  filesystem lock, so concurrent readers can share one file handle.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The offset in the file to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_pread(mbed::fs_file_t file, void *buffer, size_t size, off_t offset);
+
+    /** Write to a file at a given offset, without moving the file position
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The offset in the file to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_pwrite(mbed::fs_file_t file, const void *buffer, size_t size, off_t offset);
+
     /** Flush any buffers associated with the file
      *
      *  @param file     File handle
@@ -243,6 +266,18 @@ protected:
      */
     virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ent);
 
+    /** Read up to count directory entries in one call
+     *
+     *  The whole batch is read under a single lock acquisition.
+     *
+     *  @param dir      Dir handle
+     *  @param ents     Array of directory entries to fill out
+     *  @param count    Number of entries the array has room for
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ents, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle
@@ -275,6 +310,24 @@ private:
     const lfs_size_t _block_size;
     const lfs_size_t _lookahead;
 
+#if MBED_LFS_ENTRY_CACHE
+    // directory-entry cache, serves repeated stat and existence checks of
+    // hot paths from ram instead of retraversing the metadata on disk
+    struct lfs_entry_cache {
+        char path[64];
+        lfs_size_t size;
+        uint32_t lru;
+        int8_t type; // lfs type of the entry, 0 if the path does not exist,
+                     // -1 if the slot is free
+    };
+    lfs_entry_cache _entry_cache[MBED_LFS_ENTRY_CACHE];
+    uint32_t _entry_lru;
+
+    void entry_cache_drop();
+    lfs_entry_cache *entry_cache_find(const char *path);
+    void entry_cache_insert(const char *path, int8_t type, lfs_size_t size);
+#endif
+
     // thread-safe locking
     PlatformMutex _mutex;
 };
@@ -0,0 +1,317 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "LittleFileSystem.h"
+#include "FATFileSystem.h"
+#include "ProfilingBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+
+// test configuration
+#ifndef MBED_TEST_BLOCKDEVICE
+#error [NOT_SUPPORTED] Non-volatile block device required
+#endif
+
+#ifndef MBED_TEST_BLOCKDEVICE_DECL
+#define MBED_TEST_BLOCKDEVICE_DECL MBED_TEST_BLOCKDEVICE bd
+#endif
+
+// raw block device area exercised by the block device passes
+#ifndef MBED_TEST_BENCH_BD_SIZE
+#define MBED_TEST_BENCH_BD_SIZE (64*1024)
+#endif
+
+// file size written and read back by the filesystem passes
+#ifndef MBED_TEST_BENCH_FILE_SIZE
+#define MBED_TEST_BENCH_FILE_SIZE (16*1024)
+#endif
+
+#ifndef MBED_TEST_BUFFER
+#define MBED_TEST_BUFFER 8192
+#endif
+
+#ifndef MBED_TEST_TIMEOUT
+#define MBED_TEST_TIMEOUT 480
+#endif
+
+
+// declarations
+#define STRINGIZE(x) STRINGIZE2(x)
+#define STRINGIZE2(x) #x
+#define INCLUDE(x) STRINGIZE(x.h)
+
+#include INCLUDE(MBED_TEST_BLOCKDEVICE)
+
+MBED_TEST_BLOCKDEVICE_DECL;
+ProfilingBlockDevice profiled(&bd);
+
+uint8_t buffer[MBED_TEST_BUFFER];
+
+static const bd_size_t block_sizes[] = {512, 4096};
+
+
+// Emit one measurement over the greentea console as a "storage_benchmark"
+// key-value pair in the form "name;amount;unit;elapsed_ms;per_sec", so
+// numbers are comparable between targets, parts and builds
+void bench_report(const char *name, const char *unit, uint64_t amount, uint32_t elapsed_ms)
+{
+    uint64_t per_sec = elapsed_ms ? (amount * 1000) / elapsed_ms : 0;
+    char value[96];
+
+    snprintf(value, sizeof(value), "%s;%llu;%s;%lu;%llu",
+             name,
+             (unsigned long long)amount,
+             unit,
+             (unsigned long)elapsed_ms,
+             (unsigned long long)per_sec);
+    greentea_send_kv("storage_benchmark", value);
+    printf("storage_benchmark: %s\n", value);
+}
+
+// Report the block device traffic counted by the profiling layer
+void bench_report_profile(const char *prefix)
+{
+    char name[48];
+    snprintf(name, sizeof(name), "%s_bd_read", prefix);
+    bench_report(name, "bytes", profiled.get_read_count(), 0);
+    snprintf(name, sizeof(name), "%s_bd_program", prefix);
+    bench_report(name, "bytes", profiled.get_program_count(), 0);
+    snprintf(name, sizeof(name), "%s_bd_erase", prefix);
+    bench_report(name, "bytes", profiled.get_erase_count(), 0);
+}
+
+static uint32_t lcg_next(uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static bd_size_t gcd(bd_size_t a, bd_size_t b)
+{
+    while (b) {
+        bd_size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+
+// tests
+
+void test_bd_benchmark()
+{
+    TEST_ASSERT_EQUAL(0, profiled.init());
+    profiled.reset();
+
+    bd_size_t erase_size = profiled.get_erase_size();
+    bd_size_t program_size = profiled.get_program_size();
+    bd_size_t area = MBED_TEST_BENCH_BD_SIZE;
+    if (area > profiled.size()) {
+        area = profiled.size();
+    }
+    area -= area % erase_size;
+    TEST_ASSERT(area > 0);
+
+    char name[48];
+    Timer timer;
+
+    timer.start();
+    TEST_ASSERT_EQUAL(0, profiled.erase(0, area));
+    timer.stop();
+    bench_report("bd_erase", "bytes", area, timer.read_ms());
+
+    for (size_t s = 0; s < sizeof(block_sizes) / sizeof(block_sizes[0]); s++) {
+        bd_size_t chunk = block_sizes[s];
+        if (chunk < program_size) {
+            chunk = program_size;
+        }
+        chunk -= chunk % program_size;
+        if (chunk > MBED_TEST_BUFFER || chunk > area) {
+            continue;
+        }
+        bd_size_t blocks = area / chunk;
+
+        // sequential write
+        TEST_ASSERT_EQUAL(0, profiled.erase(0, area));
+        timer.reset();
+        timer.start();
+        for (bd_size_t i = 0; i < blocks; i++) {
+            TEST_ASSERT_EQUAL(0, profiled.program(buffer, i * chunk, chunk));
+        }
+        timer.stop();
+        snprintf(name, sizeof(name), "bd_write_seq_%lu", (unsigned long)chunk);
+        bench_report(name, "bytes", blocks * chunk, timer.read_ms());
+
+        // random-order write - a stride permutation touches every block
+        // exactly once, so no block is reprogrammed without an erase
+        bd_size_t step = blocks / 2 + 1;
+        while (gcd(step, blocks) != 1) {
+            step++;
+        }
+        TEST_ASSERT_EQUAL(0, profiled.erase(0, area));
+        timer.reset();
+        timer.start();
+        for (bd_size_t i = 0; i < blocks; i++) {
+            TEST_ASSERT_EQUAL(0, profiled.program(buffer, ((i * step) % blocks) * chunk, chunk));
+        }
+        timer.stop();
+        snprintf(name, sizeof(name), "bd_write_rand_%lu", (unsigned long)chunk);
+        bench_report(name, "bytes", blocks * chunk, timer.read_ms());
+
+        // sequential read
+        timer.reset();
+        timer.start();
+        for (bd_size_t i = 0; i < blocks; i++) {
+            TEST_ASSERT_EQUAL(0, profiled.read(buffer, i * chunk, chunk));
+        }
+        timer.stop();
+        snprintf(name, sizeof(name), "bd_read_seq_%lu", (unsigned long)chunk);
+        bench_report(name, "bytes", blocks * chunk, timer.read_ms());
+
+        // random read
+        uint32_t seed = 42;
+        timer.reset();
+        timer.start();
+        for (bd_size_t i = 0; i < blocks; i++) {
+            TEST_ASSERT_EQUAL(0, profiled.read(buffer, (lcg_next(&seed) % blocks) * chunk, chunk));
+        }
+        timer.stop();
+        snprintf(name, sizeof(name), "bd_read_rand_%lu", (unsigned long)chunk);
+        bench_report(name, "bytes", blocks * chunk, timer.read_ms());
+    }
+
+    bench_report_profile("bd");
+    profiled.reset();
+    TEST_ASSERT_EQUAL(0, profiled.deinit());
+}
+
+typedef int (*format_fn)(BlockDevice *bd);
+
+static int littlefs_format(BlockDevice *bd)
+{
+    return LittleFileSystem::format(bd);
+}
+
+static int fat_format(BlockDevice *bd)
+{
+    return FATFileSystem::format(bd);
+}
+
+void fs_benchmark(FileSystem *fs, const char *prefix, format_fn format)
+{
+    char name[48];
+    Timer timer;
+
+    TEST_ASSERT_EQUAL(0, profiled.init());
+    TEST_ASSERT_EQUAL(0, format(&profiled));
+
+    timer.start();
+    TEST_ASSERT_EQUAL(0, fs->mount(&profiled));
+    timer.stop();
+    snprintf(name, sizeof(name), "%s_mount", prefix);
+    bench_report(name, "mounts", 1, timer.read_ms());
+
+    profiled.reset();
+    memset(buffer, 0xA5, sizeof(buffer));
+
+    // sequential write, close included so deferred data is flushed
+    File file;
+    TEST_ASSERT_EQUAL(0, file.open(fs, "bench.dat", O_WRONLY | O_CREAT));
+    uint32_t total = 0;
+    timer.reset();
+    timer.start();
+    while (total < MBED_TEST_BENCH_FILE_SIZE) {
+        ssize_t ret = file.write(buffer, 4096);
+        TEST_ASSERT(ret > 0);
+        total += ret;
+    }
+    TEST_ASSERT_EQUAL(0, file.close());
+    timer.stop();
+    snprintf(name, sizeof(name), "%s_write_seq_4096", prefix);
+    bench_report(name, "bytes", total, timer.read_ms());
+
+    // sequential read
+    TEST_ASSERT_EQUAL(0, file.open(fs, "bench.dat", O_RDONLY));
+    uint32_t read_total = 0;
+    timer.reset();
+    timer.start();
+    while (read_total < total) {
+        ssize_t ret = file.read(buffer, 4096);
+        TEST_ASSERT(ret > 0);
+        read_total += ret;
+    }
+    TEST_ASSERT_EQUAL(0, file.close());
+    timer.stop();
+    snprintf(name, sizeof(name), "%s_read_seq_4096", prefix);
+    bench_report(name, "bytes", read_total, timer.read_ms());
+
+    // open latency on an existing file
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL(0, file.open(fs, "bench.dat", O_RDONLY));
+        TEST_ASSERT_EQUAL(0, file.close());
+    }
+    timer.stop();
+    snprintf(name, sizeof(name), "%s_open_close", prefix);
+    bench_report(name, "opens", 16, timer.read_ms());
+
+    // block device traffic behind the filesystem workload, the read
+    // amplification here is what sizes a read-ahead cache
+    bench_report_profile(prefix);
+    profiled.reset();
+
+    TEST_ASSERT_EQUAL(0, fs->unmount());
+    TEST_ASSERT_EQUAL(0, profiled.deinit());
+}
+
+void test_littlefs_benchmark()
+{
+    LittleFileSystem fs("lfs");
+    fs_benchmark(&fs, "littlefs", littlefs_format);
+}
+
+void test_fat_benchmark()
+{
+    FATFileSystem fs("fat");
+    fs_benchmark(&fs, "fat", fat_format);
+}
+
+
+// test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(MBED_TEST_TIMEOUT, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Block device benchmark", test_bd_benchmark),
+    Case("LittleFS benchmark", test_littlefs_benchmark),
+    Case("FAT benchmark", test_fat_benchmark),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
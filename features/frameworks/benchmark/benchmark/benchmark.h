@@ -0,0 +1,81 @@
+/****************************************************************************
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+#include "platform/Callback.h"
+
+namespace benchmark {
+/** \addtogroup frameworks */
+/** @{*/
+namespace v1 {
+
+    /** Timing statistics of one measured operation, in time base ticks. */
+    struct statistics_t {
+        uint32_t iterations;    ///< number of measured runs
+        uint32_t min;           ///< fastest run
+        uint32_t max;           ///< slowest run
+        uint64_t total;         ///< sum over all runs, mean is total / iterations
+    };
+
+    /** Microbenchmark runner.
+     *
+     * Measures the duration of short operations with the DWT cycle counter,
+     * or the microsecond ticker on cores without one, subtracting the
+     * calibrated cost of a timed empty callback from every sample. Results
+     * are serialized over the greentea console as "benchmark" key-value
+     * pairs in the form "name;ticks_per_second;iterations;min;mean;max" so
+     * the host side can collect them and compare numbers between builds.
+     *
+     * The minimum is the most stable figure to gate a release on:
+     * interrupts and preemption can only make a run slower, never faster.
+     */
+    class Benchmark
+    {
+    public:
+        /// Starts the cycle counter and calibrates the measurement overhead.
+        /// Call once, before the first measure() call.
+        static void init();
+
+        /// Ticks of the active time base per second.
+        static uint32_t ticks_per_second();
+
+        /** Measure one operation.
+         *
+         * Runs op warmup times unmeasured to settle caches and lazy
+         * initialization, then iterations times with each run timed,
+         * reports the statistics over the greentea console and returns
+         * them for additional assertions.
+         *
+         * @param name operation name reported to the host, no semicolons
+         * @param op operation to measure
+         * @param warmup number of unmeasured runs
+         * @param iterations number of measured runs
+         */
+        static statistics_t measure(const char *name, mbed::Callback<void()> op,
+                                    uint32_t warmup = 16, uint32_t iterations = 1024);
+    };
+
+}   // namespace v1
+}   // namespace benchmark
+
+#endif // BENCHMARK_H
+
+/// @}
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Copyright (c) 2018, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#include "benchmark/benchmark.h"
+#include "greentea-client/test_env.h"
+#include "cmsis.h"
+#include <stdio.h>
+
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+#define BENCHMARK_HAVE_DWT 1
+#else
+#include "hal/us_ticker_api.h"
+#endif
+
+namespace benchmark {
+namespace v1 {
+
+static uint32_t measure_overhead;
+
+static inline uint32_t read_ticks()
+{
+#ifdef BENCHMARK_HAVE_DWT
+    return DWT->CYCCNT;
+#else
+    return us_ticker_read();
+#endif
+}
+
+static void empty_op()
+{
+}
+
+void Benchmark::init()
+{
+#ifdef BENCHMARK_HAVE_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    // The fastest timed empty callback is the overhead present in every
+    // sample - anything above it was an interrupt
+    uint32_t overhead = UINT32_MAX;
+    mbed::Callback<void()> op(empty_op);
+    for (int i = 0; i < 64; i++) {
+        uint32_t t0 = read_ticks();
+        op();
+        uint32_t delta = read_ticks() - t0;
+        if (delta < overhead) {
+            overhead = delta;
+        }
+    }
+    measure_overhead = overhead;
+}
+
+uint32_t Benchmark::ticks_per_second()
+{
+#ifdef BENCHMARK_HAVE_DWT
+    return SystemCoreClock;
+#else
+    return 1000000;
+#endif
+}
+
+statistics_t Benchmark::measure(const char *name, mbed::Callback<void()> op,
+                                uint32_t warmup, uint32_t iterations)
+{
+    statistics_t stats = {0, UINT32_MAX, 0, 0};
+    if (!iterations) {
+        iterations = 1;
+    }
+
+    for (uint32_t i = 0; i < warmup; i++) {
+        op();
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint32_t t0 = read_ticks();
+        op();
+        uint32_t delta = read_ticks() - t0;
+        delta = delta > measure_overhead ? delta - measure_overhead : 0;
+        if (delta < stats.min) {
+            stats.min = delta;
+        }
+        if (delta > stats.max) {
+            stats.max = delta;
+        }
+        stats.total += delta;
+        stats.iterations++;
+    }
+
+    char value[96];
+    snprintf(value, sizeof(value), "%s;%lu;%lu;%lu;%lu;%lu",
+             name,
+             (unsigned long)ticks_per_second(),
+             (unsigned long)stats.iterations,
+             (unsigned long)stats.min,
+             (unsigned long)(stats.total / stats.iterations),
+             (unsigned long)stats.max);
+    greentea_send_kv("benchmark", value);
+
+    return stats;
+}
+
+}   // namespace v1
+}   // namespace benchmark
@@ -65,6 +65,18 @@ typedef struct mem_stat_t {
 } mem_stat_t;
 
 
+/**
+ * /struct ns_mem_pool_stat_t
+ * /brief Struct for size-class pool statistics, one entry per class
+ */
+typedef struct ns_mem_pool_stat_t {
+    ns_mem_block_size_t block_size;     /**< Size class block size in bytes. */
+    uint16_t block_count;               /**< Total blocks reserved for the class. */
+    uint16_t block_alloc_cnt;           /**< Blocks currently allocated from the class. */
+    uint16_t block_alloc_max;           /**< Max value of block_alloc_cnt (high-water mark). */
+    uint32_t block_alloc_fail_cnt;      /**< Counter for allocations that found the class empty. */
+} ns_mem_pool_stat_t;
+
 typedef struct ns_mem_book ns_mem_book_t;
 
 /**
@@ -122,6 +134,42 @@ extern void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size);
   */
 extern const mem_stat_t *ns_dyn_mem_get_mem_stat(void);
 
+/**
+  * \brief Reserve size-class segregated pools from the default heap.
+  *
+  * Carves class_count fixed-block pools out of the heap. Later allocations
+  * are served from the smallest class whose block size fits the request;
+  * when that class is empty the allocation falls back to the general heap
+  * (and the class failure counter is incremented). Blocks outside every
+  * class, or larger than the biggest class, use the general heap as before.
+  * Because a class region is never shared with variable-sized allocations,
+  * its blocks cannot be lost to fragmentation.
+  *
+  * Must be called once, after ns_dyn_mem_init and before the heap
+  * fragments - preferably during system init.
+  *
+  * \param block_sizes Block size of each class in bytes, strictly ascending
+  * \param block_counts Number of blocks to reserve for each class
+  * \param class_count Number of classes
+  * \param stat_array Array of class_count statistics entries to update, or NULL
+  *
+  * \return 0, Pools reserved
+  * \return <0, Invalid parameters or not enough free heap
+  */
+extern int8_t ns_dyn_mem_pool_init(const ns_mem_block_size_t *block_sizes, const uint16_t *block_counts, uint8_t class_count, ns_mem_pool_stat_t *stat_array);
+
+/**
+  * \brief Get pointer to the pool statistics set via ns_dyn_mem_pool_init.
+  *
+  * Note: the caller may not modify the returned array.
+  *
+  * \param class_count Returns the number of classes, may be NULL
+  *
+  * \return NULL, no pools or no stat_array was given on pool initialization
+  * \return !=0, Pointer to array of class_count ns_mem_pool_stat_t.
+  */
+extern const ns_mem_pool_stat_t *ns_dyn_mem_get_pool_stat(uint8_t *class_count);
+
 /**
   * \brief Init and set Dynamical heap pointer and length.
   *
@@ -181,6 +229,35 @@ extern void *ns_mem_alloc(ns_mem_book_t *book, ns_mem_block_size_t alloc_size);
   */
 extern const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *book);
 
+/**
+  * \brief Reserve size-class segregated pools from a user heap.
+  *
+  * See ns_dyn_mem_pool_init.
+  *
+  * \param book Address of book keeping structure
+  * \param block_sizes Block size of each class in bytes, strictly ascending
+  * \param block_counts Number of blocks to reserve for each class
+  * \param class_count Number of classes
+  * \param stat_array Array of class_count statistics entries to update, or NULL
+  *
+  * \return 0, Pools reserved
+  * \return <0, Invalid parameters or not enough free heap
+  */
+extern int8_t ns_mem_pool_init(ns_mem_book_t *book, const ns_mem_block_size_t *block_sizes, const uint16_t *block_counts, uint8_t class_count, ns_mem_pool_stat_t *stat_array);
+
+/**
+  * \brief Get pointer to the pool statistics set via ns_mem_pool_init.
+  *
+  * Note: the caller may not modify the returned array.
+  *
+  * \param book Address of book keeping structure
+  * \param class_count Returns the number of classes, may be NULL
+  *
+  * \return NULL, no pools or no stat_array was given on pool initialization
+  * \return !=0, Pointer to array of class_count ns_mem_pool_stat_t.
+  */
+extern const ns_mem_pool_stat_t *ns_mem_get_pool_stat(ns_mem_book_t *book, uint8_t *class_count);
+
 #ifdef __cplusplus
 }
 #endif
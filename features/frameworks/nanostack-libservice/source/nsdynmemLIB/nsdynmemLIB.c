@@ -33,6 +33,15 @@ typedef struct {
 
 typedef int ns_mem_word_size_t; // internal signed heap block size type
 
+/* struct for one size-class pool, blocks linked through their first word */
+typedef struct {
+    uint8_t *region_start;
+    uint8_t *region_end;
+    void *free_list;
+    ns_mem_block_size_t block_stride; // block size rounded up to word size
+    ns_mem_pool_stat_t *stat;
+} ns_mem_pool_class_t;
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main;
@@ -41,6 +50,8 @@ struct ns_mem_book {
     void (*heap_failure_callback)(heap_fail_t);
     NS_LIST_HEAD(hole_t, link) holes_list;
     ns_mem_heap_size_t heap_size;
+    ns_mem_pool_class_t *pool_classes;
+    uint8_t pool_class_count;
 };
 
 static ns_mem_book_t *default_book; // heap pointer for original "ns_" API use
@@ -118,6 +129,9 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     ns_list_init(&book->holes_list);
     ns_list_add_to_start(&book->holes_list, hole_from_block_start(book->heap_main));
 
+    book->pool_classes = NULL;
+    book->pool_class_count = 0;
+
     book->mem_stat_info_ptr = info_ptr;
     //RESET Memory by Hea Len
     if (info_ptr) {
@@ -140,6 +154,101 @@ const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *heap)
 #endif
 }
 
+int8_t ns_mem_pool_init(ns_mem_book_t *book, const ns_mem_block_size_t *block_sizes,
+                        const uint16_t *block_counts, uint8_t class_count,
+                        ns_mem_pool_stat_t *stat_array)
+{
+#ifndef STANDARD_MALLOC
+    if (!book || !block_sizes || !block_counts || !class_count || book->pool_classes) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < class_count; i++) {
+        if (!block_sizes[i] || !block_counts[i] ||
+            (i && block_sizes[i] <= block_sizes[i - 1])) {
+            return -1;
+        }
+    }
+
+    ns_mem_pool_class_t *classes = ns_mem_alloc(book, class_count * sizeof(ns_mem_pool_class_t));
+    if (!classes) {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < class_count; i++) {
+        ns_mem_pool_class_t *cur = &classes[i];
+        uint32_t stride = (block_sizes[i] + sizeof(ns_mem_word_size_t) - 1) & ~(uint32_t)(sizeof(ns_mem_word_size_t) - 1);
+        if (stride < sizeof(void *)) {
+            stride = sizeof(void *); //free list pointer must fit in a block
+        }
+        uint32_t region_size = stride * block_counts[i];
+        uint8_t *region = NULL;
+        if (region_size <= UINT16_MAX) {
+            region = ns_mem_alloc(book, region_size);
+        }
+        if (!region) {
+            while (i--) {
+                ns_mem_free(book, classes[i].region_start);
+            }
+            ns_mem_free(book, classes);
+            return -1;
+        }
+        cur->region_start = region;
+        cur->region_end = region + region_size;
+        cur->block_stride = region_size / block_counts[i];
+        cur->free_list = NULL;
+        for (uint16_t n = 0; n < block_counts[i]; n++) {
+            void *block = region + n * cur->block_stride;
+            *(void **)block = cur->free_list;
+            cur->free_list = block;
+        }
+        cur->stat = stat_array ? &stat_array[i] : NULL;
+        if (cur->stat) {
+            memset(cur->stat, 0, sizeof(ns_mem_pool_stat_t));
+            cur->stat->block_size = block_sizes[i];
+            cur->stat->block_count = block_counts[i];
+        }
+    }
+
+    platform_enter_critical();
+    book->pool_classes = classes;
+    book->pool_class_count = class_count;
+    platform_exit_critical();
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+const ns_mem_pool_stat_t *ns_mem_get_pool_stat(ns_mem_book_t *book, uint8_t *class_count)
+{
+#ifndef STANDARD_MALLOC
+    if (!book || !book->pool_class_count || !book->pool_classes[0].stat) {
+        return NULL;
+    }
+    if (class_count) {
+        *class_count = book->pool_class_count;
+    }
+    return book->pool_classes[0].stat;
+#else
+    return NULL;
+#endif
+}
+
+int8_t ns_dyn_mem_pool_init(const ns_mem_block_size_t *block_sizes, const uint16_t *block_counts,
+                            uint8_t class_count, ns_mem_pool_stat_t *stat_array)
+{
+    return ns_mem_pool_init(default_book, block_sizes, block_counts, class_count, stat_array);
+}
+
+const ns_mem_pool_stat_t *ns_dyn_mem_get_pool_stat(uint8_t *class_count)
+{
+#ifndef STANDARD_MALLOC
+    return ns_mem_get_pool_stat(default_book, class_count);
+#else
+    return NULL;
+#endif
+}
+
 #ifndef STANDARD_MALLOC
 static void dev_stat_update(mem_stat_t *mem_stat_info_ptr, mem_stat_update_t type, ns_mem_block_size_t size)
 {
@@ -191,6 +300,57 @@ static int8_t ns_mem_block_validate(ns_mem_word_size_t *block_start, int directi
     }
     return ret_val;
 }
+
+// Serve an allocation from the smallest size class that fits it.
+// An empty class records a failure and returns NULL so the caller
+// falls back to the general heap. Must be called in a critical section.
+static void *ns_mem_pool_block_alloc(ns_mem_book_t *book, ns_mem_block_size_t alloc_size)
+{
+    for (uint8_t i = 0; i < book->pool_class_count; i++) {
+        ns_mem_pool_class_t *cur = &book->pool_classes[i];
+        if (alloc_size > cur->block_stride) {
+            continue;
+        }
+        void *block = cur->free_list;
+        if (block) {
+            cur->free_list = *(void **)block;
+            if (cur->stat) {
+                cur->stat->block_alloc_cnt++;
+                if (cur->stat->block_alloc_max < cur->stat->block_alloc_cnt) {
+                    cur->stat->block_alloc_max = cur->stat->block_alloc_cnt;
+                }
+            }
+        } else if (cur->stat) {
+            cur->stat->block_alloc_fail_cnt++;
+        }
+        return block;
+    }
+    return NULL;
+}
+
+// Return a block to its size class if the pointer falls inside a class
+// region. Returns 0 when the block was pool-owned (freed or faulted),
+// -1 for general heap pointers. Must be called in a critical section.
+static int8_t ns_mem_pool_block_free(ns_mem_book_t *book, void *block)
+{
+    for (uint8_t i = 0; i < book->pool_class_count; i++) {
+        ns_mem_pool_class_t *cur = &book->pool_classes[i];
+        if ((uint8_t *)block < cur->region_start || (uint8_t *)block >= cur->region_end) {
+            continue;
+        }
+        if (((uint8_t *)block - cur->region_start) % cur->block_stride) {
+            heap_failure(book, NS_DYN_MEM_POINTER_NOT_VALID);
+        } else {
+            *(void **)block = cur->free_list;
+            cur->free_list = block;
+            if (cur->stat) {
+                cur->stat->block_alloc_cnt--;
+            }
+        }
+        return 0;
+    }
+    return -1;
+}
 #endif
 
 // For direction, use 1 for direction up and -1 for down
@@ -207,6 +367,14 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
 
     platform_enter_critical();
 
+    if (book->pool_class_count && alloc_size) {
+        void *block = ns_mem_pool_block_alloc(book, alloc_size);
+        if (block) {
+            platform_exit_critical();
+            return block;
+        }
+    }
+
     ns_mem_word_size_t data_size = convert_allocation_size(book, alloc_size);
     if (!data_size) {
         goto done;
@@ -415,6 +583,10 @@ void ns_mem_free(ns_mem_book_t *book, void *block)
     ns_mem_word_size_t size;
 
     platform_enter_critical();
+    if (book->pool_class_count && ns_mem_pool_block_free(book, block) == 0) {
+        platform_exit_critical();
+        return;
+    }
     ptr --;
     //Read Current Size
     size = *ptr;
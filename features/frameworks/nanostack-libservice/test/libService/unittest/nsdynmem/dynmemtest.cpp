@@ -470,6 +470,83 @@ TEST(dynmem, test_free_corrupted_next_block) {
     free(heap);
 }
 
+TEST(dynmem, size_class_pools)
+{
+    uint16_t size = 5000;
+    mem_stat_t info;
+    ns_mem_pool_stat_t pool_info[2];
+    const ns_mem_block_size_t block_sizes[2] = {64, 256};
+    const uint16_t block_counts[2] = {2, 2};
+    uint8_t *heap = (uint8_t*)malloc(size);
+    CHECK(NULL != heap);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(0 == ns_dyn_mem_pool_init(block_sizes, block_counts, 2, pool_info));
+    //Pool regions are carved from the heap up front
+    CHECK(info.heap_sector_allocated_bytes > (64*2 + 256*2));
+    uint8_t class_count = 0;
+    CHECK(ns_dyn_mem_get_pool_stat(&class_count) == pool_info);
+    CHECK(class_count == 2);
+    CHECK(pool_info[0].block_size == 64);
+    CHECK(pool_info[0].block_count == 2);
+
+    void *p1 = ns_dyn_mem_alloc(50);
+    void *p2 = ns_dyn_mem_temporary_alloc(64);
+    CHECK(p1 && p2);
+    CHECK(pool_info[0].block_alloc_cnt == 2);
+    CHECK(pool_info[0].block_alloc_max == 2);
+    //Class is empty so allocation falls back to the general heap
+    uint16_t last_allocated = info.heap_sector_allocated_bytes;
+    void *p3 = ns_dyn_mem_alloc(50);
+    CHECK(p3);
+    CHECK(pool_info[0].block_alloc_fail_cnt == 1);
+    CHECK(info.heap_sector_allocated_bytes > last_allocated);
+    //Over-sized request goes to the next class
+    void *p4 = ns_dyn_mem_alloc(100);
+    CHECK(p4);
+    CHECK(pool_info[1].block_alloc_cnt == 1);
+
+    ns_dyn_mem_free(p1);
+    CHECK(pool_info[0].block_alloc_cnt == 1);
+    ns_dyn_mem_free(p2);
+    ns_dyn_mem_free(p3);
+    ns_dyn_mem_free(p4);
+    CHECK(pool_info[0].block_alloc_cnt == 0);
+    CHECK(pool_info[1].block_alloc_cnt == 0);
+    CHECK(pool_info[0].block_alloc_max == 2);
+    //Freed blocks can be allocated again
+    CHECK(ns_dyn_mem_alloc(64));
+    CHECK(pool_info[0].block_alloc_cnt == 1);
+    CHECK(!heap_have_failed());
+    free(heap);
+}
+
+TEST(dynmem, size_class_pool_invalid_params)
+{
+    uint16_t size = 1000;
+    const ns_mem_block_size_t ascending[2] = {64, 256};
+    const ns_mem_block_size_t descending[2] = {256, 64};
+    const uint16_t counts[2] = {2, 2};
+    uint8_t *heap = (uint8_t*)malloc(size);
+    CHECK(NULL != heap);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, NULL);
+    CHECK(0 != ns_dyn_mem_pool_init(NULL, counts, 2, NULL));
+    CHECK(0 != ns_dyn_mem_pool_init(ascending, NULL, 2, NULL));
+    CHECK(0 != ns_dyn_mem_pool_init(ascending, counts, 0, NULL));
+    CHECK(0 != ns_dyn_mem_pool_init(descending, counts, 2, NULL));
+    //Second class does not fit into a 1000 byte heap - first class is rolled back
+    const ns_mem_block_size_t big_sizes[2] = {64, 900};
+    const uint16_t big_counts[2] = {2, 1};
+    CHECK(0 != ns_dyn_mem_pool_init(big_sizes, big_counts, 2, NULL));
+    CHECK(ns_dyn_mem_get_pool_stat(NULL) == NULL);
+    //Second initialization is rejected once pools exist
+    CHECK(0 == ns_dyn_mem_pool_init(ascending, counts, 2, NULL));
+    CHECK(0 != ns_dyn_mem_pool_init(ascending, counts, 2, NULL));
+    CHECK(!heap_have_failed());
+    free(heap);
+}
+
 //NOTE! This test must be last!
 TEST(dynmem, uninitialized_test){
     void *p = ns_dyn_mem_alloc(4);
@@ -0,0 +1,267 @@
+/*
+* Copyright (c) 2018 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "kvstore.h"
+#include "HeapBlockDevice.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+using namespace utest::v1;
+
+static const size_t test_bd_size = 16 * 1024;
+static const size_t test_bd_erase_size = 1024;
+static const size_t test_bd_prog_size = 16;
+
+static const size_t basic_max_data_size = 256;
+
+static void gen_random(uint8_t *s, int len)
+{
+    for (int i = 0; i < len; ++i) {
+        s[i] = rand() % 256;
+    }
+}
+
+static void kvstore_basic_functionality_test()
+{
+    HeapBlockDevice bd(test_bd_size, 1, test_bd_prog_size, test_bd_erase_size);
+    KVStore kv(&bd);
+
+    uint8_t *set_buf = new uint8_t[basic_max_data_size];
+    uint8_t *get_buf = new uint8_t[basic_max_data_size];
+    size_t actual_size;
+    int result;
+
+    gen_random(set_buf, basic_max_data_size);
+
+    result = kv.init();
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(0, kv.get_num_keys());
+
+    result = kv.set("boot-count", set_buf, 4);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+
+    result = kv.get("boot-count", get_buf, basic_max_data_size, &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(4, actual_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(set_buf, get_buf, 4);
+
+    result = kv.get("boot-count", get_buf, 2, &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_BUFF_TOO_SMALL, result);
+
+    result = kv.get("no-such-key", get_buf, basic_max_data_size, &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_NOT_FOUND, result);
+
+    // Overwrite replaces the value
+    result = kv.set("boot-count", &set_buf[1], 8);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    result = kv.get("boot-count", get_buf, basic_max_data_size, &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(8, actual_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&set_buf[1], get_buf, 8);
+    TEST_ASSERT_EQUAL(1, kv.get_num_keys());
+
+    result = kv.get_size("boot-count", &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(8, actual_size);
+
+    // Empty values are legal
+    result = kv.set("marker", 0, 0);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    result = kv.get_size("marker", &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(0, actual_size);
+
+    result = kv.remove("marker");
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    result = kv.get_size("marker", &actual_size);
+    TEST_ASSERT_EQUAL(KVSTORE_NOT_FOUND, result);
+    result = kv.remove("marker");
+    TEST_ASSERT_EQUAL(KVSTORE_NOT_FOUND, result);
+
+    result = kv.set("", set_buf, 1);
+    TEST_ASSERT_EQUAL(KVSTORE_BAD_VALUE, result);
+
+    delete[] set_buf;
+    delete[] get_buf;
+
+    result = kv.deinit();
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+}
+
+static void kvstore_persistence_test()
+{
+    HeapBlockDevice bd(test_bd_size, 1, test_bd_prog_size, test_bd_erase_size);
+    uint8_t set_buf[64];
+    uint8_t get_buf[64];
+    size_t actual_size;
+    char key[16];
+    int result;
+
+    gen_random(set_buf, sizeof(set_buf));
+
+    // First life - write a handful of keys, update some, remove one
+    {
+        KVStore kv(&bd);
+        result = kv.init();
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+
+        for (int i = 0; i < 8; i++) {
+            sprintf(key, "cfg-%d", i);
+            result = kv.set(key, set_buf, 32 + i);
+            TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        }
+        result = kv.set("cfg-3", &set_buf[3], 7);
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        result = kv.remove("cfg-5");
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        result = kv.deinit();
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    }
+
+    // Second life - the index is rebuilt from the record log
+    {
+        KVStore kv(&bd);
+        result = kv.init();
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        TEST_ASSERT_EQUAL(7, kv.get_num_keys());
+
+        result = kv.get("cfg-3", get_buf, sizeof(get_buf), &actual_size);
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        TEST_ASSERT_EQUAL(7, actual_size);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&set_buf[3], get_buf, 7);
+
+        result = kv.get("cfg-5", get_buf, sizeof(get_buf), &actual_size);
+        TEST_ASSERT_EQUAL(KVSTORE_NOT_FOUND, result);
+
+        result = kv.get("cfg-7", get_buf, sizeof(get_buf), &actual_size);
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        TEST_ASSERT_EQUAL(39, actual_size);
+
+        result = kv.deinit();
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    }
+}
+
+static void kvstore_compaction_test()
+{
+    HeapBlockDevice bd(test_bd_size, 1, test_bd_prog_size, test_bd_erase_size);
+    KVStore kv(&bd);
+    uint8_t set_buf[128];
+    uint8_t get_buf[128];
+    size_t actual_size;
+    char key[16];
+    int result;
+
+    gen_random(set_buf, sizeof(set_buf));
+
+    result = kv.init();
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+
+    // Keep rewriting a small working set until the stale versions have
+    // forced several area switches; the live values must survive each one
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 4; i++) {
+            sprintf(key, "log-%d", i);
+            set_buf[0] = (uint8_t) round;
+            set_buf[1] = (uint8_t) i;
+            result = kv.set(key, set_buf, sizeof(set_buf));
+            TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(4, kv.get_num_keys());
+    for (int i = 0; i < 4; i++) {
+        sprintf(key, "log-%d", i);
+        result = kv.get(key, get_buf, sizeof(get_buf), &actual_size);
+        TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+        TEST_ASSERT_EQUAL(sizeof(set_buf), actual_size);
+        TEST_ASSERT_EQUAL(99, get_buf[0]);
+        TEST_ASSERT_EQUAL(i, get_buf[1]);
+    }
+
+    result = kv.deinit();
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+}
+
+static void kvstore_iteration_test()
+{
+    HeapBlockDevice bd(test_bd_size, 1, test_bd_prog_size, test_bd_erase_size);
+    KVStore kv(&bd);
+    KVStore::iterator_t it;
+    char key[KVSTORE_MAX_KEY_SIZE + 1];
+    uint8_t val = 0;
+    int result;
+
+    result = kv.init();
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+
+    result = kv.set("net-addr", &val, 1);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    result = kv.set("net-mask", &val, 1);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    result = kv.set("app-mode", &val, 1);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+
+    result = kv.iterator_open(&it, "net-");
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+
+    int matches = 0;
+    while (kv.iterator_next(&it, key, sizeof(key)) == KVSTORE_SUCCESS) {
+        TEST_ASSERT_EQUAL_STRING_LEN("net-", key, 4);
+        matches++;
+    }
+    TEST_ASSERT_EQUAL(2, matches);
+
+    result = kv.iterator_open(&it, 0);
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+    matches = 0;
+    while (kv.iterator_next(&it, key, sizeof(key)) == KVSTORE_SUCCESS) {
+        matches++;
+    }
+    TEST_ASSERT_EQUAL(3, matches);
+
+    result = kv.deinit();
+    TEST_ASSERT_EQUAL(KVSTORE_SUCCESS, result);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("KVStore: Basic functionality", kvstore_basic_functionality_test, greentea_failure_handler),
+    Case("KVStore: Persistence",         kvstore_persistence_test,         greentea_failure_handler),
+    Case("KVStore: Compaction",          kvstore_compaction_test,          greentea_failure_handler),
+    Case("KVStore: Iteration",           kvstore_iteration_test,           greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,955 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kvstore.h"
+#include "mbed_assert.h"
+#include <string.h>
+
+// Media layout - two equal areas, each starting with a generation-stamped
+// header followed by a log of records: a fixed header, the key, the value,
+// padded to program alignment. The area with the newer valid header is
+// authoritative at init; compaction writes the target area's header only
+// after all live records have landed, so a power cut mid-compaction leaves
+// the old area intact and authoritative.
+static const uint32_t kv_area_magic   = 0x6b766131; // 'kva1'
+static const uint32_t kv_record_magic = 0x6b767231; // 'kvr1'
+static const uint32_t initial_crc = 0xFFFFFFFF;
+
+static const uint16_t kv_flag_deleted = 0x0001;
+
+static const uint32_t min_chunk_size = 256;
+static const uint32_t initial_index_capacity = 32;
+
+// Index slot markers - record offsets start after the area header, so 0
+// never points at a record
+static const uint32_t slot_free      = 0;
+static const uint32_t slot_tombstone = 0xFFFFFFFF;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t generation;
+    uint32_t crc;
+} kv_area_header_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t key_size;
+    uint16_t flags;
+    uint32_t data_size;
+    uint32_t crc; // over this header with crc zeroed, the key and the value
+} kv_record_header_t;
+
+static inline uint32_t align_up(uint32_t val, uint32_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+static uint32_t crc32(uint32_t init_crc, uint32_t data_size, const uint8_t *data_buf)
+{
+    uint32_t i, j;
+    uint32_t crc, mask;
+
+    crc = init_crc;
+    for (i = 0; i < data_size; i++) {
+        crc = crc ^ (uint32_t) (data_buf[i]);
+        for (j = 0; j < 8; j++) {
+            mask = -(crc & 1);
+            crc = (crc >> 1) ^ (0xEDB88320 & mask);
+        }
+    }
+    return crc;
+}
+
+// FNV-1a - cheap and well distributed over short config-style keys
+static uint32_t key_hash(const char *key)
+{
+    uint32_t hash = 2166136261UL;
+    while (*key) {
+        hash ^= (uint8_t) *key++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+KVStore::KVStore(BlockDevice *bd)
+    : _bd(bd), _index(0), _index_capacity(0), _num_keys(0), _num_slots_used(0),
+      _chunk_buf(0), _chunk_size(0), _prog_size(0), _area_size(0),
+      _active_area(0), _active_generation(0), _free_offset(0),
+      _is_initialized(false)
+{
+}
+
+KVStore::~KVStore()
+{
+    if (_is_initialized) {
+        deinit();
+    }
+}
+
+int KVStore::init()
+{
+    if (_is_initialized) {
+        return KVSTORE_SUCCESS;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        return KVSTORE_OS_ERROR;
+    }
+
+    _prog_size = _bd->get_program_size();
+    bd_size_t erase_size = _bd->get_erase_size();
+
+    // Two equal, erase-aligned areas
+    _area_size = (_bd->size() / 2) / erase_size * erase_size;
+    MBED_ASSERT(_area_size >= 2 * erase_size);
+
+    _chunk_size = align_up(min_chunk_size, _prog_size);
+    _chunk_buf = new uint8_t[_chunk_size];
+
+    _index_capacity = initial_index_capacity;
+    _index = new index_entry_t[_index_capacity];
+    memset(_index, 0, _index_capacity * sizeof(index_entry_t));
+    _num_keys = 0;
+    _num_slots_used = 0;
+
+    // The valid header with the newer generation wins
+    bool valid[2];
+    uint32_t generations[2];
+    for (uint32_t area = 0; area < 2; area++) {
+        err = read_area_header(area, valid[area], generations[area]);
+        if (err) {
+            goto fail;
+        }
+    }
+
+    if (valid[0] && valid[1]) {
+        _active_area = (generations[0] > generations[1]) ? 0 : 1;
+    } else if (valid[0]) {
+        _active_area = 0;
+    } else if (valid[1]) {
+        _active_area = 1;
+    } else {
+        // Fresh device - format area 0
+        _active_area = 0;
+        err = _bd->erase(area_addr(0), _area_size);
+        if (err) {
+            err = KVSTORE_WRITE_ERROR;
+            goto fail;
+        }
+        err = write_area_header(0, 1);
+        if (err) {
+            goto fail;
+        }
+        generations[0] = 1;
+    }
+    _active_generation = generations[_active_area];
+
+    err = build_index();
+    if (err) {
+        goto fail;
+    }
+
+    _is_initialized = true;
+    return KVSTORE_SUCCESS;
+
+fail:
+    delete[] _chunk_buf;
+    _chunk_buf = 0;
+    delete[] _index;
+    _index = 0;
+    _bd->deinit();
+    return err;
+}
+
+int KVStore::deinit()
+{
+    if (!_is_initialized) {
+        return KVSTORE_SUCCESS;
+    }
+
+    delete[] _chunk_buf;
+    _chunk_buf = 0;
+    delete[] _index;
+    _index = 0;
+    _is_initialized = false;
+
+    _bd->deinit();
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::get(const char *key, void *buf, size_t buf_size, size_t *actual_size)
+{
+    if (!key || !*key || strlen(key) > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (!buf && buf_size) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (!_is_initialized) {
+        return KVSTORE_UNINITIALIZED;
+    }
+
+    _mutex.lock();
+
+    uint32_t slot;
+    bool found;
+    int err = index_find(key, slot, found);
+    if (!err && !found) {
+        err = KVSTORE_NOT_FOUND;
+    }
+    if (!err) {
+        err = read_record_data(_active_area, _index[slot].offset, buf,
+                buf_size, actual_size);
+    }
+
+    _mutex.unlock();
+    return err;
+}
+
+int KVStore::get_size(const char *key, size_t *actual_size)
+{
+    if (!actual_size) {
+        return KVSTORE_BAD_VALUE;
+    }
+
+    return get(key, 0, 0, actual_size);
+}
+
+int KVStore::set(const char *key, const void *buf, size_t buf_size)
+{
+    if (!key || !*key || strlen(key) > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (!buf && buf_size) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (!_is_initialized) {
+        return KVSTORE_UNINITIALIZED;
+    }
+
+    _mutex.lock();
+
+    uint32_t header_slot = align_up(sizeof(kv_area_header_t), _prog_size);
+    uint32_t record_size = align_up(sizeof(kv_record_header_t) + strlen(key) + buf_size,
+            _prog_size);
+
+    int err = KVSTORE_SUCCESS;
+    if (header_slot + record_size > _area_size) {
+        err = KVSTORE_MEDIA_FULL;
+    }
+
+    if (!err && (_free_offset + record_size > _area_size)) {
+        err = garbage_collect();
+        if (!err && (_free_offset + record_size > _area_size)) {
+            err = KVSTORE_MEDIA_FULL;
+        }
+    }
+
+    uint32_t offset = _free_offset;
+    if (!err) {
+        err = write_record(offset, key, buf, buf_size, 0, _free_offset);
+    }
+    if (!err) {
+        err = index_insert(key, offset);
+    }
+
+    _mutex.unlock();
+    return err;
+}
+
+int KVStore::remove(const char *key)
+{
+    if (!key || !*key || strlen(key) > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (!_is_initialized) {
+        return KVSTORE_UNINITIALIZED;
+    }
+
+    _mutex.lock();
+
+    uint32_t slot;
+    bool found;
+    int err = index_find(key, slot, found);
+    if (!err && !found) {
+        err = KVSTORE_NOT_FOUND;
+    }
+
+    if (!err) {
+        _index[slot].offset = slot_tombstone;
+        _num_keys--;
+
+        uint32_t record_size = align_up(sizeof(kv_record_header_t) + strlen(key),
+                _prog_size);
+        if (_free_offset + record_size > _area_size) {
+            // No room for a deletion record - compacting from the index,
+            // which no longer holds the key, drops it just as well
+            err = garbage_collect();
+        } else {
+            err = write_record(_free_offset, key, 0, 0, kv_flag_deleted,
+                    _free_offset);
+        }
+    }
+
+    _mutex.unlock();
+    return err;
+}
+
+int KVStore::reset()
+{
+    if (!_is_initialized) {
+        return KVSTORE_UNINITIALIZED;
+    }
+
+    _mutex.lock();
+
+    int err = _bd->erase(area_addr(0), _area_size);
+    if (!err) {
+        err = write_area_header(0, _active_generation + 1);
+    } else {
+        err = KVSTORE_WRITE_ERROR;
+    }
+
+    if (!err) {
+        _active_area = 0;
+        _active_generation++;
+        _free_offset = align_up(sizeof(kv_area_header_t), _prog_size);
+        memset(_index, 0, _index_capacity * sizeof(index_entry_t));
+        _num_keys = 0;
+        _num_slots_used = 0;
+    }
+
+    _mutex.unlock();
+    return err;
+}
+
+size_t KVStore::get_num_keys() const
+{
+    return _num_keys;
+}
+
+int KVStore::iterator_open(iterator_t *it, const char *prefix)
+{
+    if (!it) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (prefix && strlen(prefix) > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_BAD_VALUE;
+    }
+
+    it->slot = 0;
+    if (prefix) {
+        strcpy(it->prefix, prefix);
+    } else {
+        it->prefix[0] = '\0';
+    }
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::iterator_next(iterator_t *it, char *key, size_t key_size)
+{
+    if (!it || !key || !key_size) {
+        return KVSTORE_BAD_VALUE;
+    }
+    if (!_is_initialized) {
+        return KVSTORE_UNINITIALIZED;
+    }
+
+    _mutex.lock();
+
+    int err = KVSTORE_NOT_FOUND;
+    char name[KVSTORE_MAX_KEY_SIZE + 1];
+
+    while (it->slot < _index_capacity) {
+        uint32_t slot = it->slot++;
+        if (_index[slot].offset == slot_free || _index[slot].offset == slot_tombstone) {
+            continue;
+        }
+
+        err = read_record_name(_active_area, _index[slot].offset, name, sizeof(name));
+        if (err) {
+            break;
+        }
+
+        if (strncmp(name, it->prefix, strlen(it->prefix)) != 0) {
+            err = KVSTORE_NOT_FOUND;
+            continue;
+        }
+
+        if (strlen(name) + 1 > key_size) {
+            err = KVSTORE_BUFF_TOO_SMALL;
+        } else {
+            strcpy(key, name);
+        }
+        break;
+    }
+
+    _mutex.unlock();
+    return err;
+}
+
+bd_addr_t KVStore::area_addr(uint32_t area) const
+{
+    return (bd_addr_t) area * _area_size;
+}
+
+int KVStore::write_area_header(uint32_t area, uint32_t generation)
+{
+    kv_area_header_t header;
+    header.magic = kv_area_magic;
+    header.generation = generation;
+    header.crc = 0;
+    header.crc = crc32(initial_crc, sizeof(header), (const uint8_t *)&header);
+
+    memset(_chunk_buf, 0, _chunk_size);
+    memcpy(_chunk_buf, &header, sizeof(header));
+
+    uint32_t slot = align_up(sizeof(header), _prog_size);
+    int err = _bd->program(_chunk_buf, area_addr(area), slot);
+    return err ? KVSTORE_WRITE_ERROR : KVSTORE_SUCCESS;
+}
+
+int KVStore::read_area_header(uint32_t area, bool &valid, uint32_t &generation)
+{
+    uint32_t slot = align_up(sizeof(kv_area_header_t), _prog_size);
+    int err = _bd->read(_chunk_buf, area_addr(area), slot);
+    if (err) {
+        return KVSTORE_READ_ERROR;
+    }
+
+    kv_area_header_t header;
+    memcpy(&header, _chunk_buf, sizeof(header));
+
+    uint32_t crc = header.crc;
+    header.crc = 0;
+    valid = (header.magic == kv_area_magic)
+            && (crc == crc32(initial_crc, sizeof(header), (const uint8_t *)&header));
+    generation = valid ? header.generation : 0;
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::write_record(uint32_t offset, const char *key, const void *data,
+        uint32_t data_size, uint16_t flags, uint32_t &next_offset)
+{
+    uint32_t key_size = strlen(key);
+
+    kv_record_header_t header;
+    header.magic = kv_record_magic;
+    header.key_size = (uint16_t) key_size;
+    header.flags = flags;
+    header.data_size = data_size;
+    header.crc = 0;
+    header.crc = crc32(crc32(crc32(initial_crc,
+            sizeof(header), (const uint8_t *)&header),
+            key_size, (const uint8_t *)key),
+            data_size, (const uint8_t *)data);
+
+    // Stream the three segments - header, key, value - through the chunk
+    // buffer, padding the tail to program alignment
+    uint32_t total = align_up(sizeof(header) + key_size + data_size, _prog_size);
+    for (uint32_t pos = 0; pos < total; pos += _chunk_size) {
+        uint32_t chunk = (total - pos < _chunk_size) ? (total - pos) : _chunk_size;
+        memset(_chunk_buf, 0, chunk);
+
+        for (uint32_t i = 0; i < chunk; i++) {
+            uint32_t src = pos + i;
+            if (src < sizeof(header)) {
+                _chunk_buf[i] = ((const uint8_t *)&header)[src];
+            } else if (src < sizeof(header) + key_size) {
+                _chunk_buf[i] = (uint8_t) key[src - sizeof(header)];
+            } else if (src < sizeof(header) + key_size + data_size) {
+                _chunk_buf[i] = ((const uint8_t *)data)[src - sizeof(header) - key_size];
+            } else {
+                break;
+            }
+        }
+
+        int err = _bd->program(_chunk_buf,
+                area_addr(_active_area) + offset + pos, chunk);
+        if (err) {
+            return KVSTORE_WRITE_ERROR;
+        }
+    }
+
+    next_offset = offset + total;
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::read_record_key(uint32_t area, uint32_t offset, const char *key,
+        bool &key_match, uint32_t &data_size, uint16_t &flags,
+        uint32_t &next_offset)
+{
+    uint32_t header_chunk = align_up(sizeof(kv_record_header_t), _prog_size);
+    if (offset + header_chunk > _area_size) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    int err = _bd->read(_chunk_buf, area_addr(area) + offset, header_chunk);
+    if (err) {
+        return KVSTORE_READ_ERROR;
+    }
+
+    kv_record_header_t header;
+    memcpy(&header, _chunk_buf, sizeof(header));
+    if (header.magic != kv_record_magic
+            || header.key_size == 0 || header.key_size > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    uint32_t total = align_up(sizeof(header) + header.key_size + header.data_size,
+            _prog_size);
+    if (offset + total > _area_size) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    char name[KVSTORE_MAX_KEY_SIZE + 1];
+    err = read_record_name(area, offset, name, sizeof(name));
+    if (err) {
+        return err;
+    }
+
+    key_match = key && (strcmp(name, key) == 0);
+    data_size = header.data_size;
+    flags = header.flags;
+    next_offset = offset + total;
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::read_record_name(uint32_t area, uint32_t offset, char *key, size_t key_size)
+{
+    // The key sits right after the fixed header - read enough aligned
+    // chunks to cover both
+    uint32_t header_chunk = align_up(sizeof(kv_record_header_t), _prog_size);
+    int err = _bd->read(_chunk_buf, area_addr(area) + offset, header_chunk);
+    if (err) {
+        return KVSTORE_READ_ERROR;
+    }
+
+    kv_record_header_t header;
+    memcpy(&header, _chunk_buf, sizeof(header));
+    if (header.magic != kv_record_magic
+            || header.key_size == 0 || header.key_size > KVSTORE_MAX_KEY_SIZE
+            || header.key_size + 1 > key_size) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    uint32_t copied = 0;
+    uint32_t pos = 0;
+    while (copied < header.key_size) {
+        uint32_t avail = (pos == 0) ? header_chunk : _chunk_size;
+        uint32_t start = (pos == 0) ? sizeof(header) : 0;
+        if (pos != 0) {
+            uint32_t chunk = _chunk_size;
+            if (offset + pos + chunk > _area_size) {
+                chunk = _area_size - offset - pos;
+            }
+            err = _bd->read(_chunk_buf, area_addr(area) + offset + pos, chunk);
+            if (err) {
+                return KVSTORE_READ_ERROR;
+            }
+            avail = chunk;
+        }
+
+        while (start < avail && copied < header.key_size) {
+            key[copied++] = (char) _chunk_buf[start++];
+        }
+        pos += avail;
+    }
+
+    key[copied] = '\0';
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::read_record_data(uint32_t area, uint32_t offset, void *buf,
+        size_t buf_size, size_t *actual_size)
+{
+    uint32_t header_chunk = align_up(sizeof(kv_record_header_t), _prog_size);
+    int err = _bd->read(_chunk_buf, area_addr(area) + offset, header_chunk);
+    if (err) {
+        return KVSTORE_READ_ERROR;
+    }
+
+    kv_record_header_t header;
+    memcpy(&header, _chunk_buf, sizeof(header));
+    if (header.magic != kv_record_magic
+            || header.key_size == 0 || header.key_size > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    if (actual_size) {
+        *actual_size = header.data_size;
+    }
+    if (!buf) {
+        return KVSTORE_SUCCESS;
+    }
+    if (buf_size < header.data_size) {
+        return KVSTORE_BUFF_TOO_SMALL;
+    }
+
+    // Stream the record, checking the crc over header, key and value while
+    // copying the value out
+    uint32_t stored_crc = header.crc;
+    header.crc = 0;
+    uint32_t crc = crc32(initial_crc, sizeof(header), (const uint8_t *)&header);
+
+    uint32_t logical = sizeof(header) + header.key_size + header.data_size;
+    uint32_t data_start = sizeof(header) + header.key_size;
+    uint32_t copied = 0;
+    uint32_t pos = 0;
+
+    while (pos < logical) {
+        uint32_t chunk;
+        const uint8_t *chunk_data;
+        if (pos == 0) {
+            chunk = header_chunk;
+            chunk_data = _chunk_buf;
+        } else {
+            chunk = _chunk_size;
+            if (offset + pos + chunk > _area_size) {
+                chunk = _area_size - offset - pos;
+            }
+            err = _bd->read(_chunk_buf, area_addr(area) + offset + pos, chunk);
+            if (err) {
+                return KVSTORE_READ_ERROR;
+            }
+            chunk_data = _chunk_buf;
+        }
+
+        uint32_t valid = (logical - pos < chunk) ? (logical - pos) : chunk;
+        // The crc covers the header with its crc field zeroed
+        if (pos == 0) {
+            uint8_t patched[sizeof(header)];
+            memcpy(patched, &header, sizeof(header));
+            crc = crc32(initial_crc, sizeof(header), patched);
+            if (valid > sizeof(header)) {
+                crc = crc32(crc, valid - sizeof(header), chunk_data + sizeof(header));
+            }
+        } else {
+            crc = crc32(crc, valid, chunk_data);
+        }
+
+        // Copy out the part of this chunk that overlaps the value
+        uint32_t chunk_end = pos + valid;
+        if (chunk_end > data_start && pos < data_start + header.data_size) {
+            uint32_t from = (pos > data_start) ? pos : data_start;
+            uint32_t to = (chunk_end < data_start + header.data_size)
+                    ? chunk_end : (data_start + header.data_size);
+            memcpy((uint8_t *)buf + (from - data_start),
+                    chunk_data + (from - pos), to - from);
+            copied += to - from;
+        }
+
+        pos += valid;
+    }
+
+    if (crc != stored_crc) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::verify_record(uint32_t area, uint32_t offset)
+{
+    uint32_t header_chunk = align_up(sizeof(kv_record_header_t), _prog_size);
+    int err = _bd->read(_chunk_buf, area_addr(area) + offset, header_chunk);
+    if (err) {
+        return KVSTORE_READ_ERROR;
+    }
+
+    kv_record_header_t header;
+    memcpy(&header, _chunk_buf, sizeof(header));
+    if (header.magic != kv_record_magic
+            || header.key_size == 0 || header.key_size > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    uint32_t logical = sizeof(header) + header.key_size + header.data_size;
+    if (offset + align_up(logical, _prog_size) > _area_size) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    uint32_t stored_crc = header.crc;
+    header.crc = 0;
+    uint32_t crc = crc32(initial_crc, sizeof(header), (const uint8_t *)&header);
+
+    uint32_t pos = sizeof(header);
+    if (header_chunk > sizeof(header)) {
+        uint32_t valid = (logical < header_chunk) ? logical : header_chunk;
+        crc = crc32(crc, valid - sizeof(header), _chunk_buf + sizeof(header));
+        pos = valid;
+    }
+
+    while (pos < logical) {
+        uint32_t aligned = pos / _prog_size * _prog_size;
+        uint32_t chunk = _chunk_size;
+        if (offset + aligned + chunk > _area_size) {
+            chunk = _area_size - offset - aligned;
+        }
+        err = _bd->read(_chunk_buf, area_addr(area) + offset + aligned, chunk);
+        if (err) {
+            return KVSTORE_READ_ERROR;
+        }
+        uint32_t valid = (logical - aligned < chunk) ? (logical - aligned) : chunk;
+        crc = crc32(crc, valid - (pos - aligned), _chunk_buf + (pos - aligned));
+        pos = aligned + valid;
+    }
+
+    return (crc == stored_crc) ? KVSTORE_SUCCESS : KVSTORE_DATA_CORRUPT;
+}
+
+int KVStore::copy_record(uint32_t from_area, uint32_t from_offset,
+        uint32_t to_offset, uint32_t &next_offset)
+{
+    uint32_t header_chunk = align_up(sizeof(kv_record_header_t), _prog_size);
+    int err = _bd->read(_chunk_buf, area_addr(from_area) + from_offset, header_chunk);
+    if (err) {
+        return KVSTORE_READ_ERROR;
+    }
+
+    kv_record_header_t header;
+    memcpy(&header, _chunk_buf, sizeof(header));
+    if (header.magic != kv_record_magic
+            || header.key_size == 0 || header.key_size > KVSTORE_MAX_KEY_SIZE) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    uint32_t total = align_up(sizeof(header) + header.key_size + header.data_size,
+            _prog_size);
+    if (from_offset + total > _area_size || to_offset + total > _area_size) {
+        return KVSTORE_DATA_CORRUPT;
+    }
+
+    for (uint32_t pos = 0; pos < total; pos += _chunk_size) {
+        uint32_t chunk = (total - pos < _chunk_size) ? (total - pos) : _chunk_size;
+        err = _bd->read(_chunk_buf, area_addr(from_area) + from_offset + pos, chunk);
+        if (err) {
+            return KVSTORE_READ_ERROR;
+        }
+        err = _bd->program(_chunk_buf,
+                area_addr(1 - from_area) + to_offset + pos, chunk);
+        if (err) {
+            return KVSTORE_WRITE_ERROR;
+        }
+    }
+
+    next_offset = to_offset + total;
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::index_find(const char *key, uint32_t &slot, bool &found)
+{
+    uint32_t hash = key_hash(key);
+    uint32_t probe = hash & (_index_capacity - 1);
+
+    found = false;
+    for (uint32_t i = 0; i < _index_capacity; i++) {
+        index_entry_t *entry = &_index[probe];
+        if (entry->offset == slot_free) {
+            return KVSTORE_SUCCESS;
+        }
+        if (entry->offset != slot_tombstone && entry->hash == hash) {
+            bool match;
+            uint32_t data_size;
+            uint16_t flags;
+            uint32_t next;
+            int err = read_record_key(_active_area, entry->offset, key,
+                    match, data_size, flags, next);
+            if (err) {
+                return err;
+            }
+            if (match) {
+                slot = probe;
+                found = true;
+                return KVSTORE_SUCCESS;
+            }
+        }
+        probe = (probe + 1) & (_index_capacity - 1);
+    }
+
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::index_insert(const char *key, uint32_t offset)
+{
+    uint32_t slot;
+    bool found;
+    int err = index_find(key, slot, found);
+    if (err) {
+        return err;
+    }
+
+    if (found) {
+        _index[slot].offset = offset;
+        return KVSTORE_SUCCESS;
+    }
+
+    if (4 * (_num_slots_used + 1) >= 3 * _index_capacity) {
+        err = index_grow();
+        if (err) {
+            return err;
+        }
+    }
+
+    uint32_t hash = key_hash(key);
+    uint32_t probe = hash & (_index_capacity - 1);
+    while (_index[probe].offset != slot_free
+            && _index[probe].offset != slot_tombstone) {
+        probe = (probe + 1) & (_index_capacity - 1);
+    }
+
+    if (_index[probe].offset == slot_free) {
+        _num_slots_used++;
+    }
+    _index[probe].hash = hash;
+    _index[probe].offset = offset;
+    _num_keys++;
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::index_grow()
+{
+    uint32_t new_capacity = 2 * _index_capacity;
+    index_entry_t *new_index = new index_entry_t[new_capacity];
+    memset(new_index, 0, new_capacity * sizeof(index_entry_t));
+
+    // Rehashing needs only the stored hashes, and drops the tombstones
+    for (uint32_t i = 0; i < _index_capacity; i++) {
+        if (_index[i].offset == slot_free || _index[i].offset == slot_tombstone) {
+            continue;
+        }
+        uint32_t probe = _index[i].hash & (new_capacity - 1);
+        while (new_index[probe].offset != slot_free) {
+            probe = (probe + 1) & (new_capacity - 1);
+        }
+        new_index[probe] = _index[i];
+    }
+
+    delete[] _index;
+    _index = new_index;
+    _index_capacity = new_capacity;
+    _num_slots_used = _num_keys;
+    return KVSTORE_SUCCESS;
+}
+
+int KVStore::garbage_collect()
+{
+    uint32_t target = 1 - _active_area;
+    uint32_t to_offset = align_up(sizeof(kv_area_header_t), _prog_size);
+
+    int err = _bd->erase(area_addr(target), _area_size);
+    if (err) {
+        err = KVSTORE_WRITE_ERROR;
+        goto fail;
+    }
+
+    // Copy exactly the records the index can reach - stale versions and
+    // deletion records simply stay behind
+    for (uint32_t i = 0; i < _index_capacity; i++) {
+        if (_index[i].offset == slot_free || _index[i].offset == slot_tombstone) {
+            continue;
+        }
+        uint32_t new_offset = to_offset;
+        err = copy_record(_active_area, _index[i].offset, to_offset, to_offset);
+        if (err) {
+            goto fail;
+        }
+        _index[i].offset = new_offset;
+    }
+
+    // The target header lands only after every live record has - a power
+    // cut before this line leaves the old area authoritative
+    err = write_area_header(target, _active_generation + 1);
+    if (err) {
+        goto fail;
+    }
+    err = _bd->sync() ? KVSTORE_WRITE_ERROR : KVSTORE_SUCCESS;
+    if (err) {
+        goto fail;
+    }
+
+    _active_area = target;
+    _active_generation++;
+    _free_offset = to_offset;
+    return KVSTORE_SUCCESS;
+
+fail:
+    // The old area is untouched - rebuild the index from it so RAM state
+    // matches the media again
+    build_index();
+    return err;
+}
+
+int KVStore::build_index()
+{
+    memset(_index, 0, _index_capacity * sizeof(index_entry_t));
+    _num_keys = 0;
+    _num_slots_used = 0;
+
+    uint32_t offset = align_up(sizeof(kv_area_header_t), _prog_size);
+    uint32_t header_chunk = align_up(sizeof(kv_record_header_t), _prog_size);
+    char name[KVSTORE_MAX_KEY_SIZE + 1];
+
+    while (offset + header_chunk <= _area_size) {
+        bool match;
+        uint32_t data_size;
+        uint16_t flags;
+        uint32_t next;
+        int err = read_record_key(_active_area, offset, 0, match, data_size,
+                flags, next);
+        if (!err) {
+            // A record with a healthy header but torn payload still has to
+            // end the log, so check the whole record
+            err = verify_record(_active_area, offset);
+        }
+        if (err == KVSTORE_DATA_CORRUPT) {
+            // A torn or blank record ends the log
+            break;
+        }
+        if (err) {
+            return err;
+        }
+
+        err = read_record_name(_active_area, offset, name, sizeof(name));
+        if (err) {
+            break;
+        }
+
+        if (flags & kv_flag_deleted) {
+            uint32_t slot;
+            bool found;
+            err = index_find(name, slot, found);
+            if (err) {
+                return err;
+            }
+            if (found) {
+                _index[slot].offset = slot_tombstone;
+                _num_keys--;
+            }
+        } else {
+            err = index_insert(name, offset);
+            if (err) {
+                return err;
+            }
+        }
+
+        offset = next;
+    }
+
+    _free_offset = offset;
+    return KVSTORE_SUCCESS;
+}
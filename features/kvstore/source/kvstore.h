@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_KVSTORE_H
+#define MBED_KVSTORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/NonCopyable.h"
+#include "PlatformMutex.h"
+#include "BlockDevice.h"
+
+typedef enum {
+    KVSTORE_SUCCESS           =  0,
+    KVSTORE_READ_ERROR        = -1,
+    KVSTORE_WRITE_ERROR       = -2,
+    KVSTORE_NOT_FOUND         = -3,
+    KVSTORE_DATA_CORRUPT      = -4,
+    KVSTORE_BAD_VALUE         = -5,
+    KVSTORE_BUFF_TOO_SMALL    = -6,
+    KVSTORE_MEDIA_FULL        = -7,
+    KVSTORE_OS_ERROR          = -8,
+    KVSTORE_UNINITIALIZED     = -9,
+} kvstore_status_e;
+
+// Maximal key length in characters, excluding the terminator
+#define KVSTORE_MAX_KEY_SIZE 128
+
+/** KVStore class
+ *
+ *  A key-value store over a block device, with string keys, a log
+ *  structured value area and a hashed index held in RAM.
+ *
+ *  Values are appended to a log in one of two areas; the RAM index maps a
+ *  key hash straight to the record's media offset, so a get costs one hash
+ *  probe and one media read regardless of how many keys are stored or how
+ *  full the area is. Sets append to the log and update the index; when the
+ *  active area fills up, the live records (reachable from the index, so
+ *  stale and deleted ones are skipped) are compacted into the other area,
+ *  which bounds a set by the size of the live data set rather than the
+ *  media. The newer area wins at init, so a power cut during compaction
+ *  falls back to the fully intact old area.
+ */
+class KVStore : private mbed::NonCopyable<KVStore> {
+public:
+
+    /** An opaque iteration cursor, valid while no sets or removes intervene
+     */
+    typedef struct {
+        uint32_t slot;
+        char prefix[KVSTORE_MAX_KEY_SIZE + 1];
+    } iterator_t;
+
+    /**
+     * @brief KVStore over the given block device.
+     *
+     * @param[in]  bd                   Block device holding the store. The
+     *                                  device is split into two equal areas
+     *                                  that sets alternate between.
+     */
+    KVStore(BlockDevice *bd);
+
+    virtual ~KVStore();
+
+    /**
+     * @brief Initialize the store: mount the block device, pick the active
+     *        area and build the RAM index from the record log.
+     *
+     * @returns KVSTORE_SUCCESS           Initialization completed.
+     *          KVSTORE_READ_ERROR        Physical error reading data.
+     *          KVSTORE_OS_ERROR          Underlying device failed to initialize.
+     */
+    int init();
+
+    /**
+     * @brief Deinitialize the store, releasing the index and the device.
+     *
+     * @returns KVSTORE_SUCCESS           Deinitialization completed.
+     */
+    int deinit();
+
+    /**
+     * @brief Get the value stored under a key.
+     *
+     * @param[in]  key                  Null terminated key, at most
+     *                                  KVSTORE_MAX_KEY_SIZE characters.
+     * @param[in]  buf                  Buffer to store the value in.
+     * @param[in]  buf_size             Length of the buffer in bytes.
+     * @param[out] actual_size          Actual size of the value, may be
+     *                                  null.
+     *
+     * @returns KVSTORE_SUCCESS           Value was found.
+     *          KVSTORE_NOT_FOUND         No value stored under this key.
+     *          KVSTORE_BUFF_TOO_SMALL    Not enough room in the buffer.
+     *          KVSTORE_READ_ERROR        Physical error reading data.
+     *          KVSTORE_DATA_CORRUPT      Record on media failed its checksum.
+     *          KVSTORE_BAD_VALUE         Bad value in any of the parameters.
+     */
+    int get(const char *key, void *buf, size_t buf_size, size_t *actual_size = 0);
+
+    /**
+     * @brief Get the size of the value stored under a key.
+     *
+     * @param[in]  key                  Null terminated key.
+     * @param[out] actual_size          Size of the value in bytes.
+     *
+     * @returns KVSTORE_SUCCESS           Value was found.
+     *          KVSTORE_NOT_FOUND         No value stored under this key.
+     *          KVSTORE_READ_ERROR        Physical error reading data.
+     *          KVSTORE_BAD_VALUE         Bad value in any of the parameters.
+     */
+    int get_size(const char *key, size_t *actual_size);
+
+    /**
+     * @brief Store a value under a key, replacing any previous value.
+     *
+     * @param[in]  key                  Null terminated key, at most
+     *                                  KVSTORE_MAX_KEY_SIZE characters.
+     * @param[in]  buf                  Buffer containing the value.
+     * @param[in]  buf_size             Value size in bytes.
+     *
+     * @returns KVSTORE_SUCCESS           Value was successfully stored.
+     *          KVSTORE_WRITE_ERROR       Physical error writing data.
+     *          KVSTORE_MEDIA_FULL        Live data does not fit in one area.
+     *          KVSTORE_BAD_VALUE         Bad value in any of the parameters.
+     */
+    int set(const char *key, const void *buf, size_t buf_size);
+
+    /**
+     * @brief Remove a key and its value.
+     *
+     * @param[in]  key                  Null terminated key.
+     *
+     * @returns KVSTORE_SUCCESS           Key was removed.
+     *          KVSTORE_NOT_FOUND         No value stored under this key.
+     *          KVSTORE_WRITE_ERROR       Physical error writing data.
+     *          KVSTORE_BAD_VALUE         Bad value in any of the parameters.
+     */
+    int remove(const char *key);
+
+    /**
+     * @brief Remove all keys and values, erasing the store.
+     *
+     * @returns KVSTORE_SUCCESS           Store was reset.
+     *          KVSTORE_WRITE_ERROR       Physical error writing data.
+     */
+    int reset();
+
+    /**
+     * @brief Number of keys currently stored.
+     *
+     * @returns Number of keys.
+     */
+    size_t get_num_keys() const;
+
+    /**
+     * @brief Open an iterator over all keys starting with a prefix.
+     *
+     * Iteration order is unspecified. The cursor is invalidated by any
+     * set or remove.
+     *
+     * @param[out] it                   Iterator to initialize.
+     * @param[in]  prefix               Key prefix to match, null or empty
+     *                                  for all keys.
+     *
+     * @returns KVSTORE_SUCCESS           Iterator was opened.
+     *          KVSTORE_BAD_VALUE         Bad value in any of the parameters.
+     */
+    int iterator_open(iterator_t *it, const char *prefix = 0);
+
+    /**
+     * @brief Get the next matching key.
+     *
+     * @param[in]  it                   Iterator opened with iterator_open.
+     * @param[out] key                  Buffer for the null terminated key.
+     * @param[in]  key_size             Length of the key buffer in bytes.
+     *
+     * @returns KVSTORE_SUCCESS           A key was returned.
+     *          KVSTORE_NOT_FOUND         No more matching keys.
+     *          KVSTORE_BUFF_TOO_SMALL    Not enough room in the key buffer.
+     *          KVSTORE_READ_ERROR        Physical error reading data.
+     */
+    int iterator_next(iterator_t *it, char *key, size_t key_size);
+
+private:
+    typedef struct {
+        uint32_t hash;
+        uint32_t offset; // offset of the record in the active area, 0 if free
+    } index_entry_t;
+
+    BlockDevice *_bd;
+    PlatformMutex _mutex;
+    index_entry_t *_index;
+    uint32_t _index_capacity;
+    uint32_t _num_keys;
+    uint32_t _num_slots_used; // keys plus tombstones
+    uint8_t *_chunk_buf;
+    uint32_t _chunk_size;
+    bd_size_t _prog_size;
+    bd_size_t _area_size;
+    uint32_t _active_area;
+    uint32_t _active_generation;
+    uint32_t _free_offset;
+    bool _is_initialized;
+
+    // Base media address of an area
+    bd_addr_t area_addr(uint32_t area) const;
+
+    // Write an area header with the given generation
+    int write_area_header(uint32_t area, uint32_t generation);
+
+    // Read and validate an area header, returning its generation
+    int read_area_header(uint32_t area, bool &valid, uint32_t &generation);
+
+    // Stream a record (header, key, value) to the given offset of the
+    // active area, returning the padded record size
+    int write_record(uint32_t offset, const char *key, const void *data,
+            uint32_t data_size, uint16_t flags, uint32_t &next_offset);
+
+    // Read and validate a record header and key at the given offset.
+    // On a key match the value size and flags are returned.
+    int read_record_key(uint32_t area, uint32_t offset, const char *key,
+            bool &key_match, uint32_t &data_size, uint16_t &flags,
+            uint32_t &next_offset);
+
+    // Read the key stored at the given offset
+    int read_record_name(uint32_t area, uint32_t offset, char *key, size_t key_size);
+
+    // Read a record's value into a user buffer, checking the record crc
+    int read_record_data(uint32_t area, uint32_t offset, void *buf,
+            size_t buf_size, size_t *actual_size);
+
+    // Stream a record and check its crc without copying anything out
+    int verify_record(uint32_t area, uint32_t offset);
+
+    // Copy a whole record between areas
+    int copy_record(uint32_t from_area, uint32_t from_offset,
+            uint32_t to_offset, uint32_t &next_offset);
+
+    // Find the index slot of a key, probing from its hash
+    int index_find(const char *key, uint32_t &slot, bool &found);
+
+    // Insert or update a key's offset in the index, growing it when load demands
+    int index_insert(const char *key, uint32_t offset);
+
+    // Double the index and rehash, dropping tombstones
+    int index_grow();
+
+    // Compact the live records into the other area and switch to it
+    int garbage_collect();
+
+    // Build the index by scanning the active area's record log
+    int build_index();
+};
+
+#endif
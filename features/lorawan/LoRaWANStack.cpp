@@ -26,6 +26,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <string.h>
 #include <stdlib.h>
 #include "platform/Callback.h"
+#include "platform/mbed_pkt_trace.h"
 #include "events/EventQueue.h"
 
 #include "LoRaWANStack.h"
@@ -329,6 +330,10 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
 
     status = state_controller(DEVICE_STATE_SCHEDULING);
 
+    if (status == LORAWAN_STATUS_OK) {
+        MBED_PKT_TRACE(MBED_PKT_TRACE_LORA, MBED_PKT_TRACE_TX, len, port);
+    }
+
     // send user the length of data which is scheduled now.
     // user should take care of the pending data.
     return (status == LORAWAN_STATUS_OK) ? len : (int16_t) status;
@@ -487,10 +492,9 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
         return LORAWAN_STATUS_NOT_INITIALIZED;
     }
 
-    int id = _loramac.get_backoff_timer_event_id();
+    backoff = _loramac.get_backoff_time_left();
 
-    if (_loramac.get_backoff_timer_event_id() > 0) {
-        backoff = _queue->time_left(id);
+    if (backoff >= 0) {
         return LORAWAN_STATUS_OK;
     }
 
@@ -516,6 +520,29 @@ void LoRaWANStack::rx_interrupt_handler(const uint8_t *payload, uint16_t size,
         return;
     }
 
+    // In a dense deployment the vast majority of downlinks are addressed to
+    // other nodes. Their device address travels in clear text right after the
+    // MAC header, so peek at it here and discard foreign data frames before
+    // they cost us a copy, an event allocation and a full MAC parse. Frames
+    // that are not well-formed data frames (join accepts, proprietary
+    // traffic, truncated frames) are left for the MAC to judge. The port is
+    // deliberately not filtered: a frame carrying our address may piggyback
+    // MAC commands or an ACK on any port.
+    loramac_mhdr_t mac_hdr;
+    mac_hdr.value = payload[0];
+    if ((mac_hdr.bits.mtype == FRAME_TYPE_DATA_UNCONFIRMED_DOWN
+            || mac_hdr.bits.mtype == FRAME_TYPE_DATA_CONFIRMED_DOWN)
+            && size >= LORA_MAC_MIN_DATA_FRAME_LEN) {
+        uint32_t address = payload[1];
+        address |= ((uint32_t) payload[2] << 8);
+        address |= ((uint32_t) payload[3] << 16);
+        address |= ((uint32_t) payload[4] << 24);
+
+        if (!_loramac.accepts_downlink_address(address)) {
+            return;
+        }
+    }
+
     _ready_for_rx = false;
     memcpy(_rx_payload, payload, size);
 
@@ -918,6 +945,8 @@ void LoRaWANStack::mcps_confirm_handler()
 
     // failure case
     tr_error("mcps_confirmation: Error code = %d", _loramac.get_mcps_confirmation()->status);
+    MBED_PKT_TRACE(MBED_PKT_TRACE_LORA, MBED_PKT_TRACE_TX_DROP, 0,
+                   _loramac.get_mcps_confirmation()->status);
 
     if (_loramac.get_mcps_confirmation()->status == LORAMAC_EVENT_INFO_STATUS_TX_TIMEOUT) {
         send_event_to_application(TX_TIMEOUT);
@@ -933,6 +962,7 @@ void LoRaWANStack::mcps_indication_handler()
     const loramac_mcps_indication_t *mcps_indication = _loramac.get_mcps_indication();
     if (mcps_indication->status != LORAMAC_EVENT_INFO_STATUS_OK) {
         tr_error("RX_ERROR: mcps_indication status = %d", mcps_indication->status);
+        MBED_PKT_TRACE(MBED_PKT_TRACE_LORA, MBED_PKT_TRACE_RX_DROP, 0, mcps_indication->status);
         send_event_to_application(RX_ERROR);
         return;
     }
@@ -965,6 +995,8 @@ void LoRaWANStack::mcps_indication_handler()
             tr_debug("Packet Received %d bytes, Port=%d",
                      _rx_msg.msg.mcps_indication.buffer_size,
                      mcps_indication->port);
+            MBED_PKT_TRACE(MBED_PKT_TRACE_LORA, MBED_PKT_TRACE_RX,
+                           mcps_indication->buffer_size, mcps_indication->port);
             _rx_msg.receive_ready = true;
             send_event_to_application(RX_DONE);
         }
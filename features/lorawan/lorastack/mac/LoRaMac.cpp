@@ -641,12 +641,12 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
     if (_params.is_rx_window_enabled == true) {
         lorawan_time_t time_diff = _lora_time.get_current_time() - timestamp;
         // start timer after which rx1_window will get opened
-        _lora_time.start(_params.timers.rx_window1_timer,
-                         _params.rx_window1_delay - time_diff);
+        _lora_time.start_critical(_params.timers.rx_window1_timer,
+                                  _params.rx_window1_delay - time_diff);
 
         if (_device_class != CLASS_C) {
-            _lora_time.start(_params.timers.rx_window2_timer,
-                             _params.rx_window2_delay - time_diff);
+            _lora_time.start_critical(_params.timers.rx_window2_timer,
+                                      _params.rx_window2_delay - time_diff);
         }
 
         if (_params.is_node_ack_requested) {
@@ -1014,15 +1014,15 @@ lorawan_status_t LoRaMac::send(loramac_mhdr_t *machdr, const uint8_t fport,
     return status;
 }
 
-int LoRaMac::get_backoff_timer_event_id(void)
+int LoRaMac::get_backoff_time_left(void)
 {
-    return _params.timers.backoff_timer.timer_id;
+    return _lora_time.time_remaining(_params.timers.backoff_timer);
 }
 
 lorawan_status_t LoRaMac::clear_tx_pipe(void)
 {
-    // check if the event is not already queued
-    if (_ev_queue->time_left(get_backoff_timer_event_id()) > 0) {
+    // check if the backoff timer is still pending
+    if (_lora_time.is_running(_params.timers.backoff_timer)) {
         _lora_time.stop(_params.timers.backoff_timer);
         _lora_time.stop(_params.timers.ack_timeout_timer);
         memset(_params.tx_buffer, 0, sizeof _params.tx_buffer);
@@ -1891,6 +1891,22 @@ lorawan_status_t LoRaMac::multicast_channel_unlink(multicast_params_t *channel_p
     return LORAWAN_STATUS_OK;
 }
 
+bool LoRaMac::accepts_downlink_address(uint32_t address) const
+{
+    if (address == _params.dev_addr) {
+        return true;
+    }
+
+    for (const multicast_params_t *cur = _params.multicast_channels;
+            cur != NULL; cur = cur->next) {
+        if (address == cur->address) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void LoRaMac::bind_radio_driver(LoRaRadio &radio)
 {
     _lora_phy.set_radio_instance(radio);
@@ -210,6 +210,22 @@ public:
      */
     lorawan_status_t multicast_channel_unlink(multicast_params_t *channel_param);
 
+    /**
+     * @brief   Checks whether a downlink device address concerns this node.
+     *
+     * @details Returns true when the given address matches either the node's
+     *          own network address or one of the linked multicast channels.
+     *          The check is cheap enough to run from the radio interrupt,
+     *          where the stack uses it to discard traffic addressed to other
+     *          nodes before spending any further work on it.
+     *
+     * @param [in] address    The device address carried by a downlink frame.
+     *
+     * @return  True if the frame is (potentially) meant for this node,
+     *          false otherwise.
+     */
+    bool accepts_downlink_address(uint32_t address) const;
+
     /** Binds radio driver to PHY layer.
      *
      * MAC layer is totally detached from the PHY layer so the stack layer
@@ -445,9 +461,10 @@ public:
     void set_batterylevel_callback(mbed::Callback<uint8_t(void)> battery_level);
 
     /**
-     * Returns the event ID of backoff timer.
+     * Returns the time left until the backoff timer expires in
+     * milliseconds, or a negative value if it is not running.
      */
-    int get_backoff_timer_event_id(void);
+    int get_backoff_time_left(void);
 
     /**
      * Clears out the TX pipe by discarding any outgoing message if the backoff
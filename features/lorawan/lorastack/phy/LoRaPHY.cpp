@@ -37,9 +37,12 @@ SPDX-License-Identifier: BSD-3-Clause
 
 LoRaPHY::LoRaPHY(LoRaWANTimeHandler &lora_time)
     : _radio(NULL),
-      _lora_time(lora_time)
+      _lora_time(lora_time),
+      _channel_cache_count(0),
+      _channel_cache_datarate(-1)
 {
     memset(&phy_params, 0, sizeof(phy_params));
+    memset(_channel_cache_mask, 0, sizeof(_channel_cache_mask));
 }
 
 LoRaPHY::~LoRaPHY()
@@ -458,26 +461,48 @@ uint8_t LoRaPHY::enabled_channel_count(bool joined, uint8_t datarate,
 {
     uint8_t count = 0;
     uint8_t delay_transmission = 0;
+    const uint8_t mask_size = (phy_params.max_channel_cnt + 15) / 16;
 
-    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
-        if (mask_bit_test(channel_mask, i)) {
+    // Re-filter the channel plan only when the mask or the datarate has
+    // changed since the previous call. In the common case of back-to-back
+    // uplinks on an unchanged plan, the cached list is reused and only
+    // the per-band duty-cycle state below has to be re-tested.
+    if (datarate != _channel_cache_datarate
+            || memcmp(_channel_cache_mask, channel_mask,
+                      mask_size * sizeof(uint16_t)) != 0) {
 
-            if (val_in_range(datarate, phy_params.channels.channel_list[i].dr_range.fields.min,
-                             phy_params.channels.channel_list[i].dr_range.fields.max) == 0) {
-                // data rate range invalid for this channel
-                continue;
-            }
+        _channel_cache_count = 0;
 
-            band_t *band_table = (band_t *) phy_params.bands.table;
-            if (band_table[phy_params.channels.channel_list[i].band].off_time > 0) {
-                // Check if the band is available for transmission
-                delay_transmission++;
-                continue;
+        for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
+            if (mask_bit_test(channel_mask, i)) {
+
+                if (val_in_range(datarate, phy_params.channels.channel_list[i].dr_range.fields.min,
+                                 phy_params.channels.channel_list[i].dr_range.fields.max) == 0) {
+                    // data rate range invalid for this channel
+                    continue;
+                }
+
+                _channel_cache[_channel_cache_count++] = i;
             }
+        }
+
+        memcpy(_channel_cache_mask, channel_mask, mask_size * sizeof(uint16_t));
+        _channel_cache_datarate = datarate;
+    }
+
+    band_t *band_table = (band_t *) phy_params.bands.table;
 
-            // otherwise count the channel as enabled
-            channel_indices[count++] = i;
+    for (uint8_t i = 0; i < _channel_cache_count; i++) {
+        uint8_t channel = _channel_cache[i];
+
+        if (band_table[phy_params.channels.channel_list[channel].band].off_time > 0) {
+            // Check if the band is available for transmission
+            delay_transmission++;
+            continue;
         }
+
+        // otherwise count the channel as enabled
+        channel_indices[count++] = channel;
     }
 
     *delayTx = delay_transmission;
@@ -485,6 +510,11 @@ uint8_t LoRaPHY::enabled_channel_count(bool joined, uint8_t datarate,
     return count;
 }
 
+void LoRaPHY::invalidate_channel_cache()
+{
+    _channel_cache_datarate = -1;
+}
+
 bool LoRaPHY::is_datarate_supported(const int8_t datarate) const
 {
     if (datarate < phy_params.datarates.size) {
@@ -1351,6 +1381,10 @@ lorawan_status_t LoRaPHY::add_channel(const channel_params_t *new_channel,
 
     mask_bit_set(phy_params.channels.mask, id);
 
+    // The channel's datarate range may have changed without touching the
+    // mask, so the cached channel-plan lookup has to be rebuilt.
+    invalidate_channel_cache();
+
     return LORAWAN_STATUS_OK;
 }
 
@@ -40,6 +40,10 @@
 #include "LoRaRadio.h"
 #include "lora_phy_ds.h"
 
+// Largest channel plan among the supported PHYs (CN470 uses 96 channels)
+#define MAX_CHANNEL_PLAN_SIZE          96
+#define MAX_CHANNEL_PLAN_MASK_SIZE     6
+
 class LoRaPHY : private mbed::NonCopyable<LoRaPHY> {
 
 public:
@@ -628,10 +632,29 @@ protected:
 
     bool is_datarate_supported(const int8_t datarate) const;
 
+    /**
+     * Invalidates the precomputed channel-plan lookup table, forcing
+     * enabled_channel_count() to re-filter the plan on its next call.
+     * Must be called whenever a channel's datarate range changes.
+     */
+    void invalidate_channel_cache();
+
 protected:
     LoRaRadio *_radio;
     LoRaWANTimeHandler &_lora_time;
     loraphy_params_t phy_params;
+
+    /**
+     * Precomputed channel-plan lookup table: the indices of channels that
+     * are enabled in the channel mask and support a given datarate.
+     * enabled_channel_count() rebuilds it only when the mask or the
+     * datarate has changed since the previous TX attempt, so steady-state
+     * channel selection only tests band duty-cycle availability.
+     */
+    uint8_t _channel_cache[MAX_CHANNEL_PLAN_SIZE];
+    uint16_t _channel_cache_mask[MAX_CHANNEL_PLAN_MASK_SIZE];
+    uint8_t _channel_cache_count;
+    int8_t _channel_cache_datarate;
 };
 
 #endif /* MBED_OS_LORAPHY_BASE_ */
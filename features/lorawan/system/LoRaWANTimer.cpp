@@ -18,6 +18,8 @@ Copyright (c) 2017, Arm Limited and affiliates.
 SPDX-License-Identifier: BSD-3-Clause
 */
 
+#include <string.h>
+
 #include "LoRaWANTimer.h"
 
 LoRaWANTimeHandler::LoRaWANTimeHandler()
@@ -47,18 +49,64 @@ lorawan_time_t LoRaWANTimeHandler::get_elapsed_time(lorawan_time_t saved_time)
 
 void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callback)
 {
+    memset(&obj.header, 0, sizeof(obj.header));
+    // The storage's data region follows its header
+    equeue_event_period(&obj.header + 1, -1);
     obj.callback = callback;
-    obj.timer_id = 0;
+    obj.queued = false;
 }
 
 void LoRaWANTimeHandler::start(timer_event_t &obj, const uint32_t timeout)
 {
-    obj.timer_id = _queue->call_in(timeout, obj.callback);
-    MBED_ASSERT(obj.timer_id != 0);
+    arm(obj, timeout, 0);
+}
+
+void LoRaWANTimeHandler::start_critical(timer_event_t &obj, const uint32_t timeout)
+{
+    arm(obj, timeout, EQUEUE_LANES - 1);
 }
 
 void LoRaWANTimeHandler::stop(timer_event_t &obj)
 {
-    _queue->cancel(obj.timer_id);
-    obj.timer_id = 0;
+    if (obj.queued) {
+        _queue->cancel_user_allocated(&obj.header + 1);
+        obj.queued = false;
+    }
+}
+
+bool LoRaWANTimeHandler::is_running(const timer_event_t &obj) const
+{
+    return obj.queued;
+}
+
+int LoRaWANTimeHandler::time_remaining(timer_event_t &obj)
+{
+    if (!obj.queued) {
+        return -1;
+    }
+    return _queue->time_left_user_allocated(&obj.header + 1);
+}
+
+void LoRaWANTimeHandler::arm(timer_event_t &obj, const uint32_t timeout, int lane)
+{
+    // Re-arming an armed timer replaces its timeout
+    if (obj.queued) {
+        _queue->cancel_user_allocated(&obj.header + 1);
+    }
+
+    void *data = &obj.header + 1;
+    equeue_event_delay(data, timeout);
+    equeue_event_lane(data, lane);
+    obj.queued = true;
+    _queue->post_user_allocated(&LoRaWANTimeHandler::event_thunk, data);
+}
+
+void LoRaWANTimeHandler::event_thunk(void *data)
+{
+    timer_event_t *timer = (timer_event_t *)((struct equeue_event *)data - 1);
+
+    timer->queued = false;
+    if (timer->callback) {
+        timer->callback();
+    }
 }
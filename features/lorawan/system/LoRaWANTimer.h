@@ -59,25 +59,66 @@ public:
      * @remark The TimerSetValue function must be called before starting the timer.
      *         This function initializes the time-stamp and reloads the value at 0.
      *
+     * Prepares the object's embedded event storage; no memory is taken
+     * from the event queue, neither here nor when the timer is armed.
+     *
      * @param [in] obj          The structure containing the timer object parameters.
      * @param [in] callback     The function callback called at the end of the timeout.
      */
      void init(timer_event_t &obj, mbed::Callback<void()> callback);
 
     /** Starts and adds the timer object to the list of timer events.
+     *
+     * Arming uses the preallocated storage inside the timer object, so it
+     * cannot fail under queue memory pressure. A timer that is already
+     * running is re-armed with the new timeout.
      *
      * @param [in] obj     The structure containing the timer object parameters.
      * @param [in] timeout The new timeout value.
      */
     void start(timer_event_t &obj, const uint32_t timeout);
 
+    /** Starts the timer object as a deadline-scheduled radio event.
+     *
+     * Behaves like start(), but posts the expiry in the highest priority
+     * lane of the event queue, so that once due it is dispatched ahead of
+     * ordinary application events sharing the queue. Use for the RX window
+     * timers, where dispatch delay behind an application handler means a
+     * missed window and a costly retransmission.
+     *
+     * @param [in] obj     The structure containing the timer object parameters.
+     * @param [in] timeout The new timeout value.
+     */
+    void start_critical(timer_event_t &obj, const uint32_t timeout);
+
     /** Stops and removes the timer object from the list of timer events.
      *
      * @param [in] obj The structure containing the timer object parameters.
      */
     void stop(timer_event_t &obj);
 
+    /** Tells whether the timer object is currently running.
+     *
+     * @param [in] obj The structure containing the timer object parameters.
+     * @return         True if the timer is armed and has not expired yet.
+     */
+    bool is_running(const timer_event_t &obj) const;
+
+    /** Time left until a running timer object expires.
+     *
+     * @param [in] obj The structure containing the timer object parameters.
+     * @return         The remaining time in milliseconds, or a negative
+     *                 value if the timer is not running.
+     */
+    int time_remaining(timer_event_t &obj);
+
 private:
+    /** Arms the timer's embedded event in the given priority lane. */
+    void arm(timer_event_t &obj, const uint32_t timeout, int lane);
+
+    /** Runs in queue context when a timer expires. */
+    static void event_thunk(void *data);
+
     events::EventQueue *_queue;
 };
 
@@ -35,6 +35,7 @@
 #define LORAWAN_SYSTEM_LORAWAN_DATA_STRUCTURES_H_
 
 #include <inttypes.h>
+#include "events/equeue/equeue.h"
 #include "lorawan_types.h"
 
 /*!
@@ -60,6 +61,11 @@ typedef uint32_t lorawan_time_t;
  */
 #define LORA_MAC_FRMPAYLOAD_OVERHEAD                13 // MHDR(1) + FHDR(7) + Port(1) + MIC(4)
 
+/*!
+ * The shortest well-formed data frame (no FOpts, no FRMPayload).
+ */
+#define LORA_MAC_MIN_DATA_FRAME_LEN                 12 // MHDR(1) + FHDR(7) + MIC(4)
+
 /**
  * LoRaMac maximum number of channels
  */
@@ -1038,10 +1044,25 @@ typedef struct {
 
 /*!
  * \brief Timer object description
+ *
+ * Carries its own preallocated event storage and is linked into the event
+ * queue intrusively, so arming and cancelling a MAC timer never touches
+ * the queue's allocator - the RX window timers cannot lose out to
+ * application events contending for queue memory.
  */
 typedef struct {
+    /*!
+     * Preallocated event queue storage, must stay the first member.
+     */
+    struct equeue_event header;
+    /*!
+     * The function run in the event queue's context on expiry.
+     */
     mbed::Callback<void()> callback;
-    int timer_id;
+    /*!
+     * Set while the timer is armed on the event queue.
+     */
+    bool queued;
 } timer_event_t;
 
 typedef struct {
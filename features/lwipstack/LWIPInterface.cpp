@@ -35,6 +35,7 @@
 #include "lwip/mld6.h"
 #include "lwip/dns.h"
 #include "lwip/udp.h"
+#include "lwip/memp.h"
 
 #include "ppp_lwip.h"
 
@@ -305,12 +306,38 @@ char *LWIP::Interface::get_gateway(char *buf, nsapi_size_t buflen)
 #endif
 }
 
+nsapi_error_t LWIP::Interface::get_stats(nsapi_interface_stats_t *stats_out)
+{
+    *stats_out = stats;
+    return NSAPI_ERROR_OK;
+}
+
+char *LWIP::Interface::get_interface_name(char *buf)
+{
+    (void) snprintf(buf, NSAPI_INTERFACE_NAME_SIZE, "%c%c%d",
+             netif.name[0], netif.name[1], netif.num);
+    return buf;
+}
+
 LWIP::Interface::Interface() :
         hw(NULL), has_addr_state(0),
         connected(NSAPI_STATUS_DISCONNECTED),
         dhcp_started(false), dhcp_has_to_be_set(false), blocking(true), ppp(false)
 {
     memset(&netif, 0, sizeof netif);
+    memset(&stats, 0, sizeof stats);
+
+#ifdef MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN
+    memset(tx_head, 0, sizeof tx_head);
+    memset(tx_count, 0, sizeof tx_count);
+    tx_drain_scheduled = false;
+#endif
+
+#ifdef MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET
+    rx_head = 0;
+    rx_count = 0;
+    rx_poll_scheduled = false;
+#endif
 
     osSemaphoreAttr_t attr;
     attr.name = NULL;
@@ -342,6 +369,25 @@ LWIP::Interface::Interface() :
     list = this;
 }
 
+#if MBED_CONF_LWIP_POOL_PREWARM
+void LWIP::prewarm_pools(void)
+{
+#if !MEMP_MEM_MALLOC
+    // Touch every byte of the statically allocated pool backing stores,
+    // so the first traffic burst does not pay for lazily faulted or
+    // background-initialized memory (ECC scrub, MPU lazy mapping)
+    for (unsigned int i = 0; i < MEMP_MAX; i++) {
+        const struct memp_desc *desc = memp_pools[i];
+        volatile u8_t *base = desc->base;
+        size_t span = (size_t)desc->num * (MEMP_SIZE + MEMP_ALIGN_SIZE(desc->size));
+        for (size_t offset = 0; offset < span; offset += sizeof(uint32_t)) {
+            (void)base[offset];
+        }
+    }
+#endif
+}
+#endif
+
 nsapi_error_t LWIP::add_ethernet_interface(EMAC &emac, bool default_if, OnboardNetworkStack::Interface **interface_out)
 {
 #if LWIP_ETHERNET
@@ -392,6 +438,10 @@ nsapi_error_t LWIP::add_ethernet_interface(EMAC &emac, bool default_if, OnboardN
     }
     lwip_add_random_seed(seed);
 
+#if MBED_CONF_LWIP_POOL_PREWARM
+    prewarm_pools();
+#endif
+
     return NSAPI_ERROR_OK;
 #else
     return NSAPI_ERROR_UNSUPPORTED;
@@ -21,11 +21,126 @@
 #include "lwip/ethip6.h"
 #include "netsocket/nsapi_types.h"
 #include "netsocket/EMAC.h"
+#include "platform/mbed_pkt_trace.h"
 
 #include "LWIPStack.h"
 
 #if LWIP_ETHERNET
 
+#ifdef MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN
+
+#include "lwip/timeouts.h"
+
+#define TX_LANE_HIGH    0
+#define TX_LANE_LOW     1
+
+/* How long to wait before re-offering held frames to a busy driver */
+#define TX_DRAIN_RETRY_MS 1
+
+/* Frames from sockets marked with the NSAPI_TXPRIO option carry DSCP class
+   selector 5 or above in their IP header; PTP event frames have their own
+   EtherType. Everything else is bulk. */
+static int emac_tx_classify(struct pbuf *p)
+{
+    const u8_t *frame = static_cast<const u8_t *>(p->payload);
+
+    if (p->len < 16) {
+        return TX_LANE_LOW;
+    }
+
+    u16_t type = (frame[12] << 8) | frame[13];
+    u8_t tos;
+    if (type == 0x88F7) {
+        return TX_LANE_HIGH;
+    } else if (type == 0x0800) {
+        tos = frame[15];
+    } else if (type == 0x86DD) {
+        tos = ((frame[14] & 0x0F) << 4) | (frame[15] >> 4);
+    } else {
+        return TX_LANE_LOW;
+    }
+
+    return tos >= 0xA0 ? TX_LANE_HIGH : TX_LANE_LOW;
+}
+
+bool LWIP::Interface::emac_tx_out(struct pbuf *p)
+{
+    /* link_out consumes a reference whether or not it manages to send */
+    pbuf_ref(p);
+
+    u16_t len = p->tot_len;
+    if (!emac->link_out(p)) {
+        return false;
+    }
+
+    stats.bytes_sent += len;
+    stats.packets_sent++;
+    MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_TX, len, 0);
+    return true;
+}
+
+void LWIP::Interface::emac_tx_drain_now()
+{
+    bool busy = false;
+
+    for (int lane = TX_LANE_HIGH; lane <= TX_LANE_LOW && !busy; lane++) {
+        while (tx_count[lane]) {
+            struct pbuf *p = tx_lane[lane][tx_head[lane]];
+            if (!emac_tx_out(p)) {
+                busy = true;
+                break;
+            }
+            pbuf_free(p);
+            tx_head[lane] = (tx_head[lane] + 1) % MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN;
+            tx_count[lane]--;
+        }
+    }
+
+    if ((tx_count[TX_LANE_HIGH] || tx_count[TX_LANE_LOW]) && !tx_drain_scheduled) {
+        tx_drain_scheduled = true;
+        sys_timeout(TX_DRAIN_RETRY_MS, &LWIP::Interface::emac_tx_drain, this);
+    }
+}
+
+void LWIP::Interface::emac_tx_drain(void *arg)
+{
+    LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(arg);
+
+    mbed_if->tx_drain_scheduled = false;
+    mbed_if->emac_tx_drain_now();
+}
+
+err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p)
+{
+    LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(netif->state);
+
+    /* Both this and the drain timeout run under the lwIP core protection,
+       so the lanes need no further locking */
+    if (mbed_if->tx_count[TX_LANE_HIGH] == 0 && mbed_if->tx_count[TX_LANE_LOW] == 0 &&
+            mbed_if->emac_tx_out(p)) {
+        return ERR_OK;
+    }
+
+    /* Driver ring is full or older frames are waiting - hold the frame in
+       its lane so high-priority frames overtake queued bulk ones */
+    int lane = emac_tx_classify(p);
+    if (mbed_if->tx_count[lane] == MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN) {
+        mbed_if->stats.tx_drops++;
+        MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_TX_DROP, p->tot_len, 0);
+        return ERR_MEM;
+    }
+
+    pbuf_ref(p);
+    uint8_t slot = (mbed_if->tx_head[lane] + mbed_if->tx_count[lane]) % MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN;
+    mbed_if->tx_lane[lane][slot] = p;
+    mbed_if->tx_count[lane]++;
+
+    mbed_if->emac_tx_drain_now();
+    return ERR_OK;
+}
+
+#else /* MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN */
+
 err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p)
 {
     /* Increase reference counter since lwip stores handle to pbuf and frees
@@ -33,22 +148,141 @@ err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p
     pbuf_ref(p);
 
     LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(netif->state);
+    u16_t len = p->tot_len;
     bool ret = mbed_if->emac->link_out(p);
+    if (ret) {
+        mbed_if->stats.bytes_sent += len;
+        mbed_if->stats.packets_sent++;
+        MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_TX, len, 0);
+    } else {
+        mbed_if->stats.tx_drops++;
+        MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_TX_DROP, len, 0);
+    }
     return ret ? ERR_OK : ERR_IF;
 }
 
+#endif /* MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN */
+
+#ifdef MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET
+
+#include "platform/mbed_critical.h"
+
+#define RX_QUEUE_LEN (2 * MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET)
+
 void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
 {
     struct pbuf *p = static_cast<struct pbuf *>(buf);
+    bool schedule = false;
+    bool full;
+
+    /* Queue the frame instead of posting a tcpip message per frame; the
+       poll callback drains the queue in budgeted batches */
+    core_util_critical_section_enter();
+    full = (rx_count == RX_QUEUE_LEN);
+    if (!full) {
+        rx_queue[(rx_head + rx_count) % RX_QUEUE_LEN] = p;
+        rx_count++;
+        if (!rx_poll_scheduled) {
+            rx_poll_scheduled = true;
+            schedule = true;
+        }
+    }
+    core_util_critical_section_exit();
+
+    if (full) {
+        stats.rx_drops++;
+        MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_RX_DROP, p->tot_len, 0);
+        pbuf_free(p);
+        return;
+    }
+
+    if (schedule) {
+        if (tcpip_callback_with_block(&LWIP::Interface::emac_rx_poll, this, 0) != ERR_OK) {
+            /* Message box full - clear the flag so the next frame retries */
+            core_util_critical_section_enter();
+            rx_poll_scheduled = false;
+            core_util_critical_section_exit();
+        }
+    }
+}
+
+void LWIP::Interface::emac_rx_poll(void *arg)
+{
+    LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(arg);
+
+    for (;;) {
+        /* Drain up to the budget, then yield the tcpip thread so timers
+           and TX work interleave with a sustained receive flood */
+        for (int budget = MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET; budget > 0; budget--) {
+            struct pbuf *p = NULL;
+
+            core_util_critical_section_enter();
+            if (mbed_if->rx_count) {
+                p = mbed_if->rx_queue[mbed_if->rx_head];
+                mbed_if->rx_head = (mbed_if->rx_head + 1) % RX_QUEUE_LEN;
+                mbed_if->rx_count--;
+            }
+            core_util_critical_section_exit();
+
+            if (p == NULL) {
+                break;
+            }
+
+            mbed_if->stats.bytes_recv += p->tot_len;
+            mbed_if->stats.packets_recv++;
+            MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_RX, p->tot_len, 0);
+
+            /* Already running in the tcpip thread, so feed ethernet_input
+               directly rather than bouncing through the message box */
+            if (ethernet_input(p, &mbed_if->netif) != ERR_OK) {
+                LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
+                mbed_if->stats.rx_drops++;
+
+                pbuf_free(p);
+            }
+        }
+
+        bool done;
+        core_util_critical_section_enter();
+        done = (mbed_if->rx_count == 0);
+        if (done) {
+            mbed_if->rx_poll_scheduled = false;
+        }
+        core_util_critical_section_exit();
+
+        if (done) {
+            return;
+        }
+
+        if (tcpip_callback_with_block(&LWIP::Interface::emac_rx_poll, mbed_if, 0) == ERR_OK) {
+            return;
+        }
+        /* Could not repost - keep draining inline rather than strand the
+           queued frames */
+    }
+}
+
+#else /* MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET */
+
+void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
+{
+    struct pbuf *p = static_cast<struct pbuf *>(buf);
+
+    stats.bytes_recv += p->tot_len;
+    stats.packets_recv++;
+    MBED_PKT_TRACE(MBED_PKT_TRACE_EMAC, MBED_PKT_TRACE_RX, p->tot_len, 0);
 
     /* pass all packets to ethernet_input, which decides what packets it supports */
     if (netif.input(p, &netif) != ERR_OK) {
         LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
+        stats.rx_drops++;
 
         pbuf_free(p);
     }
 }
 
+#endif /* MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET */
+
 void LWIP::Interface::emac_state_change(bool up)
 {
     if (up) {
@@ -160,6 +394,38 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
 
     mbed_if->emac->get_ifname(netif->name, 2);
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* Leave software checksumming enabled only where the hardware does
+       not offload it */
+    uint32_t cksum = mbed_if->emac->get_checksum_capabilities();
+    uint16_t chk_flags = NETIF_CHECKSUM_ENABLE_ALL;
+    if (cksum & EMAC::CKSUM_GEN_IP) {
+        chk_flags &= ~NETIF_CHECKSUM_GEN_IP;
+    }
+    if (cksum & EMAC::CKSUM_GEN_UDP) {
+        chk_flags &= ~NETIF_CHECKSUM_GEN_UDP;
+    }
+    if (cksum & EMAC::CKSUM_GEN_TCP) {
+        chk_flags &= ~NETIF_CHECKSUM_GEN_TCP;
+    }
+    if (cksum & EMAC::CKSUM_GEN_ICMP) {
+        chk_flags &= ~(NETIF_CHECKSUM_GEN_ICMP | NETIF_CHECKSUM_GEN_ICMP6);
+    }
+    if (cksum & EMAC::CKSUM_CHECK_IP) {
+        chk_flags &= ~NETIF_CHECKSUM_CHECK_IP;
+    }
+    if (cksum & EMAC::CKSUM_CHECK_UDP) {
+        chk_flags &= ~NETIF_CHECKSUM_CHECK_UDP;
+    }
+    if (cksum & EMAC::CKSUM_CHECK_TCP) {
+        chk_flags &= ~NETIF_CHECKSUM_CHECK_TCP;
+    }
+    if (cksum & EMAC::CKSUM_CHECK_ICMP) {
+        chk_flags &= ~(NETIF_CHECKSUM_CHECK_ICMP | NETIF_CHECKSUM_CHECK_ICMP6);
+    }
+    NETIF_SET_CHECKSUM_CTRL(netif, chk_flags);
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
 #if LWIP_IPV4
     netif->output = etharp_output;
 #if LWIP_IGMP
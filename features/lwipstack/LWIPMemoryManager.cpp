@@ -42,6 +42,29 @@ emac_mem_buf_t *LWIPMemoryManager::alloc_pool(uint32_t size, uint32_t align)
     return static_cast<emac_mem_buf_t *>(pbuf);
 }
 
+emac_mem_buf_t *LWIPMemoryManager::alloc_pool_contiguous(uint32_t size, uint32_t align)
+{
+    if (size > get_pool_alloc_unit(align)) {
+        return NULL;
+    }
+
+    struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + align, PBUF_POOL);
+    if (pbuf == NULL) {
+        return NULL;
+    }
+
+    // A fragmented pool can still produce a chain - that cannot be handed
+    // to a DMA engine, so treat it as an allocation failure
+    if (pbuf->next != NULL) {
+        pbuf_free(pbuf);
+        return NULL;
+    }
+
+    align_memory(pbuf, align);
+
+    return static_cast<emac_mem_buf_t *>(pbuf);
+}
+
 uint32_t LWIPMemoryManager::get_pool_alloc_unit(uint32_t align) const
 {
     uint32_t alloc_unit = LWIP_MEM_ALIGN_SIZE(PBUF_POOL_BUFSIZE) - align;
@@ -45,6 +45,19 @@ public:
      */
     virtual emac_mem_buf_t *alloc_pool(uint32_t size, uint32_t align);
 
+    /**
+     * Allocates a contiguous memory buffer from the pbuf pool
+     *
+     * Guarantees a single PBUF_POOL pbuf suitable for receive DMA; returns
+     * NULL if the requested size with alignment cannot be satisfied from one
+     * pool buffer, in which case the caller should fall back to alloc_heap.
+     *
+     * @param  size    Size of the memory to allocate in bytes
+     * @param  align   Memory alignment requirement in bytes
+     * @return         Allocated contiguous memory buffer, or NULL in case of error
+     */
+    virtual emac_mem_buf_t *alloc_pool_contiguous(uint32_t size, uint32_t align);
+
     /**
      * Get memory buffer pool allocation unit
      *
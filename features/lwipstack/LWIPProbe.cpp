@@ -0,0 +1,277 @@
+/* LWIP ICMP echo probe service
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lwip/opt.h"
+
+#if LWIP_RAW && LWIP_IPV4 && MBED_CONF_LWIP_ICMP_PROBE_MAX
+
+#include <string.h>
+
+#include "lwip/raw.h"
+#include "lwip/icmp.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/ip.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+
+#include "LWIPStack.h"
+
+/* Payload carried after the echo header, enough to tell real replies
+   from reflections of other traffic */
+#define PROBE_DATA_SIZE 32
+
+/* ICMP identifier namespace of the probe service; the slot index is
+   added so concurrent probes demultiplex their own replies */
+#define PROBE_ID_BASE   0x4d00
+
+nsapi_error_t LWIP::ping_async(const SocketAddress &address, uint32_t timeout, ping_cb_t callback)
+{
+    if (timeout == 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    return probe_open(address, 0, timeout, callback, NULL);
+}
+
+nsapi_value_or_error_t LWIP::probe_start(const SocketAddress &address, uint32_t interval)
+{
+    if (interval == 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    /* A reply slower than the interval counts as lost */
+    int id;
+    nsapi_error_t err = probe_open(address, interval, interval, ping_cb_t(), &id);
+    if (err != NSAPI_ERROR_OK) {
+        return err;
+    }
+
+    return id;
+}
+
+nsapi_error_t LWIP::probe_stop(int id)
+{
+    if (id < 0 || id >= MBED_CONF_LWIP_ICMP_PROBE_MAX ||
+        !probes[id].in_use || !probes[id].periodic) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    if (tcpip_callback(probe_end, &probes[id]) != ERR_OK) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t LWIP::probe_stats(int id, nsapi_ping_stats_t *stats)
+{
+    if (id < 0 || id >= MBED_CONF_LWIP_ICMP_PROBE_MAX || !probes[id].in_use) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    *stats = probes[id].stats;
+    stats->avg_rtt_ms = stats->received ? probes[id].rtt_sum / stats->received : 0;
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t LWIP::probe_open(const SocketAddress &address, uint32_t interval,
+                               uint32_t timeout, ping_cb_t callback, int *id_out)
+{
+    nsapi_addr_t addr = address.get_addr();
+    if (addr.version != NSAPI_IPv4) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    struct icmp_probe *probe = NULL;
+
+    adaptation.lock();
+    for (int i = 0; i < MBED_CONF_LWIP_ICMP_PROBE_MAX; i++) {
+        if (!probes[i].in_use) {
+            probe = &probes[i];
+            probe->in_use = true;
+            probe->id = (u16_t)(PROBE_ID_BASE + i);
+            if (id_out) {
+                *id_out = i;
+            }
+            break;
+        }
+    }
+    adaptation.unlock();
+
+    if (!probe) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    IP_ADDR4(&probe->addr, addr.bytes[0], addr.bytes[1], addr.bytes[2], addr.bytes[3]);
+    probe->periodic = (interval > 0);
+    probe->awaiting = false;
+    probe->seq = 0;
+    probe->pcb = NULL;
+    probe->interval = interval;
+    probe->timeout = timeout;
+    probe->rtt_sum = 0;
+    probe->callback = callback;
+    memset(&probe->stats, 0, sizeof(probe->stats));
+
+    if (tcpip_callback(probe_begin, probe) != ERR_OK) {
+        probe->in_use = false;
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+/* tcpip thread: create the raw pcb and send the first echo */
+void LWIP::probe_begin(void *arg)
+{
+    struct icmp_probe *probe = static_cast<struct icmp_probe *>(arg);
+
+    probe->pcb = raw_new(IP_PROTO_ICMP);
+    if (!probe->pcb) {
+        probe_finish(probe, NSAPI_ERROR_NO_MEMORY);
+        return;
+    }
+
+    raw_recv(probe->pcb, probe_recv, probe);
+    raw_bind(probe->pcb, IP_ADDR_ANY);
+
+    probe_send(probe);
+}
+
+/* tcpip thread: send one echo request and arm the tick */
+void LWIP::probe_send(void *arg)
+{
+    struct icmp_probe *probe = static_cast<struct icmp_probe *>(arg);
+    struct pbuf *p;
+    struct icmp_echo_hdr *iecho;
+    u16_t len = sizeof(struct icmp_echo_hdr) + PROBE_DATA_SIZE;
+
+    p = pbuf_alloc(PBUF_IP, len, PBUF_RAM);
+    if (p) {
+        iecho = static_cast<struct icmp_echo_hdr *>(p->payload);
+        ICMPH_TYPE_SET(iecho, ICMP_ECHO);
+        ICMPH_CODE_SET(iecho, 0);
+        iecho->chksum = 0;
+        iecho->id = lwip_htons(probe->id);
+        iecho->seqno = lwip_htons(++probe->seq);
+
+        char *data = reinterpret_cast<char *>(iecho) + sizeof(struct icmp_echo_hdr);
+        for (int i = 0; i < PROBE_DATA_SIZE; i++) {
+            data[i] = (char)i;
+        }
+
+        iecho->chksum = inet_chksum(iecho, len);
+
+        probe->stats.sent++;
+        probe->awaiting = true;
+        probe->send_time = sys_now();
+
+        raw_sendto(probe->pcb, p, &probe->addr);
+        pbuf_free(p);
+    }
+
+    sys_timeout(probe->timeout, probe_tick, probe);
+}
+
+/* tcpip thread: no reply within the timeout - a one-shot ping fails,
+   a periodic probe just sends the next request */
+void LWIP::probe_tick(void *arg)
+{
+    struct icmp_probe *probe = static_cast<struct icmp_probe *>(arg);
+
+    if (!probe->periodic) {
+        probe_finish(probe, NSAPI_ERROR_TIMEOUT);
+        return;
+    }
+
+    probe_send(probe);
+}
+
+/* tcpip thread: probe_stop */
+void LWIP::probe_end(void *arg)
+{
+    struct icmp_probe *probe = static_cast<struct icmp_probe *>(arg);
+
+    sys_untimeout(probe_tick, probe);
+    probe_finish(probe, 0);
+}
+
+void LWIP::probe_finish(struct icmp_probe *probe, nsapi_value_or_error_t result)
+{
+    if (probe->pcb) {
+        raw_remove(probe->pcb);
+        probe->pcb = NULL;
+    }
+
+    ping_cb_t callback = probe->callback;
+    probe->callback = ping_cb_t();
+    probe->in_use = false;
+
+    if (callback) {
+        callback(result);
+    }
+}
+
+/* tcpip thread: raw input - the payload still carries the IP header */
+u8_t LWIP::probe_recv(void *arg, struct raw_pcb *pcb, struct pbuf *p, const ip_addr_t *addr)
+{
+    struct icmp_probe *probe = static_cast<struct icmp_probe *>(arg);
+    struct icmp_echo_hdr *iecho;
+
+    if (p->tot_len >= PBUF_IP_HLEN + sizeof(struct icmp_echo_hdr) &&
+        pbuf_header(p, -PBUF_IP_HLEN) == 0) {
+        iecho = static_cast<struct icmp_echo_hdr *>(p->payload);
+
+        if (probe->awaiting && ICMPH_TYPE(iecho) == ICMP_ER &&
+            iecho->id == lwip_htons(probe->id) &&
+            iecho->seqno == lwip_htons(probe->seq)) {
+            u32_t rtt = sys_now() - probe->send_time;
+
+            probe->awaiting = false;
+            probe->rtt_sum += rtt;
+            probe->stats.received++;
+            if (probe->stats.received == 1 || rtt < probe->stats.min_rtt_ms) {
+                probe->stats.min_rtt_ms = rtt;
+            }
+            if (rtt > probe->stats.max_rtt_ms) {
+                probe->stats.max_rtt_ms = rtt;
+            }
+
+            /* Bucket i counts replies faster than 2^i ms, the last
+               bucket collects the rest */
+            unsigned bucket = 0;
+            while (bucket < NSAPI_PING_HISTOGRAM_BUCKETS - 1 && rtt >= ((u32_t)1 << bucket)) {
+                bucket++;
+            }
+            probe->stats.histogram[bucket]++;
+
+            pbuf_free(p);
+
+            if (!probe->periodic) {
+                sys_untimeout(probe_tick, probe);
+                probe_finish(probe, (nsapi_value_or_error_t)rtt);
+            }
+            return 1;
+        }
+
+        pbuf_header(p, PBUF_IP_HLEN);
+    }
+
+    return 0;
+}
+
+#endif /* LWIP_RAW && LWIP_IPV4 && MBED_CONF_LWIP_ICMP_PROBE_MAX */
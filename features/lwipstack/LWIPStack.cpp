@@ -33,6 +33,8 @@
 #include "lwip/dns.h"
 #include "lwip/udp.h"
 #include "lwip/lwip_errno.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
 #include "lwip-sys/arch/sys_arch.h"
 
 #include "LWIPStack.h"
@@ -173,8 +175,226 @@ LWIP::LWIP()
 
     // Zero out socket set
     arena_init();
+
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+    tcp_snd_free = MBED_CONF_LWIP_TCP_SND_BUDGET;
+#endif
+
+#if LWIP_TCP && MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE
+    memset(path_cache, 0, sizeof(path_cache));
+    path_cache_next = 0;
+#endif
+
+#if LWIP_RAW && LWIP_IPV4 && MBED_CONF_LWIP_ICMP_PROBE_MAX
+    for (int i = 0; i < MBED_CONF_LWIP_ICMP_PROBE_MAX; i++) {
+        probes[i].in_use = false;
+    }
+#endif
+}
+
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+
+/* Runtime TCP send buffer governor
+ *
+ * TCP_SND_BUF is fixed at compile time, so it has to be sized for the
+ * busiest connection and every socket then reserves that much queue
+ * space. The governor instead treats TCP_SND_BUF as a per-connection
+ * ceiling and shares a configured byte budget between sockets at
+ * runtime: a connection that keeps its send buffer full on a clean
+ * link grows toward the ceiling, one that is losing segments backs
+ * off, and allowance parked on idle connections is reclaimed. A floor
+ * of two segments is always granted so every socket can make progress.
+ *
+ * lwIP tracks the free send allowance in pcb->snd_buf and restores
+ * exactly the acked bytes to it, so moving the resting level up or
+ * down while the adjustment fits in the currently free allowance
+ * resizes the buffer without disturbing queued data.
+ */
+
+static tcpwnd_size_t tcp_buf_quota_floor(void)
+{
+    return LWIP_MIN(2 * TCP_MSS, TCP_SND_BUF);
+}
+
+void LWIP::tcp_buf_init(struct mbed_lwip_socket *s)
+{
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP || !s->conn->pcb.tcp) {
+        return;
+    }
+
+    adaptation.lock();
+
+    /* The floor is granted unconditionally; only allowance above it is
+       charged to the shared budget */
+    tcpwnd_size_t quota = tcp_buf_quota_floor();
+    tcpwnd_size_t grant = LWIP_MIN(TCP_SND_BUF - quota, tcp_snd_free);
+    quota += grant;
+    tcp_snd_free -= grant;
+
+    s->conn->pcb.tcp->snd_buf -= TCP_SND_BUF - quota;
+    s->snd_quota = quota;
+    s->last_send = s->last_tune = sys_now();
+
+    adaptation.unlock();
+}
+
+void LWIP::tcp_buf_release(struct mbed_lwip_socket *s)
+{
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP || !s->snd_quota) {
+        return;
+    }
+
+    adaptation.lock();
+    tcp_snd_free += s->snd_quota - tcp_buf_quota_floor();
+    s->snd_quota = 0;
+    adaptation.unlock();
+}
+
+void LWIP::tcp_buf_tune(struct mbed_lwip_socket *s)
+{
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+        return;
+    }
+
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (!pcb || pcb->state != ESTABLISHED) {
+        return;
+    }
+
+    /* An explicit NSAPI_SNDBUF pins the allowance - leave it alone */
+    if (s->snd_pinned) {
+        s->last_send = sys_now();
+        return;
+    }
+
+    u32_t now = sys_now();
+    s->last_send = now;
+    if (now - s->last_tune < 100) {
+        return;
+    }
+    s->last_tune = now;
+
+    const tcpwnd_size_t quota_floor = tcp_buf_quota_floor();
+
+    adaptation.lock();
+
+    /* Reclaim allowance parked on connections that have been idle with
+       nothing queued for over a second */
+    for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
+        struct mbed_lwip_socket *t = &arena[i];
+        if (!t->in_use || t == s || t->snd_quota <= quota_floor || t->snd_pinned ||
+            NETCONNTYPE_GROUP(t->conn->type) != NETCONN_TCP || !t->conn->pcb.tcp) {
+            continue;
+        }
+        if (now - t->last_send < 1000 || t->conn->pcb.tcp->snd_buf != t->snd_quota) {
+            continue;
+        }
+
+        tcpwnd_size_t reclaim = t->snd_quota - quota_floor;
+        t->conn->pcb.tcp->snd_buf -= reclaim;
+        t->snd_quota = quota_floor;
+        tcp_snd_free += reclaim;
+    }
+
+    if (pcb->nrtx > 0) {
+        /* Losing segments - halve the allowance, returning whatever of the
+           reduction is not currently queued */
+        tcpwnd_size_t target = LWIP_MAX(s->snd_quota / 2, quota_floor);
+        tcpwnd_size_t shrink = LWIP_MIN(s->snd_quota - target, pcb->snd_buf);
+        pcb->snd_buf -= shrink;
+        s->snd_quota -= shrink;
+        tcp_snd_free += shrink;
+    } else if (pcb->snd_buf == 0 && s->snd_quota < TCP_SND_BUF) {
+        /* Send-buffer limited on a clean link - grow, stepping faster on
+           long-RTT paths that need more data in flight. pcb->sa is the
+           smoothed RTT scaled by 8, in ~500 ms slow timer ticks */
+        tcpwnd_size_t step = ((pcb->sa >> 3) >= 1) ? 4 * TCP_MSS : 2 * TCP_MSS;
+        tcpwnd_size_t grow = LWIP_MIN(step, TCP_SND_BUF - s->snd_quota);
+        grow = LWIP_MIN(grow, tcp_snd_free);
+        pcb->snd_buf += grow;
+        s->snd_quota += grow;
+        tcp_snd_free -= grow;
+    }
+
+    adaptation.unlock();
+}
+
+#endif /* LWIP_TCP && MBED_CONF_LWIP_TCP_SND_BUDGET */
+
+#if LWIP_TCP && MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE
+
+void LWIP::path_cache_store(struct mbed_lwip_socket *s)
+{
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+        return;
+    }
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    /* Only connections that completed the handshake carry converged
+       values worth keeping */
+    if (!pcb || (pcb->state != ESTABLISHED && pcb->state != CLOSE_WAIT &&
+                 pcb->state != FIN_WAIT_1 && pcb->state != FIN_WAIT_2)) {
+        return;
+    }
+
+    adaptation.lock();
+    struct path_cache_entry *entry = NULL;
+    for (uint32_t i = 0; i < MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE; i++) {
+        if (path_cache[i].valid && ip_addr_cmp(&path_cache[i].addr, &pcb->remote_ip)) {
+            entry = &path_cache[i];
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &path_cache[path_cache_next];
+        path_cache_next = (path_cache_next + 1) % MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE;
+    }
+    entry->addr = pcb->remote_ip;
+    entry->mss = pcb->mss;
+    entry->ssthresh = pcb->ssthresh;
+    entry->sa = pcb->sa;
+    entry->sv = pcb->sv;
+    entry->valid = true;
+    adaptation.unlock();
+}
+
+void LWIP::path_cache_apply(struct mbed_lwip_socket *s, const ip_addr_t *addr)
+{
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+        return;
+    }
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (!pcb) {
+        return;
+    }
+
+    adaptation.lock();
+    for (uint32_t i = 0; i < MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE; i++) {
+        if (!path_cache[i].valid || !ip_addr_cmp(&path_cache[i].addr, addr)) {
+            continue;
+        }
+        /* The SYN is already on the wire but no data segment is, so
+           clamping the send MSS here still sizes the whole first flight.
+           The RTT seed replaces the conservative initial estimate, and
+           the slow-start threshold stops the window overshooting a path
+           this host has already probed. */
+        if (path_cache[i].mss && path_cache[i].mss < pcb->mss) {
+            pcb->mss = path_cache[i].mss;
+        }
+        if (path_cache[i].ssthresh) {
+            pcb->ssthresh = path_cache[i].ssthresh;
+        }
+        if (path_cache[i].sa != -1) {
+            pcb->sa = path_cache[i].sa;
+            pcb->sv = path_cache[i].sv;
+            pcb->rto = (pcb->sa >> 3) + pcb->sv;
+        }
+        break;
+    }
+    adaptation.unlock();
 }
 
+#endif /* LWIP_TCP && MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE */
+
 nsapi_error_t LWIP::get_dns_server(int index, SocketAddress *address)
 {
     int dns_entries = 0;
@@ -284,6 +504,11 @@ nsapi_error_t LWIP::socket_open(nsapi_socket_t *handle, nsapi_protocol_t proto)
     }
 
     netconn_set_recvtimeout(s->conn, 1);
+
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+    tcp_buf_init(s);
+#endif
+
     *(struct mbed_lwip_socket **)handle = s;
     return 0;
 }
@@ -293,6 +518,15 @@ nsapi_error_t LWIP::socket_close(nsapi_socket_t handle)
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
 
     netbuf_delete(s->buf);
+
+#if LWIP_TCP && MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE
+    path_cache_store(s);
+#endif
+
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+    tcp_buf_release(s);
+#endif
+
     err_t err = netconn_delete(s->conn);
     arena_dealloc(s);
     return err_remap(err);
@@ -350,9 +584,17 @@ nsapi_error_t LWIP::socket_connect(nsapi_socket_t handle, const SocketAddress &a
         return NSAPI_ERROR_PARAMETER;
     }
 
-    netconn_set_nonblocking(s->conn, false);
+    /* Connect asynchronously - the first call returns ERR_INPROGRESS and
+     * completion is signalled through the netconn event callback. Repeat
+     * calls report ERR_ALREADY while connecting and ERR_ISCONN once done,
+     * so TCPSocket's event-driven retry loop provides the blocking mode. */
     err_t err = netconn_connect(s->conn, &ip_addr, address.get_port());
-    netconn_set_nonblocking(s->conn, true);
+
+#if LWIP_TCP && MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE
+    if (err == ERR_OK || err == ERR_INPROGRESS) {
+        path_cache_apply(s, &ip_addr);
+    }
+#endif
 
     return err_remap(err);
 }
@@ -377,6 +619,11 @@ nsapi_error_t LWIP::socket_accept(nsapi_socket_t server, nsapi_socket_t *handle,
     }
 
     netconn_set_recvtimeout(ns->conn, 1);
+
+#if defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+    tcp_buf_init(ns);
+#endif
+
     *(struct mbed_lwip_socket **)handle = ns;
 
     ip_addr_t peer_addr;
@@ -403,11 +650,18 @@ nsapi_size_or_error_t LWIP::socket_send(nsapi_socket_t handle, const void *data,
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     size_t bytes_written = 0;
 
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+    tcp_buf_tune(s);
+#endif
+
     err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
     if (err != ERR_OK) {
         return err_remap(err);
     }
 
+    s->stats.bytes_sent += bytes_written;
+    s->stats.packets_sent++;
+
     return (nsapi_size_or_error_t)bytes_written;
 }
 
@@ -432,9 +686,64 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
         s->buf = 0;
     }
 
+    s->stats.bytes_recv += recv;
+    s->stats.packets_recv++;
+
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_recv_zc(nsapi_socket_t handle, const void **data)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!s->buf) {
+        err_t err = netconn_recv(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+    }
+
+    // Find the pbuf segment holding the current read position and lend its
+    // payload directly - no copy out of the chain
+    struct pbuf *p = s->buf->p;
+    u16_t offset = s->offset;
+    while (p && offset >= p->len) {
+        offset -= p->len;
+        p = p->next;
+    }
+
+    if (!p) {
+        netbuf_delete(s->buf);
+        s->buf = 0;
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    *data = (const uint8_t *)p->payload + offset;
+
+    s->stats.bytes_recv += p->len - offset;
+    s->stats.packets_recv++;
+
+    return p->len - offset;
+}
+
+void LWIP::socket_recv_zc_release(nsapi_socket_t handle, nsapi_size_t size)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!s->buf) {
+        return;
+    }
+
+    s->offset += size;
+
+    if (s->offset >= netbuf_len(s->buf)) {
+        netbuf_delete(s->buf);
+        s->buf = 0;
+    }
+}
+
 nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
 {
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
@@ -459,9 +768,176 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
         return err_remap(err);
     }
 
+    s->stats.bytes_sent += size;
+    s->stats.packets_sent++;
+
     return size;
 }
 
+nsapi_size_or_error_t LWIP::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                           const nsapi_iovec_t *iov, int iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // Stream write - pass the pieces straight to lwIP, flagging all but
+        // the last with MORE so segments are filled across the boundaries
+        size_t total_written = 0;
+        err_t write_err = ERR_OK;
+
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+        tcp_buf_tune(s);
+#endif
+
+        for (int i = 0; i < iovcnt; i++) {
+            if (iov[i].iov_len == 0) {
+                continue;
+            }
+
+            u8_t flags = NETCONN_COPY;
+            if (i < iovcnt - 1) {
+                flags |= NETCONN_MORE;
+            }
+
+            size_t bytes_written = 0;
+            write_err = netconn_write_partly(s->conn, iov[i].iov_base, iov[i].iov_len, flags, &bytes_written);
+            total_written += bytes_written;
+            if (write_err != ERR_OK || bytes_written < iov[i].iov_len) {
+                break;
+            }
+        }
+
+        if (!total_written && write_err != ERR_OK) {
+            return err_remap(write_err);
+        }
+
+        s->stats.bytes_sent += total_written;
+        s->stats.packets_sent++;
+
+        return (nsapi_size_or_error_t)total_written;
+    }
+
+    // Datagram - chain a PBUF_REF pbuf per element so the pieces go out as
+    // one packet without being staged contiguously first
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    struct pbuf *head = NULL;
+    nsapi_size_t total = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len == 0) {
+            continue;
+        }
+
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
+        if (!p) {
+            if (head) {
+                pbuf_free(head);
+            }
+            netbuf_delete(buf);
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        p->payload = iov[i].iov_base;
+        p->len = p->tot_len = (u16_t)iov[i].iov_len;
+        total += iov[i].iov_len;
+
+        if (head) {
+            pbuf_cat(head, p);
+        } else {
+            head = p;
+        }
+    }
+
+    buf->p = buf->ptr = head;
+
+    err_t err;
+    if (address) {
+        ip_addr_t ip_addr;
+        nsapi_addr_t addr = address->get_addr();
+        if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+            netbuf_delete(buf);
+            return NSAPI_ERROR_PARAMETER;
+        }
+        err = netconn_sendto(s->conn, buf, &ip_addr, address->get_port());
+    } else {
+        err = netconn_send(s->conn, buf);
+    }
+    netbuf_delete(buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    s->stats.bytes_sent += total;
+    s->stats.packets_sent++;
+
+    return total;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                           const nsapi_iovec_t *iov, int iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        if (!s->buf) {
+            err_t err = netconn_recv(s->conn, &s->buf);
+            s->offset = 0;
+
+            if (err != ERR_OK) {
+                return err_remap(err);
+            }
+        }
+
+        nsapi_size_t total = 0;
+        for (int i = 0; i < iovcnt && s->offset < netbuf_len(s->buf); i++) {
+            u16_t recv = netbuf_copy_partial(s->buf, iov[i].iov_base, (u16_t)iov[i].iov_len, s->offset);
+            s->offset += recv;
+            total += recv;
+        }
+
+        if (s->offset >= netbuf_len(s->buf)) {
+            netbuf_delete(s->buf);
+            s->buf = 0;
+        }
+
+        s->stats.bytes_recv += total;
+        s->stats.packets_recv++;
+
+        return total;
+    }
+
+    struct netbuf *buf;
+
+    err_t err = netconn_recv(s->conn, &buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(buf));
+    }
+
+    nsapi_size_t total = 0;
+    u16_t offset = 0;
+    for (int i = 0; i < iovcnt && offset < netbuf_len(buf); i++) {
+        u16_t recv = netbuf_copy_partial(buf, iov[i].iov_base, (u16_t)iov[i].iov_len, offset);
+        offset += recv;
+        total += recv;
+    }
+    netbuf_delete(buf);
+
+    s->stats.bytes_recv += total;
+    s->stats.packets_recv++;
+
+    return total;
+}
+
 nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress *address, void *data, nsapi_size_t size)
 {
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
@@ -482,9 +958,121 @@ nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress
     u16_t recv = netbuf_copy(buf, data, (u16_t)size);
     netbuf_delete(buf);
 
+    s->stats.bytes_recv += recv;
+    s->stats.packets_recv++;
+
     return recv;
 }
 
+void LWIP::raw_recv_fn(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+    struct mbed_lwip_socket *s = static_cast<struct mbed_lwip_socket *>(arg);
+
+    if (p == NULL) {
+        return;
+    }
+
+    void (*cb)(void *, const void *, nsapi_size_t, const SocketAddress &) = s->raw_recv_cb;
+    if (cb == NULL) {
+        // Unregistration raced with an in-flight datagram
+        pbuf_free(p);
+        return;
+    }
+
+    // Datagrams normally arrive in a single pbuf; linearise the rare
+    // chained ones so the callback always sees a contiguous payload
+    if (p->next != NULL) {
+        p = pbuf_coalesce(p, PBUF_RAW);
+        if (p->next != NULL) {
+            // No memory to linearise - drop rather than deliver a torn payload
+            pbuf_free(p);
+            return;
+        }
+    }
+
+    nsapi_addr_t nsapi_addr;
+    convert_lwip_addr_to_mbed(&nsapi_addr, addr);
+    SocketAddress peer(nsapi_addr, port);
+
+    s->stats.bytes_recv += p->len;
+    s->stats.packets_recv++;
+
+    cb(s->raw_recv_data, p->payload, p->len, peer);
+
+    pbuf_free(p);
+}
+
+void LWIP::raw_recv_swap(void *ctx)
+{
+    struct mbed_lwip_socket *s = static_cast<struct mbed_lwip_socket *>(ctx);
+    struct udp_pcb *pcb = s->conn->pcb.udp;
+
+    if (s->raw_recv_cb != NULL) {
+        if (!s->raw_recv_installed) {
+            s->def_recv = pcb->recv;
+            s->def_recv_arg = pcb->recv_arg;
+            s->raw_recv_installed = true;
+        }
+        udp_recv(pcb, &LWIP::raw_recv_fn, s);
+    } else if (s->raw_recv_installed) {
+        udp_recv(pcb, s->def_recv, s->def_recv_arg);
+        s->raw_recv_installed = false;
+    }
+}
+
+nsapi_error_t LWIP::socket_recv_callback(nsapi_socket_t handle,
+        void (*callback)(void *, const void *, nsapi_size_t, const SocketAddress &), void *data)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_UDP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    s->raw_recv_cb = callback;
+    s->raw_recv_data = data;
+
+    // The pcb's recv hook is owned by the tcpip thread - swap it there so
+    // no datagram ever sees a half-updated callback/argument pair
+    err_t err = tcpip_callback_with_block(&LWIP::raw_recv_swap, s, 1);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return 0;
+}
+
+nsapi_error_t LWIP::socket_stats(nsapi_socket_t handle, nsapi_socket_stats_t *stats)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    *stats = s->stats;
+    return 0;
+}
+
+nsapi_size_or_error_t LWIP::get_pool_stats(nsapi_pool_stats_t *stats, nsapi_size_t count)
+{
+#if MEMP_STATS
+    nsapi_size_t written = 0;
+    for (unsigned int i = 0; i < MEMP_MAX && written < count; i++) {
+        const struct stats_mem *mem = lwip_stats.memp[i];
+#if defined(LWIP_DEBUG) || LWIP_STATS_DISPLAY
+        stats[written].name = mem->name;
+#else
+        stats[written].name = NULL;
+#endif
+        stats[written].avail = mem->avail;
+        stats[written].used = mem->used;
+        stats[written].max = mem->max;
+        stats[written].failures = mem->err;
+        written++;
+    }
+    return written;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
 int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr) {
     uint32_t count = 0;
     uint32_t index = 0;
@@ -514,7 +1102,11 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
                 return NSAPI_ERROR_UNSUPPORTED;
             }
 
-            s->conn->pcb.tcp->so_options |= SOF_KEEPALIVE;
+            if (*(int *)optval) {
+                s->conn->pcb.tcp->so_options |= SOF_KEEPALIVE;
+            } else {
+                s->conn->pcb.tcp->so_options &= ~SOF_KEEPALIVE;
+            }
             return 0;
 
         case NSAPI_KEEPIDLE:
@@ -532,6 +1124,62 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
             s->conn->pcb.tcp->keep_intvl = *(int*)optval;
             return 0;
+
+        case NSAPI_NODELAY:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (*(int *)optval) {
+                tcp_nagle_disable(s->conn->pcb.tcp);
+            } else {
+                tcp_nagle_enable(s->conn->pcb.tcp);
+            }
+            return 0;
+
+#if defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+        case NSAPI_SNDBUF: {
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP ||
+                !s->conn->pcb.tcp) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            /* Pin the governor's allowance to the requested size, clamped
+               to its floor and the compile-time ceiling; the socket is
+               then left out of autotuning */
+            struct tcp_pcb *pcb = s->conn->pcb.tcp;
+            tcpwnd_size_t requested = (tcpwnd_size_t)LWIP_MIN(
+                    LWIP_MAX((tcpwnd_size_t)*(int *)optval, tcp_buf_quota_floor()),
+                    TCP_SND_BUF);
+
+            adaptation.lock();
+            if (requested > s->snd_quota) {
+                tcpwnd_size_t grow = LWIP_MIN(requested - s->snd_quota, tcp_snd_free);
+                pcb->snd_buf += grow;
+                s->snd_quota += grow;
+                tcp_snd_free -= grow;
+            } else {
+                /* Only space not currently queued can be returned */
+                tcpwnd_size_t shrink = LWIP_MIN(s->snd_quota - requested, pcb->snd_buf);
+                pcb->snd_buf -= shrink;
+                s->snd_quota -= shrink;
+                tcp_snd_free += shrink;
+            }
+            s->snd_pinned = true;
+            adaptation.unlock();
+            return 0;
+        }
+#endif
+#endif
+
+#if LWIP_SO_RCVBUF
+        case NSAPI_RCVBUF:
+            if (optlen != sizeof(int)) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            s->conn->recv_bufsize = *(int *)optval;
+            return 0;
 #endif
 
         case NSAPI_REUSEADDR:
@@ -546,6 +1194,53 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
             }
             return 0;
 
+        case NSAPI_TXPRIO:
+            if (optlen != sizeof(int)) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            /* Mark the socket's frames with DSCP EF so the link layer can
+               dequeue them ahead of bulk traffic */
+            s->conn->pcb.ip->tos = *(int *)optval ? 0xB8 : 0;
+            return 0;
+
+        case NSAPI_BIND_TO_DEVICE: {
+            if (!optval || optlen < 2 || optlen > NSAPI_INTERFACE_NAME_SIZE) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+#if LWIP_TCP
+            /* A connected TCP pcb is demultiplexed by its local address -
+               it cannot be moved to another interface */
+            if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP &&
+                s->conn->pcb.tcp->state != CLOSED) {
+                return NSAPI_ERROR_IS_CONNECTED;
+            }
+#endif
+
+            adaptation.lock();
+
+            struct netif *n = netif_find((const char *)optval);
+            if (!n) {
+                adaptation.unlock();
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            const ip_addr_t *addr = get_ip_addr(true, n);
+            if (!addr) {
+                adaptation.unlock();
+                return NSAPI_ERROR_NO_ADDRESS;
+            }
+
+            /* Pin the local address to the interface's address; together
+               with the source-based route hook this steers the socket's
+               traffic out through that interface */
+            ip_addr_copy(s->conn->pcb.ip->local_ip, *addr);
+
+            adaptation.unlock();
+            return 0;
+        }
+
         case NSAPI_ADD_MEMBERSHIP:
         case NSAPI_DROP_MEMBERSHIP: {
             if (optlen != sizeof(nsapi_ip_mreq_t)) {
@@ -650,7 +1345,79 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
 nsapi_error_t LWIP::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
 {
-    return NSAPI_ERROR_UNSUPPORTED;
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!optval || !optlen || *optlen < sizeof(int)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    switch (optname) {
+#if LWIP_TCP
+        case NSAPI_KEEPALIVE:
+            if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            *(int *)optval = (s->conn->pcb.tcp->so_options & SOF_KEEPALIVE) ? 1 : 0;
+            *optlen = sizeof(int);
+            return 0;
+
+        case NSAPI_KEEPIDLE:
+            if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            *(int *)optval = s->conn->pcb.tcp->keep_idle;
+            *optlen = sizeof(int);
+            return 0;
+
+        case NSAPI_KEEPINTVL:
+            if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            *(int *)optval = s->conn->pcb.tcp->keep_intvl;
+            *optlen = sizeof(int);
+            return 0;
+
+        case NSAPI_NODELAY:
+            if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            *(int *)optval = tcp_nagle_disabled(s->conn->pcb.tcp) ? 1 : 0;
+            *optlen = sizeof(int);
+            return 0;
+
+        case NSAPI_SNDBUF:
+            if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+#if defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+            *(int *)optval = s->snd_quota;
+#else
+            *(int *)optval = TCP_SND_BUF;
+#endif
+            *optlen = sizeof(int);
+            return 0;
+#endif
+
+        case NSAPI_REUSEADDR:
+            *(int *)optval = ip_get_option(s->conn->pcb.ip, SOF_REUSEADDR) ? 1 : 0;
+            *optlen = sizeof(int);
+            return 0;
+
+#if LWIP_SO_RCVBUF
+        case NSAPI_RCVBUF:
+            *(int *)optval = s->conn->recv_bufsize;
+            *optlen = sizeof(int);
+            return 0;
+#endif
+
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
 }
 
 
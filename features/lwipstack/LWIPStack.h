@@ -19,6 +19,7 @@
 
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/udp.h"
 #include "lwip/ip.h"
 #include "lwip/api.h"
 #include "netif/etharp.h"
@@ -110,6 +111,20 @@ public:
          */
         virtual char *get_gateway(char *buf, nsapi_size_t buflen);
 
+        /** Read link-level traffic counters of the interface
+         *
+         * @param    stats      Destination for the counters
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t get_stats(nsapi_interface_stats_t *stats);
+
+        /** Copies the lwIP name of the interface ("en0" form) to user supplied buffer
+         *
+         * @param    buf        buffer of at least NSAPI_INTERFACE_NAME_SIZE bytes
+         * @return              Pointer to the buffer
+         */
+        virtual char *get_interface_name(char *buf);
+
     private:
         friend LWIP;
 
@@ -132,6 +147,25 @@ public:
     #endif
 
         static err_t emac_if_init(struct netif *netif);
+
+    #ifdef MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN
+        static void emac_tx_drain(void *arg);
+        void emac_tx_drain_now();
+        bool emac_tx_out(struct pbuf *p);
+
+        struct pbuf *tx_lane[2][MBED_CONF_LWIP_EMAC_TX_QUEUE_LEN];
+        uint8_t tx_head[2];
+        uint8_t tx_count[2];
+        bool tx_drain_scheduled;
+    #endif
+    #ifdef MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET
+        static void emac_rx_poll(void *arg);
+
+        struct pbuf *rx_queue[2 * MBED_CONF_LWIP_EMAC_RX_POLL_BUDGET];
+        uint8_t rx_head;
+        uint8_t rx_count;
+        bool rx_poll_scheduled;
+    #endif
     #endif
 
         union {
@@ -166,6 +200,7 @@ public:
         bool ppp;
         mbed::Callback<void(nsapi_event_t, intptr_t)> client_callback;
         struct netif netif;
+        nsapi_interface_stats_t stats;
         static Interface *list;
         Interface *next;
         LWIPMemoryManager *memory_manager;
@@ -337,6 +372,66 @@ protected:
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
                                               void *data, nsapi_size_t size);
 
+    /** Receive data over a TCP socket without copying
+     *
+     *  Lends the caller a view into the pbuf queued on the connection. The
+     *  view covers one contiguous pbuf segment, so it may be shorter than the
+     *  data queued - call again after releasing to walk the chain. The view
+     *  stays valid until socket_recv_zc_release() or socket_close().
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param data     Written with a pointer into the pbuf payload
+     *  @return         Number of contiguous bytes readable at *data on
+     *                  success, negative error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_zc(nsapi_socket_t handle,
+                                                 const void **data);
+
+    /** Consume data lent by socket_recv_zc
+     *
+     *  @param handle   Socket handle
+     *  @param size     Number of bytes consumed from the view
+     */
+    virtual void socket_recv_zc_release(nsapi_socket_t handle, nsapi_size_t size);
+
+    /** Send a scatter-gather list of buffers as one message
+     *
+     *  On a TCP connection the pieces are written back to back, all but the
+     *  last flagged NETCONN_MORE. On UDP a PBUF_REF pbuf is chained per
+     *  element so the datagram leaves without a staging copy.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, NULL to use the
+     *                  connected peer
+     *  @param iov      Scatter-gather list of buffers to send
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Receive a message into a scatter-gather list of buffers
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Scatter-gather list of buffers to fill
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, int iovcnt);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -373,6 +468,85 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size);
 
+    /** Register a per-datagram delivery callback on a UDP socket
+     *
+     *  Hooks the UDP pcb's recv upcall, so datagrams are handed to the
+     *  callback on the tcpip thread as udp_input demultiplexes them -
+     *  they never enter the netconn recvmbox and no reader thread wakes.
+     *  Pass NULL to unregister and restore mailbox delivery.
+     *
+     *  @param handle   Socket handle
+     *  @param callback Function to call per datagram, or NULL to unregister
+     *  @param data     Argument to pass to callback
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_recv_callback(nsapi_socket_t handle,
+            void (*callback)(void *, const void *, nsapi_size_t, const SocketAddress &), void *data);
+
+    /** Read traffic counters of a socket
+     *
+     *  Copies out the counters maintained on the socket's data path.
+     *
+     *  @param handle   Socket handle
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_stats(nsapi_socket_t handle, nsapi_socket_stats_t *stats);
+
+    /** Read usage counters of the lwIP memp pools
+     *
+     *  Requires the lwip.memp-stats option; without it the call returns
+     *  NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param stats    Array the counters are written to
+     *  @param count    Number of entries in the array
+     *  @return         Number of entries written on success, negative
+     *                  error code on failure
+     */
+    virtual nsapi_size_or_error_t get_pool_stats(nsapi_pool_stats_t *stats, nsapi_size_t count);
+
+#if LWIP_RAW && LWIP_IPV4 && MBED_CONF_LWIP_ICMP_PROBE_MAX
+    /** Send an ICMP echo request to a host (asynchronous)
+     *
+     *  The reply RTT - or a negative error code - is delivered through
+     *  the callback, which runs on the tcpip thread. IPv4 only.
+     *
+     *  @param address  The SocketAddress of the host to probe
+     *  @param timeout  Time in milliseconds to wait for the reply
+     *  @param callback Callback that is called with the result
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t ping_async(const SocketAddress &address, uint32_t timeout, ping_cb_t callback);
+
+    /** Start a periodic ICMP echo probe of a path
+     *
+     *  An echo goes out every interval milliseconds from the tcpip
+     *  thread; replies slower than the interval count as lost. Results
+     *  accumulate in the probe slot, read with probe_stats().
+     *
+     *  @param address  The SocketAddress of the host to probe
+     *  @param interval Time in milliseconds between echo requests
+     *  @return         Non-negative probe id on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_value_or_error_t probe_start(const SocketAddress &address, uint32_t interval);
+
+    /** Stop a periodic echo probe
+     *
+     *  @param id       Probe id returned by probe_start
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t probe_stop(int id);
+
+    /** Read the accumulated results of a periodic echo probe
+     *
+     *  @param id       Probe id returned by probe_start
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t probe_stats(int id, nsapi_ping_stats_t *stats);
+#endif
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -466,6 +640,24 @@ private:
         nsapi_ip_mreq_t *multicast_memberships;
         uint32_t         multicast_memberships_count;
         uint32_t         multicast_memberships_registry;
+
+        // Data path traffic counters
+        nsapi_socket_stats_t stats;
+
+        // Direct datagram delivery (socket_recv_callback)
+        void (*raw_recv_cb)(void *, const void *, nsapi_size_t, const SocketAddress &);
+        void *raw_recv_data;
+        udp_recv_fn def_recv;
+        void *def_recv_arg;
+        bool raw_recv_installed;
+
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+        // Runtime send buffer tuning state
+        tcpwnd_size_t snd_quota;
+        u32_t last_send;
+        u32_t last_tune;
+        bool snd_pinned;
+#endif
     };
 
     struct lwip_callback {
@@ -474,6 +666,9 @@ private:
     };
 
     static nsapi_error_t err_remap(err_t err);
+    static void raw_recv_swap(void *ctx);
+    static void raw_recv_fn(void *arg, struct udp_pcb *pcb, struct pbuf *p,
+                            const ip_addr_t *addr, u16_t port);
     static bool is_local_addr(const ip_addr_t *ip_addr);
     static const ip_addr_t *get_ip_addr(bool any_addr, const struct netif *netif);
     static const ip_addr_t *get_ipv4_addr(const struct netif *netif);
@@ -487,6 +682,36 @@ private:
     struct mbed_lwip_socket *arena_alloc();
     void arena_dealloc(struct mbed_lwip_socket *s);
 
+#if LWIP_TCP && defined(MBED_CONF_LWIP_TCP_SND_BUDGET)
+    /* Runtime TCP send buffer governor - shares a byte budget between
+       sockets so busy connections grow toward TCP_SND_BUF while idle
+       ones shrink to a floor */
+    void tcp_buf_init(struct mbed_lwip_socket *s);
+    void tcp_buf_release(struct mbed_lwip_socket *s);
+    void tcp_buf_tune(struct mbed_lwip_socket *s);
+    uint32_t tcp_snd_free;
+#endif
+
+#if LWIP_TCP && MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE
+    /* Per-destination path property cache. A closing connection deposits
+       the send MSS, smoothed RTT estimate and slow-start threshold it
+       converged on; a new connection to the same host is seeded from the
+       entry, so its first flight is sized for the path instead of
+       rediscovering it through fragmentation and retransmits. */
+    struct path_cache_entry {
+        ip_addr_t addr;
+        u16_t mss;
+        tcpwnd_size_t ssthresh;
+        s16_t sa;
+        s16_t sv;
+        bool valid;
+    };
+    void path_cache_store(struct mbed_lwip_socket *s);
+    void path_cache_apply(struct mbed_lwip_socket *s, const ip_addr_t *addr);
+    struct path_cache_entry path_cache[MBED_CONF_LWIP_TCP_PATH_CACHE_SIZE];
+    uint32_t path_cache_next;
+#endif
+
     static uint32_t next_registered_multicast_member(const struct mbed_lwip_socket *s, uint32_t index) {
         while (!(s->multicast_memberships_registry & (0x0001 << index))) { index++; }
         return index;
@@ -511,6 +736,41 @@ private:
     static void tcpip_init_irq(void *handle);
     static void tcpip_thread_callback(void *ptr);
 
+#if MBED_CONF_LWIP_POOL_PREWARM
+    static void prewarm_pools(void);
+#endif
+
+#if LWIP_RAW && LWIP_IPV4 && MBED_CONF_LWIP_ICMP_PROBE_MAX
+    /* ICMP echo probe service. A slot is a raw pcb plus the bookkeeping
+       for one outstanding echo; one-shot pings free their slot on the
+       first result, periodic probes keep it until probe_stop. All pcb
+       and timer work runs on the tcpip thread. */
+    struct icmp_probe {
+        bool in_use;
+        bool periodic;
+        bool awaiting;
+        u16_t id;
+        u16_t seq;
+        ip_addr_t addr;
+        struct raw_pcb *pcb;
+        u32_t interval;
+        u32_t timeout;
+        u32_t send_time;
+        u32_t rtt_sum;
+        nsapi_ping_stats_t stats;
+        ping_cb_t callback;
+    };
+    nsapi_error_t probe_open(const SocketAddress &address, uint32_t interval,
+                             uint32_t timeout, ping_cb_t callback, int *id_out);
+    static void probe_begin(void *arg);
+    static void probe_send(void *arg);
+    static void probe_tick(void *arg);
+    static void probe_end(void *arg);
+    static void probe_finish(struct icmp_probe *probe, nsapi_value_or_error_t result);
+    static u8_t probe_recv(void *arg, struct raw_pcb *pcb, struct pbuf *p, const ip_addr_t *addr);
+    struct icmp_probe probes[MBED_CONF_LWIP_ICMP_PROBE_MAX];
+#endif
+
     char ip_address[40];
     rtos::Semaphore tcpip_inited;
     Interface *default_interface;
@@ -91,6 +91,32 @@ const ip_addr_t *LWIP::get_ipv6_addr(const struct netif *netif)
 }
 #endif
 
+#if LWIP_IPV4
+/* LWIP_HOOK_IP4_ROUTE_SRC - source-based route selection. A socket whose
+   local address is pinned to an interface (NSAPI_BIND_TO_DEVICE) egresses
+   through that interface, instead of whichever interface the destination's
+   route would pick on a multi-homed device. */
+extern "C" struct netif *mbed_lwip_route_src(const void *dest, const void *src)
+{
+    const ip4_addr_t *src_addr = static_cast<const ip4_addr_t *>(src);
+    struct netif *netif;
+    (void) dest;
+
+    if (src_addr == NULL || ip4_addr_isany(src_addr)) {
+        return NULL;
+    }
+
+    for (netif = netif_list; netif != NULL; netif = netif->next) {
+        if (netif_is_up(netif) && netif_is_link_up(netif) &&
+                ip4_addr_cmp(src_addr, netif_ip4_addr(netif))) {
+            return netif;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
 bool LWIP::is_local_addr(const ip_addr_t *ip_addr)
 {
     struct netif *netif;
@@ -82,7 +82,13 @@
 
 #define SYS_LIGHTWEIGHT_PROT        1
 
+// Raw pcbs back the ICMP echo probe service (NetworkStack::ping_async)
+#if MBED_CONF_LWIP_ICMP_PROBE_MAX
+#define LWIP_RAW                    1
+#define MEMP_NUM_RAW_PCB            MBED_CONF_LWIP_ICMP_PROBE_MAX
+#else
 #define LWIP_RAW                    0
+#endif
 
 #define TCPIP_MBOX_SIZE             8
 #define DEFAULT_TCP_RECVMBOX_SIZE   8
@@ -225,6 +231,8 @@
 #define LWIP_SOCKET                 0
 
 #define SO_REUSE                    1
+// Receive buffer limit, settable per socket with NSAPI_RCVBUF
+#define LWIP_SO_RCVBUF              1
 
 // Support Multicast
 #include "stdlib.h"
@@ -291,8 +299,34 @@
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
 #else
 #define LWIP_NOASSERT               1
+#if MBED_CONF_LWIP_MEMP_STATS
+// Keep only the memp pool counters - a few words per pool on the
+// allocation path, surfaced through LWIP::get_pool_stats(). Everything
+// else stays off. LWIP_STATS_DISPLAY is enabled for the pool name
+// strings, the display functions themselves are never called.
+#define LWIP_STATS                  1
+#define LWIP_STATS_DISPLAY          1
+#define MEMP_STATS                  1
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define MEM_STATS                   0
+#define SYS_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
+#define MIB2_STATS                  0
+#else
 #define LWIP_STATS                  0
 #endif
+#endif
 
 #define TRACE_TO_ASCII_HEX_DUMP     0
 
@@ -343,6 +377,10 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Per-netif checksum control, so emac_if_init can disable software
+// checksums the EMAC hardware offloads
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
@@ -353,6 +391,15 @@
 #include "lwip_random.h"
 #include "lwip_tcp_isn.h"
 #define LWIP_HOOK_TCP_ISN lwip_hook_tcp_isn
+// Source-based IPv4 route selection, so sockets pinned to an interface's
+// address (NSAPI_BIND_TO_DEVICE) egress through that interface on a
+// multi-homed device. IPv6 selects by source natively in ip6_route.
+struct netif;
+#ifdef __cplusplus
+extern "C"
+#endif
+struct netif *mbed_lwip_route_src(const void *dest, const void *src);
+#define LWIP_HOOK_IP4_ROUTE_SRC(dest, src) mbed_lwip_route_src(dest, src)
 #ifdef MBEDTLS_MD5_C
 #include "mbedtls/inc/mbedtls/md5.h"
 #define LWIP_USE_EXTERNAL_MBEDTLS 1
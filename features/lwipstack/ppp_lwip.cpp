@@ -16,6 +16,7 @@
 
 #include <errno.h>
 #include "platform/FileHandle.h"
+#include "platform/mbed_pkt_trace.h"
 #include "platform/mbed_poll.h"
 #include "events/EventQueue.h"
 #include "mbed_trace.h"
@@ -113,6 +114,8 @@ static u32_t ppp_output(ppp_pcb *pcb, u8_t *data, u32_t len, void *ctx)
 
 //    /tr_debug("> %ld bytes of data written\n", (long) written);
 
+    MBED_PKT_TRACE(MBED_PKT_TRACE_PPP, MBED_PKT_TRACE_TX, written, 0);
+
     return written;
 }
 
@@ -233,6 +236,9 @@ static void handle_modem_hangup()
 #if !PPP_INPROC_IRQ_SAFE
 #error "PPP_INPROC_IRQ_SAFE must be enabled"
 #endif
+// Receive staging for streams without a claimable buffer, allocated from the pbuf pool
+static struct pbuf *rx_pbuf;
+
 static void ppp_input()
 {
     // Allow new events from now, avoiding potential races around the read
@@ -255,15 +261,40 @@ static void ppp_input()
     // Infinite loop, but we assume that we can read faster than the
     // serial, so we will fairly rapidly hit -EAGAIN.
     for (;;) {
-        u8_t buffer[16];
-        ssize_t len = my_stream->read(buffer, sizeof buffer);
+        // Feed the framer straight out of the stream's receive buffer when
+        // the stream can hand its buffer out in place.
+        const char *claimed;
+        ssize_t len = my_stream->read_claim(&claimed);
+        if (len > 0) {
+            MBED_PKT_TRACE(MBED_PKT_TRACE_PPP, MBED_PKT_TRACE_RX, len, 0);
+            pppos_input(my_ppp_pcb, (u8_t *)claimed, len);
+            my_stream->read_release(len);
+            continue;
+        } else if (len == -EAGAIN) {
+            break;
+        } else if (len != -ENOSYS) {
+            handle_modem_hangup();
+            return;
+        }
+
+        // Streams without a claimable buffer are read in pool-buffer-sized
+        // chunks instead of staging through a small stack buffer.
+        if (!rx_pbuf) {
+            rx_pbuf = pbuf_alloc(PBUF_RAW, PBUF_POOL_BUFSIZE, PBUF_POOL);
+            if (!rx_pbuf) {
+                // Pool exhausted - read again when the next event arrives
+                break;
+            }
+        }
+        len = my_stream->read(rx_pbuf->payload, rx_pbuf->len);
         if (len == -EAGAIN) {
             break;
         } else if (len <= 0) {
             handle_modem_hangup();
             return;
         }
-        pppos_input(my_ppp_pcb, buffer, len);
+        MBED_PKT_TRACE(MBED_PKT_TRACE_PPP, MBED_PKT_TRACE_RX, len, 0);
+        pppos_input(my_ppp_pcb, (u8_t *)rx_pbuf->payload, len);
     }
     return;
 }
@@ -408,6 +439,11 @@ nsapi_error_t nsapi_ppp_disconnect(FileHandle *stream)
     my_stream->set_blocking(true);
     my_stream = NULL;
 
+    if (rx_pbuf) {
+        pbuf_free(rx_pbuf);
+        rx_pbuf = NULL;
+    }
+
     return retcode;
 }
 
@@ -0,0 +1,99 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_ECDSA_ASYNC_H
+#define MBED_ECDSA_ASYNC_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_ECDSA_C)
+
+#include "mbedtls/ecdsa.h"
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+
+/** Asynchronous ECDSA operations
+ *
+ * A software ECDSA operation on a small core blocks its thread for
+ * hundreds of milliseconds. These helpers run the operation as a job on an
+ * EventQueue instead, so the caller's thread stays responsive and the
+ * computation runs at the queue thread's priority, where real-time threads
+ * preempt it. Jobs on one queue run in order; the completion callback is
+ * invoked from the queue's dispatch thread.
+ *
+ * The context and all buffers must stay valid until the completion
+ * callback has run, and no other operation may use the context while a
+ * job on it is outstanding.
+ */
+
+/** Sign a message hash on an event queue
+ *
+ *  Computes the signature with mbedtls_ecdsa_write_signature() from the
+ *  queue's dispatch context and reports the result through done.
+ *
+ *  @param queue    Queue to run the job on
+ *  @param ctx      ECDSA context with a private key set up
+ *  @param md_alg   Digest that produced the hash
+ *  @param hash     Message hash to sign
+ *  @param hash_len Length of hash in bytes
+ *  @param sig      Destination buffer for the signature, at least
+ *                  MBEDTLS_ECDSA_MAX_LEN bytes
+ *  @param sig_len  Written with the signature length
+ *  @param f_rng    RNG function
+ *  @param p_rng    RNG parameter
+ *  @param done     Called with the mbedtls_ecdsa_write_signature() result
+ *  @return         0 if the job was queued, MBEDTLS_ERR_ECP_BAD_INPUT_DATA
+ *                  on invalid arguments or MBEDTLS_ERR_ECP_ALLOC_FAILED if
+ *                  the job could not be allocated or queued
+ */
+int mbed_ecdsa_sign_async(events::EventQueue *queue,
+                          mbedtls_ecdsa_context *ctx,
+                          mbedtls_md_type_t md_alg,
+                          const unsigned char *hash, size_t hash_len,
+                          unsigned char *sig, size_t *sig_len,
+                          int (*f_rng)(void *, unsigned char *, size_t),
+                          void *p_rng,
+                          mbed::Callback<void(int)> done);
+
+/** Verify a signature on an event queue
+ *
+ *  Checks the signature with mbedtls_ecdsa_read_signature() from the
+ *  queue's dispatch context and reports the result through done.
+ *
+ *  @param queue    Queue to run the job on
+ *  @param ctx      ECDSA context with the peer's public key set up
+ *  @param hash     Message hash the signature covers
+ *  @param hash_len Length of hash in bytes
+ *  @param sig      Signature to check
+ *  @param sig_len  Length of sig in bytes
+ *  @param done     Called with the mbedtls_ecdsa_read_signature() result
+ *  @return         0 if the job was queued, MBEDTLS_ERR_ECP_BAD_INPUT_DATA
+ *                  on invalid arguments or MBEDTLS_ERR_ECP_ALLOC_FAILED if
+ *                  the job could not be allocated or queued
+ */
+int mbed_ecdsa_verify_async(events::EventQueue *queue,
+                            mbedtls_ecdsa_context *ctx,
+                            const unsigned char *hash, size_t hash_len,
+                            const unsigned char *sig, size_t sig_len,
+                            mbed::Callback<void(int)> done);
+
+#endif /* MBEDTLS_ECDSA_C */
+
+#endif /* MBED_ECDSA_ASYNC_H */
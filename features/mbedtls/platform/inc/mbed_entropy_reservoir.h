@@ -0,0 +1,54 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_ENTROPY_RESERVOIR_H
+#define MBED_ENTROPY_RESERVOIR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(DEVICE_TRNG) && MBED_CONF_MBEDTLS_ENTROPY_RESERVOIR_SIZE > 0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Read entropy, preferring bytes buffered during idle
+ *
+ *  The reservoir is trickle-filled from the TRNG in the idle loop through
+ *  the sleep manager's idle hook, so reads that fit in the buffered amount
+ *  are a memcpy instead of a blocking hardware gather. Buffered bytes are
+ *  wiped as they are handed out and are never returned twice; when the
+ *  reservoir runs dry the remainder is gathered synchronously from the
+ *  TRNG as before.
+ *
+ *  Same contract as trng_get_bytes(): may return fewer bytes than asked.
+ *
+ *  @param output        Destination for the entropy
+ *  @param length        Number of bytes requested
+ *  @param output_length Written with the number of bytes provided
+ *  @return              0 on success, -1 if the TRNG failed and the
+ *                       reservoir was empty
+ */
+int mbed_entropy_reservoir_get_bytes(uint8_t *output, size_t length, size_t *output_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEVICE_TRNG && MBED_CONF_MBEDTLS_ENTROPY_RESERVOIR_SIZE > 0 */
+
+#endif /* MBED_ENTROPY_RESERVOIR_H */
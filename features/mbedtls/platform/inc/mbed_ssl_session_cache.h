@@ -0,0 +1,86 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_SSL_SESSION_CACHE_H
+#define MBED_SSL_SESSION_CACHE_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include "mbedtls/ssl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief          Look up a cached TLS session for a peer
+ *
+ *                 On a hit the session is filled in ready to be offered
+ *                 with mbedtls_ssl_set_session() before the handshake, so
+ *                 the reconnect resumes in one round trip. The caller owns
+ *                 the session: initialize it with mbedtls_ssl_session_init()
+ *                 first and release it with mbedtls_ssl_session_free() after
+ *                 the handshake.
+ *
+ * \param host     Hostname the session was saved under
+ * \param port     Port the session was saved under
+ * \param session  Destination for the cached session
+ *
+ * \return         0 on a hit, -1 if no session is cached for the peer
+ */
+int mbed_ssl_session_cache_get(const char *host, uint16_t port,
+                               mbedtls_ssl_session *session);
+
+/**
+ * \brief          Remember a TLS session for later resumption
+ *
+ *                 Call after a successful handshake with the session
+ *                 obtained from mbedtls_ssl_get_session(). An existing
+ *                 entry for the same (host, port) is replaced; when the
+ *                 cache is full the least recently used entry is evicted.
+ *                 Sessions carrying neither a session id nor a ticket are
+ *                 not resumable and are rejected.
+ *
+ * \param host     Hostname to save the session under
+ * \param port     Port to save the session under
+ * \param session  Session to save; the peer certificate is not retained
+ *
+ * \return         0 if stored, -1 otherwise
+ */
+int mbed_ssl_session_cache_put(const char *host, uint16_t port,
+                               const mbedtls_ssl_session *session);
+
+/**
+ * \brief          Drop all cached TLS sessions
+ *
+ *                 Also wipes the persisted copy when the cache is mirrored
+ *                 to NVStore.
+ */
+void mbed_ssl_session_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_SSL_CLI_C */
+
+#endif /* MBED_SSL_SESSION_CACHE_H */
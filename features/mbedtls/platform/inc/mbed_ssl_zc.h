@@ -0,0 +1,76 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_SSL_ZC_H
+#define MBED_SSL_ZC_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SSL_TLS_C)
+
+#include "mbedtls/ssl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief          Read application data without copying it
+ *
+ *                 Lends the caller a view of the current decrypted TLS
+ *                 record inside the SSL context's own input buffer instead
+ *                 of copying it out with mbedtls_ssl_read(). The view is one
+ *                 record or less and stays valid until it is returned with
+ *                 mbed_ssl_read_zc_release() - no other read or handshake
+ *                 operation may run on the context while it is outstanding.
+ *
+ * \param ssl      SSL context
+ * \param buf      written with a pointer to the decrypted data
+ *
+ * \return         the number of bytes readable at *buf,
+ *                 0 if the peer closed the connection,
+ *                 or a negative error code (including
+ *                 MBEDTLS_ERR_SSL_WANT_READ with a non-blocking BIO).
+ */
+int mbed_ssl_read_zc( mbedtls_ssl_context *ssl, const unsigned char **buf );
+
+/**
+ * \brief          Return data lent by mbed_ssl_read_zc()
+ *
+ *                 Consumes the first len bytes of the outstanding view.
+ *                 Consuming less than the view's length keeps the remainder
+ *                 pending for the next mbed_ssl_read_zc() or
+ *                 mbedtls_ssl_read() call.
+ *
+ * \param ssl      SSL context
+ * \param len      number of bytes consumed from the view
+ *
+ * \return         0 if successful, or MBEDTLS_ERR_SSL_BAD_INPUT_DATA if
+ *                 no view is outstanding or len overruns it
+ */
+int mbed_ssl_read_zc_release( mbedtls_ssl_context *ssl, size_t len );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_SSL_TLS_C */
+
+#endif /* MBED_SSL_ZC_H */
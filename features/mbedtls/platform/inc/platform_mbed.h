@@ -21,6 +21,37 @@
 #define MBEDTLS_ENTROPY_HARDWARE_ALT
 #endif
 
+#if defined(DEVICE_CRYPTO)
+#define MBEDTLS_AES_SETKEY_ENC_ALT
+#define MBEDTLS_AES_SETKEY_DEC_ALT
+#define MBEDTLS_AES_ENCRYPT_ALT
+#define MBEDTLS_AES_DECRYPT_ALT
+#define MBEDTLS_SHA256_PROCESS_ALT
+#define MBEDTLS_ECDH_GEN_PUBLIC_ALT
+#define MBEDTLS_ECDH_COMPUTE_SHARED_ALT
+#endif
+
 #if defined(MBEDTLS_CONFIG_HW_SUPPORT)
 #include "mbedtls_device.h"
 #endif
+
+#if MBED_CONF_MBEDTLS_CALLOC_POOL
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *mbed_mbedtls_pool_calloc(size_t n, size_t size);
+void mbed_mbedtls_pool_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define MBEDTLS_PLATFORM_MEMORY
+#define MBEDTLS_PLATFORM_CALLOC_MACRO mbed_mbedtls_pool_calloc
+#define MBEDTLS_PLATFORM_FREE_MACRO   mbed_mbedtls_pool_free
+
+#endif /* MBED_CONF_MBEDTLS_CALLOC_POOL */
@@ -0,0 +1,108 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Size-classed pool backend for mbedtls_calloc()/mbedtls_free(), enabled
+ * through mbedtls.calloc-pool. A handshake makes hundreds of short-lived
+ * MPI allocations of a few dozen bytes each; serving them from a static
+ * arena keeps that churn off the shared heap, so the heap does not
+ * fragment and allocation cost stays constant. Requests larger than the
+ * biggest class (SSL I/O buffers, parsed certificates) fall through to
+ * the heap as before.
+ */
+
+#if MBED_CONF_MBEDTLS_CALLOC_POOL
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform/mbed_critical.h"
+
+static const uint16_t class_size[] = { 16, 32, 64, 128, 256, 512 };
+
+#define NUM_CLASSES (sizeof(class_size) / sizeof(class_size[0]))
+
+/* Pool blocks carry one aligned header word holding their class index so
+ * free() can find the right list; heap-fallback blocks carry no header
+ * and are recognized by address range */
+#define HEADER_SIZE 8
+
+static uint8_t arena[MBED_CONF_MBEDTLS_CALLOC_POOL_SIZE] __attribute__((aligned(8)));
+static size_t arena_used;
+static void *free_list[NUM_CLASSES];
+
+void *mbed_mbedtls_pool_calloc(size_t n, size_t size)
+{
+    if (n != 0 && size > (size_t)-1 / n) {
+        return NULL;
+    }
+
+    size_t bytes = n * size;
+
+    size_t c;
+    for (c = 0; c < NUM_CLASSES; c++) {
+        if (bytes <= class_size[c]) {
+            break;
+        }
+    }
+    if (c == NUM_CLASSES) {
+        return calloc(n, size);
+    }
+
+    uint8_t *block = NULL;
+
+    core_util_critical_section_enter();
+    if (free_list[c]) {
+        block = (uint8_t *)free_list[c] - HEADER_SIZE;
+        free_list[c] = *(void **)free_list[c];
+    } else if (arena_used + HEADER_SIZE + class_size[c] <= sizeof(arena)) {
+        block = &arena[arena_used];
+        arena_used += HEADER_SIZE + class_size[c];
+        *(uint32_t *)block = (uint32_t)c;
+    }
+    core_util_critical_section_exit();
+
+    if (!block) {
+        /* Pool exhausted - spill to the heap rather than fail */
+        return calloc(n, size);
+    }
+
+    memset(block + HEADER_SIZE, 0, class_size[c]);
+    return block + HEADER_SIZE;
+}
+
+void mbed_mbedtls_pool_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    uint8_t *p = (uint8_t *)ptr;
+    if (p < arena || p >= arena + sizeof(arena)) {
+        free(ptr);
+        return;
+    }
+
+    uint32_t c = *(uint32_t *)(p - HEADER_SIZE);
+
+    core_util_critical_section_enter();
+    *(void **)ptr = free_list[c];
+    free_list[c] = ptr;
+    core_util_critical_section_exit();
+}
+
+#endif /* MBED_CONF_MBEDTLS_CALLOC_POOL */
@@ -0,0 +1,233 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Routes mbed TLS AES, SHA-256 and ECDH point multiplications to the
+ * target's crypto accelerator through hal/crypto_api.h. The ALT hooks are
+ * enabled from platform_mbed.h when the target declares DEVICE_CRYPTO;
+ * curves the hardware cannot handle fall back to the C implementation at
+ * runtime.
+ */
+
+#if defined(DEVICE_CRYPTO)
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "hal/crypto_api.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_AES_C)
+
+#include "mbedtls/aes.h"
+
+int mbedtls_aes_setkey_enc( mbedtls_aes_context *ctx, const unsigned char *key,
+                            unsigned int keybits )
+{
+    switch( keybits )
+    {
+        case 128: ctx->nr = 10; break;
+        case 192: ctx->nr = 12; break;
+        case 256: ctx->nr = 14; break;
+        default : return( MBEDTLS_ERR_AES_INVALID_KEY_LENGTH );
+    }
+
+    /* The hardware takes the raw key, so no schedule is expanded */
+    ctx->rk = ctx->buf;
+    memcpy( ctx->buf, key, keybits / 8 );
+
+    return( 0 );
+}
+
+int mbedtls_aes_setkey_dec( mbedtls_aes_context *ctx, const unsigned char *key,
+                            unsigned int keybits )
+{
+    return( mbedtls_aes_setkey_enc( ctx, key, keybits ) );
+}
+
+int mbedtls_internal_aes_encrypt( mbedtls_aes_context *ctx,
+                                  const unsigned char input[16],
+                                  unsigned char output[16] )
+{
+    if( hal_crypto_aes_crypt_ecb( (const uint8_t *) ctx->rk,
+                                  ( ctx->nr - 6 ) * 32, true,
+                                  input, output ) != 0 )
+    {
+        return( MBEDTLS_ERR_AES_HW_ACCEL_FAILED );
+    }
+
+    return( 0 );
+}
+
+int mbedtls_internal_aes_decrypt( mbedtls_aes_context *ctx,
+                                  const unsigned char input[16],
+                                  unsigned char output[16] )
+{
+    if( hal_crypto_aes_crypt_ecb( (const uint8_t *) ctx->rk,
+                                  ( ctx->nr - 6 ) * 32, false,
+                                  input, output ) != 0 )
+    {
+        return( MBEDTLS_ERR_AES_HW_ACCEL_FAILED );
+    }
+
+    return( 0 );
+}
+
+#endif /* MBEDTLS_AES_C */
+
+#if defined(MBEDTLS_SHA256_C)
+
+#include "mbedtls/sha256.h"
+
+int mbedtls_internal_sha256_process( mbedtls_sha256_context *ctx,
+                                     const unsigned char data[64] )
+{
+    if( hal_crypto_sha256_process( ctx->state, data ) != 0 )
+        return( MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED );
+
+    return( 0 );
+}
+
+#endif /* MBEDTLS_SHA256_C */
+
+#if defined(MBEDTLS_ECDH_C)
+
+#include "mbedtls/ecdh.h"
+#include "mbedtls/platform_util.h"
+
+#define ECP_HW_MAX_BYTES 48
+
+static uint32_t crypto_hw_curve( const mbedtls_ecp_group *grp )
+{
+    switch( grp->id )
+    {
+        case MBEDTLS_ECP_DP_SECP256R1: return( HAL_CRYPTO_ECC_P256 );
+        case MBEDTLS_ECP_DP_SECP384R1: return( HAL_CRYPTO_ECC_P384 );
+        default                      : return( 0 );
+    }
+}
+
+static int ecp_hw_capable( const mbedtls_ecp_group *grp )
+{
+    uint32_t curve = crypto_hw_curve( grp );
+
+    return( curve != 0 && ( hal_crypto_get_capabilities() & curve ) != 0 );
+}
+
+/*
+ * R = d * P on the accelerator, exchanging operands in the big-endian/SEC1
+ * formats the HAL defines
+ */
+static int ecp_hw_mul( mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                       const mbedtls_mpi *d, const mbedtls_ecp_point *P )
+{
+    int ret;
+    unsigned char scalar[ECP_HW_MAX_BYTES];
+    unsigned char point[2 * ECP_HW_MAX_BYTES + 1];
+    size_t plen = ( grp->pbits + 7 ) / 8;
+    size_t olen;
+
+    MBEDTLS_MPI_CHK( mbedtls_mpi_write_binary( d, scalar, plen ) );
+    MBEDTLS_MPI_CHK( mbedtls_ecp_point_write_binary( grp, P,
+                            MBEDTLS_ECP_PF_UNCOMPRESSED, &olen,
+                            point, sizeof( point ) ) );
+
+    if( hal_crypto_ecp_mul( crypto_hw_curve( grp ), scalar, plen,
+                            point, olen, point ) != 0 )
+    {
+        ret = MBEDTLS_ERR_ECP_HW_ACCEL_FAILED;
+        goto cleanup;
+    }
+
+    MBEDTLS_MPI_CHK( mbedtls_ecp_point_read_binary( grp, R, point, olen ) );
+
+cleanup:
+    mbedtls_platform_zeroize( scalar, sizeof( scalar ) );
+
+    return( ret );
+}
+
+int mbedtls_ecdh_gen_public( mbedtls_ecp_group *grp, mbedtls_mpi *d, mbedtls_ecp_point *Q,
+                     int (*f_rng)(void *, unsigned char *, size_t),
+                     void *p_rng )
+{
+    int ret;
+    int count = 0;
+    size_t n_size = ( grp->nbits + 7 ) / 8;
+
+    if( !ecp_hw_capable( grp ) )
+        return( mbedtls_ecp_gen_keypair( grp, d, Q, f_rng, p_rng ) );
+
+    /* SEC1 3.2.1: generate d such that 1 <= d < N, following the same
+     * procedure as mbedtls_ecp_gen_keypair_base() */
+    do
+    {
+        MBEDTLS_MPI_CHK( mbedtls_mpi_fill_random( d, n_size, f_rng, p_rng ) );
+        MBEDTLS_MPI_CHK( mbedtls_mpi_shift_r( d, 8 * n_size - grp->nbits ) );
+
+        if( ++count > 30 )
+            return( MBEDTLS_ERR_ECP_RANDOM_FAILED );
+    }
+    while( mbedtls_mpi_cmp_int( d, 1 ) < 0 ||
+           mbedtls_mpi_cmp_mpi( d, &grp->N ) >= 0 );
+
+    MBEDTLS_MPI_CHK( ecp_hw_mul( grp, Q, d, &grp->G ) );
+
+cleanup:
+    return( ret );
+}
+
+int mbedtls_ecdh_compute_shared( mbedtls_ecp_group *grp, mbedtls_mpi *z,
+                         const mbedtls_ecp_point *Q, const mbedtls_mpi *d,
+                         int (*f_rng)(void *, unsigned char *, size_t),
+                         void *p_rng )
+{
+    int ret;
+    mbedtls_ecp_point P;
+
+    mbedtls_ecp_point_init( &P );
+
+    /*
+     * Make sure Q is a valid pubkey before using it
+     */
+    MBEDTLS_MPI_CHK( mbedtls_ecp_check_pubkey( grp, Q ) );
+
+    if( ecp_hw_capable( grp ) )
+        MBEDTLS_MPI_CHK( ecp_hw_mul( grp, &P, d, Q ) );
+    else
+        MBEDTLS_MPI_CHK( mbedtls_ecp_mul( grp, &P, d, Q, f_rng, p_rng ) );
+
+    if( mbedtls_ecp_is_zero( &P ) )
+    {
+        ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+        goto cleanup;
+    }
+
+    MBEDTLS_MPI_CHK( mbedtls_mpi_copy( z, &P.X ) );
+
+cleanup:
+    mbedtls_ecp_point_free( &P );
+
+    return( ret );
+}
+
+#endif /* MBEDTLS_ECDH_C */
+
+#endif /* DEVICE_CRYPTO */
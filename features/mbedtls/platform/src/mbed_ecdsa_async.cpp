@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_ecdsa_async.h"
+
+#if defined(MBEDTLS_ECDSA_C)
+
+#include <new>
+
+struct ecdsa_job {
+    mbedtls_ecdsa_context *ctx;
+    mbedtls_md_type_t md_alg;
+    const unsigned char *hash;
+    size_t hash_len;
+    unsigned char *sig;
+    size_t *sig_len;
+    const unsigned char *in_sig;
+    size_t in_sig_len;
+    int (*f_rng)(void *, unsigned char *, size_t);
+    void *p_rng;
+    mbed::Callback<void(int)> done;
+};
+
+static void ecdsa_sign_job(ecdsa_job *job)
+{
+    int ret = mbedtls_ecdsa_write_signature(job->ctx, job->md_alg,
+                                            job->hash, job->hash_len,
+                                            job->sig, job->sig_len,
+                                            job->f_rng, job->p_rng);
+    job->done(ret);
+    delete job;
+}
+
+static void ecdsa_verify_job(ecdsa_job *job)
+{
+    int ret = mbedtls_ecdsa_read_signature(job->ctx,
+                                           job->hash, job->hash_len,
+                                           job->in_sig, job->in_sig_len);
+    job->done(ret);
+    delete job;
+}
+
+int mbed_ecdsa_sign_async(events::EventQueue *queue,
+                          mbedtls_ecdsa_context *ctx,
+                          mbedtls_md_type_t md_alg,
+                          const unsigned char *hash, size_t hash_len,
+                          unsigned char *sig, size_t *sig_len,
+                          int (*f_rng)(void *, unsigned char *, size_t),
+                          void *p_rng,
+                          mbed::Callback<void(int)> done)
+{
+    if (!queue || !ctx || !hash || !sig || !sig_len || !done) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    ecdsa_job *job = new (std::nothrow) ecdsa_job;
+    if (!job) {
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    job->ctx = ctx;
+    job->md_alg = md_alg;
+    job->hash = hash;
+    job->hash_len = hash_len;
+    job->sig = sig;
+    job->sig_len = sig_len;
+    job->f_rng = f_rng;
+    job->p_rng = p_rng;
+    job->done = done;
+
+    if (queue->call(ecdsa_sign_job, job) == 0) {
+        delete job;
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    return 0;
+}
+
+int mbed_ecdsa_verify_async(events::EventQueue *queue,
+                            mbedtls_ecdsa_context *ctx,
+                            const unsigned char *hash, size_t hash_len,
+                            const unsigned char *sig, size_t sig_len,
+                            mbed::Callback<void(int)> done)
+{
+    if (!queue || !ctx || !hash || !sig || !done) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    ecdsa_job *job = new (std::nothrow) ecdsa_job;
+    if (!job) {
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    job->ctx = ctx;
+    job->hash = hash;
+    job->hash_len = hash_len;
+    job->in_sig = sig;
+    job->in_sig_len = sig_len;
+    job->done = done;
+
+    if (queue->call(ecdsa_verify_job, job) == 0) {
+        delete job;
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    return 0;
+}
+
+#endif /* MBEDTLS_ECDSA_C */
@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_entropy_reservoir.h"
+
+#if defined(DEVICE_TRNG) && MBED_CONF_MBEDTLS_ENTROPY_RESERVOIR_SIZE > 0
+
+#include <string.h>
+
+#include "hal/trng_api.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
+
+#define RESERVOIR_SIZE MBED_CONF_MBEDTLS_ENTROPY_RESERVOIR_SIZE
+
+/* How much to gather per idle pass, bounding how long one pass delays
+ * sleep entry */
+#define FILL_CHUNK 32
+
+static uint8_t reservoir[RESERVOIR_SIZE];
+static size_t reservoir_level;
+
+/* Trickle-fill the reservoir while the system has nothing better to do.
+ * Runs in the idle loop with interrupts enabled; the hardware gather
+ * happens outside the critical section and only the copy into the
+ * reservoir is protected. */
+void sleep_manager_idle_hook(void)
+{
+    uint8_t chunk[FILL_CHUNK];
+    size_t space;
+    size_t got = 0;
+
+    core_util_critical_section_enter();
+    space = sizeof(reservoir) - reservoir_level;
+    core_util_critical_section_exit();
+
+    if (space == 0) {
+        return;
+    }
+    if (space > FILL_CHUNK) {
+        space = FILL_CHUNK;
+    }
+
+    trng_t trng_obj;
+    trng_init(&trng_obj);
+    int ret = trng_get_bytes(&trng_obj, chunk, space, &got);
+    trng_free(&trng_obj);
+
+    if (ret != 0) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    space = sizeof(reservoir) - reservoir_level;
+    if (got > space) {
+        got = space;
+    }
+    memcpy(&reservoir[reservoir_level], chunk, got);
+    reservoir_level += got;
+    core_util_critical_section_exit();
+
+    memset(chunk, 0, sizeof(chunk));
+}
+
+int mbed_entropy_reservoir_get_bytes(uint8_t *output, size_t length, size_t *output_length)
+{
+    size_t from_pool;
+
+    core_util_critical_section_enter();
+    from_pool = (reservoir_level < length) ? reservoir_level : length;
+    memcpy(output, &reservoir[reservoir_level - from_pool], from_pool);
+    /* Wipe what was handed out so no byte can ever be served twice */
+    memset(&reservoir[reservoir_level - from_pool], 0, from_pool);
+    reservoir_level -= from_pool;
+    core_util_critical_section_exit();
+
+    *output_length = from_pool;
+    if (from_pool == length) {
+        return 0;
+    }
+
+    /* Reservoir ran dry - gather the remainder synchronously */
+    trng_t trng_obj;
+    size_t got = 0;
+    trng_init(&trng_obj);
+    int ret = trng_get_bytes(&trng_obj, output + from_pool, length - from_pool, &got);
+    trng_free(&trng_obj);
+
+    if (ret != 0) {
+        return from_pool ? 0 : -1;
+    }
+
+    *output_length = from_pool + got;
+    return 0;
+}
+
+#endif /* DEVICE_TRNG && MBED_CONF_MBEDTLS_ENTROPY_RESERVOIR_SIZE > 0 */
@@ -0,0 +1,392 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_ssl_session_cache.h"
+
+#if defined(MBEDTLS_SSL_CLI_C) && MBED_CONF_MBEDTLS_SSL_SESSION_CACHE_SIZE > 0
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "PlatformMutex.h"
+#include "rtos/Kernel.h"
+
+#if MBED_CONF_MBEDTLS_SSL_SESSION_CACHE_PERSIST
+#include "nvstore.h"
+#if NVSTORE_ENABLED
+#define SESSION_CACHE_PERSIST 1
+#endif
+#endif
+
+#define SESSION_CACHE_SIZE      MBED_CONF_MBEDTLS_SSL_SESSION_CACHE_SIZE
+#define SESSION_CACHE_HOST_MAX  64
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+#define SESSION_CACHE_HAS_TICKETS 1
+#endif
+
+struct session_entry {
+    bool valid;
+    char host[SESSION_CACHE_HOST_MAX];
+    uint16_t port;
+    uint64_t last_used;
+    int ciphersuite;
+    int compression;
+    size_t id_len;
+    unsigned char id[32];
+    unsigned char master[48];
+    uint32_t verify_result;
+#if SESSION_CACHE_HAS_TICKETS
+    unsigned char *ticket;
+    size_t ticket_len;
+    uint32_t ticket_lifetime;
+#endif
+};
+
+static session_entry session_cache[SESSION_CACHE_SIZE];
+static PlatformMutex session_cache_mutex;
+
+static void session_cache_ensure_loaded();
+static void session_cache_save();
+
+static void session_entry_wipe(session_entry *entry)
+{
+#if SESSION_CACHE_HAS_TICKETS
+    if (entry->ticket) {
+        memset(entry->ticket, 0, entry->ticket_len);
+        free(entry->ticket);
+    }
+#endif
+    memset(entry, 0, sizeof(*entry));
+}
+
+static session_entry *session_cache_find(const char *host, uint16_t port)
+{
+    for (int i = 0; i < SESSION_CACHE_SIZE; i++) {
+        if (session_cache[i].valid && session_cache[i].port == port &&
+                strcmp(session_cache[i].host, host) == 0) {
+            return &session_cache[i];
+        }
+    }
+    return NULL;
+}
+
+int mbed_ssl_session_cache_get(const char *host, uint16_t port,
+                               mbedtls_ssl_session *session)
+{
+    if (!host || !session) {
+        return -1;
+    }
+
+    session_cache_mutex.lock();
+    session_cache_ensure_loaded();
+
+    session_entry *entry = session_cache_find(host, port);
+    if (!entry) {
+        session_cache_mutex.unlock();
+        return -1;
+    }
+
+    session->ciphersuite = entry->ciphersuite;
+    session->compression = entry->compression;
+    session->id_len = entry->id_len;
+    memcpy(session->id, entry->id, sizeof(session->id));
+    memcpy(session->master, entry->master, sizeof(session->master));
+    session->verify_result = entry->verify_result;
+
+#if SESSION_CACHE_HAS_TICKETS
+    if (entry->ticket_len) {
+        session->ticket = (unsigned char *)malloc(entry->ticket_len);
+        if (!session->ticket) {
+            session_cache_mutex.unlock();
+            return -1;
+        }
+        memcpy(session->ticket, entry->ticket, entry->ticket_len);
+        session->ticket_len = entry->ticket_len;
+        session->ticket_lifetime = entry->ticket_lifetime;
+    }
+#endif
+
+    entry->last_used = rtos::Kernel::get_ms_count();
+
+    session_cache_mutex.unlock();
+    return 0;
+}
+
+int mbed_ssl_session_cache_put(const char *host, uint16_t port,
+                               const mbedtls_ssl_session *session)
+{
+    if (!host || !session || strlen(host) >= SESSION_CACHE_HOST_MAX) {
+        return -1;
+    }
+
+    /* A session with neither an id nor a ticket cannot be resumed */
+    bool resumable = session->id_len != 0;
+#if SESSION_CACHE_HAS_TICKETS
+    resumable = resumable || session->ticket_len != 0;
+#endif
+    if (!resumable) {
+        return -1;
+    }
+
+    session_cache_mutex.lock();
+    session_cache_ensure_loaded();
+
+    session_entry *entry = session_cache_find(host, port);
+    if (!entry) {
+        /* Take a free slot, or evict the least recently used entry */
+        for (int i = 0; i < SESSION_CACHE_SIZE; i++) {
+            if (!session_cache[i].valid) {
+                entry = &session_cache[i];
+                break;
+            }
+            if (!entry || session_cache[i].last_used < entry->last_used) {
+                entry = &session_cache[i];
+            }
+        }
+    }
+
+    session_entry_wipe(entry);
+
+#if SESSION_CACHE_HAS_TICKETS
+    if (session->ticket_len) {
+        entry->ticket = (unsigned char *)malloc(session->ticket_len);
+        if (!entry->ticket) {
+            session_cache_mutex.unlock();
+            return -1;
+        }
+        memcpy(entry->ticket, session->ticket, session->ticket_len);
+        entry->ticket_len = session->ticket_len;
+        entry->ticket_lifetime = session->ticket_lifetime;
+    }
+#endif
+
+    strcpy(entry->host, host);
+    entry->port = port;
+    entry->last_used = rtos::Kernel::get_ms_count();
+    entry->ciphersuite = session->ciphersuite;
+    entry->compression = session->compression;
+    entry->id_len = session->id_len;
+    memcpy(entry->id, session->id, sizeof(entry->id));
+    memcpy(entry->master, session->master, sizeof(entry->master));
+    entry->verify_result = session->verify_result;
+    entry->valid = true;
+
+    session_cache_save();
+
+    session_cache_mutex.unlock();
+    return 0;
+}
+
+void mbed_ssl_session_cache_clear(void)
+{
+    session_cache_mutex.lock();
+    session_cache_ensure_loaded();
+
+    for (int i = 0; i < SESSION_CACHE_SIZE; i++) {
+        session_entry_wipe(&session_cache[i]);
+    }
+
+    session_cache_save();
+
+    session_cache_mutex.unlock();
+}
+
+#if SESSION_CACHE_PERSIST
+
+/* The cache is mirrored to NVStore as one flat record so sessions survive a
+ * reboot: per entry {uint8_t host length, host characters, uint16_t port,
+ * int32_t ciphersuite, uint8_t compression, uint8_t id length, 32-byte id,
+ * 48-byte master secret, uint32_t verify result, uint32_t ticket lifetime,
+ * uint16_t ticket length, ticket bytes}. Expired tickets are not tracked
+ * here - a server that no longer accepts one simply continues with a full
+ * handshake. Callers hold session_cache_mutex. */
+
+static bool session_cache_loaded = false;
+
+#define SESSION_ENTRY_FIXED_SIZE \
+    (1 + SESSION_CACHE_HOST_MAX + 2 + 4 + 1 + 1 + 32 + 48 + 4 + 4 + 2)
+
+static void session_cache_ensure_loaded()
+{
+    if (session_cache_loaded) {
+        return;
+    }
+    session_cache_loaded = true;
+
+    uint16_t size = 0;
+    if (NVStore::get_instance().get_item_size(NVSTORE_TLS_SESSION_CACHE_KEY, size) != NVSTORE_SUCCESS || size == 0) {
+        return;
+    }
+
+    uint8_t *buf = (uint8_t *)malloc(size);
+    if (!buf) {
+        return;
+    }
+
+    uint16_t actual = 0;
+    if (NVStore::get_instance().get(NVSTORE_TLS_SESSION_CACHE_KEY, size, buf, actual) != NVSTORE_SUCCESS) {
+        free(buf);
+        return;
+    }
+
+    const uint8_t *p = buf;
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+    int index = 0;
+
+    while (index < SESSION_CACHE_SIZE && p + 1 <= buf + actual) {
+        uint8_t host_len = *p++;
+        uint16_t ticket_len;
+        session_entry *entry = &session_cache[index];
+
+        if (host_len >= SESSION_CACHE_HOST_MAX ||
+                p + host_len + 2 + 4 + 1 + 1 + 32 + 48 + 4 + 4 + 2 > buf + actual) {
+            break;
+        }
+
+        memcpy(entry->host, p, host_len);
+        entry->host[host_len] = '\0';
+        p += host_len;
+        memcpy(&entry->port, p, 2);
+        p += 2;
+        int32_t ciphersuite;
+        memcpy(&ciphersuite, p, 4);
+        entry->ciphersuite = ciphersuite;
+        p += 4;
+        entry->compression = *p++;
+        entry->id_len = *p++;
+        memcpy(entry->id, p, 32);
+        p += 32;
+        memcpy(entry->master, p, 48);
+        p += 48;
+        memcpy(&entry->verify_result, p, 4);
+        p += 4;
+        uint32_t ticket_lifetime;
+        memcpy(&ticket_lifetime, p, 4);
+        p += 4;
+        memcpy(&ticket_len, p, 2);
+        p += 2;
+
+        if (p + ticket_len > buf + actual || entry->id_len > 32) {
+            memset(entry, 0, sizeof(*entry));
+            break;
+        }
+
+#if SESSION_CACHE_HAS_TICKETS
+        if (ticket_len) {
+            entry->ticket = (unsigned char *)malloc(ticket_len);
+            if (!entry->ticket) {
+                memset(entry, 0, sizeof(*entry));
+                break;
+            }
+            memcpy(entry->ticket, p, ticket_len);
+            entry->ticket_len = ticket_len;
+            entry->ticket_lifetime = ticket_lifetime;
+        }
+#else
+        (void)ticket_lifetime;
+#endif
+        p += ticket_len;
+
+        entry->last_used = ms_count;
+        entry->valid = true;
+        index++;
+    }
+
+    memset(buf, 0, actual);
+    free(buf);
+}
+
+static void session_cache_save()
+{
+    size_t max_size = 0;
+    for (int i = 0; i < SESSION_CACHE_SIZE; i++) {
+        if (session_cache[i].valid) {
+            max_size += SESSION_ENTRY_FIXED_SIZE;
+#if SESSION_CACHE_HAS_TICKETS
+            max_size += session_cache[i].ticket_len;
+#endif
+        }
+    }
+
+    if (max_size > UINT16_MAX) {
+        return;
+    }
+
+    uint8_t *buf = (uint8_t *)malloc(max_size ? max_size : 1);
+    if (!buf) {
+        return;
+    }
+
+    uint8_t *p = buf;
+
+    for (int i = 0; i < SESSION_CACHE_SIZE; i++) {
+        session_entry *entry = &session_cache[i];
+        if (!entry->valid) {
+            continue;
+        }
+
+        uint8_t host_len = (uint8_t)strlen(entry->host);
+        *p++ = host_len;
+        memcpy(p, entry->host, host_len);
+        p += host_len;
+        memcpy(p, &entry->port, 2);
+        p += 2;
+        int32_t ciphersuite = entry->ciphersuite;
+        memcpy(p, &ciphersuite, 4);
+        p += 4;
+        *p++ = (uint8_t)entry->compression;
+        *p++ = (uint8_t)entry->id_len;
+        memcpy(p, entry->id, 32);
+        p += 32;
+        memcpy(p, entry->master, 48);
+        p += 48;
+        memcpy(p, &entry->verify_result, 4);
+        p += 4;
+        uint32_t ticket_lifetime = 0;
+        uint16_t ticket_len = 0;
+#if SESSION_CACHE_HAS_TICKETS
+        ticket_lifetime = entry->ticket_lifetime;
+        ticket_len = (uint16_t)entry->ticket_len;
+#endif
+        memcpy(p, &ticket_lifetime, 4);
+        p += 4;
+        memcpy(p, &ticket_len, 2);
+        p += 2;
+#if SESSION_CACHE_HAS_TICKETS
+        memcpy(p, entry->ticket, ticket_len);
+        p += ticket_len;
+#endif
+    }
+
+    NVStore::get_instance().set(NVSTORE_TLS_SESSION_CACHE_KEY, (uint16_t)(p - buf), buf);
+    memset(buf, 0, max_size ? max_size : 1);
+    free(buf);
+}
+
+#else
+
+static void session_cache_ensure_loaded()
+{
+}
+
+static void session_cache_save()
+{
+}
+
+#endif // SESSION_CACHE_PERSIST
+
+#endif /* MBEDTLS_SSL_CLI_C && MBED_CONF_MBEDTLS_SSL_SESSION_CACHE_SIZE > 0 */
@@ -0,0 +1,73 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_ssl_zc.h"
+
+#if defined(MBEDTLS_SSL_TLS_C)
+
+int mbed_ssl_read_zc( mbedtls_ssl_context *ssl, const unsigned char **buf )
+{
+    unsigned char dummy;
+    int ret;
+
+    if( ssl == NULL || ssl->conf == NULL || buf == NULL )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    /*
+     * A zero-length read drives the handshake and record processing
+     * without consuming anything: on return in_offt is parked on the
+     * decrypted payload of the pending application data record, which
+     * is handed out by reference instead of being copied out.
+     */
+    ret = mbedtls_ssl_read( ssl, &dummy, 0 );
+    if( ret < 0 )
+        return( ret );
+
+    if( ssl->in_offt == NULL )
+        return( 0 );
+
+    *buf = ssl->in_offt;
+    return( (int) ssl->in_msglen );
+}
+
+int mbed_ssl_read_zc_release( mbedtls_ssl_context *ssl, size_t len )
+{
+    if( ssl == NULL || ssl->conf == NULL )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    if( ssl->in_offt == NULL || len > ssl->in_msglen )
+        return( MBEDTLS_ERR_SSL_BAD_INPUT_DATA );
+
+    /* Mirror mbedtls_ssl_read()'s buffer bookkeeping so the two
+     * interfaces can be mixed freely on one context */
+    ssl->in_msglen -= len;
+
+    if( ssl->in_msglen == 0 )
+    {
+        /* all bytes consumed */
+        ssl->in_offt = NULL;
+        ssl->keep_current_message = 0;
+    }
+    else
+    {
+        /* more data available */
+        ssl->in_offt += len;
+    }
+
+    return( 0 );
+}
+
+#endif /* MBEDTLS_SSL_TLS_C */
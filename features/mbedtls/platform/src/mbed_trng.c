@@ -17,13 +17,18 @@
 #if defined(DEVICE_TRNG)
 
 #include "hal/trng_api.h"
+#include "mbed_entropy_reservoir.h"
 
 int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
+#if MBED_CONF_MBEDTLS_ENTROPY_RESERVOIR_SIZE > 0
+    return mbed_entropy_reservoir_get_bytes(output, len, olen);
+#else
     trng_t trng_obj;
     trng_init(&trng_obj);
     int ret = trng_get_bytes(&trng_obj, output, len, olen);
     trng_free(&trng_obj);
     return ret;
+#endif
 }
 
 #endif
@@ -46,6 +46,99 @@ static void own_free(void *ptr)
 
 static NS_LIST_DEFINE(request_list, coap_transaction_t, link);
 
+/* Serialized-message cache for notification fan-out. When the same
+ * non-confirmable message is sent to several destinations back to back,
+ * only the first send pays for serialization; the following sends reuse
+ * the cached packet and just patch in the per-destination message ID and
+ * token. The cache holds the most recent such message and the buffer is
+ * reference counted, so a send still in progress keeps it alive if the
+ * cache entry is replaced underneath it. */
+typedef struct cached_message {
+    uint8_t *packet_ptr;
+    uint8_t *uri_ptr;
+    uint16_t packet_len;
+    uint16_t uri_len;
+    uint16_t payload_len;
+    sn_coap_msg_code_e msg_code;
+    sn_coap_content_format_e content_format;
+    uint8_t reference_count;
+} cached_message_t;
+
+static cached_message_t *message_cache = NULL;
+static uint16_t cached_msg_id = 0;
+
+static void cached_message_release(cached_message_t *this)
+{
+    if (this && --this->reference_count == 0) {
+        ns_dyn_mem_free(this->packet_ptr);
+        ns_dyn_mem_free(this->uri_ptr);
+        ns_dyn_mem_free(this);
+    }
+}
+
+static void cached_message_store(const char *uri, sn_coap_msg_code_e msg_code, sn_coap_content_format_e content_format,
+                                 uint16_t payload_len, const uint8_t *packet_ptr, uint16_t packet_len)
+{
+    cached_message_t *this = ns_dyn_mem_alloc(sizeof(cached_message_t));
+    if (!this) {
+        return;
+    }
+    this->uri_len = strlen(uri);
+    this->packet_ptr = ns_dyn_mem_alloc(packet_len);
+    this->uri_ptr = ns_dyn_mem_alloc(this->uri_len);
+    if (!this->packet_ptr || !this->uri_ptr) {
+        ns_dyn_mem_free(this->packet_ptr);
+        ns_dyn_mem_free(this->uri_ptr);
+        ns_dyn_mem_free(this);
+        return;
+    }
+    memcpy(this->packet_ptr, packet_ptr, packet_len);
+    memcpy(this->uri_ptr, uri, this->uri_len);
+    this->packet_len = packet_len;
+    this->payload_len = payload_len;
+    this->msg_code = msg_code;
+    this->content_format = content_format;
+    this->reference_count = 1; // reference held by the cache
+
+    cached_message_release(message_cache);
+    message_cache = this;
+}
+
+static bool cached_message_match(const char *uri, sn_coap_msg_code_e msg_code, sn_coap_content_format_e content_format,
+                                 const uint8_t *payload_ptr, uint16_t payload_len)
+{
+    cached_message_t *this = message_cache;
+
+    if (!this || this->msg_code != msg_code || this->content_format != content_format) {
+        return false;
+    }
+    if (this->uri_len != strlen(uri) || memcmp(this->uri_ptr, uri, this->uri_len) != 0) {
+        return false;
+    }
+    /* The payload is serialized verbatim as the tail of the packet */
+    if (this->payload_len != payload_len ||
+            (payload_len > 0 && memcmp(this->packet_ptr + this->packet_len - payload_len, payload_ptr, payload_len) != 0)) {
+        return false;
+    }
+    return true;
+}
+
+/* Message IDs for cached sends come from an own pool, as the CoAP library
+ * allocates IDs only while building. Non-confirmable responses are matched
+ * by token, so the IDs only need to be locally unique for duplicate
+ * detection at the receiver. */
+static uint16_t cached_message_id_allocate(void)
+{
+    if (cached_msg_id == 0) {
+        cached_msg_id = randLIB_get_16bit();
+    }
+    cached_msg_id++;
+    if (cached_msg_id == 0) {
+        cached_msg_id = 1;
+    }
+    return cached_msg_id;
+}
+
 static coap_transaction_t *transaction_find_client_by_token(uint8_t *token, uint8_t token_len, const uint8_t address[static 16], uint16_t port)
 {
     (void) address;
@@ -236,6 +329,10 @@ int8_t coap_message_handler_destroy(coap_msg_handler_t *handle){
         cur_ptr = NULL;
     }
 
+    //Drop the serialized-message cache
+    cached_message_release(message_cache);
+    message_cache = NULL;
+
     handle->sn_coap_service_free(handle);
     return 0;
 }
@@ -381,6 +478,29 @@ uint16_t coap_message_handler_request_send(coap_msg_handler_t *handle, int8_t se
     request.token_ptr = transaction_ptr->token;
     request.token_len = 4;
 
+    /* Notification fan-out fast path: when the same non-confirmable
+     * message was just serialized for another destination, reuse the
+     * cached packet and patch in this destination's message ID and token. */
+    if (msg_type == COAP_MSG_TYPE_NON_CONFIRMABLE
+            && cached_message_match(uri, msg_code, cont_type, payload_ptr, payload_len)) {
+        cached_message_t *cached = message_cache;
+
+        cached->reference_count++;
+        request.msg_id = cached_message_id_allocate();
+        cached->packet_ptr[2] = request.msg_id >> 8;
+        cached->packet_ptr[3] = request.msg_id & 0xFF;
+        memcpy(&cached->packet_ptr[4], transaction_ptr->token, 4);
+        transaction_ptr->msg_id = request.msg_id;
+        handle->sn_coap_tx_callback(cached->packet_ptr, cached->packet_len, &dst_addr, transaction_ptr);
+        cached_message_release(cached);
+
+        if (request_response_cb == NULL) {
+            //No response expected
+            return 0;
+        }
+        return request.msg_id;
+    }
+
     request.payload_len = payload_len;
     request.payload_ptr = (uint8_t *) payload_ptr;  // Cast away const and trust that nsdl doesn't modify...
     data_len = sn_coap_builder_calc_needed_packet_data_size(&request);
@@ -406,6 +526,14 @@ uint16_t coap_message_handler_request_send(coap_msg_handler_t *handle, int8_t se
     transaction_ptr->msg_id = request.msg_id;
     handle->sn_coap_tx_callback(data_ptr, data_len, &dst_addr, transaction_ptr);
 
+    /* Cache the serialized packet for fan-out to further destinations.
+     * A build shorter than the calculated size means the library engaged
+     * blockwise transfer, in which case the packet is not reusable. */
+    if (msg_type == COAP_MSG_TYPE_NON_CONFIRMABLE && sn_coap_ret > 0
+            && (uint16_t)sn_coap_ret == data_len) {
+        cached_message_store(uri, msg_code, cont_type, payload_len, data_ptr, data_len);
+    }
+
     // Free allocated data
     own_free(data_ptr);
     if(request_response_cb == NULL){
@@ -53,6 +53,11 @@ TEST(coap_message_handler, test_coap_message_handler_request_send)
     CHECK(test_coap_message_handler_request_send());
 }
 
+TEST(coap_message_handler, test_coap_message_handler_notification_cache)
+{
+    CHECK(test_coap_message_handler_notification_cache());
+}
+
 TEST(coap_message_handler, test_coap_message_handler_response_send)
 {
     CHECK(test_coap_message_handler_response_send());
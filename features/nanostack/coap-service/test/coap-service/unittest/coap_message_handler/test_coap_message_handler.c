@@ -288,6 +288,57 @@ bool test_coap_message_handler_request_send()
     return true;
 }
 
+bool test_coap_message_handler_notification_cache()
+{
+    retCounter = 2;
+    sn_coap_protocol_stub.expectedCoap = (struct coap_s*)malloc(sizeof(struct coap_s));
+    memset(sn_coap_protocol_stub.expectedCoap, 0, sizeof(struct coap_s));
+    coap_msg_handler_t *handle = coap_message_handler_init(&test_own_alloc, &test_own_free, &coap_tx_function);
+
+    uint8_t buf[16];
+    memset(&buf, 1, 16);
+    char uri[3];
+    uri[0] = 'r';
+    uri[1] = 's';
+    uri[2] = '\0';
+    char uri2[3];
+    uri2[0] = 'r';
+    uri2[1] = 'x';
+    uri2[2] = '\0';
+
+    /* First non-confirmable send serializes normally and populates the cache */
+    sn_coap_builder_stub.expectedUint16 = 10;
+    sn_coap_protocol_stub.expectedInt16 = 10;
+    nsdynmemlib_stub.returnCounter = 4;
+    if( 2 != coap_message_handler_request_send(handle, 3, 0, buf, 24, COAP_MSG_TYPE_NON_CONFIRMABLE, 2, &uri, 4, NULL, 0, &resp_recv))
+        return false;
+
+    /* Second identical send must be served from the cache: the builder and
+     * protocol build are set to fail, so success proves the cached packet
+     * was reused, with a message ID from the cache's own pool */
+    sn_coap_builder_stub.expectedUint16 = 0;
+    sn_coap_protocol_stub.expectedInt16 = -1;
+    nsdynmemlib_stub.returnCounter = 1;
+    uint16_t msg_id = coap_message_handler_request_send(handle, 3, 0, buf, 24, COAP_MSG_TYPE_NON_CONFIRMABLE, 2, &uri, 4, NULL, 0, &resp_recv);
+    if( msg_id == 0 || msg_id == 2 )
+        return false;
+
+    /* A different resource must miss the cache and take the normal path */
+    nsdynmemlib_stub.returnCounter = 1;
+    if( 2 != coap_message_handler_request_send(handle, 3, 0, buf, 24, COAP_MSG_TYPE_NON_CONFIRMABLE, 2, &uri2, 4, NULL, 0, &resp_recv))
+        return false;
+
+    /* Clear all transactions */
+    sn_coap_protocol_stub.expectedInt8 = 0;
+    if( 0 != coap_message_handler_exec(handle, 0xffffffff))
+        return false;
+
+    free(sn_coap_protocol_stub.expectedCoap);
+    sn_coap_protocol_stub.expectedCoap = NULL;
+    coap_message_handler_destroy(handle);
+    return true;
+}
+
 bool test_coap_message_handler_request_delete()
 {
     retCounter = 1;
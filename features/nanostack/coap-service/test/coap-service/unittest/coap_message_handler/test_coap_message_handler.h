@@ -28,6 +28,7 @@ bool test_coap_message_handler_destroy();
 bool test_coap_message_handler_find_transaction();
 bool test_coap_message_handler_coap_msg_process();
 bool test_coap_message_handler_request_send();
+bool test_coap_message_handler_notification_cache();
 bool test_coap_message_handler_response_send();
 bool test_coap_message_handler_request_delete();
 bool test_coap_message_handler_exec();
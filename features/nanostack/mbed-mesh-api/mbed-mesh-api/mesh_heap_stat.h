@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __MESH_HEAP_STAT_H__
+#define __MESH_HEAP_STAT_H__
+
+#include "nsdynmemLIB.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Read Nanostack heap size-class pool statistics.
+ *
+ * Pools are reserved from the Nanostack heap when the
+ * `mbed-mesh-api.heap-pool-block-sizes` and
+ * `mbed-mesh-api.heap-pool-block-counts` configuration values are set.
+ * One statistics entry is kept per size class; entries are updated by the
+ * stack as it runs and can be polled for monitoring pool pressure.
+ *
+ * Note: the caller may not modify the returned array.
+ *
+ * \param class_count Returns the number of size classes, may be NULL.
+ *
+ * \return NULL, heap pooling is not configured
+ * \return !=0, Pointer to array of class_count statistics entries.
+ */
+const ns_mem_pool_stat_t *mesh_system_heap_pool_stat_get(uint8_t *class_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MESH_HEAP_STAT_H__ */
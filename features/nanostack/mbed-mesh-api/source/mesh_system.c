@@ -23,6 +23,7 @@
 #include "platform/arm_hal_timer.h"
 #include "ns_hal_init.h"
 #include "include/mesh_system.h"
+#include "mbed-mesh-api/mesh_heap_stat.h"
 #include "mbed_assert.h"
 // For tracing we need to define flag, have include and define group
 #define HAVE_DEBUG 1
@@ -37,6 +38,16 @@ static uint8_t *app_stack_heap;
 #endif
 static bool mesh_initialized = false;
 
+/* Size-class pools reserved from the heap before the stack fragments it */
+#if defined(MBED_CONF_MBED_MESH_API_HEAP_POOL_BLOCK_SIZES) && defined(MBED_CONF_MBED_MESH_API_HEAP_POOL_BLOCK_COUNTS)
+static const ns_mem_block_size_t heap_pool_block_sizes[] = MBED_CONF_MBED_MESH_API_HEAP_POOL_BLOCK_SIZES;
+static const uint16_t heap_pool_block_counts[] = MBED_CONF_MBED_MESH_API_HEAP_POOL_BLOCK_COUNTS;
+#define HEAP_POOL_CLASS_COUNT (sizeof(heap_pool_block_sizes) / sizeof(heap_pool_block_sizes[0]))
+MBED_STATIC_ASSERT(HEAP_POOL_CLASS_COUNT == sizeof(heap_pool_block_counts) / sizeof(heap_pool_block_counts[0]),
+                   "heap-pool-block-sizes and heap-pool-block-counts must list the same number of classes");
+static ns_mem_pool_stat_t heap_pool_stat[HEAP_POOL_CLASS_COUNT];
+#endif
+
 /*
  * Heap error handler, called when heap problem is detected.
  * Function is for-ever loop.
@@ -67,6 +78,12 @@ void mesh_system_init(void)
 #endif
         ns_hal_init(app_stack_heap, MBED_CONF_MBED_MESH_API_HEAP_SIZE,
                     mesh_system_heap_error_handler, NULL);
+#if defined(MBED_CONF_MBED_MESH_API_HEAP_POOL_BLOCK_SIZES) && defined(MBED_CONF_MBED_MESH_API_HEAP_POOL_BLOCK_COUNTS)
+        if (ns_dyn_mem_pool_init(heap_pool_block_sizes, heap_pool_block_counts,
+                                 HEAP_POOL_CLASS_COUNT, heap_pool_stat) != 0) {
+            tr_error("Heap pool reservation failed");
+        }
+#endif
         eventOS_scheduler_mutex_wait();
         net_init_core();
         eventOS_scheduler_mutex_release();
@@ -74,6 +91,11 @@ void mesh_system_init(void)
     }
 }
 
+const ns_mem_pool_stat_t *mesh_system_heap_pool_stat_get(uint8_t *class_count)
+{
+    return ns_dyn_mem_get_pool_stat(class_count);
+}
+
 void mesh_system_send_connect_event(uint8_t receiver)
 {
     arm_event_s event = {
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ns_types.h"
+#include "platform/arm_hal_interrupt.h"
+#include "arm_hal_ccm.h"
+
+static const arm_ccm_offload_driver_t *ccm_driver;
+
+/* FIFO of operations waiting for the driver, plus the one in flight.
+ * Protected with the platform critical section so arm_ccm_offload_done()
+ * may be called from the driver's interrupt. */
+static arm_ccm_offload_op_t *queue_head;
+static arm_ccm_offload_op_t *queue_tail;
+static arm_ccm_offload_op_t *in_flight;
+
+int8_t arm_ccm_offload_driver_register(const arm_ccm_offload_driver_t *driver)
+{
+    if (driver && ccm_driver) {
+        return -1;
+    }
+
+    ccm_driver = driver;
+    return 0;
+}
+
+const arm_ccm_offload_driver_t *arm_ccm_offload_driver_get(void)
+{
+    return ccm_driver;
+}
+
+/* Pop the next queued operation and mark it in flight, or mark the
+ * driver idle. Returns the operation to start, if any. */
+static arm_ccm_offload_op_t *ccm_queue_next(void)
+{
+    platform_enter_critical();
+
+    arm_ccm_offload_op_t *op = queue_head;
+    if (op) {
+        queue_head = op->next;
+        if (!queue_head) {
+            queue_tail = NULL;
+        }
+    }
+    in_flight = op;
+
+    platform_exit_critical();
+    return op;
+}
+
+static void ccm_start(arm_ccm_offload_op_t *op)
+{
+    const arm_ccm_offload_driver_t *driver = ccm_driver;
+    int8_t status;
+
+    while (op) {
+        if (driver->enqueue) {
+            status = driver->enqueue(op);
+            if (status == ARM_CCM_STATUS_OK) {
+                /* Driver took it - completion arrives via arm_ccm_offload_done() */
+                return;
+            }
+        } else {
+            status = driver->run(op);
+        }
+
+        /* Synchronous driver, or the asynchronous start failed - complete
+         * here and move on to the next operation */
+        arm_ccm_offload_op_t *next = ccm_queue_next();
+        op->done(op, status);
+        op = next;
+    }
+}
+
+int8_t arm_ccm_offload_enqueue(arm_ccm_offload_op_t *op)
+{
+    if (!ccm_driver) {
+        return ARM_CCM_STATUS_UNSUPPORTED;
+    }
+
+    bool start = false;
+
+    platform_enter_critical();
+    op->next = NULL;
+    if (in_flight) {
+        if (queue_tail) {
+            queue_tail->next = op;
+        } else {
+            queue_head = op;
+        }
+        queue_tail = op;
+    } else {
+        in_flight = op;
+        start = true;
+    }
+    platform_exit_critical();
+
+    if (start) {
+        ccm_start(op);
+    }
+    return 0;
+}
+
+void arm_ccm_offload_done(arm_ccm_offload_op_t *op, int8_t status)
+{
+    /* Hand the driver its next operation before running the completion, so
+     * the engine is busy while the result is consumed */
+    arm_ccm_offload_op_t *next = ccm_queue_next();
+
+    op->done(op, status);
+
+    if (next) {
+        ccm_start(next);
+    }
+}
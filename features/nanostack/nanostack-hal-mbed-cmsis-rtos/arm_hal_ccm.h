@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Link-layer AES-CCM offload interface.
+ *
+ * Per-packet CCM in the nanostack security layer runs in software by
+ * default and dominates forwarding CPU on routing nodes. A radio or SoC
+ * driver with a hardware CCM engine can register an offload driver here:
+ *
+ * - The synchronous run() hook is picked up by the CCM library
+ *   (ccm_process_run()), replacing the software transform in place.
+ * - The asynchronous enqueue() hook, together with the per-packet queue in
+ *   this module, lets a driver pipeline crypto against radio I/O: operations
+ *   are queued with arm_ccm_offload_enqueue(), handed to the driver one at a
+ *   time, and completed from the driver's interrupt with
+ *   arm_ccm_offload_done().
+ *
+ * A driver may implement run() only; the queue then falls back to running
+ * operations inline as they are enqueued.
+ */
+
+#ifndef ARM_HAL_CCM_H_
+#define ARM_HAL_CCM_H_
+
+#include "ns_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Operation completed, MIC valid on decrypt */
+#define ARM_CCM_STATUS_OK            0
+/** Crypto failure or MIC mismatch */
+#define ARM_CCM_STATUS_FAIL        (-1)
+/** Driver cannot handle this operation - caller must use the software path */
+#define ARM_CCM_STATUS_UNSUPPORTED (-2)
+
+/** One per-packet CCM operation.
+ *
+ * All referenced buffers must stay valid until the operation completes.
+ * data_ptr is transformed in place; on encrypt the driver writes mic_len
+ * bytes to mic, on decrypt it compares against mic.
+ */
+typedef struct arm_ccm_offload_op {
+    uint8_t sec_level;              /**< AES_SECURITY_LEVEL_* from ccmLIB.h */
+    uint8_t mode;                   /**< AES_CCM_ENCRYPT or AES_CCM_DECRYPT */
+    uint8_t ccm_l;                  /**< CCM L parameter, 2 or 3 */
+    const uint8_t *key;             /**< 128-bit key */
+    const uint8_t *nonce;           /**< (15 - ccm_l) byte nonce */
+    uint8_t *data_ptr;              /**< Payload, transformed in place */
+    uint16_t data_len;              /**< Payload length */
+    const uint8_t *adata_ptr;       /**< Authenticated-only data */
+    uint16_t adata_len;             /**< Authenticated-only data length */
+    uint8_t *mic;                   /**< MIC in (decrypt) or out (encrypt) */
+    uint8_t mic_len;                /**< MIC length from the security level */
+
+    /** Called when the operation completes, possibly in interrupt context */
+    void (*done)(struct arm_ccm_offload_op *op, int8_t status);
+    void *arg;                      /**< Free for the submitter's use */
+
+    struct arm_ccm_offload_op *next; /**< Owned by the queue, do not touch */
+} arm_ccm_offload_op_t;
+
+/** Hooks a radio/SoC driver implements to provide the offload */
+typedef struct arm_ccm_offload_driver {
+    /** Run one operation to completion on the calling thread.
+     *  Return an ARM_CCM_STATUS_* code. */
+    int8_t (*run)(arm_ccm_offload_op_t *op);
+    /** Start one operation and return; report the result later with
+     *  arm_ccm_offload_done(). NULL if the driver is synchronous only. */
+    int8_t (*enqueue)(arm_ccm_offload_op_t *op);
+} arm_ccm_offload_driver_t;
+
+/** Register a CCM offload driver
+ *
+ * Only one driver may be registered; NULL unregisters.
+ *
+ * \param driver driver hook table, valid until unregistered
+ * \return 0 on success, -1 if another driver is already registered
+ */
+int8_t arm_ccm_offload_driver_register(const arm_ccm_offload_driver_t *driver);
+
+/** Get the registered offload driver
+ *
+ * \return the driver hook table, or NULL when no offload is available
+ */
+const arm_ccm_offload_driver_t *arm_ccm_offload_driver_get(void);
+
+/** Queue one CCM operation
+ *
+ * Operations are handed to the driver in order, one at a time, so crypto on
+ * one packet overlaps radio I/O on another. op->done is invoked on
+ * completion, possibly from interrupt context and possibly before this
+ * function returns (synchronous drivers and queue-bypass completions).
+ *
+ * \param op the operation, owned by the queue until done is called
+ * \return 0 when accepted, ARM_CCM_STATUS_UNSUPPORTED when no driver is
+ *         registered
+ */
+int8_t arm_ccm_offload_enqueue(arm_ccm_offload_op_t *op);
+
+/** Complete the in-flight operation
+ *
+ * Called by the driver, typically from its crypto-done interrupt. Starts the
+ * next queued operation before invoking the finished operation's done
+ * callback.
+ *
+ * \param op the operation handed to the driver's enqueue hook
+ * \param status an ARM_CCM_STATUS_* code
+ */
+void arm_ccm_offload_done(arm_ccm_offload_op_t *op, int8_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARM_HAL_CCM_H_ */
@@ -82,3 +82,19 @@ uint16_t platform_timer_get_remaining_slots(void)
     }
 }
 
+#ifdef NS_EVENTLOOP_RUNTIME_ACCOUNTING
+// Free-running timestamp for tasklet runtime accounting; a separate timer
+// from the protocol one above, which is reset on every timer start.
+static SingletonPtr<Timer> accounting_timer;
+static bool accounting_timer_started;
+
+uint32_t platform_timer_get_timestamp(void)
+{
+    if (!accounting_timer_started) {
+        accounting_timer->start();
+        accounting_timer_started = true;
+    }
+    return (uint32_t) accounting_timer->read_us();
+}
+#endif
+
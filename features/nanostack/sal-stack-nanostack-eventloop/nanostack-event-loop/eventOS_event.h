@@ -143,6 +143,45 @@ extern void eventOS_event_send_user_allocated(arm_event_storage_t *event);
  * */
 extern int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_t *), uint8_t init_event_type);
 
+/**
+ * \brief Set an event handler's priority class
+ *
+ * Events sent to the handler are queued at the higher of the event's own
+ * priority and the handler's priority class, so a latency-critical
+ * tasklet's events dispatch ahead of earlier-queued bulk work. Events are
+ * still run to completion; a running event is never interrupted.
+ *
+ * The default class is ARM_LIB_LOW_PRIORITY_EVENT. Already-queued events
+ * are not repositioned.
+ *
+ * \param tasklet_id event handler ID from eventOS_event_handler_create
+ * \param priority priority class for the handler's events
+ *
+ * \return 0 on success
+ * \return < 0 if the handler does not exist
+ *
+ * */
+extern int8_t eventOS_event_handler_set_priority(int8_t tasklet_id, arm_library_event_priority_e priority);
+
+/**
+ * \brief Read an event handler's runtime accounting counters
+ *
+ * Returns the cumulative time spent in the handler's callback and the
+ * number of events dispatched to it, for finding handlers that overrun
+ * their budget. Available when the event loop is built with runtime
+ * accounting enabled (nanostack-eventloop.runtime-accounting); otherwise
+ * the call fails.
+ *
+ * \param tasklet_id event handler ID from eventOS_event_handler_create
+ * \param runtime_us returns consumed time in microseconds, wrapping naturally at 32 bits
+ * \param dispatch_count returns number of events dispatched to the handler
+ *
+ * \return 0 on success
+ * \return < 0 if the handler does not exist or accounting is not enabled
+ *
+ * */
+extern int8_t eventOS_event_handler_runtime_read(int8_t tasklet_id, uint32_t *runtime_us, uint32_t *dispatch_count);
+
 /**
  * Cancel an event.
  *
@@ -88,6 +88,17 @@ extern int8_t platform_tick_timer_stop(void);
 
 #endif // NS_EVENTLOOP_USE_TICK_TIMER
 
+#ifdef NS_EVENTLOOP_RUNTIME_ACCOUNTING
+/**
+ * \brief This function is API for reading a free-running timestamp for
+ *        tasklet runtime accounting
+ *
+ * \return timestamp in microseconds, wrapping naturally at 32 bits
+ */
+extern uint32_t platform_timer_get_timestamp(void);
+
+#endif // NS_EVENTLOOP_RUNTIME_ACCOUNTING
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,8 @@
 #undef NS_EVENTLOOP_USE_TICK_TIMER
 /* Exclude high resolution timer from build (removes need for "platform_timer" API) */
 #undef NS_EXCLUDE_HIGHRES_TIMER
+/* Account time consumed by each tasklet (requires "platform_timer_get_timestamp" API) */
+#undef NS_EVENTLOOP_RUNTIME_ACCOUNTING
 
 /*
  * mbedOS 5 specific configuration flag mapping to internal flags
@@ -39,6 +41,10 @@
 #define NS_EXCLUDE_HIGHRES_TIMER        1
 #endif
 
+#ifdef MBED_CONF_NANOSTACK_EVENTLOOP_RUNTIME_ACCOUNTING
+#define NS_EVENTLOOP_RUNTIME_ACCOUNTING 1
+#endif
+
 /*
  * For mbedOS 3 and minar use platform tick timer by default, highres timers should come from eventloop adaptor
  */
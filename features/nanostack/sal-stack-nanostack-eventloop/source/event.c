@@ -23,11 +23,17 @@
 #include "ns_timer.h"
 #include "event.h"
 #include "platform/arm_hal_interrupt.h"
+#include "platform/arm_hal_timer.h"
 
 
 typedef struct arm_core_tasklet {
     int8_t id; /**< Event handler Tasklet ID */
+    arm_library_event_priority_e priority; /**< Priority class for the tasklet's events */
     void (*func_ptr)(arm_event_s *);
+#ifdef NS_EVENTLOOP_RUNTIME_ACCOUNTING
+    uint32_t runtime_us; /**< Cumulative time consumed in the event handler */
+    uint32_t dispatch_count; /**< Number of events dispatched to the handler */
+#endif
     ns_list_link_t link;
 } arm_core_tasklet_t;
 
@@ -102,7 +108,12 @@ int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_s *), uin
 
     //Fill in tasklet; add to list
     new->id = tasklet_get_free_id();
+    new->priority = ARM_LIB_LOW_PRIORITY_EVENT;
     new->func_ptr = handler_func_ptr;
+#ifdef NS_EVENTLOOP_RUNTIME_ACCOUNTING
+    new->runtime_us = 0;
+    new->dispatch_count = 0;
+#endif
     ns_list_add_to_end(&arm_core_tasklet_list, new);
 
     //Queue "init" event for the new task
@@ -115,6 +126,38 @@ int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_s *), uin
     return new->id;
 }
 
+int8_t eventOS_event_handler_set_priority(int8_t tasklet_id, arm_library_event_priority_e priority)
+{
+    arm_core_tasklet_t *tasklet = event_tasklet_handler_get(tasklet_id);
+    if (!tasklet) {
+        return -1;
+    }
+    tasklet->priority = priority;
+    return 0;
+}
+
+int8_t eventOS_event_handler_runtime_read(int8_t tasklet_id, uint32_t *runtime_us, uint32_t *dispatch_count)
+{
+#ifdef NS_EVENTLOOP_RUNTIME_ACCOUNTING
+    arm_core_tasklet_t *tasklet = event_tasklet_handler_get(tasklet_id);
+    if (!tasklet) {
+        return -1;
+    }
+    if (runtime_us) {
+        *runtime_us = tasklet->runtime_us;
+    }
+    if (dispatch_count) {
+        *dispatch_count = tasklet->dispatch_count;
+    }
+    return 0;
+#else
+    (void) tasklet_id;
+    (void) runtime_us;
+    (void) dispatch_count;
+    return -1;
+#endif
+}
+
 int8_t eventOS_event_send(const arm_event_t *event)
 {
     if (event_tasklet_handler_get(event->receiver)) {
@@ -216,6 +259,14 @@ static arm_event_storage_t *event_core_read(void)
 
 void event_core_write(arm_event_storage_t *event)
 {
+    /* Queue at the higher of the event's own priority and its receiver
+     * tasklet's priority class, so a latency-critical tasklet's events
+     * dispatch ahead of earlier-queued bulk work. */
+    arm_core_tasklet_t *receiver = event_tasklet_handler_get(event->data.receiver);
+    if (receiver && receiver->priority < event->data.priority) {
+        event->data.priority = receiver->priority;
+    }
+
     platform_enter_critical();
     bool added = false;
     ns_list_foreach(arm_event_storage_t, event_tmp, &event_queue_active) {
@@ -336,7 +387,14 @@ bool eventOS_scheduler_dispatch_event(void)
      */
 
     /* Tasklet Scheduler Call */
+#ifdef NS_EVENTLOOP_RUNTIME_ACCOUNTING
+    uint32_t start_time = platform_timer_get_timestamp();
+    tasklet->func_ptr(&cur_event->data);
+    tasklet->runtime_us += platform_timer_get_timestamp() - start_time;
+    tasklet->dispatch_count++;
+#else
     tasklet->func_ptr(&cur_event->data);
+#endif
     event_core_free_push(cur_event);
 
     /* Set Current Tasklet to Idle state */
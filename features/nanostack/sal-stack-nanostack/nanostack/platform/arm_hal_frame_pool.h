@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file arm_hal_frame_pool.h
+ * \brief Shared radio frame pool.
+ *
+ * A pool of fixed-size frame buffers shared between the RF driver and the
+ * MAC. The driver receives a frame - by DMA where the radio supports it -
+ * directly into a pool buffer and passes the payload pointer to its
+ * phy_rx_cb. The MAC recognizes pool payloads and takes ownership of the
+ * buffer instead of copying the frame into its own heap, so a received
+ * frame travels from the radio to MAC processing without a copy.
+ *
+ * Each buffer carries headroom in front of the payload that the MAC uses
+ * to build its frame descriptor in place; the driver must not touch it.
+ *
+ * Ownership: a buffer obtained with arm_net_frame_pool_alloc() belongs to
+ * the driver. It passes to the stack when the driver's phy_rx_cb returns
+ * >= 0 for its payload - the stack then frees it on every path, including
+ * frame drops. If phy_rx_cb returns < 0 the driver still owns the buffer
+ * and must free it.
+ *
+ * The pool is optional: when no pool is initialized, or a driver passes
+ * payloads that do not come from the pool, the MAC copies frames exactly
+ * as before.
+ */
+
+#ifndef ARM_HAL_FRAME_POOL_H_
+#define ARM_HAL_FRAME_POOL_H_
+
+#include "ns_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** One frame buffer of the shared pool */
+typedef struct arm_frame_buf {
+    uint8_t *payload;               /**< Frame data area of frame_size bytes */
+    uint16_t size;                  /**< Capacity of payload in bytes */
+    uint16_t length;                /**< Frame length, set by the driver */
+    uint8_t lqi;                    /**< Link quality, set by the driver */
+    int8_t dbm;                     /**< Signal strength, set by the driver */
+    struct arm_frame_buf *next;     /**< Free list link, owned by the pool */
+} arm_frame_buf_t;
+
+/**
+ * \brief Initialize the shared frame pool.
+ *
+ * Carves the given storage into as many frame buffers as fit. The storage
+ * is typically a static buffer provided by the RF driver and must be
+ * DMA-capable if the radio receives by DMA. May be called only once.
+ *
+ * \param storage pool memory, must stay valid forever
+ * \param storage_size size of storage in bytes
+ * \param frame_size payload capacity of one buffer, normally the PHY MTU
+ *
+ * \return number of buffers in the pool
+ * \return < 0 when the pool is already initialized or no buffer fits
+ */
+int8_t arm_net_frame_pool_init(void *storage, uint16_t storage_size, uint16_t frame_size);
+
+/**
+ * \brief Allocate a frame buffer. Callable from interrupt.
+ *
+ * \return a buffer with payload/size set, or NULL when the pool is empty
+ * or not initialized
+ */
+arm_frame_buf_t *arm_net_frame_pool_alloc(void);
+
+/**
+ * \brief Return a frame buffer to the pool. Callable from interrupt.
+ *
+ * \param buf buffer obtained from arm_net_frame_pool_alloc()
+ */
+void arm_net_frame_pool_free(arm_frame_buf_t *buf);
+
+/**
+ * \brief Map a payload pointer back to its pool buffer.
+ *
+ * \param payload a pointer that may or may not be a pool buffer's payload
+ *
+ * \return the owning buffer when payload is the start of a pool buffer's
+ * payload area, NULL otherwise
+ */
+arm_frame_buf_t *arm_net_frame_pool_from_payload(const uint8_t *payload);
+
+/**
+ * \brief Read the pool's frame capacity.
+ *
+ * \return payload capacity of one buffer, 0 when no pool is initialized
+ */
+uint16_t arm_net_frame_pool_frame_size(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ARM_HAL_FRAME_POOL_H_ */
@@ -33,6 +33,7 @@
 #include "mac_api.h"
 #include "fhss_api.h"
 #include "platform/arm_hal_interrupt.h"
+#include "platform/arm_hal_frame_pool.h"
 #include "common_functions.h"
 
 #include "MAC/IEEE802_15_4/sw_mac_internal.h"
@@ -1459,11 +1460,30 @@ static mac_pre_build_frame_t * mcps_sap_pd_req_queue_read(protocol_interface_rf_
 
 void mcps_sap_pre_parsed_frame_buffer_free(mac_pre_parsed_frame_t *buf)
 {
+    if (buf) {
+        arm_frame_buf_t *frame = arm_net_frame_pool_from_payload(buf->buf);
+        if (frame) {
+            arm_net_frame_pool_free(frame);
+            return;
+        }
+    }
+
     ns_dyn_mem_free(buf);
 }
 
 mac_pre_parsed_frame_t * mcps_sap_pre_parsed_frame_buffer_get(const uint8_t *data_ptr, uint16_t frame_length)
 {
+    /* A frame received straight into the shared radio frame pool carries
+     * headroom for the pre-parsed descriptor in front of the payload -
+     * build the descriptor in place instead of copying the frame */
+    arm_frame_buf_t *frame = arm_net_frame_pool_from_payload(data_ptr);
+    if (frame && frame_length <= frame->size) {
+        mac_pre_parsed_frame_t *buffer = (mac_pre_parsed_frame_t *)((uintptr_t)data_ptr - offsetof(mac_pre_parsed_frame_t, buf));
+        memset(buffer, 0, offsetof(mac_pre_parsed_frame_t, buf));
+        buffer->frameLength = frame_length;
+        return buffer;
+    }
+
     mac_pre_parsed_frame_t *buffer = ns_dyn_mem_temporary_alloc(sizeof(mac_pre_parsed_frame_t) + frame_length);
 
     if (buffer) {
@@ -1471,6 +1491,9 @@ mac_pre_parsed_frame_t * mcps_sap_pre_parsed_frame_buffer_get(const uint8_t *dat
         buffer->frameLength = frame_length;
         memcpy(mac_header_message_start_pointer(buffer), data_ptr, frame_length);
     }
+    /* Ownership of a pool frame passes to the stack with the call - when it
+     * could not be adopted above, release it here */
+    arm_net_frame_pool_free(frame);
     return buffer;
 }
 
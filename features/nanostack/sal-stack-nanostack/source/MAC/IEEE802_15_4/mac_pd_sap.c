@@ -24,6 +24,7 @@
 #include "ccmLIB.h"
 #include "common_functions.h"
 #include "platform/arm_hal_interrupt.h"
+#include "platform/arm_hal_frame_pool.h"
 #include "mac_api.h"
 #include "fhss_api.h"
 #include "MAC/IEEE802_15_4/sw_mac_internal.h"
@@ -311,15 +312,30 @@ static int8_t mac_data_interface_tx_done_cb(protocol_interface_rf_mac_setup_s *r
     return 0;
 }
 
+/* Once a frame in the shared radio pool has been handed to the stack, the
+ * stack owns it on every path - drop paths included */
+static void mac_pd_sap_pool_frame_drop(const arm_phy_sap_msg_t *message)
+{
+    if (message->id == MAC15_4_PD_SAP_DATA_IND) {
+        arm_net_frame_pool_free(arm_net_frame_pool_from_payload(message->message.generic_data_ind.data_ptr));
+    }
+}
+
 int8_t mac_pd_sap_data_cb(void *identifier, arm_phy_sap_msg_t *message)
 {
     protocol_interface_rf_mac_setup_s *rf_ptr = (protocol_interface_rf_mac_setup_s*)identifier;
 
-    if (!rf_ptr || !message ) {
+    if (!message) {
+        return -1;
+    }
+
+    if (!rf_ptr) {
+        mac_pd_sap_pool_frame_drop(message);
         return -1;
     }
 
     if (!rf_ptr->macUpState) {
+        mac_pd_sap_pool_frame_drop(message);
         return -2;
     }
 
@@ -329,6 +345,7 @@ int8_t mac_pd_sap_data_cb(void *identifier, arm_phy_sap_msg_t *message)
         arm_pd_sap_generic_ind_t *pd_data_ind = &(message->message.generic_data_ind);
 
         if (pd_data_ind->data_len < 3 ) {
+            mac_pd_sap_pool_frame_drop(message);
             return -1;
         }
         ptr = pd_data_ind->data_ptr;
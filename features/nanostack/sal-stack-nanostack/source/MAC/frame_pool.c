@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nsconfig.h"
+#include "string.h"
+#include <stddef.h>
+#include "ns_types.h"
+#include "platform/arm_hal_interrupt.h"
+#include "platform/arm_hal_frame_pool.h"
+#include "MAC/IEEE802_15_4/mac_mcps_sap.h"
+
+/* Each pool block holds the buffer descriptor, headroom where the MAC
+ * builds its pre-parsed frame descriptor in place, and the payload:
+ *
+ *   [arm_frame_buf_t][mac_pre_parsed_frame_t headroom][payload]
+ *
+ * The headroom equals offsetof(mac_pre_parsed_frame_t, buf) so the
+ * descriptor's trailing buf[] lines up exactly with the payload. */
+#define FRAME_POOL_HEADROOM     offsetof(mac_pre_parsed_frame_t, buf)
+#define FRAME_POOL_ALIGN(x)     (((x) + 3) & ~(uintptr_t)3)
+
+static uint8_t *pool_base;
+static uint16_t pool_stride;
+static uint16_t pool_frame_size;
+static uint8_t pool_count;
+static arm_frame_buf_t *pool_free_list;
+
+int8_t arm_net_frame_pool_init(void *storage, uint16_t storage_size, uint16_t frame_size)
+{
+    if (pool_base || !storage || !frame_size) {
+        return -1;
+    }
+
+    uint8_t *base = (uint8_t *)FRAME_POOL_ALIGN((uintptr_t)storage);
+    storage_size -= base - (uint8_t *)storage;
+
+    uint16_t stride = (uint16_t)FRAME_POOL_ALIGN(sizeof(arm_frame_buf_t) + FRAME_POOL_HEADROOM + frame_size);
+    uint16_t count = storage_size / stride;
+    if (count == 0) {
+        return -1;
+    }
+    if (count > INT8_MAX) {
+        count = INT8_MAX;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        arm_frame_buf_t *buf = (arm_frame_buf_t *)(base + i * stride);
+        memset(buf, 0, sizeof(arm_frame_buf_t));
+        buf->payload = (uint8_t *)buf + sizeof(arm_frame_buf_t) + FRAME_POOL_HEADROOM;
+        buf->size = frame_size;
+        buf->next = pool_free_list;
+        pool_free_list = buf;
+    }
+
+    pool_stride = stride;
+    pool_frame_size = frame_size;
+    pool_count = (uint8_t)count;
+    pool_base = base;
+    return (int8_t)count;
+}
+
+arm_frame_buf_t *arm_net_frame_pool_alloc(void)
+{
+    platform_enter_critical();
+    arm_frame_buf_t *buf = pool_free_list;
+    if (buf) {
+        pool_free_list = buf->next;
+        buf->next = NULL;
+        buf->length = 0;
+    }
+    platform_exit_critical();
+    return buf;
+}
+
+void arm_net_frame_pool_free(arm_frame_buf_t *buf)
+{
+    if (!buf) {
+        return;
+    }
+
+    platform_enter_critical();
+    buf->next = pool_free_list;
+    pool_free_list = buf;
+    platform_exit_critical();
+}
+
+arm_frame_buf_t *arm_net_frame_pool_from_payload(const uint8_t *payload)
+{
+    if (!pool_base || payload < pool_base ||
+        payload >= pool_base + (uintptr_t)pool_count * pool_stride) {
+        return NULL;
+    }
+
+    uintptr_t offset = payload - pool_base;
+    if (offset % pool_stride != sizeof(arm_frame_buf_t) + FRAME_POOL_HEADROOM) {
+        return NULL;
+    }
+
+    return (arm_frame_buf_t *)(pool_base + (offset / pool_stride) * pool_stride);
+}
+
+uint16_t arm_net_frame_pool_frame_size(void)
+{
+    return pool_frame_size;
+}
@@ -42,6 +42,7 @@
 #include <string.h>
 #include "ccmLIB.h"
 #include "platform/arm_hal_aes.h"
+#include "arm_hal_ccm.h"
 
 #ifndef CCM_USE_MUTEX
 #define arm_ccm_mutex_lock()
@@ -128,6 +129,33 @@ int8_t ccm_process_run(ccm_globals_t *ccm_params)
         goto END;
     }
 
+    /* Hand the whole packet to a hardware CCM engine when one is registered */
+    const arm_ccm_offload_driver_t *offload = arm_ccm_offload_driver_get();
+    if (offload && offload->run) {
+        arm_ccm_offload_op_t op;
+        op.sec_level = ccm_sec_level;
+        op.mode = CCM_ENCODE_MODE;
+        op.ccm_l = CCM_L_PARAM;
+        op.key = ccm_key_ptr;
+        op.nonce = ccm_params->exp_nonce;
+        op.data_ptr = ccm_params->data_ptr;
+        op.data_len = ccm_params->data_len;
+        op.adata_ptr = ccm_params->adata_ptr;
+        op.adata_len = ccm_params->adata_len;
+        op.mic = ccm_params->mic;
+        op.mic_len = ccm_params->mic_len;
+        op.done = NULL;
+        op.arg = NULL;
+        op.next = NULL;
+
+        int8_t status = offload->run(&op);
+        if (status != ARM_CCM_STATUS_UNSUPPORTED) {
+            ret_val = (status == ARM_CCM_STATUS_OK) ? 0 : -1;
+            goto END;
+        }
+        /* Driver cannot handle this combination - continue in software */
+    }
+
     if (CCM_ENCODE_MODE == AES_CCM_ENCRYPT) {
         if (ccm_params->mic_len) {
             //Calc
@@ -26,6 +26,91 @@
 
 static void entry_delete(neigh_cache_s *neigh_cache, neigh_cache_entry_s *entry);
 
+#if NEIGH_CACHE_TABLE_SIZE > 0
+
+/* Contiguous entry storage with an open-addressed hash index over the
+ * EUI-64 addresses. The index is sized to twice the entry count to keep
+ * the load factor at or below one half; linear probing, with deleted
+ * slots leaving a tombstone so later probes keep walking. */
+#define NEIGH_CACHE_HASH_SIZE (2 * NEIGH_CACHE_TABLE_SIZE)
+#define NEIGH_HASH_TOMBSTONE ((neigh_cache_entry_s *) -1)
+
+typedef struct neigh_cache_slab_s {
+    neigh_cache_entry_s entries[NEIGH_CACHE_TABLE_SIZE];
+    neigh_cache_entry_s *hash[NEIGH_CACHE_HASH_SIZE];
+    NS_LIST_HEAD(neigh_cache_entry_s, link) free;
+    uint16_t overflow_count; /* dynamically allocated entries, not in the hash */
+} neigh_cache_slab_t;
+
+static uint_fast16_t slab_hash_mac64(const uint8_t mac64[8])
+{
+    uint32_t h = common_read_32_bit(mac64) ^ common_read_32_bit(mac64 + 4);
+    return (uint_fast16_t) ((h * 0x9E3779B9u) % NEIGH_CACHE_HASH_SIZE);
+}
+
+static bool slab_contains(const neigh_cache_slab_t *slab, const neigh_cache_entry_s *entry)
+{
+    return entry >= &slab->entries[0] && entry <= &slab->entries[NEIGH_CACHE_TABLE_SIZE - 1];
+}
+
+static neigh_cache_slab_t *slab_create(void)
+{
+    neigh_cache_slab_t *slab = ns_dyn_mem_alloc(sizeof(neigh_cache_slab_t));
+    if (slab) {
+        memset(slab, 0, sizeof * slab);
+        ns_list_init(&slab->free);
+        for (int i = 0; i < NEIGH_CACHE_TABLE_SIZE; i++) {
+            ns_list_add_to_end(&slab->free, &slab->entries[i]);
+        }
+    }
+    return slab;
+}
+
+static void slab_hash_insert(neigh_cache_slab_t *slab, neigh_cache_entry_s *entry)
+{
+    uint_fast16_t i = slab_hash_mac64(entry->mac64);
+    while (slab->hash[i] && slab->hash[i] != NEIGH_HASH_TOMBSTONE) {
+        i = (i + 1) % NEIGH_CACHE_HASH_SIZE;
+    }
+    slab->hash[i] = entry;
+}
+
+static neigh_cache_entry_s *slab_hash_find(neigh_cache_slab_t *slab, const uint8_t mac64[8])
+{
+    uint_fast16_t i = slab_hash_mac64(mac64);
+    for (uint_fast16_t n = 0; n < NEIGH_CACHE_HASH_SIZE && slab->hash[i]; n++) {
+        if (slab->hash[i] != NEIGH_HASH_TOMBSTONE &&
+                memcmp(slab->hash[i]->mac64, mac64, sizeof slab->hash[i]->mac64) == 0) {
+            return slab->hash[i];
+        }
+        i = (i + 1) % NEIGH_CACHE_HASH_SIZE;
+    }
+    return NULL;
+}
+
+static void slab_hash_remove(neigh_cache_slab_t *slab, const neigh_cache_entry_s *entry)
+{
+    uint_fast16_t i = slab_hash_mac64(entry->mac64);
+    for (uint_fast16_t n = 0; n < NEIGH_CACHE_HASH_SIZE && slab->hash[i]; n++) {
+        if (slab->hash[i] == entry) {
+            if (slab->hash[(i + 1) % NEIGH_CACHE_HASH_SIZE] == NULL) {
+                /* Next slot is empty - the tombstone, and any run of
+                 * tombstones before it, can be cleared outright. */
+                do {
+                    slab->hash[i] = NULL;
+                    i = (i + NEIGH_CACHE_HASH_SIZE - 1) % NEIGH_CACHE_HASH_SIZE;
+                } while (slab->hash[i] == NEIGH_HASH_TOMBSTONE);
+            } else {
+                slab->hash[i] = NEIGH_HASH_TOMBSTONE;
+            }
+            return;
+        }
+        i = (i + 1) % NEIGH_CACHE_HASH_SIZE;
+    }
+}
+
+#endif // NEIGH_CACHE_TABLE_SIZE > 0
+
 /**
  * \brief A function to initialize a neighbor cache before use
  *
@@ -34,6 +119,13 @@ static void entry_delete(neigh_cache_s *neigh_cache, neigh_cache_entry_s *entry)
 void neighbor_cache_init(neigh_cache_s *neigh_cache)
 {
     ns_list_init(&neigh_cache->head);
+#if NEIGH_CACHE_TABLE_SIZE > 0
+    /* If the slab cannot be allocated, the cache falls back to dynamic
+     * allocation and list scanning throughout its lifetime. */
+    neigh_cache->slab = slab_create();
+#else
+    neigh_cache->slab = NULL;
+#endif
 }
 
 /**
@@ -75,7 +167,18 @@ static neigh_cache_entry_s *entry_get(neigh_cache_s *neigh_cache, neighbor_addre
         mac16 = common_read_16_bit(address_ptr);
     }
 
-    ns_list_foreach(neigh_cache_entry_s, e, &neigh_cache->head) {
+#if NEIGH_CACHE_TABLE_SIZE > 0
+    /* EUI-64 lookups are served by the hash index; the list is scanned
+     * only when overflow entries outside the slab exist. */
+    if (address_type == NEIGH_64_BIT_ADDRESS && neigh_cache->slab) {
+        entry = slab_hash_find(neigh_cache->slab, address_ptr);
+        if (!entry && neigh_cache->slab->overflow_count == 0) {
+            return NULL;
+        }
+    }
+#endif
+
+    if (!entry) ns_list_foreach(neigh_cache_entry_s, e, &neigh_cache->head) {
         bool match = false;
         switch (address_type) {
             case NEIGH_64_BIT_ADDRESS:
@@ -145,7 +248,24 @@ neigh_cache_entry_s *neighbor_cache_entry_create(neigh_cache_s *neigh_cache, con
         return entry;
     }
 
+#if NEIGH_CACHE_TABLE_SIZE > 0
+    if (neigh_cache->slab) {
+        entry = ns_list_get_first(&neigh_cache->slab->free);
+        if (entry) {
+            ns_list_remove(&neigh_cache->slab->free, entry);
+        } else {
+            /* Slab full - overflow to a dynamically allocated entry */
+            entry = ns_dyn_mem_alloc(sizeof * entry);
+            if (entry) {
+                neigh_cache->slab->overflow_count++;
+            }
+        }
+    } else {
+        entry = ns_dyn_mem_alloc(sizeof * entry);
+    }
+#else
     entry = ns_dyn_mem_alloc(sizeof * entry);
+#endif
     if (!entry) {
         return NULL;
     }
@@ -155,6 +275,11 @@ neigh_cache_entry_s *neighbor_cache_entry_create(neigh_cache_s *neigh_cache, con
     entry->mac16 = 0xFFFF;
     entry->neighbor_keypair_info = NULL;
     ns_list_add_to_start(&neigh_cache->head, entry);
+#if NEIGH_CACHE_TABLE_SIZE > 0
+    if (neigh_cache->slab && slab_contains(neigh_cache->slab, entry)) {
+        slab_hash_insert(neigh_cache->slab, entry);
+    }
+#endif
 
     return entry;
 }
@@ -171,6 +296,18 @@ static void entry_delete(neigh_cache_s *neigh_cache, neigh_cache_entry_s *entry)
     if (entry->neighbor_keypair_info) {
         ns_dyn_mem_free(entry->neighbor_keypair_info);
     }
+#if NEIGH_CACHE_TABLE_SIZE > 0
+    if (neigh_cache->slab) {
+        if (slab_contains(neigh_cache->slab, entry)) {
+            slab_hash_remove(neigh_cache->slab, entry);
+            ns_list_add_to_start(&neigh_cache->slab->free, entry);
+            return;
+        }
+        if (neigh_cache->slab->overflow_count) {
+            neigh_cache->slab->overflow_count--;
+        }
+    }
+#endif
     ns_dyn_mem_free(entry);
 }
 
@@ -30,6 +30,19 @@
 
 #include "ns_list.h"
 
+/*
+ * Number of neighbour entries stored in a contiguous, EUI-64-hashed table
+ * for O(1) lookup and fragmentation-free storage. Additional neighbours
+ * fall back to dynamically allocated, list-scanned entries. Exposed as
+ * mbed-mesh-api configuration option "neighbour-cache-table-size"; when
+ * unset the cache uses dynamic allocation only, as before.
+ */
+#ifdef MBED_CONF_MBED_MESH_API_NEIGHBOUR_CACHE_TABLE_SIZE
+#define NEIGH_CACHE_TABLE_SIZE                  MBED_CONF_MBED_MESH_API_NEIGHBOUR_CACHE_TABLE_SIZE
+#else
+#define NEIGH_CACHE_TABLE_SIZE                  0
+#endif
+
 #define NEIGH_LQI_DEFAULT_SAMPLE                16
 
 #define NEIGH_LINK_REQUEST_COUNTER              3
@@ -155,6 +168,7 @@ typedef struct neigh_cache_entry_s {
  */
 typedef struct neigh_cache_s {
     NS_LIST_HEAD(neigh_cache_entry_s, link) head;
+    struct neigh_cache_slab_s *slab; /*!< Contiguous entry storage and hash index, allocated on first use */
 } neigh_cache_s;
 
 /**
@@ -22,6 +22,9 @@
 #include "ns_types.h"
 #include "platform/arm_hal_interrupt.h"
 #include "nanostack/platform/arm_hal_phy.h"
+#ifdef MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE
+#include "nanostack/platform/arm_hal_frame_pool.h"
+#endif
 #include "mbed_toolchain.h"
 
 #include "mbed-trace/mbed_trace.h"
@@ -78,7 +81,14 @@ static osThreadDef(rf_thread_loop, osPriorityRealtime, RF_THREAD_STACK_SIZE);
 static osThreadId rf_thread_id = 0;
 
 /* Queue for passing messages from interrupt to adaptor thread */
+#ifdef MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE
+/* Frames are received into buffers of the shared radio frame pool and the
+ * MAC adopts them without a copy; the queue carries the buffer pointers */
+static uint32_t rx_frame_pool_storage[MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE / sizeof(uint32_t)];
+static arm_frame_buf_t * volatile rx_queue[RF_QUEUE_SIZE];
+#else
 static volatile uint8_t rx_queue[RF_QUEUE_SIZE][MAC_PACKET_MAX_LENGTH + MAC_PACKET_INFO_LENGTH];
+#endif
 static volatile size_t rx_queue_head = 0;
 static volatile size_t rx_queue_tail = 0;
 
@@ -276,6 +286,19 @@ static void rf_thread_loop(const void *arg)
 
         if (event.value.signals & SL_RX_DONE) {
             while(rx_queue_tail != rx_queue_head) {
+#ifdef MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE
+                arm_frame_buf_t* frame = rx_queue[rx_queue_tail];
+                SL_DEBUG_PRINT("rPKT %d\n", frame->length);
+                if (device_driver.phy_rx_cb(
+                        frame->payload,
+                        frame->length,
+                        frame->lqi,
+                        frame->dbm,
+                        rf_radio_driver_id) < 0) {
+                    /* The stack did not take the frame */
+                    arm_net_frame_pool_free(frame);
+                }
+#else
                 uint8_t* packet = (uint8_t*) rx_queue[rx_queue_tail];
                 SL_DEBUG_PRINT("rPKT %d\n", packet[MAC_PACKET_INFO_LENGTH] - 2);
                 device_driver.phy_rx_cb(
@@ -284,6 +307,7 @@ static void rf_thread_loop(const void *arg)
                         packet[MAC_PACKET_OFFSET_LQI], /* LQI in second byte */
                         packet[MAC_PACKET_OFFSET_RSSI], /* RSSI in first byte */
                         rf_radio_driver_id);
+#endif
                 rx_queue_tail = (rx_queue_tail + 1) % RF_QUEUE_SIZE;
             }
 
@@ -458,6 +482,12 @@ static int8_t rf_device_register(void)
     device_driver.arm_net_virtual_rx_cb = NULL;
     device_driver.arm_net_virtual_tx_cb = NULL;
 
+#ifdef MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE
+    /*Hand the shared frame pool its storage; the MAC adopts frames from it
+      without a copy*/
+    arm_net_frame_pool_init(rx_frame_pool_storage, sizeof(rx_frame_pool_storage), MAC_PACKET_MAX_LENGTH);
+#endif
+
     /*Register device driver*/
     rf_radio_driver_id = arm_net_phy_register(&device_driver);
 
@@ -998,6 +1028,46 @@ static void radioEventHandler(RAIL_Handle_t railHandle,
                             rxPacketDetails.timeReceived.totalPacketBytes = 0;
                             RAIL_GetRxPacketDetails(gRailHandle, rxHandle, &rxPacketDetails);
 
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE)
+                            /* Drop this packet if we're out of space */
+                            if (((rx_queue_head + 1) % RF_QUEUE_SIZE) == rx_queue_tail) {
+                                osSignalSet(rf_thread_id, SL_QUEUE_FULL);
+                                RAIL_ReleaseRxPacket(gRailHandle, rxHandle);
+                                break;
+                            }
+
+                            /* Receive into a shared pool buffer the MAC can
+                             * adopt without a copy */
+                            arm_frame_buf_t* frame = arm_net_frame_pool_alloc();
+                            if (frame == NULL) {
+                                osSignalSet(rf_thread_id, SL_QUEUE_FULL);
+                                RAIL_ReleaseRxPacket(gRailHandle, rxHandle);
+                                break;
+                            }
+
+                            frame->dbm = (int8_t)rxPacketDetails.rssi;
+                            frame->lqi = (uint8_t)rxPacketDetails.lqi;
+
+                            /* First packet byte is the PHY length field; data
+                             * for Nanostack starts at the FCS right after it
+                             * and excludes the two CRC bytes */
+                            uint8_t phy_length;
+                            RAIL_PeekRxPacket(gRailHandle, rxHandle, &phy_length, 1, 0);
+                            frame->length = phy_length - 2;
+                            RAIL_PeekRxPacket(gRailHandle, rxHandle, frame->payload, frame->length, 1);
+
+                            /* Release RAIL resources early */
+                            RAIL_ReleaseRxPacket(gRailHandle, rxHandle);
+
+                            /* Cancel the ACK if the sender did not request one */
+                            if( (frame->payload[0] & (1 << 5)) == 0 ) {
+                                RAIL_CancelAutoAck(gRailHandle);
+                            }
+
+                            rx_queue[rx_queue_head] = frame;
+                            rx_queue_head = (rx_queue_head + 1) % RF_QUEUE_SIZE;
+                            osSignalSet(rf_thread_id, SL_RX_DONE);
+#else
 #ifdef MBED_CONF_RTOS_PRESENT
                             /* Drop this packet if we're out of space */
                             if (((rx_queue_head + 1) % RF_QUEUE_SIZE) == rx_queue_tail) {
@@ -1046,6 +1116,7 @@ static void radioEventHandler(RAIL_Handle_t railHandle,
                                                     packetBuffer[MAC_PACKET_OFFSET_RSSI], /* RSSI in first byte */
                                                     rf_radio_driver_id);
 #endif
+#endif /* MBED_CONF_RTOS_PRESENT && MBED_CONF_NANOSTACK_HAL_FRAME_POOL_SIZE */
                         }
                     }
                 }
@@ -72,6 +72,84 @@ public:
      */
     virtual uint32_t get_align_preference() const = 0;
 
+    /**
+     * Checksum capability flags
+     *
+     * Advertised by get_checksum_capabilities() for checksums the hardware
+     * generates on transmitted frames or verifies on received frames, so the
+     * IP stack can skip computing them in software.
+     */
+    enum ChecksumCapability {
+        CKSUM_GEN_IP     = 0x0001, /**< Generates IPv4 header checksum on transmit */
+        CKSUM_GEN_UDP    = 0x0002, /**< Generates UDP checksum on transmit */
+        CKSUM_GEN_TCP    = 0x0004, /**< Generates TCP checksum on transmit */
+        CKSUM_GEN_ICMP   = 0x0008, /**< Generates ICMP checksum on transmit */
+        CKSUM_CHECK_IP   = 0x0100, /**< Verifies IPv4 header checksum on receive */
+        CKSUM_CHECK_UDP  = 0x0200, /**< Verifies UDP checksum on receive */
+        CKSUM_CHECK_TCP  = 0x0400, /**< Verifies TCP checksum on receive */
+        CKSUM_CHECK_ICMP = 0x0800  /**< Verifies ICMP checksum on receive */
+    };
+
+    /**
+     * Return the checksums offloaded by the hardware
+     *
+     * A MAC that verifies receive checksums must drop frames that fail the
+     * check before passing them up, as the stack will not re-check them.
+     * Defaults to no offloads, so existing drivers keep software checksums.
+     *
+     * @return     Bitmask of ChecksumCapability flags
+     */
+    virtual uint32_t get_checksum_capabilities() const
+    {
+        return 0;
+    }
+
+    /**
+     * Descriptor ring and interrupt moderation configuration
+     *
+     * Lets the application trade RAM for interrupt load: deeper rings
+     * absorb bursts without drops, and coalescing settings reduce the
+     * one-interrupt-per-frame load that dominates CPU use at high line
+     * rates.
+     */
+    struct ring_config_t {
+        uint32_t rx_ring_len;       /**< Number of RX descriptors/buffers */
+        uint32_t tx_ring_len;       /**< Number of TX descriptors */
+        uint32_t rx_frames_per_irq; /**< RX frames accumulated before an interrupt, 1 for an interrupt per frame */
+        uint32_t rx_irq_delay_us;   /**< Max time a coalesced RX interrupt is held back, 0 for none */
+        uint32_t rx_burst_limit;    /**< Max frames passed to the stack per wakeup, 0 for no limit */
+    };
+
+    /**
+     * Return the active descriptor ring configuration
+     *
+     * @param config Structure to fill in
+     * @return       True if the driver supports ring configuration
+     */
+    virtual bool get_ring_config(ring_config_t &config) const
+    {
+        return false;
+    }
+
+    /**
+     * Set the descriptor ring configuration
+     *
+     * Must be called before power_up(). Drivers clamp each field to the
+     * nearest value the hardware supports - in particular a MAC without
+     * interrupt moderation clamps rx_frames_per_irq to 1 - and report
+     * the values actually in effect through get_ring_config(). The
+     * default implementation rejects the call, so existing drivers keep
+     * their hardcoded rings.
+     *
+     * @param config Requested configuration
+     * @return       True if accepted (possibly clamped), false if
+     *               unsupported or the driver is already powered up
+     */
+    virtual bool set_ring_config(const ring_config_t &config)
+    {
+        return false;
+    }
+
     /**
      * Return interface name
      *
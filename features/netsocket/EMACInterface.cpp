@@ -111,6 +111,24 @@ const char *EMACInterface::get_gateway()
     return 0;
 }
 
+nsapi_error_t EMACInterface::get_stats(nsapi_interface_stats_t *stats)
+{
+    if (!_interface) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    return _interface->get_stats(stats);
+}
+
+char *EMACInterface::get_interface_name(char *interface_name)
+{
+    if (_interface) {
+        return _interface->get_interface_name(interface_name);
+    }
+
+    return 0;
+}
+
 NetworkStack *EMACInterface::get_stack()
 {
     return &_stack;
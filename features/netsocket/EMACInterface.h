@@ -121,6 +121,23 @@ public:
      */
     virtual const char *get_gateway();
 
+    /** Read link-level traffic counters of the interface
+     *
+     *  Stacks without counter support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t get_stats(nsapi_interface_stats_t *stats);
+
+    /** Get the name the underlying stack knows the interface by
+     *
+     *  @param interface_name Destination buffer of at least
+     *                        NSAPI_INTERFACE_NAME_SIZE bytes
+     *  @return               Pointer to the buffer, or null if unavailable
+     */
+    virtual char *get_interface_name(char *interface_name);
+
     /** Register callback for status reporting
      *
      *  @param status_cb The callback for status changes
@@ -14,6 +14,67 @@
  */
 
 #include "EMACMemoryManager.h"
+#include "hal/dma_api.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include "rtos/Semaphore.h"
+
+#if MBED_CONF_NSAPI_EMAC_DMA_COPY_THRESHOLD > 0
+
+static SingletonPtr<PlatformMutex> dma_copy_mutex;
+static int dma_copy_channel = DMA_ERROR_OUT_OF_CHANNELS;
+static bool dma_copy_channel_tried = false;
+
+static void dma_copy_done(void *context)
+{
+    static_cast<rtos::Semaphore *>(context)->release();
+}
+
+#endif
+
+void EMACMemoryManager::copy_mem(void *to_ptr, const void *from_ptr, uint32_t len)
+{
+#if MBED_CONF_NSAPI_EMAC_DMA_COPY_THRESHOLD > 0
+    if (len >= MBED_CONF_NSAPI_EMAC_DMA_COPY_THRESHOLD) {
+        dma_copy_mutex->lock();
+        if (!dma_copy_channel_tried) {
+            dma_copy_channel = dma_channel_allocate(0);
+            dma_copy_channel_tried = true;
+        }
+        if (dma_copy_channel >= 0) {
+            rtos::Semaphore done(0, 1);
+            dma_transfer_t transfer;
+            transfer.source = from_ptr;
+            transfer.destination = to_ptr;
+            transfer.length = len;
+            // Word transfers when everything is aligned, else byte transfers
+            if ((((uint32_t)(uintptr_t) to_ptr | (uint32_t)(uintptr_t) from_ptr | len) & 3) == 0) {
+                transfer.word_size = 4;
+            } else {
+                transfer.word_size = 1;
+            }
+            transfer.source_inc = true;
+            transfer.destination_inc = true;
+            if (dma_transfer_start(dma_copy_channel, &transfer, dma_copy_done, &done) == 0) {
+                done.wait();
+                dma_copy_mutex->unlock();
+                return;
+            }
+        }
+        dma_copy_mutex->unlock();
+    }
+#endif
+    memcpy(to_ptr, from_ptr, len);
+}
+
+emac_mem_buf_t *EMACMemoryManager::alloc_pool_contiguous(uint32_t size, uint32_t align)
+{
+    if (size > get_pool_alloc_unit(align)) {
+        return NULL;
+    }
+
+    return alloc_pool(size, align);
+}
 
 void EMACMemoryManager::copy_to_buf(emac_mem_buf_t *to_buf, const void *ptr, uint32_t len)
 {
@@ -28,7 +89,7 @@ void EMACMemoryManager::copy_to_buf(emac_mem_buf_t *to_buf, const void *ptr, uin
             len -= copy_to_len;
         }
 
-        memcpy(copy_to_ptr, ptr, copy_to_len);
+        copy_mem(copy_to_ptr, ptr, copy_to_len);
         ptr = static_cast<const uint8_t *>(ptr) + copy_to_len;
 
         to_buf = get_next(to_buf);
@@ -50,7 +111,7 @@ uint32_t EMACMemoryManager::copy_from_buf(void *ptr, uint32_t len, const emac_me
             len -= copy_from_len;
         }
 
-        memcpy(ptr, copy_from_ptr, copy_from_len);
+        copy_mem(ptr, copy_from_ptr, copy_from_len);
         ptr = static_cast<uint8_t *>(ptr) + copy_from_len;
         copied_len += copy_from_len;
 
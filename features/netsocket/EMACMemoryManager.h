@@ -34,6 +34,14 @@
  * On Emac interface buffer chain ownership is transferred. Emac must free buffer chain that it is given for
  * link output and the stack must free the buffer chain that it is given for link input.
  *
+ * Zero-copy receive: an Emac that can make its receive DMA write directly into stack-owned memory should
+ * pre-allocate its descriptor buffers with alloc_pool_contiguous(), using get_pool_alloc_unit() to negotiate
+ * whether a maximum-size frame plus its own padding fits one contiguous allocation. On reception the Emac
+ * sets the received length with set_len(), passes the buffer up through link input - transferring ownership
+ * to the stack, which frees it - and refills the descriptor with a fresh pool allocation. No frame data is
+ * copied on this path. If alloc_pool_contiguous() declines the requested size, the Emac must fall back to
+ * alloc_heap() buffers or to copying out of its own DMA memory.
+ *
  */
 
 #include "nsapi.h"
@@ -67,6 +75,20 @@ public:
      */
     virtual emac_mem_buf_t *alloc_pool(uint32_t size, uint32_t align) = 0;
 
+    /**
+     * Allocates a contiguous memory buffer from a pool
+     *
+     * Like alloc_pool, but never returns a chained buffer: the allocation is
+     * a single buffer the caller may hand to a DMA engine. Returns NULL if
+     * the pool's allocation unit cannot fit the requested size with the given
+     * alignment - check get_pool_alloc_unit to negotiate a size that fits.
+     *
+     * @param  size    Size of the memory to allocate in bytes
+     * @param  align   Memory alignment requirement in bytes
+     * @return         Allocated contiguous memory buffer, or NULL in case of error
+     */
+    virtual emac_mem_buf_t *alloc_pool_contiguous(uint32_t size, uint32_t align);
+
     /**
      * Get memory buffer pool allocation unit
      *
@@ -181,6 +203,21 @@ public:
      * @param len      Payload size, must be less or equal allocated size
      */
     virtual void set_len(emac_mem_buf_t *buf, uint32_t len) = 0;
+
+protected:
+    /**
+     * Copy a contiguous block of memory
+     *
+     * Equivalent to memcpy, but blocks at or above the nsapi.emac-dma-copy-threshold
+     * configuration value are routed through a DMA channel (see hal/dma_api.h),
+     * freeing the core for other threads during the copy. The default copy_to_buf
+     * and copy_from_buf use this; stack-specific copy implementations should too.
+     *
+     * @param to_ptr   Pointer to copy to
+     * @param from_ptr Pointer to copy from
+     * @param len      Data length
+     */
+    static void copy_mem(void *to_ptr, const void *from_ptr, uint32_t len);
 };
 
 #endif /* EMAC_MEMORY_MANAGER_H */
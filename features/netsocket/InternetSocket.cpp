@@ -15,7 +15,10 @@
  */
 
 #include "InternetSocket.h"
+#include "netsocket/NetworkInterface.h"
 #include "platform/Callback.h"
+#include "mbed_assert.h"
+#include <string.h>
 
 using namespace mbed;
 
@@ -24,6 +27,10 @@ InternetSocket::InternetSocket()
       _readers(0), _writers(0), _factory_allocated(false),
       _pending(0)
 {
+#if MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES
+    _failover_count = 0;
+    _failover_active = NULL;
+#endif
 }
 
 nsapi_error_t InternetSocket::open(NetworkStack *stack)
@@ -55,6 +62,14 @@ nsapi_error_t InternetSocket::close()
 {
     _lock.lock();
 
+#if MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES
+    for (int i = 0; i < _failover_count; i++) {
+        _failover[i].iface->attach(Callback<void(nsapi_event_t, intptr_t)>());
+    }
+    _failover_count = 0;
+    _failover_active = NULL;
+#endif
+
     nsapi_error_t ret = NSAPI_ERROR_OK;
     if (_socket) {
         _stack->socket_attach(_socket, 0, 0);
@@ -106,6 +121,119 @@ int InternetSocket::leave_multicast_group(const SocketAddress &address)
 }
 
 
+nsapi_size_or_error_t InternetSocket::sendmsg(const nsapi_iovec_t *iov, int iovcnt)
+{
+    return do_sendmsg(NULL, iov, iovcnt);
+}
+
+nsapi_size_or_error_t InternetSocket::sendmsg(const SocketAddress &address, const nsapi_iovec_t *iov, int iovcnt)
+{
+    return do_sendmsg(&address, iov, iovcnt);
+}
+
+nsapi_size_or_error_t InternetSocket::do_sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, int iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_sendmsg(_socket, address, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetSocket::recvmsg(const nsapi_iovec_t *iov, int iovcnt)
+{
+    return do_recvmsg(NULL, iov, iovcnt);
+}
+
+nsapi_size_or_error_t InternetSocket::recvmsg(SocketAddress *address, const nsapi_iovec_t *iov, int iovcnt)
+{
+    return do_recvmsg(address, iov, iovcnt);
+}
+
+nsapi_size_or_error_t InternetSocket::do_recvmsg(SocketAddress *address, const nsapi_iovec_t *iov, int iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_recvmsg(_socket, address, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_error_t InternetSocket::bind(uint16_t port)
 {
     // Underlying bind is thread safe
@@ -135,6 +263,109 @@ nsapi_error_t InternetSocket::bind(const SocketAddress &address)
     return ret;
 }
 
+nsapi_error_t InternetSocket::bind_to_interface(const char *name)
+{
+    if (!name) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // InternetSocket::setsockopt is thread safe
+    return setsockopt(NSAPI_SOCKET, NSAPI_BIND_TO_DEVICE, name, strlen(name) + 1);
+}
+
+nsapi_error_t InternetSocket::bind_to_interface(NetworkInterface *interface)
+{
+    char name[NSAPI_INTERFACE_NAME_SIZE];
+
+    if (!interface) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (!interface->get_interface_name(name)) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    return bind_to_interface(name);
+}
+
+#if MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES
+nsapi_error_t InternetSocket::set_failover(NetworkInterface *const *interfaces, int count,
+                                           Callback<void(NetworkInterface *)> callback)
+{
+    if (count < 0 || count > MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES ||
+        (count > 0 && !interfaces)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _lock.lock();
+
+    for (int i = 0; i < _failover_count; i++) {
+        _failover[i].iface->attach(Callback<void(nsapi_event_t, intptr_t)>());
+    }
+
+    _failover_count = count;
+    _failover_callback = callback;
+    _failover_active = NULL;
+
+    for (int i = 0; i < count; i++) {
+        _failover[i].iface = interfaces[i];
+        _failover[i].socket = this;
+        interfaces[i]->attach(mbed::callback(&InternetSocket::failover_event, &_failover[i]));
+    }
+
+    _lock.unlock();
+
+    if (count > 0) {
+        failover_update();
+    }
+    return NSAPI_ERROR_OK;
+}
+
+void InternetSocket::failover_event(failover_entry *entry, nsapi_event_t event, intptr_t status)
+{
+    (void) status;
+    if (event == NSAPI_EVENT_CONNECTION_STATUS_CHANGE) {
+        entry->socket->failover_update();
+    }
+}
+
+void InternetSocket::failover_update()
+{
+    // May run from the stack's own thread, so the socket lock is not
+    // taken - only the stack-side binding is touched, which the stack
+    // serializes itself
+    NetworkInterface *best = NULL;
+    int best_health = 0;
+
+    for (int i = 0; i < _failover_count; i++) {
+        int health = _failover[i].iface->get_health();
+        if (health > best_health) {
+            best = _failover[i].iface;
+            best_health = health;
+        }
+    }
+
+    if (best == _failover_active) {
+        return;
+    }
+    _failover_active = best;
+
+    if (best && _stack && _socket) {
+        char name[NSAPI_INTERFACE_NAME_SIZE];
+        if (best->get_interface_name(name)) {
+            // Rebinds a datagram socket in place; a stream socket keeps
+            // its current connection and picks the binding up when the
+            // application reconnects from the callback
+            _stack->setsockopt(_socket, NSAPI_SOCKET, NSAPI_BIND_TO_DEVICE,
+                               name, strlen(name) + 1);
+        }
+    }
+
+    if (_failover_callback) {
+        _failover_callback(best);
+    }
+}
+#endif
+
 void InternetSocket::set_blocking(bool blocking)
 {
     // InternetSocket::set_timeout is thread safe
@@ -169,6 +400,21 @@ nsapi_error_t InternetSocket::setsockopt(int level, int optname, const void *opt
     return ret;
 }
 
+nsapi_error_t InternetSocket::get_stats(nsapi_socket_stats_t *stats)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        ret = _stack->socket_stats(_socket, stats);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_error_t InternetSocket::getsockopt(int level, int optname, void *optval, unsigned *optlen)
 {
     _lock.lock();
@@ -27,6 +27,8 @@
 #include "Callback.h"
 #include "mbed_toolchain.h"
 
+class NetworkInterface;
+
 /** Socket implementation that uses IP network stack.
  * Not to be directly used by applications. Cannot be directly instantiated.
  */
@@ -77,6 +79,85 @@ public:
      */
     int leave_multicast_group(const SocketAddress &address);
 
+    /** Send a scatter-gather list of buffers as one message
+     *
+     *  Gathers the iov elements in order into a single stream write or
+     *  datagram, so a frame built from separate header, payload and trailer
+     *  buffers does not have to be copied into a staging buffer first. On a
+     *  stream socket the message may be partially sent and the number of
+     *  bytes actually sent is returned; on a datagram socket the message
+     *  goes out as one packet.
+     *
+     *  By default, sendmsg blocks until at least some data is sent. If socket
+     *  is set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is
+     *  returned if nothing could be sent.
+     *
+     *  Stacks without a vectored send path return NSAPI_ERROR_UNSUPPORTED;
+     *  fall back to send()/sendto() in that case.
+     *
+     *  @param iov      Scatter-gather list of buffers to send
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendmsg(const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Send a scatter-gather list of buffers as one message to a remote host
+     *
+     *  As sendmsg(iov, iovcnt), addressed to the given remote host.
+     *
+     *  @param address  The SocketAddress of the remote host
+     *  @param iov      Scatter-gather list of buffers to send
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendmsg(const SocketAddress &address, const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Receive a message into a scatter-gather list of buffers
+     *
+     *  Fills the iov elements in order with received data, equivalent to
+     *  recvmsg(NULL, iov, iovcnt).
+     *
+     *  By default, recvmsg blocks until some data is received. If socket is
+     *  set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be
+     *  returned to indicate no data.
+     *
+     *  Stacks without a vectored receive path return NSAPI_ERROR_UNSUPPORTED;
+     *  fall back to recv()/recvfrom() in that case.
+     *
+     *  @param iov      Scatter-gather list of buffers to fill
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t recvmsg(const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Receive a message into a scatter-gather list of buffers
+     *
+     *  As recvmsg(iov, iovcnt), storing the source address in address if it
+     *  is not NULL.
+     *
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Scatter-gather list of buffers to fill
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t recvmsg(SocketAddress *address, const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Read traffic counters of the socket
+     *
+     *  Returns the socket's cumulative traffic counters. Counters are
+     *  maintained on the data path and the read is O(1), so the call is
+     *  cheap enough to poll in production.
+     *
+     *  Stacks without counter support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t get_stats(nsapi_socket_stats_t *stats);
 
     /** Bind a specific address to a socket
      *
@@ -109,6 +190,60 @@ public:
      */
     virtual nsapi_error_t bind(const SocketAddress &address);
 
+    /** Bind the socket's traffic to a network interface
+     *
+     *  On a multi-homed device, routes all of the socket's traffic through
+     *  the named interface instead of whichever interface the destination's
+     *  route selects. The name is the stack's, as returned by
+     *  NetworkInterface::get_interface_name(). A stream socket must be
+     *  bound before it connects.
+     *
+     *  @param name     Stack-assigned interface name, e.g. "en0"
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t bind_to_interface(const char *name);
+
+    /** Bind the socket's traffic to a network interface
+     *
+     *  As bind_to_interface(name), taking the interface itself.
+     *
+     *  @param interface Interface to route the socket's traffic through
+     *  @return          0 on success, negative error code on failure
+     */
+    nsapi_error_t bind_to_interface(NetworkInterface *interface);
+
+#if MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES || defined(DOXYGEN_ONLY)
+    /** Keep the socket bound to the healthiest of a set of interfaces
+     *
+     *  The candidates are listed in order of preference; the socket binds
+     *  to the healthiest one (NetworkInterface::get_health(), earlier
+     *  entries win ties) and re-evaluates the choice on every connection
+     *  status change, registering its own status callback on each
+     *  candidate - replacing any callback the application had attached
+     *  to them. So with Ethernet listed before cellular, traffic moves
+     *  to cellular only while Ethernet is down.
+     *
+     *  When the selection changes, a datagram socket is rebound in place;
+     *  a stream socket keeps its current connection and picks the new
+     *  binding up when the application reconnects. Either way the given
+     *  callback fires with the newly selected interface, or NULL when no
+     *  candidate is healthy.
+     *
+     *  The callback may be called from the stack's own context and should
+     *  not perform blocking operations such as connect or send - defer
+     *  reconnection to an application thread or event queue.
+     *
+     *  @param interfaces Candidate interfaces in order of preference
+     *  @param count      Number of candidates, up to
+     *                    nsapi.socket-failover-max-interfaces; 0 stops
+     *                    monitoring
+     *  @param callback   Function to call when the selection changes
+     *  @return           0 on success, negative error code on failure
+     */
+    nsapi_error_t set_failover(NetworkInterface *const *interfaces, int count,
+                               mbed::Callback<void(NetworkInterface *)> callback);
+#endif
+
     /** Set blocking or non-blocking mode of the socket
      *
      *  Initially all sockets are in blocking mode. In non-blocking mode
@@ -220,6 +355,17 @@ protected:
     virtual nsapi_protocol_t get_proto() = 0;
     virtual void event();
     int modify_multicast_group(const SocketAddress &address, nsapi_socket_option_t socketopt);
+    nsapi_size_or_error_t do_sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, int iovcnt);
+    nsapi_size_or_error_t do_recvmsg(SocketAddress *address, const nsapi_iovec_t *iov, int iovcnt);
+
+#if MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES
+    struct failover_entry {
+        NetworkInterface *iface;
+        InternetSocket *socket;
+    };
+    static void failover_event(failover_entry *entry, nsapi_event_t event, intptr_t status);
+    void failover_update();
+#endif
 
     NetworkStack *_stack;
     nsapi_socket_t _socket;
@@ -234,6 +380,13 @@ protected:
     volatile unsigned _pending;
     bool _factory_allocated;
 
+#if MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES
+    failover_entry _failover[MBED_CONF_NSAPI_SOCKET_FAILOVER_MAX_INTERFACES];
+    int _failover_count;
+    NetworkInterface *_failover_active;
+    mbed::Callback<void(NetworkInterface *)> _failover_callback;
+#endif
+
     // Event flags
     static const int READ_FLAG     = 0x1u;
     static const int WRITE_FLAG    = 0x2u;
@@ -19,6 +19,11 @@
 #include <string.h>
 
 
+NetworkInterface::NetworkInterface()
+    : _probe_id(-1)
+{
+}
+
 // Default network-interface state
 const char *NetworkInterface::get_mac_address()
 {
@@ -30,6 +35,75 @@ const char *NetworkInterface::get_ip_address()
     return 0;
 }
 
+char *NetworkInterface::get_interface_name(char *interface_name)
+{
+    return 0;
+}
+
+int NetworkInterface::get_health()
+{
+    switch (get_connection_status()) {
+        case NSAPI_STATUS_GLOBAL_UP:
+            break;
+        case NSAPI_STATUS_LOCAL_UP:
+            return 50;
+        case NSAPI_STATUS_CONNECTING:
+            return 10;
+        default:
+            return 0;
+    }
+
+    // With a link probe running, derate full health by the probe's loss
+    // rate, so a path that is up but degraded ranks below a clean one
+    nsapi_ping_stats_t stats;
+    if (_probe_id >= 0 && link_probe_stats(&stats) == NSAPI_ERROR_OK && stats.sent >= 4) {
+        uint32_t lost = stats.sent - stats.received;
+        return 100 - (int)((lost * 50) / stats.sent);
+    }
+
+    return 100;
+}
+
+nsapi_error_t NetworkInterface::ping_async(const SocketAddress &address, uint32_t timeout, ping_cb_t callback)
+{
+    return get_stack()->ping_async(address, timeout, callback);
+}
+
+nsapi_error_t NetworkInterface::link_probe_start(const SocketAddress &address, uint32_t interval)
+{
+    if (_probe_id >= 0) {
+        return NSAPI_ERROR_IN_PROGRESS;
+    }
+
+    nsapi_value_or_error_t id = get_stack()->probe_start(address, interval);
+    if (id < 0) {
+        return id;
+    }
+
+    _probe_id = id;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t NetworkInterface::link_probe_stop()
+{
+    if (_probe_id < 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nsapi_error_t err = get_stack()->probe_stop(_probe_id);
+    _probe_id = -1;
+    return err;
+}
+
+nsapi_error_t NetworkInterface::link_probe_stats(nsapi_ping_stats_t *stats)
+{
+    if (_probe_id < 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    return get_stack()->probe_stats(_probe_id, stats);
+}
+
 const char *NetworkInterface::get_netmask()
 {
     return 0;
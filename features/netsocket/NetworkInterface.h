@@ -90,6 +90,90 @@ public:
      */
     virtual const char *get_mac_address();
 
+    /** Get the name the underlying stack knows the interface by
+     *
+     *  The name can be passed to the NSAPI_BIND_TO_DEVICE socket option
+     *  to pin a socket's traffic to this interface.
+     *
+     *  @param interface_name Destination buffer of at least
+     *                        NSAPI_INTERFACE_NAME_SIZE bytes
+     *  @return               Pointer to the buffer, or null if the stack
+     *                        does not name its interfaces
+     */
+    virtual char *get_interface_name(char *interface_name);
+
+    /** Get a health score for the interface
+     *
+     *  Returns a coarse 0-100 score usable to rank interfaces on a
+     *  multi-homed device: 0 when disconnected, rising through connecting
+     *  and local connectivity to 100 with full global connectivity. The
+     *  default is derived from get_connection_status(); interfaces with
+     *  better knowledge of their link (signal strength, registration
+     *  state) may refine it.
+     *
+     *  @return         Health score, higher is healthier
+     */
+    virtual int get_health();
+
+    /** Ping result callback
+     *
+     *  Called with the echo round-trip time in milliseconds on success,
+     *  or a negative error code on timeout or failure.
+     *
+     *  The callback may be called from the stack's own context and should
+     *  not perform expensive operations such as socket recv/send calls or
+     *  blocking operations.
+     *
+     *  @param rtt_ms  Round-trip time in milliseconds, or negative error code
+     */
+    typedef mbed::Callback<void (nsapi_value_or_error_t rtt_ms)> ping_cb_t;
+
+    /** Send an ICMP echo request to a host (asynchronous)
+     *
+     *  Call is non-blocking; the result is delivered through the callback.
+     *  If this function returns failure, the callback will not be called.
+     *
+     *  Stacks without echo support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param address  The SocketAddress of the host to probe
+     *  @param timeout  Time in milliseconds to wait for the reply
+     *  @param callback Callback that is called with the result
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t ping_async(const SocketAddress &address, uint32_t timeout, ping_cb_t callback);
+
+    /** Start a periodic background link probe
+     *
+     *  Sends an ICMP echo to the given host every interval milliseconds
+     *  and accumulates the results, readable with link_probe_stats().
+     *  While the probe runs, its loss rate derates get_health(), so
+     *  interface failover reacts to paths that are up but degraded. One
+     *  probe per interface; a probe at a few-second interval (0.1 Hz)
+     *  costs one raw pcb and one small frame per interval, cheap enough
+     *  to leave running in production.
+     *
+     *  Counters accumulate from the start of the probe; restart the probe
+     *  to reset them.
+     *
+     *  @param address  The SocketAddress of the host to probe
+     *  @param interval Time in milliseconds between echo requests
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t link_probe_start(const SocketAddress &address, uint32_t interval);
+
+    /** Stop the background link probe
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t link_probe_stop();
+
+    /** Read the accumulated results of the background link probe
+     *
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t link_probe_stats(nsapi_ping_stats_t *stats);
+
     /** Get the local IP address
      *
      *  @return         Null-terminated representation of the local IP address
@@ -270,6 +354,8 @@ public:
     }
 
 protected:
+    NetworkInterface();
+
     friend class InternetSocket;
     friend class UDPSocket;
     friend class TCPSocket;
@@ -314,6 +400,9 @@ protected:
      * performs the search described by get_default_instance.
      */
     static NetworkInterface *get_target_default_instance();
+
+private:
+    int _probe_id;
 };
 
 
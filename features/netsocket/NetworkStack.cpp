@@ -71,15 +71,8 @@ nsapi_value_or_error_t NetworkStack::gethostbyname_async(const char *name, hostb
         return NSAPI_ERROR_OK;
     }
 
-    // if the version is unspecified, try to guess the version from the
-    // ip address of the underlying stack
-    if (version == NSAPI_UNSPEC) {
-        SocketAddress testaddress;
-        if (testaddress.set_ip_address(this->get_ip_address())) {
-            version = testaddress.get_ip_version();
-        }
-    }
-
+    // An unspecified version is left to the resolver, which races the
+    // A and AAAA questions and takes whichever family answers first
     call_in_callback_cb_t call_in_cb = get_call_in_callback();
 
     return nsapi_dns_query_async(this, name, callback, call_in_cb, version);
@@ -100,6 +93,63 @@ nsapi_error_t NetworkStack::get_dns_server(int index, SocketAddress *address)
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_recv_zc(nsapi_socket_t handle, const void **data)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+void NetworkStack::socket_recv_zc_release(nsapi_socket_t handle, nsapi_size_t size)
+{
+}
+
+nsapi_error_t NetworkStack::socket_recv_callback(nsapi_socket_t handle,
+        void (*callback)(void *, const void *, nsapi_size_t, const SocketAddress &), void *data)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+        const nsapi_iovec_t *iov, int iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+        const nsapi_iovec_t *iov, int iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::socket_stats(nsapi_socket_t handle, nsapi_socket_stats_t *stats)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::get_pool_stats(nsapi_pool_stats_t *stats, nsapi_size_t count)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::ping_async(const SocketAddress &address, uint32_t timeout, ping_cb_t callback)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_value_or_error_t NetworkStack::probe_start(const SocketAddress &address, uint32_t interval)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::probe_stop(int id)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::probe_stats(int id, nsapi_ping_stats_t *stats)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkStack::setstackopt(int level, int optname, const void *optval, unsigned optlen)
 {
     return NSAPI_ERROR_UNSUPPORTED;
@@ -161,6 +161,80 @@ public:
      */
     virtual nsapi_error_t getstackopt(int level, int optname, void *optval, unsigned *optlen);
 
+    /** Read usage counters of the stack's internal buffer pools
+     *
+     *  Fills up to count entries with the current usage, high watermark
+     *  and allocation failure count of each fixed-size pool the stack
+     *  allocates from, so pools can be sized from field data rather than
+     *  guessed. Counters are maintained on the allocation path and the
+     *  read is cheap enough to poll in production.
+     *
+     *  Stacks without pool counter support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param stats    Array the counters are written to
+     *  @param count    Number of entries in the array
+     *  @return         Number of entries written on success, negative
+     *                  error code on failure
+     */
+    virtual nsapi_size_or_error_t get_pool_stats(nsapi_pool_stats_t *stats, nsapi_size_t count);
+
+    /** Ping result callback
+     *
+     *  Called with the echo round-trip time in milliseconds on success,
+     *  or a negative error code on timeout or failure.
+     *
+     *  The callback may be called from the stack's own context and should
+     *  not perform expensive operations such as socket recv/send calls or
+     *  blocking operations.
+     *
+     *  @param rtt_ms  Round-trip time in milliseconds, or negative error code
+     */
+    typedef mbed::Callback<void (nsapi_value_or_error_t rtt_ms)> ping_cb_t;
+
+    /** Send an ICMP echo request to a host (asynchronous)
+     *
+     *  Call is non-blocking; the result is delivered through the callback.
+     *  If this function returns failure, the callback will not be called.
+     *
+     *  Stacks without echo support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param address  The SocketAddress of the host to probe
+     *  @param timeout  Time in milliseconds to wait for the reply
+     *  @param callback Callback that is called with the result
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t ping_async(const SocketAddress &address, uint32_t timeout, ping_cb_t callback);
+
+    /** Start a periodic ICMP echo probe of a path
+     *
+     *  Sends an echo request to the host every interval milliseconds and
+     *  accumulates the results, readable with probe_stats(). A reply
+     *  arriving later than the interval counts as lost.
+     *
+     *  Stacks without echo support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param address  The SocketAddress of the host to probe
+     *  @param interval Time in milliseconds between echo requests
+     *  @return         Non-negative probe id on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_value_or_error_t probe_start(const SocketAddress &address, uint32_t interval);
+
+    /** Stop a periodic echo probe
+     *
+     *  @param id       Probe id returned by probe_start
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t probe_stop(int id);
+
+    /** Read the accumulated results of a periodic echo probe
+     *
+     *  @param id       Probe id returned by probe_start
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t probe_stats(int id, nsapi_ping_stats_t *stats);
+
     /** Dynamic downcast to a OnboardNetworkStack */
     virtual OnboardNetworkStack *onboardNetworkStack() { return 0; }
 
@@ -283,6 +357,41 @@ protected:
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
             void *data, nsapi_size_t size) = 0;
 
+    /** Receive data over a TCP socket without copying
+     *
+     *  Lends the caller a view of the stack's own receive buffer instead of
+     *  copying into a caller-provided buffer. The view is a contiguous run of
+     *  bytes and may be shorter than the data queued on the socket - call
+     *  again after releasing to walk the remaining data. The view stays valid
+     *  until it is consumed with socket_recv_zc_release() or the socket is
+     *  closed, and only one view may be outstanding per socket.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  Stacks without a zero-copy receive path return
+     *  NSAPI_ERROR_UNSUPPORTED and the caller should fall back to
+     *  socket_recv.
+     *
+     *  @param handle   Socket handle
+     *  @param data     Written with a pointer to the received data
+     *  @return         Number of contiguous bytes readable at *data on
+     *                  success, negative error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_zc(nsapi_socket_t handle,
+            const void **data);
+
+    /** Consume data lent by socket_recv_zc
+     *
+     *  Returns the first size bytes of the outstanding view to the stack.
+     *  Consuming less than the view's length keeps the remainder queued for
+     *  the next socket_recv_zc or socket_recv call.
+     *
+     *  @param handle   Socket handle
+     *  @param size     Number of bytes consumed from the view
+     */
+    virtual void socket_recv_zc_release(nsapi_socket_t handle, nsapi_size_t size);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -319,6 +428,92 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
             void *buffer, nsapi_size_t size) = 0;
 
+    /** Register a per-datagram delivery callback on a UDP socket
+     *
+     *  Replaces queue-and-wake delivery for the socket: instead of queueing
+     *  each datagram for a later socket_recvfrom, the stack invokes the
+     *  callback from its own thread as the datagram arrives, passing a view
+     *  of the payload and the source address. The view is only valid for
+     *  the duration of the call. While a callback is registered datagrams
+     *  do not reach socket_recvfrom; pass NULL to unregister and restore
+     *  queued delivery.
+     *
+     *  The callback runs in the stack's thread context and must not block
+     *  or call back into the stack.
+     *
+     *  Stacks without a direct delivery path return
+     *  NSAPI_ERROR_UNSUPPORTED and the caller should fall back to
+     *  socket_recvfrom.
+     *
+     *  @param handle   Socket handle
+     *  @param callback Function to call per datagram, or NULL to unregister
+     *  @param data     Argument to pass to callback
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_recv_callback(nsapi_socket_t handle,
+            void (*callback)(void *, const void *, nsapi_size_t, const SocketAddress &), void *data);
+
+    /** Send a scatter-gather list of buffers as one message
+     *
+     *  Gathers the iov elements in order into a single stream write or
+     *  datagram, so a frame split across header, payload and trailer buffers
+     *  does not have to be staged contiguously by the caller. On a stream
+     *  socket the message may be partially sent; on a datagram socket it is
+     *  sent as one packet or not at all.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  Stacks without a vectored send path return NSAPI_ERROR_UNSUPPORTED
+     *  and the caller should fall back to socket_send/socket_sendto.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, NULL to use the
+     *                  connected peer
+     *  @param iov      Scatter-gather list of buffers to send
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+            const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Receive a message into a scatter-gather list of buffers
+     *
+     *  Fills the iov elements in order with received data and stores the
+     *  source address in address if address is not NULL. Returns the total
+     *  number of bytes scattered across the buffers.
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  Stacks without a vectored receive path return NSAPI_ERROR_UNSUPPORTED
+     *  and the caller should fall back to socket_recv/socket_recvfrom.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Scatter-gather list of buffers to fill
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+            const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Read traffic counters of a socket
+     *
+     *  Returns the socket's cumulative traffic counters. Counters are
+     *  maintained on the data path and the read is O(1), so the call is
+     *  cheap enough to poll in production.
+     *
+     *  Stacks without counter support return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param handle   Socket handle
+     *  @param stats    Destination for the counters
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_stats(nsapi_socket_t handle, nsapi_socket_stats_t *stats);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -119,6 +119,31 @@ public:
          * @return              Pointer to a buffer, or NULL if the buffer is too small
          */
         virtual char *get_gateway(char *buf, nsapi_size_t buflen) = 0;
+
+        /** Read link-level traffic counters of the interface
+         *
+         * Stacks without counter support return NSAPI_ERROR_UNSUPPORTED.
+         *
+         * @param    stats      Destination for the counters
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t get_stats(nsapi_interface_stats_t *stats)
+        {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+
+        /** Copies the name the stack knows the interface by to user supplied buffer
+         *
+         * The name can be passed to the NSAPI_BIND_TO_DEVICE socket option.
+         * Stacks that do not name their interfaces return NULL.
+         *
+         * @param    buf        buffer of at least NSAPI_INTERFACE_NAME_SIZE bytes
+         * @return              Pointer to the buffer, or NULL
+         */
+        virtual char *get_interface_name(char *buf)
+        {
+            return NULL;
+        }
     };
 
     /** Register a network interface with the IP stack
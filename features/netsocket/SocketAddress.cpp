@@ -253,13 +253,18 @@ bool operator==(const SocketAddress &a, const SocketAddress &b)
         return true;
     } else if (a._addr.version != b._addr.version) {
         return false;
-    } else if (a._addr.version == NSAPI_IPv4) {
-        return memcmp(a._addr.bytes, b._addr.bytes, NSAPI_IPv4_BYTES) == 0;
-    } else if (a._addr.version == NSAPI_IPv6) {
-        return memcmp(a._addr.bytes, b._addr.bytes, NSAPI_IPv6_BYTES) == 0;
     }
 
-    MBED_UNREACHABLE;
+    // Accumulate over the whole address instead of bailing at the first
+    // difference, so the comparison takes the same time whatever the
+    // addresses - keeps address-keyed rate limiters free of timing tells
+    int bytes = (a._addr.version == NSAPI_IPv6) ? NSAPI_IPv6_BYTES : NSAPI_IPv4_BYTES;
+    uint8_t diff = 0;
+    for (int i = 0; i < bytes; i++) {
+        diff |= a._addr.bytes[i] ^ b._addr.bytes[i];
+    }
+
+    return diff == 0;
 }
 
 bool operator!=(const SocketAddress &a, const SocketAddress &b)
@@ -267,6 +272,39 @@ bool operator!=(const SocketAddress &a, const SocketAddress &b)
     return !(a == b);
 }
 
+bool operator<(const SocketAddress &a, const SocketAddress &b)
+{
+    if (!a || !b) {
+        // All zero addresses compare equal, so order unset before set
+        return !a && b;
+    } else if (a._addr.version != b._addr.version) {
+        return a._addr.version < b._addr.version;
+    }
+
+    int bytes = (a._addr.version == NSAPI_IPv6) ? NSAPI_IPv6_BYTES : NSAPI_IPv4_BYTES;
+    return memcmp(a._addr.bytes, b._addr.bytes, bytes) < 0;
+}
+
+uint32_t SocketAddress::get_hash() const
+{
+    // All zero addresses compare equal regardless of version, so they
+    // must also hash equally
+    if (!*this) {
+        return 0;
+    }
+
+    // FNV-1a over the version and the address bytes
+    uint32_t hash = 2166136261u;
+    hash = (hash ^ _addr.version) * 16777619u;
+
+    int bytes = (_addr.version == NSAPI_IPv6) ? NSAPI_IPv6_BYTES : NSAPI_IPv4_BYTES;
+    for (int i = 0; i < bytes; i++) {
+        hash = (hash ^ _addr.bytes[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
 void SocketAddress::_SocketAddress(NetworkStack *iface, const char *host, uint16_t port)
 {
     _ip_address = NULL;
@@ -171,6 +171,26 @@ public:
      */
     friend bool operator!=(const SocketAddress &a, const SocketAddress &b);
 
+    /** Order two addresses
+     *
+     *  Orders by IP version, then raw address bytes. The port is not
+     *  considered, consistent with equality. Suitable for keying ordered
+     *  containers without formatting the textual address.
+     *
+     *  @return         True if a orders before b
+     */
+    friend bool operator<(const SocketAddress &a, const SocketAddress &b);
+
+    /** Get a hash of the address
+     *
+     *  Hashes the raw address bytes directly, without formatting the
+     *  textual address. Equal addresses hash equally; the port is not
+     *  included, consistent with equality.
+     *
+     *  @return         32-bit hash of the address
+     */
+    uint32_t get_hash() const;
+
 private:
     void _SocketAddress(NetworkStack *iface, const char *host, uint16_t port);
 
@@ -0,0 +1,110 @@
+/* SocketSet
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSet.h"
+
+void SocketSet::member::event()
+{
+    set->_flags.set(flag);
+}
+
+SocketSet::SocketSet() : _used(0)
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        _members[i].set = this;
+        _members[i].socket = 0;
+        _members[i].flag = (1 << i);
+    }
+}
+
+SocketSet::~SocketSet()
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_members[i].socket) {
+            _members[i].socket->sigio(0);
+        }
+    }
+}
+
+nsapi_error_t SocketSet::add(Socket *socket)
+{
+    if (!socket) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    int slot = -1;
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_members[i].socket == socket) {
+            return NSAPI_ERROR_PARAMETER;
+        }
+        if (slot < 0 && !_members[i].socket) {
+            slot = i;
+        }
+    }
+    if (slot < 0) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    _members[slot].socket = socket;
+    _used |= _members[slot].flag;
+    socket->sigio(mbed::callback(&_members[slot], &SocketSet::member::event));
+
+    /* The socket may already be readable or writable - latch an initial
+       event so the first wait services it rather than missing the edge */
+    _flags.set(_members[slot].flag);
+
+    return slot;
+}
+
+nsapi_error_t SocketSet::remove(Socket *socket)
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_members[i].socket == socket) {
+            _members[i].socket->sigio(0);
+            _members[i].socket = 0;
+            _used &= ~_members[i].flag;
+            _flags.clear(_members[i].flag);
+            return NSAPI_ERROR_OK;
+        }
+    }
+
+    return NSAPI_ERROR_PARAMETER;
+}
+
+uint32_t SocketSet::wait(uint32_t millisec)
+{
+    if (!_used) {
+        return 0;
+    }
+
+    uint32_t flags = _flags.wait_any(_used, millisec);
+    if (flags & osFlagsError) {
+        return 0;
+    }
+
+    /* Report only current members - a slot may have been recycled while
+       its old event was still pending */
+    return flags & _used;
+}
+
+Socket *SocketSet::get(int index)
+{
+    if (index < 0 || index >= MAX_SOCKETS) {
+        return 0;
+    }
+
+    return _members[index].socket;
+}
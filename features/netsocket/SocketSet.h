@@ -0,0 +1,112 @@
+
+/** \addtogroup netsocket */
+/** @{*/
+/* SocketSet
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOCKETSET_H
+#define SOCKETSET_H
+
+#include "netsocket/Socket.h"
+#include "rtos/EventFlags.h"
+#include "Callback.h"
+
+/** Waitable set of sockets.
+ *
+ *  Lets one thread block until any of several sockets reports activity,
+ *  instead of dedicating a thread per socket or busy-looping on
+ *  NSAPI_ERROR_WOULD_BLOCK. The set registers itself as each member
+ *  socket's sigio handler and latches events into a shared flag group.
+ *
+ *  Member sockets should be in non-blocking mode. An event is a hint that
+ *  the socket may be readable, writable or in error - the same semantics
+ *  as sigio - so after wait() the caller services flagged sockets with
+ *  non-blocking calls until they return NSAPI_ERROR_WOULD_BLOCK, as
+ *  events are latched on state change rather than level-triggered.
+ *
+ *  Adding a socket replaces any sigio callback registered on it; removing
+ *  it clears the callback.
+ */
+class SocketSet {
+public:
+    /** Maximum number of sockets in one set */
+    static const int MAX_SOCKETS = 30;
+
+    SocketSet();
+
+    /** Destroy a socket set
+     *
+     *  Detaches from all member sockets
+     */
+    ~SocketSet();
+
+    /** Add a socket to the set
+     *
+     *  @param socket   Socket to add
+     *  @return         Nonnegative index of the socket in the set on success,
+     *                  NSAPI_ERROR_NO_MEMORY if the set is full,
+     *                  NSAPI_ERROR_PARAMETER if socket is NULL or already a member
+     */
+    nsapi_error_t add(Socket *socket);
+
+    /** Remove a socket from the set
+     *
+     *  Clears the socket's sigio callback and any pending event for it.
+     *
+     *  @param socket   Socket to remove
+     *  @return         0 on success, NSAPI_ERROR_PARAMETER if the socket
+     *                  is not a member of the set
+     */
+    nsapi_error_t remove(Socket *socket);
+
+    /** Wait for activity on any socket in the set
+     *
+     *  Blocks until at least one member socket has reported an event since
+     *  it was last serviced, or the timeout expires. Pending events are
+     *  cleared by the wait, so each call reports fresh activity.
+     *
+     *  @param millisec Timeout in milliseconds, osWaitForever to wait forever
+     *  @return         Bitmask of ready socket indexes (bit n set means the
+     *                  socket at index n has activity), 0 on timeout
+     */
+    uint32_t wait(uint32_t millisec = osWaitForever);
+
+    /** Return the socket at an index
+     *
+     *  Use with the bitmask from wait() to locate ready sockets.
+     *
+     *  @param index    Index returned by add()
+     *  @return         Socket at the index, or NULL if the slot is empty
+     */
+    Socket *get(int index);
+
+private:
+    struct member {
+        SocketSet *set;
+        Socket *socket;
+        uint32_t flag;
+
+        void event();
+    };
+
+    member _members[MAX_SOCKETS];
+    rtos::EventFlags _flags;
+    uint32_t _used;
+};
+
+#endif // SOCKETSET_H
+
+/** @}*/
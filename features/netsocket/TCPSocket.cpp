@@ -100,10 +100,121 @@ nsapi_error_t TCPSocket::connect(const char *host, uint16_t port)
 
     address.set_port(port);
 
+#if MBED_CONF_NSAPI_CONNECT_STAGGER_DELAY > 0
+    // When the preferred family is IPv6 the host may be dual-stack and the
+    // IPv6 route black-holed - resolve the IPv4 fallback and race the two
+    // attempts rather than eating a full connection timeout serially
+    if (_timeout != 0 && address.get_ip_version() == NSAPI_IPv6) {
+        SocketAddress fallback;
+        if (_stack->gethostbyname(host, &fallback, NSAPI_IPv4) == NSAPI_ERROR_OK) {
+            fallback.set_port(port);
+            return connect_staggered(address, fallback);
+        }
+    }
+#endif
+
     // connect is thread safe
     return connect(address);
 }
 
+nsapi_error_t TCPSocket::connect_staggered(const SocketAddress &primary, const SocketAddress &secondary)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    nsapi_socket_t alt = 0;
+    bool alt_started = false;
+    bool alt_won = false;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_connect(_socket, primary);
+        if (!(ret == NSAPI_ERROR_IN_PROGRESS || ret == NSAPI_ERROR_ALREADY)) {
+            // Preferred attempt resolved - connected or failed for real
+            break;
+        }
+
+        if (alt) {
+            nsapi_error_t alt_ret = _stack->socket_connect(alt, secondary);
+            if (alt_ret == NSAPI_ERROR_OK || alt_ret == NSAPI_ERROR_IS_CONNECTED) {
+                // Fallback won the race - adopt its socket and abandon the
+                // still-pending preferred attempt
+                nsapi_socket_t abandoned = _socket;
+                _socket = alt;
+                alt = 0;
+                alt_won = true;
+                _stack->socket_close(abandoned);
+                ret = NSAPI_ERROR_IS_CONNECTED;
+                break;
+            } else if (!(alt_ret == NSAPI_ERROR_IN_PROGRESS || alt_ret == NSAPI_ERROR_ALREADY)) {
+                // Fallback failed - keep waiting on the preferred attempt
+                _stack->socket_close(alt);
+                alt = 0;
+            }
+        }
+
+        uint32_t flag;
+
+        // Release lock before blocking so other threads
+        // accessing this object aren't blocked
+        _lock.unlock();
+        if (!alt_started) {
+            // Give the preferred family the stagger delay to itself
+            flag = _event_flag.wait_any(WRITE_FLAG, MBED_CONF_NSAPI_CONNECT_STAGGER_DELAY);
+        } else {
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+        }
+        _lock.lock();
+
+        if (flag & osFlagsError) {
+            if (!alt_started) {
+                // Preferred attempt is slow - launch the fallback
+                alt_started = true;
+                if (_stack->socket_open(&alt, NSAPI_TCP) != NSAPI_ERROR_OK) {
+                    alt = 0;
+                } else {
+                    _stack->socket_attach(alt, &mbed::Callback<void()>::thunk, &_event);
+                }
+            } else {
+                // Timeout break
+                break;
+            }
+        }
+    }
+
+    if (alt) {
+        _stack->socket_close(alt);
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    /* Non-blocking connect gives "EISCONN" once done - convert to OK for blocking mode if we became connected during this call */
+    if (ret == NSAPI_ERROR_IS_CONNECTED) {
+        ret = NSAPI_ERROR_OK;
+    }
+
+    if (ret == NSAPI_ERROR_OK || ret == NSAPI_ERROR_IN_PROGRESS) {
+        _remote_peer = alt_won ? secondary : primary;
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
 {
     _lock.lock();
@@ -222,6 +333,68 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
     return ret;
 }
 
+nsapi_size_or_error_t TCPSocket::recv_zc(const void **data)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_recv_zc(_socket, data);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TCPSocket::recv_zc_release(nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        _stack->socket_recv_zc_release(_socket, size);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t TCPSocket::recvfrom(SocketAddress *address, void *data, nsapi_size_t size)
 {
     if (address) {
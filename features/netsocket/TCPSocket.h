@@ -65,6 +65,13 @@ public:
      *  Initiates a connection to a remote server specified by either
      *  a domain name or an IP address and a port.
      *
+     *  When the host resolves in both address families on a blocking
+     *  socket, the preferred family is tried first and the other is
+     *  attempted in parallel after a short stagger delay
+     *  (nsapi.connect-stagger-delay, RFC 8305 style), so a black-holed
+     *  route in one family costs the stagger delay rather than a full
+     *  connection timeout. Whichever attempt completes first wins.
+     *
      *  @param host     Hostname of the remote host
      *  @param port     Port of the remote host
      *  @return         0 on success, negative error code on failure
@@ -115,6 +122,41 @@ public:
      */
     virtual nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
 
+    /** Receive data over a TCP socket without copying
+     *
+     *  Lends the application a view of the network stack's own receive
+     *  buffer instead of copying into a caller-provided buffer. The view is
+     *  a contiguous run of bytes and may be shorter than the data queued on
+     *  the socket - call again after releasing to walk the remaining data.
+     *  The view stays valid until it is returned with recv_zc_release() or
+     *  the socket is closed, and only one view may be outstanding at a time.
+     *
+     *  By default, recv_zc blocks until some data is received. If socket is
+     *  set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be
+     *  returned to indicate no data.
+     *
+     *  Stacks without a zero-copy receive path return
+     *  NSAPI_ERROR_UNSUPPORTED; fall back to recv() in that case.
+     *
+     *  @param data     Written with a pointer to the received data
+     *  @return         Number of contiguous bytes readable at *data on
+     *                  success, negative error code on failure. If no data is
+     *                  available to be received and the peer has performed an
+     *                  orderly shutdown, recv_zc() returns 0.
+     */
+    nsapi_size_or_error_t recv_zc(const void **data);
+
+    /** Return data lent by recv_zc to the network stack
+     *
+     *  Consumes the first size bytes of the outstanding view. Consuming less
+     *  than the view's length keeps the remainder queued for the next
+     *  recv_zc() or recv() call.
+     *
+     *  @param size     Number of bytes consumed from the view
+     *  @return         0 on success, negative error code on failure
+     */
+    nsapi_error_t recv_zc_release(nsapi_size_t size);
+
     /** Send data on a socket.
      *
      * TCP socket is connection oriented protocol, so address is ignored.
@@ -179,6 +221,7 @@ public:
 protected:
     friend class TCPServer;
     virtual nsapi_protocol_t get_proto();
+    nsapi_error_t connect_staggered(const SocketAddress &primary, const SocketAddress &secondary);
 };
 
 
@@ -0,0 +1,177 @@
+/* TCPSocketPool
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TCPSocketPool.h"
+#include "rtos/Kernel.h"
+#include <string.h>
+
+TCPSocketPool::TCPSocketPool(NetworkStack *stack, uint32_t idle_timeout_ms,
+                             int keepalive_idle_ms)
+{
+    init(stack, idle_timeout_ms, keepalive_idle_ms);
+}
+
+void TCPSocketPool::init(NetworkStack *stack, uint32_t idle_timeout_ms,
+                         int keepalive_idle_ms)
+{
+    _stack = stack;
+    _idle_timeout = idle_timeout_ms;
+    _keepalive = keepalive_idle_ms;
+
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        _entries[i].open = false;
+        _entries[i].in_use = false;
+    }
+}
+
+TCPSocketPool::~TCPSocketPool()
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_entries[i].open) {
+            close_entry(&_entries[i]);
+        }
+    }
+}
+
+void TCPSocketPool::close_entry(entry *e)
+{
+    e->socket.close();
+    e->open = false;
+    e->in_use = false;
+}
+
+void TCPSocketPool::sweep_idle()
+{
+    uint64_t now = rtos::Kernel::get_ms_count();
+
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        entry *e = &_entries[i];
+        if (e->open && !e->in_use && now - e->last_used > _idle_timeout) {
+            close_entry(e);
+        }
+    }
+}
+
+TCPSocket *TCPSocketPool::acquire(const char *host, uint16_t port, nsapi_error_t *error)
+{
+    if (!host || strlen(host) >= MAX_HOSTNAME) {
+        if (error) {
+            *error = NSAPI_ERROR_PARAMETER;
+        }
+        return NULL;
+    }
+
+    _lock.lock();
+
+    sweep_idle();
+
+    /* Reuse an idle connection to the same destination */
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        entry *e = &_entries[i];
+        if (e->open && !e->in_use && e->port == port && strcmp(e->host, host) == 0) {
+            e->in_use = true;
+            _lock.unlock();
+            if (error) {
+                *error = NSAPI_ERROR_OK;
+            }
+            return &e->socket;
+        }
+    }
+
+    /* Otherwise find a free slot, evicting the least recently used idle
+       connection if the pool is full */
+    entry *slot = NULL;
+    entry *lru = NULL;
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        entry *e = &_entries[i];
+        if (!e->open) {
+            slot = e;
+            break;
+        }
+        if (!e->in_use && (!lru || e->last_used < lru->last_used)) {
+            lru = e;
+        }
+    }
+    if (!slot && lru) {
+        close_entry(lru);
+        slot = lru;
+    }
+    if (!slot) {
+        _lock.unlock();
+        if (error) {
+            *error = NSAPI_ERROR_NO_SOCKET;
+        }
+        return NULL;
+    }
+
+    /* Mark the slot busy before connecting so the pool lock is not held
+       across the handshake */
+    strcpy(slot->host, host);
+    slot->port = port;
+    slot->open = true;
+    slot->in_use = true;
+
+    _lock.unlock();
+
+    nsapi_error_t err = slot->socket.open(_stack);
+    if (err == NSAPI_ERROR_OK) {
+        if (_keepalive > 0) {
+            int enable = 1;
+            /* Best effort - stacks without keepalive support simply leave
+               idle connections unprobed */
+            slot->socket.setsockopt(NSAPI_SOCKET, NSAPI_KEEPALIVE, &enable, sizeof enable);
+            slot->socket.setsockopt(NSAPI_SOCKET, NSAPI_KEEPIDLE, &_keepalive, sizeof _keepalive);
+        }
+        err = slot->socket.connect(host, port);
+    }
+
+    if (err != NSAPI_ERROR_OK) {
+        _lock.lock();
+        close_entry(slot);
+        _lock.unlock();
+        if (error) {
+            *error = err;
+        }
+        return NULL;
+    }
+
+    if (error) {
+        *error = NSAPI_ERROR_OK;
+    }
+    return &slot->socket;
+}
+
+nsapi_error_t TCPSocketPool::release(TCPSocket *socket, bool keep)
+{
+    _lock.lock();
+
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        entry *e = &_entries[i];
+        if (e->open && &e->socket == socket) {
+            if (keep) {
+                e->in_use = false;
+                e->last_used = rtos::Kernel::get_ms_count();
+            } else {
+                close_entry(e);
+            }
+            _lock.unlock();
+            return NSAPI_ERROR_OK;
+        }
+    }
+
+    _lock.unlock();
+    return NSAPI_ERROR_PARAMETER;
+}
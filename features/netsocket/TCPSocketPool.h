@@ -0,0 +1,128 @@
+
+/** \addtogroup netsocket */
+/** @{*/
+/* TCPSocketPool
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TCPSOCKETPOOL_H
+#define TCPSOCKETPOOL_H
+
+#include "netsocket/TCPSocket.h"
+#include "netsocket/NetworkStack.h"
+#include "rtos/Mutex.h"
+
+/** Pool of reusable TCP connections keyed by host and port.
+ *
+ *  Opening a fresh TCPSocket per transaction costs a TCP handshake each
+ *  time and leaves TIME_WAIT pcbs behind that can exhaust the stack's pcb
+ *  pool under churn. The pool keeps connections open between uses and
+ *  hands an established socket straight back when the same host and port
+ *  are requested again.
+ *
+ *  Released connections stay open with TCP keepalive enabled so NATs and
+ *  the peer hold the connection during idle gaps; connections idle longer
+ *  than the idle timeout are closed on the next pool operation. A peer
+ *  may still drop a pooled connection at any time - on the first send or
+ *  recv error from a reused socket, release it with keep set to false
+ *  and acquire again to get a fresh connection.
+ */
+class TCPSocketPool {
+public:
+    /** Maximum number of pooled connections */
+    static const int MAX_SOCKETS = 4;
+
+    /** Maximum length of a pooled hostname, including terminator */
+    static const int MAX_HOSTNAME = 64;
+
+    /** Create a connection pool on a network stack
+     *
+     *  @param stack             Network stack the pooled sockets are opened on
+     *  @param idle_timeout_ms   Idle time after which a released connection
+     *                           is closed, in milliseconds
+     *  @param keepalive_idle_ms TCP keepalive idle time set on pooled
+     *                           connections, in milliseconds, 0 to disable
+     */
+    TCPSocketPool(NetworkStack *stack, uint32_t idle_timeout_ms = 30000,
+                  int keepalive_idle_ms = 10000);
+
+    template <typename S>
+    TCPSocketPool(S *stack, uint32_t idle_timeout_ms = 30000,
+                  int keepalive_idle_ms = 10000)
+    {
+        init(nsapi_create_stack(stack), idle_timeout_ms, keepalive_idle_ms);
+    }
+
+    /** Destroy a connection pool
+     *
+     *  Closes all pooled connections
+     */
+    ~TCPSocketPool();
+
+    /** Get a connected socket for a host and port
+     *
+     *  Returns an idle pooled connection to the host and port if one is
+     *  open, otherwise opens and connects a new socket. If the pool is
+     *  full of idle connections to other destinations, the least recently
+     *  used one is closed to make room.
+     *
+     *  The returned socket is owned by the pool and must be returned with
+     *  release(), not closed or deleted by the caller.
+     *
+     *  @param host     Hostname of the remote host
+     *  @param port     Port of the remote host
+     *  @param error    Pointer to storage of the error value or NULL
+     *  @return         Connected socket, or NULL on failure
+     */
+    TCPSocket *acquire(const char *host, uint16_t port, nsapi_error_t *error = NULL);
+
+    /** Return a socket to the pool
+     *
+     *  With keep set the connection stays open for reuse by a later
+     *  acquire() of the same host and port. Without it the connection is
+     *  closed - use this when the socket has reported an error or the
+     *  application knows the peer has finished with the connection.
+     *
+     *  @param socket   Socket obtained from acquire()
+     *  @param keep     True to keep the connection open for reuse
+     *  @return         0 on success, NSAPI_ERROR_PARAMETER if the socket
+     *                  did not come from this pool
+     */
+    nsapi_error_t release(TCPSocket *socket, bool keep = true);
+
+private:
+    struct entry {
+        TCPSocket socket;
+        char host[MAX_HOSTNAME];
+        uint16_t port;
+        bool open;
+        bool in_use;
+        uint64_t last_used;
+    };
+
+    void init(NetworkStack *stack, uint32_t idle_timeout_ms, int keepalive_idle_ms);
+    void close_entry(entry *e);
+    void sweep_idle();
+
+    entry _entries[MAX_SOCKETS];
+    NetworkStack *_stack;
+    uint32_t _idle_timeout;
+    int _keepalive;
+    rtos::Mutex _lock;
+};
+
+#endif // TCPSOCKETPOOL_H
+
+/** @}*/
@@ -0,0 +1,399 @@
+/* TLSSocket
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSocket.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include "events/EventQueue.h"
+#include "platform/SingletonPtr.h"
+#include <string.h>
+
+static const char DRBG_PERS[] = "mbed TLSSocket";
+
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+// Session cache shared by all TLSSocket instances, keyed by hostname.
+// Restoring a session lets the server skip the full key exchange on a
+// repeat connection.
+namespace {
+struct tls_session_entry {
+    char host[64];
+    mbedtls_ssl_session session;
+    bool valid;
+};
+tls_session_entry tls_session_cache[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+uint32_t tls_session_cache_next;
+SingletonPtr<PlatformMutex> tls_session_cache_lock;
+}
+#endif
+
+TLSSocket::TLSSocket() :
+    _queue(NULL), _tls_initialized(false), _cacert_loaded(false),
+    _clicert_loaded(false), _tls_connected(false),
+    _handshake_in_progress(false), _handshake_deferred_pending(false)
+{
+    _hostname[0] = '\0';
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    mbedtls_x509_crt_init(&_cacert);
+    mbedtls_x509_crt_init(&_clicert);
+    mbedtls_pk_init(&_pkey);
+#endif
+}
+
+TLSSocket::~TLSSocket()
+{
+    tls_free();
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    mbedtls_x509_crt_free(&_cacert);
+    mbedtls_x509_crt_free(&_clicert);
+    mbedtls_pk_free(&_pkey);
+#endif
+}
+
+nsapi_error_t TLSSocket::set_root_ca_cert(const void *root_ca, size_t len)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if (mbedtls_x509_crt_parse(&_cacert, (const unsigned char *)root_ca, len) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _cacert_loaded = true;
+    return NSAPI_ERROR_OK;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_error_t TLSSocket::set_root_ca_cert(const char *root_ca_pem)
+{
+    return set_root_ca_cert(root_ca_pem, strlen(root_ca_pem) + 1);
+}
+
+nsapi_error_t TLSSocket::set_client_cert_key(const void *client_cert, size_t client_cert_len,
+                                             const void *client_private_key, size_t client_private_key_len)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if (mbedtls_x509_crt_parse(&_clicert, (const unsigned char *)client_cert, client_cert_len) != 0 ||
+            mbedtls_pk_parse_key(&_pkey, (const unsigned char *)client_private_key,
+                                 client_private_key_len, NULL, 0) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _clicert_loaded = true;
+    return NSAPI_ERROR_OK;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_error_t TLSSocket::set_client_cert_key(const char *client_cert_pem, const char *client_private_key_pem)
+{
+    return set_client_cert_key(client_cert_pem, strlen(client_cert_pem) + 1,
+                               client_private_key_pem, strlen(client_private_key_pem) + 1);
+}
+
+void TLSSocket::set_event_queue(events::EventQueue *queue)
+{
+    _queue = queue;
+}
+
+int TLSSocket::ssl_send_cb(void *ctx, const unsigned char *buf, size_t len)
+{
+    TLSSocket *self = static_cast<TLSSocket *>(ctx);
+    nsapi_size_or_error_t ret = self->TCPSocket::send(buf, len);
+    if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (ret < 0) {
+        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    }
+    return ret;
+}
+
+int TLSSocket::ssl_recv_cb(void *ctx, unsigned char *buf, size_t len)
+{
+    TLSSocket *self = static_cast<TLSSocket *>(ctx);
+    nsapi_size_or_error_t ret = self->TCPSocket::recv(buf, len);
+    if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    if (ret < 0) {
+        return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+    }
+    return ret;
+}
+
+nsapi_error_t TLSSocket::tls_init()
+{
+    if (_tls_initialized) {
+        return NSAPI_ERROR_OK;
+    }
+
+    mbedtls_entropy_init(&_entropy);
+    mbedtls_ctr_drbg_init(&_ctr_drbg);
+    mbedtls_ssl_init(&_ssl);
+    mbedtls_ssl_config_init(&_conf);
+
+    int ret = mbedtls_ctr_drbg_seed(&_ctr_drbg, mbedtls_entropy_func, &_entropy,
+                                    (const unsigned char *)DRBG_PERS, sizeof(DRBG_PERS) - 1);
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_ctr_drbg);
+        mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+        if (_cacert_loaded) {
+            mbedtls_ssl_conf_ca_chain(&_conf, &_cacert, NULL);
+        }
+        if (_clicert_loaded) {
+            ret = mbedtls_ssl_conf_own_cert(&_conf, &_clicert, &_pkey);
+        }
+#endif
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_setup(&_ssl, &_conf);
+    }
+    if (ret != 0) {
+        mbedtls_ssl_free(&_ssl);
+        mbedtls_ssl_config_free(&_conf);
+        mbedtls_ctr_drbg_free(&_ctr_drbg);
+        mbedtls_entropy_free(&_entropy);
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    mbedtls_ssl_set_bio(&_ssl, this, ssl_send_cb, ssl_recv_cb, NULL);
+    _tls_initialized = true;
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSocket::tls_free()
+{
+    if (!_tls_initialized) {
+        return;
+    }
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_config_free(&_conf);
+    mbedtls_ctr_drbg_free(&_ctr_drbg);
+    mbedtls_entropy_free(&_entropy);
+    _tls_initialized = false;
+    _tls_connected = false;
+    _handshake_in_progress = false;
+    _hostname[0] = '\0';
+}
+
+void TLSSocket::session_cache_store()
+{
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+    if (_hostname[0] == '\0') {
+        return;
+    }
+    tls_session_cache_lock->lock();
+    tls_session_entry *entry = NULL;
+    for (uint32_t i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i].valid && strcmp(tls_session_cache[i].host, _hostname) == 0) {
+            entry = &tls_session_cache[i];
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &tls_session_cache[tls_session_cache_next];
+        tls_session_cache_next = (tls_session_cache_next + 1) % MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE;
+        strncpy(entry->host, _hostname, sizeof(entry->host) - 1);
+        entry->host[sizeof(entry->host) - 1] = '\0';
+    }
+    if (entry->valid) {
+        mbedtls_ssl_session_free(&entry->session);
+        entry->valid = false;
+    }
+    mbedtls_ssl_session_init(&entry->session);
+    if (mbedtls_ssl_get_session(&_ssl, &entry->session) == 0) {
+        entry->valid = true;
+    }
+    tls_session_cache_lock->unlock();
+#endif
+}
+
+void TLSSocket::session_cache_restore()
+{
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+    if (_hostname[0] == '\0') {
+        return;
+    }
+    tls_session_cache_lock->lock();
+    for (uint32_t i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i].valid && strcmp(tls_session_cache[i].host, _hostname) == 0) {
+            mbedtls_ssl_set_session(&_ssl, &tls_session_cache[i].session);
+            break;
+        }
+    }
+    tls_session_cache_lock->unlock();
+#endif
+}
+
+nsapi_error_t TLSSocket::connect_common(const char *host, const SocketAddress *address, uint16_t port)
+{
+    _ssl_lock.lock();
+    nsapi_error_t ret = tls_init();
+    if (ret != NSAPI_ERROR_OK) {
+        _ssl_lock.unlock();
+        return ret;
+    }
+    if (host && _hostname[0] == '\0') {
+        strncpy(_hostname, host, sizeof(_hostname) - 1);
+        _hostname[sizeof(_hostname) - 1] = '\0';
+        mbedtls_ssl_set_hostname(&_ssl, _hostname);
+        session_cache_restore();
+    }
+    _ssl_lock.unlock();
+
+    if (host) {
+        ret = TCPSocket::connect(host, port);
+    } else {
+        ret = TCPSocket::connect(*address);
+    }
+    if (ret != NSAPI_ERROR_OK && ret != NSAPI_ERROR_IS_CONNECTED) {
+        // Includes NSAPI_ERROR_IN_PROGRESS and NSAPI_ERROR_ALREADY of a
+        // non-blocking TCP connect - repeat the call as with TCPSocket
+        return ret;
+    }
+
+    _ssl_lock.lock();
+    if (_tls_connected) {
+        // An event-queue continuation finished the handshake already
+        _ssl_lock.unlock();
+        return NSAPI_ERROR_OK;
+    }
+    _handshake_in_progress = true;
+    ret = handshake_continue();
+    _ssl_lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TLSSocket::connect(const char *host, uint16_t port)
+{
+    if (_tls_connected) {
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+    return connect_common(host, NULL, port);
+}
+
+nsapi_error_t TLSSocket::connect(const SocketAddress &address)
+{
+    if (_tls_connected) {
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+    return connect_common(NULL, &address, 0);
+}
+
+// Advance the handshake one step; called with _ssl_lock held
+nsapi_error_t TLSSocket::handshake_continue()
+{
+    int ret = mbedtls_ssl_handshake(&_ssl);
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        // Only reachable on a non-blocking socket - progress resumes on
+        // the next socket event
+        return NSAPI_ERROR_IN_PROGRESS;
+    }
+    _handshake_in_progress = false;
+    if (ret != 0) {
+        if (ret == MBEDTLS_ERR_SSL_CONN_EOF || ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+            return NSAPI_ERROR_NO_CONNECTION;
+        }
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+    _tls_connected = true;
+    session_cache_store();
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSocket::handshake_deferred()
+{
+    _handshake_deferred_pending = false;
+    _ssl_lock.lock();
+    if (!_handshake_in_progress) {
+        _ssl_lock.unlock();
+        return;
+    }
+    nsapi_error_t ret = handshake_continue();
+    _ssl_lock.unlock();
+    if (ret != NSAPI_ERROR_IN_PROGRESS && _callback) {
+        // Completion (or failure) is an event the owner waits on
+        _callback();
+    }
+}
+
+void TLSSocket::event()
+{
+    if (_handshake_in_progress && _queue && !_handshake_deferred_pending) {
+        _handshake_deferred_pending = true;
+        if (!_queue->call(mbed::callback(this, &TLSSocket::handshake_deferred))) {
+            _handshake_deferred_pending = false;
+        }
+    }
+    TCPSocket::event();
+}
+
+nsapi_size_or_error_t TLSSocket::send(const void *data, nsapi_size_t size)
+{
+    if (!_tls_connected) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+    _ssl_lock.lock();
+    int ret = mbedtls_ssl_write(&_ssl, (const unsigned char *)data, size);
+    _ssl_lock.unlock();
+    if (ret >= 0) {
+        return ret;
+    }
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    return NSAPI_ERROR_DEVICE_ERROR;
+}
+
+nsapi_size_or_error_t TLSSocket::recv(void *data, nsapi_size_t size)
+{
+    if (!_tls_connected) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+    _ssl_lock.lock();
+    int ret = mbedtls_ssl_read(&_ssl, (unsigned char *)data, size);
+    _ssl_lock.unlock();
+    if (ret >= 0) {
+        return ret;
+    }
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY || ret == MBEDTLS_ERR_SSL_CONN_EOF) {
+        // Orderly shutdown by the peer, matches the TCPSocket contract
+        return 0;
+    }
+    return NSAPI_ERROR_DEVICE_ERROR;
+}
+
+nsapi_error_t TLSSocket::close()
+{
+    _ssl_lock.lock();
+    if (_tls_connected) {
+        mbedtls_ssl_close_notify(&_ssl);
+    }
+    tls_free();
+    _ssl_lock.unlock();
+    return TCPSocket::close();
+}
+
+#endif // MBEDTLS_SSL_CLI_C
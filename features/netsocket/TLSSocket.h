@@ -0,0 +1,212 @@
+/** \addtogroup netsocket */
+/** @{*/
+/* TLSSocket
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLSSOCKET_H
+#define TLSSOCKET_H
+
+#include "netsocket/TCPSocket.h"
+#include "platform/PlatformMutex.h"
+
+#include "mbedtls/ssl.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+
+#if defined(MBEDTLS_SSL_CLI_C) || defined(DOXYGEN_ONLY)
+
+namespace events {
+class EventQueue;
+}
+
+/** TLS socket connection
+ *
+ * A TCPSocket carrying TLS, so applications stop hand-rolling the glue
+ * between the socket event model and mbed TLS. The record path runs
+ * through mbed TLS, which picks up the hardware crypto accelerators the
+ * target provides through the usual *_ALT hooks.
+ *
+ * A root CA must be set with set_root_ca_cert() before connecting; peer
+ * verification is always required. Successful handshakes deposit their
+ * session in a small cache keyed by hostname (nsapi.tls-session-cache-size),
+ * so repeat connections to the same host resume the session and skip the
+ * full key exchange.
+ *
+ * The socket follows the usual blocking rules: on a blocking socket
+ * connect() returns once the handshake has completed, on a non-blocking
+ * socket it returns NSAPI_ERROR_IN_PROGRESS and the caller repeats the
+ * call on sigio events, as with TCPSocket::connect(). Alternatively
+ * set_event_queue() continues a non-blocking handshake from the given
+ * queue, and sigio signals its completion.
+ */
+class TLSSocket : public TCPSocket {
+public:
+    /** Create an uninitialized socket
+     *
+     *  Must call open to initialize the socket on a network stack.
+     */
+    TLSSocket();
+
+    /** Destroy a socket
+     *
+     *  Closes socket if the socket is still open
+     */
+    virtual ~TLSSocket();
+
+    /** Set the root CA certificate chain the peer is verified against
+     *
+     *  @param root_ca Root CA certificate chain in DER or PEM format
+     *  @param len     Length of the chain in bytes, including the
+     *                 terminating NUL for PEM
+     *  @return        0 on success, negative error code on failure
+     */
+    nsapi_error_t set_root_ca_cert(const void *root_ca, size_t len);
+
+    /** Set the root CA certificate chain the peer is verified against
+     *
+     *  @param root_ca_pem Root CA certificate chain as a NUL-terminated
+     *                     PEM string
+     *  @return            0 on success, negative error code on failure
+     */
+    nsapi_error_t set_root_ca_cert(const char *root_ca_pem);
+
+    /** Set the client certificate and private key for mutual authentication
+     *
+     *  @param client_cert            Client certificate in DER or PEM format
+     *  @param client_cert_len        Length of the certificate in bytes,
+     *                                including the terminating NUL for PEM
+     *  @param client_private_key     Client private key in DER or PEM format
+     *  @param client_private_key_len Length of the key in bytes, including
+     *                                the terminating NUL for PEM
+     *  @return                       0 on success, negative error code on failure
+     */
+    nsapi_error_t set_client_cert_key(const void *client_cert, size_t client_cert_len,
+                                      const void *client_private_key, size_t client_private_key_len);
+
+    /** Set the client certificate and private key for mutual authentication
+     *
+     *  @param client_cert_pem        Client certificate as a NUL-terminated PEM string
+     *  @param client_private_key_pem Client private key as a NUL-terminated PEM string
+     *  @return                       0 on success, negative error code on failure
+     */
+    nsapi_error_t set_client_cert_key(const char *client_cert_pem, const char *client_private_key_pem);
+
+    /** Continue non-blocking handshakes from an event queue
+     *
+     *  With a queue set, a handshake started by a non-blocking connect()
+     *  is driven forward from the queue's context as socket events
+     *  arrive, instead of requiring the caller to repeat connect(). The
+     *  sigio callback fires when the handshake has finished either way.
+     *
+     *  @param queue Queue the handshake continuations are dispatched on,
+     *               NULL to return to the repeat-call model
+     */
+    void set_event_queue(events::EventQueue *queue);
+
+    /** Connect to a remote host and complete the TLS handshake
+     *
+     *  The hostname is used both for DNS resolution and for SNI and
+     *  certificate verification.
+     *
+     *  @param host     Hostname of the remote host
+     *  @param port     Port of the remote host
+     *  @return         0 on success, negative error code on failure;
+     *                  NSAPI_ERROR_IN_PROGRESS while a non-blocking
+     *                  handshake is under way
+     */
+    nsapi_error_t connect(const char *host, uint16_t port);
+
+    /** Connect to a remote host and complete the TLS handshake
+     *
+     *  Without a hostname, SNI is not sent and the peer certificate is
+     *  verified against the trust chain only.
+     *
+     *  @param address  The SocketAddress of the remote host
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t connect(const SocketAddress &address);
+
+    /** Send data over the TLS connection
+     *
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+
+    /** Receive data over the TLS connection
+     *
+     *  @param data     Destination buffer for data received from the host
+     *  @param size     Size of the buffer in bytes
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure, 0 on orderly shutdown by the peer
+     */
+    virtual nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
+
+    /** Close the connection
+     *
+     *  Sends the TLS close notify if the handshake had completed, frees
+     *  the TLS state and closes the underlying socket.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t close();
+
+protected:
+    virtual void event();
+
+private:
+    // mbed TLS BIO callbacks, routed to the underlying TCP socket
+    static int ssl_send_cb(void *ctx, const unsigned char *buf, size_t len);
+    static int ssl_recv_cb(void *ctx, unsigned char *buf, size_t len);
+
+    nsapi_error_t tls_init();
+    void tls_free();
+    nsapi_error_t handshake_continue();
+    void handshake_deferred();
+    nsapi_error_t connect_common(const char *host, const SocketAddress *address, uint16_t port);
+
+    void session_cache_store();
+    void session_cache_restore();
+
+    mbedtls_entropy_context _entropy;
+    mbedtls_ctr_drbg_context _ctr_drbg;
+    mbedtls_ssl_context _ssl;
+    mbedtls_ssl_config _conf;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    mbedtls_x509_crt _cacert;
+    mbedtls_x509_crt _clicert;
+    mbedtls_pk_context _pkey;
+#endif
+    char _hostname[64];
+    events::EventQueue *_queue;
+    PlatformMutex _ssl_lock;
+    bool _tls_initialized;
+    bool _cacert_loaded;
+    bool _clicert_loaded;
+    bool _tls_connected;
+    volatile bool _handshake_in_progress;
+    volatile bool _handshake_deferred_pending;
+};
+
+#endif
+
+#endif
+
+/** @}*/
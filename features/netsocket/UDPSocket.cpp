@@ -158,6 +158,147 @@ nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer,
     return ret;
 }
 
+nsapi_size_or_error_t UDPSocket::send_multiple(socket_datagram_t *datagrams, int count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret = 0;
+    int sent = 0;
+
+    _writers++;
+
+    while (sent < count) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        socket_datagram_t *msg = &datagrams[sent];
+        nsapi_size_or_error_t result = _stack->socket_sendto(_socket, msg->address, msg->data, msg->size);
+        if (result >= 0) {
+            msg->result = result;
+            sent++;
+        } else if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != result)) {
+            msg->result = result;
+            ret = result;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+         _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return sent ? sent : ret;
+}
+
+nsapi_size_or_error_t UDPSocket::recv_multiple(socket_datagram_t *datagrams, int count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret = 0;
+    int received = 0;
+
+    _readers++;
+
+    while (received < count) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        socket_datagram_t *msg = &datagrams[received];
+        nsapi_size_or_error_t result = _stack->socket_recvfrom(_socket, &msg->address, msg->data, msg->size);
+
+        if (result >= 0) {
+            // Filter incomming packets using connected peer address
+            if (_remote_peer && !(_remote_peer == msg->address)) {
+                continue;
+            }
+            msg->result = result;
+            received++;
+        } else if (NSAPI_ERROR_WOULD_BLOCK == result) {
+            if (received > 0) {
+                // Queue drained - return what the batch got so far
+                break;
+            }
+            if (0 == _timeout) {
+                ret = result;
+                break;
+            }
+
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        } else {
+            msg->result = result;
+            ret = result;
+            break;
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+         _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return received ? received : ret;
+}
+
+nsapi_error_t UDPSocket::set_recv_callback(mbed::Callback<void(const void *, nsapi_size_t,
+        const SocketAddress &)> callback)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        _recv_callback = callback;
+        ret = _stack->socket_recv_callback(_socket,
+                callback ? &UDPSocket::recv_callback_trampoline : NULL, this);
+        if (ret != NSAPI_ERROR_OK) {
+            _recv_callback = NULL;
+        }
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+void UDPSocket::recv_callback_trampoline(void *data, const void *payload,
+        nsapi_size_t size, const SocketAddress &address)
+{
+    UDPSocket *self = static_cast<UDPSocket *>(data);
+    self->_recv_callback(payload, size, address);
+}
+
 nsapi_size_or_error_t UDPSocket::recv(void *buffer, nsapi_size_t size)
 {
     return recvfrom(NULL, buffer, size);
@@ -28,6 +28,16 @@
 
 /** UDP socket
  */
+/** Describes one datagram of a UDPSocket::send_multiple() or
+ *  UDPSocket::recv_multiple() batch
+ */
+typedef struct socket_datagram {
+    SocketAddress address;          /**< Destination on send, filled with the source on recv */
+    void *data;                     /**< Payload to send or buffer to receive into */
+    nsapi_size_t size;              /**< Payload size on send, buffer capacity on recv */
+    nsapi_size_or_error_t result;   /**< Bytes transferred for this datagram or negative error code */
+} socket_datagram_t;
+
 class UDPSocket : public InternetSocket {
 public:
     /** Create an uninitialized socket
@@ -117,6 +127,69 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
             void *data, nsapi_size_t size);
 
+    /** Send a batch of datagrams over a UDP socket
+     *
+     *  Sends each datagram of the batch to its own address under a single
+     *  lock acquisition, so a burst of small datagrams pays the socket path
+     *  overhead once instead of per packet. Datagrams are sent in order and
+     *  each element's result field is filled with the bytes sent or a
+     *  negative error code.
+     *
+     *  By default, send_multiple blocks until every datagram is sent. If
+     *  socket is set to non-blocking or times out, the batch may be cut
+     *  short and the number sent so far is returned.
+     *
+     *  @param datagrams  Array of datagrams to send
+     *  @param count      Number of elements in datagrams
+     *  @return           Number of datagrams sent on success, negative error
+     *                    code if none could be sent
+     */
+    nsapi_size_or_error_t send_multiple(socket_datagram_t *datagrams, int count);
+
+    /** Receive a batch of datagrams over a UDP socket
+     *
+     *  Receives up to count datagrams under a single lock acquisition,
+     *  filling each element's address, data and result fields. If the socket
+     *  is connected, only packets coming from the connected peer address are
+     *  accepted.
+     *
+     *  By default, recv_multiple blocks until at least one datagram is
+     *  received, then drains whatever else is already queued without
+     *  blocking again. If socket is set to non-blocking or times out with no
+     *  datagram, NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @param datagrams  Array of datagrams to fill
+     *  @param count      Number of elements in datagrams
+     *  @return           Number of datagrams received on success, negative
+     *                    error code if none was received
+     */
+    nsapi_size_or_error_t recv_multiple(socket_datagram_t *datagrams, int count);
+
+    /** Register a per-datagram receive callback
+     *
+     *  Opt-in fast path for trivial consumers: instead of waking a reader
+     *  thread to call recvfrom() once per datagram, the network stack
+     *  invokes the callback directly from its own thread with a view of
+     *  the payload and the source address - zero thread hops and zero
+     *  copies. The payload view is only valid for the duration of the
+     *  call; copy anything that must outlive it.
+     *
+     *  While a callback is registered, datagrams are consumed by it and
+     *  do not reach recv()/recvfrom(). Pass an empty callback to
+     *  unregister and restore queued delivery.
+     *
+     *  The callback runs in the stack's thread context and must not block
+     *  or call other socket operations.
+     *
+     *  @param callback Function to call per received datagram, or an
+     *                  empty callback to unregister
+     *  @return         0 on success, negative error code on failure
+     *                  (NSAPI_ERROR_UNSUPPORTED if the stack has no
+     *                  direct delivery path)
+     */
+    nsapi_error_t set_recv_callback(mbed::Callback<void(const void *data, nsapi_size_t size,
+            const SocketAddress &address)> callback);
+
     /** Set remote peer address
      *
      *  Set the remote address for next send() call and filtering
@@ -180,6 +253,12 @@ public:
 
 protected:
     virtual nsapi_protocol_t get_proto();
+
+private:
+    static void recv_callback_trampoline(void *data, const void *payload,
+            nsapi_size_t size, const SocketAddress &address);
+
+    mbed::Callback<void(const void *, nsapi_size_t, const SocketAddress &)> _recv_callback;
 };
 
 
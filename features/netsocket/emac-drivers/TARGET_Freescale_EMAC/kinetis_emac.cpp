@@ -76,8 +76,14 @@ extern "C" void kinetis_init_eth_hardware(void);
 
 #define PHY_TASK_PERIOD_MS      200
 
-Kinetis_EMAC::Kinetis_EMAC() : xTXDCountSem(ENET_TX_RING_LEN, ENET_TX_RING_LEN), hwaddr()
+Kinetis_EMAC::Kinetis_EMAC() : xTXDCountSem(ENET_TX_RING_LEN, ENET_TX_RING_LEN), hwaddr(),
+    powered(false)
 {
+    ring_config.rx_ring_len = ENET_RX_RING_LEN;
+    ring_config.tx_ring_len = ENET_TX_RING_LEN;
+    ring_config.rx_frames_per_irq = 1;
+    ring_config.rx_irq_delay_us = 0;
+    ring_config.rx_burst_limit = 0;
 }
 
 static osThreadId_t create_new_thread(const char *threadName, void (*thread)(void *arg), void *arg, int stacksize, osPriority_t priority, os_thread_t *thread_cb)
@@ -130,7 +136,7 @@ void Kinetis_EMAC::tx_reclaim()
   // Traverse all descriptors, looking for the ones modified by the uDMA
   while((tx_consume_index != tx_produce_index) &&
         (!(g_handle.txBdDirty->control & ENET_BUFFDESCRIPTOR_TX_READY_MASK))) {
-      memory_manager->free(tx_buff[tx_consume_index % ENET_TX_RING_LEN]);
+      memory_manager->free(tx_buff[tx_consume_index % ring_config.tx_ring_len]);
       if (g_handle.txBdDirty->control & ENET_BUFFDESCRIPTOR_TX_WRAP_MASK)
         g_handle.txBdDirty = g_handle.txBdBase;
       else
@@ -189,12 +195,12 @@ bool Kinetis_EMAC::low_level_init_successful()
     enet_config_t config;
 
     // Allocate RX descriptors
-    rx_desc_start_addr = (uint8_t *)calloc(1, sizeof(enet_rx_bd_struct_t) * ENET_RX_RING_LEN + ENET_BUFF_ALIGNMENT);
+    rx_desc_start_addr = (uint8_t *)calloc(1, sizeof(enet_rx_bd_struct_t) * ring_config.rx_ring_len + ENET_BUFF_ALIGNMENT);
     if(!rx_desc_start_addr)
         return false;
 
     // Allocate TX descriptors
-    tx_desc_start_addr = (uint8_t *)calloc(1, sizeof(enet_tx_bd_struct_t) * ENET_TX_RING_LEN + ENET_BUFF_ALIGNMENT);
+    tx_desc_start_addr = (uint8_t *)calloc(1, sizeof(enet_tx_bd_struct_t) * ring_config.tx_ring_len + ENET_BUFF_ALIGNMENT);
     if(!tx_desc_start_addr)
         return false;
 
@@ -202,7 +208,7 @@ bool Kinetis_EMAC::low_level_init_successful()
     tx_desc_start_addr = (uint8_t *)ENET_ALIGN(tx_desc_start_addr, ENET_BUFF_ALIGNMENT);
 
     /* Create buffers for each receive BD */
-    for (i = 0; i < ENET_RX_RING_LEN; i++) {
+    for (i = 0; i < ring_config.rx_ring_len; i++) {
         rx_buff[i] = memory_manager->alloc_heap(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT);
         if (NULL == rx_buff[i])
             return false;
@@ -212,10 +218,16 @@ bool Kinetis_EMAC::low_level_init_successful()
 
     tx_consume_index = tx_produce_index = 0;
 
+    /* Park the TX semaphore tokens for the descriptors a shrunk ring
+     * leaves outside the configured length */
+    for (uint32_t j = ring_config.tx_ring_len; j < ENET_TX_RING_LEN; j++) {
+        xTXDCountSem.wait(0);
+    }
+
     /* prepare the buffer configuration. */
     enet_buffer_config_t buffCfg = {
-        ENET_RX_RING_LEN,
-        ENET_TX_RING_LEN,
+        (uint16_t)ring_config.rx_ring_len,
+        (uint16_t)ring_config.tx_ring_len,
         ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT),
         0,
         (volatile enet_rx_bd_struct_t *)rx_desc_start_addr,
@@ -368,10 +380,19 @@ void Kinetis_EMAC::thread_function(void* pvParameters)
 void Kinetis_EMAC::packet_rx()
 {
     static int idx = 0;
+    uint32_t budget = ring_config.rx_burst_limit;
 
     while ((g_handle.rxBdCurrent->control & ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK) == 0) {
         input(idx);
-        idx = (idx + 1) % ENET_RX_RING_LEN;
+        idx = (idx + 1) % ring_config.rx_ring_len;
+        if (budget != 0 && --budget == 0) {
+            /* Burst limit reached - re-signal so the remaining frames are
+             * handled on the next wakeup, after TX reclaim got a turn */
+            if ((g_handle.rxBdCurrent->control & ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK) == 0) {
+                osThreadFlagsSet(thread, FLAG_RX);
+            }
+            break;
+        }
     }
 }
 
@@ -421,7 +442,7 @@ bool Kinetis_EMAC::link_out(emac_mem_buf_t *buf)
     TXLockMutex.lock();
 
     /* Save the buffer so that it can be freed when transmit is done */
-    tx_buff[tx_produce_index % ENET_TX_RING_LEN] = buf;
+    tx_buff[tx_produce_index % ring_config.tx_ring_len] = buf;
     tx_produce_index += 1;
 
     /* Setup transfers */
@@ -514,6 +535,46 @@ bool Kinetis_EMAC::power_up()
 
     phy_task_handle = mbed::mbed_event_queue()->call_every(PHY_TASK_PERIOD_MS, mbed::callback(this, &Kinetis_EMAC::phy_task));
 
+    powered = true;
+
+    return true;
+}
+
+bool Kinetis_EMAC::get_ring_config(ring_config_t &config) const
+{
+    config = ring_config;
+    return true;
+}
+
+bool Kinetis_EMAC::set_ring_config(const ring_config_t &config)
+{
+    if (powered) {
+        return false;
+    }
+
+    /* The buffer tables are sized at build time, so the configured
+     * lengths are the ceiling; at least two descriptors are needed to
+     * keep the rings turning */
+    ring_config.rx_ring_len = config.rx_ring_len;
+    if (ring_config.rx_ring_len < 2) {
+        ring_config.rx_ring_len = 2;
+    } else if (ring_config.rx_ring_len > ENET_RX_RING_LEN) {
+        ring_config.rx_ring_len = ENET_RX_RING_LEN;
+    }
+
+    ring_config.tx_ring_len = config.tx_ring_len;
+    if (ring_config.tx_ring_len < 2) {
+        ring_config.tx_ring_len = 2;
+    } else if (ring_config.tx_ring_len > ENET_TX_RING_LEN) {
+        ring_config.tx_ring_len = ENET_TX_RING_LEN;
+    }
+
+    /* The ENET has no RX interrupt moderation */
+    ring_config.rx_frames_per_irq = 1;
+    ring_config.rx_irq_delay_us = 0;
+
+    ring_config.rx_burst_limit = config.rx_burst_limit;
+
     return true;
 }
 
@@ -136,6 +136,29 @@ public:
      */
     virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
 
+    /**
+     * Return the active descriptor ring configuration
+     *
+     * @param config Structure to fill in
+     * @return       True, ring configuration is supported
+     */
+    virtual bool get_ring_config(ring_config_t &config) const;
+
+    /**
+     * Set the descriptor ring configuration
+     *
+     * Ring lengths are clamped to the build-time maximums
+     * (kinetis-emac.rx-ring-len/tx-ring-len, which size the buffer
+     * tables); the ENET has no RX interrupt moderation, so
+     * rx_frames_per_irq and rx_irq_delay_us are clamped to an interrupt
+     * per frame. rx_burst_limit bounds the frames handed to the stack
+     * per worker thread wakeup.
+     *
+     * @param config Requested configuration
+     * @return       True if accepted (possibly clamped), false after power_up()
+     */
+    virtual bool set_ring_config(const ring_config_t &config);
+
 private:
     bool low_level_init_successful();
     void rx_isr();
@@ -165,6 +188,8 @@ private:
     };
     PHY_STATE prev_state;
     uint8_t hwaddr[KINETIS_HWADDR_SIZE];
+    ring_config_t ring_config; /**< Active ring configuration */
+    bool powered; /**< Set once power_up() succeeds, freezes the ring configuration */
 };
 
 #endif /* KINETIS_EMAC_H_ */
@@ -37,8 +37,10 @@
 #include "netsocket/MeshInterface.h"
 
 #include "netsocket/Socket.h"
+#include "netsocket/SocketSet.h"
 #include "netsocket/UDPSocket.h"
 #include "netsocket/TCPSocket.h"
+#include "netsocket/TCPSocketPool.h"
 #include "netsocket/TCPServer.h"
 
 #endif
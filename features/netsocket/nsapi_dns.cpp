@@ -28,8 +28,16 @@
 #include "OnboardNetworkStack.h"
 #include "Kernel.h"
 #include "PlatformMutex.h"
+#include "Semaphore.h"
 #include "SingletonPtr.h"
 
+#if MBED_CONF_NSAPI_DNS_CACHE_PERSIST
+#include "nvstore.h"
+#if NVSTORE_ENABLED
+#define DNS_CACHE_PERSIST 1
+#endif
+#endif
+
 #define CLASS_IN 1
 
 #define RR_A 1
@@ -43,6 +51,8 @@
 #define DNS_QUERY_QUEUE_SIZE 5
 #define DNS_HOST_NAME_MAX_LEN 255
 #define DNS_TIMER_TIMEOUT 100
+#define DNS_NEGATIVE_CACHE_SIZE 3
+#define DNS_INFLIGHT_QUERIES 3
 
 struct DNS_CACHE {
     nsapi_addr_t address;
@@ -51,6 +61,23 @@ struct DNS_CACHE {
     uint64_t accessed;     /*!< last accessed */
 };
 
+struct DNS_NEGATIVE_CACHE {
+    char *host;
+    uint64_t expires;      /*!< time to live in milliseconds */
+};
+
+struct DNS_INFLIGHT {
+    char *host;
+    NetworkStack *stack;
+    nsapi_version_t version;
+    rtos::Semaphore *done_sem;
+    nsapi_addr_t address;  /*!< first address of the answer, valid when result > 0 */
+    nsapi_size_or_error_t result;
+    uint8_t users;         /*!< querying thread plus waiters */
+    uint8_t waiters;       /*!< waiters still blocked on done_sem */
+    bool done;
+};
+
 struct SOCKET_CB_DATA {
     call_in_callback_cb_t call_in_cb;
     NetworkStack *stack;
@@ -78,6 +105,7 @@ struct DNS_QUERY {
     uint32_t total_timeout;
     uint32_t socket_timeout;
     uint16_t dns_message_id;
+    uint16_t dns_message_id_aaaa;
     uint8_t dns_server;
     uint8_t retries;
     uint8_t total_attempts;
@@ -88,6 +116,14 @@ struct DNS_QUERY {
 
 static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl);
 static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+static void nsapi_dns_cache_add_negative(const char *host);
+static bool nsapi_dns_cache_find_negative(const char *host);
+static void nsapi_dns_cache_ensure_loaded();
+static void nsapi_dns_cache_save();
+
+static DNS_INFLIGHT *nsapi_dns_inflight_attach(NetworkStack *stack, const char *host, nsapi_version_t version, bool *owner);
+static nsapi_size_or_error_t nsapi_dns_inflight_wait(DNS_INFLIGHT *inflight, nsapi_addr_t *addr);
+static void nsapi_dns_inflight_finish(DNS_INFLIGHT *inflight, nsapi_size_or_error_t result, const nsapi_addr_t *addr);
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr);
 
@@ -112,11 +148,15 @@ static nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
 };
 
 static DNS_CACHE *dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static DNS_NEGATIVE_CACHE *dns_negative_cache[DNS_NEGATIVE_CACHE_SIZE];
 static uint16_t dns_message_id = 1;
 static int dns_unique_id = 1;
 static DNS_QUERY *dns_query_queue[DNS_QUERY_QUEUE_SIZE];
+static DNS_INFLIGHT *dns_inflight[DNS_INFLIGHT_QUERIES];
 // Protects cache shared between blocking and asynchronous calls
 static SingletonPtr<PlatformMutex> dns_cache_mutex;
+// Protects the in-flight query table shared between blocking calls
+static SingletonPtr<PlatformMutex> dns_inflight_mutex;
 // Protects from several threads running asynchronous DNS
 static SingletonPtr<PlatformMutex> dns_mutex;
 static SingletonPtr<call_in_callback_cb_t> dns_call_in;
@@ -318,6 +358,17 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_
 
     dns_cache_mutex->lock();
 
+    nsapi_dns_cache_ensure_loaded();
+
+    // A fresh address supersedes a cached negative answer
+    for (int i = 0; i < DNS_NEGATIVE_CACHE_SIZE; i++) {
+        if (dns_negative_cache[i] && strcmp(dns_negative_cache[i]->host, host) == 0) {
+            delete dns_negative_cache[i]->host;
+            delete dns_negative_cache[i];
+            dns_negative_cache[i] = NULL;
+        }
+    }
+
     int index = -1;
     uint64_t accessed = UINT64_MAX;
 
@@ -351,6 +402,7 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_
         uint64_t ms_count = rtos::Kernel::get_ms_count();
         dns_cache[index]->expires = ms_count + (uint64_t) ttl * 1000;
         dns_cache[index]->accessed = ms_count;
+        nsapi_dns_cache_save();
     }
 
     dns_cache_mutex->unlock();
@@ -362,6 +414,8 @@ static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t vers
 
     dns_cache_mutex->lock();
 
+    nsapi_dns_cache_ensure_loaded();
+
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
         if (dns_cache[i]) {
             uint64_t ms_count = rtos::Kernel::get_ms_count();
@@ -386,6 +440,339 @@ static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t vers
     return ret_val;
 }
 
+static void nsapi_dns_cache_add_negative(const char *host)
+{
+#if MBED_CONF_NSAPI_DNS_NEGATIVE_CACHE_TTL > 0
+    dns_cache_mutex->lock();
+
+    int index = -1;
+
+    // Refreshes an existing entry for the host
+    for (int i = 0; i < DNS_NEGATIVE_CACHE_SIZE; i++) {
+        if (dns_negative_cache[i] && strcmp(dns_negative_cache[i]->host, host) == 0) {
+            index = i;
+            break;
+        }
+    }
+
+    // Otherwise takes a free or the soonest expiring entry
+    if (index < 0) {
+        uint64_t expires = UINT64_MAX;
+        for (int i = 0; i < DNS_NEGATIVE_CACHE_SIZE; i++) {
+            if (!dns_negative_cache[i]) {
+                index = i;
+                break;
+            } else if (dns_negative_cache[i]->expires <= expires) {
+                expires = dns_negative_cache[i]->expires;
+                index = i;
+            }
+        }
+    }
+
+    if (!dns_negative_cache[index]) {
+        dns_negative_cache[index] = new (std::nothrow) DNS_NEGATIVE_CACHE;
+        if (!dns_negative_cache[index]) {
+            dns_cache_mutex->unlock();
+            return;
+        }
+        dns_negative_cache[index]->host = NULL;
+    }
+
+    delete dns_negative_cache[index]->host;
+    dns_negative_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
+    if (!dns_negative_cache[index]->host) {
+        delete dns_negative_cache[index];
+        dns_negative_cache[index] = NULL;
+        dns_cache_mutex->unlock();
+        return;
+    }
+    strcpy(dns_negative_cache[index]->host, host);
+    dns_negative_cache[index]->expires = rtos::Kernel::get_ms_count() +
+            (uint64_t) MBED_CONF_NSAPI_DNS_NEGATIVE_CACHE_TTL * 1000;
+
+    dns_cache_mutex->unlock();
+#else
+    (void) host;
+#endif
+}
+
+static bool nsapi_dns_cache_find_negative(const char *host)
+{
+    bool found = false;
+
+#if MBED_CONF_NSAPI_DNS_NEGATIVE_CACHE_TTL > 0
+    dns_cache_mutex->lock();
+
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+
+    for (int i = 0; i < DNS_NEGATIVE_CACHE_SIZE; i++) {
+        if (dns_negative_cache[i]) {
+            // Checks all entries for expired entries
+            if (ms_count > dns_negative_cache[i]->expires) {
+                delete dns_negative_cache[i]->host;
+                delete dns_negative_cache[i];
+                dns_negative_cache[i] = NULL;
+            } else if (strcmp(dns_negative_cache[i]->host, host) == 0) {
+                found = true;
+            }
+        }
+    }
+
+    dns_cache_mutex->unlock();
+#else
+    (void) host;
+#endif
+
+    return found;
+}
+
+#if DNS_CACHE_PERSIST
+
+/* The cache is mirrored to NVStore as one flat record so resolutions survive
+ * a reboot: per entry {nsapi_addr_t, uint32_t remaining ttl in seconds,
+ * uint8_t host length, host characters}. Remaining TTLs are measured at save
+ * time and restart on boot - without a wall clock the time spent powered off
+ * cannot be charged against them. Callers hold dns_cache_mutex. */
+
+static bool dns_cache_loaded = false;
+
+static void nsapi_dns_cache_ensure_loaded()
+{
+    if (dns_cache_loaded) {
+        return;
+    }
+    dns_cache_loaded = true;
+
+    uint16_t size = 0;
+    if (NVStore::get_instance().get_item_size(NVSTORE_DNS_CACHE_KEY, size) != NVSTORE_SUCCESS || size == 0) {
+        return;
+    }
+
+    uint8_t *buf = (uint8_t *)malloc(size);
+    if (!buf) {
+        return;
+    }
+
+    uint16_t actual = 0;
+    if (NVStore::get_instance().get(NVSTORE_DNS_CACHE_KEY, size, buf, actual) != NVSTORE_SUCCESS) {
+        free(buf);
+        return;
+    }
+
+    const uint8_t *p = buf;
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+    int index = 0;
+
+    while ((index < MBED_CONF_NSAPI_DNS_CACHE_SIZE) &&
+           (p + sizeof(nsapi_addr_t) + sizeof(uint32_t) + 1 <= buf + actual)) {
+        nsapi_addr_t address;
+        uint32_t ttl;
+        memcpy(&address, p, sizeof(address));
+        p += sizeof(address);
+        memcpy(&ttl, p, sizeof(ttl));
+        p += sizeof(ttl);
+        uint8_t host_len = *p++;
+        if (p + host_len > buf + actual) {
+            break;
+        }
+
+        DNS_CACHE *entry = new (std::nothrow) DNS_CACHE;
+        if (!entry) {
+            break;
+        }
+        entry->host = new (std::nothrow) char[host_len + 1];
+        if (!entry->host) {
+            delete entry;
+            break;
+        }
+        memcpy(entry->host, p, host_len);
+        entry->host[host_len] = '\0';
+        p += host_len;
+        entry->address = address;
+        entry->expires = ms_count + (uint64_t) ttl * 1000;
+        entry->accessed = ms_count;
+        dns_cache[index++] = entry;
+    }
+
+    free(buf);
+}
+
+static void nsapi_dns_cache_save()
+{
+    uint8_t *buf = (uint8_t *)malloc(MBED_CONF_NSAPI_DNS_CACHE_SIZE *
+            (sizeof(nsapi_addr_t) + sizeof(uint32_t) + 1 + DNS_HOST_NAME_MAX_LEN));
+    if (!buf) {
+        return;
+    }
+
+    uint8_t *p = buf;
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
+        if (!dns_cache[i] || ms_count > dns_cache[i]->expires) {
+            continue;
+        }
+        uint32_t ttl = (uint32_t)((dns_cache[i]->expires - ms_count) / 1000);
+        uint8_t host_len = (uint8_t)strlen(dns_cache[i]->host);
+        memcpy(p, &dns_cache[i]->address, sizeof(nsapi_addr_t));
+        p += sizeof(nsapi_addr_t);
+        memcpy(p, &ttl, sizeof(ttl));
+        p += sizeof(ttl);
+        *p++ = host_len;
+        memcpy(p, dns_cache[i]->host, host_len);
+        p += host_len;
+    }
+
+    NVStore::get_instance().set(NVSTORE_DNS_CACHE_KEY, (uint16_t)(p - buf), buf);
+    free(buf);
+}
+
+#else
+
+static void nsapi_dns_cache_ensure_loaded()
+{
+}
+
+static void nsapi_dns_cache_save()
+{
+}
+
+#endif // DNS_CACHE_PERSIST
+
+// Joins an identical lookup already on the wire, or registers this one so
+// later callers can join it. Returns NULL when in-flight tracking is
+// unavailable and the caller should simply query on its own.
+static DNS_INFLIGHT *nsapi_dns_inflight_attach(NetworkStack *stack, const char *host, nsapi_version_t version, bool *owner)
+{
+    dns_inflight_mutex->lock();
+
+    for (int i = 0; i < DNS_INFLIGHT_QUERIES; i++) {
+        DNS_INFLIGHT *inflight = dns_inflight[i];
+        if (inflight && inflight->stack == stack && inflight->version == version &&
+                strcmp(inflight->host, host) == 0) {
+            inflight->users++;
+            inflight->waiters++;
+            *owner = false;
+            dns_inflight_mutex->unlock();
+            return inflight;
+        }
+    }
+
+    *owner = true;
+
+    int index = -1;
+    for (int i = 0; i < DNS_INFLIGHT_QUERIES; i++) {
+        if (!dns_inflight[i]) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index < 0) {
+        dns_inflight_mutex->unlock();
+        return NULL;
+    }
+
+    DNS_INFLIGHT *inflight = new (std::nothrow) DNS_INFLIGHT;
+    if (!inflight) {
+        dns_inflight_mutex->unlock();
+        return NULL;
+    }
+
+    inflight->host = (char *)malloc(strlen(host) + 1);
+    inflight->done_sem = new (std::nothrow) rtos::Semaphore(0);
+    if (!inflight->host || !inflight->done_sem) {
+        free(inflight->host);
+        delete inflight->done_sem;
+        delete inflight;
+        dns_inflight_mutex->unlock();
+        return NULL;
+    }
+
+    strcpy(inflight->host, host);
+    inflight->stack = stack;
+    inflight->version = version;
+    inflight->result = NSAPI_ERROR_DNS_FAILURE;
+    inflight->users = 1;
+    inflight->waiters = 0;
+    inflight->done = false;
+    dns_inflight[index] = inflight;
+
+    dns_inflight_mutex->unlock();
+
+    return inflight;
+}
+
+// Drops one reference, called with dns_inflight_mutex held; the last
+// participant out frees the entry
+static void nsapi_dns_inflight_release(DNS_INFLIGHT *inflight)
+{
+    if (--inflight->users == 0) {
+        free(inflight->host);
+        delete inflight->done_sem;
+        delete inflight;
+    }
+}
+
+// Publishes the answer of the owning query and wakes every waiter
+static void nsapi_dns_inflight_finish(DNS_INFLIGHT *inflight, nsapi_size_or_error_t result, const nsapi_addr_t *addr)
+{
+    dns_inflight_mutex->lock();
+
+    inflight->done = true;
+    inflight->result = result;
+    if (result > 0) {
+        inflight->address = *addr;
+    }
+
+    // Unlink so a lookup arriving after the answer starts fresh (and takes
+    // the cache hit) instead of joining a finished query
+    for (int i = 0; i < DNS_INFLIGHT_QUERIES; i++) {
+        if (dns_inflight[i] == inflight) {
+            dns_inflight[i] = NULL;
+            break;
+        }
+    }
+
+    while (inflight->waiters) {
+        inflight->waiters--;
+        inflight->done_sem->release();
+    }
+
+    nsapi_dns_inflight_release(inflight);
+
+    dns_inflight_mutex->unlock();
+}
+
+// Blocks until the owning query answers and shares its first address
+static nsapi_size_or_error_t nsapi_dns_inflight_wait(DNS_INFLIGHT *inflight, nsapi_addr_t *addr)
+{
+    // bounded by the owning query's own worst case: every server, every retry
+    inflight->done_sem->wait(MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS *
+            MBED_CONF_NSAPI_DNS_RESPONSE_WAIT_TIME + 1000);
+
+    dns_inflight_mutex->lock();
+
+    nsapi_size_or_error_t result;
+    if (inflight->done) {
+        result = inflight->result;
+        if (result > 0) {
+            *addr = inflight->address;
+            result = 1;
+        }
+    } else {
+        // timed out before the owning query answered; stop waiting for it
+        inflight->waiters--;
+        result = NSAPI_ERROR_TIMEOUT;
+    }
+
+    nsapi_dns_inflight_release(inflight);
+
+    dns_inflight_mutex->unlock();
+
+    return result;
+}
+
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr)
 {
     bool dns_addr_set = false;
@@ -437,10 +824,25 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
         return 1;
     }
 
+    if (nsapi_dns_cache_find_negative(host)) {
+        return NSAPI_ERROR_DNS_FAILURE;
+    }
+
+    // coalesce with an identical lookup already on the wire, so several
+    // sockets connecting to one host by name cost one query between them
+    bool inflight_owner = true;
+    DNS_INFLIGHT *inflight = nsapi_dns_inflight_attach(stack, host, version, &inflight_owner);
+    if (inflight && !inflight_owner) {
+        return nsapi_dns_inflight_wait(inflight, addr);
+    }
+
     // create a udp socket
     UDPSocket socket;
     int err = socket.open(stack);
     if (err) {
+        if (inflight) {
+            nsapi_dns_inflight_finish(inflight, err, NULL);
+        }
         return err;
     }
 
@@ -449,6 +851,9 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
     // create network packet
     uint8_t * const packet = (uint8_t *)malloc(DNS_BUFFER_SIZE);
     if (!packet) {
+        if (inflight) {
+            nsapi_dns_inflight_finish(inflight, NSAPI_ERROR_NO_MEMORY, NULL);
+        }
         return NSAPI_ERROR_NO_MEMORY;
     }
 
@@ -510,6 +915,10 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
             result = resp;
         } else if (resp < 0) {
             continue;
+        } else {
+            // Server answered with no address - remember briefly so a burst
+            // of lookups for the same host does not repeat the full query
+            nsapi_dns_cache_add_negative(host);
         }
 
         /* The DNS response is final, no need to check other servers */
@@ -522,7 +931,13 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
     // clean up udp
     err = socket.close();
     if (err) {
-        return err;
+        result = err;
+    }
+
+    // the first address answers every coalesced waiter; later lookups for
+    // this host hit the cache instead
+    if (inflight) {
+        nsapi_dns_inflight_finish(inflight, result, addr);
     }
 
     // return result
@@ -617,6 +1032,12 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
         return NSAPI_ERROR_OK;
     }
 
+    if (nsapi_dns_cache_find_negative(host)) {
+        dns_mutex->unlock();
+        callback(NSAPI_ERROR_DNS_FAILURE, NULL);
+        return NSAPI_ERROR_OK;
+    }
+
     int index = -1;
 
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
@@ -659,6 +1080,7 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     query->total_attempts =  MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS;
     query->send_success = 0;
     query->dns_message_id = 0;
+    query->dns_message_id_aaaa = 0;
     query->socket_timeout = 0;
     query->total_timeout = MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS * MBED_CONF_NSAPI_DNS_RESPONSE_WAIT_TIME + 500;
     query->count = 0;
@@ -832,6 +1254,21 @@ static void nsapi_dns_query_async_create(void *ptr)
         return;
     }
 
+    // an earlier query for the same host may have answered and fed the
+    // cache while this one waited its turn on the queue - take the answer
+    // without touching the wire
+    nsapi_addr_t address;
+    if (nsapi_dns_cache_find(query->host, query->version, &address) == NSAPI_ERROR_OK) {
+        SocketAddress addr(address);
+        nsapi_dns_query_async_resp(query, NSAPI_ERROR_OK, &addr);
+        return;
+    }
+
+    if (nsapi_dns_cache_find_negative(query->host)) {
+        nsapi_dns_query_async_resp(query, NSAPI_ERROR_DNS_FAILURE, NULL);
+        return;
+    }
+
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
         if (dns_query_queue[i] && dns_query_queue[i] != query) {
             if (!query->socket && dns_query_queue[i]->socket && dns_query_queue[i]->stack == query->stack) {
@@ -977,8 +1414,9 @@ static void nsapi_dns_query_async_send(void *ptr)
     // send the question
     int len = dns_append_question(packet, query->dns_message_id, query->host, query->version);
 
+    SocketAddress dns_addr;
+
     while (true) {
-        SocketAddress dns_addr;
         nsapi_size_or_error_t err = nsapi_dns_get_server_addr(query->stack, &(query->dns_server), &(query->total_attempts), &(query->send_success), &dns_addr);
         if (err != NSAPI_ERROR_OK) {
             nsapi_dns_query_async_resp(query, NSAPI_ERROR_TIMEOUT, NULL);
@@ -995,6 +1433,20 @@ static void nsapi_dns_query_async_send(void *ptr)
         }
     }
 
+    // For an unspecified version the A and AAAA questions are in flight
+    // simultaneously and whichever family answers first wins
+    if (query->version == NSAPI_UNSPEC) {
+        query->dns_message_id_aaaa = dns_message_id++;
+        if (dns_message_id == 0) {
+            dns_message_id = 1;
+        }
+
+        len = dns_append_question(packet, query->dns_message_id_aaaa, query->host, NSAPI_IPv6);
+        if (query->socket->sendto(dns_addr, packet, len) < 0) {
+            query->dns_message_id_aaaa = 0;
+        }
+    }
+
     query->send_success++;
 
     if (query->total_attempts) {
@@ -1052,7 +1504,9 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
             DNS_QUERY *query = NULL;
 
             for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
-                if (dns_query_queue[i] && dns_query_queue[i]->dns_message_id == id) {
+                if (dns_query_queue[i] && id != 0 &&
+                        (dns_query_queue[i]->dns_message_id == id ||
+                         dns_query_queue[i]->dns_message_id_aaaa == id)) {
                     query = dns_query_queue[i];
                     break;
                 }
@@ -1075,6 +1529,16 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
             if (resp < 0) {
                 delete[] query->addrs;
                 query->addrs = 0;
+            } else if (resp == 0 && query->version == NSAPI_UNSPEC &&
+                       (id == query->dns_message_id ? query->dns_message_id_aaaa : query->dns_message_id) != 0) {
+                // Empty answer for one family, keep waiting on the other question
+                if (id == query->dns_message_id) {
+                    query->dns_message_id = 0;
+                } else {
+                    query->dns_message_id_aaaa = 0;
+                }
+                delete[] query->addrs;
+                query->addrs = 0;
             } else {
                 query->count = resp;
                 query->status = NSAPI_ERROR_DNS_FAILURE; // Used in case failure, otherwise ok
@@ -1122,6 +1586,9 @@ static void nsapi_dns_query_async_response(void *ptr)
             if (query->addr_count > 0) {
                 status = query->count;
             }
+        } else if (status == NSAPI_ERROR_DNS_FAILURE) {
+            // Server answered with no address
+            nsapi_dns_cache_add_negative(query->host);
         }
 
         nsapi_dns_query_async_resp(query, status, addresses);
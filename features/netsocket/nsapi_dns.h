@@ -82,7 +82,9 @@ nsapi_error_t nsapi_dns_query(NetworkStack *stack, const char *host,
  *  @param stack    Network stack as target for DNS query
  *  @param host     Hostname to resolve
  *  @param callback Callback that is called for result
- *  @param version  IP version to resolve (defaults to NSAPI_IPv4)
+ *  @param version  IP version to resolve (defaults to NSAPI_IPv4); with
+ *                  NSAPI_UNSPEC the A and AAAA questions are sent in parallel
+ *                  and the first family to answer is returned
  *  @return         0 on success, negative error code on failure or an unique id that
  *                  represents the hostname translation operation and can be passed to
  *                  cancel, NSAPI_ERROR_DNS_FAILURE indicates the host could not be found
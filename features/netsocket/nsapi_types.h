@@ -155,6 +155,10 @@ typedef enum nsapi_security {
  */
 #define NSAPI_IPv6_SIZE 40
 
+/** Maximum size of an interface name representation, e.g. "en0"
+ */
+#define NSAPI_INTERFACE_NAME_SIZE 8
+
 /** Number of bytes in IPv6 address
  */
 #define NSAPI_IPv6_BYTES 16
@@ -254,6 +258,9 @@ typedef enum nsapi_socket_option {
     NSAPI_RCVBUF,            /*!< Sets recv buffer size */
     NSAPI_ADD_MEMBERSHIP,    /*!< Add membership to multicast address */
     NSAPI_DROP_MEMBERSHIP,   /*!< Drop membership to multicast address */
+    NSAPI_TXPRIO,            /*!< Transmit ahead of bulk traffic at the link layer */
+    NSAPI_NODELAY,           /*!< Disable Nagle coalescing - send small segments immediately */
+    NSAPI_BIND_TO_DEVICE,    /*!< Route the socket's traffic through a particular interface */
 } nsapi_socket_option_t;
 
 /** Supported IP protocol versions of IP stack
@@ -312,6 +319,72 @@ typedef struct nsapi_ip_mreq {
     nsapi_addr_t imr_interface; /* local IP address of interface */
 } nsapi_ip_mreq_t;
 
+/** nsapi_iovec structure
+ *
+ *  One element of a scatter-gather list for vectored socket send/recv.
+ */
+typedef struct nsapi_iovec {
+    void *iov_base;             /* start of the buffer */
+    nsapi_size_t iov_len;       /* length of the buffer in bytes */
+} nsapi_iovec_t;
+
+/** nsapi_socket_stats structure
+ *
+ *  Traffic counters for one socket. On datagram sockets packets count
+ *  datagrams; on stream sockets they count send and receive operations.
+ */
+typedef struct nsapi_socket_stats {
+    uint32_t bytes_sent;        /* bytes successfully passed to the stack */
+    uint32_t bytes_recv;        /* bytes delivered to the application */
+    uint32_t packets_sent;      /* datagrams or send operations completed */
+    uint32_t packets_recv;      /* datagrams or receive operations completed */
+} nsapi_socket_stats_t;
+
+/** nsapi_interface_stats structure
+ *
+ *  Link-level traffic counters for one network interface.
+ */
+typedef struct nsapi_interface_stats {
+    uint32_t bytes_sent;        /* bytes handed to the link driver */
+    uint32_t bytes_recv;        /* bytes received from the link driver */
+    uint32_t packets_sent;      /* frames handed to the link driver */
+    uint32_t packets_recv;      /* frames received from the link driver */
+    uint32_t tx_drops;          /* frames the link driver refused */
+    uint32_t rx_drops;          /* received frames the stack refused */
+} nsapi_interface_stats_t;
+
+/** nsapi_pool_stats structure
+ *
+ *  Usage counters for one fixed-size buffer pool inside a network stack.
+ */
+typedef struct nsapi_pool_stats {
+    const char *name;           /* pool name, valid for the lifetime of the stack, may be NULL */
+    uint32_t avail;             /* configured number of entries */
+    uint32_t used;              /* entries currently in use */
+    uint32_t max;               /* high watermark of entries in use */
+    uint32_t failures;          /* allocations that found the pool empty */
+} nsapi_pool_stats_t;
+
+/** Number of RTT histogram buckets in nsapi_ping_stats_t
+ *
+ *  Bucket i counts replies faster than 2^i milliseconds; the last bucket
+ *  collects everything slower.
+ */
+#define NSAPI_PING_HISTOGRAM_BUCKETS 8
+
+/** nsapi_ping_stats structure
+ *
+ *  Accumulated results of an ICMP echo probe.
+ */
+typedef struct nsapi_ping_stats {
+    uint32_t sent;              /* echo requests sent */
+    uint32_t received;          /* echo replies received */
+    uint32_t min_rtt_ms;        /* fastest reply seen, in milliseconds */
+    uint32_t avg_rtt_ms;        /* mean reply time, in milliseconds */
+    uint32_t max_rtt_ms;        /* slowest reply seen, in milliseconds */
+    uint32_t histogram[NSAPI_PING_HISTOGRAM_BUCKETS]; /* reply RTT distribution */
+} nsapi_ping_stats_t;
+
 /** nsapi_stack_api structure
  *
  *  Common api structure for network stack operations. A network stack
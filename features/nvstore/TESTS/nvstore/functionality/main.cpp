@@ -145,6 +145,34 @@ static void nvstore_basic_functionality_test()
     result = nvstore.set(NVSTORE_NUM_PREDEFINED_KEYS + 1, 17, &(nvstore_testing_buf_set[3]));
     TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
 
+    // Batched sets - no value should reach flash before the commit call,
+    // and repeated updates of the same key should be coalesced
+    result = nvstore.set_batch(8, 12, &(nvstore_testing_buf_set[4]));
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    result = nvstore.get(8, 20, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_NOT_FOUND, result);
+    result = nvstore.set_batch(12, 20, &(nvstore_testing_buf_set[5]));
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    result = nvstore.set_batch(12, 24, &(nvstore_testing_buf_set[6]));
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    result = nvstore.set_batch(19, 10, &(nvstore_testing_buf_set[3]));
+    TEST_ASSERT_EQUAL(NVSTORE_ALREADY_EXISTS, result);
+    result = nvstore.set_batch(64, 10, &(nvstore_testing_buf_set[3]));
+    TEST_ASSERT_EQUAL(NVSTORE_BAD_VALUE, result);
+    result = nvstore.commit();
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    result = nvstore.get(8, 20, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(12, actual_len_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&(nvstore_testing_buf_set[4]), nvstore_testing_buf_get, 12);
+    result = nvstore.get(12, 30, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(24, actual_len_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&(nvstore_testing_buf_set[6]), nvstore_testing_buf_get, 24);
+    // Empty commit should be a benign no op
+    result = nvstore.commit();
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+
     // Make sure set items are also gotten OK after reset
     result = nvstore.deinit();
     TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
@@ -181,6 +209,16 @@ static void nvstore_basic_functionality_test()
     TEST_ASSERT_EQUAL(17, actual_len_bytes);
     TEST_ASSERT_EQUAL_UINT8_ARRAY(&nvstore_testing_buf_set[3], nvstore_testing_buf_get, 17);
 
+    // Committed records should survive reset like regular ones
+    result = nvstore.get(8, 20, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(12, actual_len_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&(nvstore_testing_buf_set[4]), nvstore_testing_buf_get, 12);
+    result = nvstore.get(12, 30, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(24, actual_len_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&(nvstore_testing_buf_set[6]), nvstore_testing_buf_get, 24);
+
     result = nvstore.free_all_keys_by_owner(3);
     TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
 
@@ -21,6 +21,7 @@
 #if NVSTORE_ENABLED
 
 #include "FlashIAP.h"
+#include "events/EventQueue.h"
 #include "mbed_critical.h"
 #include "mbed_assert.h"
 #include "mbed_wait_api.h"
@@ -71,6 +72,11 @@ static const uint32_t max_data_size = 4096;
 
 static const int num_write_retries = 16;
 
+// Background GC starts once used space crosses this percentage of the area,
+// copying this many records per event queue slice
+static const uint32_t gc_trigger_percent = 75;
+static const int gc_records_per_slice = 4;
+
 static const uint8_t blank_flash_val = 0xFF;
 
 // See whether any of these defines are given (by config files)
@@ -141,7 +147,8 @@ static uint32_t crc32(uint32_t init_crc, uint32_t data_size, uint8_t *data_buf)
 
 NVStore::NVStore() : _init_done(0), _init_attempts(0), _active_area(0), _max_keys(NVSTORE_MAX_KEYS),
       _active_area_version(0), _free_space_offset(0), _size(0), _mutex(0), _offset_by_key(0), _flash(0),
-      _min_prog_size(0), _page_buf(0)
+      _min_prog_size(0), _page_buf(0), _pending_sets(0), _pending_last(0), _gc_queue(0),
+      _gc_active(0), _gc_erase_pending(0), _gc_stalled(0), _gc_key(0), _gc_new_area_offset(0)
 {
 }
 
@@ -576,6 +583,151 @@ int NVStore::garbage_collection(uint16_t key, uint16_t flags, uint8_t owner, uin
     return ret;
 }
 
+int NVStore::gc_slice_step()
+{
+    uint32_t curr_offset, next_offset;
+    int copied = 0;
+    int ret;
+
+    // Last phase - the records and master record are already in the new active
+    // area, only the (lengthy) erase of the old one is left.
+    if (_gc_erase_pending) {
+        if (flash_erase_area(1 - _active_area)) {
+            return NVSTORE_WRITE_ERROR;
+        }
+        _gc_erase_pending = 0;
+        _gc_active = 0;
+        return NVSTORE_SUCCESS;
+    }
+
+    while ((_gc_key < _max_keys) && (copied < gc_records_per_slice)) {
+        curr_offset = _offset_by_key[_gc_key];
+        uint16_t save_flags = curr_offset & offs_by_key_flag_mask & ~offs_by_key_area_mask;
+        uint8_t curr_area = (uint8_t)(curr_offset >> offs_by_key_area_bit_pos) & 1;
+        curr_offset &= ~offs_by_key_flag_mask;
+        if ((!curr_offset) || (curr_area != _active_area)) {
+            _gc_key++;
+            continue;
+        }
+        ret = copy_record(curr_area, curr_offset, _gc_new_area_offset, next_offset);
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+        _offset_by_key[_gc_key] = _gc_new_area_offset | (1 - curr_area) << offs_by_key_area_bit_pos | save_flags;
+        _gc_new_area_offset = next_offset;
+        _gc_key++;
+        copied++;
+    }
+
+    if (_gc_key == _max_keys) {
+        // All records copied - publish the new area, leaving the erase of the
+        // old one to the next slice.
+        _active_area_version++;
+        ret = write_master_record(1 - _active_area, _active_area_version, next_offset);
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+        _free_space_offset = _gc_new_area_offset;
+        _active_area = 1 - _active_area;
+        _gc_erase_pending = 1;
+    }
+
+    return NVSTORE_SUCCESS;
+}
+
+int NVStore::gc_finish()
+{
+    int ret;
+
+    while (_gc_active) {
+        ret = gc_slice_step();
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+    }
+    return NVSTORE_SUCCESS;
+}
+
+void NVStore::gc_slice()
+{
+    if (!_init_done || !_gc_queue) {
+        return;
+    }
+
+    _mutex->lock();
+
+    if (!_gc_active) {
+        _mutex->unlock();
+        return;
+    }
+
+    // On a failing slice, just retry it on the next one - flash accesses already
+    // retry internally, so a persistent failure means the device is gone anyway.
+    gc_slice_step();
+
+    if (_gc_active) {
+        if (!_gc_queue->call(this, &NVStore::gc_slice)) {
+            // Queue is full - the next set call will repost us
+            _gc_stalled = 1;
+        }
+    }
+
+    _mutex->unlock();
+}
+
+void NVStore::gc_check_trigger()
+{
+    if (!_gc_queue) {
+        return;
+    }
+
+    if (_gc_active) {
+        if (_gc_stalled && _gc_queue->call(this, &NVStore::gc_slice)) {
+            _gc_stalled = 0;
+        }
+        return;
+    }
+
+    if (_free_space_offset < (_size / 100) * gc_trigger_percent) {
+        return;
+    }
+
+    _gc_key = 0;
+    _gc_new_area_offset = align_up(sizeof(nvstore_record_header_t) + sizeof(master_record_data_t), _min_prog_size);
+    _gc_erase_pending = 0;
+    _gc_stalled = 0;
+    _gc_active = 1;
+    if (!_gc_queue->call(this, &NVStore::gc_slice)) {
+        _gc_stalled = 1;
+    }
+}
+
+int NVStore::set_background_gc(events::EventQueue *queue)
+{
+    int ret = NVSTORE_SUCCESS;
+
+    if (!_init_done) {
+        ret = init();
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+    }
+
+    _mutex->lock();
+
+    if (!queue && _gc_active) {
+        // Can't leave a half done garbage collection behind - finish it now
+        ret = gc_finish();
+    }
+    _gc_queue = queue;
+    if (queue) {
+        gc_check_trigger();
+    }
+
+    _mutex->unlock();
+    return ret;
+}
+
 
 int NVStore::do_get(uint16_t key, uint16_t buf_size, void *buf, uint16_t &actual_size,
                     int validate_only)
@@ -676,6 +828,38 @@ int NVStore::do_set(uint16_t key, uint16_t buf_size, const void *buf, uint16_t f
     _mutex->lock();
 
     owner = (_offset_by_key[key] & offs_by_key_owner_mask) >> offs_by_key_owner_bit_pos;
+
+    if (_gc_active) {
+        // While an incremental GC is in progress, new records must go to the area
+        // being filled - otherwise an update of an already copied key would be
+        // lost when the areas switch.
+        if (_gc_new_area_offset + record_size >= _size) {
+            // Destination area is full - finish the GC now and fall through to
+            // the regular path below.
+            ret = gc_finish();
+            if (ret != NVSTORE_SUCCESS) {
+                _mutex->unlock();
+                return ret;
+            }
+        } else {
+            ret = write_record(1 - _active_area, _gc_new_area_offset, key, flags, owner, buf_size, buf, next_offset);
+            if (ret != NVSTORE_SUCCESS) {
+                _mutex->unlock();
+                return ret;
+            }
+            if (flags & delete_item_flag) {
+                _offset_by_key[key] = 0;
+            } else {
+                _offset_by_key[key] = _gc_new_area_offset | ((1 - _active_area) << offs_by_key_area_bit_pos) |
+                                      (((flags & set_once_flag) != 0) << offs_by_key_set_once_bit_pos) |
+                                      (owner << offs_by_key_owner_bit_pos);
+            }
+            _gc_new_area_offset = next_offset;
+            _mutex->unlock();
+            return NVSTORE_SUCCESS;
+        }
+    }
+
     new_free_space = core_util_atomic_incr_u32(&_free_space_offset, record_size);
     record_offset = new_free_space - record_size;
 
@@ -702,6 +886,8 @@ int NVStore::do_set(uint16_t key, uint16_t buf_size, const void *buf, uint16_t f
                               (owner << offs_by_key_owner_bit_pos);
     }
 
+    gc_check_trigger();
+
     _mutex->unlock();
 
     return NVSTORE_SUCCESS;
@@ -717,6 +903,175 @@ int NVStore::set_once(uint16_t key, uint16_t buf_size, const void *buf)
     return do_set(key, buf_size, buf, set_once_flag);
 }
 
+int NVStore::set_batch(uint16_t key, uint16_t buf_size, const void *buf)
+{
+    int ret = NVSTORE_SUCCESS;
+    nvstore_pending_set_t *pending;
+
+    if (!_init_done) {
+        ret = init();
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+    }
+
+    if (key >= _max_keys) {
+        return NVSTORE_BAD_VALUE;
+    }
+
+    if (buf_size >= max_data_size) {
+        return NVSTORE_BAD_VALUE;
+    }
+
+    if (!buf) {
+        buf_size = 0;
+    }
+
+    if (_offset_by_key[key] & offs_by_key_set_once_mask) {
+        return NVSTORE_ALREADY_EXISTS;
+    }
+
+    _mutex->lock();
+
+    // Coalesce repeated updates of the same key - only the last value reaches Flash
+    pending = _pending_sets;
+    while (pending && (pending->key != key)) {
+        pending = pending->next;
+    }
+    if (pending) {
+        delete[] pending->buf;
+    } else {
+        pending = new nvstore_pending_set_t;
+        MBED_ASSERT(pending);
+        pending->key = key;
+        pending->next = 0;
+        if (_pending_last) {
+            _pending_last->next = pending;
+        } else {
+            _pending_sets = pending;
+        }
+        _pending_last = pending;
+    }
+
+    pending->buf_size = buf_size;
+    pending->buf = 0;
+    if (buf_size) {
+        pending->buf = new uint8_t[buf_size];
+        MBED_ASSERT(pending->buf);
+        memcpy(pending->buf, buf, buf_size);
+    }
+
+    _mutex->unlock();
+    return NVSTORE_SUCCESS;
+}
+
+int NVStore::commit()
+{
+    int ret = NVSTORE_SUCCESS;
+    uint32_t batch_size, record_offset, new_free_space, curr_offset;
+    nvstore_pending_set_t *pending;
+    uint8_t owner;
+    int os_ret;
+
+    if (!_init_done) {
+        ret = init();
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+    }
+
+    _mutex->lock();
+
+    if (!_pending_sets) {
+        _mutex->unlock();
+        return NVSTORE_SUCCESS;
+    }
+
+    // The batch is written at the free space offset of the active area, so a
+    // half done incremental GC must be finished first.
+    if (_gc_active) {
+        ret = gc_finish();
+        if (ret != NVSTORE_SUCCESS) {
+            _mutex->unlock();
+            return ret;
+        }
+    }
+
+    batch_size = 0;
+    for (pending = _pending_sets; pending; pending = pending->next) {
+        batch_size += align_up(sizeof(nvstore_record_header_t) + pending->buf_size, _min_prog_size);
+    }
+
+    new_free_space = core_util_atomic_incr_u32(&_free_space_offset, batch_size);
+    record_offset = new_free_space - batch_size;
+
+    // If we cross the area limit, we need to invoke GC, then take the space for the
+    // batch in the new active area.
+    if (new_free_space >= _size) {
+        ret = garbage_collection(no_key, 0, 0, 0, NULL);
+        if (ret != NVSTORE_SUCCESS) {
+            _mutex->unlock();
+            return ret;
+        }
+        new_free_space = core_util_atomic_incr_u32(&_free_space_offset, batch_size);
+        record_offset = new_free_space - batch_size;
+        if (new_free_space >= _size) {
+            core_util_atomic_decr_u32(&_free_space_offset, batch_size);
+            _mutex->unlock();
+            return NVSTORE_FLASH_AREA_TOO_SMALL;
+        }
+    }
+
+    // Build all records back to back in a RAM staging buffer, blank filled so the
+    // alignment padding between records stays unprogrammed, and program it in one pass.
+    uint8_t *batch_buf = new uint8_t[batch_size];
+    MBED_ASSERT(batch_buf);
+    memset(batch_buf, blank_flash_val, batch_size);
+
+    curr_offset = 0;
+    for (pending = _pending_sets; pending; pending = pending->next) {
+        nvstore_record_header_t *header = (nvstore_record_header_t *) (batch_buf + curr_offset);
+        uint32_t crc = initial_crc;
+        owner = (_offset_by_key[pending->key] & offs_by_key_owner_mask) >> offs_by_key_owner_bit_pos;
+        header->key_and_flags = pending->key;
+        header->size_and_owner = pending->buf_size | (owner << owner_bit_pos);
+        header->crc = 0;
+        crc = crc32(crc, sizeof(*header) - sizeof(header->crc), (uint8_t *) header);
+        if (pending->buf_size) {
+            memcpy(batch_buf + curr_offset + sizeof(*header), pending->buf, pending->buf_size);
+            crc = crc32(crc, pending->buf_size, pending->buf);
+        }
+        header->crc = crc;
+        curr_offset += align_up(sizeof(*header) + pending->buf_size, _min_prog_size);
+    }
+
+    os_ret = flash_write_area(_active_area, record_offset, batch_size, batch_buf);
+    delete[] batch_buf;
+    if (os_ret) {
+        _mutex->unlock();
+        return NVSTORE_WRITE_ERROR;
+    }
+
+    // Records are now on Flash - update the index and release the pending list
+    curr_offset = record_offset;
+    while (_pending_sets) {
+        pending = _pending_sets;
+        owner = (_offset_by_key[pending->key] & offs_by_key_owner_mask) >> offs_by_key_owner_bit_pos;
+        _offset_by_key[pending->key] = curr_offset | (_active_area << offs_by_key_area_bit_pos) |
+                                       (owner << offs_by_key_owner_bit_pos);
+        curr_offset += align_up(sizeof(nvstore_record_header_t) + pending->buf_size, _min_prog_size);
+        _pending_sets = pending->next;
+        delete[] pending->buf;
+        delete pending;
+    }
+    _pending_last = 0;
+
+    gc_check_trigger();
+
+    _mutex->unlock();
+    return NVSTORE_SUCCESS;
+}
+
 int NVStore::allocate_key(uint16_t &key, uint8_t owner)
 {
     int ret = NVSTORE_SUCCESS;
@@ -947,6 +1302,17 @@ int NVStore::deinit()
             delete[] _page_buf;
             _page_buf = 0;
         }
+        while (_pending_sets) {
+            nvstore_pending_set_t *pending = _pending_sets;
+            _pending_sets = pending->next;
+            delete[] pending->buf;
+            delete pending;
+        }
+        _pending_last = 0;
+        _gc_queue = 0;
+        _gc_active = 0;
+        _gc_erase_pending = 0;
+        _gc_stalled = 0;
     }
 
     _init_attempts = 0;
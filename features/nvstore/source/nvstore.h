@@ -30,6 +30,10 @@
 #include "PlatformMutex.h"
 #include "FlashIAP.h"
 
+namespace events {
+class EventQueue;
+}
+
 typedef enum {
     NVSTORE_SUCCESS                =  0,
     NVSTORE_READ_ERROR             = -1,
@@ -50,6 +54,8 @@ typedef enum {
     // All predefined keys used for internal features should be defined here
 
     NVSTORE_DEVICEKEY_KEY               = 4,
+    NVSTORE_DNS_CACHE_KEY               = 5,
+    NVSTORE_TLS_SESSION_CACHE_KEY       = 6,
 
     NVSTORE_LAST_PREDEFINED_KEY         = 15,
     NVSTORE_NUM_PREDEFINED_KEYS
@@ -207,6 +213,51 @@ public:
      */
     int set_once(uint16_t key, uint16_t buf_size, const void *buf);
 
+    /**
+     * @brief Queues one item of data in RAM, to be programmed on Flash by the next commit call.
+     *        Allows coalescing a burst of updates into a single program pass, reducing both
+     *        latency and flash wear. Repeated calls with the same key replace the queued data,
+     *        so only the last value reaches Flash.
+     *
+     * @param[in]  key                  Key of stored item.
+     * @param[in]  buf_size             Item size in bytes.
+     * @param[in]  buf                  Buffer containing data.
+     *
+     * @returns NVSTORE_SUCCESS           Value was successfully queued.
+     *          NVSTORE_BAD_VALUE         Bad value in any of the parameters.
+     *          NVSTORE_ALREADY_EXISTS    Item set with write once API already exists.
+     *
+     */
+    int set_batch(uint16_t key, uint16_t buf_size, const void *buf);
+
+    /**
+     * @brief Programs all items queued by set_batch on Flash, in one program pass.
+     *        Does nothing if no items are queued. On failure, the queued items are
+     *        kept, allowing the call to be retried.
+     *
+     * @returns NVSTORE_SUCCESS           Values were successfully written on Flash.
+     *          NVSTORE_WRITE_ERROR       Physical error writing data.
+     *          NVSTORE_FLASH_AREA_TOO_SMALL
+     *                                    Not enough space in Flash area.
+     *
+     */
+    int commit();
+
+    /**
+     * @brief Enables background garbage collection, run in slices on the given event queue.
+     *        Once the used space in the active area crosses a watermark, records are copied
+     *        to the nonactive area a few at a time, so the full area copy no longer runs
+     *        inline inside a set call and worst case set latency stays small and bounded.
+     *        Called with NULL, disables background garbage collection (finishing an
+     *        in-progress one first).
+     *
+     * @param[in]  queue                Queue to run garbage collection slices on.
+     *
+     * @returns NVSTORE_SUCCESS           Success.
+     *          NVSTORE_WRITE_ERROR       Physical error writing data (when finishing an
+     *                                    in-progress garbage collection).
+     */
+    int set_background_gc(events::EventQueue *queue);
 
     /**
      * @brief Remove an item from flash.
@@ -279,6 +330,13 @@ private:
         size_t   size;
     } nvstore_area_data_t;
 
+    typedef struct nvstore_pending_set {
+        uint16_t key;
+        uint16_t buf_size;
+        uint8_t  *buf;
+        struct nvstore_pending_set *next;
+    } nvstore_pending_set_t;
+
     int _init_done;
     uint32_t _init_attempts;
     uint8_t _active_area;
@@ -293,6 +351,14 @@ private:
     mbed::FlashIAP *_flash;
     uint32_t _min_prog_size;
     uint8_t *_page_buf;
+    nvstore_pending_set_t *_pending_sets;
+    nvstore_pending_set_t *_pending_last;
+    events::EventQueue *_gc_queue;
+    int _gc_active;
+    int _gc_erase_pending;
+    int _gc_stalled;
+    uint16_t _gc_key;
+    uint32_t _gc_new_area_offset;
 
     // Private constructor, as class is a singleton
     NVStore();
@@ -422,6 +488,35 @@ private:
      */
     int garbage_collection(uint16_t key, uint16_t flags, uint8_t owner, uint16_t buf_size, const void *buf);
 
+    /**
+     * @brief Perform one slice of an incremental garbage collection: copy a few
+     *        records, then switch areas, then erase the old area (one phase per slice).
+     *        Must be called with the mutex held.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_slice_step();
+
+    /**
+     * @brief Run the remaining slices of an incremental garbage collection to
+     *        completion. Must be called with the mutex held.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_finish();
+
+    /**
+     * @brief Event queue callback, running one garbage collection slice and
+     *        reposting itself while work remains.
+     */
+    void gc_slice();
+
+    /**
+     * @brief Start an incremental garbage collection if the watermark has been
+     *        crossed and none is in progress. Must be called with the mutex held.
+     */
+    void gc_check_trigger();
+
     /**
      * @brief Actual logics of get API (covers also get size API).
      *
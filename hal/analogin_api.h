@@ -21,6 +21,11 @@
 
 #include "device.h"
 
+#if DEVICE_ANALOGIN_BURST
+#include <stddef.h>
+#include "hal/dma_api.h"
+#endif
+
 #if DEVICE_ANALOGIN
 
 #ifdef __cplusplus
@@ -58,8 +63,60 @@ float analogin_read(analogin_t *obj);
  */
 uint16_t analogin_read_u16(analogin_t *obj);
 
+
 /**@}*/
 
+#if DEVICE_ANALOGIN_BURST
+
+/**
+ * \defgroup hal_analogin_burst Analogin burst capture hal functions
+ *
+ * Optional extension for targets whose ADC can run a hardware-paced burst
+ * of conversions into memory (typically via DMA). Targets advertise
+ * support with DEVICE_ANALOGIN_BURST in device_has.
+ * @{
+ */
+
+/** Begin an asynchronous burst capture of length samples into buffer
+ *
+ * Conversions are paced by the hardware at sample_rate_hz (best effort,
+ * rounded to the closest rate the ADC clocking supports) and written to
+ * the buffer without CPU involvement. The handler is invoked from
+ * interrupt context once the last sample has been stored.
+ *
+ * @param obj            The analogin object
+ * @param buffer         Buffer the normalised 16-bit samples are stored to
+ * @param length         Number of samples to capture
+ * @param sample_rate_hz Requested sample rate in Hz, 0 for maximum rate
+ * @param handler        The analogin handler, called on completion
+ * @param hint           A suggestion for how to use DMA with this transfer
+ */
+void analogin_capture_asynch(analogin_t *obj, uint16_t *buffer, size_t length, uint32_t sample_rate_hz, uint32_t handler, DMAUsage hint);
+
+/** Attempts to determine if the analogin peripheral is already in use
+ *
+ * @param obj The analogin object
+ * @return Non-zero if a capture is ongoing, 0 otherwise
+ */
+uint8_t analogin_active(analogin_t *obj);
+
+/** The asynchronous capture interrupt handler
+ *
+ * @param obj The analogin object
+ * @return Non-zero when the capture has completed, 0 otherwise
+ */
+int analogin_irq_handler_asynch(analogin_t *obj);
+
+/** Abort the ongoing capture
+ *
+ * @param obj The analogin object
+ */
+void analogin_abort_capture_asynch(analogin_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,20 @@ unsigned char can_rderror  (can_t *obj);
 unsigned char can_tderror  (can_t *obj);
 void          can_monitor  (can_t *obj, int silent);
 
+#if DEVICE_CAN_FD
+
+/* CAN FD extension. Targets whose peripheral supports FD frames define
+ * DEVICE_CAN_FD and implement these; without it the driver layer offers
+ * classic frames only. The nominal rate covers arbitration and frames
+ * without bitrate switching, the data rate is used for the data phase of
+ * frames sent with the BRS flag set.
+ */
+int           can_fd_frequency (can_t *obj, int hz, int data_hz);
+int           can_fd_write     (can_t *obj, const CAN_FD_Message *msg, int cc);
+int           can_fd_read      (can_t *obj, CAN_FD_Message *msg, int handle);
+
+#endif
+
 #ifdef __cplusplus
 };
 #endif
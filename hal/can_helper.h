@@ -66,6 +66,22 @@ struct CAN_Message {
 };
 typedef struct CAN_Message CAN_Message;
 
+/**
+ *
+ * \struct  CAN_FD_Message
+ *
+ * \brief   Holder for single CAN FD message.
+ *
+**/
+struct CAN_FD_Message {
+    unsigned int   id;                 // 29 bit identifier
+    unsigned char  data[64];           // Data field
+    unsigned char  len;                // Length of data field in bytes, a valid FD DLC size (0-8, 12, 16, 20, 24, 32, 48, 64)
+    unsigned char  brs;                // 1 to use the data-phase bitrate for the data field
+    CANFormat      format;             // Format ::CANFormat
+};
+typedef struct CAN_FD_Message CAN_FD_Message;
+
 #ifdef __cplusplus
 };
 #endif
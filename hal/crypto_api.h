@@ -0,0 +1,124 @@
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRYPTO_HAL_API_H
+#define MBED_CRYPTO_HAL_API_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Crypto accelerator capabilities
+ *
+ * Bitmask values returned by hal_crypto_get_capabilities(). The AES and
+ * SHA-256 bits cover the whole primitive; the ECC bits are per curve.
+ */
+typedef enum hal_crypto_capability {
+    HAL_CRYPTO_AES      = 0x0001, /**< AES-ECB single block, 128/192/256-bit keys */
+    HAL_CRYPTO_SHA256   = 0x0002, /**< SHA-256 block transform */
+    HAL_CRYPTO_ECC_P256 = 0x0004, /**< secp256r1 point multiplication */
+    HAL_CRYPTO_ECC_P384 = 0x0008, /**< secp384r1 point multiplication */
+} hal_crypto_capability_t;
+
+#ifdef DEVICE_CRYPTO
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_crypto Hardware crypto acceleration
+ *
+ * Low-level interface to a target's crypto accelerator, dispatched to at
+ * runtime by the mbed TLS glue in features/mbedtls/platform.
+ *
+ * # Defined behaviour
+ *
+ * * hal_crypto_get_capabilities() returns the operations the hardware can
+ *   perform; the value is constant after boot.
+ * * A target reporting HAL_CRYPTO_AES must handle all three AES key lengths.
+ * * A target reporting an ECC curve must handle scalar multiplication of
+ *   any valid point on that curve, including the base point.
+ * * All functions may be called from any thread; implementations serialize
+ *   access to the hardware internally.
+ * * All functions are synchronous and return 0 on success, non-zero if the
+ *   hardware failed.
+ *
+ * # Undefined behaviour
+ *
+ * * Calling an operation whose capability bit is not reported.
+ *
+ * @{
+ */
+
+/** Read which operations the crypto hardware supports
+ *
+ * @return Bitmask of hal_crypto_capability_t values
+ */
+uint32_t hal_crypto_get_capabilities(void);
+
+/** Encrypt or decrypt one 16-byte block with AES-ECB
+ *
+ * The raw key is passed on every call so the HAL holds no per-context
+ * state; implementations may cache the last key schedule.
+ *
+ * @param key     Raw AES key
+ * @param keybits Key length in bits: 128, 192 or 256
+ * @param encrypt True to encrypt the block, false to decrypt
+ * @param input   16-byte input block
+ * @param output  16-byte output block, may alias input
+ * @return        0 on success, non-zero on hardware failure
+ */
+int hal_crypto_aes_crypt_ecb(const uint8_t *key, size_t keybits, bool encrypt,
+                             const uint8_t input[16], uint8_t output[16]);
+
+/** Run the SHA-256 compression function over one 64-byte block
+ *
+ * @param state   Hash state of eight native-endian words, updated in place
+ * @param data    64-byte message block
+ * @return        0 on success, non-zero on hardware failure
+ */
+int hal_crypto_sha256_process(uint32_t state[8], const uint8_t data[64]);
+
+/** Multiply a point on an elliptic curve by a scalar
+ *
+ * Scalars are big-endian and padded to the curve size; points use the
+ * SEC1 uncompressed format (0x04 || X || Y).
+ *
+ * @param curve      The curve's hal_crypto_capability_t value
+ * @param scalar     Big-endian scalar of scalar_len bytes
+ * @param scalar_len Scalar length in bytes
+ * @param point      Input point of point_len bytes
+ * @param point_len  Input point length in bytes
+ * @param result     Output point, same format and length as the input,
+ *                   may alias point
+ * @return           0 on success, non-zero on hardware failure
+ */
+int hal_crypto_ecp_mul(uint32_t curve, const uint8_t *scalar, size_t scalar_len,
+                       const uint8_t *point, size_t point_len, uint8_t *result);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_CRYPTO
+
+#endif // MBED_CRYPTO_HAL_API_H
+
+/** @}*/
@@ -20,6 +20,7 @@
 #define MBED_DMA_API_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #define DMA_ERROR_OUT_OF_CHANNELS (-1)
 
@@ -41,6 +42,53 @@ int dma_channel_allocate(uint32_t capabilities);
 
 int dma_channel_free(int channelid);
 
+/** DMA transfer completion handler
+ *
+ * Called once when a transfer started with dma_transfer_start completes.
+ * May be invoked from interrupt context.
+ */
+typedef void (*dma_transfer_handler_t)(void *context);
+
+/** Descriptor for a memory-to-memory or memory-to-peripheral transfer */
+typedef struct {
+    const void *source;   /**< Source address */
+    void *destination;    /**< Destination address */
+    uint32_t length;      /**< Transfer length in bytes, a multiple of word_size */
+    uint8_t word_size;    /**< Transfer unit in bytes: 1, 2 or 4 */
+    bool source_inc;      /**< Advance source address after each unit; false for a peripheral register */
+    bool destination_inc; /**< Advance destination address after each unit; false for a peripheral register */
+} dma_transfer_t;
+
+/** Start an asynchronous transfer on an allocated channel
+ *
+ * The default implementation performs the copy synchronously on the CPU and
+ * invokes the handler before returning, so a caller may rely on the handler
+ * running exactly once whether or not the target has a DMA engine.
+ *
+ * @param channelid Channel obtained from dma_channel_allocate
+ * @param transfer  Transfer descriptor, not referenced after return
+ * @param handler   Completion handler, or NULL
+ * @param context   Opaque pointer passed to the handler
+ * @return          0 started OK, -1 invalid transfer or channel busy
+ */
+int dma_transfer_start(int channelid, const dma_transfer_t *transfer, dma_transfer_handler_t handler, void *context);
+
+/** Check whether a transfer is still in progress on a channel
+ *
+ * @param channelid Channel obtained from dma_channel_allocate
+ * @return          True if a transfer started on the channel has not completed
+ */
+bool dma_transfer_is_busy(int channelid);
+
+/** Abort an in-progress transfer
+ *
+ * The completion handler of an aborted transfer is not called. Destination
+ * contents are undefined up to the transfer length.
+ *
+ * @param channelid Channel obtained from dma_channel_allocate
+ */
+void dma_transfer_abort(int channelid);
+
 #ifdef __cplusplus
 }
 #endif
@@ -112,6 +112,42 @@ void gpio_init_out(gpio_t* gpio, PinName pin);
  */
 void gpio_init_out_ex(gpio_t* gpio, PinName pin, int value);
 
+/** One pin's captured configuration, see gpio_state_capture */
+typedef struct {
+    gpio_t gpio;            /**< The initialized GPIO object */
+    PinName pin;            /**< The pin the entry describes */
+    PinDirection direction; /**< Direction at capture */
+    PinMode mode;           /**< Pin mode at capture */
+    int value;              /**< Driven value at capture, outputs only */
+} gpio_state_t;
+
+/** Capture the configuration of every pin set up through the gpio_init_*
+ *  helpers into an array, for fast restoration after a deepsleep wake.
+ *
+ * Tracking is only compiled in when MBED_GPIO_STATE_RETENTION_ENABLED is
+ * set; without it no pins are captured. Output values are read back at
+ * capture time, direction and mode reflect the last gpio_init_* call for
+ * the pin.
+ *
+ * @param states Array the pin states are copied into
+ * @param count  Capacity of the array
+ * @return       Number of entries filled
+ */
+uint32_t gpio_state_capture(gpio_state_t *states, uint32_t count);
+
+/** Restore previously captured pin configurations in one call.
+ *
+ * The generic implementation replays value, direction and mode on the
+ * captured GPIO objects, skipping the pin-function lookup of a full
+ * gpio_init path. Targets whose ports expose block mode/direction/output
+ * registers can override it (it is MBED_WEAK) and restore each port with
+ * a couple of register writes.
+ *
+ * @param states Array of pin states from gpio_state_capture
+ * @param count  Number of entries in the array
+ */
+void gpio_state_restore(const gpio_state_t *states, uint32_t count);
+
 /** Init the pin to be in/out
  *
  * @param gpio      The GPIO object
@@ -22,6 +22,7 @@
 #if defined(DEVICE_ITM)
 
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +75,52 @@ void mbed_itm_init(void);
  */
 uint32_t mbed_itm_send(uint32_t port, uint32_t data);
 
+/**
+ * @brief      Enable an additional stimulus port as a trace channel.
+ *
+ *             The ITM has 32 independent stimulus ports and the SWO
+ *             decoder demultiplexes them on the host, so each subsystem
+ *             can stream over its own port without interleaving with the
+ *             others. mbed_itm_init() only enables port ITM_PORT_SWO.
+ *
+ * @param[in]  port  The stimulus port to enable, 0 to 31.
+ */
+void mbed_itm_enable_port(uint32_t port);
+
+/**
+ * @brief      Send a block of data over a stimulus port without blocking.
+ *
+ *             Bytes are packed into 32-bit stimulus writes, so the SWO
+ *             bandwidth carries four payload bytes per write rather than
+ *             one as with mbed_itm_send. The port FIFO is checked before
+ *             every write; once it stalls the remaining bytes are dropped
+ *             and counted instead of spinning, so tracing never perturbs
+ *             the timing of the code being traced.
+ *
+ *             Each port expects a single producer; concurrent writers
+ *             should use separate ports.
+ *
+ * @param[in]  port    The stimulus port to send data over.
+ * @param[in]  data    The data to send.
+ * @param[in]  length  Number of bytes to send.
+ *
+ * @return     Number of bytes accepted by the port FIFO.
+ */
+size_t mbed_itm_write(uint32_t port, const void *data, size_t length);
+
+/**
+ * @brief      Number of bytes dropped on a stimulus port.
+ *
+ *             Counts bytes mbed_itm_write() discarded because the port
+ *             FIFO stalled or the port was not enabled. Reading does not
+ *             reset the counter.
+ *
+ * @param[in]  port  The stimulus port.
+ *
+ * @return     Dropped byte count since boot.
+ */
+uint32_t mbed_itm_dropped(uint32_t port);
+
 /**@}*/
 
 #ifdef __cplusplus
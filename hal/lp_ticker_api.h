@@ -86,6 +86,21 @@ const ticker_data_t* get_lp_ticker_data(void);
  */
 void lp_ticker_irq_handler(void);
 
+/** Measured drift of the low power clock against the us ticker
+ *
+ * Only meaningful on targets using the lp ticker wrapper with
+ * MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT set; the wrapper then
+ * samples the lp clock rate opportunistically while interrupts are being
+ * scheduled and stretches long deadlines so they fire at their true
+ * wall-clock time.
+ *
+ * @return Drift in parts per million, positive when the lp clock runs
+ *         fast, or 0 before the first calibration window completes
+ *
+ * @note this is a utility function and it's not required part of HAL implementation
+ */
+int32_t lp_ticker_drift_ppm(void);
+
 /* HAL lp ticker */
 
 /** Initialize the low power ticker
@@ -0,0 +1,106 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/dma_api.h"
+#include "platform/mbed_toolchain.h"
+
+#include <string.h>
+
+/* Software fallbacks, overridden by targets with a DMA engine. A target
+ * with no DMA support at all reports out-of-channels, so users degrade to
+ * CPU copies instead of failing to link. */
+
+MBED_WEAK void dma_init(void)
+{
+}
+
+MBED_WEAK int dma_channel_allocate(uint32_t capabilities)
+{
+    (void) capabilities;
+    return DMA_ERROR_OUT_OF_CHANNELS;
+}
+
+MBED_WEAK int dma_channel_free(int channelid)
+{
+    (void) channelid;
+    return 0;
+}
+
+MBED_WEAK int dma_transfer_start(int channelid, const dma_transfer_t *transfer, dma_transfer_handler_t handler, void *context)
+{
+    (void) channelid;
+
+    if (!transfer || (transfer->word_size != 1 && transfer->word_size != 2 && transfer->word_size != 4)) {
+        return -1;
+    }
+    if (transfer->length % transfer->word_size != 0) {
+        return -1;
+    }
+
+    if (transfer->source_inc && transfer->destination_inc) {
+        memcpy(transfer->destination, transfer->source, transfer->length);
+    } else {
+        uint32_t count = transfer->length / transfer->word_size;
+        switch (transfer->word_size) {
+            case 1: {
+                const volatile uint8_t *src = (const volatile uint8_t *) transfer->source;
+                volatile uint8_t *dst = (volatile uint8_t *) transfer->destination;
+                while (count--) {
+                    *dst = *src;
+                    src += transfer->source_inc ? 1 : 0;
+                    dst += transfer->destination_inc ? 1 : 0;
+                }
+                break;
+            }
+            case 2: {
+                const volatile uint16_t *src = (const volatile uint16_t *) transfer->source;
+                volatile uint16_t *dst = (volatile uint16_t *) transfer->destination;
+                while (count--) {
+                    *dst = *src;
+                    src += transfer->source_inc ? 1 : 0;
+                    dst += transfer->destination_inc ? 1 : 0;
+                }
+                break;
+            }
+            case 4: {
+                const volatile uint32_t *src = (const volatile uint32_t *) transfer->source;
+                volatile uint32_t *dst = (volatile uint32_t *) transfer->destination;
+                while (count--) {
+                    *dst = *src;
+                    src += transfer->source_inc ? 1 : 0;
+                    dst += transfer->destination_inc ? 1 : 0;
+                }
+                break;
+            }
+        }
+    }
+
+    if (handler) {
+        handler(context);
+    }
+
+    return 0;
+}
+
+MBED_WEAK bool dma_transfer_is_busy(int channelid)
+{
+    (void) channelid;
+    return false;
+}
+
+MBED_WEAK void dma_transfer_abort(int channelid)
+{
+    (void) channelid;
+}
@@ -14,6 +14,96 @@
  * limitations under the License.
  */
 #include "hal/gpio_api.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+
+#if defined(MBED_GPIO_STATE_RETENTION_ENABLED)
+
+#ifndef MBED_GPIO_STATE_PINS
+#define MBED_GPIO_STATE_PINS 32
+#endif
+
+/* every pin configured through the gpio_init_* helpers is recorded here,
+ * so a deepsleep wake can restore them without the pin-function lookup
+ * of a full gpio_init */
+static gpio_state_t gpio_state_table[MBED_GPIO_STATE_PINS];
+static uint32_t gpio_state_used;
+
+static void _gpio_state_record(const gpio_t *gpio, PinName pin,
+                               PinDirection direction, PinMode mode, int value)
+{
+    if (pin == NC) {
+        return;
+    }
+    core_util_critical_section_enter();
+    uint32_t slot = gpio_state_used;
+    for (uint32_t i = 0; i < gpio_state_used; i++) {
+        if (gpio_state_table[i].pin == pin) {
+            slot = i;   // a re-initialized pin replaces its entry
+            break;
+        }
+    }
+    if (slot < MBED_GPIO_STATE_PINS) {
+        gpio_state_table[slot].gpio = *gpio;
+        gpio_state_table[slot].pin = pin;
+        gpio_state_table[slot].direction = direction;
+        gpio_state_table[slot].mode = mode;
+        gpio_state_table[slot].value = value;
+        if (slot == gpio_state_used) {
+            gpio_state_used++;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+uint32_t gpio_state_capture(gpio_state_t *states, uint32_t count)
+{
+    core_util_critical_section_enter();
+    uint32_t copied = gpio_state_used < count ? gpio_state_used : count;
+    for (uint32_t i = 0; i < copied; i++) {
+        states[i] = gpio_state_table[i];
+        if (states[i].direction == PIN_OUTPUT) {
+            states[i].value = gpio_read(&states[i].gpio);
+        }
+    }
+    core_util_critical_section_exit();
+    return copied;
+}
+
+MBED_WEAK void gpio_state_restore(const gpio_state_t *states, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        /* the gpio_t object survived deepsleep, only the pin registers
+         * need replaying - cast away const for the unchanged objects */
+        gpio_t *gpio = (gpio_t *)&states[i].gpio;
+        if (states[i].direction == PIN_OUTPUT) {
+            gpio_write(gpio, states[i].value);
+            gpio_dir(gpio, PIN_OUTPUT);
+        } else {
+            gpio_dir(gpio, PIN_INPUT);
+        }
+        gpio_mode(gpio, states[i].mode);
+    }
+}
+
+#else
+
+uint32_t gpio_state_capture(gpio_state_t *states, uint32_t count)
+{
+    (void)states;
+    (void)count;
+    return 0;
+}
+
+MBED_WEAK void gpio_state_restore(const gpio_state_t *states, uint32_t count)
+{
+    (void)states;
+    (void)count;
+}
+
+#define _gpio_state_record(gpio, pin, direction, mode, value) ((void)0)
+
+#endif // MBED_GPIO_STATE_RETENTION_ENABLED
 
 static inline void _gpio_init_in(gpio_t* gpio, PinName pin, PinMode mode)
 {
@@ -22,6 +112,7 @@ static inline void _gpio_init_in(gpio_t* gpio, PinName pin, PinMode mode)
         gpio_dir(gpio, PIN_INPUT);
         gpio_mode(gpio, mode);
     }
+    _gpio_state_record(gpio, pin, PIN_INPUT, mode, 0);
 }
 
 static inline void _gpio_init_out(gpio_t* gpio, PinName pin, PinMode mode, int value)
@@ -32,6 +123,7 @@ static inline void _gpio_init_out(gpio_t* gpio, PinName pin, PinMode mode, int v
         gpio_dir(gpio, PIN_OUTPUT);
         gpio_mode(gpio, mode);
     }
+    _gpio_state_record(gpio, pin, PIN_OUTPUT, mode, value);
 }
 
 void gpio_init_in(gpio_t* gpio, PinName pin) {
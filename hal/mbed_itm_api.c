@@ -84,4 +84,76 @@ uint32_t mbed_itm_send(uint32_t port, uint32_t data)
     return data;
 }
 
+#define ITM_PORT_COUNT 32
+
+static uint32_t itm_dropped[ITM_PORT_COUNT];
+
+void mbed_itm_enable_port(uint32_t port)
+{
+    if (port >= ITM_PORT_COUNT) {
+        return;
+    }
+
+    mbed_itm_init();
+
+    /* Trace Enable Register, write access is unlocked by mbed_itm_init */
+    ITM->TER |= 1UL << port;
+}
+
+size_t mbed_itm_write(uint32_t port, const void *data, size_t length)
+{
+    const uint8_t *bytes = data;
+    size_t written = 0;
+
+    /* Check if ITM and port is enabled */
+    if ((port >= ITM_PORT_COUNT)                          ||
+        ((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0UL)          ||  /* ITM disabled */
+        ((ITM->TER & (1UL << port)     ) == 0UL)            ) /* ITM Port disabled */
+    {
+        if (port < ITM_PORT_COUNT) {
+            itm_dropped[port] += length;
+        }
+        return 0;
+    }
+
+    while (written < length) {
+        /* A stimulus port reads zero while its FIFO is full; stop rather
+         * than spin so the caller's timing is not perturbed. */
+        if (ITM->PORT[port].u32 == 0UL) {
+            break;
+        }
+
+        size_t remaining = length - written;
+        if (remaining >= 4) {
+            /* Pack four payload bytes into one stimulus write. The debug
+             * unit emits them in little-endian order, matching the byte
+             * stream a plain sequence of u8 writes would produce. */
+            ITM->PORT[port].u32 = (uint32_t)bytes[written]            |
+                                  ((uint32_t)bytes[written + 1] << 8)  |
+                                  ((uint32_t)bytes[written + 2] << 16) |
+                                  ((uint32_t)bytes[written + 3] << 24);
+            written += 4;
+        } else if (remaining >= 2) {
+            ITM->PORT[port].u16 = (uint16_t)bytes[written] |
+                                  ((uint16_t)bytes[written + 1] << 8);
+            written += 2;
+        } else {
+            ITM->PORT[port].u8 = bytes[written];
+            written += 1;
+        }
+    }
+
+    itm_dropped[port] += length - written;
+
+    return written;
+}
+
+uint32_t mbed_itm_dropped(uint32_t port)
+{
+    if (port >= ITM_PORT_COUNT) {
+        return 0;
+    }
+    return itm_dropped[port];
+}
+
 #endif // defined(DEVICE_ITM)
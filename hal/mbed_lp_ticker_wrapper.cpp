@@ -20,6 +20,10 @@
 #include "Timeout.h"
 #include "mbed_critical.h"
 
+#if MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT
+#include "hal/us_ticker_api.h"
+#endif
+
 static const timestamp_t min_delta = LPTICKER_DELAY_TICKS;
 
 static bool init = false;
@@ -36,6 +40,96 @@ static timestamp_t reschedule_us;
 static mbed::Timeout *timeout;
 static uint64_t timeout_data[sizeof(mbed::Timeout) / 8];
 
+#if MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT
+
+// Calibration windows shorter than this carry too much sampling noise
+#define CAL_MIN_WINDOW_US 1000000
+// Reject windows with an apparent drift beyond what a real low power
+// oscillator exhibits - a window spanning a period where the us ticker
+// was stopped (deep sleep) shows up as a huge bogus drift
+#define CAL_MAX_PPM       5000
+
+static uint32_t lp_frequency;
+static bool cal_started = false;
+static bool cal_valid = false;
+static int32_t lp_drift_ppm = 0;
+static timestamp_t cal_lp_base;
+static us_tick_t cal_us_base;
+
+/**
+ * Sample the low power clock rate against the us ticker
+ *
+ * Piggybacks on interrupt scheduling so drift tracking costs no wakeups
+ * of its own. Windows are only accepted once they are long enough to
+ * average out sampling noise and short enough that the lp counter cannot
+ * have wrapped between samples.
+ *
+ * @param lp_now The current value read from lp_ticker_read
+ */
+static void drift_sample(timestamp_t lp_now)
+{
+    MBED_ASSERT(core_util_in_critical_section());
+
+    us_tick_t us_now = us_ticker_timestamp();
+    if (!cal_started) {
+        cal_lp_base = lp_now;
+        cal_us_base = us_now;
+        cal_started = true;
+        return;
+    }
+
+    uint64_t window_us = us_ticker_ticks_to_us(us_now - cal_us_base);
+    if (window_us < CAL_MIN_WINDOW_US) {
+        return;
+    }
+
+    if (window_us < ((uint64_t)(mask >> 1) * 1000000) / lp_frequency) {
+        uint64_t lp_elapsed = (lp_now - cal_lp_base) & mask;
+        int64_t expected = (int64_t)((window_us * lp_frequency) / 1000000);
+        if (expected > 0) {
+            int64_t ppm = (((int64_t)lp_elapsed - expected) * 1000000) / expected;
+            if (ppm > -CAL_MAX_PPM && ppm < CAL_MAX_PPM) {
+                if (cal_valid) {
+                    // light smoothing so one noisy window does not swing the rate
+                    lp_drift_ppm = (3 * lp_drift_ppm + (int32_t)ppm) / 4;
+                } else {
+                    lp_drift_ppm = (int32_t)ppm;
+                    cal_valid = true;
+                }
+            }
+        }
+    }
+    cal_lp_base = lp_now;
+    cal_us_base = us_now;
+}
+
+/**
+ * Stretch an interrupt delta by the measured drift
+ *
+ * Deadlines are handed down in nominal lp ticks, so on a fast lp clock
+ * the counter reaches them early in wall-clock time. Only positive
+ * corrections are applied: firing later just delays dispatch by the
+ * correction, while firing before the ticker layer sees the event as due
+ * would cause re-arm churn around the deadline.
+ *
+ * @param delta Requested delta in nominal lp ticks
+ * @return The delta adjusted to fire at the true deadline
+ */
+static timestamp_t compensate_delta(timestamp_t delta)
+{
+    if (!cal_valid || lp_drift_ppm <= 0) {
+        return delta;
+    }
+    return delta + (timestamp_t)(((uint64_t)delta * (uint32_t)lp_drift_ppm) / 1000000);
+}
+
+extern "C" int32_t lp_ticker_drift_ppm(void)
+{
+    return cal_valid ? lp_drift_ppm : 0;
+}
+
+#endif // MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT
+
 /**
  * Initialize variables
  */
@@ -57,6 +151,10 @@ static void init_local()
     // Add 4 microseconds to round up the micro second ticker time (which has a frequency of at least 250KHz - 4us period)
     reschedule_us = (min_delta + 1) * us_per_tick + 4;
 
+#if MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT
+    lp_frequency = info->frequency;
+#endif
+
     timeout = new (timeout_data) mbed::Timeout();
 }
 
@@ -129,11 +227,30 @@ extern "C" void lp_ticker_set_interrupt_wrapper(timestamp_t timestamp)
     }
 
     timestamp_t current = lp_ticker_read();
+
+#if MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT
+    drift_sample(current);
+    timestamp = (current + compensate_delta((timestamp - current) & mask)) & mask;
+#endif
+
     if (pending) {
         // Check if pending should be cleared
         if (((current - last_set_interrupt) & mask) >= min_delta) {
             pending = false;
         }
+#if MBED_CONF_PLATFORM_LPTICKER_COMPENSATED_ONESHOT
+        else {
+            // One-shot mode: wait out the remainder of the write-in-flight
+            // window - bounded by LPTICKER_DELAY_TICKS lp periods - and
+            // program the true deadline directly, instead of re-arming the
+            // us ticker to retry later and keeping the fast clock domain
+            // active through idle
+            do {
+                current = lp_ticker_read();
+            } while (((current - last_set_interrupt) & mask) < min_delta);
+            pending = false;
+        }
+#endif
     }
 
     if (pending || timeout_pending) {
@@ -15,19 +15,49 @@
  */
 #include "hal/pinmap.h"
 #include "platform/mbed_error.h"
+#include "platform/mbed_critical.h"
+
+// One-entry memo of the most recent successful lookup. A driver init
+// resolves the same pin against the same map several times over (peripheral,
+// then pinout, then function), so remembering the last hit turns all but the
+// first walk of each table into a single compare.
+static const PinMap *pinmap_memo_map;
+static const PinMap *pinmap_memo_entry;
+
+static const PinMap *pinmap_find_entry(PinName pin, const PinMap *map) {
+    const PinMap *entry;
+
+    core_util_critical_section_enter();
+    entry = (map == pinmap_memo_map && pinmap_memo_entry->pin == pin) ? pinmap_memo_entry : NULL;
+    core_util_critical_section_exit();
+    if (entry) {
+        return entry;
+    }
+
+    for (entry = map; entry->pin != NC; entry++) {
+        if (entry->pin == pin) {
+            core_util_critical_section_enter();
+            pinmap_memo_map = map;
+            pinmap_memo_entry = entry;
+            core_util_critical_section_exit();
+            return entry;
+        }
+    }
+    return NULL;
+}
 
 void pinmap_pinout(PinName pin, const PinMap *map) {
+    const PinMap *entry;
+
     if (pin == NC)
         return;
 
-    while (map->pin != NC) {
-        if (map->pin == pin) {
-            pin_function(pin, map->function);
+    entry = pinmap_find_entry(pin, map);
+    if (entry) {
+        pin_function(pin, entry->function);
 
-            pin_mode(pin, PullNone);
-            return;
-        }
-        map++;
+        pin_mode(pin, PullNone);
+        return;
     }
     MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_PINMAP_INVALID), "could not pinout", pin);
 }
@@ -49,11 +79,9 @@ uint32_t pinmap_merge(uint32_t a, uint32_t b) {
 }
 
 uint32_t pinmap_find_peripheral(PinName pin, const PinMap* map) {
-    while (map->pin != NC) {
-        if (map->pin == pin)
-            return map->peripheral;
-        map++;
-    }
+    const PinMap *entry = pinmap_find_entry(pin, map);
+    if (entry)
+        return entry->peripheral;
     return (uint32_t)NC;
 }
 
@@ -69,11 +97,9 @@ uint32_t pinmap_peripheral(PinName pin, const PinMap* map) {
 }
 
 uint32_t pinmap_find_function(PinName pin, const PinMap* map) {
-    while (map->pin != NC) {
-        if (map->pin == pin)
-            return map->function;
-        map++;
-    }
+    const PinMap *entry = pinmap_find_entry(pin, map);
+    if (entry)
+        return entry->function;
     return (uint32_t)NC;
 }
 
@@ -0,0 +1,37 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device.h"
+
+#if DEVICE_PWMOUT
+
+#include "hal/pwmout_api.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+
+/* Software fallback, overridden by targets whose timer banks can latch
+ * all staged compare values on a single update event. Writing the
+ * channels back to back with interrupts masked removes the per-call
+ * overhead but still commits them a few cycles apart. */
+MBED_WEAK void pwmout_group_write(pwmout_t **objs, const float *values, size_t count)
+{
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < count; i++) {
+        pwmout_write(objs[i], values[i]);
+    }
+    core_util_critical_section_exit();
+}
+
+#endif
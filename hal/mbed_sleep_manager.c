@@ -24,6 +24,7 @@
 #include "lp_ticker_api.h"
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 #include "mbed_stats.h"
 
 
@@ -33,6 +34,16 @@
 static uint16_t deep_sleep_lock = 0U;
 static us_timestamp_t sleep_time = 0;
 static us_timestamp_t deep_sleep_time = 0;
+static us_timestamp_t idle_time = 0;
+
+// active wakeup-latency constraints; the strictest one bounds the sleep depth
+static sleep_latency_constraint_t *latency_constraints = NULL;
+
+// per-tier residency counters
+static uint32_t sleep_entries = 0;
+static uint32_t deep_sleep_entries = 0;
+static uint32_t deep_sleep_blocked_lock = 0;
+static uint32_t deep_sleep_blocked_latency = 0;
 
 #if defined(MBED_CPU_STATS_ENABLED) && defined(DEVICE_LPTICKER)
 static ticker_data_t *sleep_ticker = NULL;
@@ -50,9 +61,22 @@ static inline us_timestamp_t read_us(void)
 #endif
 }
 
+void sleep_manager_report_idle(us_timestamp_t time)
+{
+    core_util_critical_section_enter();
+    idle_time += time;
+    core_util_critical_section_exit();
+}
+
 us_timestamp_t mbed_time_idle(void)
 {
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CPU_STATS_ENABLED)
+    // measured around each pass of the RTOS idle loop, which includes the
+    // time spent asleep as well as busy idling
+    return idle_time;
+#else
     return (sleep_time + deep_sleep_time);
+#endif
 }
 
 us_timestamp_t mbed_uptime(void)
@@ -183,11 +207,70 @@ bool sleep_manager_can_deep_sleep(void)
     return deep_sleep_lock == 0 ? true : false;
 }
 
+MBED_WEAK uint32_t sleep_manager_deep_sleep_latency(void)
+{
+    // targets override this with their measured deepsleep wakeup latency
+    return 0;
+}
+
+void sleep_manager_set_latency(sleep_latency_constraint_t *constraint, uint32_t latency_us)
+{
+    core_util_critical_section_enter();
+    constraint->latency_us = latency_us;
+    constraint->next = latency_constraints;
+    latency_constraints = constraint;
+    core_util_critical_section_exit();
+}
+
+void sleep_manager_clear_latency(sleep_latency_constraint_t *constraint)
+{
+    core_util_critical_section_enter();
+    sleep_latency_constraint_t **p = &latency_constraints;
+    while (*p != NULL) {
+        if (*p == constraint) {
+            *p = constraint->next;
+            break;
+        }
+        p = &(*p)->next;
+    }
+    core_util_critical_section_exit();
+}
+
+uint32_t sleep_manager_allowed_latency(void)
+{
+    uint32_t allowed = UINT32_MAX;
+    core_util_critical_section_enter();
+    for (const sleep_latency_constraint_t *c = latency_constraints; c != NULL; c = c->next) {
+        if (c->latency_us < allowed) {
+            allowed = c->latency_us;
+        }
+    }
+    core_util_critical_section_exit();
+    return allowed;
+}
+
+void sleep_manager_get_stats(sleep_manager_stats_t *stats)
+{
+    core_util_critical_section_enter();
+    stats->sleep_time = sleep_time;
+    stats->deep_sleep_time = deep_sleep_time;
+    stats->sleep_entries = sleep_entries;
+    stats->deep_sleep_entries = deep_sleep_entries;
+    stats->deep_sleep_blocked_lock = deep_sleep_blocked_lock;
+    stats->deep_sleep_blocked_latency = deep_sleep_blocked_latency;
+    core_util_critical_section_exit();
+}
+
+MBED_WEAK void sleep_manager_idle_hook(void)
+{
+}
+
 void sleep_manager_sleep_auto(void)
 {
 #ifdef MBED_SLEEP_TRACING_ENABLED
     sleep_tracker_print_stats();
 #endif
+    sleep_manager_idle_hook();
     core_util_critical_section_enter();
     us_timestamp_t start = read_us();
     bool deep = false;
@@ -196,8 +279,15 @@ void sleep_manager_sleep_auto(void)
 #ifdef MBED_DEBUG
     hal_sleep();
 #else
-    if (sleep_manager_can_deep_sleep()) {
+    if (!sleep_manager_can_deep_sleep()) {
+        deep_sleep_blocked_lock++;
+    } else if (sleep_manager_deep_sleep_latency() > sleep_manager_allowed_latency()) {
+        deep_sleep_blocked_latency++;
+    } else {
         deep = true;
+    }
+
+    if (deep) {
         hal_deepsleep();
     } else {
         hal_sleep();
@@ -206,8 +296,10 @@ void sleep_manager_sleep_auto(void)
 
     us_timestamp_t end = read_us();
     if (true == deep) {
+        deep_sleep_entries++;
         deep_sleep_time += end - start;
     } else {
+        sleep_entries++;
         sleep_time += end - start;
     }
     core_util_critical_section_exit();
@@ -234,4 +326,30 @@ bool sleep_manager_can_deep_sleep(void)
     return false;
 }
 
+void sleep_manager_set_latency(sleep_latency_constraint_t *constraint, uint32_t latency_us)
+{
+    (void)constraint;
+    (void)latency_us;
+}
+
+void sleep_manager_clear_latency(sleep_latency_constraint_t *constraint)
+{
+    (void)constraint;
+}
+
+uint32_t sleep_manager_allowed_latency(void)
+{
+    return UINT32_MAX;
+}
+
+uint32_t sleep_manager_deep_sleep_latency(void)
+{
+    return 0;
+}
+
+void sleep_manager_get_stats(sleep_manager_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
 #endif
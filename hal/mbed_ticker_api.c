@@ -22,6 +22,77 @@
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
 
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+
+/*
+ * Timing wheel scheduler mode.
+ *
+ * Events are hashed by timestamp into unsorted per-slot lists, so insertion
+ * and removal touch a single bucket instead of walking a sorted list inside
+ * the critical section. queue->head caches the earliest pending event, which
+ * keeps schedule_interrupt() and ticker_get_next_timestamp() unchanged; it
+ * is recomputed only when the cached event fires or is removed.
+ *
+ * Events overdue by more than one wheel rotation may execute slightly out of
+ * timestamp order relative to each other, but never late relative to the
+ * sorted list behaviour.
+ */
+
+static uint32_t wheel_slot(us_timestamp_t timestamp)
+{
+    return (uint32_t)(timestamp >> MBED_TICKER_WHEEL_SLOT_SHIFT) & (MBED_TICKER_WHEEL_SLOTS - 1);
+}
+
+/*
+ * Unlink an event from its wheel slot. Does nothing if the event is not
+ * queued.
+ */
+static void wheel_unlink(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    ticker_event_t **link = &queue->wheel[wheel_slot(obj->timestamp)];
+    while (*link != NULL) {
+        if (*link == obj) {
+            *link = obj->next;
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+/*
+ * Find the earliest pending event on the wheel.
+ *
+ * Slots are scanned in wheel order starting from the slot of the present
+ * time. Within one rotation, slot order equals time order, so the scan can
+ * stop at the first slot containing an event due within its own window;
+ * events belonging to later rotations only contribute to the running
+ * minimum.
+ */
+static ticker_event_t *wheel_earliest(ticker_event_queue_t *queue)
+{
+    uint64_t base = queue->present_time >> MBED_TICKER_WHEEL_SLOT_SHIFT;
+    ticker_event_t *best = NULL;
+
+    for (uint32_t d = 0; d < MBED_TICKER_WHEEL_SLOTS; d++) {
+        uint32_t slot = (uint32_t)(base + d) & (MBED_TICKER_WHEEL_SLOTS - 1);
+        bool due_in_window = false;
+        for (ticker_event_t *p = queue->wheel[slot]; p != NULL; p = p->next) {
+            if ((best == NULL) || (p->timestamp < best->timestamp)) {
+                best = p;
+            }
+            if ((p->timestamp >> MBED_TICKER_WHEEL_SLOT_SHIFT) <= base + d) {
+                due_in_window = true;
+            }
+        }
+        if (due_in_window) {
+            break;
+        }
+    }
+    return best;
+}
+
+#endif /* MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL */
+
 /*
  * Initialize a ticker instance.  
  */
@@ -61,6 +132,11 @@ static void initialize(const ticker_data_t *ticker)
 
     ticker->queue->event_handler = NULL;
     ticker->queue->head = NULL;
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+    for (uint32_t i = 0; i < MBED_TICKER_WHEEL_SLOTS; i++) {
+        ticker->queue->wheel[i] = NULL;
+    }
+#endif
     ticker->queue->tick_last_read = ticker->interface->read();
     ticker->queue->tick_remainder = 0;
     ticker->queue->frequency = frequency;
@@ -292,7 +368,12 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             // This event was in the past:
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+            wheel_unlink(ticker->queue, p);
+            ticker->queue->head = wheel_earliest(ticker->queue);
+#else
             ticker->queue->head = ticker->queue->head->next;
+#endif
             if (ticker->queue->event_handler != NULL) {
                 (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -339,6 +420,19 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     obj->timestamp = timestamp;
     obj->id = id;
 
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+    /* Push onto the event's wheel slot - O(1), no list walk. Only a new
+       earliest event needs the interrupt rescheduled. */
+    uint32_t slot = wheel_slot(timestamp);
+    obj->next = ticker->queue->wheel[slot];
+    ticker->queue->wheel[slot] = obj;
+
+    if ((ticker->queue->head == NULL) ||
+            (timestamp < ticker->queue->head->timestamp)) {
+        ticker->queue->head = obj;
+        schedule_interrupt(ticker);
+    }
+#else
     /* Go through the list until we either reach the end, or find
        an element this should come before (which is possibly the
        head). */
@@ -363,6 +457,7 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     } else {
         prev->next = obj;
     }
+#endif /* MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL */
 
     core_util_critical_section_exit();
 }
@@ -371,6 +466,13 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
 {
     core_util_critical_section_enter();
 
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+    wheel_unlink(ticker->queue, obj);
+    if (ticker->queue->head == obj) {
+        ticker->queue->head = wheel_earliest(ticker->queue);
+        schedule_interrupt(ticker);
+    }
+#else
     // remove this object from the list
     if (ticker->queue->head == obj) {
         // first in the list, so just drop me
@@ -387,6 +489,7 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
             p = p->next;
         }
     }
+#endif /* MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL */
 
     core_util_critical_section_exit();
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "hal/us_ticker_api.h"
+#include "platform/mbed_critical.h"
 
 static ticker_event_queue_t events = { 0 };
 
@@ -54,3 +55,82 @@ void us_ticker_irq_handler(void)
         irq_handler(&us_data);
     }
 }
+
+/* Fast timestamp path. The hardware counter width, frequency and (for
+ * power-of-two frequencies) shift are cached on first use, and the raw
+ * 32-bit counter is extended to 64 bits by accumulating observed
+ * rollovers - so a timestamp is one counter read and a compare, with
+ * none of the present-time bookkeeping ticker_read_us does. */
+static struct {
+    uint32_t bitmask;       /* mask for the counter's width */
+    uint32_t frequency;     /* ticks per second */
+    uint32_t last_raw;      /* previous raw read, for rollover detection */
+    uint64_t base;          /* ticks accumulated from rollovers */
+    uint8_t shifts;         /* n when frequency == 2^n, else 0 */
+    bool cached;
+} timestamp_state;
+
+static void us_ticker_timestamp_cache(void)
+{
+    if (!events.initialized) {
+        /* Counter not running yet; init is safe to repeat when the
+         * common ticker layer initializes later */
+        us_ticker_init();
+    }
+
+    const ticker_info_t *info = us_ticker_get_info();
+    timestamp_state.frequency = info->frequency;
+    timestamp_state.bitmask = (info->bits >= 32) ? 0xFFFFFFFF : ((1U << info->bits) - 1);
+    timestamp_state.shifts = 0;
+    for (uint8_t i = 1; i < 32; i++) {
+        if (info->frequency == (1U << i)) {
+            timestamp_state.shifts = i;
+            break;
+        }
+    }
+    timestamp_state.last_raw = us_ticker_read() & timestamp_state.bitmask;
+    timestamp_state.base = 0;
+    timestamp_state.cached = true;
+}
+
+us_tick_t us_ticker_timestamp(void)
+{
+    core_util_critical_section_enter();
+    if (!timestamp_state.cached) {
+        us_ticker_timestamp_cache();
+    }
+    uint32_t raw = us_ticker_read() & timestamp_state.bitmask;
+    if (raw < timestamp_state.last_raw) {
+        timestamp_state.base += (uint64_t) timestamp_state.bitmask + 1;
+    }
+    timestamp_state.last_raw = raw;
+    us_tick_t ticks = timestamp_state.base + raw;
+    core_util_critical_section_exit();
+
+    return ticks;
+}
+
+uint64_t us_ticker_ticks_to_us(us_tick_t ticks)
+{
+    uint32_t frequency = us_ticker_timestamp_frequency();
+
+    if (frequency == 1000000) {
+        return ticks;
+    }
+    if (timestamp_state.shifts) {
+        return (ticks * 1000000ULL) >> timestamp_state.shifts;
+    }
+    return ticks * 1000000ULL / frequency;
+}
+
+uint32_t us_ticker_timestamp_frequency(void)
+{
+    if (!timestamp_state.cached) {
+        core_util_critical_section_enter();
+        if (!timestamp_state.cached) {
+            us_ticker_timestamp_cache();
+        }
+        core_util_critical_section_exit();
+    }
+    return timestamp_state.frequency;
+}
@@ -19,6 +19,7 @@
 #ifndef MBED_PWMOUT_API_H
 #define MBED_PWMOUT_API_H
 
+#include <stddef.h>
 #include "device.h"
 
 #if DEVICE_PWMOUT
@@ -107,6 +108,23 @@ void pwmout_pulsewidth_ms(pwmout_t *obj, int ms);
  */
 void pwmout_pulsewidth_us(pwmout_t *obj, int us);
 
+/** Write several duty-cycles as one synchronized update
+ *
+ * All channels take their new duty-cycle in the same instant, so a
+ * multi-phase bridge sees a phase-coherent commit rather than channels
+ * staggered by per-call overhead. Targets whose timer banks support
+ * buffered compare loads (preload/update-disable or equivalent) should
+ * override this to latch every staged value on one update event; the
+ * default implementation writes the channels back to back inside a
+ * critical section, which removes the per-call overhead but cannot
+ * guarantee a single-cycle commit.
+ *
+ * @param objs   Array of pwmout objects to update
+ * @param values Duty-cycles in range <0.0f, 1.0f>, one per object
+ * @param count  Number of channels to update
+ */
+void pwmout_group_write(pwmout_t **objs, const float *values, size_t count);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,177 @@
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_QSPI_API_H
+#define MBED_QSPI_API_H
+
+#include "device.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_QSPI
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** QSPI HAL object
+ */
+typedef struct qspi_s qspi_t;
+
+/** Bus width for a phase of a QSPI command
+ */
+typedef enum qspi_bus_width {
+    QSPI_CFG_BUS_SINGLE,
+    QSPI_CFG_BUS_DUAL,
+    QSPI_CFG_BUS_QUAD,
+} qspi_bus_width_t;
+
+/** Address size in bits for the address phase of a QSPI command
+ */
+typedef enum qspi_address_size {
+    QSPI_CFG_ADDR_SIZE_8,
+    QSPI_CFG_ADDR_SIZE_16,
+    QSPI_CFG_ADDR_SIZE_24,
+    QSPI_CFG_ADDR_SIZE_32,
+} qspi_address_size_t;
+
+/** QSPI command, defines each phase of a flash transaction
+ */
+typedef struct qspi_command {
+    struct {
+        qspi_bus_width_t bus_width; /**< Bus width for the instruction phase */
+        uint8_t value;              /**< Instruction value */
+        bool disabled;              /**< Skip the instruction phase */
+    } instruction;
+    struct {
+        qspi_bus_width_t bus_width; /**< Bus width for the address phase */
+        qspi_address_size_t size;   /**< Address size */
+        uint32_t value;             /**< Address value */
+        bool disabled;              /**< Skip the address phase */
+    } address;
+    uint8_t dummy_count;            /**< Number of dummy cycles between address and data */
+    struct {
+        qspi_bus_width_t bus_width; /**< Bus width for the data phase */
+    } data;
+} qspi_command_t;
+
+/** QSPI return status
+ */
+typedef enum qspi_status {
+    QSPI_STATUS_OK = 0,                 /**< Operation successful */
+    QSPI_STATUS_ERROR = -1,             /**< Generic error */
+    QSPI_STATUS_INVALID_PARAMETER = -2, /**< The parameters are not valid */
+} qspi_status_t;
+
+/**
+ * \defgroup hal_qspi QSPI Hardware Abstraction Layer
+ * @{
+ */
+
+/** Initialize the QSPI peripheral
+ *
+ * Configures the pins, sets the clock mode and frequency, and enables the
+ * peripheral in command (indirect) mode
+ *
+ * @param[out] obj  The QSPI object to initialize
+ * @param[in]  io0  Data pin 0
+ * @param[in]  io1  Data pin 1
+ * @param[in]  io2  Data pin 2, NC if the bus is no wider than dual
+ * @param[in]  io3  Data pin 3, NC if the bus is no wider than dual
+ * @param[in]  sclk The pin to use for SCLK
+ * @param[in]  ssel The pin to use for SSEL
+ * @param[in]  hz   The bus frequency in hertz
+ * @param[in]  mode The clock polarity and phase, 0 or 3
+ * @return QSPI_STATUS_OK on success
+ */
+qspi_status_t qspi_init(qspi_t *obj, PinName io0, PinName io1, PinName io2, PinName io3,
+                        PinName sclk, PinName ssel, uint32_t hz, uint8_t mode);
+
+/** Release the QSPI peripheral
+ *
+ * Return the pins owned by the QSPI object to their reset state and
+ * disable the peripheral clock
+ *
+ * @param[in] obj The QSPI object to deinitialize
+ * @return QSPI_STATUS_OK on success
+ */
+qspi_status_t qspi_free(qspi_t *obj);
+
+/** Set the QSPI bus frequency
+ *
+ * The actual frequency may differ from the desired one due to available dividers
+ *
+ * @param[in,out] obj The QSPI object to configure
+ * @param[in]     hz  The bus frequency in hertz
+ * @return QSPI_STATUS_OK on success
+ */
+qspi_status_t qspi_frequency(qspi_t *obj, int hz);
+
+/** Send a command and write data in command mode
+ *
+ * @param[in]     obj     The QSPI object to use
+ * @param[in]     command The command to send before the data phase
+ * @param[in]     data    The buffer with data to write, may be NULL for a bare command
+ * @param[in,out] length  In: bytes to write, out: bytes actually written
+ * @return QSPI_STATUS_OK on success
+ */
+qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void *data, size_t *length);
+
+/** Send a command and read data in command mode
+ *
+ * @param[in]     obj     The QSPI object to use
+ * @param[in]     command The command to send before the data phase
+ * @param[out]    data    The buffer read data is stored to
+ * @param[in,out] length  In: bytes to read, out: bytes actually read
+ * @return QSPI_STATUS_OK on success
+ */
+qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
+
+/** Enter memory-mapped (XIP) mode
+ *
+ * The peripheral decodes reads of a CPU address window into the given read
+ * command, so the flash contents appear as ordinary memory. While mapped,
+ * command mode transfers are not available - call qspi_mmap_disable()
+ * before qspi_read()/qspi_write().
+ *
+ * @param[in]  obj          The QSPI object to configure
+ * @param[in]  read_command The read command the peripheral issues on bus fetches,
+ *                          with the address phase filled by the hardware
+ * @param[out] base         Set to the base CPU address of the mapped window
+ * @return QSPI_STATUS_OK on success, QSPI_STATUS_ERROR if the target cannot map
+ */
+qspi_status_t qspi_mmap_enable(qspi_t *obj, const qspi_command_t *read_command, const void **base);
+
+/** Leave memory-mapped (XIP) mode and return to command mode
+ *
+ * @param[in] obj The QSPI object to configure
+ * @return QSPI_STATUS_OK on success
+ */
+qspi_status_t qspi_mmap_disable(qspi_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -219,6 +219,29 @@ void serial_pinout_tx(PinName tx);
  */
 void serial_set_flow_control(serial_t *obj, FlowControl type, PinName rxflow, PinName txflow);
 
+#if DEVICE_SERIAL_9BIT_MULTIDROP
+
+/** Configure 9-bit multidrop address matching.
+ *
+ * When enabled the receiver enters mute mode and stays silent until an
+ * address frame - a frame with the 9th (address-mark) bit set - carrying
+ * the given address is seen on the bus. Data frames belonging to other
+ * nodes do not generate RX interrupts; after a matching address frame the
+ * following data frames are received normally, until an address frame for
+ * another node mutes the receiver again.
+ *
+ * Targets with hardware address matching define
+ * DEVICE_SERIAL_9BIT_MULTIDROP and implement this function; without it
+ * the driver layer falls back to filtering in the RX interrupt.
+ *
+ * @param obj     The serial object
+ * @param address The node address to match
+ * @param enable  1 to enable address matching and mute, 0 to disable
+ */
+void serial_address_match(serial_t *obj, uint8_t address, int enable);
+
+#endif
+
 #if DEVICE_SERIAL_ASYNCH
 
 /**@}*/
@@ -67,11 +67,21 @@ typedef struct {
     const ticker_info_t *(*get_info)(void);       /**< Return info about this ticker's implementation */
 } ticker_interface_t;
 
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+/** Number of slots of the timing wheel scheduler, must be a power of two */
+#define MBED_TICKER_WHEEL_SLOTS      32
+/** log2 of a wheel slot's span in us (1 << 10 == 1024 us per slot) */
+#define MBED_TICKER_WHEEL_SLOT_SHIFT 10
+#endif
+
 /** Ticker's event queue structure
  */
 typedef struct {
     ticker_event_handler event_handler; /**< Event handler */
     ticker_event_t *head;               /**< A pointer to head */
+#if MBED_CONF_PLATFORM_TICKER_TIMING_WHEEL
+    ticker_event_t *wheel[MBED_TICKER_WHEEL_SLOTS]; /**< Timing wheel slots, head caches the earliest event */
+#endif
     uint32_t frequency;                 /**< Frequency of the timer in Hz */
     uint32_t bitmask;                   /**< Mask to be applied to time values read */
     uint32_t max_delta;                 /**< Largest delta in ticks that can be used when scheduling */
@@ -129,6 +129,46 @@ const ticker_data_t* get_us_ticker_data(void);
  */
 void us_ticker_irq_handler(void);
 
+/** Monotonic tick count of the microsecond ticker, extended to 64 bits */
+typedef uint64_t us_tick_t;
+
+/** Read a monotonic 64-bit timestamp in raw ticks
+ *
+ * Fast path for high-rate timestamping: one hardware counter read and a
+ * rollover check inside a short critical section, using conversion
+ * constants cached from ::us_ticker_get_info on first use - none of the
+ * interval math and frequency scaling of ::ticker_read_us. Safe from any
+ * context.
+ *
+ * Ticks are converted to wall-clock units with ::us_ticker_ticks_to_us,
+ * typically only for the few timestamps that end up displayed.
+ *
+ * @note The 64-bit extension is maintained by observing rollovers, so
+ * this function must be called at least once per counter rollover period
+ * (for example every 65 ms for a 16-bit ticker at 1 MHz) to stay
+ * monotonic. Timestamping at packet rate satisfies this by a wide
+ * margin.
+ *
+ * @return Ticks since the first call, monotonically increasing
+ */
+us_tick_t us_ticker_timestamp(void);
+
+/** Convert raw timestamp ticks to microseconds
+ *
+ * Uses the cached ticker frequency; a 1 MHz ticker converts with no
+ * arithmetic at all and power-of-two frequencies with a shift.
+ *
+ * @param ticks Tick count from ::us_ticker_timestamp
+ * @return The corresponding time in microseconds
+ */
+uint64_t us_ticker_ticks_to_us(us_tick_t ticks);
+
+/** Frequency the timestamp ticks run at
+ *
+ * @return The cached ticker frequency in Hz
+ */
+uint32_t us_ticker_timestamp_frequency(void);
+
 /* HAL us ticker */
 
 /** Initialize the ticker
@@ -60,8 +60,10 @@
 #include "drivers/AnalogIn.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
+#include "drivers/PwmOutGroup.h"
 #include "drivers/Serial.h"
 #include "drivers/SPI.h"
+#include "drivers/TypedSPI.h"
 #include "drivers/SPISlave.h"
 #include "drivers/I2C.h"
 #include "drivers/I2CSlave.h"
@@ -70,17 +72,21 @@
 #include "drivers/RawSerial.h"
 #include "drivers/UARTSerial.h"
 #include "drivers/FlashIAP.h"
+#include "drivers/ImageVerifier.h"
 #include "drivers/MbedCRC.h"
 
 // mbed Internal components
 #include "drivers/Timer.h"
 #include "drivers/Ticker.h"
+#include "drivers/DeferredTicker.h"
 #include "drivers/Timeout.h"
 #include "drivers/LowPowerTimeout.h"
 #include "drivers/LowPowerTicker.h"
 #include "drivers/LowPowerTimer.h"
 #include "platform/LocalFileSystem.h"
 #include "drivers/InterruptIn.h"
+#include "drivers/TimestampedInterruptIn.h"
+#include "drivers/WakeupLatencyProbe.h"
 #include "platform/mbed_wait_api.h"
 #include "hal/sleep_api.h"
 #include "platform/mbed_power_mgmt.h"
@@ -92,6 +98,7 @@
 #include "platform/DirHandle.h"
 #include "platform/CriticalSectionLock.h"
 #include "platform/DeepSleepLock.h"
+#include "platform/WakeLatencyLock.h"
 #include "platform/mbed_stats.h"
 
 // mbed Non-hardware components
@@ -180,6 +180,314 @@ int ATCmdParser::vscanf(const char *format, va_list args)
 }
 
 
+// Compiled command templates
+static bool is_simple_conv(char c)
+{
+    return c == 'd' || c == 'u' || c == 'x' || c == 's' || c == 'c' || c == '%';
+}
+
+// Minimal integer formatter for the template fast path; returns the
+// number of characters written (at most 11 for 32-bit values)
+static int format_uint(char *out, unsigned int value, unsigned int base)
+{
+    char tmp[12];
+    int n = 0;
+    do {
+        unsigned int digit = value % base;
+        tmp[n++] = (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+        value /= base;
+    } while (value);
+    for (int i = 0; i < n; i++) {
+        out[i] = tmp[n-1-i];
+    }
+    return n;
+}
+
+ATCmdParser::Template::Template(const char *format)
+    : _segments(NULL), _nsegments(0), _lines(NULL), _nlines(0)
+{
+    size_t len = strlen(format);
+    _format = new char[len + 1];
+    memcpy(_format, format, len + 1);
+
+    // Send view: literal runs separated by simple conversions. If the
+    // format uses flags, widths or other specifiers we leave _segments
+    // NULL and vsend falls back to the formatted path.
+    bool simple = true;
+    int nsegs = 1;
+    for (size_t i = 0; format[i]; i++) {
+        if (format[i] == '%') {
+            if (!is_simple_conv(format[i+1])) {
+                simple = false;
+                break;
+            }
+            nsegs++;
+            i++;
+        }
+    }
+    if (simple) {
+        _segments = new send_segment[nsegs];
+        _nsegments = nsegs;
+        int seg = 0;
+        const char *start = _format;
+        for (size_t i = 0; _format[i]; i++) {
+            if (_format[i] == '%') {
+                _segments[seg].text = start;
+                _segments[seg].len = &_format[i] - start;
+                _segments[seg].conv = _format[i+1];
+                seg++;
+                i++;
+                start = &_format[i+1];
+            }
+        }
+        _segments[seg].text = start;
+        _segments[seg].len = strlen(start);
+        _segments[seg].conv = 0;
+    }
+
+    // Receive view: split into lines and pre-build the %*-clobbered match
+    // strings that vrecv otherwise rebuilds in its buffer on every call
+    int nlines = 0;
+    const char *response = format;
+    while (response[0]) {
+        int i = 0;
+        while (response[i]) {
+            if (response[i] == '%' && response[i+1] != '%' && response[i+1] != '*') {
+                i++;
+            } else {
+                i++;
+                if (response[i - 1] == '\n' && !(i >= 3 && response[i-3] == '[' && response[i-2] == '^')) {
+                    break;
+                }
+            }
+        }
+        nlines++;
+        response += i;
+    }
+    _lines = new recv_line[nlines];
+    _nlines = nlines;
+    response = format;
+    for (int l = 0; l < nlines; l++) {
+        recv_line &line = _lines[l];
+        line.whole_line_wanted = false;
+        int i = 0;
+        int offset = 0;
+        while (response[i]) {
+            if (response[i] == '%' && response[i+1] != '%' && response[i+1] != '*') {
+                offset += 2;
+                i++;
+            } else {
+                offset++;
+                i++;
+                if (response[i - 1] == '\n' && !(i >= 3 && response[i-3] == '[' && response[i-2] == '^')) {
+                    line.whole_line_wanted = true;
+                    break;
+                }
+            }
+        }
+        line.fmt = new char[i + 1];
+        memcpy(line.fmt, response, i);
+        line.fmt[i] = 0;
+        line.match_fmt = new char[offset + 3];
+        offset = 0;
+        for (int k = 0; k < i; ) {
+            if (response[k] == '%' && response[k+1] != '%' && response[k+1] != '*') {
+                line.match_fmt[offset++] = '%';
+                line.match_fmt[offset++] = '*';
+                k++;
+            } else {
+                line.match_fmt[offset++] = response[k++];
+            }
+        }
+        line.match_fmt[offset++] = '%';
+        line.match_fmt[offset++] = 'n';
+        line.match_fmt[offset] = 0;
+        response += i;
+    }
+}
+
+ATCmdParser::Template::~Template()
+{
+    for (int l = 0; l < _nlines; l++) {
+        delete[] _lines[l].fmt;
+        delete[] _lines[l].match_fmt;
+    }
+    delete[] _lines;
+    delete[] _segments;
+    delete[] _format;
+}
+
+bool ATCmdParser::vsend(const Template *tmpl, va_list args)
+{
+    if (!tmpl->_segments) {
+        // Format too rich for the template fast path
+        return vsend(tmpl->_format, args);
+    }
+
+    // Substitute the arguments directly - no format parsing
+    int pos = 0;
+    for (int s = 0; s < tmpl->_nsegments; s++) {
+        const Template::send_segment &seg = tmpl->_segments[s];
+        // Worst case following conversion is an 11 character integer
+        if (pos + seg.len + 12 >= _buffer_size) {
+            return false;
+        }
+        memcpy(_buffer + pos, seg.text, seg.len);
+        pos += seg.len;
+        switch (seg.conv) {
+            case 0:
+                break;
+            case '%':
+                _buffer[pos++] = '%';
+                break;
+            case 'c':
+                _buffer[pos++] = (char)va_arg(args, int);
+                break;
+            case 's': {
+                const char *str = va_arg(args, const char *);
+                int slen = strlen(str);
+                if (pos + slen + 1 >= _buffer_size) {
+                    return false;
+                }
+                memcpy(_buffer + pos, str, slen);
+                pos += slen;
+                break;
+            }
+            case 'd': {
+                int value = va_arg(args, int);
+                if (value < 0) {
+                    _buffer[pos++] = '-';
+                    value = -value;
+                }
+                pos += format_uint(_buffer + pos, (unsigned int)value, 10);
+                break;
+            }
+            case 'u':
+                pos += format_uint(_buffer + pos, va_arg(args, unsigned int), 10);
+                break;
+            case 'x':
+                pos += format_uint(_buffer + pos, va_arg(args, unsigned int), 16);
+                break;
+        }
+    }
+    _buffer[pos] = 0;
+
+    for (int i = 0; _buffer[i]; i++) {
+        if (putc(_buffer[i]) < 0) {
+            return false;
+        }
+    }
+
+    // Finish with newline
+    for (size_t i = 0; _output_delimiter[i]; i++) {
+        if (putc(_output_delimiter[i]) < 0) {
+            return false;
+        }
+    }
+
+    debug_if(_dbg_on, "AT> %s\n", _buffer);
+    return true;
+}
+
+bool ATCmdParser::vrecv(const Template *tmpl, va_list args)
+{
+    _aborted = false;
+    // Iterate through each pre-compiled line of the expected response
+    for (int l = 0; l < tmpl->_nlines; l++) {
+        const Template::recv_line &line = tmpl->_lines[l];
+        debug_if(_dbg_on, "AT? %s\n", line.match_fmt);
+
+        int j = 0;
+        _oob_scan = _oob_trie;
+
+        while (true) {
+            // Receive next character
+            int c = getc();
+            if (c < 0) {
+                debug_if(_dbg_on, "AT(Timeout)\n");
+                return false;
+            }
+            // Simplify newlines (borrowed from retarget.cpp)
+            if ((c == CR && _in_prev != LF) ||
+                (c == LF && _in_prev != CR)) {
+                _in_prev = c;
+                c = '\n';
+            } else if ((c == CR && _in_prev == LF) ||
+                       (c == LF && _in_prev == CR)) {
+                _in_prev = c;
+                // onto next character
+                continue;
+            } else {
+                _in_prev = c;
+            }
+            _buffer[j++] = c;
+            _buffer[j] = 0;
+
+            // Check for oob data
+            if (struct oob *oob = oob_match(c)) {
+                debug_if(_dbg_on, "AT! %s\n", oob->prefix);
+                oob->cb();
+
+                if (_aborted) {
+                    debug_if(_dbg_on, "AT(Aborted)\n");
+                    return false;
+                }
+                // oob may have corrupted the non-reentrant buffer, so
+                // restart the current line; the compiled match string is
+                // untouched in the template
+                _aborted = false;
+                j = 0;
+                _oob_scan = _oob_trie;
+                continue;
+            }
+
+            // Check for match
+            int count = -1;
+            if (line.whole_line_wanted && c != '\n') {
+                // Don't attempt scanning until we get delimiter if they included it in format
+            } else {
+                sscanf(_buffer, line.match_fmt, &count);
+            }
+
+            // We only succeed if all characters in the response are matched
+            if (count == j) {
+                debug_if(_dbg_on, "AT= %s\n", _buffer);
+                // Store the found results
+                vsscanf(_buffer, line.fmt, args);
+                break;
+            }
+
+            // Clear the buffer when we hit a newline or ran out of space
+            // running out of space usually means we ran into binary data
+            if (c == '\n' || j+1 >= _buffer_size) {
+                debug_if(_dbg_on, "AT< %s", _buffer);
+                j = 0;
+                _oob_scan = _oob_trie;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ATCmdParser::send(const Template *tmpl, ...)
+{
+    va_list args;
+    va_start(args, tmpl);
+    bool res = vsend(tmpl, args);
+    va_end(args);
+    return res;
+}
+
+bool ATCmdParser::recv(const Template *tmpl, ...)
+{
+    va_list args;
+    va_start(args, tmpl);
+    bool res = vrecv(tmpl, args);
+    va_end(args);
+    return res;
+}
+
 // Command parsing with line handling
 bool ATCmdParser::vsend(const char *command, va_list args)
 {
@@ -250,6 +558,7 @@ restart:
         // We keep trying the match until we succeed or some other error
         // derails us.
         int j = 0;
+        _oob_scan = _oob_trie;
 
         while (true) {
             // Receive next character
@@ -275,20 +584,17 @@ restart:
             _buffer[offset + j] = 0;
 
             // Check for oob data
-            for (struct oob *oob = _oobs; oob; oob = oob->next) {
-                if ((unsigned)j == oob->len && memcmp(
-                        oob->prefix, _buffer+offset, oob->len) == 0) {
-                    debug_if(_dbg_on, "AT! %s\n", oob->prefix);
-                    oob->cb();
-
-                    if (_aborted) {
-                        debug_if(_dbg_on, "AT(Aborted)\n");
-                        return false;
-                    }
-                    // oob may have corrupted non-reentrant buffer,
-                    // so we need to set it up again
-                    goto restart;
+            if (struct oob *oob = oob_match(c)) {
+                debug_if(_dbg_on, "AT! %s\n", oob->prefix);
+                oob->cb();
+
+                if (_aborted) {
+                    debug_if(_dbg_on, "AT(Aborted)\n");
+                    return false;
                 }
+                // oob may have corrupted non-reentrant buffer,
+                // so we need to set it up again
+                goto restart;
             }
 
             // Check for match
@@ -321,6 +627,7 @@ restart:
             if (c == '\n' || j+1 >= _buffer_size - offset) {
                 debug_if(_dbg_on, "AT< %s", _buffer+offset);
                 j = 0;
+                _oob_scan = _oob_trie;
             }
         }
     }
@@ -374,6 +681,61 @@ void ATCmdParser::oob(const char *prefix, Callback<void()> cb)
     oob->cb = cb;
     oob->next = _oobs;
     _oobs = oob;
+    oob_insert(oob);
+}
+
+void ATCmdParser::oob_insert(struct oob *oob)
+{
+    oob_node **slot = &_oob_trie;
+    for (unsigned i = 0; i < oob->len; i++) {
+        oob_node *node = *slot;
+        while (node && node->ch != oob->prefix[i]) {
+            node = node->sibling;
+        }
+        if (!node) {
+            node = new oob_node;
+            node->ch = oob->prefix[i];
+            node->sibling = *slot;
+            node->child = NULL;
+            node->handler = NULL;
+            *slot = node;
+        }
+        if (i + 1 == oob->len) {
+            // Newest registration wins for an identical prefix, matching
+            // the head-first order of the _oobs list
+            node->handler = oob;
+        }
+        slot = &node->child;
+    }
+    // A prefix registered mid-line takes effect from the next line; the
+    // in-progress match state is deliberately left alone
+}
+
+// Advance the prefix match by one received byte. Returns the handler of a
+// fully matched prefix, or NULL. A mismatch parks the scan until the
+// caller resets _oob_scan at the next line boundary.
+struct ATCmdParser::oob *ATCmdParser::oob_match(char c)
+{
+    oob_node *node = _oob_scan;
+    while (node && node->ch != c) {
+        node = node->sibling;
+    }
+    if (!node) {
+        _oob_scan = NULL;
+        return NULL;
+    }
+    _oob_scan = node->child;
+    return node->handler;
+}
+
+void ATCmdParser::oob_free(oob_node *node)
+{
+    while (node) {
+        oob_node *sibling = node->sibling;
+        oob_free(node->child);
+        delete node;
+        node = sibling;
+    }
 }
 
 void ATCmdParser::abort()
@@ -388,6 +750,7 @@ bool ATCmdParser::process_oob()
     }
 
     int i = 0;
+    _oob_scan = _oob_trie;
     while (true) {
         // Receive next character
         int c = getc();
@@ -411,22 +774,18 @@ bool ATCmdParser::process_oob()
         _buffer[i] = 0;
 
         // Check for oob data
-        struct oob *oob = _oobs;
-        while (oob) {
-            if (i == (int)oob->len && memcmp(
-                    oob->prefix, _buffer, oob->len) == 0) {
-                debug_if(_dbg_on, "AT! %s\r\n", oob->prefix);
-                oob->cb();
-                return true;
-            }
-            oob = oob->next;
+        if (struct oob *oob = oob_match(c)) {
+            debug_if(_dbg_on, "AT! %s\r\n", oob->prefix);
+            oob->cb();
+            return true;
         }
-        
+
         // Clear the buffer when we hit a newline or ran out of space
         // running out of space usually means we ran into binary data
         if (((i+1) >= _buffer_size) || (c == '\n')) {
             debug_if(_dbg_on, "AT< %s", _buffer);
             i = 0;
+            _oob_scan = _oob_trie;
         }
     }
 }
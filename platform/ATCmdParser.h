@@ -78,8 +78,76 @@ private:
     };
     oob *_oobs;
 
+    /* Sparse trie over the registered oob prefixes. Each node holds one
+     * prefix character; alternatives at the same depth chain through
+     * 'sibling', the following character hangs off 'child'. Matching
+     * advances one node per received byte, so the per-byte cost depends
+     * on the fan-out at the current depth, not on how many handlers are
+     * registered. */
+    struct oob_node {
+        char ch;
+        oob_node *sibling;
+        oob_node *child;
+        struct oob *handler;
+    };
+    oob_node *_oob_trie;
+    // Current match position; NULL once the line cannot match any prefix
+    oob_node *_oob_scan;
+
+    void oob_insert(struct oob *oob);
+    struct oob *oob_match(char c);
+    static void oob_free(oob_node *node);
+
 public:
 
+    /**
+     * A pre-parsed send/receive format string
+     *
+     * Compiling a format once and replaying it avoids re-running the
+     * printf/scanf format machinery for commands that are exchanged over
+     * and over. The send side is split into literal runs plus plain
+     * %d/%u/%x/%s/%c/%% conversions that are substituted directly; a
+     * format using anything fancier still works but falls back to the
+     * regular formatted path. The receive side pre-builds the per-line
+     * match strings that vrecv otherwise reconstructs on every call.
+     *
+     * @code
+     * static ATCmdParser::Template set_rate("AT+CWMODE=%d");
+     * static ATCmdParser::Template ok("OK");
+     * at.send(&set_rate, 3) && at.recv(&ok);
+     * @endcode
+     */
+    class Template : private NonCopyable<Template> {
+        friend class ATCmdParser;
+    public:
+        /**
+         * Compile a format string for repeated use with send() and recv()
+         *
+         * @param format printf/scanf-like format string; the template
+         *               keeps its own copy
+         */
+        Template(const char *format);
+        ~Template();
+    private:
+        // One literal run of the send format followed by one conversion
+        struct send_segment {
+            const char *text;
+            int len;
+            char conv;
+        };
+        // One line of the receive format with its pre-clobbered match string
+        struct recv_line {
+            char *fmt;
+            char *match_fmt;
+            bool whole_line_wanted;
+        };
+        char *_format;
+        send_segment *_segments;
+        int _nsegments;
+        recv_line *_lines;
+        int _nlines;
+    };
+
     /**
      * Constructor
      *
@@ -91,7 +159,8 @@ public:
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
              int buffer_size = 256, int timeout = 8000, bool debug = false)
-            : _fh(fh), _buffer_size(buffer_size), _in_prev(0), _oobs(NULL)
+            : _fh(fh), _buffer_size(buffer_size), _in_prev(0), _oobs(NULL),
+              _oob_trie(NULL), _oob_scan(NULL)
     {
         _buffer = new char[buffer_size];
         set_timeout(timeout);
@@ -109,6 +178,7 @@ public:
             _oobs = oob->next;
             delete oob;
         }
+        oob_free(_oob_trie);
         delete[] _buffer;
     }
 
@@ -202,6 +272,20 @@ public:
 
     bool vsend(const char *command, va_list args);
 
+    /**
+     * Sends a pre-compiled AT command
+     *
+     * Replays a Template with only argument substitution - the format
+     * string is not parsed again.
+     *
+     * @param tmpl compiled command template
+     * @param ... arguments for the template's conversions
+     * @return true only if command is successfully sent
+     */
+    bool send(const Template *tmpl, ...);
+
+    bool vsend(const Template *tmpl, va_list args);
+
     /**
      * Receive an AT response
      *
@@ -220,6 +304,21 @@ public:
 
     bool vrecv(const char *response, va_list args);
 
+    /**
+     * Receive a pre-compiled AT response
+     *
+     * Matches a Template using the match strings built at compile time
+     * instead of rebuilding them per call. Semantics otherwise follow
+     * recv(), including out-of-band handling.
+     *
+     * @param tmpl compiled response template
+     * @param ... arguments to extract from the response
+     * @return true only if response is successfully matched
+     */
+    bool recv(const Template *tmpl, ...);
+
+    bool vrecv(const Template *tmpl, va_list args);
+
     /**
      * Write a single byte to the underlying stream
      *
@@ -0,0 +1,369 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOUNDCALLBACK_H
+#define MBED_BOUNDCALLBACK_H
+
+#include <string.h>
+#include <stdint.h>
+#include <new>
+#include "platform/mbed_assert.h"
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_BoundCallback BoundCallback class
+ * @{
+ */
+
+/** Lightweight callback with inline bound arguments and direct dispatch
+ *
+ *  A slimmer sibling of Callback for dispatch hot paths. Callback routes
+ *  every invocation through an operations table (one indirection to find
+ *  the call thunk, one for the call itself) so it can manage arbitrary
+ *  functor lifetimes. BoundCallback trades that generality for speed and
+ *  footprint: the attached target must be trivially copyable and fit the
+ *  fixed inline storage, which lets the class keep a single trampoline
+ *  function pointer and pay exactly one indirect call per invocation,
+ *  with no operations table and never a heap allocation.
+ *
+ *  Unlike Callback, extra arguments can be bound by value at attach time,
+ *  so no wrapper functor is needed to call f(arg) from a void() context:
+ *
+ *  @code
+ *  void set_level(int level);
+ *  BoundCallback<void()> cb(set_level, 3); // calls set_level(3)
+ *  @endcode
+ *
+ *  Bound arguments must each fit in a machine word and be trivially
+ *  copyable; this is asserted at compile time.
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename F>
+class BoundCallback;
+
+/** BoundCallback for functions taking no call-time arguments
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename R>
+class BoundCallback<R()> {
+public:
+    /** Create an empty BoundCallback
+     */
+    BoundCallback() : _call(0) {
+    }
+
+    /** Create a BoundCallback with a static function
+     *  @param func     Static function to attach
+     */
+    BoundCallback(R (*func)()) {
+        target_fn *t = new (&_storage) target_fn;
+        t->func = func;
+        _call = &call_fn;
+    }
+
+    /** Create a BoundCallback with a static function and one bound argument
+     *  @param func     Static function to attach
+     *  @param arg      Argument bound by value, passed on every call
+     */
+    template <typename A>
+    BoundCallback(R (*func)(A), A arg) {
+        MBED_STATIC_ASSERT(sizeof(target_fn_arg<A>) <= sizeof(Storage),
+                "Bound argument does not fit the inline storage");
+        target_fn_arg<A> *t = new (&_storage) target_fn_arg<A>;
+        t->func = func;
+        t->arg = arg;
+        _call = &call_fn_arg<A>;
+    }
+
+    /** Create a BoundCallback with a static function and two bound arguments
+     *  @param func     Static function to attach
+     *  @param arg0     First argument bound by value
+     *  @param arg1     Second argument bound by value
+     */
+    template <typename A, typename B>
+    BoundCallback(R (*func)(A, B), A arg0, B arg1) {
+        MBED_STATIC_ASSERT(sizeof(target_fn_arg2<A, B>) <= sizeof(Storage),
+                "Bound arguments do not fit the inline storage");
+        target_fn_arg2<A, B> *t = new (&_storage) target_fn_arg2<A, B>;
+        t->func = func;
+        t->arg0 = arg0;
+        t->arg1 = arg1;
+        _call = &call_fn_arg2<A, B>;
+    }
+
+    /** Create a BoundCallback with a member function
+     *  @param obj      Pointer to object to invoke member function on
+     *  @param method   Member function to attach
+     */
+    template <typename T, typename U>
+    BoundCallback(U *obj, R (T::*method)()) {
+        MBED_STATIC_ASSERT(sizeof(target_method<T, R (T::*)()>) <= sizeof(Storage),
+                "Member pointer does not fit the inline storage");
+        target_method<T, R (T::*)()> *t =
+                new (&_storage) target_method<T, R (T::*)()>;
+        t->obj = obj;
+        t->method = method;
+        _call = &call_method<T, R (T::*)()>;
+    }
+
+    /** Call the attached function
+     */
+    R call() const {
+        MBED_ASSERT(_call);
+        return _call(&_storage);
+    }
+
+    /** Call the attached function
+     */
+    R operator()() const {
+        return call();
+    }
+
+    /** Test if function has been attached
+     */
+    operator bool() const {
+        return _call != 0;
+    }
+
+private:
+    /* All targets are trivially copyable PODs, so copy/assign/destroy need
+     * no operations table - the default memberwise behaviour is correct */
+    struct target_fn {
+        R (*func)();
+    };
+
+    template <typename A>
+    struct target_fn_arg {
+        R (*func)(A);
+        A arg;
+    };
+
+    template <typename A, typename B>
+    struct target_fn_arg2 {
+        R (*func)(A, B);
+        A arg0;
+        B arg1;
+    };
+
+    template <typename T, typename M>
+    struct target_method {
+        T *obj;
+        M method;
+    };
+
+    static R call_fn(const void *p) {
+        const target_fn *t = static_cast<const target_fn *>(p);
+        return t->func();
+    }
+
+    template <typename A>
+    static R call_fn_arg(const void *p) {
+        const target_fn_arg<A> *t = static_cast<const target_fn_arg<A> *>(p);
+        return t->func(t->arg);
+    }
+
+    template <typename A, typename B>
+    static R call_fn_arg2(const void *p) {
+        const target_fn_arg2<A, B> *t = static_cast<const target_fn_arg2<A, B> *>(p);
+        return t->func(t->arg0, t->arg1);
+    }
+
+    template <typename T, typename M>
+    static R call_method(const void *p) {
+        const target_method<T, M> *t = static_cast<const target_method<T, M> *>(p);
+        return (t->obj->*(t->method))();
+    }
+
+    /* Room for a function pointer plus two word-sized bound arguments, or
+     * an object pointer plus a (possibly fat) member pointer */
+    struct Storage {
+        uintptr_t words[4];
+    };
+
+    R (*_call)(const void *);
+    Storage _storage;
+};
+
+/** BoundCallback for functions taking one call-time argument
+ *
+ *  Bound arguments are prepended, so a BoundCallback<R(A0)> attached with
+ *  (func, arg) invokes func(arg, a0).
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename R, typename A0>
+class BoundCallback<R(A0)> {
+public:
+    /** Create an empty BoundCallback
+     */
+    BoundCallback() : _call(0) {
+    }
+
+    /** Create a BoundCallback with a static function
+     *  @param func     Static function to attach
+     */
+    BoundCallback(R (*func)(A0)) {
+        target_fn *t = new (&_storage) target_fn;
+        t->func = func;
+        _call = &call_fn;
+    }
+
+    /** Create a BoundCallback with a static function and one bound argument
+     *  @param func     Static function to attach
+     *  @param arg      Argument bound by value, prepended on every call
+     */
+    template <typename A>
+    BoundCallback(R (*func)(A, A0), A arg) {
+        MBED_STATIC_ASSERT(sizeof(target_fn_arg<A>) <= sizeof(Storage),
+                "Bound argument does not fit the inline storage");
+        target_fn_arg<A> *t = new (&_storage) target_fn_arg<A>;
+        t->func = func;
+        t->arg = arg;
+        _call = &call_fn_arg<A>;
+    }
+
+    /** Create a BoundCallback with a member function
+     *  @param obj      Pointer to object to invoke member function on
+     *  @param method   Member function to attach
+     */
+    template <typename T, typename U>
+    BoundCallback(U *obj, R (T::*method)(A0)) {
+        MBED_STATIC_ASSERT(sizeof(target_method<T, R (T::*)(A0)>) <= sizeof(Storage),
+                "Member pointer does not fit the inline storage");
+        target_method<T, R (T::*)(A0)> *t =
+                new (&_storage) target_method<T, R (T::*)(A0)>;
+        t->obj = obj;
+        t->method = method;
+        _call = &call_method<T, R (T::*)(A0)>;
+    }
+
+    /** Call the attached function
+     *  @param a0       Call-time argument
+     */
+    R call(A0 a0) const {
+        MBED_ASSERT(_call);
+        return _call(&_storage, a0);
+    }
+
+    /** Call the attached function
+     *  @param a0       Call-time argument
+     */
+    R operator()(A0 a0) const {
+        return call(a0);
+    }
+
+    /** Test if function has been attached
+     */
+    operator bool() const {
+        return _call != 0;
+    }
+
+private:
+    struct target_fn {
+        R (*func)(A0);
+    };
+
+    template <typename A>
+    struct target_fn_arg {
+        R (*func)(A, A0);
+        A arg;
+    };
+
+    template <typename T, typename M>
+    struct target_method {
+        T *obj;
+        M method;
+    };
+
+    static R call_fn(const void *p, A0 a0) {
+        const target_fn *t = static_cast<const target_fn *>(p);
+        return t->func(a0);
+    }
+
+    template <typename A>
+    static R call_fn_arg(const void *p, A0 a0) {
+        const target_fn_arg<A> *t = static_cast<const target_fn_arg<A> *>(p);
+        return t->func(t->arg, a0);
+    }
+
+    template <typename T, typename M>
+    static R call_method(const void *p, A0 a0) {
+        const target_method<T, M> *t = static_cast<const target_method<T, M> *>(p);
+        return (t->obj->*(t->method))(a0);
+    }
+
+    struct Storage {
+        uintptr_t words[4];
+    };
+
+    R (*_call)(const void *, A0);
+    Storage _storage;
+};
+
+/** Create a bound callback class with type infered from the arguments
+ *
+ *  @param func     Static function to attach
+ *  @return         BoundCallback with infered type
+ */
+template <typename R>
+BoundCallback<R()> bound_callback(R (*func)()) {
+    return BoundCallback<R()>(func);
+}
+
+/** Create a bound callback class with type infered from the arguments
+ *
+ *  @param func     Static function to attach
+ *  @param arg      Argument bound by value
+ *  @return         BoundCallback with infered type
+ */
+template <typename R, typename A>
+BoundCallback<R()> bound_callback(R (*func)(A), A arg) {
+    return BoundCallback<R()>(func, arg);
+}
+
+/** Create a bound callback class with type infered from the arguments
+ *
+ *  @param func     Static function to attach
+ *  @param arg0     First argument bound by value
+ *  @param arg1     Second argument bound by value
+ *  @return         BoundCallback with infered type
+ */
+template <typename R, typename A, typename B>
+BoundCallback<R()> bound_callback(R (*func)(A, B), A arg0, B arg1) {
+    return BoundCallback<R()>(func, arg0, arg1);
+}
+
+/** Create a bound callback class with type infered from the arguments
+ *
+ *  @param obj      Pointer to object to invoke member function on
+ *  @param method   Member function to attach
+ *  @return         BoundCallback with infered type
+ */
+template <typename T, typename U, typename R>
+BoundCallback<R()> bound_callback(U *obj, R (T::*method)()) {
+    return BoundCallback<R()>(obj, method);
+}
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
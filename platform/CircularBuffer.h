@@ -155,6 +155,65 @@ public:
         return elements;
     }
 
+    /** Claim a pointer to the longest contiguous block of buffered data
+     *
+     *  Gives zero-copy read access into the buffer. The block stays valid
+     *  until it is consumed with drop(), provided nothing else pops from
+     *  the buffer and no producer pushes into a full buffer (push to a
+     *  full buffer overwrites the claimed data).
+     *
+     *  The buffered data may wrap around the pool, so the block can be
+     *  shorter than size(); call again after drop() to claim the rest.
+     *
+     * @param data Updated to point at the first buffered element
+     * @return Number of contiguous elements available at *data, zero if empty
+     */
+    CounterType peek_block(const T **data) const {
+        core_util_critical_section_enter();
+        CounterType elements;
+        if ((_head == _tail) && !_full) {
+            elements = 0;
+        } else if (_head > _tail) {
+            elements = _head - _tail;
+        } else {
+            elements = BufferSize - _tail;
+        }
+        *data = &_pool[_tail];
+        core_util_critical_section_exit();
+        return elements;
+    }
+
+    /** Drop elements from the front of the buffer without reading them
+     *
+     *  Used together with peek_block() to consume data that was accessed
+     *  in place.
+     *
+     * @param len Number of elements to drop
+     * @return Number of elements actually dropped, limited by the buffer content
+     */
+    CounterType drop(CounterType len) {
+        core_util_critical_section_enter();
+        CounterType elements;
+        if (!_full) {
+            if (_head < _tail) {
+                elements = BufferSize + _head - _tail;
+            } else {
+                elements = _head - _tail;
+            }
+        } else {
+            elements = BufferSize;
+        }
+        if (len > elements) {
+            len = elements;
+        }
+        if (len > 0) {
+            _tail = (_tail + len) % BufferSize;
+            _full = false;
+        }
+        core_util_critical_section_exit();
+        return len;
+    }
+
     /** Peek into circular buffer without popping
      *
      * @param data Data to be peeked from the buffer
@@ -178,6 +237,146 @@ private:
     volatile bool _full;
 };
 
+/** Lock-free single-producer single-consumer circular buffer
+ *
+ *  A specialization of CircularBuffer for the common ISR-to-thread pipe:
+ *  exactly one context pushes and exactly one context pops. Under that
+ *  restriction the producer only ever writes _head and the consumer only
+ *  ever writes _tail, so neither side needs to mask interrupts - an ISR
+ *  producer never disables interrupts and a thread consumer never delays
+ *  the ISR.
+ *
+ *  The indices run freely and are wrapped with a mask, so BufferSize must
+ *  be a power of two.
+ *
+ *  @note Synchronization level: Interrupt safe (single producer, single
+ *        consumer only)
+ */
+template<typename T, uint32_t BufferSize>
+class SPSCCircularBuffer {
+public:
+    SPSCCircularBuffer() : _head(0), _tail(0) {
+        MBED_STATIC_ASSERT(
+            (BufferSize & (BufferSize - 1)) == 0,
+            "BufferSize must be a power of two"
+        );
+    }
+
+    /** Push a single element to the buffer
+     *
+     *  Must only be called from the producer context.
+     *
+     * @param data Data to be pushed to the buffer
+     * @return True if the element was pushed, false if the buffer is full
+     */
+    bool push(const T& data) {
+        if (_head - _tail == BufferSize) {
+            return false;
+        }
+        _pool[_head & (BufferSize - 1)] = data;
+        // Publishing the element must happen before the index moves;
+        // both are ordered on a single core by the volatile accesses
+        _head = _head + 1;
+        return true;
+    }
+
+    /** Push a span of elements to the buffer
+     *
+     *  Copies as many elements as fit and moves the index once, so a
+     *  burst costs one index update instead of one per element. Must only
+     *  be called from the producer context.
+     *
+     * @param data Elements to be pushed to the buffer
+     * @param len  Number of elements to push
+     * @return Number of elements actually pushed
+     */
+    uint32_t push(const T *data, uint32_t len) {
+        uint32_t free = BufferSize - (_head - _tail);
+        if (len > free) {
+            len = free;
+        }
+        uint32_t head = _head;
+        for (uint32_t i = 0; i < len; i++) {
+            _pool[(head + i) & (BufferSize - 1)] = data[i];
+        }
+        _head = head + len;
+        return len;
+    }
+
+    /** Pop a single element from the buffer
+     *
+     *  Must only be called from the consumer context.
+     *
+     * @param data Data to be popped from the buffer
+     * @return True if the buffer was not empty and data contains an element, false otherwise
+     */
+    bool pop(T& data) {
+        if (_head == _tail) {
+            return false;
+        }
+        data = _pool[_tail & (BufferSize - 1)];
+        _tail = _tail + 1;
+        return true;
+    }
+
+    /** Pop a span of elements from the buffer
+     *
+     *  Copies out up to len elements and moves the index once. Must only
+     *  be called from the consumer context.
+     *
+     * @param data Buffer the elements are popped to
+     * @param len  Maximum number of elements to pop
+     * @return Number of elements actually popped
+     */
+    uint32_t pop(T *data, uint32_t len) {
+        uint32_t available = _head - _tail;
+        if (len > available) {
+            len = available;
+        }
+        uint32_t tail = _tail;
+        for (uint32_t i = 0; i < len; i++) {
+            data[i] = _pool[(tail + i) & (BufferSize - 1)];
+        }
+        _tail = tail + len;
+        return len;
+    }
+
+    /** Check if the buffer is empty
+     *
+     * @return True if the buffer is empty, false if not
+     */
+    bool empty() const {
+        return _head == _tail;
+    }
+
+    /** Check if the buffer is full
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const {
+        return (_head - _tail) == BufferSize;
+    }
+
+    /** Get the number of elements currently stored in the buffer */
+    uint32_t size() const {
+        return _head - _tail;
+    }
+
+    /** Reset the buffer
+     *
+     *  Not safe against a concurrently running producer or consumer; only
+     *  call while both sides are quiescent.
+     */
+    void reset() {
+        _tail = _head;
+    }
+
+private:
+    T _pool[BufferSize];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
 /**@}*/
 
 /**@}*/
@@ -57,6 +57,32 @@ public:
      */
     virtual ssize_t read(struct dirent *ent) = 0;
 
+    /** Read up to count directory entries in one call
+     *
+     *  The default implementation simply loops over read(). Directory
+     *  handles backed by real media are expected to override this so that a
+     *  whole batch is fetched per lock acquisition.
+     *
+     *  @param ents     Array of directory entries to fill out
+     *  @param count    Number of entries the array has room for
+     *  @return         Number of entries read, 0 at end of directory,
+     *                  negative error on failure
+     */
+    virtual ssize_t read(struct dirent *ents, size_t count)
+    {
+        size_t n = 0;
+        while (n < count) {
+            ssize_t res = read(&ents[n]);
+            if (res < 0) {
+                return res;
+            } else if (res == 0) {
+                break;
+            }
+            n++;
+        }
+        return n;
+    }
+
     /** Close a directory
      *
      *  @return          0 on success, negative error code on failure
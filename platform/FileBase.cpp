@@ -20,9 +20,21 @@
 namespace mbed {
 
 FileBase *FileBase::_head = NULL;
+FileBase *FileBase::_buckets[FileBase::HASH_BUCKETS];
 SingletonPtr<PlatformMutex> FileBase::_mutex;
 
+/* FNV-1a, cheap and well distributed for the short names in the registry */
+uint32_t FileBase::name_hash(const char *name, unsigned int len) {
+    uint32_t hash = 2166136261U;
+    for (unsigned int i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619U;
+    }
+    return hash;
+}
+
 FileBase::FileBase(const char *name, PathType t) : _next(NULL),
+                                                   _hash_next(NULL),
+                                                   _hash(0),
                                                    _name(name),
                                                    _path_type(t) {
     _mutex->lock();
@@ -30,6 +42,11 @@ FileBase::FileBase(const char *name, PathType t) : _next(NULL),
         // put this object at head of the list
         _next = _head;
         _head = this;
+        // and index it by name hash for lookup()
+        _hash = name_hash(name, std::strlen(name));
+        FileBase **bucket = &_buckets[_hash & (HASH_BUCKETS - 1)];
+        _hash_next = *bucket;
+        *bucket = this;
     } else {
         _next = NULL;
     }
@@ -49,6 +66,12 @@ FileBase::~FileBase() {
             }
             p->_next = _next;
         }
+        // and from its hash bucket
+        FileBase **bucket = &_buckets[_hash & (HASH_BUCKETS - 1)];
+        while (*bucket != this) {
+            bucket = &(*bucket)->_hash_next;
+        }
+        *bucket = _hash_next;
     }
     _mutex->unlock();
 
@@ -59,15 +82,17 @@ FileBase::~FileBase() {
 }
 
 FileBase *FileBase::lookup(const char *name, unsigned int len) {
+    uint32_t hash = name_hash(name, len);
     _mutex->lock();
-    FileBase *p = _head;
+    /* Walk only the matching hash bucket; the string compare runs just on
+     * the rare hash collision instead of on every registered object */
+    FileBase *p = _buckets[hash & (HASH_BUCKETS - 1)];
     while (p != NULL) {
-        /* Check that p->_name matches name and is the correct length */
-        if (p->_name != NULL && std::strncmp(p->_name, name, len) == 0 && std::strlen(p->_name) == len) {
+        if (p->_hash == hash && std::strncmp(p->_name, name, len) == 0 && std::strlen(p->_name) == len) {
             _mutex->unlock();
             return p;
         }
-        p = p->_next;
+        p = p->_hash_next;
     }
     _mutex->unlock();
     return NULL;
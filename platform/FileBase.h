@@ -57,10 +57,21 @@ public:
 
     /* disallow copy constructor and assignment operators */
 private:
+    /* Number of buckets in the name hash index; a power of two so the
+     * bucket is a mask of the hash */
+    static const unsigned int HASH_BUCKETS = 16;
+
+    static uint32_t name_hash(const char *name, unsigned int len);
+
     static FileBase *_head;
+    static FileBase *_buckets[HASH_BUCKETS];
     static SingletonPtr<PlatformMutex> _mutex;
 
     FileBase   *_next;
+    /* Chain of objects whose names share a hash bucket; lookup() walks
+     * this instead of the full registration list */
+    FileBase   *_hash_next;
+    uint32_t    _hash;
     const char * const _name;
     const PathType _path_type;
 };
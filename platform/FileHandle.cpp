@@ -33,4 +33,38 @@ off_t FileHandle::size()
     return size;
 }
 
+ssize_t FileHandle::pread(void *buffer, size_t size, off_t offset)
+{
+    /* remember our current position */
+    off_t off = seek(0, SEEK_CUR);
+    if (off < 0) {
+        return off;
+    }
+    off_t err = seek(offset, SEEK_SET);
+    if (err < 0) {
+        return err;
+    }
+    ssize_t res = read(buffer, size);
+    /* return to our old position */
+    seek(off, SEEK_SET);
+    return res;
+}
+
+ssize_t FileHandle::pwrite(const void *buffer, size_t size, off_t offset)
+{
+    /* remember our current position */
+    off_t off = seek(0, SEEK_CUR);
+    if (off < 0) {
+        return off;
+    }
+    off_t err = seek(offset, SEEK_SET);
+    if (err < 0) {
+        return err;
+    }
+    ssize_t res = write(buffer, size);
+    /* return to our old position */
+    seek(off, SEEK_SET);
+    return res;
+}
+
 } // namespace mbed
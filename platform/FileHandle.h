@@ -137,6 +137,68 @@ public:
      */
     virtual off_t size();
 
+    /** Read from the file at a given offset
+     *
+     *  The default implementation emulates the positioned read with seeks,
+     *  so it moves and restores the file position and is not safe against
+     *  concurrent users of the same handle. Implementations may override
+     *  it to read at the given offset atomically, letting concurrent
+     *  readers share one handle without racing on the file position.
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The offset in the file to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t pread(void *buffer, size_t size, off_t offset);
+
+    /** Write to the file at a given offset
+     *
+     *  The default implementation emulates the positioned write with
+     *  seeks, with the same caveats as the default pread.
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The offset in the file to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t pwrite(const void *buffer, size_t size, off_t offset);
+
+    /** Claim zero-copy read access to buffered receive data
+     *
+     *  Hands out a pointer to the longest contiguous run of data inside
+     *  the handle's internal receive buffer, so a protocol parser can work
+     *  on it in place instead of copying it out through read(). The claimed
+     *  region stays valid until it is consumed with read_release().
+     *
+     *  This is an optional extension: the default implementation returns
+     *  -ENOSYS, and callers should fall back to read() when they see it.
+     *  Handles with an internal receive buffer, such as UARTSerial, may
+     *  override it.
+     *
+     *  @param buffer   Updated to point at the first buffered byte
+     *  @return         The number of contiguous bytes available at *buffer,
+     *                  -ENOSYS if the handle has no claimable buffer,
+     *                  negative error on failure
+     */
+    virtual ssize_t read_claim(const char **buffer)
+    {
+        return -ENOSYS;
+    }
+
+    /** Consume data previously claimed with read_claim()
+     *
+     *  Releasing less than was claimed is allowed; the remainder stays
+     *  buffered.
+     *
+     *  @param amount   Number of bytes the caller has consumed
+     *  @return         The number of bytes released, negative error on failure
+     */
+    virtual ssize_t read_release(size_t amount)
+    {
+        return -ENOSYS;
+    }
+
     /** Move the file position to a given offset from a given location.
      *
      *  @param offset The offset from whence to move to
@@ -0,0 +1,143 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SEQLOCK_H
+#define MBED_SEQLOCK_H
+
+#include <stdint.h>
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_SeqLock SeqLock class
+ * @{
+ */
+
+/** Sequence lock synchronization primitive
+ *
+ *  A sequence lock publishes state from a single writer to any number of
+ *  readers without ever making the readers block each other or the writer.
+ *  The writer brackets its update with a version counter that is odd while
+ *  the write is in progress; readers copy the state and retry if the
+ *  version changed under them. Reads are lock-free and never serialize,
+ *  which makes the primitive a good fit for small read-mostly state such
+ *  as telemetry published at a high rate.
+ *
+ *  SeqLockBase is the untyped primitive for guarding arbitrary state; the
+ *  SeqLock template below pairs it with a typed copy of the value.
+ *
+ *  @note Synchronization level: Interrupt safe for readers. Writes must
+ *        come from a single context, or be serialized externally.
+ *  @note A reader spins while a write is in progress, so a writer that can
+ *        be preempted by its readers (a higher priority thread or an ISR)
+ *        should perform the write under a CriticalSectionLock.
+ */
+class SeqLockBase {
+public:
+    SeqLockBase() : _sequence(0) {
+    }
+
+    /** Mark the beginning of a write
+     *
+     *  Makes the sequence odd so that overlapping reads retry.
+     */
+    void write_begin() {
+        core_util_atomic_incr_u32(&_sequence, 1);
+    }
+
+    /** Mark the end of a write
+     */
+    void write_end() {
+        core_util_atomic_incr_u32(&_sequence, 1);
+    }
+
+    /** Begin a read attempt
+     *
+     *  Waits out a write in progress.
+     *
+     *  @return sequence to pass to read_retry once the state has been read
+     */
+    uint32_t read_begin() const {
+        uint32_t sequence;
+        do {
+            sequence = core_util_atomic_incr_u32(&_sequence, 0);
+        } while (sequence & 1);
+        return sequence;
+    }
+
+    /** Check whether a read attempt raced a write
+     *
+     *  @param sequence sequence returned by the matching read_begin
+     *  @return true if a write overlapped the read and it must be retried
+     */
+    bool read_retry(uint32_t sequence) const {
+        return core_util_atomic_incr_u32(&_sequence, 0) != sequence;
+    }
+
+private:
+    // loads go through the atomic add-of-zero so the surrounding data
+    // accesses cannot be reordered across them by the compiler
+    mutable volatile uint32_t _sequence;
+};
+
+/** Templated sequence lock holding a copy of the published value
+ *
+ *  @note T is copied in both write and read, so it should be small and
+ *        must not have side effects in its copy assignment.
+ */
+template<typename T>
+class SeqLock : public SeqLockBase {
+public:
+    SeqLock() : _value() {
+    }
+
+    /** Publish a new value
+     *
+     *  @param value value to publish to the readers
+     */
+    void write(const T &value) {
+        write_begin();
+        _value = value;
+        write_end();
+    }
+
+    /** Read the most recently published value
+     *
+     *  Retries until a copy untouched by concurrent writes was taken.
+     *
+     *  @param value destination for the published value
+     */
+    void read(T &value) const {
+        uint32_t sequence;
+        do {
+            sequence = read_begin();
+            value = _value;
+        } while (read_retry(sequence));
+    }
+
+private:
+    T _value;
+};
+
+/**@}*/
+
+/**@}*/
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SINGLE_OWNER_CHECKER_H
+#define MBED_SINGLE_OWNER_CHECKER_H
+
+#include <stddef.h>
+#include "platform/mbed_assert.h"
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include "cmsis_os2.h"
+#endif
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+
+/** Debug-build ownership check for single-owner driver objects.
+ *
+ *  A driver object declared single-owner elides its mutex, handing the
+ *  synchronization guarantee over to the caller. This helper verifies that
+ *  guarantee where it can: the first checked use records the calling
+ *  thread, and every later use asserts that it comes from the same thread.
+ *  The check costs nothing when asserts are disabled (NDEBUG) and does
+ *  nothing when no RTOS is present.
+ */
+class SingleOwnerChecker {
+public:
+    SingleOwnerChecker() : _owner_thread(NULL)
+    {
+    }
+
+    /** Record the calling thread on first use and assert that every
+     *  later use comes from the same thread
+     */
+    void check()
+    {
+#if defined(MBED_CONF_RTOS_PRESENT) && !defined(NDEBUG)
+        void *current = (void *) osThreadGetId();
+        if (_owner_thread == NULL) {
+            _owner_thread = current;
+        }
+        MBED_ASSERT(_owner_thread == current);
+#endif
+    }
+
+    /** Forget the recorded owner, so the next checked use may come from
+     *  any thread
+     */
+    void reset()
+    {
+        _owner_thread = NULL;
+    }
+
+private:
+    void *_owner_thread;
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
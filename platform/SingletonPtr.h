@@ -26,6 +26,9 @@
 #include <stdint.h>
 #include <new>
 #include "platform/mbed_assert.h"
+#ifdef MBED_INIT_REGISTRY_ENABLED
+#include "platform/mbed_init_registry.h"
+#endif
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #endif
@@ -84,7 +87,13 @@ struct SingletonPtr {
         if (NULL == _ptr) {
             singleton_lock();
             if (NULL == _ptr) {
+#ifdef MBED_INIT_REGISTRY_ENABLED
+                uint32_t start_us = mbed_init_registry_now();
+#endif
                 _ptr = new (_data) T();
+#ifdef MBED_INIT_REGISTRY_ENABLED
+                mbed_init_registry_record(NULL, _data, start_us);
+#endif
             }
             singleton_unlock();
         }
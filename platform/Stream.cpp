@@ -17,6 +17,12 @@
 #include "platform/mbed_error.h"
 #include <errno.h>
 
+/* printf lines up to this long are formatted on the stack and written in
+ * a single write() call; longer ones fall back to the per-byte FILE path */
+#ifndef STREAM_PRINTF_BUFFER_SIZE
+#define STREAM_PRINTF_BUFFER_SIZE 128
+#endif
+
 namespace mbed {
 
 Stream::Stream(const char *name) : FileLike(name), _file(NULL) {
@@ -125,13 +131,10 @@ off_t Stream::size() {
 }
 
 int Stream::printf(const char* format, ...) {
-    lock();
     std::va_list arg;
     va_start(arg, format);
-    fflush(_file);
-    int r = vfprintf(_file, format, arg);
+    int r = vprintf(format, arg);
     va_end(arg);
-    unlock();
     return r;
 }
 
@@ -149,7 +152,20 @@ int Stream::scanf(const char* format, ...) {
 int Stream::vprintf(const char* format, std::va_list args) {
     lock();
     fflush(_file);
-    int r = vfprintf(_file, format, args);
+    /* format into a stack buffer and hand the line to write() in one
+     * call - the unbuffered FILE path below costs a virtual _putc call
+     * per byte */
+    char buffer[STREAM_PRINTF_BUFFER_SIZE];
+    std::va_list args_copy;
+    va_copy(args_copy, args);
+    int r = vsnprintf(buffer, sizeof(buffer), format, args_copy);
+    va_end(args_copy);
+    if (r >= 0 && r < (int)sizeof(buffer)) {
+        write(buffer, r);
+    } else {
+        // lines longer than the stack buffer take the stdio path
+        r = vfprintf(_file, format, args);
+    }
     unlock();
     return r;
 }
@@ -0,0 +1,78 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_WAKELATENCYLOCK_H
+#define MBED_WAKELATENCYLOCK_H
+
+#include "platform/mbed_power_mgmt.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_WakeLatencyLock WakeLatencyLock functions
+ * @{
+ */
+
+/** RAII object declaring a maximum tolerable wakeup latency
+  *
+  * While the object exists, the sleep manager only enters deepsleep if the
+  * target wakes from it within the declared budget; otherwise it falls
+  * back to sleep. Unlike DeepSleepLock this does not forbid deepsleep
+  * outright, so the system still reaches it on targets that wake fast
+  * enough.
+  *
+  * Usage:
+  * @code
+  *
+  * void f() {
+  *     {
+  *         WakeLatencyLock lock(1000);
+  *         // Wakeups in this block take at most 1 ms
+  *     }
+  *     // the previous latency budget is restored
+  * }
+  * @endcode
+  */
+class WakeLatencyLock : private NonCopyable<WakeLatencyLock> {
+public:
+    /** Declare a wakeup-latency budget
+     *
+     *  @param latency_us Max tolerable wakeup latency in microseconds
+     */
+    WakeLatencyLock(uint32_t latency_us)
+    {
+        sleep_manager_set_latency(&_constraint, latency_us);
+    }
+
+    ~WakeLatencyLock()
+    {
+        sleep_manager_clear_latency(&_constraint);
+    }
+
+private:
+    sleep_latency_constraint_t _constraint;
+};
+
+/**@}*/
+
+/**@}*/
+
+
+}
+
+#endif
@@ -49,6 +49,17 @@ typedef struct {
 #ifdef MBED_HEAP_STATS_ENABLED
 static SingletonPtr<PlatformMutex> malloc_stats_mutex;
 static mbed_stats_heap_t heap_stats = {0, 0, 0, 0, 0};
+static mbed_stats_heap_detail_t heap_detail = {};
+
+/* Power-of-two size class, the last class absorbs everything larger */
+static uint32_t heap_size_class(uint32_t size)
+{
+    uint32_t bucket = 0;
+    while ((size >>= 1) != 0 && bucket < MBED_STATS_HEAP_HIST_SIZE - 1) {
+        bucket++;
+    }
+    return bucket;
+}
 #endif
 
 void mbed_stats_heap_get(mbed_stats_heap_t *stats)
@@ -88,6 +99,11 @@ extern "C" {
 // TODO: memory tracing doesn't work with uVisor enabled.
 #if !defined(FEATURE_UVISOR)
 
+/* Unwrapped allocator access for the largest-free-block probe, so probe
+ * allocations don't pollute the statistics */
+#define MBED_HEAP_RAW_MALLOC(size) __real__malloc_r(_REENT, size)
+#define MBED_HEAP_RAW_FREE(ptr)    __real__free_r(_REENT, ptr)
+
 extern "C" void * __wrap__malloc_r(struct _reent * r, size_t size) {
     return malloc_wrapper(r, size, MBED_CALLER_ADDR());
 }
@@ -106,11 +122,13 @@ extern "C" void * malloc_wrapper(struct _reent * r, size_t size, void * caller)
         heap_stats.current_size += size;
         heap_stats.total_size += size;
         heap_stats.alloc_cnt += 1;
+        heap_detail.alloc_hist[heap_size_class(size)] += 1;
         if (heap_stats.current_size > heap_stats.max_size) {
             heap_stats.max_size = heap_stats.current_size;
         }
     } else {
         heap_stats.alloc_fail_cnt += 1;
+        heap_detail.fail_hist[heap_size_class(size)] += 1;
     }
     malloc_stats_mutex->unlock();
 #else // #ifdef MBED_HEAP_STATS_ENABLED
@@ -180,6 +198,7 @@ extern "C" void free_wrapper(struct _reent * r, void * ptr, void * caller) {
         alloc_info = ((alloc_info_t*)ptr) - 1;
         heap_stats.current_size -= alloc_info->size;
         heap_stats.alloc_cnt -= 1;
+        heap_detail.alloc_hist[heap_size_class(alloc_info->size)] -= 1;
     }
     __real__free_r(r, (void*)alloc_info);
     malloc_stats_mutex->unlock();
@@ -250,6 +269,11 @@ extern "C" void * __wrap__memalign_r(struct _reent * r, size_t alignment, size_t
 /* Enable hooking of memory function only if tracing is also enabled */
 #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
 
+/* Unwrapped allocator access for the largest-free-block probe, so probe
+ * allocations don't pollute the statistics */
+#define MBED_HEAP_RAW_MALLOC(size) SUPER_MALLOC(size)
+#define MBED_HEAP_RAW_FREE(ptr)    SUPER_FREE(ptr)
+
 extern "C" {
     void *SUPER_MALLOC(size_t size);
     void *SUPER_REALLOC(void *ptr, size_t size);
@@ -278,11 +302,13 @@ extern "C" void* malloc_wrapper(size_t size, void* caller) {
         heap_stats.current_size += size;
         heap_stats.total_size += size;
         heap_stats.alloc_cnt += 1;
+        heap_detail.alloc_hist[heap_size_class(size)] += 1;
         if (heap_stats.current_size > heap_stats.max_size) {
             heap_stats.max_size = heap_stats.current_size;
         }
     } else {
         heap_stats.alloc_fail_cnt += 1;
+        heap_detail.fail_hist[heap_size_class(size)] += 1;
     }
     malloc_stats_mutex->unlock();
 #else // #ifdef MBED_HEAP_STATS_ENABLED
@@ -369,6 +395,7 @@ extern "C" void free_wrapper(void *ptr, void* caller) {
         alloc_info = ((alloc_info_t*)ptr) - 1;
         heap_stats.current_size -= alloc_info->size;
         heap_stats.alloc_cnt -= 1;
+        heap_detail.alloc_hist[heap_size_class(alloc_info->size)] -= 1;
     }
     SUPER_FREE((void*)alloc_info);
     malloc_stats_mutex->unlock();
@@ -398,3 +425,56 @@ extern "C" void free_wrapper(void *ptr, void* caller) {
 #endif
 
 #endif // #if defined(TOOLCHAIN_GCC)
+
+/******************************************************************************/
+/* Heap fragmentation detail                                                  */
+/******************************************************************************/
+
+#if defined(MBED_HEAP_STATS_ENABLED) && defined(MBED_HEAP_RAW_MALLOC)
+
+/* Don't resolve the largest free block below this granularity; bounds the
+ * probe at a handful of transient allocations */
+#define HEAP_PROBE_GRANULARITY 16
+
+/* Binary-search the largest single allocation the heap can satisfy right
+ * now, probing through the unwrapped allocator so the attempts don't show
+ * up in the statistics. Runs under the stats mutex. */
+static uint32_t heap_probe_largest_free(uint32_t free_estimate)
+{
+    uint32_t good = 0;
+    uint32_t bad = free_estimate + HEAP_PROBE_GRANULARITY;
+
+    while (bad - good > HEAP_PROBE_GRANULARITY) {
+        uint32_t probe = good + (bad - good) / 2;
+        void *ptr = MBED_HEAP_RAW_MALLOC(probe);
+        if (ptr != NULL) {
+            MBED_HEAP_RAW_FREE(ptr);
+            good = probe;
+        } else {
+            bad = probe;
+        }
+    }
+    return good;
+}
+
+void mbed_stats_heap_detail_get(mbed_stats_heap_detail_t *stats)
+{
+    extern uint32_t mbed_heap_size;
+
+    malloc_stats_mutex->lock();
+    memcpy(stats, &heap_detail, sizeof(mbed_stats_heap_detail_t));
+    // Estimate ignores the allocator's own bookkeeping overhead
+    uint32_t used = heap_stats.current_size + heap_stats.alloc_cnt * sizeof(alloc_info_t);
+    stats->free_size = (used < mbed_heap_size) ? mbed_heap_size - used : 0;
+    stats->largest_free_block = heap_probe_largest_free(stats->free_size);
+    malloc_stats_mutex->unlock();
+}
+
+#else
+
+void mbed_stats_heap_detail_get(mbed_stats_heap_detail_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_heap_detail_t));
+}
+
+#endif // #if defined(MBED_HEAP_STATS_ENABLED) && defined(MBED_HEAP_RAW_MALLOC)
@@ -0,0 +1,157 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_arena.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+#include <stdlib.h>
+
+#define ARENA_ALIGNMENT 8
+#define ARENA_ALIGN(x) (((x) + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+/* Header prepended to malloc fallback blocks. The mark records the bump
+ * position at allocation time, so a rewind knows which fallback blocks
+ * belong to the scopes being released - the list is newest first and
+ * marks never decrease between rewinds, so freeing stops at the first
+ * block older than the rewind target. */
+typedef struct arena_fallback {
+    struct arena_fallback *next;
+    size_t mark;
+} arena_fallback_t;
+
+#define ARENA_FALLBACK_HEADER ARENA_ALIGN(sizeof(arena_fallback_t))
+
+/* Innermost-first stack of active scopes for the subsystem hooks */
+#define ARENA_SCOPE_DEPTH 4
+static mbed_arena_t *arena_scopes[ARENA_SCOPE_DEPTH];
+static uint32_t arena_scope_count;
+
+void mbed_arena_init(mbed_arena_t *arena, void *buffer, size_t size, bool fallback)
+{
+    arena->buffer = buffer;
+    arena->size = size;
+    arena->offset = 0;
+    arena->high_water = 0;
+    arena->fallback = fallback;
+    arena->fallbacks = NULL;
+}
+
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size)
+{
+    size_t offset = ARENA_ALIGN(arena->offset);
+
+    if (size <= arena->size && offset <= arena->size - size) {
+        arena->offset = offset + size;
+        if (arena->offset > arena->high_water) {
+            arena->high_water = arena->offset;
+        }
+        return arena->buffer + offset;
+    }
+
+    if (!arena->fallback) {
+        return NULL;
+    }
+
+    arena_fallback_t *block = malloc(ARENA_FALLBACK_HEADER + size);
+    if (!block) {
+        return NULL;
+    }
+    block->mark = arena->offset;
+    block->next = arena->fallbacks;
+    arena->fallbacks = block;
+    return (uint8_t *) block + ARENA_FALLBACK_HEADER;
+}
+
+size_t mbed_arena_mark(const mbed_arena_t *arena)
+{
+    return arena->offset;
+}
+
+void mbed_arena_rewind(mbed_arena_t *arena, size_t mark)
+{
+    MBED_ASSERT(mark <= arena->offset);
+
+    while (arena->fallbacks && arena->fallbacks->mark >= mark) {
+        arena_fallback_t *block = arena->fallbacks;
+        arena->fallbacks = block->next;
+        free(block);
+    }
+    arena->offset = mark;
+}
+
+void mbed_arena_reset(mbed_arena_t *arena)
+{
+    mbed_arena_rewind(arena, 0);
+}
+
+size_t mbed_arena_high_water(const mbed_arena_t *arena)
+{
+    return arena->high_water;
+}
+
+void mbed_arena_scope_enter(mbed_arena_t *arena)
+{
+    core_util_critical_section_enter();
+    MBED_ASSERT(arena_scope_count < ARENA_SCOPE_DEPTH);
+    arena_scopes[arena_scope_count++] = arena;
+    core_util_critical_section_exit();
+}
+
+void mbed_arena_scope_exit(mbed_arena_t *arena)
+{
+    core_util_critical_section_enter();
+    MBED_ASSERT(arena_scope_count > 0);
+    MBED_ASSERT(arena_scopes[arena_scope_count - 1] == arena);
+    arena_scope_count--;
+    core_util_critical_section_exit();
+}
+
+void *mbed_arena_scope_alloc(size_t size)
+{
+    if (arena_scope_count) {
+        return mbed_arena_alloc(arena_scopes[arena_scope_count - 1], size);
+    }
+    return malloc(size);
+}
+
+/* True when ptr lies in the arena's region or is one of its fallback blocks */
+static bool arena_owns(const mbed_arena_t *arena, const uint8_t *ptr)
+{
+    if (ptr >= arena->buffer && ptr < arena->buffer + arena->size) {
+        return true;
+    }
+    for (const arena_fallback_t *block = arena->fallbacks; block; block = block->next) {
+        if (ptr == (const uint8_t *) block + ARENA_FALLBACK_HEADER) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void mbed_arena_scope_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    for (uint32_t i = arena_scope_count; i > 0; i--) {
+        if (arena_owns(arena_scopes[i - 1], ptr)) {
+            // Released wholesale when the owning scope rewinds
+            return;
+        }
+    }
+    free(ptr);
+}
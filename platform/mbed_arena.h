@@ -0,0 +1,188 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_arena Arena allocator functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ARENA_H
+#define MBED_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+#include "platform/NonCopyable.h"
+
+extern "C" {
+#endif
+
+/* Region allocator for request-scoped buffers.
+ *
+ * An arena hands out 8-byte-aligned allocations by bumping a pointer
+ * through a caller-provided region; individual allocations are never
+ * freed, the whole scope is released at once with mbed_arena_rewind()
+ * or mbed_arena_reset(). Dozens of short-lived protocol buffers then
+ * cost one pointer increment each and leave no heap fragmentation
+ * behind. When the region is exhausted an arena can optionally fall
+ * back to malloc; fallback blocks are freed by the rewind that
+ * releases their scope and still show up in the mbed_mem_trace
+ * wrappers.
+ *
+ * An arena is not internally synchronized - each arena belongs to one
+ * transaction context at a time, matching the per-request usage it is
+ * built for.
+ */
+typedef struct mbed_arena {
+    uint8_t *buffer;                    /**< backing region */
+    size_t size;                        /**< region size in bytes */
+    size_t offset;                      /**< bump position */
+    size_t high_water;                  /**< largest offset reached */
+    bool fallback;                      /**< malloc when region exhausted */
+    struct arena_fallback *fallbacks;   /**< fallback blocks, newest first */
+} mbed_arena_t;
+
+/** Initialize an arena over a caller-provided region
+ *
+ *  @param arena    Arena to initialize
+ *  @param buffer   Backing memory region
+ *  @param size     Region size in bytes
+ *  @param fallback True to satisfy allocations from malloc once the
+ *                  region is exhausted, false to fail them
+ */
+void mbed_arena_init(mbed_arena_t *arena, void *buffer, size_t size, bool fallback);
+
+/** Allocate from an arena
+ *
+ *  @param arena Arena to allocate from
+ *  @param size  Number of bytes
+ *  @return 8-byte-aligned pointer, or NULL if the region is exhausted
+ *          and the arena has no fallback (or the fallback malloc failed)
+ */
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size);
+
+/** Take a scope marker
+ *
+ *  @param arena Arena to mark
+ *  @return Opaque marker for mbed_arena_rewind()
+ */
+size_t mbed_arena_mark(const mbed_arena_t *arena);
+
+/** Release everything allocated since a marker
+ *
+ *  Frees any fallback blocks taken since the marker and moves the bump
+ *  position back. Pointers handed out since the marker are invalid
+ *  afterwards.
+ *
+ *  @param arena Arena to rewind
+ *  @param mark  Marker from mbed_arena_mark()
+ */
+void mbed_arena_rewind(mbed_arena_t *arena, size_t mark);
+
+/** Release everything in the arena
+ *
+ *  Equivalent to rewinding to a marker taken just after init. The
+ *  high-water statistic is preserved across resets for sizing the
+ *  region.
+ *
+ *  @param arena Arena to reset
+ */
+void mbed_arena_reset(mbed_arena_t *arena);
+
+/** Largest bump position the arena has reached
+ *
+ *  @param arena Arena to query
+ *  @return High-water mark in bytes; region allocations only, fallback
+ *          blocks are not counted
+ */
+size_t mbed_arena_high_water(const mbed_arena_t *arena);
+
+/** Make an arena the current allocation scope
+ *
+ *  Subsystems with per-transaction allocations route them through
+ *  mbed_arena_scope_alloc()/mbed_arena_scope_free(); entering a scope
+ *  points those calls at the arena until the matching
+ *  mbed_arena_scope_exit(). Scopes nest (innermost wins) and must be
+ *  entered and exited from the same context that performs the
+ *  allocations.
+ *
+ *  @param arena Arena to route scoped allocations to
+ */
+void mbed_arena_scope_enter(mbed_arena_t *arena);
+
+/** Leave the current allocation scope
+ *
+ *  Does not rewind the arena - release is the owner's call.
+ *
+ *  @param arena Arena passed to the matching mbed_arena_scope_enter()
+ */
+void mbed_arena_scope_exit(mbed_arena_t *arena);
+
+/** Allocate from the current scope's arena, or malloc outside a scope
+ *
+ *  This is the hook for subsystems: call it where a transaction-scoped
+ *  buffer is created and behavior is unchanged until a caller opts in
+ *  by entering a scope.
+ *
+ *  @param size Number of bytes
+ *  @return Allocated memory, or NULL on failure
+ */
+void *mbed_arena_scope_alloc(size_t size);
+
+/** Release memory obtained from mbed_arena_scope_alloc()
+ *
+ *  Memory belonging to an active scope's arena is left for that
+ *  arena's rewind; anything else is passed to free().
+ *
+ *  @param ptr Memory to release, may be NULL
+ */
+void mbed_arena_scope_free(void *ptr);
+
+#ifdef __cplusplus
+}
+
+namespace mbed {
+
+/** RAII helper that enters an arena scope for the current block
+ *
+ * @note Synchronization level: Not protected
+ */
+class ArenaScope : private NonCopyable<ArenaScope> {
+public:
+    ArenaScope(mbed_arena_t *arena) : _arena(arena)
+    {
+        mbed_arena_scope_enter(_arena);
+    }
+
+    ~ArenaScope()
+    {
+        mbed_arena_scope_exit(_arena);
+    }
+
+private:
+    mbed_arena_t *_arena;
+};
+
+}
+#endif
+
+#endif
+
+/**@}*/
+
+/**@}*/
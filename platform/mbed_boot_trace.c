@@ -0,0 +1,92 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_boot_trace.h"
+
+#if defined(MBED_BOOT_TRACE_ENABLED)
+
+#include "device.h"
+#include "platform/mbed_toolchain.h"
+
+#if DEVICE_USTICKER
+
+#include "hal/us_ticker_api.h"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t recorded;      // bit per stage
+    uint32_t timestamp[MBED_BOOT_STAGE_COUNT];
+} boot_trace_table_t;
+
+#define BOOT_TRACE_MAGIC 0x42545243     // "BTRC"
+
+/* noinit so stamps taken before the zero-init pass survive it */
+static boot_trace_table_t boot_trace MBED_SECTION(".noinit");
+
+/* In normal BSS, so it is false once per boot after RAM init. A mark
+ * placed before RAM init reads it as garbage and may init the ticker an
+ * extra time - such early marks rely on the target ticker tolerating
+ * that, as the RAM init stamp does it again regardless. */
+static bool ticker_ready;
+
+void mbed_boot_trace_mark(mbed_boot_stage_t stage)
+{
+    if ((unsigned)stage >= MBED_BOOT_STAGE_COUNT) {
+        return;
+    }
+    if (boot_trace.magic != BOOT_TRACE_MAGIC) {
+        boot_trace.magic = BOOT_TRACE_MAGIC;
+        boot_trace.recorded = 0;
+    }
+    if (!ticker_ready) {
+        us_ticker_init();
+        ticker_ready = true;
+    }
+    boot_trace.timestamp[stage] = us_ticker_read();
+    boot_trace.recorded |= 1UL << stage;
+}
+
+bool mbed_boot_trace_read(mbed_boot_stage_t stage, uint32_t *timestamp_us)
+{
+    if ((unsigned)stage >= MBED_BOOT_STAGE_COUNT) {
+        return false;
+    }
+    if (boot_trace.magic != BOOT_TRACE_MAGIC || !(boot_trace.recorded & (1UL << stage))) {
+        return false;
+    }
+    if (timestamp_us != NULL) {
+        *timestamp_us = boot_trace.timestamp[stage];
+    }
+    return true;
+}
+
+#else // DEVICE_USTICKER
+
+void mbed_boot_trace_mark(mbed_boot_stage_t stage)
+{
+    (void)stage;
+}
+
+bool mbed_boot_trace_read(mbed_boot_stage_t stage, uint32_t *timestamp_us)
+{
+    (void)stage;
+    (void)timestamp_us;
+    return false;
+}
+
+#endif // DEVICE_USTICKER
+
+#endif // MBED_BOOT_TRACE_ENABLED
@@ -0,0 +1,85 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOOT_TRACE_H
+#define MBED_BOOT_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Boot-time budget tracker.
+ *
+ * When MBED_BOOT_TRACE_ENABLED is set, the startup code stamps each init
+ * stage with the microsecond ticker into a table placed in noinit RAM,
+ * so stamps taken before the zero-init pass are not wiped by it. The
+ * table is read back after boot with mbed_boot_trace_read to attribute
+ * the cold-boot budget stage by stage.
+ *
+ * Stages are stamped via the MBED_BOOT_TRACE_MARK macro, which compiles
+ * away when the tracker is disabled. The SystemInit stage has no generic
+ * call site - a target can mark it from its own startup if its ticker
+ * hardware runs that early. Timestamps are overwritten in place as each
+ * stage passes, so after a warm reset a stage not yet reached still
+ * holds the previous boot's value.
+ */
+
+/** Boot stages, in the order the startup passes them */
+typedef enum {
+    MBED_BOOT_STAGE_SYSTEM_INIT = 0,    /**< Target SystemInit done (target-marked, optional) */
+    MBED_BOOT_STAGE_RAM_INIT,           /**< C runtime entered, RAM initialized */
+    MBED_BOOT_STAGE_SDK_INIT,           /**< mbed_sdk_init returned */
+    MBED_BOOT_STAGE_RTOS_START,         /**< Kernel about to start */
+    MBED_BOOT_STAGE_MAIN,               /**< Handing over to the application */
+    MBED_BOOT_STAGE_COUNT
+} mbed_boot_stage_t;
+
+/** Stamp a boot stage with the current microsecond ticker value.
+ *
+ * Use the MBED_BOOT_TRACE_MARK macro rather than calling this directly,
+ * so the stamps compile away when the tracker is disabled.
+ *
+ *  @param stage  Stage being passed
+ */
+void mbed_boot_trace_mark(mbed_boot_stage_t stage);
+
+/** Read the timestamp recorded for a stage.
+ *
+ *  @param stage         Stage to query
+ *  @param timestamp_us  Written with the microsecond ticker value at the stamp
+ *  @return              True if the stage was stamped since the table was
+ *                       last valid, false otherwise
+ */
+bool mbed_boot_trace_read(mbed_boot_stage_t stage, uint32_t *timestamp_us);
+
+#if defined(MBED_BOOT_TRACE_ENABLED)
+#define MBED_BOOT_TRACE_MARK(stage) mbed_boot_trace_mark(stage)
+#else
+#define MBED_BOOT_TRACE_MARK(stage) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
@@ -45,6 +45,78 @@
 
 static volatile uint32_t critical_section_reentrancy_counter = 0;
 
+/* Interrupts-masked window instrumentation: time each outermost critical
+ * section with the DWT cycle counter, keeping the maximum and a log2
+ * histogram, optionally trapping when a window exceeds the configured
+ * threshold. Needs a core with a DWT - M3 and up. */
+#if defined(MBED_CRITICAL_STATS_ENABLED) && defined(DWT_BASE) && !defined(TARGET_CORTEX_A)
+#define CRITICAL_SECTION_STATS 1
+#else
+#define CRITICAL_SECTION_STATS 0
+#endif
+
+#if CRITICAL_SECTION_STATS
+
+#include <string.h>
+#include "platform/mbed_error.h"
+
+#ifndef MBED_CONF_PLATFORM_CRITICAL_SECTION_TRAP_CYCLES
+#define MBED_CONF_PLATFORM_CRITICAL_SECTION_TRAP_CYCLES 0
+#endif
+
+static uint32_t critical_section_start_cycles;
+static uint32_t critical_section_max_cycles;
+static uint32_t critical_section_hist[MBED_CRITICAL_STATS_HIST_SIZE];
+
+static void critical_stats_enter(void)
+{
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    critical_section_start_cycles = DWT->CYCCNT;
+}
+
+static void critical_stats_exit(void)
+{
+    uint32_t duration = DWT->CYCCNT - critical_section_start_cycles;
+    if (duration > critical_section_max_cycles) {
+        critical_section_max_cycles = duration;
+    }
+    uint32_t bucket = duration ? (31 - __CLZ(duration)) : 0;
+    if (bucket >= MBED_CRITICAL_STATS_HIST_SIZE) {
+        bucket = MBED_CRITICAL_STATS_HIST_SIZE - 1;
+    }
+    critical_section_hist[bucket]++;
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_TRAP_CYCLES > 0
+    if (duration > MBED_CONF_PLATFORM_CRITICAL_SECTION_TRAP_CYCLES) {
+        MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_TIME_OUT), "interrupts masked over threshold", duration);
+    }
+#endif
+}
+
+void core_util_critical_section_stats_read(uint32_t *max_cycles, uint32_t *hist)
+{
+    core_util_critical_section_enter();
+    if (max_cycles != NULL) {
+        *max_cycles = critical_section_max_cycles;
+    }
+    if (hist != NULL) {
+        memcpy(hist, critical_section_hist, sizeof critical_section_hist);
+    }
+    core_util_critical_section_exit();
+}
+
+void core_util_critical_section_stats_reset(void)
+{
+    core_util_critical_section_enter();
+    critical_section_max_cycles = 0;
+    memset(critical_section_hist, 0, sizeof critical_section_hist);
+    core_util_critical_section_exit();
+}
+
+#endif
+
 bool core_util_are_interrupts_enabled(void)
 {
 #if defined(__CORTEX_A9)
@@ -87,6 +159,12 @@ void core_util_critical_section_enter(void)
 
     hal_critical_section_enter();
 
+#if CRITICAL_SECTION_STATS
+    if (critical_section_reentrancy_counter == 0) {
+        critical_stats_enter();
+    }
+#endif
+
     ++critical_section_reentrancy_counter;
 }
 
@@ -105,6 +183,9 @@ void core_util_critical_section_exit(void)
     --critical_section_reentrancy_counter;
 
     if (critical_section_reentrancy_counter == 0) {
+#if CRITICAL_SECTION_STATS
+        critical_stats_exit();
+#endif
         hal_critical_section_exit();
     }
 }
@@ -211,6 +292,22 @@ uint32_t core_util_atomic_decr_u32(volatile uint32_t *valuePtr, uint32_t delta)
     return newValue;
 }
 
+bool core_util_atomic_flag_test_and_set(core_util_atomic_flag *flagPtr)
+{
+    uint8_t currentValue;
+    do {
+        currentValue = __LDREXB(&flagPtr->_flag);
+    } while (__STREXB(1U, &flagPtr->_flag));
+    __DMB();
+    return currentValue != 0;
+}
+
+void core_util_atomic_flag_clear(core_util_atomic_flag *flagPtr)
+{
+    __DMB();
+    flagPtr->_flag = 0;
+}
+
 #else
 
 bool core_util_atomic_cas_u8(volatile uint8_t *ptr, uint8_t *expectedCurrentValue, uint8_t desiredValue)
@@ -327,8 +424,36 @@ uint32_t core_util_atomic_decr_u32(volatile uint32_t *valuePtr, uint32_t delta)
     return newValue;
 }
 
+bool core_util_atomic_flag_test_and_set(core_util_atomic_flag *flagPtr)
+{
+    core_util_critical_section_enter();
+    uint8_t currentValue = flagPtr->_flag;
+    flagPtr->_flag = 1U;
+    core_util_critical_section_exit();
+    return currentValue != 0;
+}
+
+void core_util_atomic_flag_clear(core_util_atomic_flag *flagPtr)
+{
+    flagPtr->_flag = 0;
+}
+
 #endif
 
+void core_util_object_lock(core_util_atomic_flag *flagPtr)
+{
+    /* The holder is a thread, so when spinning preempts it the scheduler
+     * will eventually run it again to release the flag; the interrupts
+     * stay enabled the whole time */
+    while (core_util_atomic_flag_test_and_set(flagPtr)) {
+    }
+}
+
+void core_util_object_unlock(core_util_atomic_flag *flagPtr)
+{
+    core_util_atomic_flag_clear(flagPtr);
+}
+
 
 bool core_util_atomic_cas_ptr(void * volatile *ptr, void **expectedCurrentValue, void *desiredValue) {
     return core_util_atomic_cas_u32(
@@ -387,6 +387,84 @@ uint32_t core_util_atomic_decr_u32(volatile uint32_t *valuePtr, uint32_t delta);
  */
 void *core_util_atomic_decr_ptr(void * volatile *valuePtr, ptrdiff_t delta);
 
+/** A lock-free, primitive atomic flag.
+ *
+ * Emulate C11's atomic_flag. Initialize with CORE_UTIL_ATOMIC_FLAG_INIT.
+ */
+typedef struct core_util_atomic_flag {
+    volatile uint8_t _flag;
+} core_util_atomic_flag;
+
+/** Initializer for a core_util_atomic_flag
+ *
+ * Example:
+ * @code
+ * core_util_atomic_flag in_use = CORE_UTIL_ATOMIC_FLAG_INIT;
+ * @endcode
+ */
+#define CORE_UTIL_ATOMIC_FLAG_INIT { 0 }
+
+/**
+ * Atomic test and set.
+ *
+ * Atomically tests then sets the flag to true, returning the previous value.
+ * On targets with exclusive access this compiles to a short LDREX/STREX
+ * sequence and never masks interrupts, so two unrelated objects guarding
+ * their own flags no longer serialize on global IRQ disabling.
+ *
+ * @param  flagPtr Target flag being tested and set.
+ * @return         The previous value.
+ */
+bool core_util_atomic_flag_test_and_set(core_util_atomic_flag *flagPtr);
+
+/**
+ * Atomic clear.
+ * @param  flagPtr Target flag being cleared.
+ */
+void core_util_atomic_flag_clear(core_util_atomic_flag *flagPtr);
+
+/** Acquire a per-object lock built on an atomic flag.
+ *
+ * Spins until the flag is taken, so the protected region must be short.
+ * Intended for thread-to-thread serialization of an object's own state,
+ * where a full critical section would needlessly mask interrupts for
+ * every other subsystem. Must not be used to synchronize with interrupt
+ * handlers: on a single core a handler spinning on a lock held by the
+ * interrupted thread can never make progress - use
+ * core_util_critical_section_enter for ISR-shared data.
+ *
+ * @param flagPtr Flag acting as the object's lock.
+ */
+void core_util_object_lock(core_util_atomic_flag *flagPtr);
+
+/** Release a per-object lock taken with core_util_object_lock.
+ *
+ * @param flagPtr Flag acting as the object's lock.
+ */
+void core_util_object_unlock(core_util_atomic_flag *flagPtr);
+
+/** Number of buckets in the interrupts-masked duration histogram */
+#define MBED_CRITICAL_STATS_HIST_SIZE 16
+
+/** Read the interrupts-masked duration statistics.
+ *
+ * When MBED_CRITICAL_STATS_ENABLED is set, every outermost critical
+ * section is timed with the DWT cycle counter. Bucket i of the histogram
+ * counts masked windows of [2^i, 2^(i+1)) cycles, with the last bucket
+ * absorbing everything longer. A window exceeding the
+ * platform.critical-section-trap-cycles threshold (0 disables) raises a
+ * timeout error at the exit, pinpointing the regression at the spot it
+ * happens rather than as field jitter.
+ *
+ * @param max_cycles  Written with the longest masked window seen, NULL to skip
+ * @param hist        Array of MBED_CRITICAL_STATS_HIST_SIZE entries the
+ *                    histogram is copied into, NULL to skip
+ */
+void core_util_critical_section_stats_read(uint32_t *max_cycles, uint32_t *hist);
+
+/** Reset the interrupts-masked duration statistics. */
+void core_util_critical_section_stats_reset(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,194 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_deferred_log.h"
+
+#if MBED_CONF_PLATFORM_DEFERRED_LOG_RING_SIZE > 0
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "events/EventQueue.h"
+#include "events/mbed_shared_queues.h"
+#if DEVICE_USTICKER
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
+
+#define LOG_RING_SIZE MBED_CONF_PLATFORM_DEFERRED_LOG_RING_SIZE
+
+MBED_STATIC_ASSERT((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0,
+                   "platform.deferred-log-ring-size must be a power of two");
+
+/* Bounded multi-producer single-consumer ring, same claim/commit shape as
+ * the equeue ISR intake path: a producer claims a slot index with a CAS
+ * on the head, fills the record, then publishes it by storing the claim
+ * index (plus one, so zero means never written) into the slot's sequence
+ * word. The consumer takes records in claim order and stops at the first
+ * slot whose sequence does not match - a producer preempted mid-record
+ * just delays draining, never corrupts it. Producers check the head-tail
+ * distance before claiming, so a slot is never reused until consumed. */
+typedef struct log_record {
+    const char *format;
+    uint32_t timestamp;
+    uint32_t args[MBED_LOG_MAX_ARGS];
+    uint8_t argc;
+    volatile uint32_t seq;
+} log_record_t;
+
+static log_record_t log_ring[LOG_RING_SIZE];
+static volatile uint32_t log_head;
+static volatile uint32_t log_tail;
+static volatile uint32_t log_dropped;
+
+static uint32_t log_timestamp(void)
+{
+#if DEVICE_USTICKER
+    return (uint32_t) ticker_read(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+void mbed_log_push(unsigned argc, const char *format, ...)
+{
+    MBED_ASSERT(argc <= MBED_LOG_MAX_ARGS);
+
+    uint32_t index = log_head;
+    do {
+        if (index - log_tail >= LOG_RING_SIZE) {
+            core_util_atomic_incr_u32((volatile uint32_t *) &log_dropped, 1);
+            return;
+        }
+    } while (!core_util_atomic_cas_u32((volatile uint32_t *) &log_head, &index, index + 1));
+
+    log_record_t *record = &log_ring[index & (LOG_RING_SIZE - 1)];
+    record->format = format;
+    record->timestamp = log_timestamp();
+    record->argc = (uint8_t) argc;
+
+    va_list arguments;
+    va_start(arguments, format);
+    for (unsigned i = 0; i < argc; i++) {
+        record->args[i] = va_arg(arguments, uint32_t);
+    }
+    va_end(arguments);
+
+    // Publish - readable once seq matches the claim index
+    record->seq = index + 1;
+}
+
+int mbed_log_drain(void)
+{
+    char line[128];
+    int emitted = 0;
+
+    while (log_tail != log_head) {
+        uint32_t index = log_tail;
+        log_record_t *record = &log_ring[index & (LOG_RING_SIZE - 1)];
+        if (record->seq != index + 1) {
+            // Producer claimed this slot but has not committed yet
+            break;
+        }
+
+        int prefix = snprintf(line, sizeof line, "[%lu] ",
+                              (unsigned long) record->timestamp);
+        if (prefix < 0 || prefix >= (int) sizeof line) {
+            prefix = 0;
+        }
+
+        const uint32_t *a = record->args;
+        int body;
+        switch (record->argc) {
+            case 0:
+                body = snprintf(line + prefix, sizeof line - prefix, "%s", record->format);
+                break;
+            case 1:
+                body = snprintf(line + prefix, sizeof line - prefix, record->format, a[0]);
+                break;
+            case 2:
+                body = snprintf(line + prefix, sizeof line - prefix, record->format, a[0], a[1]);
+                break;
+            case 3:
+                body = snprintf(line + prefix, sizeof line - prefix, record->format, a[0], a[1], a[2]);
+                break;
+            default:
+                body = snprintf(line + prefix, sizeof line - prefix, record->format, a[0], a[1], a[2], a[3]);
+                break;
+        }
+
+        // Release the slot before the (slow) write so producers regain
+        // space as early as possible
+        log_tail = index + 1;
+
+        if (body >= 0) {
+            size_t len = prefix + body;
+            if (len >= sizeof line) {
+                len = sizeof line - 1;
+            }
+            line[len] = '\n';
+            fwrite(line, 1, len + 1, stdout);
+        }
+        emitted++;
+    }
+
+    uint32_t dropped = log_dropped;
+    if (dropped && log_head - log_tail < LOG_RING_SIZE) {
+        uint32_t expected = dropped;
+        if (core_util_atomic_cas_u32((volatile uint32_t *) &log_dropped, &expected, 0)) {
+            int len = snprintf(line, sizeof line, "[%lu] log dropped %lu records\n",
+                               (unsigned long) log_timestamp(), (unsigned long) dropped);
+            if (len > 0) {
+                fwrite(line, 1, len, stdout);
+            }
+        }
+    }
+
+    return emitted;
+}
+
+static void log_drain_event(void)
+{
+    mbed_log_drain();
+}
+
+void mbed_log_start(uint32_t period_ms)
+{
+    mbed::mbed_event_queue()->call_every((int) period_ms, log_drain_event);
+}
+
+#else
+
+void mbed_log_push(unsigned argc, const char *format, ...)
+{
+    (void) argc;
+    (void) format;
+}
+
+int mbed_log_drain(void)
+{
+    return 0;
+}
+
+void mbed_log_start(uint32_t period_ms)
+{
+    (void) period_ms;
+}
+
+#endif // MBED_CONF_PLATFORM_DEFERRED_LOG_RING_SIZE > 0
@@ -0,0 +1,117 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_deferred_log Deferred-formatting log functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DEFERRED_LOG_H
+#define MBED_DEFERRED_LOG_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Deferred-formatting logging.
+ *
+ * MBED_LOG captures the format-string pointer, a timestamp and up to
+ * four raw 32-bit argument words into a preallocated ring and returns -
+ * no formatting happens in the caller's context, so the call is cheap
+ * enough for ISRs and real-time loops. A background drainer (normally
+ * mbed_log_drain() on the shared event queue, see mbed_log_start())
+ * formats the records with snprintf and writes them to stdout.
+ *
+ * Because only the argument words are captured, arguments must fit in
+ * 32 bits - int, unsigned, pointers, char - and any %s pointer must
+ * remain valid until the record is drained, i.e. point at a string
+ * literal or other static storage. 64-bit conversions (%lld) and
+ * floating point are not supported. The format string itself must also
+ * be a literal or static.
+ *
+ * Enabled by setting platform.deferred-log-ring-size to a power of two;
+ * when it is 0 the macros compile away entirely.
+ */
+
+/** Maximum number of argument words a single log record can carry */
+#define MBED_LOG_MAX_ARGS 4
+
+#if MBED_CONF_PLATFORM_DEFERRED_LOG_RING_SIZE > 0
+
+/** Capture a log record
+ *
+ *  Safe from any context, including ISRs; multiple producers may log
+ *  concurrently. Costs one CAS plus a handful of word stores. If the
+ *  ring is full the record is dropped and counted.
+ *
+ *  @param ... Format string followed by up to MBED_LOG_MAX_ARGS
+ *             32-bit arguments
+ */
+#define MBED_LOG(...) mbed_log_push(MBED_LOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+
+#define MBED_LOG_NARGS(...) MBED_LOG_NARGS_(__VA_ARGS__, 4, 3, 2, 1, 0)
+#define MBED_LOG_NARGS_(fmt, a1, a2, a3, a4, N, ...) N
+
+#else
+
+#define MBED_LOG(...) ((void)0)
+
+#endif
+
+/** Capture a log record with an explicit argument count
+ *
+ *  Normally invoked through MBED_LOG, which counts the arguments.
+ *
+ *  @param argc   Number of argument words following format, at most
+ *                MBED_LOG_MAX_ARGS
+ *  @param format printf-style format string; must point at static
+ *                storage
+ */
+void mbed_log_push(unsigned argc, const char *format, ...);
+
+/** Format and emit pending log records to stdout
+ *
+ *  Must only be called from one context at a time - the ring is
+ *  multi-producer, single-consumer. If a producer was preempted
+ *  mid-record, draining stops at that record and resumes on the next
+ *  call. Reports records dropped on ring overflow as a "log dropped"
+ *  line once the ring has space again.
+ *
+ *  @return Number of records emitted
+ */
+int mbed_log_drain(void);
+
+/** Start draining the log ring on the shared event queue
+ *
+ *  Schedules mbed_log_drain() on the queue returned by
+ *  mbed_event_queue() every period_ms milliseconds. Call once, after
+ *  the kernel is running.
+ *
+ *  @param period_ms Drain period in milliseconds
+ */
+void mbed_log_start(uint32_t period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/**@}*/
+
+/**@}*/
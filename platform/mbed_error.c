@@ -396,6 +396,12 @@ int mbed_get_error_hist_count(void)
     return mbed_error_hist_get_count();
 }
 
+//Retrieve the number of entries preserved across the last reboot
+int mbed_get_error_hist_preserved_count(void)
+{
+    return mbed_error_hist_preserved_count();
+}
+
 mbed_error_status_t mbed_save_error_hist(const char *path)
 {
     mbed_error_status_t ret = MBED_SUCCESS;
@@ -1050,6 +1050,15 @@ mbed_error_status_t mbed_make_error(mbed_error_type_t error_type, mbed_module_ty
  */
 int mbed_get_error_hist_count(void);
 
+/**
+ * Returns the number of error history entries preserved across the last reboot.
+ * Requires the error history to be placed in noinit RAM with the platform.error-hist-preserve option;
+ * the entries are streamed out with mbed_get_error_hist_info() before the current run overwrites them.
+ * @return                      Number of preserved entries, 0 on a cold boot or when preservation is disabled.
+ *
+ */
+int mbed_get_error_hist_preserved_count(void);
+
 /**
  * Reads the error context information for a specific error from error history, specified by the index.
  * 
@@ -24,16 +24,78 @@
 #if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
 #include "platform/mbed_error_hist.h"
 
+#if MBED_CONF_PLATFORM_ERROR_HIST_PRESERVE
+
+/* Keep the history in a linker section the startup code does not zero, so
+ * the ring written before a crash is still there after the reboot. The
+ * magic word tells a warm boot apart from power-on garbage. */
+#define ERROR_HIST_MAGIC    0x45524831      /* 'ERH1' */
+
+static struct error_hist_store {
+    uint32_t magic;
+    int count;
+    mbed_error_ctx log[MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
+} error_hist_store MBED_SECTION(".noinit");
+
+#define mbed_error_ctx_log  (error_hist_store.log)
+#define error_log_count     (error_hist_store.count)
+
+static int error_hist_inited = 0;
+static int error_hist_preserved_entries = 0;
+
+/* Validate the noinit region once per boot; anything written by this run
+ * of the system goes through here first */
+static void error_hist_init(void)
+{
+    if (error_hist_inited) {
+        return;
+    }
+    core_util_critical_section_enter();
+    if (!error_hist_inited) {
+        if (error_hist_store.magic == ERROR_HIST_MAGIC && error_hist_store.count >= -1) {
+            // Warm boot: the pre-reboot history is intact, remember how
+            // much of it there is before this run starts overwriting it
+            error_hist_preserved_entries =
+                    (error_log_count >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE) ?
+                    MBED_CONF_PLATFORM_ERROR_HIST_SIZE : (error_log_count + 1);
+        } else {
+            // Cold boot or corrupted region
+            error_hist_store.magic = ERROR_HIST_MAGIC;
+            error_log_count = -1;
+        }
+        error_hist_inited = 1;
+    }
+    core_util_critical_section_exit();
+}
+
+int mbed_error_hist_preserved_count(void)
+{
+    error_hist_init();
+    return error_hist_preserved_entries;
+}
+
+#else
+
 static mbed_error_ctx mbed_error_ctx_log[MBED_CONF_PLATFORM_ERROR_HIST_SIZE] = {0};
 static int error_log_count = -1;
 
+#define error_hist_init()   ((void)0)
+
+int mbed_error_hist_preserved_count(void)
+{
+    return 0;
+}
+
+#endif
+
 mbed_error_status_t mbed_error_hist_put(mbed_error_ctx *error_ctx)
 {
     //Return error if error_ctx is NULL
     if (NULL == error_ctx) {
         return MBED_ERROR_INVALID_ARGUMENT;
     }
-    
+
+    error_hist_init();
     core_util_critical_section_enter();
     error_log_count++;
     memcpy(&mbed_error_ctx_log[error_log_count % MBED_CONF_PLATFORM_ERROR_HIST_SIZE], error_ctx, sizeof(mbed_error_ctx));
@@ -48,7 +110,8 @@ mbed_error_status_t mbed_error_hist_get(int index, mbed_error_ctx *error_ctx)
     if (index >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE) {
         return MBED_ERROR_INVALID_ARGUMENT;
     }
-    
+
+    error_hist_init();
     core_util_critical_section_enter();
     //calculate the index where we want to pick the ctx
     if (error_log_count >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE) {
@@ -62,6 +125,7 @@ mbed_error_status_t mbed_error_hist_get(int index, mbed_error_ctx *error_ctx)
 
 mbed_error_ctx *mbed_error_hist_get_entry(void)
 {
+    error_hist_init();
     core_util_critical_section_enter();
     error_log_count++;
     mbed_error_ctx *ctx = &mbed_error_ctx_log[error_log_count % MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
@@ -72,6 +136,7 @@ mbed_error_ctx *mbed_error_hist_get_entry(void)
 
 mbed_error_status_t mbed_error_hist_get_last_error(mbed_error_ctx *error_ctx)
 {
+    error_hist_init();
     if (-1 == error_log_count) {
         return MBED_ERROR_ITEM_NOT_FOUND;
     }
@@ -84,13 +149,19 @@ mbed_error_status_t mbed_error_hist_get_last_error(mbed_error_ctx *error_ctx)
 
 int mbed_error_hist_get_count()
 {
+    error_hist_init();
     return (error_log_count >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE? MBED_CONF_PLATFORM_ERROR_HIST_SIZE:error_log_count+1);
 }
 
 mbed_error_status_t mbed_error_hist_reset()
 {
+    error_hist_init();
     core_util_critical_section_enter();
     error_log_count = -1;
+#if MBED_CONF_PLATFORM_ERROR_HIST_PRESERVE
+    // The pre-reboot entries live in the same ring, so they are gone too
+    error_hist_preserved_entries = 0;
+#endif
     core_util_critical_section_exit(); 
     
     return MBED_SUCCESS;
@@ -94,6 +94,20 @@ int mbed_error_hist_get_count(void);
  */
 mbed_error_status_t mbed_error_hist_reset(void);
 
+/*
+ * Returns the number of entries carried over from before the last reboot
+ *
+ * Only nonzero when the history lives in noinit RAM (see the
+ * platform.error-hist-preserve option) and the region survived the reset
+ * intact. The preserved entries are read with mbed_error_hist_get()
+ * starting at index 0 (oldest first); they are overwritten in ring order
+ * as the current run logs new errors.
+ *
+ * @return                      Number of preserved entries, 0 on a cold boot
+ *
+ */
+int mbed_error_hist_preserved_count(void);
+
 /*
  * Saves the error log information to a file
  * 
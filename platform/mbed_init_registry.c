@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_init_registry.h"
+
+#if defined(MBED_INIT_REGISTRY_ENABLED)
+
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_critical.h"
+#if DEVICE_USTICKER
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
+
+#ifndef MBED_CONF_PLATFORM_INIT_REGISTRY_TABLE_SIZE
+#define MBED_CONF_PLATFORM_INIT_REGISTRY_TABLE_SIZE 16
+#endif
+
+static mbed_init_record_t records[MBED_CONF_PLATFORM_INIT_REGISTRY_TABLE_SIZE];
+static uint32_t record_count;
+
+typedef struct {
+    const char *name;
+    void (*init_fn)(void);
+    bool ran;
+} deferred_unit_t;
+
+static deferred_unit_t deferred[MBED_CONF_PLATFORM_INIT_REGISTRY_TABLE_SIZE];
+static uint32_t deferred_count;
+
+uint32_t mbed_init_registry_now(void)
+{
+#if DEVICE_USTICKER
+    return ticker_read(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+void mbed_init_registry_record(const char *name, const void *object, uint32_t start_us)
+{
+    uint32_t duration = mbed_init_registry_now() - start_us;
+
+    core_util_critical_section_enter();
+    if (record_count < MBED_CONF_PLATFORM_INIT_REGISTRY_TABLE_SIZE) {
+        mbed_init_record_t *rec = &records[record_count++];
+        rec->name = name;
+        rec->object = object;
+        rec->timestamp_us = start_us;
+        rec->duration_us = duration;
+    }
+    core_util_critical_section_exit();
+}
+
+uint32_t mbed_init_registry_read(mbed_init_record_t *out, uint32_t count)
+{
+    core_util_critical_section_enter();
+    if (count > record_count) {
+        count = record_count;
+    }
+    memcpy(out, records, count * sizeof records[0]);
+    core_util_critical_section_exit();
+    return count;
+}
+
+void mbed_init_registry_defer(const char *name, void (*init_fn)(void))
+{
+    core_util_critical_section_enter();
+    if (deferred_count < MBED_CONF_PLATFORM_INIT_REGISTRY_TABLE_SIZE) {
+        deferred_unit_t *unit = &deferred[deferred_count++];
+        unit->name = name;
+        unit->init_fn = init_fn;
+        unit->ran = false;
+    }
+    core_util_critical_section_exit();
+}
+
+static void deferred_run(deferred_unit_t *unit)
+{
+    /* The init functions are idempotent first-use accessors, so no harm
+     * if the unit was already pulled in through its normal path. */
+    if (!unit->ran) {
+        unit->ran = true;
+        uint32_t start = mbed_init_registry_now();
+        unit->init_fn();
+        mbed_init_registry_record(unit->name, NULL, start);
+    }
+}
+
+bool mbed_init_registry_run(const char *name)
+{
+    for (uint32_t i = 0; i < deferred_count; i++) {
+        if (strcmp(deferred[i].name, name) == 0) {
+            deferred_run(&deferred[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+void mbed_init_registry_run_all(void)
+{
+    for (uint32_t i = 0; i < deferred_count; i++) {
+        deferred_run(&deferred[i]);
+    }
+}
+
+#endif // MBED_INIT_REGISTRY_ENABLED
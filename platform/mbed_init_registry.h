@@ -0,0 +1,103 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INIT_REGISTRY_H
+#define MBED_INIT_REGISTRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Construction audit and deferral registry.
+ *
+ * When MBED_INIT_REGISTRY_ENABLED is set, every SingletonPtr
+ * construction is timed and recorded with its object address and a
+ * microsecond timestamp, so boot-time construction cost can be
+ * attributed object by object - compare the timestamps against the boot
+ * trace's main stage stamp (see mbed_boot_trace.h) to separate what ran
+ * before main() from what was pulled in later. Addresses of anonymous
+ * records resolve to their owning singleton through the map file.
+ *
+ * Deferrable units - the stdio console, the shared event queues -
+ * additionally register a named init function. They still construct on
+ * first use as before; the registration lets staging builds pull the
+ * construction forward to a chosen quiet moment with
+ * mbed_init_registry_run or mbed_init_registry_run_all instead of
+ * paying it inside the first latency-critical call.
+ */
+
+/** One recorded construction */
+typedef struct {
+    const char *name;       /**< Unit name, NULL for an anonymous singleton */
+    const void *object;     /**< Address of the constructed object */
+    uint32_t timestamp_us;  /**< Microsecond ticker value when construction began */
+    uint32_t duration_us;   /**< Time the constructor took */
+} mbed_init_record_t;
+
+/** Current microsecond ticker value, for bracketing a construction.
+ *
+ *  @return  Microsecond ticker value, 0 on targets without one
+ */
+uint32_t mbed_init_registry_now(void);
+
+/** Record a construction that began at start_us.
+ *
+ *  @param name      Unit name, NULL for an anonymous singleton
+ *  @param object    Address of the constructed object
+ *  @param start_us  Value of mbed_init_registry_now() taken before construction
+ */
+void mbed_init_registry_record(const char *name, const void *object, uint32_t start_us);
+
+/** Copy out up to count records, oldest first.
+ *
+ *  @param records  Array the records are copied into
+ *  @param count    Capacity of the array
+ *  @return         Number of records copied
+ */
+uint32_t mbed_init_registry_read(mbed_init_record_t *records, uint32_t count);
+
+/** Register a deferrable unit.
+ *
+ *  The init function must be idempotent - it is also reached through the
+ *  unit's normal first-use path.
+ *
+ *  @param name     Unit name, by which it can be run explicitly
+ *  @param init_fn  Function constructing the unit
+ */
+void mbed_init_registry_defer(const char *name, void (*init_fn)(void));
+
+/** Run one registered unit's init now, if it has not run already.
+ *
+ *  @param name  Name the unit registered under
+ *  @return      True if the unit was found, false otherwise
+ */
+bool mbed_init_registry_run(const char *name);
+
+/** Run every registered unit's init that has not run already. */
+void mbed_init_registry_run_all(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
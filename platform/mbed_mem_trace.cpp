@@ -92,6 +92,94 @@ void mbed_mem_trace_free(void *ptr, void *caller) {
     }
 }
 
+#if MBED_CONF_PLATFORM_MEM_TRACE_RING_SIZE
+
+/* Binary trace ring. Records are dropped (and counted) rather than
+ * overwritten when the ring is full, so a drain loop that falls behind
+ * loses the newest records, not the history it is about to read. */
+static mbed_mem_trace_record_t trace_ring[MBED_CONF_PLATFORM_MEM_TRACE_RING_SIZE];
+static uint32_t trace_ring_head;
+static uint32_t trace_ring_tail;
+static uint32_t trace_ring_count;
+static uint32_t trace_ring_dropped;
+static uint32_t trace_sample_rate = 1;
+static uint32_t trace_sample_skip;
+
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...) {
+    va_list va;
+
+    /* 1-in-N sampling; note a sampled trace is a statistical profile of
+     * allocation activity, not a complete log usable for leak matching */
+    if (++trace_sample_skip < trace_sample_rate) {
+        return;
+    }
+    trace_sample_skip = 0;
+
+    core_util_critical_section_enter();
+    if (trace_ring_count == MBED_CONF_PLATFORM_MEM_TRACE_RING_SIZE) {
+        trace_ring_dropped++;
+        core_util_critical_section_exit();
+        return;
+    }
+    mbed_mem_trace_record_t *rec = &trace_ring[trace_ring_head];
+    trace_ring_head = (trace_ring_head + 1) % MBED_CONF_PLATFORM_MEM_TRACE_RING_SIZE;
+    trace_ring_count++;
+
+    rec->op = op;
+    rec->res = res;
+    rec->caller = caller;
+    rec->arg1 = 0;
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            rec->arg0 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            rec->arg0 = (uint32_t)va_arg(va, void*);
+            rec->arg1 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            rec->arg0 = va_arg(va, size_t);
+            rec->arg1 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            rec->arg0 = (uint32_t)va_arg(va, void*);
+            break;
+
+        default:
+            rec->arg0 = 0;
+    }
+    va_end(va);
+    core_util_critical_section_exit();
+}
+
+void mbed_mem_trace_set_sampling(uint32_t rate) {
+    trace_sample_rate = rate ? rate : 1;
+    trace_sample_skip = 0;
+}
+
+int mbed_mem_trace_ring_fetch(mbed_mem_trace_record_t *rec) {
+    int fetched = 0;
+    core_util_critical_section_enter();
+    if (trace_ring_count > 0) {
+        *rec = trace_ring[trace_ring_tail];
+        trace_ring_tail = (trace_ring_tail + 1) % MBED_CONF_PLATFORM_MEM_TRACE_RING_SIZE;
+        trace_ring_count--;
+        fetched = 1;
+    }
+    core_util_critical_section_exit();
+    return fetched;
+}
+
+uint32_t mbed_mem_trace_ring_drops(void) {
+    return trace_ring_dropped;
+}
+
+#endif // MBED_CONF_PLATFORM_MEM_TRACE_RING_SIZE
+
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...) {
     va_list va;
     size_t temp_s1, temp_s2;
@@ -150,6 +150,63 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/**
+ * A fixed-size binary record of one traced memory operation, as stored by
+ * 'mbed_mem_trace_ring_callback'.
+ *
+ * 'arg0'/'arg1' hold the operation arguments: size for 'malloc', ptr and
+ * size for 'realloc', nmemb and size for 'calloc', ptr for 'free'.
+ */
+typedef struct mbed_mem_trace_record {
+    uint8_t op;
+    void *res;
+    void *caller;
+    uint32_t arg0;
+    uint32_t arg1;
+} mbed_mem_trace_record_t;
+
+/**
+ * Memory trace callback that stores binary records in a RAM ring buffer
+ * instead of formatting text. DO NOT CALL DIRECTLY. It is meant to be used
+ * as the argument of 'mbed_mem_trace_set_callback'.
+ *
+ * Recording one operation is a struct copy and two counter updates - no
+ * printf, no I/O - so it can be left enabled in timing-sensitive code.
+ * The ring is drained at the application's leisure with
+ * 'mbed_mem_trace_ring_fetch'; when the ring overflows the oldest
+ * records are kept and newer ones are counted as dropped.
+ *
+ * Only available when 'platform.mem-trace-ring-size' is set to a nonzero
+ * number of records.
+ */
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Set the sampling rate of 'mbed_mem_trace_ring_callback'.
+ *
+ * @param rate record one in 'rate' operations (1 records everything, the
+ *             default; 0 is treated as 1).
+ */
+void mbed_mem_trace_set_sampling(uint32_t rate);
+
+/**
+ * Fetch the oldest record from the trace ring.
+ *
+ * Safe to call from a different thread than the one allocating; intended
+ * for a low-priority drain loop that forwards records over a serial link.
+ *
+ * @param rec the record is copied here.
+ * @return 1 if a record was fetched, 0 if the ring is empty.
+ */
+int mbed_mem_trace_ring_fetch(mbed_mem_trace_record_t *rec);
+
+/**
+ * Number of records dropped because the trace ring was full.
+ *
+ * @return the drop count since boot.
+ */
+uint32_t mbed_mem_trace_ring_drops(void);
+
 /** @}*/
 
 #ifdef __cplusplus
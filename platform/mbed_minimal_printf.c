@@ -0,0 +1,277 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compact formatted-output engine, enabled with platform.minimal-printf.
+ *
+ * Replaces the toolchain printf family with an integer-first formatter:
+ * %d %i %u %x %X %o %p %c %s and %%, with '0' padding, a numeric field
+ * width and the h/hh/l/ll/z/t length modifiers. No floating point, no
+ * precision, no positional arguments - an unsupported conversion is
+ * emitted literally so it is visible in the log rather than crashing.
+ * Stream output is staged in a small stack buffer and pushed to the
+ * retarget layer in chunks, bypassing the toolchain's formatted-I/O
+ * machinery entirely.
+ */
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    char *buffer;       // NULL when streaming to a FILE
+    FILE *stream;
+    size_t capacity;    // bytes that may be stored (excluding the NUL)
+    size_t count;       // characters produced, may exceed capacity
+    char chunk[32];     // staging buffer for stream output
+    size_t chunk_fill;
+} minimal_out_t;
+
+static void out_flush(minimal_out_t *out)
+{
+    if (out->stream && out->chunk_fill) {
+        fwrite(out->chunk, 1, out->chunk_fill, out->stream);
+        out->chunk_fill = 0;
+    }
+}
+
+static void out_char(minimal_out_t *out, char c)
+{
+    if (out->buffer) {
+        if (out->count < out->capacity) {
+            out->buffer[out->count] = c;
+        }
+    } else {
+        out->chunk[out->chunk_fill++] = c;
+        if (out->chunk_fill == sizeof out->chunk) {
+            out_flush(out);
+        }
+    }
+    out->count++;
+}
+
+static void out_unsigned(minimal_out_t *out, unsigned long long value, unsigned base, bool upper, int width, char pad, bool negative)
+{
+    char digits[22];
+    int n = 0;
+
+    do {
+        unsigned digit = (unsigned)(value % base);
+        digits[n++] = (char)(digit < 10 ? '0' + digit : (upper ? 'A' : 'a') + digit - 10);
+        value /= base;
+    } while (value);
+
+    if (negative) {
+        if (pad == '0') {
+            // Sign precedes zero padding: -007
+            out_char(out, '-');
+        } else {
+            digits[n++] = '-';
+        }
+    }
+
+    for (int i = n + (negative && pad == '0'); i < width; i++) {
+        out_char(out, pad);
+    }
+    while (n) {
+        out_char(out, digits[--n]);
+    }
+}
+
+static void minimal_format(minimal_out_t *out, const char *format, va_list arguments)
+{
+    while (*format) {
+        if (*format != '%') {
+            out_char(out, *format++);
+            continue;
+        }
+
+        const char *spec_start = format++;
+        char pad = ' ';
+        int width = 0;
+        int length = 0;     // h = -1, hh = -2, l = 1, ll = 2
+
+        if (*format == '0') {
+            pad = '0';
+            format++;
+        }
+        while (*format >= '0' && *format <= '9') {
+            width = width * 10 + (*format++ - '0');
+        }
+        while (*format == 'h') {
+            length--;
+            format++;
+        }
+        while (*format == 'l') {
+            length++;
+            format++;
+        }
+        if (*format == 'z' || *format == 't') {
+            length = (sizeof(size_t) == sizeof(long)) ? 1 : 2;
+            format++;
+        }
+
+        switch (*format) {
+            case 'd':
+            case 'i': {
+                long long value;
+                if (length >= 2) {
+                    value = va_arg(arguments, long long);
+                } else if (length == 1) {
+                    value = va_arg(arguments, long);
+                } else {
+                    value = va_arg(arguments, int);
+                }
+                bool negative = value < 0;
+                unsigned long long magnitude = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+                out_unsigned(out, magnitude, 10, false, width, pad, negative);
+                format++;
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o': {
+                unsigned long long value;
+                if (length >= 2) {
+                    value = va_arg(arguments, unsigned long long);
+                } else if (length == 1) {
+                    value = va_arg(arguments, unsigned long);
+                } else {
+                    value = va_arg(arguments, unsigned int);
+                }
+                unsigned base = (*format == 'u') ? 10 : (*format == 'o') ? 8 : 16;
+                out_unsigned(out, value, base, *format == 'X', width, pad, false);
+                format++;
+                break;
+            }
+            case 'p': {
+                uintptr_t value = (uintptr_t) va_arg(arguments, void *);
+                out_char(out, '0');
+                out_char(out, 'x');
+                out_unsigned(out, value, 16, false, 2 * sizeof(void *), '0', false);
+                format++;
+                break;
+            }
+            case 'c':
+                out_char(out, (char) va_arg(arguments, int));
+                format++;
+                break;
+            case 's': {
+                const char *s = va_arg(arguments, const char *);
+                if (!s) {
+                    s = "(null)";
+                }
+                int slen = (int) strlen(s);
+                for (int i = slen; i < width; i++) {
+                    out_char(out, ' ');
+                }
+                while (*s) {
+                    out_char(out, *s++);
+                }
+                format++;
+                break;
+            }
+            case '%':
+                out_char(out, '%');
+                format++;
+                break;
+            default:
+                // Unsupported conversion - emit it literally so it shows
+                // up in the log instead of silently eating an argument
+                while (spec_start <= format && *spec_start) {
+                    out_char(out, *spec_start++);
+                }
+                if (*format) {
+                    format++;
+                }
+                break;
+        }
+    }
+}
+
+int vfprintf(FILE *stream, const char *format, va_list arguments)
+{
+    minimal_out_t out = {0};
+    out.stream = stream;
+    minimal_format(&out, format, arguments);
+    out_flush(&out);
+    return (int) out.count;
+}
+
+int fprintf(FILE *stream, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int count = vfprintf(stream, format, arguments);
+    va_end(arguments);
+    return count;
+}
+
+int vprintf(const char *format, va_list arguments)
+{
+    return vfprintf(stdout, format, arguments);
+}
+
+int printf(const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int count = vfprintf(stdout, format, arguments);
+    va_end(arguments);
+    return count;
+}
+
+int vsnprintf(char *buffer, size_t length, const char *format, va_list arguments)
+{
+    minimal_out_t out = {0};
+    out.buffer = buffer;
+    out.capacity = length ? length - 1 : 0;
+    minimal_format(&out, format, arguments);
+    if (length) {
+        buffer[out.count < out.capacity ? out.count : out.capacity] = '\0';
+    }
+    return (int) out.count;
+}
+
+int snprintf(char *buffer, size_t length, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int count = vsnprintf(buffer, length, format, arguments);
+    va_end(arguments);
+    return count;
+}
+
+int vsprintf(char *buffer, const char *format, va_list arguments)
+{
+    return vsnprintf(buffer, SIZE_MAX, format, arguments);
+}
+
+int sprintf(char *buffer, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    int count = vsnprintf(buffer, SIZE_MAX, format, arguments);
+    va_end(arguments);
+    return count;
+}
+
+#endif // MBED_CONF_PLATFORM_MINIMAL_PRINTF
@@ -0,0 +1,123 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_pkt_trace.h"
+
+#if defined(MBED_PKT_TRACE_ENABLED)
+
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#if defined(DEVICE_ITM)
+#include "hal/itm_api.h"
+#endif
+
+#ifndef MBED_CONF_PLATFORM_PKT_TRACE_RING_SIZE
+#define MBED_CONF_PLATFORM_PKT_TRACE_RING_SIZE 64
+#endif
+
+#define RING_SIZE MBED_CONF_PLATFORM_PKT_TRACE_RING_SIZE
+#define RING_MASK (RING_SIZE - 1)
+
+MBED_STATIC_ASSERT((RING_SIZE & RING_MASK) == 0,
+        "pkt-trace-ring-size must be a power of two");
+
+static mbed_pkt_trace_record_t ring[RING_SIZE];
+static volatile uint32_t trace_head;    /* next sequence number to claim */
+static uint32_t trace_tail;             /* next sequence number to read */
+static uint32_t trace_lost;
+
+void mbed_pkt_trace(uint8_t subsys, uint8_t event, uint16_t length, uint32_t info)
+{
+    /* claiming the slot is the only shared-state update, so producers in
+     * thread and interrupt context never wait on each other */
+    uint32_t seq = core_util_atomic_incr_u32(&trace_head, 1) - 1;
+    mbed_pkt_trace_record_t *rec = &ring[seq & RING_MASK];
+
+    rec->timestamp = ticker_read(get_us_ticker_data());
+    rec->info = info;
+    rec->length = length;
+    rec->subsys = subsys;
+    rec->event = event;
+    /* the sequence number is stored last: a slot whose seq does not match
+     * the position being read is either still being written or already
+     * overwritten, and the reader handles it accordingly */
+    rec->seq = seq;
+}
+
+uint32_t mbed_pkt_trace_read(mbed_pkt_trace_record_t *records, uint32_t count)
+{
+    uint32_t head = trace_head;
+    uint32_t n = 0;
+
+    /* fell more than a ring behind - resync to the oldest survivor */
+    if (head - trace_tail > RING_SIZE) {
+        trace_lost += head - trace_tail - RING_SIZE;
+        trace_tail = head - RING_SIZE;
+    }
+
+    while (n < count && trace_tail != head) {
+        records[n] = ring[trace_tail & RING_MASK];
+
+        int32_t delta = (int32_t)(records[n].seq - trace_tail);
+        if (delta == 0) {
+            /* committed record */
+            trace_tail++;
+            n++;
+        } else if (delta < 0) {
+            /* a producer claimed this slot but has not finished writing
+             * it - pick it up on the next drain */
+            break;
+        } else {
+            /* overwritten while copying by a producer that lapped us */
+            trace_lost++;
+            trace_tail++;
+        }
+    }
+
+    return n;
+}
+
+uint32_t mbed_pkt_trace_lost(void)
+{
+    return trace_lost;
+}
+
+uint32_t mbed_pkt_trace_itm_drain(uint32_t port)
+{
+#if defined(DEVICE_ITM)
+    uint32_t total = 0;
+
+    for (;;) {
+        mbed_pkt_trace_record_t batch[4];
+        uint32_t n = mbed_pkt_trace_read(batch, 4);
+        if (n == 0) {
+            return total;
+        }
+        total += n;
+        if (mbed_itm_write(port, batch, n * sizeof(batch[0])) < n * sizeof(batch[0])) {
+            /* port FIFO stalled - mbed_itm_write counted the dropped
+             * bytes; stop rather than stall the caller */
+            return total;
+        }
+    }
+#else
+    (void)port;
+    return 0;
+#endif
+}
+
+#endif // MBED_PKT_TRACE_ENABLED
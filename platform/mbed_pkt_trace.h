@@ -0,0 +1,127 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PKT_TRACE_H
+#define MBED_PKT_TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Unified packet-event trace.
+ *
+ * When MBED_PKT_TRACE_ENABLED is set, the network interfaces record one
+ * fixed 16-byte binary record per packet event - timestamped from the
+ * microsecond ticker - into a shared ring, so timing between the
+ * Ethernet, cellular PPP and LoRa paths can be correlated from a single
+ * log instead of three ad-hoc ones. A producer claims its slot with one
+ * atomic increment and never takes a lock or waits, so the taps are
+ * cheap enough to stay enabled in production builds.
+ *
+ * Records are drained with mbed_pkt_trace_read, or streamed in binary
+ * over a dedicated ITM stimulus port with mbed_pkt_trace_itm_drain so
+ * the host decoder sees packet events alongside the other trace
+ * channels. The MBED_PKT_TRACE macro used at the tap sites compiles
+ * away when the facility is disabled.
+ */
+
+/** Subsystem that produced a record */
+typedef enum {
+    MBED_PKT_TRACE_EMAC = 1,    /**< Ethernet frames through the lwIP EMAC glue */
+    MBED_PKT_TRACE_PPP = 2,     /**< Bytes through the cellular PPP stream */
+    MBED_PKT_TRACE_LORA = 3     /**< LoRaWAN uplinks and downlinks */
+} mbed_pkt_trace_subsys_t;
+
+/** Packet event recorded */
+typedef enum {
+    MBED_PKT_TRACE_TX = 0,      /**< packet accepted for transmission */
+    MBED_PKT_TRACE_RX = 1,      /**< packet received */
+    MBED_PKT_TRACE_TX_DROP = 2, /**< packet dropped on the transmit path */
+    MBED_PKT_TRACE_RX_DROP = 3  /**< packet dropped on the receive path */
+} mbed_pkt_trace_event_t;
+
+/** One entry of the trace ring, 16 bytes */
+typedef struct {
+    uint32_t timestamp;         /**< microsecond ticker time of the event */
+    uint32_t seq;               /**< monotonic event number; gaps mark overwritten records */
+    uint32_t info;              /**< subsystem specific - port, status code, 0 */
+    uint16_t length;            /**< payload length in bytes */
+    uint8_t subsys;             /**< mbed_pkt_trace_subsys_t */
+    uint8_t event;              /**< mbed_pkt_trace_event_t */
+} mbed_pkt_trace_record_t;
+
+/** Record a packet event. Use the MBED_PKT_TRACE macro at tap sites so
+ *  the call compiles away when the facility is disabled.
+ *
+ *  Claims a ring slot with a single atomic increment; safe from any
+ *  context, including interrupt handlers, and never blocks.
+ *
+ *  @param subsys  mbed_pkt_trace_subsys_t of the producer
+ *  @param event   mbed_pkt_trace_event_t
+ *  @param length  payload length in bytes
+ *  @param info    subsystem specific extra word, 0 when unused
+ */
+void mbed_pkt_trace(uint8_t subsys, uint8_t event, uint16_t length, uint32_t info);
+
+/** Drain up to count records from the ring, oldest first.
+ *
+ *  Single consumer, thread context. Records the producers overwrote
+ *  before they were drained are skipped and counted by
+ *  mbed_pkt_trace_lost.
+ *
+ *  @param records  Array the records are copied into
+ *  @param count    Capacity of the array
+ *  @return         Number of records copied
+ */
+uint32_t mbed_pkt_trace_read(mbed_pkt_trace_record_t *records, uint32_t count);
+
+/** Number of records lost to ring overwrite since boot. Reading does not
+ *  reset the counter.
+ *
+ *  @return  Lost record count
+ */
+uint32_t mbed_pkt_trace_lost(void);
+
+/** Drain buffered records as binary over an ITM stimulus port.
+ *
+ *  Records go out through mbed_itm_write, so a drain never spins on a
+ *  stalled port FIFO; bytes the port did not accept are counted by
+ *  mbed_itm_dropped and the host decoder resynchronizes on the sequence
+ *  numbers. Returns 0 on targets without DEVICE_ITM.
+ *
+ *  @param port  The stimulus port to stream over; enable it first with
+ *               mbed_itm_enable_port
+ *  @return      Number of records handed to the port
+ */
+uint32_t mbed_pkt_trace_itm_drain(uint32_t port);
+
+#if defined(MBED_PKT_TRACE_ENABLED)
+#define MBED_PKT_TRACE(subsys, event, length, info) \
+    mbed_pkt_trace((subsys), (event), (length), (info))
+#else
+#define MBED_PKT_TRACE(subsys, event, length, info) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
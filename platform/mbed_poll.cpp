@@ -18,6 +18,9 @@
 #if MBED_CONF_RTOS_PRESENT
 #include "rtos/Kernel.h"
 #include "rtos/Thread.h"
+#if MBED_CONF_PLATFORM_POLL_SIGIO_WAIT
+#include "rtos/EventFlags.h"
+#endif
 using namespace rtos;
 #else
 #include "Timer.h"
@@ -26,6 +29,15 @@ using namespace rtos;
 
 namespace mbed {
 
+#if MBED_CONF_RTOS_PRESENT && MBED_CONF_PLATFORM_POLL_SIGIO_WAIT
+/* Flag set on the waiting poll() call whenever any polled handle reports
+ * activity through sigio */
+static void poll_wakeup(EventFlags *flags)
+{
+    flags->set(1);
+}
+#endif
+
 // timeout -1 forever, or milliseconds
 int poll(pollfh fhs[], unsigned nfhs, int timeout)
 {
@@ -44,6 +56,19 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
         start_time = Kernel::get_ms_count();
     }
 #define TIME_ELAPSED() int64_t(Kernel::get_ms_count() - start_time)
+
+#if MBED_CONF_PLATFORM_POLL_SIGIO_WAIT
+    /* Register for wake-ups before the first scan so an event arriving
+     * between a scan and the wait still sets the flag and the wait
+     * returns immediately. This takes over the handles' sigio callbacks
+     * for the duration of the call. */
+    EventFlags flags;
+    for (unsigned n = 0; n < nfhs; n++) {
+        if (fhs[n].fh) {
+            fhs[n].fh->sigio(callback(poll_wakeup, &flags));
+        }
+    }
+#endif
 #else
 #if MBED_CONF_PLATFORM_POLL_USE_LOWPOWER_TIMER
     LowPowerTimer timer;
@@ -81,11 +106,35 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
             break;
         }
 #ifdef MBED_CONF_RTOS_PRESENT
+#if MBED_CONF_PLATFORM_POLL_SIGIO_WAIT
+        /* Sleep until a handle signals sigio or the timeout expires, then
+         * rescan. No periodic wake-up: latency is one flag set, not up to
+         * a millisecond of polling interval. */
+        uint32_t wait_ms = osWaitForever;
+        if (timeout > 0) {
+            int64_t remaining = timeout - TIME_ELAPSED();
+            if (remaining <= 0) {
+                break;
+            }
+            wait_ms = (uint32_t)remaining;
+        }
+        flags.wait_any(1, wait_ms);
+#else
         // TODO - proper blocking
         // wait for condition variable, wait queue whatever here
         rtos::Thread::wait(1);
+#endif
 #endif
     }
+
+#if MBED_CONF_RTOS_PRESENT && MBED_CONF_PLATFORM_POLL_SIGIO_WAIT
+    /* Detach before the local EventFlags goes out of scope */
+    for (unsigned n = 0; n < nfhs; n++) {
+        if (fhs[n].fh) {
+            fhs[n].fh->sigio(NULL);
+        }
+    }
+#endif
     return count;
 }
 
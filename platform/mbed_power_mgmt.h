@@ -122,6 +122,93 @@ void sleep_manager_unlock_deep_sleep_internal(void);
  */
 bool sleep_manager_can_deep_sleep(void);
 
+/** Wakeup-latency constraint handle
+ *
+ * Callers own the storage; the sleep manager links active handles into an
+ * intrusive list, so a handle must stay valid until it is cleared.
+ */
+typedef struct sleep_latency_constraint {
+    uint32_t latency_us;                    /**< Max tolerable wakeup latency */
+    struct sleep_latency_constraint *next;  /**< Managed by the sleep manager */
+} sleep_latency_constraint_t;
+
+/** Declare a maximum tolerable wakeup latency
+ *
+ * While the constraint is active, sleep_manager_sleep_auto() only enters
+ * deepsleep if the target's declared deepsleep wakeup latency fits within
+ * the strictest active constraint; otherwise it falls back to sleep, which
+ * wakes in a few cycles. This lets latency-critical services - a BLE
+ * connection interval, a motor control loop - bound their wake time
+ * without holding the deep sleep lock and forfeiting deepsleep entirely
+ * for the rest of the system.
+ *
+ * Activating a handle that is already active is not allowed; clear it
+ * first. This function is IRQ and thread safe.
+ *
+ * @param constraint Caller-owned handle, must stay valid until cleared
+ * @param latency_us Max tolerable wakeup latency in microseconds
+ */
+void sleep_manager_set_latency(sleep_latency_constraint_t *constraint, uint32_t latency_us);
+
+/** Remove a previously declared wakeup-latency constraint
+ *
+ * Clearing a handle that is not active is a no-op.
+ * This function is IRQ and thread safe
+ *
+ * @param constraint Handle passed to sleep_manager_set_latency()
+ */
+void sleep_manager_clear_latency(sleep_latency_constraint_t *constraint);
+
+/** Get the strictest active wakeup-latency constraint
+ *
+ * @return Smallest tolerable wakeup latency in microseconds, or
+ *         UINT32_MAX when no constraint is active
+ */
+uint32_t sleep_manager_allowed_latency(void);
+
+/** Get the target's deepsleep wakeup latency
+ *
+ * The default weak implementation returns zero, which keeps latency
+ * constraints from ever vetoing deepsleep. Targets whose deepsleep exit
+ * takes meaningful time (clock restart, flash wakeup) should override
+ * this with their measured figure so constraints take effect.
+ *
+ * @return Deepsleep wakeup latency in microseconds
+ */
+uint32_t sleep_manager_deep_sleep_latency(void);
+
+/** Sleep manager residency statistics, one tier per sleep state */
+typedef struct {
+    us_timestamp_t sleep_time;           /**< Time spent in sleep */
+    us_timestamp_t deep_sleep_time;      /**< Time spent in deepsleep */
+    uint32_t sleep_entries;              /**< Number of sleep entries */
+    uint32_t deep_sleep_entries;         /**< Number of deepsleep entries */
+    uint32_t deep_sleep_blocked_lock;    /**< Deepsleep vetoed by the lock counter */
+    uint32_t deep_sleep_blocked_latency; /**< Deepsleep vetoed by a latency constraint */
+} sleep_manager_stats_t;
+
+/** Fill in residency statistics for each sleep tier
+ *
+ * The veto counters show why the manager stayed in the shallow tier, so
+ * a power regression can be attributed to a lock holder or to an overly
+ * strict latency constraint. Times are only tracked on platforms with an
+ * LP ticker. This function is IRQ and thread safe.
+ *
+ * @param stats Structure to fill in
+ */
+void sleep_manager_get_stats(sleep_manager_stats_t *stats);
+
+/** Hook called before each automatic sleep entry
+ *
+ * Runs in the idle loop with interrupts enabled, before
+ * sleep_manager_sleep_auto() enters its critical section. The default
+ * implementation is a weak empty function; services that want to use idle
+ * time - for example to trickle-fill an entropy reservoir - can override
+ * it. The hook must be brief as it delays sleep entry, and it must not
+ * block indefinitely.
+ */
+void sleep_manager_idle_hook(void);
+
 /** Enter auto selected sleep mode. It chooses the sleep or deeepsleep modes based
  *  on the deepsleep locking counter
  *
@@ -235,6 +322,17 @@ us_timestamp_t mbed_time_idle(void);
  */
 us_timestamp_t mbed_uptime(void);
 
+/** Accumulate time spent in the RTOS idle loop.
+ *
+ * Called by the idle loop with the duration of one idle pass, including
+ * any time spent asleep, so that mbed_time_idle() reports true idle
+ * residency rather than just the time spent in sleep modes.
+ *
+ * @param  time Duration of the idle pass.
+ * @note  Not intended for application use.
+ */
+void sleep_manager_report_idle(us_timestamp_t time);
+
 #ifdef __cplusplus
 }
 #endif
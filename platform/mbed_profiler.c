@@ -0,0 +1,196 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_profiler.h"
+
+#if defined(MBED_PROFILER_ENABLED)
+
+#include <stdio.h>
+#include "cmsis.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_watchpoint.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+#ifndef MBED_CONF_PLATFORM_PROFILER_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_PROFILER_BUFFER_SIZE 256
+#endif
+
+/* PC sampling needs the DWT cycle comparator and monitor-mode debug -
+ * ARMv7-M and up. Elsewhere only span markers are recorded, stamped from
+ * the microsecond ticker. */
+#if defined(DWT_BASE) && defined(DWT_FUNCTION_CYCMATCH_Msk) && !defined(TARGET_CORTEX_A)
+#define PROFILER_HAVE_PC_SAMPLING 1
+#else
+#define PROFILER_HAVE_PC_SAMPLING 0
+#endif
+
+static mbed_profiler_record_t record_ring[MBED_CONF_PLATFORM_PROFILER_BUFFER_SIZE];
+static volatile uint32_t ring_head;     // next write
+static volatile uint32_t ring_tail;     // next read
+static volatile uint32_t ring_dropped;
+static void *volatile current_thread;
+static volatile bool profiler_running;
+static uint32_t sample_interval;
+
+static uint32_t profiler_timestamp(void)
+{
+#if PROFILER_HAVE_PC_SAMPLING
+    return DWT->CYCCNT;
+#else
+    return ticker_read(get_us_ticker_data());
+#endif
+}
+
+static void record_push(uint32_t type, uint32_t value)
+{
+    core_util_critical_section_enter();
+    uint32_t next = ring_head + 1;
+    if (next >= MBED_CONF_PLATFORM_PROFILER_BUFFER_SIZE) {
+        next = 0;
+    }
+    if (next == ring_tail) {
+        ring_dropped++;
+    } else {
+        mbed_profiler_record_t *rec = &record_ring[ring_head];
+        rec->timestamp = profiler_timestamp();
+        rec->value = value;
+        rec->thread_id = current_thread;
+        rec->type = type;
+        ring_head = next;
+    }
+    core_util_critical_section_exit();
+}
+
+#if PROFILER_HAVE_PC_SAMPLING
+/* The cycle comparator raises the DebugMonitor exception; the stacked
+ * frame of the preempted context holds the PC to sample. RTX threads run
+ * on the process stack, so the frame is read from PSP - a sample landing
+ * in handler mode therefore reports the interrupted thread's resume PC. */
+void DebugMon_Handler(void)
+{
+    if (DWT->FUNCTION0 & DWT_FUNCTION_MATCHED_Msk) {    // read clears MATCHED
+        uint32_t *frame = (uint32_t *) __get_PSP();
+        record_push(MBED_PROFILER_REC_SAMPLE, frame[6]);
+        DWT->COMP0 = DWT->CYCCNT + sample_interval;
+    }
+#if defined(MBED_WATCHPOINT_ENABLED)
+    // the address comparators share the exception with the sampler
+    mbed_watchpoint_debugmon_hook();
+#endif
+}
+#endif
+
+void mbed_profiler_start(uint32_t interval_cycles)
+{
+    core_util_critical_section_enter();
+    sample_interval = interval_cycles;
+    profiler_running = true;
+#if PROFILER_HAVE_PC_SAMPLING
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    /* Monitor-mode debug: comparator matches raise DebugMonitor. Halting
+     * debug takes precedence, so no samples arrive with a probe attached. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_MON_EN_Msk;
+    DWT->COMP0 = DWT->CYCCNT + interval_cycles;
+    DWT->MASK0 = 0;
+    DWT->FUNCTION0 = DWT_FUNCTION_CYCMATCH_Msk | (0x4 << DWT_FUNCTION_FUNCTION_Pos);
+#endif
+    core_util_critical_section_exit();
+}
+
+void mbed_profiler_stop(void)
+{
+    core_util_critical_section_enter();
+#if PROFILER_HAVE_PC_SAMPLING
+    DWT->FUNCTION0 = 0;
+#endif
+    profiler_running = false;
+    core_util_critical_section_exit();
+}
+
+void mbed_profiler_span(const char *name, bool enter)
+{
+    if (!profiler_running) {
+        return;
+    }
+    record_push(enter ? MBED_PROFILER_REC_SPAN_ENTER : MBED_PROFILER_REC_SPAN_EXIT,
+                (uint32_t)(uintptr_t) name);
+}
+
+void mbed_profiler_thread_switch_hook(void *thread_id)
+{
+    current_thread = thread_id;
+}
+
+uint32_t mbed_profiler_read(mbed_profiler_record_t *records, uint32_t count)
+{
+    uint32_t copied = 0;
+
+    core_util_critical_section_enter();
+    while (copied < count && ring_tail != ring_head) {
+        records[copied++] = record_ring[ring_tail];
+        uint32_t next = ring_tail + 1;
+        if (next >= MBED_CONF_PLATFORM_PROFILER_BUFFER_SIZE) {
+            next = 0;
+        }
+        ring_tail = next;
+    }
+    core_util_critical_section_exit();
+
+    return copied;
+}
+
+void mbed_profiler_dump(mbed_profiler_write_f write, void *handle)
+{
+    mbed_profiler_record_t rec;
+    char line[64];
+    int len;
+
+    while (mbed_profiler_read(&rec, 1) == 1) {
+        switch (rec.type) {
+            case MBED_PROFILER_REC_SPAN_ENTER:
+            case MBED_PROFILER_REC_SPAN_EXIT:
+                len = snprintf(line, sizeof line, "%c %lu %s %p\n",
+                               (rec.type == MBED_PROFILER_REC_SPAN_ENTER) ? 'E' : 'X',
+                               (unsigned long) rec.timestamp,
+                               (const char *)(uintptr_t) rec.value, rec.thread_id);
+                break;
+            default:
+                len = snprintf(line, sizeof line, "P %lu 0x%lx %p\n",
+                               (unsigned long) rec.timestamp,
+                               (unsigned long) rec.value, rec.thread_id);
+                break;
+        }
+        if (len > (int) sizeof line - 1) {
+            len = (int) sizeof line - 1;
+        }
+        if (write(handle, line, len) < 0) {
+            return;
+        }
+    }
+
+    core_util_critical_section_enter();
+    uint32_t dropped = ring_dropped;
+    ring_dropped = 0;
+    core_util_critical_section_exit();
+    if (dropped) {
+        len = snprintf(line, sizeof line, "D %lu\n", (unsigned long) dropped);
+        write(handle, line, len);
+    }
+}
+
+#endif // MBED_PROFILER_ENABLED
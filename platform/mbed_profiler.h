@@ -0,0 +1,137 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PROFILER_H
+#define MBED_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Sampling profiler with span annotations.
+ *
+ * When MBED_PROFILER_ENABLED is set, mbed_profiler_start arms the DWT
+ * cycle comparator to raise the DebugMonitor exception at a fixed cycle
+ * interval; each exception stores the interrupted PC, the running thread
+ * and a cycle timestamp into a preallocated ring. Code can additionally
+ * mark spans with the MBED_PROFILER_SPAN_ENTER/EXIT macros, which record
+ * named enter/exit events in the same ring and compile away when the
+ * profiler is disabled.
+ *
+ * Thread attribution comes from the RTX context switch hook. Records are
+ * drained with mbed_profiler_read, or formatted as text lines through a
+ * caller-supplied writer with mbed_profiler_dump - the writer can forward
+ * to a UARTSerial, a FileHandle or the semihost connection.
+ *
+ * PC sampling uses monitor-mode debug, so it requires a core with a DWT
+ * cycle comparator (M3 and up) and takes no samples while a halting-mode
+ * debug probe is attached. On cores without the comparator only span
+ * markers are recorded, timestamped from the microsecond ticker.
+ */
+
+/** Type of a profiler record */
+typedef enum {
+    MBED_PROFILER_REC_SAMPLE = 0,       /**< PC sample from the cycle comparator */
+    MBED_PROFILER_REC_SPAN_ENTER = 1,   /**< MBED_PROFILER_SPAN_ENTER marker */
+    MBED_PROFILER_REC_SPAN_EXIT = 2     /**< MBED_PROFILER_SPAN_EXIT marker */
+} mbed_profiler_record_type_t;
+
+/** One entry of the profiler ring */
+typedef struct {
+    uint32_t timestamp;     /**< DWT cycles at capture, microseconds without a DWT */
+    uint32_t value;         /**< Sampled PC, or the span name pointer for markers */
+    void *thread_id;        /**< Thread running at capture (osThreadId_t), NULL before the first switch */
+    uint32_t type;          /**< mbed_profiler_record_type_t */
+} mbed_profiler_record_t;
+
+/** Writer used by mbed_profiler_dump, FileHandle::write shaped.
+ *
+ *  @param handle   Opaque pointer passed through from the dump call
+ *  @param buf      Text to write
+ *  @param size     Number of bytes in buf
+ *  @return         Number of bytes written, negative to abort the dump
+ */
+typedef int (*mbed_profiler_write_f)(void *handle, const void *buf, size_t size);
+
+/** Start sampling.
+ *
+ *  @param interval_cycles  Cycles between PC samples. Choose it to keep the
+ *                          sample rate in the low kilohertz - each sample
+ *                          costs an exception entry and a ring store.
+ */
+void mbed_profiler_start(uint32_t interval_cycles);
+
+/** Stop sampling. Span markers are no longer recorded either; buffered
+ *  records remain readable. */
+void mbed_profiler_stop(void);
+
+/** Record a span marker. Use the MBED_PROFILER_SPAN_ENTER/EXIT macros
+ *  rather than calling this directly, so annotations compile away when
+ *  the profiler is disabled.
+ *
+ *  @param name   Span name; the pointer is stored, so it must be a literal
+ *                or otherwise outlive the dump
+ *  @param enter  True at span entry, false at exit
+ */
+void mbed_profiler_span(const char *name, bool enter);
+
+/** Drain up to count records from the ring, oldest first.
+ *
+ *  @param records  Array the records are copied into
+ *  @param count    Capacity of the array
+ *  @return         Number of records copied
+ */
+uint32_t mbed_profiler_read(mbed_profiler_record_t *records, uint32_t count);
+
+/** Drain the ring as text lines through a writer.
+ *
+ * Lines are "P <timestamp> <pc> <thread>" for samples and
+ * "E <timestamp> <name> <thread>" / "X ..." for span markers. A final
+ * "D <count>" line reports records dropped on ring overflow since the
+ * previous dump.
+ *
+ *  @param write   Writer the lines are passed to
+ *  @param handle  Opaque pointer handed to the writer
+ */
+void mbed_profiler_dump(mbed_profiler_write_f write, void *handle);
+
+/** Context switch hook - called from the RTX switch event with the thread
+ *  being switched in, to attribute samples and spans to threads.
+ *
+ *  @param thread_id  id of the thread about to run
+ */
+void mbed_profiler_thread_switch_hook(void *thread_id);
+
+#if defined(MBED_PROFILER_ENABLED)
+#define MBED_PROFILER_SPAN_ENTER(name) mbed_profiler_span((name), true)
+#define MBED_PROFILER_SPAN_EXIT(name)  mbed_profiler_span((name), false)
+#else
+#define MBED_PROFILER_SPAN_ENTER(name) ((void)0)
+#define MBED_PROFILER_SPAN_EXIT(name)  ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
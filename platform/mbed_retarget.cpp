@@ -217,6 +217,113 @@ ssize_t Sink::read(void *buffer, size_t size) {
     return 1;
 }
 
+#if MBED_CONF_PLATFORM_STDIO_BUFFERED_OUTPUT_SIZE
+
+/* Staging buffer in front of the stdout console. Writes become a memcpy
+ * into the buffer; the underlying handle only sees whole lines (or a full
+ * buffer), so logging threads are not stalled by one bus transaction per
+ * character. Reads and polling pass straight through.
+ */
+class BufferedConsole : public FileHandle {
+public:
+    BufferedConsole(FileHandle *fh) : _fh(fh), _level(0) { }
+    virtual ssize_t write(const void *buffer, size_t size);
+    virtual ssize_t read(void *buffer, size_t size) {
+        return _fh->read(buffer, size);
+    }
+    virtual off_t seek(off_t offset, int whence = SEEK_SET) {
+        return -ESPIPE;
+    }
+    virtual off_t size() {
+        return -EINVAL;
+    }
+    virtual int isatty() {
+        return _fh->isatty();
+    }
+    virtual int sync();
+    virtual int close() {
+        sync();
+        return _fh->close();
+    }
+    virtual short poll(short events) const {
+        return _fh->poll(events);
+    }
+    virtual void sigio(Callback<void()> func) {
+        _fh->sigio(func);
+    }
+private:
+    int flush();
+    FileHandle *_fh;
+    PlatformMutex _mutex;
+    unsigned char _buffer[MBED_CONF_PLATFORM_STDIO_BUFFERED_OUTPUT_SIZE];
+    size_t _level;
+};
+
+/* Push the staged bytes down to the real console; called with the mutex held */
+int BufferedConsole::flush() {
+    size_t sent = 0;
+    while (sent < _level) {
+        ssize_t r = _fh->write(_buffer + sent, _level - sent);
+        if (r < 0) {
+            _level = 0;
+            return (int)r;
+        }
+        sent += r;
+    }
+    _level = 0;
+    return 0;
+}
+
+ssize_t BufferedConsole::write(const void *buffer, size_t size) {
+    const unsigned char *buf = static_cast<const unsigned char *>(buffer);
+    bool newline = false;
+    size_t accepted = 0;
+
+    _mutex.lock();
+    while (accepted < size) {
+        size_t chunk = size - accepted;
+        size_t space = sizeof(_buffer) - _level;
+        if (space == 0) {
+            int err = flush();
+            if (err < 0) {
+                _mutex.unlock();
+                return err;
+            }
+            continue;
+        }
+        if (chunk > space) {
+            chunk = space;
+        }
+        if (memchr(buf + accepted, '\n', chunk)) {
+            newline = true;
+        }
+        memcpy(_buffer + _level, buf + accepted, chunk);
+        _level += chunk;
+        accepted += chunk;
+    }
+    if (newline) {
+        int err = flush();
+        if (err < 0) {
+            _mutex.unlock();
+            return err;
+        }
+    }
+    _mutex.unlock();
+    return size;
+}
+
+int BufferedConsole::sync() {
+    _mutex.lock();
+    int err = flush();
+    _mutex.unlock();
+    if (err < 0) {
+        return err;
+    }
+    return _fh->sync();
+}
+
+#endif // MBED_CONF_PLATFORM_STDIO_BUFFERED_OUTPUT_SIZE
+
 
 MBED_WEAK FileHandle* mbed::mbed_target_override_console(int fd)
 {
@@ -250,16 +357,42 @@ static FileHandle* default_console()
 }
 
 /* Locate the default console for stdout, stdin, stderr */
+static FileHandle* get_console(int fd);
+
+#if defined(MBED_INIT_REGISTRY_ENABLED)
+#include "platform/mbed_init_registry.h"
+/* Register the console as a deferrable unit, so staging builds can pull
+ * its construction forward to a quiet moment instead of paying it
+ * inside the first printf */
+static void init_console_unit()
+{
+    get_console(STDOUT_FILENO);
+}
+static struct ConsoleInitRegistrar {
+    ConsoleInitRegistrar()
+    {
+        mbed_init_registry_defer("stdio-console", init_console_unit);
+    }
+} console_init_registrar;
+#endif
+
 static FileHandle* get_console(int fd) {
     FileHandle *fh = mbed_override_console(fd);
-    if (fh) {
-        return fh;
+    if (!fh) {
+        fh = mbed_target_override_console(fd);
     }
-    fh = mbed_target_override_console(fd);
-    if (fh) {
-        return fh;
+    if (!fh) {
+        fh = default_console();
     }
-    return default_console();
+#if MBED_CONF_PLATFORM_STDIO_BUFFERED_OUTPUT_SIZE
+    /* stdout gets the staging buffer; stderr stays unbuffered so error
+     * output is never stranded in RAM after a crash */
+    if (fd == STDOUT_FILENO) {
+        static BufferedConsole buffered_stdout(fh);
+        return &buffered_stdout;
+    }
+#endif
+    return fh;
 }
 
 /* Deal with the fact C library may not _open descriptors 0, 1, 2 - auto bind */
@@ -15,6 +15,7 @@
  */
 
 #include "mbed_toolchain.h"
+#include "mbed_boot_trace.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include "cmsis.h"
@@ -71,16 +72,19 @@ void mbed_copy_nvic(void)
 
 int $Super$$main(void);
 
-int $Sub$$main(void) 
+int $Sub$$main(void)
 {
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_MAIN);
     mbed_main();
     return $Super$$main();
 }
 
-void _platform_post_stackheap_init(void) 
+void _platform_post_stackheap_init(void)
 {
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RAM_INIT);
     mbed_copy_nvic();
     mbed_sdk_init();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_SDK_INIT);
 }
 
 #elif defined (__GNUC__) 
@@ -89,14 +93,17 @@ extern int __real_main(void);
 
 void software_init_hook(void)
 {
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RAM_INIT);
     mbed_copy_nvic();
     mbed_sdk_init();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_SDK_INIT);
     software_init_hook_rtos();
 }
 
 
-int __wrap_main(void) 
+int __wrap_main(void)
 {
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_MAIN);
     mbed_main();
     return __real_main();
 }
@@ -8,6 +8,9 @@
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #include "rtos_idle.h"
+#if defined(MBED_THREAD_STATS_ENABLED)
+#include "mbed_thread_stats.h"
+#endif
 #elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_CPU_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
@@ -29,6 +32,7 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 }
 
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
+// note: mbed_stats_wakeup_latency_get defined in drivers/WakeupLatencyProbe.cpp
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -110,6 +114,7 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
         stats[i].stack_size = osThreadGetStackSize(threads[i]);
         stats[i].stack_space = osThreadGetStackSpace(threads[i]);
         stats[i].name = osThreadGetName(threads[i]);
+        mbed_thread_stats_read(threads[i], &stats[i].cpu_cycles, &stats[i].min_stack_space);
     }
     osKernelUnlock();
     free(threads);
@@ -57,6 +57,36 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/** Number of power-of-two size classes in the heap detail histograms */
+#define MBED_STATS_HEAP_HIST_SIZE 16
+
+/**
+ * struct mbed_stats_heap_detail_t definition
+ *
+ * Size class i counts requests of [2^i, 2^(i+1)) bytes; the last class
+ * also absorbs everything larger.
+ */
+typedef struct {
+    uint32_t alloc_hist[MBED_STATS_HEAP_HIST_SIZE]; /**< Live allocations per size class. */
+    uint32_t fail_hist[MBED_STATS_HEAP_HIST_SIZE];  /**< Failed allocations per size class. */
+    uint32_t largest_free_block;                    /**< Largest single block currently allocatable. */
+    uint32_t free_size;                             /**< Estimated free bytes, ignoring allocator overhead. */
+} mbed_stats_heap_detail_t;
+
+/**
+ *  Fill the passed in structure with heap fragmentation detail.
+ *
+ *  The histograms and failure counters are maintained by the allocation
+ *  wrappers and cost nothing to read. The largest free block is measured
+ *  at call time with a short binary-search allocation probe (a few
+ *  transient mallocs), so a low largest_free_block against a high
+ *  free_size is the fragmentation signal. Cheap enough for periodic
+ *  telemetry.
+ *
+ *  @param stats    A pointer to the mbed_stats_heap_detail_t structure to fill
+ */
+void mbed_stats_heap_detail_get(mbed_stats_heap_detail_t *stats);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -112,6 +142,8 @@ typedef struct {
     uint32_t stack_size;        /**< Thread Stack Size */
     uint32_t stack_space;       /**< Thread remaining stack size */
     const char   *name;         /**< Thread Object name */
+    uint64_t cpu_cycles;        /**< Cycles spent running, sampled at context switch, 0 if not tracked */
+    uint32_t min_stack_space;   /**< Smallest free stack observed at a context switch, 0 if not tracked */
 } mbed_stats_thread_t;
 
 /**
@@ -150,6 +182,50 @@ typedef struct {
  */
 void mbed_stats_sys_get(mbed_stats_sys_t *stats);
 
+/** Number of power-of-two latency buckets in the wakeup latency histograms */
+#define MBED_STATS_WAKEUP_LATENCY_BUCKET_COUNT 16
+
+/**
+ * enum mbed_wakeup_path_t definition
+ *
+ * The interrupt-to-thread wakeup paths exercised by mbed::WakeupLatencyProbe.
+ */
+typedef enum {
+    MBED_WAKEUP_PATH_SEMAPHORE = 0,     /**< Semaphore released from interrupt */
+    MBED_WAKEUP_PATH_EVENT_FLAGS,       /**< EventFlags set from interrupt */
+    MBED_WAKEUP_PATH_EVENT_QUEUE,       /**< EventQueue call posted from interrupt */
+    MBED_WAKEUP_PATH_COUNT              /**< Number of measured wakeup paths */
+} mbed_wakeup_path_t;
+
+/**
+ * struct mbed_stats_wakeup_latency_t definition
+ *
+ * Latency bucket i counts wakeups of [2^i, 2^(i+1)) microseconds; the
+ * last bucket also absorbs everything slower.
+ */
+typedef struct {
+    uint32_t samples;       /**< Number of wakeups recorded */
+    uint32_t min_us;        /**< Shortest interrupt-to-thread latency observed */
+    uint32_t max_us;        /**< Longest interrupt-to-thread latency observed */
+    uint64_t total_us;      /**< Sum of all latencies, mean is total_us / samples */
+    uint32_t bucket[MBED_STATS_WAKEUP_LATENCY_BUCKET_COUNT];    /**< Latency histogram */
+} mbed_stats_wakeup_latency_t;
+
+/**
+ *  Fill the passed in structure with the wakeup latency histogram of one
+ *  wakeup path. The histograms are collected by a running
+ *  mbed::WakeupLatencyProbe and are all zero while no probe has run.
+ *
+ *  @param path     The wakeup path to report
+ *  @param stats    A pointer to the mbed_stats_wakeup_latency_t structure to fill
+ */
+void mbed_stats_wakeup_latency_get(mbed_wakeup_path_t path, mbed_stats_wakeup_latency_t *stats);
+
+/**
+ *  Clear the collected wakeup latency histograms of all paths.
+ */
+void mbed_stats_wakeup_latency_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -82,6 +82,28 @@ void wait_ms(int ms);
  */
 void wait_us(int us);
 
+/** Shortest delay wait_us serves with the calibrated cycle spin instead
+ *  of the ticker; 0 disables the spin path. Set from the platform config
+ *  value wait-us-spin-threshold. */
+#ifndef MBED_CONF_PLATFORM_WAIT_US_SPIN_THRESHOLD
+#define MBED_CONF_PLATFORM_WAIT_US_SPIN_THRESHOLD 16
+#endif
+
+/** Waits a number of microseconds by spinning on the DWT cycle counter.
+ *
+ *  Below the wait-us-spin-threshold wait_us delegates here, avoiding the
+ *  ticker read overhead that dominates 1-5 us delays; drivers bit-banging
+ *  a bus can also call it directly for the tightest timing. The first
+ *  call calibrates the cycle counter against the microsecond ticker
+ *  (roughly 100 us, interrupts masked), so callers needing an accurate
+ *  first delay should make a throwaway call at init.
+ *
+ *  @param us the whole number of microseconds to wait
+ *  @return true if the delay was served, false if the core has no cycle
+ *          counter and the caller must fall back to the ticker
+ */
+int mbed_wait_us_spin(unsigned int us);
+
 #ifdef __cplusplus
 }
 #endif
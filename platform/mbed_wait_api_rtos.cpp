@@ -33,6 +33,13 @@ void wait_ms(int ms) {
 }
 
 void wait_us(int us) {
+#if MBED_CONF_PLATFORM_WAIT_US_SPIN_THRESHOLD > 0
+    // short delays spin on the cycle counter, where a ticker read alone
+    // would overshoot the request
+    if (us > 0 && us < MBED_CONF_PLATFORM_WAIT_US_SPIN_THRESHOLD && mbed_wait_us_spin(us)) {
+        return;
+    }
+#endif
     const ticker_data_t *const ticker = get_us_ticker_data();
 
     uint32_t start = ticker_read(ticker);
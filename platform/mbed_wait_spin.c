@@ -0,0 +1,75 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_wait_api.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
+#include "cmsis.h"
+
+/* Cycle spinning needs the DWT cycle counter - ARMv7-M and up. Elsewhere
+ * mbed_wait_us_spin reports failure and wait_us stays on the ticker. */
+#if defined(DWT_BASE) && defined(DWT_CTRL_CYCCNTENA_Msk) && !defined(TARGET_CORTEX_A)
+
+/* interval the cycle counter is calibrated over; long enough that the
+ * ticker read jitter at the edges stays below 1% */
+#define WAIT_SPIN_CALIBRATE_US 128
+
+static uint32_t cycles_per_us;
+
+/* Measure the core clock against the microsecond ticker once, so the
+ * spin stays accurate under clock scaling where a stale SystemCoreClock
+ * would not be. */
+static int wait_spin_calibrate(void)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    core_util_critical_section_enter();
+    // start on a tick edge so the interval is a whole number of ticks
+    uint32_t edge = ticker_read(ticker);
+    uint32_t start;
+    while ((start = ticker_read(ticker)) == edge);
+    uint32_t cycles = DWT->CYCCNT;
+    while (ticker_read(ticker) - start < WAIT_SPIN_CALIBRATE_US);
+    cycles = DWT->CYCCNT - cycles;
+    core_util_critical_section_exit();
+
+    cycles_per_us = (cycles + WAIT_SPIN_CALIBRATE_US / 2) / WAIT_SPIN_CALIBRATE_US;
+    return cycles_per_us != 0;
+}
+
+int mbed_wait_us_spin(unsigned int us)
+{
+    if (cycles_per_us == 0 && !wait_spin_calibrate()) {
+        return 0;
+    }
+    uint32_t start = DWT->CYCCNT;
+    uint32_t limit = us * cycles_per_us;
+    while (DWT->CYCCNT - start < limit);
+    return 1;
+}
+
+#else
+
+int mbed_wait_us_spin(unsigned int us)
+{
+    (void)us;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,227 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_watchpoint.h"
+
+#if defined(MBED_WATCHPOINT_ENABLED)
+
+#include "cmsis.h"
+#include "platform/mbed_critical.h"
+
+#ifndef MBED_CONF_PLATFORM_WATCHPOINT_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_WATCHPOINT_BUFFER_SIZE 32
+#endif
+
+/* Address watchpoints need DWT comparators and monitor-mode debug -
+ * ARMv7-M and up. Elsewhere mbed_watchpoint_set reports no comparator. */
+#if defined(DWT_BASE) && defined(DWT_FUNCTION_CYCMATCH_Msk) && !defined(TARGET_CORTEX_A)
+#define WATCHPOINT_HAVE_DWT 1
+#else
+#define WATCHPOINT_HAVE_DWT 0
+#endif
+
+/* The v7-M DWT has at most four comparators; 0 is left to the sampling
+ * profiler's cycle match so both can run in one image. */
+#define WATCHPOINT_MAX_COMP 4
+#define WATCHPOINT_FIRST_COMP 1
+
+/* comparator registers repeat at a four-word stride */
+#define WP_COMP(i)      ((&DWT->COMP0)[4 * (i)])
+#define WP_MASK(i)      ((&DWT->MASK0)[4 * (i)])
+#define WP_FUNCTION(i)  ((&DWT->FUNCTION0)[4 * (i)])
+
+static mbed_watchpoint_record_t record_ring[MBED_CONF_PLATFORM_WATCHPOINT_BUFFER_SIZE];
+static volatile uint32_t ring_head;     // next write
+static volatile uint32_t ring_tail;     // next read
+static volatile uint32_t ring_dropped;
+static void *volatile current_thread;
+
+static struct {
+    bool used;
+    uint32_t address;
+} watch_slot[WATCHPOINT_MAX_COMP];
+
+#if WATCHPOINT_HAVE_DWT
+
+static uint32_t comparator_count(void)
+{
+    uint32_t num = DWT->CTRL >> 28;     // NUMCOMP
+    if (num > WATCHPOINT_MAX_COMP) {
+        num = WATCHPOINT_MAX_COMP;
+    }
+    return num;
+}
+
+static void record_push(int id, uint32_t pc)
+{
+    uint32_t next = ring_head + 1;
+    if (next >= MBED_CONF_PLATFORM_WATCHPOINT_BUFFER_SIZE) {
+        next = 0;
+    }
+    if (next == ring_tail) {
+        ring_dropped++;
+    } else {
+        mbed_watchpoint_record_t *rec = &record_ring[ring_head];
+        rec->timestamp = DWT->CYCCNT;
+        rec->pc = pc;
+        rec->address = watch_slot[id].address;
+        rec->thread_id = current_thread;
+        rec->id = id;
+        ring_head = next;
+    }
+}
+
+/* Called from the DebugMonitor exception; the stacked frame of the
+ * preempted context holds the PC near the access. RTX threads run on the
+ * process stack, so the frame is read from PSP. */
+void mbed_watchpoint_debugmon_hook(void)
+{
+    for (int i = WATCHPOINT_FIRST_COMP; i < WATCHPOINT_MAX_COMP; i++) {
+        if (watch_slot[i].used && (WP_FUNCTION(i) & DWT_FUNCTION_MATCHED_Msk)) {
+            // the FUNCTION read above clears MATCHED
+            uint32_t *frame = (uint32_t *) __get_PSP();
+            record_push(i, frame[6]);
+        }
+    }
+}
+
+#if !defined(MBED_PROFILER_ENABLED)
+/* With the profiler in the image its DebugMon_Handler dispatches to the
+ * hook above; otherwise the watchpoints own the exception. */
+void DebugMon_Handler(void)
+{
+    mbed_watchpoint_debugmon_hook();
+}
+#endif
+
+int mbed_watchpoint_set(const volatile void *addr, uint32_t size, mbed_watchpoint_access_t access)
+{
+    uint32_t address = (uint32_t)(uintptr_t) addr;
+    uint32_t ignore_bits = 0;
+
+    if (size == 0 || (size & (size - 1)) || (address & (size - 1))) {
+        return -1;
+    }
+    for (uint32_t bytes = size; bytes > 1; bytes >>= 1) {
+        ignore_bits++;
+    }
+
+    uint32_t function;
+    switch (access) {
+        case MBED_WATCHPOINT_READ:
+            function = 0x5;
+            break;
+        case MBED_WATCHPOINT_WRITE:
+            function = 0x6;
+            break;
+        default:
+            function = 0x7;
+            break;
+    }
+
+    core_util_critical_section_enter();
+    int id = -1;
+    uint32_t num = comparator_count();
+    for (uint32_t i = WATCHPOINT_FIRST_COMP; i < num; i++) {
+        if (!watch_slot[i].used) {
+            id = i;
+            break;
+        }
+    }
+    if (id >= 0) {
+        watch_slot[id].used = true;
+        watch_slot[id].address = address;
+        /* Monitor-mode debug: comparator matches raise DebugMonitor.
+         * Halting debug takes precedence, so no hits arrive with a probe
+         * attached. CYCCNT supplies the record timestamps. */
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_MON_EN_Msk;
+        WP_COMP(id) = address;
+        WP_MASK(id) = ignore_bits;
+        WP_FUNCTION(id) = function << DWT_FUNCTION_FUNCTION_Pos;
+    }
+    core_util_critical_section_exit();
+    return id;
+}
+
+void mbed_watchpoint_clear(int id)
+{
+    if (id < WATCHPOINT_FIRST_COMP || id >= WATCHPOINT_MAX_COMP) {
+        return;
+    }
+    core_util_critical_section_enter();
+    if (watch_slot[id].used) {
+        WP_FUNCTION(id) = 0;
+        watch_slot[id].used = false;
+    }
+    core_util_critical_section_exit();
+}
+
+#else // WATCHPOINT_HAVE_DWT
+
+void mbed_watchpoint_debugmon_hook(void)
+{
+}
+
+int mbed_watchpoint_set(const volatile void *addr, uint32_t size, mbed_watchpoint_access_t access)
+{
+    (void) addr;
+    (void) size;
+    (void) access;
+    return -1;
+}
+
+void mbed_watchpoint_clear(int id)
+{
+    (void) id;
+}
+
+#endif // WATCHPOINT_HAVE_DWT
+
+uint32_t mbed_watchpoint_read(mbed_watchpoint_record_t *records, uint32_t count)
+{
+    uint32_t copied = 0;
+
+    core_util_critical_section_enter();
+    while (copied < count && ring_tail != ring_head) {
+        records[copied++] = record_ring[ring_tail];
+        uint32_t next = ring_tail + 1;
+        if (next >= MBED_CONF_PLATFORM_WATCHPOINT_BUFFER_SIZE) {
+            next = 0;
+        }
+        ring_tail = next;
+    }
+    core_util_critical_section_exit();
+
+    return copied;
+}
+
+uint32_t mbed_watchpoint_dropped(void)
+{
+    core_util_critical_section_enter();
+    uint32_t dropped = ring_dropped;
+    ring_dropped = 0;
+    core_util_critical_section_exit();
+    return dropped;
+}
+
+void mbed_watchpoint_thread_switch_hook(void *thread_id)
+{
+    current_thread = thread_id;
+}
+
+#endif // MBED_WATCHPOINT_ENABLED
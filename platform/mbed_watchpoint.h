@@ -0,0 +1,111 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_WATCHPOINT_H
+#define MBED_WATCHPOINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Data-access watchpoints without a debugger.
+ *
+ * When MBED_WATCHPOINT_ENABLED is set, mbed_watchpoint_set arms a DWT
+ * address comparator to raise the DebugMonitor exception on reads and/or
+ * writes of an address range; each hit stores the accessing PC, the
+ * running thread and a cycle timestamp into a preallocated ring that is
+ * drained with mbed_watchpoint_read. This answers "who scribbles this
+ * word" on a deployed unit where a debug probe is not an option.
+ *
+ * Thread attribution comes from the RTX context switch hook, like the
+ * profiler's. Watchpoints use monitor-mode debug, so they require a core
+ * with DWT address comparators (M3 and up) and are silent while a
+ * halting-mode debug probe is attached. Comparator 0 is left to the
+ * sampling profiler; the remaining comparators (typically three) are
+ * available as watchpoints.
+ */
+
+/** Accesses a watchpoint fires on */
+typedef enum {
+    MBED_WATCHPOINT_READ = 0,       /**< Fire on reads of the range */
+    MBED_WATCHPOINT_WRITE,          /**< Fire on writes of the range */
+    MBED_WATCHPOINT_READ_WRITE      /**< Fire on any access of the range */
+} mbed_watchpoint_access_t;
+
+/** One entry of the watchpoint ring */
+typedef struct {
+    uint32_t timestamp;     /**< DWT cycles at the access */
+    uint32_t pc;            /**< PC of the instruction near the access */
+    uint32_t address;       /**< Base address of the watched range that matched */
+    void *thread_id;        /**< Thread running at the access (osThreadId_t), NULL before the first switch */
+    int id;                 /**< Watchpoint id the hit belongs to */
+} mbed_watchpoint_record_t;
+
+/** Arm a watchpoint on an address range.
+ *
+ *  @param addr    Start of the range to watch, aligned to size
+ *  @param size    Size of the range in bytes, a power of two
+ *  @param access  Accesses to fire on
+ *  @return        Watchpoint id to pass to mbed_watchpoint_clear, or -1
+ *                 when no comparator is free, the range is not a naturally
+ *                 aligned power of two, or the core has no DWT
+ */
+int mbed_watchpoint_set(const volatile void *addr, uint32_t size, mbed_watchpoint_access_t access);
+
+/** Disarm a watchpoint.
+ *
+ *  @param id  Watchpoint id returned by mbed_watchpoint_set
+ */
+void mbed_watchpoint_clear(int id);
+
+/** Drain captured hits from the ring, oldest first.
+ *
+ *  @param records  Array the hits are copied into
+ *  @param count    Capacity of the array
+ *  @return         Number of records copied
+ */
+uint32_t mbed_watchpoint_read(mbed_watchpoint_record_t *records, uint32_t count);
+
+/** Number of hits dropped on ring overflow since the last call, which
+ *  resets the counter.
+ *
+ *  @return  Dropped hit count
+ */
+uint32_t mbed_watchpoint_dropped(void);
+
+/** Context switch hook - called from the RTX switch event with the thread
+ *  being switched in, to attribute hits to threads.
+ *
+ *  @param thread_id  id of the thread about to run
+ */
+void mbed_watchpoint_thread_switch_hook(void *thread_id);
+
+/** DebugMonitor dispatch - called from the DebugMon exception to service
+ *  matched address comparators. Not for application use.
+ */
+void mbed_watchpoint_debugmon_hook(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,297 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2012 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BUDDYPOOL_H
+#define BUDDYPOOL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "mbed_rtos1_types.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_BuddyPool BuddyPool class
+ * @{
+ */
+
+namespace internal {
+/* compile-time log2 for the buddy order count */
+template<uint32_t N>
+struct buddy_log2 {
+    static const uint32_t value = 1 + buddy_log2<N / 2>::value;
+};
+template<>
+struct buddy_log2<1> {
+    static const uint32_t value = 0;
+};
+}
+
+/** Define and manage a variable-size memory pool with buddy allocation.
+
+  Unlike MemoryPool, which hands out blocks of a single fixed size, a
+  BuddyPool serves mixed request sizes from one arena by splitting it
+  into power-of-two blocks and merging freed buddies back together. This
+  lets several fixed pools that each carry sizing margin be replaced by
+  one arena whose capacity is shared between the sizes. Allocation and
+  free cost is bounded by the number of block orders, not by the number
+  of outstanding blocks.
+
+  @tparam  arena_sz      arena size in bytes, a power of two.
+  @tparam  min_block_sz  smallest block handed out, a power of two no
+                         smaller than 8 (default: 32). Requests are
+                         rounded up to the next power of two no smaller
+                         than this.
+
+ @note
+ Memory considerations: The arena and control structures will be created
+ on current thread's stack, no RTOS memory pools are used.
+*/
+template<uint32_t arena_sz, uint32_t min_block_sz = 32>
+class BuddyPool : private mbed::NonCopyable<BuddyPool<arena_sz, min_block_sz> > {
+    MBED_STATIC_ASSERT((arena_sz & (arena_sz - 1)) == 0,
+            "Invalid arena size. Must be a power of two.");
+    MBED_STATIC_ASSERT((min_block_sz >= 8) && ((min_block_sz & (min_block_sz - 1)) == 0),
+            "Invalid minimum block size. Must be a power of two no smaller than 8.");
+    MBED_STATIC_ASSERT(arena_sz >= min_block_sz,
+            "Invalid arena size. Must hold at least one minimum-size block.");
+public:
+    /** Create and Initialize a buddy pool.
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    BuddyPool() {
+        memset(_order, 0, sizeof(_order));
+        memset(_alloc_count, 0, sizeof(_alloc_count));
+        memset(_peak_count, 0, sizeof(_peak_count));
+        for (uint32_t i = 0; i < order_count; i++) {
+            _free_list[i] = NULL;
+        }
+        /* the whole arena starts out as one maximal free block */
+        free_block *block = (free_block *)_arena;
+        block->next = NULL;
+        block->prev = NULL;
+        _free_list[order_count - 1] = block;
+        _order[0] = order_count - 1;
+    }
+
+    /** Allocate a memory block of at least the requested size.
+      @param   size  number of bytes needed, no larger than arena_sz.
+      @return  address of the allocated memory block or NULL in case of no
+               sufficiently large block available.
+
+      @note You may call this function from ISR context.
+    */
+    void *alloc(uint32_t size) {
+        if (size > arena_sz) {
+            return NULL;
+        }
+        uint32_t order = size_to_order(size);
+
+        core_util_critical_section_enter();
+        /* take the smallest free block that fits, splitting off the
+         * unused halves back onto their free lists */
+        uint32_t avail = order;
+        while (avail < order_count && _free_list[avail] == NULL) {
+            avail++;
+        }
+        if (avail == order_count) {
+            core_util_critical_section_exit();
+            return NULL;
+        }
+        free_block *block = list_pop(avail);
+        uint32_t index = block_index(block);
+        while (avail > order) {
+            avail--;
+            free_block *half = (free_block *)((char *)block + (min_block_sz << avail));
+            _order[block_index(half)] = avail;
+            list_push(avail, half);
+        }
+        _order[index] = order | ALLOCATED;
+        _alloc_count[order]++;
+        if (_alloc_count[order] > _peak_count[order]) {
+            _peak_count[order] = _alloc_count[order];
+        }
+        core_util_critical_section_exit();
+        return block;
+    }
+
+    /** Allocate a memory block of at least the requested size and set it to zero.
+      @param   size  number of bytes needed, no larger than arena_sz.
+      @return  address of the allocated memory block or NULL in case of no
+               sufficiently large block available.
+
+      @note You may call this function from ISR context.
+    */
+    void *calloc(uint32_t size) {
+        void *block = alloc(size);
+        if (block != NULL) {
+            memset(block, 0, min_block_sz << size_to_order(size));
+        }
+        return block;
+    }
+
+    /** Free a memory block.
+      @param   block  address of the allocated memory block to be freed.
+      @return         osOK on successful deallocation, osErrorParameter if given
+                      memory block is NULL or not an allocated block of this pool.
+
+      @note You may call this function from ISR context.
+    */
+    osStatus free(void *block) {
+        char *p = (char *)block;
+        if (p == NULL || p < _arena_start() || p >= _arena_start() + arena_sz
+                || (uint32_t)(p - _arena_start()) % min_block_sz != 0) {
+            return osErrorParameter;
+        }
+        uint32_t index = (p - _arena_start()) / min_block_sz;
+
+        core_util_critical_section_enter();
+        if (!(_order[index] & ALLOCATED)) {
+            core_util_critical_section_exit();
+            return osErrorParameter;
+        }
+        uint32_t order = _order[index] & ~ALLOCATED;
+        _alloc_count[order]--;
+        /* merge with the buddy as long as it is free, whole and of the
+         * same order, doubling the block each time; _order is current for
+         * every block start since each split writes both halves */
+        while (order < order_count - 1) {
+            uint32_t buddy = index ^ (1 << order);
+            if (_order[buddy] != order) {
+                break;
+            }
+            list_remove(order, (free_block *)(_arena_start() + buddy * min_block_sz));
+            if (buddy < index) {
+                index = buddy;
+            }
+            order++;
+        }
+        _order[index] = order;
+        list_push(order, (free_block *)(_arena_start() + index * min_block_sz));
+        core_util_critical_section_exit();
+        return osOK;
+    }
+
+    /** Get the number of outstanding allocations of the order serving a size.
+      @param   size  request size the order is derived from.
+      @return  number of currently allocated blocks of that order.
+
+      @note You may call this function from ISR context.
+    */
+    uint32_t alloc_count(uint32_t size) const {
+        return _alloc_count[size_to_order(size)];
+    }
+
+    /** Get the peak number of simultaneous allocations of the order serving a size.
+      @param   size  request size the order is derived from.
+      @return  most blocks of that order ever allocated at once.
+
+      @note You may call this function from ISR context.
+    */
+    uint32_t peak_alloc_count(uint32_t size) const {
+        return _peak_count[size_to_order(size)];
+    }
+
+    /** Get the block size a request of the given size is served with.
+      @param   size  request size.
+      @return  size in bytes of the power-of-two block used.
+    */
+    static uint32_t alloc_size(uint32_t size) {
+        return min_block_sz << size_to_order(size);
+    }
+
+private:
+    /* free blocks carry their list linkage in the block itself */
+    struct free_block {
+        free_block *next;
+        free_block *prev;
+    };
+
+    static const uint32_t num_min_blocks = arena_sz / min_block_sz;
+    static const uint32_t order_count = internal::buddy_log2<num_min_blocks>::value + 1;
+    static const uint8_t  ALLOCATED = 0x80;
+
+    static uint32_t size_to_order(uint32_t size) {
+        uint32_t order = 0;
+        uint32_t block = min_block_sz;
+        while (block < size) {
+            block <<= 1;
+            order++;
+        }
+        return order;
+    }
+
+    char *_arena_start() const {
+        return (char *)_arena;
+    }
+
+    uint32_t block_index(const free_block *block) const {
+        return ((const char *)block - _arena_start()) / min_block_sz;
+    }
+
+    void list_push(uint32_t order, free_block *block) {
+        block->prev = NULL;
+        block->next = _free_list[order];
+        if (block->next != NULL) {
+            block->next->prev = block;
+        }
+        _free_list[order] = block;
+    }
+
+    free_block *list_pop(uint32_t order) {
+        free_block *block = _free_list[order];
+        _free_list[order] = block->next;
+        if (block->next != NULL) {
+            block->next->prev = NULL;
+        }
+        return block;
+    }
+
+    void list_remove(uint32_t order, free_block *block) {
+        if (block->prev != NULL) {
+            block->prev->next = block->next;
+        } else {
+            _free_list[order] = block->next;
+        }
+        if (block->next != NULL) {
+            block->next->prev = block->prev;
+        }
+    }
+
+    /* uint64_t storage keeps every block 8-byte aligned */
+    uint64_t    _arena[arena_sz / sizeof(uint64_t)];
+    free_block *_free_list[order_count];
+    uint8_t     _order[num_min_blocks];
+    uint32_t    _alloc_count[order_count];
+    uint32_t    _peak_count[order_count];
+};
+/** @}*/
+/** @}*/
+
+}
+#endif
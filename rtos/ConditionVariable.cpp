@@ -28,12 +28,12 @@
 
 namespace rtos {
 
-ConditionVariable::Waiter::Waiter(): sem(0), prev(NULL), next(NULL), in_list(false)
+ConditionVariable::Waiter::Waiter(): sem(0), prev(NULL), next(NULL), in_list(false), in_handoff(false)
 {
     // No initialization to do
 }
 
-ConditionVariable::ConditionVariable(Mutex &mutex): _mutex(mutex), _wait_list(NULL)
+ConditionVariable::ConditionVariable(Mutex &mutex): _mutex(mutex), _wait_list(NULL), _handoff_list(NULL)
 {
     // No initialization to do
 }
@@ -58,9 +58,21 @@ bool ConditionVariable::wait_for(uint32_t millisec)
     _mutex.lock();
 
     if (current_thread.in_list) {
-        _remove_wait_list(&_wait_list, &current_thread);
+        _remove_wait_list(current_thread.in_handoff ? &_handoff_list : &_wait_list, &current_thread);
+        current_thread.in_handoff = false;
     }
 
+#if MBED_CONF_RTOS_CONDITION_VARIABLE_HANDOFF
+    // pass the broadcast baton: wake the next notified waiter only now
+    // that we hold the mutex, so each mutex release admits one thread
+    if (_handoff_list != NULL) {
+        Waiter *next = _handoff_list;
+        _remove_wait_list(&_handoff_list, next);
+        next->in_handoff = false;
+        next->sem.release();
+    }
+#endif
+
     return timeout;
 }
 
@@ -94,10 +106,32 @@ void ConditionVariable::notify_one()
 void ConditionVariable::notify_all()
 {
     MBED_ASSERT(_mutex.get_owner() == Thread::gettid());
+#if MBED_CONF_RTOS_CONDITION_VARIABLE_HANDOFF
+    if (_wait_list == NULL) {
+        return;
+    }
+
+    // move every waiter onto the handoff list and wake only the first;
+    // the rest are woken one at a time as each predecessor re-acquires
+    // the mutex in wait_for, avoiding the thundering herd of all waiters
+    // contending for the mutex at once
+    while (_wait_list != NULL) {
+        Waiter *waiter = _wait_list;
+        _remove_wait_list(&_wait_list, waiter);
+        _add_wait_list(&_handoff_list, waiter);
+        waiter->in_handoff = true;
+    }
+
+    Waiter *first = _handoff_list;
+    _remove_wait_list(&_handoff_list, first);
+    first->in_handoff = false;
+    first->sem.release();
+#else
     while (_wait_list != NULL) {
         _wait_list->sem.release();
         _remove_wait_list(&_wait_list, _wait_list);
     }
+#endif
 }
 
 void ConditionVariable::_add_wait_list(Waiter **wait_list, Waiter *waiter)
@@ -148,6 +182,7 @@ void ConditionVariable::_remove_wait_list(Waiter **wait_list, Waiter *waiter)
 ConditionVariable::~ConditionVariable()
 {
     MBED_ASSERT(NULL == _wait_list);
+    MBED_ASSERT(NULL == _handoff_list);
 }
 
 }
@@ -228,6 +228,11 @@ public:
      *
      * @note - The thread calling this function must be the owner of the ConditionVariable's mutex
      *
+     * @note - With the configuration option `rtos.condition-variable-handoff`
+     * enabled, waiters are woken one at a time as each predecessor
+     * re-acquires the mutex, instead of all at once, so a broadcast does not
+     * make every waiter contend for the mutex simultaneously.
+     *
      * @note You cannot call this function from ISR context.
      */
     void notify_all();
@@ -245,12 +250,16 @@ protected:
         Waiter *prev;
         Waiter *next;
         bool in_list;
+        bool in_handoff;
     };
 
     static void _add_wait_list(Waiter **wait_list, Waiter *waiter);
     static void _remove_wait_list(Waiter **wait_list, Waiter *waiter);
     Mutex &_mutex;
     Waiter *_wait_list;
+    /* Waiters notified by a broadcast but not yet woken - each thread wakes
+     * its successor once it has re-acquired the mutex, see notify_all() */
+    Waiter *_handoff_list;
 };
 
 }
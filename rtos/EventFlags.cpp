@@ -45,11 +45,17 @@ void EventFlags::constructor(const char *name)
     attr.cb_size = sizeof(_obj_mem);
     _id = osEventFlagsNew(&attr);
     MBED_ASSERT(_id);
+    _group_id = NULL;
+    _group_bit = 0;
 }
 
 uint32_t EventFlags::set(uint32_t flags)
 {
-    return osEventFlagsSet(_id, flags);
+    uint32_t result = osEventFlagsSet(_id, flags);
+    if (_group_id != NULL) {
+        osEventFlagsSet(_group_id, _group_bit);
+    }
+    return result;
 }
 
 uint32_t EventFlags::clear(uint32_t flags)
@@ -64,6 +64,8 @@ public:
       @param   flags  specifies the flags that shall be set.
       @return  event flags after setting or error code if highest bit set (@a osFlagsError).
 
+      @note If this object is a member of an EventFlagsGroup, its member bit
+            is also raised in the group.
       @note This function may be called from ISR context.
      */
     uint32_t set(uint32_t flags);
@@ -110,10 +112,16 @@ public:
     ~EventFlags();
 
 private:
+    friend class EventFlagsGroup;
+
     void constructor(const char *name = NULL);
     uint32_t wait(uint32_t flags, uint32_t opt, uint32_t timeout, bool clear);
     osEventFlagsId_t                _id;
     mbed_rtos_storage_event_flags_t _obj_mem;
+    // Group membership, managed by EventFlagsGroup - set() forwards the
+    // member bit into the group's flags object when a group id is present
+    osEventFlagsId_t                _group_id;
+    uint32_t                        _group_bit;
 };
 
 /** @}*/
@@ -0,0 +1,109 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2018 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/EventFlagsGroup.h"
+#include <string.h>
+#include "mbed_assert.h"
+
+namespace rtos {
+
+EventFlagsGroup::EventFlagsGroup()
+{
+    constructor();
+}
+
+EventFlagsGroup::EventFlagsGroup(const char *name)
+{
+    constructor(name);
+}
+
+void EventFlagsGroup::constructor(const char *name)
+{
+    memset(&_obj_mem, 0, sizeof(_obj_mem));
+    memset(_members, 0, sizeof(_members));
+    _used_bits = 0;
+    osEventFlagsAttr_t attr;
+    attr.name = name ? name : "application_unnamed_event_flags_group";
+    attr.cb_mem = &_obj_mem;
+    attr.cb_size = sizeof(_obj_mem);
+    _id = osEventFlagsNew(&attr);
+    MBED_ASSERT(_id);
+}
+
+uint32_t EventFlagsGroup::add(EventFlags &flags)
+{
+    if (flags._group_id != NULL) {
+        return osFlagsErrorParameter;
+    }
+
+    for (uint32_t i = 0; i < sizeof(_members) / sizeof(_members[0]); i++) {
+        uint32_t bit = 1UL << i;
+        if (!(_used_bits & bit)) {
+            _used_bits |= bit;
+            _members[i] = &flags;
+            // The bit must be in place before the group id is published, as
+            // set() may forward from ISR context as soon as it sees the id
+            flags._group_bit = bit;
+            flags._group_id = _id;
+            if (flags.get() != 0) {
+                osEventFlagsSet(_id, bit);
+            }
+            return bit;
+        }
+    }
+
+    return osFlagsErrorResource;
+}
+
+void EventFlagsGroup::remove(EventFlags &flags)
+{
+    if (flags._group_id != _id) {
+        return;
+    }
+
+    uint32_t bit = flags._group_bit;
+    flags._group_id = NULL;
+    flags._group_bit = 0;
+    for (uint32_t i = 0; i < sizeof(_members) / sizeof(_members[0]); i++) {
+        if (_members[i] == &flags) {
+            _members[i] = NULL;
+        }
+    }
+    _used_bits &= ~bit;
+    osEventFlagsClear(_id, bit);
+}
+
+uint32_t EventFlagsGroup::wait_any(uint32_t timeout)
+{
+    return osEventFlagsWait(_id, _used_bits, osFlagsWaitAny, timeout);
+}
+
+EventFlagsGroup::~EventFlagsGroup()
+{
+    for (uint32_t i = 0; i < sizeof(_members) / sizeof(_members[0]); i++) {
+        if (_members[i] != NULL) {
+            remove(*_members[i]);
+        }
+    }
+    osEventFlagsDelete(_id);
+}
+
+}
@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2018 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef EVENT_FLAGS_GROUP_H
+#define EVENT_FLAGS_GROUP_H
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#include "rtos/EventFlags.h"
+
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_EventFlagsGroup EventFlagsGroup class
+ * @{
+ */
+
+/** The EventFlagsGroup class lets one thread block on several EventFlags
+ objects at once.
+
+ Each added EventFlags object is given a member bit in the group. Whenever
+ flags are set on a member, its bit is also raised in the group, so a single
+ wait_any() blocks until any member is signaled - no polling loop over the
+ members is needed. The returned mask tells the caller which members to
+ examine; the members' own flags are untouched and are read or consumed with
+ the usual EventFlags calls.
+ @note
+ A group supports up to 30 members, as the member bits share the 31 usable
+ event flags and the MSB is reserved for error codes (@a osFlagsError).
+ @note
+ Memory considerations: The control structures will be created on current
+ thread's stack, both for the mbed OS and underlying RTOS objects (static or
+ dynamic RTOS memory pools are not being used).
+*/
+class EventFlagsGroup : private mbed::NonCopyable<EventFlagsGroup> {
+public:
+    /** Create and Initialize an EventFlagsGroup object
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    EventFlagsGroup();
+
+    /** Create and Initialize an EventFlagsGroup object
+
+     @param name name to be used for this group. It has to stay allocated for the lifetime of the thread.
+
+     @note You cannot call this function from ISR context.
+    */
+    EventFlagsGroup(const char *name);
+
+    /** Add an EventFlags object as a member of this group.
+      @param   flags  the EventFlags object to add. It must outlive its group
+                      membership and may belong to at most one group at a time.
+      @return  the member bit assigned to the object, or error code if highest
+               bit set (@a osFlagsError) when the group is full or the object
+               already belongs to a group.
+
+      @note If the member already has flags set when added, its bit is raised
+            in the group immediately so the signal is not lost.
+      @note You cannot call this function from ISR context.
+     */
+    uint32_t add(EventFlags &flags);
+
+    /** Remove an EventFlags object from this group.
+      @param   flags  the EventFlags object to remove.
+
+      @note You cannot call this function from ISR context.
+     */
+    void remove(EventFlags &flags);
+
+    /** Wait for any member of the group to be signaled.
+      @param   timeout  timeout value or 0 in case of no time-out. (default: osWaitForever)
+      @return  mask of member bits signaled since the last wait, or error code
+               if highest bit set (@a osFlagsError).
+
+      @note The member bits are cleared in the group before returning; the
+            members' own flags are left for the caller to consume.
+      @note This function may be called from ISR context if the timeout parameter is set to 0.
+     */
+    uint32_t wait_any(uint32_t timeout = osWaitForever);
+
+    /** EventFlagsGroup destructor. Remaining members are detached.
+
+      @note You cannot call this function from ISR context.
+    */
+    ~EventFlagsGroup();
+
+private:
+    void constructor(const char *name = NULL);
+    osEventFlagsId_t                _id;
+    mbed_rtos_storage_event_flags_t _obj_mem;
+    uint32_t                        _used_bits;
+    EventFlags                     *_members[30];
+};
+
+/** @}*/
+/** @}*/
+
+}
+#endif
@@ -24,6 +24,10 @@
 
 #include "mbed.h"
 
+#if defined(MBED_THREAD_STATS_ENABLED)
+#include "mbed_thread_stats.h"
+#endif
+
 namespace rtos {
 
 uint64_t Kernel::get_ms_count() {
@@ -60,4 +64,20 @@ uint64_t Kernel::get_ms_count() {
     }
 }
 
+void Kernel::get_scheduler_stats(scheduler_stats_t *stats)
+{
+    memset(stats, 0, sizeof(scheduler_stats_t));
+#if defined(MBED_THREAD_STATS_ENABLED)
+    mbed_scheduler_stats_read(&stats->context_switches, &stats->preemptions,
+                              &stats->switch_cycles, &stats->switch_cycles_max);
+#endif
+}
+
+void Kernel::reset_scheduler_stats()
+{
+#if defined(MBED_THREAD_STATS_ENABLED)
+    mbed_scheduler_stats_reset();
+#endif
+}
+
 }
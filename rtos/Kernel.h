@@ -43,6 +43,29 @@ namespace Kernel {
  */
 uint64_t get_ms_count();
 
+/** Scheduler activity counters collected at the RTOS context switch point.
+     Filled in by get_scheduler_stats().
+ */
+struct scheduler_stats_t {
+    uint32_t context_switches;      /**< Context switches since boot or the last reset */
+    uint32_t preemptions;           /**< Switches where the outgoing thread was still runnable */
+    uint64_t switch_cycles;         /**< Cumulative cycles measured across the switch path */
+    uint32_t switch_cycles_max;     /**< Costliest single switch observed, in cycles */
+};
+
+/** Read the scheduler activity counters.
+     A high share of preemptions in context_switches means threads are being
+     displaced while still runnable - priority churn - rather than blocking
+     voluntarily, and switch_cycles puts a cycle figure on what that churn
+     costs. The counters are kept by the context switch hook and require
+     MBED_THREAD_STATS_ENABLED; without it everything reads as zero.
+     @param stats  pointer to the scheduler_stats_t structure to fill
+ */
+void get_scheduler_stats(scheduler_stats_t *stats);
+
+/** Reset the scheduler activity counters to zero. */
+void reset_scheduler_stats();
+
 } // namespace Kernel
 
 } // namespace rtos
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <new>
 
 #include "Queue.h"
 #include "MemoryPool.h"
@@ -45,15 +46,20 @@ namespace rtos {
  
 /** The Mail class allow to control, send, receive, or wait for mail.
  A mail is a memory block that is send to a thread or interrupt service routine.
-  @tparam  T         data type of a single message element.
-  @tparam  queue_sz  maximum number of messages in queue.
+  @tparam  T            data type of a single message element.
+  @tparam  queue_sz     maximum number of messages in queue.
+  @tparam  block_align  alignment in bytes of the pool blocks holding the
+                        messages, a power of two no smaller than 4
+                        (default: 4). See MemoryPool.
+  @tparam  isr_reserve  extra queue slots and pool blocks only
+                        Mail::put_isr can claim (default: 0). See Queue.
 
  @note
  Memory considerations: The mail data store and control structures will be created on current thread's stack,
  both for the mbed OS and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
 */
-template<typename T, uint32_t queue_sz>
-class Mail : private mbed::NonCopyable<Mail<T, queue_sz> > {
+template<typename T, uint32_t queue_sz, uint32_t block_align = 4, uint32_t isr_reserve = 0>
+class Mail : private mbed::NonCopyable<Mail<T, queue_sz, block_align, isr_reserve> > {
 public:
     /** Create and Initialize Mail queue.
      *
@@ -101,6 +107,77 @@ public:
         return _pool.calloc();
     }
 
+    /** Allocate a memory block of type T and construct the mail in place.
+
+      The payload is built directly in the pool block, so it can be handed to
+      the consumer through Mail::put and Mail::borrow without ever being
+      copied. A mail constructed this way must be returned with Mail::release
+      so its destructor runs.
+
+      @return  pointer to the constructed mail or NULL if the pool is exhausted.
+
+      @note You may call this function from ISR context if T's constructor
+            is ISR safe.
+    */
+    T* emplace(void) {
+        T *mptr = _pool.alloc();
+        if (mptr != NULL) {
+            new (mptr) T();
+        }
+        return mptr;
+    }
+
+    /** Allocate a memory block of type T and construct the mail in place.
+      @param   a0  argument to forward to T's constructor.
+      @return  pointer to the constructed mail or NULL if the pool is exhausted.
+
+      @note You may call this function from ISR context if T's constructor
+            is ISR safe.
+    */
+    template <typename A0>
+    T* emplace(const A0 &a0) {
+        T *mptr = _pool.alloc();
+        if (mptr != NULL) {
+            new (mptr) T(a0);
+        }
+        return mptr;
+    }
+
+    /** Allocate a memory block of type T and construct the mail in place.
+      @param   a0  argument to forward to T's constructor.
+      @param   a1  argument to forward to T's constructor.
+      @return  pointer to the constructed mail or NULL if the pool is exhausted.
+
+      @note You may call this function from ISR context if T's constructor
+            is ISR safe.
+    */
+    template <typename A0, typename A1>
+    T* emplace(const A0 &a0, const A1 &a1) {
+        T *mptr = _pool.alloc();
+        if (mptr != NULL) {
+            new (mptr) T(a0, a1);
+        }
+        return mptr;
+    }
+
+    /** Allocate a memory block of type T and construct the mail in place.
+      @param   a0  argument to forward to T's constructor.
+      @param   a1  argument to forward to T's constructor.
+      @param   a2  argument to forward to T's constructor.
+      @return  pointer to the constructed mail or NULL if the pool is exhausted.
+
+      @note You may call this function from ISR context if T's constructor
+            is ISR safe.
+    */
+    template <typename A0, typename A1, typename A2>
+    T* emplace(const A0 &a0, const A1 &a1, const A2 &a2) {
+        T *mptr = _pool.alloc();
+        if (mptr != NULL) {
+            new (mptr) T(a0, a1, a2);
+        }
+        return mptr;
+    }
+
     /** Put a mail in the queue.
       @param   mptr  memory block previously allocated with Mail::alloc or Mail::calloc.
       @return  status code that indicates the execution status of the function.
@@ -111,6 +188,33 @@ public:
         return _queue.put(mptr);
     }
 
+    /** Put a mail in the queue from interrupt context, allowed to use the
+      reserved ISR slots.
+
+      See Queue::put_isr. The pool holds isr_reserve extra blocks, so an
+      interrupt handler that allocates, fills and posts a mail never fails
+      for thread backpressure; a drop is counted by Mail::isr_dropped.
+
+      @param   mptr  memory block previously allocated with Mail::alloc or Mail::calloc.
+      @return  status code that indicates the execution status of the function.
+
+      @note You may call this function from ISR context.
+    */
+    osStatus put_isr(T *mptr) {
+        return _queue.put_isr(mptr);
+    }
+
+    /** Number of Mail::put_isr mails dropped because even the reserved
+      slots were filled.
+
+      @return  dropped mail count since construction.
+
+      @note You may call this function from ISR context.
+    */
+    uint32_t isr_dropped() const {
+        return _queue.isr_dropped();
+    }
+
     /** Get a mail from a queue.
       @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
       @return  event that contains mail information or error code.
@@ -125,6 +229,80 @@ public:
         return evt;
     }
 
+    /** Put multiple mails in the queue.
+
+      See Queue::put_multiple - the batch is transferred under a single
+      scheduler lock after the first message.
+
+      @param   mptrs     array of memory blocks previously allocated with
+                         Mail::alloc, Mail::calloc or Mail::emplace.
+      @param   count     number of mails in the array.
+      @param   millisec  timeout value or 0 in case of no time-out, applied
+                         to the first mail only. (default: 0)
+      @return  number of mails put into the queue, 0 to count.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    uint32_t put_multiple(T * const *mptrs, uint32_t count, uint32_t millisec=0) {
+        return _queue.put_multiple(mptrs, count, millisec);
+    }
+
+    /** Get multiple mails from the queue, draining up to count mails.
+
+      See Queue::get_multiple. The received pointers refer to the payloads
+      still in their pool blocks (as with Mail::borrow); return each one with
+      Mail::free or Mail::release when done.
+
+      @param   mptrs     array the received mail pointers are written to.
+      @param   count     capacity of the array.
+      @param   millisec  timeout value or 0 in case of no time-out, applied
+                         to the first mail only. (default: osWaitForever)
+      @return  number of mails received, 0 to count.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    uint32_t get_multiple(T **mptrs, uint32_t count, uint32_t millisec=osWaitForever) {
+        return _queue.get_multiple(mptrs, count, millisec);
+    }
+
+    /** Get a mail from the queue without copying it out.
+
+      The zero-copy counterpart of Mail::get - the returned pointer refers to
+      the payload still sitting in the pool block, which stays owned by the
+      caller until it is handed back with Mail::release.
+
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
+      @return  pointer to the mail or NULL on timeout.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    T* borrow(uint32_t millisec=osWaitForever) {
+        osEvent evt = get(millisec);
+        if (evt.status != osEventMail) {
+            return NULL;
+        }
+        return (T*)evt.value.p;
+    }
+
+    /** Destroy a mail and return its memory block to the pool.
+
+      Pairs with Mail::emplace and Mail::borrow - the mail's destructor is
+      run before the block is freed. For mail created with Mail::alloc or
+      Mail::calloc use Mail::free instead.
+
+      @param   mptr  pointer to the mail that was obtained with Mail::borrow.
+      @return  status code that indicates the execution status of the function.
+
+      @note You may call this function from ISR context if T's destructor
+            is ISR safe.
+    */
+    osStatus release(T *mptr) {
+        if (mptr != NULL) {
+            mptr->~T();
+        }
+        return _pool.free(mptr);
+    }
+
     /** Free a memory block from a mail.
       @param   mptr  pointer to the memory block that was obtained with Mail::get.
       @return  status code that indicates the execution status of the function.
@@ -136,8 +314,8 @@ public:
     }
 
 private:
-    Queue<T, queue_sz> _queue;
-    MemoryPool<T, queue_sz> _pool;
+    Queue<T, queue_sz, isr_reserve> _queue;
+    MemoryPool<T, queue_sz + isr_reserve, block_align> _pool;
 };
 
 /** @}*/
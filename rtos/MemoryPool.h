@@ -39,16 +39,22 @@ namespace rtos {
  */
  
 /** Define and manage fixed-size memory pools of objects of a given type.
-  @tparam  T         data type of a single object (element).
-  @tparam  queue_sz  maximum number of objects (elements) in the memory pool.
+  @tparam  T            data type of a single object (element).
+  @tparam  queue_sz     maximum number of objects (elements) in the memory pool.
+  @tparam  block_align  alignment in bytes of each block, a power of two no
+                        smaller than 4 (default: 4). Use the cache line size
+                        (for example 32) for blocks moved by DMA or shared
+                        with bus masters that snoop the cache.
 
  @note
  Memory considerations: The memory pool data store and control structures will be created on current thread's stack,
  both for the mbed OS and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
 */
-template<typename T, uint32_t pool_sz>
-class MemoryPool : private mbed::NonCopyable<MemoryPool<T, pool_sz> > {
+template<typename T, uint32_t pool_sz, uint32_t block_align = 4>
+class MemoryPool : private mbed::NonCopyable<MemoryPool<T, pool_sz, block_align> > {
 	MBED_STATIC_ASSERT(pool_sz > 0, "Invalid memory pool size. Must be greater than 0.");
+	MBED_STATIC_ASSERT((block_align >= 4) && ((block_align & (block_align - 1)) == 0),
+	        "Invalid block alignment. Must be a power of two no smaller than 4.");
 public:
     /** Create and Initialize a memory pool.
      *
@@ -58,11 +64,13 @@ public:
         memset(_pool_mem, 0, sizeof(_pool_mem));
         memset(&_obj_mem, 0, sizeof(_obj_mem));
         osMemoryPoolAttr_t attr = { 0 };
-        attr.mp_mem = _pool_mem;
-        attr.mp_size = sizeof(_pool_mem);
+        /* rounding the buffer start and the block size to block_align keeps
+         * every block on a block_align boundary */
+        attr.mp_mem = (void *)(((uintptr_t)_pool_mem + (block_align - 1)) & ~(uintptr_t)(block_align - 1));
+        attr.mp_size = block_size * pool_sz;
         attr.cb_mem = &_obj_mem;
         attr.cb_size = sizeof(_obj_mem);
-        _id = osMemoryPoolNew(pool_sz, sizeof(T), &attr);
+        _id = osMemoryPoolNew(pool_sz, block_size, &attr);
         MBED_ASSERT(_id);
     }
 
@@ -109,9 +117,12 @@ public:
     }
 
 private:
-    osMemoryPoolId_t             _id;
     /* osMemoryPoolNew requires that pool block size is a multiple of 4 bytes. */
-    char                         _pool_mem[((sizeof(T) + 3) & ~3) * pool_sz];
+    static const uint32_t        block_size = (sizeof(T) + block_align - 1) & ~(block_align - 1);
+
+    osMemoryPoolId_t             _id;
+    /* slack for aligning the buffer start to a block_align boundary */
+    char                         _pool_mem[block_size * pool_sz + block_align - 1];
     mbed_rtos_storage_mem_pool_t _obj_mem;
 };
 /** @}*/
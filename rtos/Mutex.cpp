@@ -25,6 +25,7 @@
 #include <string.h>
 #include "mbed_error.h"
 #include "mbed_assert.h"
+#include "mbed_critical.h"
 
 namespace rtos {
 
@@ -40,6 +41,13 @@ Mutex::Mutex(const char *name)
 
 void Mutex::constructor(const char *name)
 {
+    _fast = false;
+    _fast_sem = NULL;
+    _fast_contend = 0;
+    _fast_owner = NULL;
+    _fast_recursion = 0;
+    _spin_limit = 0;
+
     memset(&_obj_mem, 0, sizeof(_obj_mem));
     osMutexAttr_t attr = { 0 };
     attr.name = name ? name : "aplication_unnamed_mutex";
@@ -50,7 +58,25 @@ void Mutex::constructor(const char *name)
     MBED_ASSERT(_id);
 }
 
+void Mutex::enable_fast_acquire(uint32_t spin_limit) {
+    MBED_ASSERT(_count == 0);
+    if (!_fast) {
+        memset(&_fast_sem_mem, 0, sizeof(_fast_sem_mem));
+        osSemaphoreAttr_t attr = { 0 };
+        attr.cb_mem = &_fast_sem_mem;
+        attr.cb_size = sizeof(_fast_sem_mem);
+        _fast_sem = osSemaphoreNew(0xffff, 0, &attr);
+        MBED_ASSERT(_fast_sem);
+        _fast = true;
+    }
+    _spin_limit = spin_limit;
+}
+
 osStatus Mutex::lock(uint32_t millisec) {
+    if (_fast) {
+        return fast_lock(millisec);
+    }
+
     osStatus status = osMutexAcquire(_id, millisec);
     if (osOK == status) {
         _count++;
@@ -58,6 +84,56 @@ osStatus Mutex::lock(uint32_t millisec) {
     return status;
 }
 
+osStatus Mutex::fast_lock(uint32_t millisec) {
+    osThreadId_t self = osThreadGetId();
+
+    // recursive acquisition, the owner already serializes against itself
+    if (_fast_owner == self) {
+        _fast_recursion++;
+        _count++;
+        return osOK;
+    }
+
+    // a single compare-and-swap takes the place of the kernel call when
+    // the mutex is free, with an optional bounded spin for an owner that
+    // may release imminently on another core
+    bool acquired = false;
+    uint32_t spins = _spin_limit;
+    do {
+        uint32_t expected = 0;
+        acquired = core_util_atomic_cas_u32(&_fast_contend, &expected, 1);
+    } while (!acquired && spins--);
+
+    if (!acquired) {
+        if (millisec == osWaitForever) {
+            // join the waiters; a positive count parks us on the
+            // semaphore until the owner hands the mutex over
+            if (core_util_atomic_incr_u32(&_fast_contend, 1) > 1) {
+                osSemaphoreAcquire(_fast_sem, osWaitForever);
+            }
+        } else if (millisec == 0) {
+            return osErrorResource;
+        } else {
+            // a timed wait cannot park on the handover semaphore without
+            // racing its token accounting, retry periodically instead
+            uint64_t deadline = Kernel::get_ms_count() + millisec;
+            do {
+                osDelay(1);
+                uint32_t expected = 0;
+                acquired = core_util_atomic_cas_u32(&_fast_contend, &expected, 1);
+            } while (!acquired && Kernel::get_ms_count() < deadline);
+            if (!acquired) {
+                return osErrorTimeout;
+            }
+        }
+    }
+
+    _fast_owner = self;
+    _fast_recursion = 0;
+    _count++;
+    return osOK;
+}
+
 bool Mutex::trylock() {
     return trylock_for(0);
 }
@@ -88,14 +164,35 @@ bool Mutex::trylock_until(uint64_t millisec) {
 
 osStatus Mutex::unlock() {
     _count--;
+
+    if (_fast) {
+        if (_fast_recursion > 0) {
+            _fast_recursion--;
+            return osOK;
+        }
+        _fast_owner = NULL;
+        // the last decrement frees the mutex; a positive remainder means
+        // a parked waiter takes over ownership
+        if (core_util_atomic_decr_u32(&_fast_contend, 1) > 0) {
+            osSemaphoreRelease(_fast_sem);
+        }
+        return osOK;
+    }
+
     return osMutexRelease(_id);
 }
 
 osThreadId Mutex::get_owner() {
+    if (_fast) {
+        return _fast_owner;
+    }
     return osMutexGetOwner(_id);
 }
 
 Mutex::~Mutex() {
+    if (_fast_sem) {
+        osSemaphoreDelete(_fast_sem);
+    }
     osMutexDelete(_id);
 }
 
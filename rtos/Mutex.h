@@ -78,6 +78,32 @@ public:
     */
     Mutex(const char *name);
 
+    /** Enable the adaptive spin-then-block acquisition fast path
+
+     When enabled, a free mutex is acquired and released with a single
+     atomic compare-and-swap instead of a kernel call, optionally retrying
+     for a bounded number of spins when the mutex is held, and a contended
+     lock falls back to blocking in the kernel. This cuts the cost of an
+     uncontended lock from a kernel call to a few instructions, which pays
+     off for locks that are taken often and held only for a few cycles, as
+     in the drivers' lock() paths.
+
+     Trade-offs: a thread blocked on a contended fast mutex does not lend
+     its priority to the owner (no priority inheritance), and a lock
+     attempt with a finite non-zero timeout is served by periodic retries
+     rather than a single kernel block. Only enable the fast path on
+     short-held locks that do not need those properties.
+
+     @param spin_limit extra atomic acquisition attempts to make before
+            blocking when the mutex is held. Spinning only pays off when
+            the owner can release simultaneously, so leave it at 0 on
+            single-core targets. (default: 0)
+
+     @note Must be called before the mutex is shared between contexts.
+     @note You cannot call this function from ISR context.
+    */
+    void enable_fast_acquire(uint32_t spin_limit = 0);
+
     /** Wait until a Mutex becomes available.
       @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever)
       @return  status code that indicates the execution status of the function:
@@ -149,11 +175,21 @@ public:
 
 private:
     void constructor(const char *name = NULL);
+    osStatus fast_lock(uint32_t millisec);
     friend class ConditionVariable;
 
     osMutexId_t               _id;
     mbed_rtos_storage_mutex_t _obj_mem;
     uint32_t                  _count;
+
+    // adaptive fast path state, see enable_fast_acquire
+    osSemaphoreId_t                _fast_sem;
+    mbed_rtos_storage_semaphore_t  _fast_sem_mem;
+    volatile uint32_t              _fast_contend;
+    osThreadId_t volatile          _fast_owner;
+    uint32_t                       _fast_recursion;
+    uint32_t                       _spin_limit;
+    bool                           _fast;
 };
 /** @}*/
 /** @}*/
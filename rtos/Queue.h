@@ -27,6 +27,7 @@
 
 #include "cmsis_os2.h"
 #include "mbed_rtos_storage.h"
+#include "platform/mbed_critical.h"
 #include "platform/mbed_error.h"
 #include "platform/NonCopyable.h"
 #include "mbed_rtos1_types.h"
@@ -42,15 +43,19 @@ namespace rtos {
 /** The Queue class allow to control, send, receive, or wait for messages.
  A message can be a integer or pointer value  to a certain type T that is send
  to a thread or interrupt service routine.
-  @tparam  T         data type of a single message element.
-  @tparam  queue_sz  maximum number of messages in queue.
+  @tparam  T            data type of a single message element.
+  @tparam  queue_sz     maximum number of messages in queue.
+  @tparam  isr_reserve  extra slots only Queue::put_isr can claim
+                        (default: 0). Thread-side puts never fill these,
+                        so an interrupt handler sized to its worst burst
+                        never loses an event to thread backpressure.
 
  @note
  Memory considerations: The queue control structures will be created on current thread's stack, both for the mbed OS
  and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
 */
-template<typename T, uint32_t queue_sz>
-class Queue : private mbed::NonCopyable<Queue<T, queue_sz> > {
+template<typename T, uint32_t queue_sz, uint32_t isr_reserve = 0>
+class Queue : private mbed::NonCopyable<Queue<T, queue_sz, isr_reserve> > {
 public:
     /** Create and initialize a message Queue.
      *
@@ -58,12 +63,13 @@ public:
     */
     Queue() {
         memset(&_obj_mem, 0, sizeof(_obj_mem));
+        _isr_dropped = 0;
         osMessageQueueAttr_t attr = { 0 };
         attr.mq_mem = _queue_mem;
         attr.mq_size = sizeof(_queue_mem);
         attr.cb_mem = &_obj_mem;
         attr.cb_size = sizeof(_obj_mem);
-        _id = osMessageQueueNew(queue_sz, sizeof(T*), &attr);
+        _id = osMessageQueueNew(total_sz, sizeof(T*), &attr);
         MBED_ASSERT(_id);
     }
     /** Queue destructor
@@ -91,7 +97,8 @@ public:
      * @note You may call this function from ISR context.
      */
     bool full() const {
-        return osMessageQueueGetSpace(_id) == 0;
+        // the reserved ISR slots do not count as thread-usable space
+        return osMessageQueueGetSpace(_id) <= isr_reserve;
     }
 
     /** Put a message in a Queue.
@@ -105,9 +112,104 @@ public:
                @a osErrorParameter internal error or non-zero timeout specified in an ISR.
 
       @note You may call this function from ISR context if the millisec parameter is set to 0.
+      @note With a non-zero isr_reserve, this put fails once only the
+            reserved slots remain free - use Queue::put_isr from the
+            interrupt handler to claim those.
     */
     osStatus put(T* data, uint32_t millisec=0, uint8_t prio=0) {
-        return osMessageQueuePut(_id, &data, prio, millisec);
+        if (isr_reserve == 0) {
+            return osMessageQueuePut(_id, &data, prio, millisec);
+        }
+        osStatus status = try_put(data, prio);
+        // the reservation cannot be waited on in the kernel, timed puts poll
+        for (uint32_t waited = 0; status == osErrorResource && waited < millisec; waited++) {
+            osDelay(1);
+            status = try_put(data, prio);
+        }
+        if (status == osErrorResource && millisec != 0) {
+            status = osErrorTimeout;
+        }
+        return status;
+    }
+
+    /** Put a message in a Queue from interrupt context, allowed to use the
+      reserved ISR slots.
+
+      Never waits and, with isr_reserve sized to the worst interrupt burst,
+      never fails: thread-side puts stop short of the reserved slots, so the
+      only way this put can find the queue full is an interrupt backlog of
+      more than queue_sz + isr_reserve undrained messages. A failed put is
+      counted and reported by Queue::isr_dropped.
+
+      @param   data  message pointer.
+      @param   prio  priority value or 0 in case of default. (default: 0)
+      @return  status code that indicates the execution status of the function:
+               @a osOK the message has been put into the queue.
+               @a osErrorResource even the reserved slots were filled; the
+               message was dropped and counted.
+
+      @note You may call this function from ISR context.
+    */
+    osStatus put_isr(T* data, uint8_t prio=0) {
+        osStatus status = osMessageQueuePut(_id, &data, prio, 0);
+        if (status != osOK) {
+            core_util_atomic_incr_u32(&_isr_dropped, 1);
+        }
+        return status;
+    }
+
+    /** Number of Queue::put_isr messages dropped because even the reserved
+      slots were filled.
+
+      @return  dropped message count since construction.
+
+      @note You may call this function from ISR context.
+    */
+    uint32_t isr_dropped() const {
+        return _isr_dropped;
+    }
+
+    /** Put multiple messages in a Queue.
+
+      The first message is put with the given timeout; the rest of the batch
+      is then stored without blocking under a single scheduler lock, so a
+      high-rate producer gives the scheduler one preemption opportunity per
+      batch instead of one per message.
+
+      @param   data      array of message pointers to enqueue.
+      @param   count     number of messages in the array.
+      @param   millisec  timeout value or 0 in case of no time-out, applied
+                         to the first message only. (default: 0)
+      @param   prio      priority value or 0 in case of default. (default: 0)
+      @return  number of messages put into the queue, 0 to count. Less than
+               count means the queue filled up (or the first put timed out).
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    uint32_t put_multiple(T * const *data, uint32_t count, uint32_t millisec=0, uint8_t prio=0) {
+        if (count == 0) {
+            return 0;
+        }
+
+        // the only put allowed to block, before the scheduler lock is taken
+        if (put(data[0], millisec, prio) != osOK) {
+            return 0;
+        }
+
+        uint32_t n = 1;
+        int32_t lock = -1;
+        if (!core_util_is_isr_active()) {
+            lock = osKernelLock();
+        }
+
+        while (n < count && try_put(data[n], prio) == osOK) {
+            n++;
+        }
+
+        if (lock >= 0) {
+            osKernelRestoreLock(lock);
+        }
+        return n;
     }
 
     /** Get a message or Wait for a message from a Queue. Messages are retrieved in a descending priority order or
@@ -147,10 +249,77 @@ public:
         return event;
     }
 
+    /** Get multiple messages from a Queue, draining up to count messages.
+
+      Waits up to the given timeout for the first message, then drains
+      whatever else is immediately available (up to count in total) under a
+      single scheduler lock, giving the consumer one kernel transition's
+      worth of preemption opportunity per batch.
+
+      @param   data      array the received message pointers are written to.
+      @param   count     capacity of the array.
+      @param   millisec  timeout value or 0 in case of no time-out, applied
+                         to the first message only. (default: osWaitForever)
+      @return  number of messages received, 0 to count. 0 means the wait for
+               the first message timed out.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    uint32_t get_multiple(T **data, uint32_t count, uint32_t millisec=osWaitForever) {
+        if (count == 0) {
+            return 0;
+        }
+
+        // the only get allowed to block, before the scheduler lock is taken
+        if (osMessageQueueGet(_id, &data[0], NULL, millisec) != osOK) {
+            return 0;
+        }
+
+        uint32_t n = 1;
+        int32_t lock = -1;
+        if (!core_util_is_isr_active()) {
+            lock = osKernelLock();
+        }
+
+        while (n < count && osMessageQueueGet(_id, &data[n], NULL, 0) == osOK) {
+            n++;
+        }
+
+        if (lock >= 0) {
+            osKernelRestoreLock(lock);
+        }
+        return n;
+    }
+
 private:
+    /* non-blocking put that leaves the reserved ISR slots free; the
+     * scheduler lock keeps two threads from racing past the space check */
+    osStatus try_put(T *data, uint8_t prio) {
+        if (isr_reserve == 0) {
+            return osMessageQueuePut(_id, &data, prio, 0);
+        }
+        int32_t lock = -1;
+        if (!core_util_is_isr_active()) {
+            lock = osKernelLock();
+        }
+        osStatus status;
+        if (osMessageQueueGetSpace(_id) <= isr_reserve) {
+            status = osErrorResource;
+        } else {
+            status = osMessageQueuePut(_id, &data, prio, 0);
+        }
+        if (lock >= 0) {
+            osKernelRestoreLock(lock);
+        }
+        return status;
+    }
+
+    static const uint32_t         total_sz = queue_sz + isr_reserve;
+
     osMessageQueueId_t            _id;
-    char                          _queue_mem[queue_sz * (sizeof(T*) + sizeof(mbed_rtos_storage_message_t))];
+    char                          _queue_mem[total_sz * (sizeof(T*) + sizeof(mbed_rtos_storage_message_t))];
     mbed_rtos_storage_msg_queue_t _obj_mem;
+    volatile uint32_t             _isr_dropped;
 };
 /** @}*/
 /** @}*/
@@ -82,7 +82,24 @@ void SysTimer::suspend(uint32_t ticks)
     core_util_critical_section_enter();
 
     remove();
+#if MBED_CONF_RTOS_TICKLESS_COALESCE_SLACK_US > 0
+    /* RTX has already collapsed its delay list into a single deadline
+     * (ticks). If another ticker event - an application Timeout, a stack
+     * retry timer - is due shortly before that deadline, ride its wakeup
+     * instead of programming our own a moment later: resume() tolerates
+     * waking early, and RTX simply suspends again for the remainder. This
+     * halves wakeups when independent timers cluster. */
+    us_timestamp_t target = _start_time + (_tick + ticks) * 1000000ULL / OS_TICK_FREQ;
+    const ticker_event_t *next = _ticker_data->queue->head;
+    if (next && next->timestamp < target
+            && next->timestamp + MBED_CONF_RTOS_TICKLESS_COALESCE_SLACK_US >= target) {
+        insert_absolute(next->timestamp);
+    } else {
+        insert_absolute(target);
+    }
+#else
     schedule_tick(ticks);
+#endif
     _suspend_time_passed = false;
     _suspended = true;
 
@@ -169,6 +169,7 @@
 #include "mbed_toolchain.h"
 #include "mbed_error.h"
 #include "mbed_critical.h"
+#include "mbed_boot_trace.h"
 #if defined(__IAR_SYSTEMS_ICC__ ) && (__VER__ >= 8000000)
 #include <DLib_Threads.h>
 #endif
@@ -326,6 +327,8 @@ void mbed_start_main(void)
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_INITIALIZATION_FAILED), "Pre main thread not created", &_main_thread_attr);
     }
 
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RTOS_START);
+
     osKernelStart();
 }
 
@@ -348,11 +351,13 @@ void $Super$$__cpp_initialize__aeabi_(void);
 
 void _main_init (void) {
     mbed_set_stack_heap();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RAM_INIT);
     /* Copy the vector table to RAM only if uVisor is not in use. */
 #if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_SDK_INIT);
     osKernelInitialize();
     mbed_start_main();
     for (;;);
@@ -374,6 +379,7 @@ void pre_main()
     singleton_mutex_id = osMutexNew(&singleton_mutex_attr);
 
     $Super$$__cpp_initialize__aeabi_();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_MAIN);
     main();
 }
 
@@ -395,6 +401,7 @@ void pre_main (void)
 
     __rt_lib_init((unsigned)mbed_heap_start, (unsigned)(mbed_heap_start + mbed_heap_size));
 
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_MAIN);
     main(0, NULL);
 }
 
@@ -414,11 +421,13 @@ __asm(".global __use_no_semihosting\n\t");
 void __rt_entry (void) {
     __user_setup_stackheap();
     mbed_set_stack_heap();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RAM_INIT);
     /* Copy the vector table to RAM only if uVisor is not in use. */
 #if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_SDK_INIT);
     _platform_post_stackheap_init();
     mbed_start_main();
 }
@@ -633,17 +642,20 @@ void pre_main(void)
 
     __libc_init_array();
 
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_MAIN);
     main(0, NULL);
 }
 
 void software_init_hook(void)
 {
     mbed_set_stack_heap();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RAM_INIT);
     /* Copy the vector table to RAM only if uVisor is not in use. */
 #if !(defined(FEATURE_UVISOR) && defined(TARGET_UVISOR_SUPPORTED))
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_SDK_INIT);
     osKernelInitialize();
     /* uvisor_lib_init calls RTOS functions, so must be called after the RTOS has
      * been initialized. */
@@ -713,6 +725,7 @@ void pre_main(void)
         __iar_dynamic_initialization();
     }
 
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_MAIN);
     mbed_main();
     main();
 }
@@ -734,9 +747,11 @@ void __iar_program_start( void )
     mbed_cpy_nvic();
 #endif
     mbed_sdk_init();
+    MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_SDK_INIT);
   }
 
   mbed_set_stack_heap();
+  MBED_BOOT_TRACE_MARK(MBED_BOOT_STAGE_RAM_INIT);
 
   /* Store in a global variable after RAM has been initialized */
   low_level_init_needed = low_level_init_needed_local;
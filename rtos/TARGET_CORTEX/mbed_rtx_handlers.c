@@ -25,10 +25,23 @@
 #ifdef RTE_Compiler_EventRecorder
 #include "EventRecorder.h"              // Keil::Compiler:Event Recorder
 // Used from rtx_evr.c
+#define EvtRtxThreadSwitched           EventID(EventLevelOp,  0xF2U, 0x18U)
 #define EvtRtxThreadExit               EventID(EventLevelAPI, 0xF2U, 0x19U)
 #define EvtRtxThreadTerminate          EventID(EventLevelAPI, 0xF2U, 0x1AU)
 #endif
 
+#if defined(MBED_THREAD_STATS_ENABLED)
+#include "mbed_thread_stats.h"
+#endif
+
+#if defined(MBED_PROFILER_ENABLED)
+#include "platform/mbed_profiler.h"
+#endif
+
+#if defined(MBED_WATCHPOINT_ENABLED)
+#include "platform/mbed_watchpoint.h"
+#endif
+
 extern void rtos_idle_loop(void);
 extern void thread_terminate_hook(osThreadId_t id);
 
@@ -144,11 +157,35 @@ void EvrRtxMessageQueueError (osMessageQueueId_t mq_id, int32_t status)
 
 #endif
 
+#if defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_PROFILER_ENABLED) || defined(MBED_WATCHPOINT_ENABLED)
+// RTX hook which gets called on every context switch with the incoming thread,
+// used to charge the elapsed cycles to the outgoing thread and sample its stack,
+// and to attribute profiler samples and watchpoint hits to the running thread
+void EvrRtxThreadSwitched (osThreadId_t thread_id)
+{
+#if defined(MBED_THREAD_STATS_ENABLED)
+    mbed_thread_stats_switch_hook(thread_id);
+#endif
+#if defined(MBED_PROFILER_ENABLED)
+    mbed_profiler_thread_switch_hook(thread_id);
+#endif
+#if defined(MBED_WATCHPOINT_ENABLED)
+    mbed_watchpoint_thread_switch_hook(thread_id);
+#endif
+#if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_SWITCHED_DISABLE) && defined(RTE_Compiler_EventRecorder))
+    EventRecord2(EvtRtxThreadSwitched, (uint32_t)thread_id, 0U);
+#endif
+}
+#endif
+
 // RTX hook which gets called when a thread terminates, using the event function to call hook
 void EvrRtxThreadExit (void)
 {
     osThreadId_t thread_id = osThreadGetId();
     thread_terminate_hook(thread_id);
+#if defined(MBED_THREAD_STATS_ENABLED)
+    mbed_thread_stats_remove(thread_id);
+#endif
 #if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_EXIT_DISABLE) && defined(RTE_Compiler_EventRecorder))
     EventRecord2(EvtRtxThreadExit, 0U, 0U);
 #endif
@@ -157,6 +194,9 @@ void EvrRtxThreadExit (void)
 void EvrRtxThreadTerminate (osThreadId_t thread_id)
 {
     thread_terminate_hook(thread_id);
+#if defined(MBED_THREAD_STATS_ENABLED)
+    mbed_thread_stats_remove(thread_id);
+#endif
 #if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_TERMINATE_DISABLE) && defined(RTE_Compiler_EventRecorder))
     EventRecord2(EvtRtxThreadTerminate, (uint32_t)thread_id, 0U);
 #endif
@@ -147,6 +147,12 @@ extern "C" void rtos_idle_loop(void)
 {
     //Continuously call the idle hook function pointer
     while (1) {
+#if defined(MBED_CPU_STATS_ENABLED) && defined(DEVICE_LPTICKER) && defined(DEVICE_SLEEP)
+        us_timestamp_t start = mbed_uptime();
         idle_hook_fptr();
+        sleep_manager_report_idle(mbed_uptime() - start);
+#else
+        idle_hook_fptr();
+#endif
     }
 }
@@ -0,0 +1,209 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_thread_stats.h"
+
+#if defined(MBED_THREAD_STATS_ENABLED)
+
+#include <string.h>
+#include "cmsis.h"
+#include "rtx_os.h"
+#include "mbed_critical.h"
+
+#ifndef MBED_CONF_RTOS_THREAD_STATS_TABLE_SIZE
+#define MBED_CONF_RTOS_THREAD_STATS_TABLE_SIZE 16
+#endif
+
+typedef struct {
+    osThreadId_t thread_id;     // NULL marks a free slot
+    uint64_t cpu_cycles;
+    uint32_t min_stack_free;
+} thread_stats_slot_t;
+
+static thread_stats_slot_t stats_table[MBED_CONF_RTOS_THREAD_STATS_TABLE_SIZE];
+// Cycles of threads whose slot was reclaimed, so totals stay monotonic
+static uint64_t retired_cycles;
+static osThreadId_t running_id;
+static uint32_t last_switch_cycles;
+
+// Scheduler activity, see mbed_scheduler_stats_read()
+static uint32_t switch_count;
+static uint32_t preemption_count;
+static uint64_t switch_cost_cycles;
+static uint32_t switch_cost_max;
+
+/* Cycle source: DWT CYCCNT where the core has one (M3 and up), otherwise
+ * the kernel's system timer count which ticks at the core clock. Either
+ * way a 32-bit counter - deltas are taken per switch, so wrap is handled
+ * as long as a slice is shorter than 2^32 cycles. */
+static uint32_t read_cycles(void)
+{
+#if defined(DWT_BASE) && !defined(TARGET_CORTEX_A)
+    return DWT->CYCCNT;
+#else
+    return (uint32_t)osKernelGetSysTimerCount();
+#endif
+}
+
+static void cycle_counter_init(void)
+{
+#if defined(DWT_BASE) && !defined(TARGET_CORTEX_A)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+static thread_stats_slot_t *slot_for(osThreadId_t thread_id, bool allocate)
+{
+    thread_stats_slot_t *free_slot = NULL;
+    for (unsigned i = 0; i < MBED_CONF_RTOS_THREAD_STATS_TABLE_SIZE; i++) {
+        if (stats_table[i].thread_id == thread_id) {
+            return &stats_table[i];
+        }
+        if (allocate && (free_slot == NULL) && (stats_table[i].thread_id == NULL)) {
+            free_slot = &stats_table[i];
+        }
+    }
+    if (free_slot != NULL) {
+        free_slot->thread_id = thread_id;
+        free_slot->cpu_cycles = 0;
+        free_slot->min_stack_free = 0xFFFFFFFF;
+    }
+    return free_slot;
+}
+
+void mbed_thread_stats_switch_hook(osThreadId_t thread_id)
+{
+    static bool initialized;
+    if (!initialized) {
+        cycle_counter_init();
+        last_switch_cycles = read_cycles();
+        initialized = true;
+    }
+
+    uint32_t now = read_cycles();
+    switch_count++;
+    if (running_id != NULL) {
+        thread_stats_slot_t *out = slot_for(running_id, false);
+        if (out != NULL) {
+            out->cpu_cycles += (uint32_t)(now - last_switch_cycles);
+        }
+        // The outgoing thread is still on the ready list if something
+        // higher priority displaced it - a blocked or terminated thread
+        // left of its own accord
+        if ((running_id != thread_id) && (((os_thread_t *)running_id)->state == osRtxThreadReady)) {
+            preemption_count++;
+        }
+    }
+    last_switch_cycles = now;
+    running_id = thread_id;
+
+    thread_stats_slot_t *in = slot_for(thread_id, true);
+    if (in != NULL) {
+        // The incoming thread's context is stored, so its saved sp gives
+        // the free stack at its last switch-out without scanning for the
+        // watermark pattern.
+        os_thread_t *thread = (os_thread_t *)thread_id;
+        uint32_t stack_free = thread->sp - (uint32_t)thread->stack_mem;
+        if (stack_free < in->min_stack_free) {
+            in->min_stack_free = stack_free;
+        }
+    }
+
+    uint32_t cost = read_cycles() - now;
+    switch_cost_cycles += cost;
+    if (cost > switch_cost_max) {
+        switch_cost_max = cost;
+    }
+}
+
+void mbed_thread_stats_remove(osThreadId_t thread_id)
+{
+    core_util_critical_section_enter();
+    thread_stats_slot_t *slot = slot_for(thread_id, false);
+    if (slot != NULL) {
+        retired_cycles += slot->cpu_cycles;
+        slot->thread_id = NULL;
+    }
+    if (running_id == thread_id) {
+        running_id = NULL;
+    }
+    core_util_critical_section_exit();
+}
+
+bool mbed_thread_stats_read(osThreadId_t thread_id, uint64_t *cpu_cycles, uint32_t *min_stack_free)
+{
+    bool found = false;
+    core_util_critical_section_enter();
+    thread_stats_slot_t *slot = slot_for(thread_id, false);
+    if (slot != NULL) {
+        if (cpu_cycles != NULL) {
+            *cpu_cycles = slot->cpu_cycles;
+        }
+        if (min_stack_free != NULL) {
+            *min_stack_free = (slot->min_stack_free == 0xFFFFFFFF) ? 0 : slot->min_stack_free;
+        }
+        found = true;
+    }
+    core_util_critical_section_exit();
+    return found;
+}
+
+uint64_t mbed_thread_stats_total_cycles(void)
+{
+    uint64_t total;
+    core_util_critical_section_enter();
+    total = retired_cycles;
+    for (unsigned i = 0; i < MBED_CONF_RTOS_THREAD_STATS_TABLE_SIZE; i++) {
+        if (stats_table[i].thread_id != NULL) {
+            total += stats_table[i].cpu_cycles;
+        }
+    }
+    core_util_critical_section_exit();
+    return total;
+}
+
+void mbed_scheduler_stats_read(uint32_t *switches, uint32_t *preemptions,
+                               uint64_t *switch_cycles, uint32_t *switch_cycles_max)
+{
+    core_util_critical_section_enter();
+    if (switches != NULL) {
+        *switches = switch_count;
+    }
+    if (preemptions != NULL) {
+        *preemptions = preemption_count;
+    }
+    if (switch_cycles != NULL) {
+        *switch_cycles = switch_cost_cycles;
+    }
+    if (switch_cycles_max != NULL) {
+        *switch_cycles_max = switch_cost_max;
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_scheduler_stats_reset(void)
+{
+    core_util_critical_section_enter();
+    switch_count = 0;
+    preemption_count = 0;
+    switch_cost_cycles = 0;
+    switch_cost_max = 0;
+    core_util_critical_section_exit();
+}
+
+#endif // MBED_THREAD_STATS_ENABLED
@@ -0,0 +1,93 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2018 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_THREAD_STATS_H
+#define MBED_THREAD_STATS_H
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Per-thread runtime accounting sampled at context switch.
+ *
+ * When MBED_THREAD_STATS_ENABLED is set the RTX thread switch event keeps
+ * a cycle counter (DWT CYCCNT where available, the OS tick otherwise) per
+ * thread and records the smallest free stack seen at any switch point.
+ * Both numbers are kept in a small fixed table so reads are cheap enough
+ * for a deployed unit - no stack scan and no debugger required.
+ */
+
+/** Context switch hook - called from the RTX switch event with the thread
+ *  being switched in. Interrupts disabled caller context, must not block.
+ *
+ *  @param thread_id  id of the thread about to run
+ */
+void mbed_thread_stats_switch_hook(osThreadId_t thread_id);
+
+/** Drop the accounting slot of a terminated thread so it can be reused.
+ *
+ *  @param thread_id  id of the thread that exited or was terminated
+ */
+void mbed_thread_stats_remove(osThreadId_t thread_id);
+
+/** Read the accumulated stats of one thread.
+ *
+ *  @param thread_id       id of the thread to query
+ *  @param cpu_cycles      written with cycles spent running, NULL to skip
+ *  @param min_stack_free  written with the smallest free stack in bytes
+ *                         observed at a context switch, NULL to skip
+ *  @return true if the thread had an accounting slot, false otherwise
+ */
+bool mbed_thread_stats_read(osThreadId_t thread_id, uint64_t *cpu_cycles, uint32_t *min_stack_free);
+
+/** Total cycles accumulated across all tracked threads, for computing
+ *  per-thread shares of the CPU budget.
+ *
+ *  @return sum of cpu_cycles over all slots, including reclaimed ones
+ */
+uint64_t mbed_thread_stats_total_cycles(void);
+
+/** Read the scheduler activity counters kept by the switch hook.
+ *
+ *  A preemption is a switch where the outgoing thread was still runnable,
+ *  so a high preemption share of the switch count points at priority
+ *  churn rather than threads blocking voluntarily. The cycle figures are
+ *  measured across the switch event itself - the register save/restore
+ *  in the dispatch exception sits outside the window, so they are a
+ *  lower bound on the true switch cost.
+ *
+ *  @param switches           written with the context switch count, NULL to skip
+ *  @param preemptions        written with the preemptive switch count, NULL to skip
+ *  @param switch_cycles      written with the cumulative cycles measured
+ *                            across the switch path, NULL to skip
+ *  @param switch_cycles_max  written with the costliest single switch
+ *                            observed in cycles, NULL to skip
+ */
+void mbed_scheduler_stats_read(uint32_t *switches, uint32_t *preemptions,
+                               uint64_t *switch_cycles, uint32_t *switch_cycles_max);
+
+/** Reset the scheduler activity counters to zero. */
+void mbed_scheduler_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
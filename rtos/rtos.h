@@ -33,8 +33,10 @@
 #include "rtos/Semaphore.h"
 #include "rtos/Mail.h"
 #include "rtos/MemoryPool.h"
+#include "rtos/BuddyPool.h"
 #include "rtos/Queue.h"
 #include "rtos/EventFlags.h"
+#include "rtos/EventFlagsGroup.h"
 #include "rtos/ConditionVariable.h"
 
 using namespace rtos;
@@ -506,7 +506,8 @@ def build_project(src_paths, build_path, target, toolchain_name,
                   notify=None, name=None, macros=None, inc_dirs=None, jobs=1,
                   report=None, properties=None, project_id=None,
                   project_description=None, config=None,
-                  app_config=None, build_profile=None, stats_depth=None, ignore=None):
+                  app_config=None, build_profile=None, stats_depth=None, ignore=None,
+                  memory_baseline=None):
     """ Build a project. A project may be a test or a user program.
 
     Positional arguments:
@@ -534,6 +535,8 @@ def build_project(src_paths, build_path, target, toolchain_name,
     build_profile - a dict of flags that will be passed to the compiler
     stats_depth - depth level for memap to display file/dirs
     ignore - list of paths to add to mbedignore
+    memory_baseline - budget report from an earlier build to report
+                      per-module flash/RAM deltas against
     """
 
     # Convert src_path to a list if needed
@@ -616,6 +619,13 @@ def build_project(src_paths, build_path, target, toolchain_name,
             map_html = join(build_path, name + "_map.html")
             memap_instance.generate_output('html', stats_depth, map_html)
 
+            # Write the per-module flash/RAM budget rollup in JSON format,
+            # with deltas against the baseline when one was given
+            if memory_baseline:
+                memap_instance.load_baseline(memory_baseline)
+            map_budget = join(build_path, name + "_budget.json")
+            memap_instance.generate_output('budget', stats_depth, map_budget)
+
         resources.detect_duplicates(toolchain)
 
         if report != None:
@@ -1096,6 +1096,27 @@ class Config(object):
 
         return resources
 
+    @staticmethod
+    def _param_to_trait(macro_name, value):
+        """ Map a configuration parameter to a compile-time trait tuple
+        (name, type, value), or None when the value is not usable as a
+        compile-time integral constant (strings, expressions, floats).
+
+        Positional arguments:
+        macro_name - the macro name of the parameter
+        value - the parameter value, as a string
+        """
+        if value in ("true", "false"):
+            return (macro_name.lower(), "bool", value)
+        try:
+            int_value = int(value, 0)
+        except ValueError:
+            return None
+        # Keep to values an 'int' is guaranteed to hold on our targets
+        if int_value < -(2 ** 31) or int_value >= 2 ** 31:
+            return None
+        return (macro_name.lower(), "int", value)
+
     @staticmethod
     def config_to_header(config, fname=None):
         """ Convert the configuration data to the content of a C header file,
@@ -1125,6 +1146,9 @@ class Config(object):
             "val_len" : max([len(str(m.value)) for m in params_with_values] +
                             [len(m.macro_value or "") for m in macros.values()]
                             + [0]),
+            "cfg_traits": [t for t in
+                           (Config._param_to_trait(p.macro_name, str(p.value))
+                            for p in params_with_values) if t],
         }
         jinja_loader = FileSystemLoader(dirname(abspath(__file__)))
         jinja_environment = Environment(loader=jinja_loader,
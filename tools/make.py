@@ -121,6 +121,14 @@ if __name__ == '__main__':
         default=2,
         help="Depth level for static memory report")
 
+    parser.add_argument(
+        "--memory-baseline",
+        type=argparse_filestring_type,
+        dest="memory_baseline",
+        default=None,
+        help="Budget report from an earlier build to report per-module "
+        "flash/RAM deltas against")
+
     # Local run
     parser.add_argument("--automated", action="store_true", dest="automated",
                       default=False, help="Automated test")
@@ -287,7 +295,8 @@ if __name__ == '__main__':
                                                                    options,
                                                                    toolchain),
                                      stats_depth=options.stats_depth,
-                                     ignore=options.ignore)
+                                     ignore=options.ignore,
+                                     memory_baseline=options.memory_baseline)
             print('Image: %s'% bin_file)
 
             if options.disk:
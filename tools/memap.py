@@ -483,6 +483,9 @@ class MemapParser(object):
         # Name of the toolchain, for better headings
         self.tc_name = None
 
+        # Baseline budget report to compute deltas against
+        self.baseline = None
+
     def reduce_depth(self, depth):
         """
         populates the short_modules attribute with a truncated module list
@@ -511,7 +514,7 @@ class MemapParser(object):
                     self.short_modules[new_name].setdefault(section_idx, 0)
                     self.short_modules[new_name][section_idx] += self.modules[module_name][section_idx]
 
-    export_formats = ["json", "csv-ci", "html", "table"]
+    export_formats = ["json", "csv-ci", "html", "table", "budget"]
 
     def generate_output(self, export_format, depth, file_output=None):
         """ Generates summary of memory map data
@@ -539,7 +542,8 @@ class MemapParser(object):
         to_call = {'json': self.generate_json,
                    'html': self.generate_html,
                    'csv-ci': self.generate_csv,
-                   'table': self.generate_table}[export_format]
+                   'table': self.generate_table,
+                   'budget': self.generate_budget}[export_format]
         output = to_call(file_desc)
 
         if file_desc is not stdout:
@@ -631,6 +635,67 @@ class MemapParser(object):
         file_desc.write('\n')
         return None
 
+    def load_baseline(self, baseline_path):
+        """Load a previously exported budget report to compute deltas against
+
+        Positional arguments:
+        baseline_path - path to a JSON file written by the budget export
+        """
+        try:
+            with open(baseline_path, 'r') as file_input:
+                self.baseline = json.load(file_input)
+            return True
+        except (IOError, ValueError) as error:
+            print("Invalid memory baseline file: {0}".format(error))
+            return False
+
+    def generate_budget(self, file_desc):
+        """Generate a per-module flash/RAM budget report from a memory map
+
+        Rolls the module list up into flash (text + data) and static RAM
+        (data + bss) figures per module. When a baseline report has been
+        loaded, every entry also carries its delta against the baseline,
+        so the subsystem responsible for a size regression can be read
+        straight out of the build output instead of diffing map files.
+
+        Positional arguments:
+        file_desc - the file to write out the final report to
+        """
+        budget = {}
+        for module, v in self.short_modules.items():
+            budget[module] = {
+                'flash': v['.text'] + v['.data'],
+                'static_ram': v['.data'] + v['.bss'],
+            }
+
+        summary = {
+            'total_flash': self.mem_summary['total_flash'],
+            'static_ram': self.mem_summary['static_ram'],
+        }
+
+        if self.baseline:
+            baseline_modules = self.baseline.get('modules', {})
+            # Modules gone since the baseline still show up, with their
+            # whole baseline size as a negative delta
+            for module in baseline_modules:
+                budget.setdefault(module, {'flash': 0, 'static_ram': 0})
+            for module, v in budget.items():
+                base = baseline_modules.get(module, {})
+                v['delta_flash'] = v['flash'] - base.get('flash', 0)
+                v['delta_static_ram'] = \
+                    v['static_ram'] - base.get('static_ram', 0)
+
+            baseline_summary = self.baseline.get('summary', {})
+            summary['delta_total_flash'] = \
+                summary['total_flash'] - baseline_summary.get('total_flash', 0)
+            summary['delta_static_ram'] = \
+                summary['static_ram'] - baseline_summary.get('static_ram', 0)
+
+        file_desc.write(json.dumps(
+            {'summary': summary, 'modules': budget}, indent=4, sort_keys=True))
+        file_desc.write('\n')
+        return None
+
     def generate_csv(self, file_desc):
         """Generate a CSV file from a memoy map
 
@@ -787,6 +852,12 @@ def main():
         help="export format (examples: %s: default)" %
         ", ".join(MemapParser.export_formats))
 
+    parser.add_argument(
+        '-b', '--baseline', dest='baseline', required=False,
+        type=argparse_filestring_type,
+        help='budget report from an earlier build to compute deltas against '
+        '(used by the budget export format)')
+
     parser.add_argument('-v', '--version', action='version', version=version)
 
     # Parse/run command
@@ -804,6 +875,9 @@ def main():
         if memap.parse(args.file, args.toolchain) is False:
             exit(0)
 
+    if args.baseline:
+        memap.load_baseline(args.baseline)
+
     if args.depth is None:
         depth = 2  # default depth level
     else:
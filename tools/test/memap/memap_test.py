@@ -216,3 +216,33 @@ def test_generate_output_csv_ci(memap_parser, tmpdir, depth, sep):
     file_name = str(tmpdir.join('output.csv').realpath())
     generate_test_helper(memap_parser, 'csv-ci', depth, sep, file_name)
     assert isfile(file_name), "Failed to create csv-ci file"
+
+
+@pytest.mark.parametrize("depth", [1, 2, 20])
+@pytest.mark.parametrize("sep", ["\\", "/"])
+def test_generate_output_budget(memap_parser, tmpdir, depth, sep):
+    """
+    Test that an output of type "budget" can be generated correctly and
+    that deltas against a baseline report come out as expected
+
+    :param memap_parser: Mocked parser
+    :param tmpdir: a unique location to place an output file
+    :param depth: the detail of the output
+    """
+    file_name = str(tmpdir.join('budget.json').realpath())
+    generate_test_helper(memap_parser, 'budget', depth, sep, file_name)
+    assert isfile(file_name), "Failed to create budget file"
+
+    report = json.load(open(file_name))
+    assert report["summary"]["total_flash"] == 27
+    assert report["summary"]["static_ram"] == 24
+
+    # A report used as its own baseline reports all-zero deltas
+    memap_parser.load_baseline(file_name)
+    generate_test_helper(memap_parser, 'budget', depth, sep, file_name)
+    report = json.load(open(file_name))
+    assert report["summary"]["delta_total_flash"] == 0
+    assert report["summary"]["delta_static_ram"] == 0
+    for module in report["modules"].values():
+        assert module["delta_flash"] == 0
+        assert module["delta_static_ram"] == 0